@@ -23,6 +23,8 @@ BufferPoolManager::~BufferPoolManager() {
 }
 
 Page *BufferPoolManager::FetchPage(page_id_t page_id) {
+  // 并行扫描的线程会同时取页，页表和替换器都在latch_下修改
+  std::lock_guard<recursive_mutex> guard(latch_);
   if (page_id == INVALID_PAGE_ID) {
     return nullptr;
   }
@@ -63,6 +65,7 @@ Page *BufferPoolManager::FetchPage(page_id_t page_id) {
 }
 
 Page *BufferPoolManager::NewPage(page_id_t &page_id) {
+  std::lock_guard<recursive_mutex> guard(latch_);
   // 0.   Make sure you call AllocatePage!
   // 1.   If all the pages in the buffer pool are pinned, return nullptr.
   // 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
@@ -90,6 +93,7 @@ Page *BufferPoolManager::NewPage(page_id_t &page_id) {
 
 
 bool BufferPoolManager::DeletePage(page_id_t page_id) {
+  std::lock_guard<recursive_mutex> guard(latch_);
   // 0.   Make sure you call DeallocatePage!
   // 1.   Search the page table for the requested page (P). If P does not exist, return true.
   if (page_table_.find(page_id) == page_table_.end()) {
@@ -115,6 +119,7 @@ bool BufferPoolManager::DeletePage(page_id_t page_id) {
 }
 
 bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
+  std::lock_guard<recursive_mutex> guard(latch_);
   // 1.   Search the page table for the requested page (P).
   if (page_table_.find(page_id) == page_table_.end()) {
     return false;
@@ -135,6 +140,7 @@ bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
 }
 
 bool BufferPoolManager::FlushPage(page_id_t page_id) {
+  std::lock_guard<recursive_mutex> guard(latch_);
   if (page_table_.find(page_id) != page_table_.end()) {
     frame_id_t frame_id = page_table_[page_id];
     Page *page = &pages_[frame_id];
@@ -157,6 +163,7 @@ void BufferPoolManager::DeallocatePage(page_id_t page_id) {
 }
 
 bool BufferPoolManager::IsPageFree(page_id_t page_id) {
+  std::lock_guard<recursive_mutex> guard(latch_);
   return disk_manager_->IsPageFree(page_id);
 }
 
@@ -175,6 +182,7 @@ frame_id_t BufferPoolManager::TryToFindFreePage() {
 
 // Only used for debug
 bool BufferPoolManager::CheckAllUnpinned() {
+  std::lock_guard<recursive_mutex> guard(latch_);
   bool res = true;
   for (size_t i = 0; i < pool_size_; i++) {
     if (pages_[i].pin_count_ != 0) {
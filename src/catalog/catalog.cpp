@@ -1,5 +1,9 @@
 #include "catalog/catalog.h"
 
+#include <algorithm>
+
+#include "catalog/statistics.h"
+
 void CatalogMeta::SerializeTo(char *buf) const {
   ASSERT(GetSerializedSize() <= PAGE_SIZE, "Failed to serialize catalog metadata to disk.");
   MACH_WRITE_UINT32(buf, CATALOG_METADATA_MAGIC_NUM);
@@ -78,12 +82,17 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
       char *table_data = table_page->GetData();
       TableMetadata *table_meta = nullptr;
       TableMetadata::DeserializeFrom(table_data, table_meta);
-      TableHeap* table_heap = TableHeap::Create(buffer_pool_manager_, table_meta->GetFirstPageId(), table_meta->GetSchema(), log_manager, lock_manager);
+      // clustered table的记录在主键索引中，没有table heap
+      TableHeap* table_heap = nullptr;
+      if (!table_meta->IsClustered()) {
+        table_heap = TableHeap::Create(buffer_pool_manager_, table_meta->GetFirstPageId(), table_meta->GetSchema(), log_manager, lock_manager);
+      }
       TableInfo* table_info = TableInfo::Create();
       table_info->Init(table_meta, table_heap);
       table_names_[table_meta->GetTableName()] = table_meta->GetTableId();
       tables_[table_meta->GetTableId()] = table_info;
       buffer_pool_manager_->UnpinPage(page_id, false);
+      LoadStatistics(table_info);
     }
     for (auto iter : catalog_meta_->index_meta_pages_) {
       page_id_t page_id = iter.second;
@@ -97,12 +106,19 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
       index_names_[tables_[index_meta->GetTableId()]->GetTableName()].insert({index_meta->GetIndexName(), index_meta->GetIndexId()});
       indexes_[index_meta->GetIndexId()] = index_info;
       buffer_pool_manager_->UnpinPage(page_id, false);
+      // art索引不落盘，加载时从表中重建
+      if (index_meta->GetIndexType() == "art") {
+        PopulateIndex(index_info, tables_[index_meta->GetTableId()], nullptr);
+      }
     }
     buffer_pool_manager_->UnpinPage(CATALOG_META_PAGE_ID, false);
   }
 }
 
 CatalogManager::~CatalogManager() {
+  for (auto iter : indexes_) {
+    iter.second->FlushBloomFilter();
+  }
   FlushCatalogMetaPage();
   delete catalog_meta_;
   for (auto iter : tables_) {
@@ -113,18 +129,42 @@ CatalogManager::~CatalogManager() {
   }
 }
 
-dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info) {
+dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info, bool clustered) {
   if (table_names_.find(table_name) != table_names_.end()) {
     return DB_TABLE_ALREADY_EXIST;
   }
+  // 对primary key建立index，nullable == false表示primary key
+  std::vector<std::string> primary_keys;
+  std::vector<uint32_t> primary_key_map;
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    if (!schema->GetColumn(i)->IsNullable()) {
+      primary_keys.push_back(schema->GetColumn(i)->GetName());
+      primary_key_map.push_back(i);
+    }
+  }
+  // clustered table按单个int主键组织，整行要能放进主键索引的key
+  if (clustered) {
+    if (primary_keys.empty()) {
+      return DB_FAILED;
+    }
+    std::unique_ptr<Schema> key_schema(Schema::ShallowCopySchema(schema, primary_key_map));
+    if (ClusteredIndex::KeySizeFor(key_schema.get(), schema) == 0) {
+      return DB_FAILED;
+    }
+  }
   table_id_t table_id = catalog_meta_->GetNextTableId();
   // 新建table_meta和table_heap
   page_id_t table_meta_page_id;
   Schema *tmp_schema = schema->DeepCopySchema(schema);
   auto table_meta_page = buffer_pool_manager_->NewPage(table_meta_page_id);
   // TableMetadata类中，root_page_id_指的是TableHeap的root_page_id_，所以先构造TableHeap再构造TableMetadata
-  TableHeap *table_heap = TableHeap::Create(buffer_pool_manager_, tmp_schema, txn, log_manager_, lock_manager_);
-  TableMetadata *table_meta = TableMetadata::Create(table_id, table_name, table_heap->GetFirstPageId(), tmp_schema);
+  TableHeap *table_heap = nullptr;
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  if (!clustered) {
+    table_heap = TableHeap::Create(buffer_pool_manager_, tmp_schema, txn, log_manager_, lock_manager_);
+    first_page_id = table_heap->GetFirstPageId();
+  }
+  TableMetadata *table_meta = TableMetadata::Create(table_id, table_name, first_page_id, tmp_schema, clustered);
   // 构造table_info
   table_info = TableInfo::Create();
   table_info->Init(table_meta, table_heap);
@@ -136,6 +176,11 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
   table_names_[table_name] = table_id;
   tables_[table_id] = table_info;
 
+  // clustered index最先建立，加载时它先于其他索引挂到table info上
+  if (clustered) {
+    IndexInfo *index_info = nullptr;
+    CreateIndex(table_name, table_name + "_PRIMARY_KEY", primary_keys, txn, index_info, "clustered");
+  }
   // 对unique列建立index
   std::vector<std::string> unique_columns;
   for (auto column : schema->GetColumns()) {
@@ -143,19 +188,12 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
       IndexInfo *index_info = nullptr;
       unique_columns.clear();
       unique_columns.push_back(column->GetName());
-      CreateIndex(table_name, table_name + "_" + column->GetName() + "_UNIQUE", unique_columns, txn, index_info, "btree");
+      CreateIndex(table_name, table_name + "_" + column->GetName() + "_UNIQUE", unique_columns, txn, index_info, "bptree");
     }
   }
-  // 对primary key建立index，nullable == false表示primary key
-  std::vector<std::string> primary_keys;
-  for (auto column : schema->GetColumns()) {
-    if (!column->IsNullable()) {
-      primary_keys.push_back(column->GetName());
-    }
-  }
-  if (!primary_keys.empty()) {
+  if (!primary_keys.empty() && !clustered) {
     IndexInfo *index_info = nullptr;
-    CreateIndex(table_name, table_name + "_PRIMARY_KEY", primary_keys, txn, index_info, "btree");
+    CreateIndex(table_name, table_name + "_PRIMARY_KEY", primary_keys, txn, index_info, "bptree");
   }
   return DB_SUCCESS;
 }
@@ -178,10 +216,20 @@ dberr_t CatalogManager::GetTables(vector<TableInfo *> &tables) const {
   return DB_SUCCESS;
 }
 
-dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string &index_name, const std::vector<std::string> &index_keys, Txn *txn, IndexInfo *&index_info, const string &index_type) {
+dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string &index_name, const std::vector<std::string> &index_keys, Txn *txn, IndexInfo *&index_info, const string &type_name) {
   if (table_names_.find(table_name) == table_names_.end()) {
     return DB_TABLE_NOT_EXIST;
   }
+  // btree是bptree的别名
+  const string index_type = type_name == "btree" ? "bptree" : type_name;
+  if (index_type != "bptree" && index_type != "hash" && index_type != "art" && index_type != "clustered") {
+    return DB_FAILED;
+  }
+  // clustered index只在建表时为clustered table建立一次
+  TableInfo *table = tables_[table_names_[table_name]];
+  if (index_type == "clustered" && (!table->IsClustered() || table->GetClusteredIndex() != nullptr)) {
+    return DB_FAILED;
+  }
   // 同一个数据库中不能有相同的index名，因此遍历所有的表的index名
   for (auto iter : index_names_) {
     if (iter.second.find(index_name) != iter.second.end()) {
@@ -198,12 +246,28 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
     }
     key_map.push_back(index);
   }
+  // key包含unique列或者包含全部primary key列时为唯一索引，否则允许重复key
+  bool unique = false;
+  bool has_primary_key = false;
+  bool covers_primary_key = true;
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    auto column = schema->GetColumn(i);
+    bool in_key = std::find(key_map.begin(), key_map.end(), i) != key_map.end();
+    if (column->IsUnique() && in_key) {
+      unique = true;
+    }
+    if (!column->IsNullable()) {
+      has_primary_key = true;
+      covers_primary_key = covers_primary_key && in_key;
+    }
+  }
+  unique = unique || (has_primary_key && covers_primary_key);
   table_id_t table_id = table_names_[table_name];
   index_id_t index_id = catalog_meta_->GetNextIndexId();
   page_id_t index_meta_page_id;
   auto index_meta_page = buffer_pool_manager_->NewPage(index_meta_page_id);
   // 构造index_meta
-  IndexMetadata *index_meta = IndexMetadata::Create(index_id, index_name, table_id, key_map);
+  IndexMetadata *index_meta = IndexMetadata::Create(index_id, index_name, table_id, key_map, unique, index_type);
   // 构造index_info
   index_info = IndexInfo::Create();
   index_info->Init(index_meta, tables_[table_id], buffer_pool_manager_);
@@ -216,20 +280,46 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
   indexes_[index_id] = index_info;
 
   // 插入记录
-  auto table_info = tables_[table_id];
-  auto table_heap = table_info->GetTableHeap();
+  if (PopulateIndex(index_info, tables_[table_id], txn) != DB_SUCCESS) {
+    DropIndex(table_name, index_name);
+    return DB_FAILED;
+  }
+  // 唯一索引每次插入前都要查重，建立bloom filter排除不存在的key
+  if (unique) {
+    index_info->CreateBloomFilter();
+    FlushIndexMetaPage(index_id);
+  }
+  return DB_SUCCESS;
+}
+
+/**
+ * 把表中已有的记录插入索引，按批排序后插入
+ */
+dberr_t CatalogManager::PopulateIndex(IndexInfo *index_info, TableInfo *table_info, Txn *txn) {
   auto table_schema = table_info->GetSchema();
-  for (auto iter = table_heap->Begin(txn); iter != table_heap->End(); ++iter) {
+  std::vector<Row> keys;
+  std::vector<RowId> rids;
+  dberr_t result = DB_SUCCESS;
+  auto flush = [&]() {
+    if (index_info->GetIndex()->InsertEntries(keys, rids, txn) == DB_FAILED) {
+      result = DB_FAILED;
+    }
+    keys.clear();
+    rids.clear();
+  };
+  for (auto iter = table_info->Begin(txn); iter != table_info->End() && result == DB_SUCCESS; ++iter) {
     Row insert_row = *iter;
-    Row key_row;
-    insert_row.GetKeyFromRow(table_schema, index_info->GetIndexKeySchema(), key_row);
-    dberr_t result = index_info->GetIndex()->InsertEntry(key_row, insert_row.GetRowId(), txn);
-    if (result == DB_FAILED) {
-      DropIndex(table_name, index_name);
-      return DB_FAILED;
+    keys.emplace_back();
+    insert_row.GetKeyFromRow(table_schema, index_info->GetIndexKeySchema(), keys.back());
+    rids.push_back(insert_row.GetRowId());
+    if (keys.size() == POPULATE_BATCH_SIZE) {
+      flush();
     }
   }
-  return DB_SUCCESS;
+  if (result == DB_SUCCESS && !keys.empty()) {
+    flush();
+  }
+  return result;
 }
 
 dberr_t CatalogManager::GetIndex(const std::string &table_name, const std::string &index_name, IndexInfo *&index_info) const {
@@ -256,6 +346,58 @@ dberr_t CatalogManager::GetTableIndexes(const std::string &table_name, std::vect
   return DB_SUCCESS;
 }
 
+dberr_t CatalogManager::SetIndexPinnedLevels(const std::string &table_name, const std::string &index_name, int levels) {
+  IndexInfo *index_info = nullptr;
+  dberr_t result = GetIndex(table_name, index_name, index_info);
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  result = index_info->SetPinnedLevels(levels);
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  return FlushIndexMetaPage(index_info->GetMetadata()->GetIndexId());
+}
+
+dberr_t CatalogManager::SetIndexBloomFilter(const std::string &table_name, const std::string &index_name, bool enable) {
+  IndexInfo *index_info = nullptr;
+  dberr_t result = GetIndex(table_name, index_name, index_info);
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  if (enable == index_info->HasBloomFilter()) {
+    return DB_SUCCESS;
+  }
+  if (enable) {
+    index_info->CreateBloomFilter();
+  } else {
+    index_info->DropBloomFilter();
+  }
+  return FlushIndexMetaPage(index_info->GetMetadata()->GetIndexId());
+}
+
+/**
+ * 重新统计整张表，新的统计信息写入新的页链后再释放旧页
+ */
+dberr_t CatalogManager::AnalyzeTable(const string &table_name, Txn *txn) {
+  TableInfo *table_info = nullptr;
+  dberr_t result = GetTable(table_name, table_info);
+  if (result != DB_SUCCESS) {
+    return result;
+  }
+  auto statistics = TableStatistics::Build(table_info, txn);
+  page_id_t page_id = statistics->WriteToPages(buffer_pool_manager_);
+  if (page_id == INVALID_PAGE_ID) {
+    delete statistics;
+    return DB_FAILED;
+  }
+  TableMetadata *table_meta = table_info->GetMetadata();
+  TableStatistics::FreePages(buffer_pool_manager_, table_meta->GetStatisticsPageId());
+  table_meta->SetStatisticsPageId(page_id);
+  table_info->SetStatistics(statistics);
+  return FlushTableMetaPage(table_info->GetTableId());
+}
+
 dberr_t CatalogManager::DropTable(const string &table_name) {
   if (table_names_.find(table_name) == table_names_.end()) {
     return DB_TABLE_NOT_EXIST;
@@ -267,11 +409,14 @@ dberr_t CatalogManager::DropTable(const string &table_name) {
     index_names.push_back(iter.first);
   }
   for (auto iter : index_names) {
-    DropIndex(table_name, iter);
+    DropIndex(table_name, iter, true);
   }
   table_names_.erase(table_name);
   TableInfo *table_info = tables_[table_id];
-  table_info->GetTableHeap()->FreeTableHeap();
+  if (!table_info->IsClustered()) {
+    table_info->GetTableHeap()->FreeTableHeap();
+  }
+  TableStatistics::FreePages(buffer_pool_manager_, table_info->GetMetadata()->GetStatisticsPageId());
   tables_.erase(table_id);
   buffer_pool_manager_->DeletePage(catalog_meta_->table_meta_pages_[table_id]);
   catalog_meta_->table_meta_pages_.erase(table_id);
@@ -279,16 +424,26 @@ dberr_t CatalogManager::DropTable(const string &table_name) {
 }
 
 dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_name) {
+  return DropIndex(table_name, index_name, false);
+}
+
+/**
+ * clustered index中存放着表的记录，只能随表一起删除
+ */
+dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_name, bool drop_table) {
   if (table_names_.find(table_name) == table_names_.end()) {
     return DB_TABLE_NOT_EXIST;
   }
   if (index_names_.find(table_name) != index_names_.end() && index_names_[table_name].find(index_name) == index_names_[table_name].end()) {
     return DB_INDEX_NOT_FOUND;
   }
-  table_id_t table_id = table_names_[table_name];
   index_id_t index_id = index_names_[table_name][index_name];
-  index_names_[table_name].erase(index_name);
   IndexInfo *index_info = indexes_[index_id];
+  if (index_info->GetIndexType() == "clustered" && !drop_table) {
+    return DB_FAILED;
+  }
+  index_names_[table_name].erase(index_name);
+  index_info->DropBloomFilter();
   index_info->GetIndex()->Destroy();
   indexes_.erase(index_id);
   catalog_meta_->DeleteIndexMetaPage(buffer_pool_manager_, index_id);
@@ -311,6 +466,34 @@ dberr_t CatalogManager::FlushCatalogMetaPage() const {
   return DB_SUCCESS;
 }
 
+/**
+ * 重写index meta page，bloom filter首页变化时调用
+ */
+dberr_t CatalogManager::FlushIndexMetaPage(index_id_t index_id) const {
+  page_id_t page_id = catalog_meta_->index_meta_pages_.at(index_id);
+  auto page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    return DB_FAILED;
+  }
+  indexes_.at(index_id)->GetMetadata()->SerializeTo(page->GetData());
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  return DB_SUCCESS;
+}
+
+/**
+ * 重写table meta page，统计信息首页变化时调用
+ */
+dberr_t CatalogManager::FlushTableMetaPage(table_id_t table_id) const {
+  page_id_t page_id = catalog_meta_->table_meta_pages_.at(table_id);
+  auto page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    return DB_FAILED;
+  }
+  tables_.at(table_id)->GetMetadata()->SerializeTo(page->GetData());
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  return DB_SUCCESS;
+}
+
 dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t page_id) {
   if (tables_.find(table_id) != tables_.end()) {
     return DB_TABLE_ALREADY_EXIST;
@@ -320,14 +503,30 @@ dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t pag
   TableMetadata *table_meta = nullptr;
   TableMetadata::DeserializeFrom(page->GetData(), table_meta);
   table_names_[table_meta->GetTableName()] = table_id;
-  TableHeap *table_heap = TableHeap::Create(buffer_pool_manager_, table_meta->GetFirstPageId(), table_meta->GetSchema(), log_manager_, lock_manager_);
+  TableHeap *table_heap = nullptr;
+  if (!table_meta->IsClustered()) {
+    table_heap = TableHeap::Create(buffer_pool_manager_, table_meta->GetFirstPageId(), table_meta->GetSchema(), log_manager_, lock_manager_);
+  }
   TableInfo *table_info = TableInfo::Create();
   table_info->Init(table_meta, table_heap);
   tables_[table_id] = table_info;
   buffer_pool_manager_->UnpinPage(page_id, false);
+  LoadStatistics(table_info);
   return DB_SUCCESS;
 }
 
+void CatalogManager::LoadStatistics(TableInfo *table_info) {
+  page_id_t page_id = table_info->GetMetadata()->GetStatisticsPageId();
+  if (page_id == INVALID_PAGE_ID) {
+    return;
+  }
+  auto statistics = TableStatistics::ReadFromPages(buffer_pool_manager_, page_id);
+  if (statistics == nullptr) {
+    LOG(WARNING) << "Failed to read the statistics of table " << table_info->GetTableName() << std::endl;
+  }
+  table_info->SetStatistics(statistics);
+}
+
 dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t page_id) {
   if (indexes_.find(index_id) != indexes_.end()) {
     return DB_INDEX_ALREADY_EXIST;
@@ -345,6 +544,10 @@ dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t pag
   index_names_[tables_[table_id]->GetTableName()].insert({index_meta->GetIndexName(), index_meta->GetIndexId()});
   indexes_[index_id] = index_info;
   buffer_pool_manager_->UnpinPage(page_id, false);
+  // art索引不落盘，加载时从表中重建
+  if (index_meta->GetIndexType() == "art") {
+    return PopulateIndex(index_info, tables_[table_id], nullptr);
+  }
   return DB_SUCCESS;
 }
 
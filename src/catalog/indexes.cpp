@@ -1,10 +1,21 @@
 #include "catalog/indexes.h"
 
-IndexMetadata::IndexMetadata(const index_id_t index_id, const std::string &index_name, const table_id_t table_id, const std::vector<uint32_t> &key_map)
-    : index_id_(index_id), index_name_(index_name), table_id_(table_id), key_map_(key_map) {}
+#include <algorithm>
 
-IndexMetadata *IndexMetadata::Create(const index_id_t index_id, const string &index_name, const table_id_t table_id, const vector<uint32_t> &key_map) {
-  return new IndexMetadata(index_id, index_name, table_id, key_map);
+IndexMetadata::IndexMetadata(const index_id_t index_id, const std::string &index_name, const table_id_t table_id, const std::vector<uint32_t> &key_map, bool unique,
+                             const std::string &index_type, page_id_t bloom_page_id, uint32_t pinned_levels)
+    : index_id_(index_id),
+      index_name_(index_name),
+      table_id_(table_id),
+      key_map_(key_map),
+      unique_(unique),
+      index_type_(index_type),
+      bloom_page_id_(bloom_page_id),
+      pinned_levels_(pinned_levels) {}
+
+IndexMetadata *IndexMetadata::Create(const index_id_t index_id, const string &index_name, const table_id_t table_id, const vector<uint32_t> &key_map, bool unique,
+                                     const std::string &index_type, page_id_t bloom_page_id, uint32_t pinned_levels) {
+  return new IndexMetadata(index_id, index_name, table_id, key_map, unique, index_type, bloom_page_id, pinned_levels);
 }
 
 uint32_t IndexMetadata::SerializeTo(char *buf) const {
@@ -33,12 +44,26 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
     MACH_WRITE_UINT32(buf, col_index);
     buf += 4;
   }
+  // unique flag
+  MACH_WRITE_UINT32(buf, unique_ ? 1 : 0);
+  buf += 4;
+  // index type
+  MACH_WRITE_UINT32(buf, index_type_.length());
+  buf += 4;
+  MACH_WRITE_STRING(buf, index_type_);
+  buf += index_type_.length();
+  // bloom filter page
+  MACH_WRITE_TO(page_id_t, buf, bloom_page_id_);
+  buf += 4;
+  // pinned levels
+  MACH_WRITE_UINT32(buf, pinned_levels_);
+  buf += 4;
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
   return ofs;
 }
 
 uint32_t IndexMetadata::GetSerializedSize() const {
-  return 4 * 4 + MACH_STR_SERIALIZED_SIZE(index_name_) + 4 * key_map_.size();
+  return 7 * 4 + MACH_STR_SERIALIZED_SIZE(index_name_) + 4 * key_map_.size() + MACH_STR_SERIALIZED_SIZE(index_type_);
 }
 
 uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
@@ -71,27 +96,62 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
     buf += 4;
     key_map.push_back(key_index);
   }
+  // unique flag
+  bool unique = MACH_READ_UINT32(buf) != 0;
+  buf += 4;
+  // index type
+  len = MACH_READ_UINT32(buf);
+  buf += 4;
+  std::string index_type(buf, len);
+  buf += len;
+  // bloom filter page
+  page_id_t bloom_page_id = MACH_READ_FROM(page_id_t, buf);
+  buf += 4;
+  // pinned levels
+  uint32_t pinned_levels = MACH_READ_UINT32(buf);
+  buf += 4;
   // allocate space for index meta data
-  index_meta = new IndexMetadata(index_id, index_name, table_id, key_map);
+  index_meta =
+      new IndexMetadata(index_id, index_name, table_id, key_map, unique, index_type, bloom_page_id, pinned_levels);
   return buf - p;
 }
 
 Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const string &index_type) {
-  size_t max_size = 0;
+  // art索引只在内存中，key按字节序编码，不需要定长的GenericKey
+  if (index_type == "art") {
+    return new ArtIndex(meta_data_->index_id_, key_schema_, meta_data_->IsUnique());
+  }
+  // clustered index的key后面带着整行，大小由表的schema决定
+  if (index_type == "clustered") {
+    if (ClusteredIndex::KeySizeFor(key_schema_, table_info_->GetSchema()) == 0) {
+      return nullptr;
+    }
+    return new ClusteredIndex(meta_data_->index_id_, key_schema_, table_info_->GetSchema(), buffer_pool_manager);
+  }
+  // 序列化后的key row: magic num + null bitmap + 各字段(char字段带4字节长度)
+  size_t max_size = 2 * sizeof(uint32_t);
   for (auto col : key_schema_->GetColumns()) {
     max_size += col->GetLength();
+    if (col->GetType() == TypeId::kTypeChar) {
+      max_size += sizeof(uint32_t);
+    }
+  }
+  // 非唯一索引在key末尾追加row id
+  bool unique = meta_data_->IsUnique();
+  if (!unique) {
+    max_size += sizeof(int64_t);
   }
 
-  if (index_type == "bptree") {
-    if (max_size <= 8)
+  if (index_type == "bptree" || index_type == "hash") {
+    if (max_size <= 16)
       max_size = 16;
-    else if (max_size <= 24)
+    else if (max_size <= 32)
       max_size = 32;
-    else if (max_size <= 56)
+    else if (max_size <= 64)
       max_size = 64;
-    else if (max_size <= 120)
+    else if (max_size <= 128)
       max_size = 128;
-    else if (max_size <= 248)
+    else if (max_size <= 256)
       max_size = 256;
     else {
       LOG(ERROR) << "GenericKey size is too large";
@@ -100,5 +160,260 @@ Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const stri
   } else {
     return nullptr;
   }
-  return new BPlusTreeIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager);
+  if (index_type == "hash") {
+    return new HashIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager, unique);
+  }
+  return new BPlusTreeIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager, unique);
+}
+
+uint64_t IndexInfo::HashKey(const Row &key) const {
+  std::string buf = ArtIndex::EncodeKey(key, key_schema_);
+  return BloomFilter::Hash(buf.data(), buf.size());
+}
+
+dberr_t IndexInfo::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
+  dberr_t result = index_->InsertEntry(key, row_id, txn);
+  if (result != DB_SUCCESS || filter_ == nullptr) {
+    return result;
+  }
+  filter_->Insert(HashKey(key));
+  // 超过容量后误判率上升，按表中的记录重建一个更大的filter
+  if (++filter_keys_ > filter_->GetCapacity()) {
+    RebuildBloomFilter();
+  }
+  OnBloomFilterChange();
+  return result;
+}
+
+dberr_t IndexInfo::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
+  dberr_t result = index_->RemoveEntry(key, row_id, txn);
+  if (result == DB_SUCCESS && filter_ != nullptr) {
+    OnBloomFilterChange();
+  }
+  return result;
+}
+
+dberr_t IndexInfo::InsertEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn) {
+  dberr_t result = index_->InsertEntries(keys, row_ids, txn);
+  if (filter_ == nullptr || keys.empty()) {
+    return result;
+  }
+  // 重复的key本来就在filter中，全部加入即可
+  for (const auto &key : keys) {
+    filter_->Insert(HashKey(key));
+  }
+  filter_keys_ += keys.size();
+  if (filter_keys_ > filter_->GetCapacity()) {
+    RebuildBloomFilter();
+  }
+  OnBloomFilterChange(keys.size());
+  return result;
+}
+
+dberr_t IndexInfo::RemoveEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn) {
+  dberr_t result = index_->RemoveEntries(keys, row_ids, txn);
+  if (filter_ != nullptr && !keys.empty()) {
+    OnBloomFilterChange(keys.size());
+  }
+  return result;
+}
+
+dberr_t IndexInfo::LookupMany(const std::vector<Row> &keys, std::vector<std::vector<RowId>> &results, Txn *txn) {
+  if (filter_ == nullptr) {
+    return index_->LookupMany(keys, results, txn);
+  }
+  std::vector<Row> probe_keys;
+  std::vector<size_t> positions;
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (MayContain(keys[i])) {
+      probe_keys.push_back(keys[i]);
+      positions.push_back(i);
+    }
+  }
+  results.assign(keys.size(), {});
+  if (probe_keys.empty()) {
+    return DB_SUCCESS;
+  }
+  std::vector<std::vector<RowId>> probe_results;
+  dberr_t result = index_->LookupMany(probe_keys, probe_results, txn);
+  for (size_t i = 0; i < positions.size(); i++) {
+    results[positions[i]] = std::move(probe_results[i]);
+  }
+  return result;
+}
+
+bool IndexInfo::MayContain(const Row &key) const {
+  if (filter_ == nullptr || key.GetFieldCount() != key_schema_->GetColumnCount()) {
+    return true;
+  }
+  return filter_->MayContain(HashKey(key));
+}
+
+void IndexInfo::RebuildBloomFilter() {
+  std::vector<uint64_t> hashes;
+  for (auto iter = table_info_->Begin(nullptr); iter != table_info_->End(); ++iter) {
+    Row row = *iter;
+    Row key_row;
+    row.GetKeyFromRow(table_info_->GetSchema(), key_schema_, key_row);
+    hashes.push_back(HashKey(key_row));
+  }
+  if (filter_ == nullptr) {
+    filter_ = new BloomFilter();
+  }
+  filter_->Reset(BloomFilter::BlocksFor(2 * hashes.size()));
+  for (auto hash : hashes) {
+    filter_->Insert(hash);
+  }
+  filter_keys_ = hashes.size();
+}
+
+/*
+ * bloom filter页格式:
+ *  首页: | MagicNum (4) | Complete (4) | NumBlocks (4) | NumKeys (4) | NextPageId (4) | DATA |
+ *  后续页: | NextPageId (4) | DATA |
+ */
+static constexpr uint32_t BLOOM_HEADER_SIZE = 5 * 4;
+
+void IndexInfo::CreateBloomFilter() {
+  if (filter_ != nullptr) {
+    return;
+  }
+  page_id_t page_id;
+  auto page = buffer_pool_manager_->NewPage(page_id);
+  if (page == nullptr) {
+    LOG(WARNING) << "No free page for the bloom filter of index " << GetIndexName() << std::endl;
+    return;
+  }
+  MACH_WRITE_UINT32(page->GetData(), 0);
+  MACH_WRITE_TO(page_id_t, page->GetData() + 4 * 4, INVALID_PAGE_ID);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  meta_data_->bloom_page_id_ = page_id;
+  RebuildBloomFilter();
+  FlushBloomFilter();
+}
+
+void IndexInfo::DropBloomFilter() {
+  page_id_t page_id = meta_data_->bloom_page_id_;
+  bool first = true;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    page_id_t next = MACH_READ_FROM(page_id_t, page->GetData() + (first ? 4 * 4 : 0));
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    page_id = next;
+    first = false;
+  }
+  meta_data_->bloom_page_id_ = INVALID_PAGE_ID;
+  delete filter_;
+  filter_ = nullptr;
+}
+
+void IndexInfo::FlushBloomFilter() {
+  if (filter_ == nullptr) {
+    return;
+  }
+  const char *data = filter_->GetData();
+  size_t size = filter_->GetMemoryUsage();
+  size_t offset = 0;
+  page_id_t page_id = meta_data_->bloom_page_id_;
+  auto page = buffer_pool_manager_->FetchPage(page_id);
+  char *buf = page->GetData();
+  MACH_WRITE_UINT32(buf, BLOOM_FILTER_MAGIC_NUM);
+  MACH_WRITE_UINT32(buf + 4, 1);
+  MACH_WRITE_UINT32(buf + 2 * 4, filter_->GetNumBlocks());
+  MACH_WRITE_UINT32(buf + 3 * 4, static_cast<uint32_t>(filter_keys_));
+  char *next_ptr = buf + 4 * 4;
+  uint32_t header_size = BLOOM_HEADER_SIZE;
+  // 沿着页链写入，页不够时追加新页
+  while (true) {
+    size_t len = std::min(size - offset, static_cast<size_t>(PAGE_SIZE - header_size));
+    memcpy(buf + header_size, data + offset, len);
+    offset += len;
+    page_id_t next = MACH_READ_FROM(page_id_t, next_ptr);
+    if (offset == size) {
+      // 释放多余的页
+      MACH_WRITE_TO(page_id_t, next_ptr, INVALID_PAGE_ID);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      while (next != INVALID_PAGE_ID) {
+        auto extra = buffer_pool_manager_->FetchPage(next);
+        page_id_t after = MACH_READ_FROM(page_id_t, extra->GetData());
+        buffer_pool_manager_->UnpinPage(next, false);
+        buffer_pool_manager_->DeletePage(next);
+        next = after;
+      }
+      break;
+    }
+    Page *next_page;
+    if (next == INVALID_PAGE_ID) {
+      next_page = buffer_pool_manager_->NewPage(next);
+      MACH_WRITE_TO(page_id_t, next_page->GetData(), INVALID_PAGE_ID);
+      MACH_WRITE_TO(page_id_t, next_ptr, next);
+    } else {
+      next_page = buffer_pool_manager_->FetchPage(next);
+    }
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    page_id = next;
+    buf = next_page->GetData();
+    next_ptr = buf;
+    header_size = 4;
+  }
+  filter_changes_ = 0;
+}
+
+void IndexInfo::LoadBloomFilter() {
+  page_id_t page_id = meta_data_->bloom_page_id_;
+  auto page = buffer_pool_manager_->FetchPage(page_id);
+  char *buf = page->GetData();
+  bool complete = MACH_READ_UINT32(buf) == BLOOM_FILTER_MAGIC_NUM && MACH_READ_UINT32(buf + 4) != 0;
+  if (!complete) {
+    // 上次修改后没有正常关闭，页上的filter可能缺少key，从表中重建
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    RebuildBloomFilter();
+    FlushBloomFilter();
+    return;
+  }
+  filter_ = new BloomFilter(MACH_READ_UINT32(buf + 2 * 4));
+  filter_keys_ = MACH_READ_UINT32(buf + 3 * 4);
+  char *data = filter_->GetData();
+  size_t size = filter_->GetMemoryUsage();
+  size_t offset = 0;
+  uint32_t header_size = BLOOM_HEADER_SIZE;
+  page_id_t next = MACH_READ_FROM(page_id_t, buf + 4 * 4);
+  while (true) {
+    size_t len = std::min(size - offset, static_cast<size_t>(PAGE_SIZE - header_size));
+    memcpy(data + offset, buf + header_size, len);
+    offset += len;
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    if (offset == size) {
+      break;
+    }
+    page_id = next;
+    buf = buffer_pool_manager_->FetchPage(page_id)->GetData();
+    next = MACH_READ_FROM(page_id_t, buf);
+    header_size = 4;
+  }
+  filter_changes_ = 0;
+}
+
+void IndexInfo::OnBloomFilterChange(size_t count) {
+  if (filter_changes_ == 0) {
+    auto page = buffer_pool_manager_->FetchPage(meta_data_->bloom_page_id_);
+    MACH_WRITE_UINT32(page->GetData() + 4, 0);
+    buffer_pool_manager_->UnpinPage(meta_data_->bloom_page_id_, true);
+  }
+  filter_changes_ += count;
+  if (filter_changes_ >= std::max(BLOOM_FLUSH_INTERVAL, filter_->GetCapacity() / 4)) {
+    FlushBloomFilter();
+  }
+}
+
+dberr_t IndexInfo::SetPinnedLevels(int levels) {
+  auto index = dynamic_cast<BPlusTreeIndex *>(index_);
+  if (index == nullptr) {
+    return DB_FAILED;
+  }
+  index->SetPinnedLevels(levels);
+  // 负数按0处理，记录实际的层数
+  meta_data_->pinned_levels_ = index->GetPinnedLevels();
+  return DB_SUCCESS;
 }
@@ -0,0 +1,385 @@
+#include "catalog/statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "catalog/table.h"
+
+static bool FieldLess(const Field *a, const Field *b) { return a->CompareLessThan(*b) == CmpBool::kTrue; }
+
+/*
+ * 把字段映射到数轴上用于桶内插值，char取前6个字节
+ */
+static double ToDouble(const Field &field) {
+  if (field.GetTypeId() == TypeId::kTypeInt) {
+    int32_t value;
+    field.SerializeTo(reinterpret_cast<char *>(&value));
+    return value;
+  }
+  if (field.GetTypeId() == TypeId::kTypeFloat) {
+    float value;
+    field.SerializeTo(reinterpret_cast<char *>(&value));
+    return value;
+  }
+  const char *data = field.GetData();
+  uint32_t len = field.GetLength();
+  double value = 0;
+  for (uint32_t i = 0; i < 6; i++) {
+    value = value * 256 + (i < len ? static_cast<unsigned char>(data[i]) : 0);
+  }
+  return value;
+}
+
+double ColumnStatistics::PositionInBucket(size_t bucket, const Field &value) const {
+  double lo = ToDouble(*bounds_[bucket]);
+  double hi = ToDouble(*bounds_[bucket + 1]);
+  if (hi <= lo) {
+    return 0.5;
+  }
+  return std::min(1.0, std::max(0.0, (ToDouble(value) - lo) / (hi - lo)));
+}
+
+double ColumnStatistics::EstimateEqual(const Field &value) const {
+  if (bounds_.empty() || value.IsNull()) {
+    return 0;
+  }
+  if (FieldLess(&value, bounds_.front().get()) || FieldLess(bounds_.back().get(), &value)) {
+    return 0;
+  }
+  // 占满整个桶的值至少有这么多，其余的值按distinct平均
+  size_t full = 0;
+  for (size_t i = 0; i + 1 < bounds_.size(); i++) {
+    if (bounds_[i]->CompareEquals(value) == CmpBool::kTrue && bounds_[i + 1]->CompareEquals(value) == CmpBool::kTrue) {
+      full++;
+    }
+  }
+  double fraction = static_cast<double>(full) / GetBucketCount();
+  if (distinct_ > 0) {
+    fraction = std::max(fraction, 1.0 / distinct_);
+  }
+  return std::min(1.0, fraction) * (1 - null_fraction_);
+}
+
+double ColumnStatistics::EstimateLess(const Field &value, bool inclusive) const {
+  if (bounds_.empty() || value.IsNull()) {
+    return 0;
+  }
+  double non_null = 1 - null_fraction_;
+  if (FieldLess(&value, bounds_.front().get())) {
+    return 0;
+  }
+  if (FieldLess(bounds_.back().get(), &value)) {
+    return non_null;
+  }
+  // 上界小于value的桶整个计入，value所在的桶按位置插值
+  double buckets = 0;
+  for (size_t i = 0; i + 1 < bounds_.size(); i++) {
+    if (FieldLess(bounds_[i + 1].get(), &value)) {
+      buckets += 1;
+    } else {
+      if (FieldLess(bounds_[i].get(), &value)) {
+        buckets += PositionInBucket(i, value);
+      }
+      break;
+    }
+  }
+  double fraction = buckets / GetBucketCount() * non_null;
+  if (inclusive) {
+    fraction += EstimateEqual(value);
+  }
+  return std::min(non_null, fraction);
+}
+
+double ColumnStatistics::EstimateComparison(const std::string &comparison, const Field &value) const {
+  double non_null = 1 - null_fraction_;
+  if (comparison == "is") {
+    return null_fraction_;
+  } else if (comparison == "not") {
+    return non_null;
+  } else if (comparison == "=") {
+    return EstimateEqual(value);
+  } else if (comparison == "<>") {
+    return std::max(0.0, non_null - EstimateEqual(value));
+  } else if (comparison == "<") {
+    return EstimateLess(value, false);
+  } else if (comparison == "<=") {
+    return EstimateLess(value, true);
+  } else if (comparison == ">") {
+    return std::max(0.0, non_null - EstimateLess(value, true));
+  } else if (comparison == ">=") {
+    return std::max(0.0, non_null - EstimateLess(value, false));
+  }
+  return 1;
+}
+
+/*
+ * 按值排序后的名次与行在表中位置的皮尔逊相关系数，相同的值按位置排
+ */
+static double Correlation(std::vector<std::pair<const Field *, uint64_t>> &placed) {
+  size_t n = placed.size();
+  if (n < 2) {
+    return 1;
+  }
+  std::sort(placed.begin(), placed.end(), [](const auto &a, const auto &b) {
+    return FieldLess(a.first, b.first) || (a.first->CompareEquals(*b.first) == CmpBool::kTrue && a.second < b.second);
+  });
+  double mean_rank = (n - 1) / 2.0, mean_position = 0;
+  for (const auto &entry : placed) {
+    mean_position += static_cast<double>(entry.second) / n;
+  }
+  double covariance = 0, rank_variance = 0, position_variance = 0;
+  for (size_t k = 0; k < n; k++) {
+    double dr = k - mean_rank;
+    double dp = placed[k].second - mean_position;
+    covariance += dr * dp;
+    rank_variance += dr * dr;
+    position_variance += dp * dp;
+  }
+  if (position_variance == 0) {
+    return 1;
+  }
+  return covariance / std::sqrt(rank_variance * position_variance);
+}
+
+/*
+ * 扫描一遍全表：精确计数，同时用蓄水池抽样保留至多SAMPLE_SIZE行
+ */
+TableStatistics *TableStatistics::Build(TableInfo *table_info, Txn *txn, uint32_t seed) {
+  auto statistics = new TableStatistics();
+  std::vector<Row> sample;
+  std::vector<uint64_t> positions;
+  sample.reserve(SAMPLE_SIZE);
+  positions.reserve(SAMPLE_SIZE);
+  uint64_t state = 0x9E3779B97F4A7C15ULL ^ seed;
+  auto next_random = [&state]() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  };
+  page_id_t last_page_id = INVALID_PAGE_ID;
+  for (auto iter = table_info->Begin(txn); iter != table_info->End(); ++iter) {
+    if (iter.GetPageId() != last_page_id) {
+      last_page_id = iter.GetPageId();
+      statistics->page_count_++;
+    }
+    uint64_t seen = statistics->row_count_++;
+    if (seen < SAMPLE_SIZE) {
+      sample.emplace_back(*iter);
+      positions.push_back(seen);
+      continue;
+    }
+    uint64_t slot = next_random() % (seen + 1);
+    if (slot < SAMPLE_SIZE) {
+      sample[slot] = *iter;
+      positions[slot] = seen;
+    }
+  }
+  statistics->BuildColumns(table_info->GetSchema(), sample, positions);
+  return statistics;
+}
+
+void TableStatistics::BuildColumns(const Schema *schema, const std::vector<Row> &sample,
+                                   const std::vector<uint64_t> &positions) {
+  sample_size_ = sample.size();
+  columns_.clear();
+  for (uint32_t c = 0; c < schema->GetColumnCount(); c++) {
+    ColumnStatistics column(schema->GetColumn(c)->GetType());
+    std::vector<const Field *> values;
+    std::vector<std::pair<const Field *, uint64_t>> placed;
+    values.reserve(sample.size());
+    placed.reserve(sample.size());
+    for (size_t i = 0; i < sample.size(); i++) {
+      const Field *field = sample[i].GetField(c);
+      if (!field->IsNull()) {
+        values.push_back(field);
+        placed.emplace_back(field, positions[i]);
+      }
+    }
+    if (!sample.empty()) {
+      column.null_fraction_ = 1 - static_cast<double>(values.size()) / sample.size();
+    }
+    std::sort(values.begin(), values.end(), FieldLess);
+    column.correlation_ = Correlation(placed);
+    // 样本中不同值的个数d，只出现一次的值的个数f1
+    size_t n = values.size();
+    double d = 0, f1 = 0;
+    for (size_t i = 0; i < n;) {
+      size_t j = i + 1;
+      while (j < n && values[j]->CompareEquals(*values[i]) == CmpBool::kTrue) {
+        j++;
+      }
+      d += 1;
+      f1 += j - i == 1 ? 1 : 0;
+      i = j;
+    }
+    // Duj1估计: D = n * d / (n - f1 + f1 * n / N)，样本即全表时D = d
+    double total = row_count_ * (1 - column.null_fraction_);
+    if (n == 0) {
+      column.distinct_ = 0;
+    } else if (n >= total) {
+      column.distinct_ = d;
+    } else {
+      column.distinct_ = n * d / (n - f1 + f1 * n / total);
+      column.distinct_ = std::min(total, std::max(d, column.distinct_));
+    }
+    // 等深直方图的边界
+    if (n > 0) {
+      size_t buckets = std::min<size_t>(ColumnStatistics::MAX_BUCKETS, n);
+      for (size_t k = 0; k <= buckets; k++) {
+        column.bounds_.emplace_back(new Field(*values[k * (n - 1) / buckets]));
+      }
+    }
+    columns_.emplace_back(std::move(column));
+  }
+}
+
+/*
+ * | MagicNum (4) | RowCount (8) | SampleSize (4) | PageCount (4) | ColumnCount (4) | Column ... |
+ * Column: | Type (4) | NullFraction (8) | Distinct (8) | Correlation (8) | BoundCount (4) | Bound ... |
+ */
+uint32_t TableStatistics::SerializeTo(char *buf) const {
+  char *p = buf;
+  MACH_WRITE_UINT32(buf, STATISTICS_MAGIC_NUM);
+  buf += 4;
+  MACH_WRITE_TO(uint64_t, buf, row_count_);
+  buf += 8;
+  MACH_WRITE_UINT32(buf, sample_size_);
+  buf += 4;
+  MACH_WRITE_UINT32(buf, page_count_);
+  buf += 4;
+  MACH_WRITE_UINT32(buf, columns_.size());
+  buf += 4;
+  for (const auto &column : columns_) {
+    MACH_WRITE_UINT32(buf, static_cast<uint32_t>(column.type_));
+    buf += 4;
+    MACH_WRITE_TO(double, buf, column.null_fraction_);
+    buf += 8;
+    MACH_WRITE_TO(double, buf, column.distinct_);
+    buf += 8;
+    MACH_WRITE_TO(double, buf, column.correlation_);
+    buf += 8;
+    MACH_WRITE_UINT32(buf, column.bounds_.size());
+    buf += 4;
+    for (const auto &bound : column.bounds_) {
+      buf += bound->SerializeTo(buf);
+    }
+  }
+  return buf - p;
+}
+
+uint32_t TableStatistics::GetSerializedSize() const {
+  uint32_t size = 4 + 8 + 4 + 4 + 4;
+  for (const auto &column : columns_) {
+    size += 4 + 8 + 8 + 8 + 4;
+    for (const auto &bound : column.bounds_) {
+      size += bound->GetSerializedSize();
+    }
+  }
+  return size;
+}
+
+uint32_t TableStatistics::DeserializeFrom(char *buf, TableStatistics *&statistics) {
+  char *p = buf;
+  uint32_t magic_num = MACH_READ_UINT32(buf);
+  buf += 4;
+  ASSERT(magic_num == STATISTICS_MAGIC_NUM, "Failed to deserialize table statistics.");
+  statistics = new TableStatistics();
+  statistics->row_count_ = MACH_READ_FROM(uint64_t, buf);
+  buf += 8;
+  statistics->sample_size_ = MACH_READ_UINT32(buf);
+  buf += 4;
+  statistics->page_count_ = MACH_READ_UINT32(buf);
+  buf += 4;
+  uint32_t column_count = MACH_READ_UINT32(buf);
+  buf += 4;
+  for (uint32_t c = 0; c < column_count; c++) {
+    ColumnStatistics column(static_cast<TypeId>(MACH_READ_UINT32(buf)));
+    buf += 4;
+    column.null_fraction_ = MACH_READ_FROM(double, buf);
+    buf += 8;
+    column.distinct_ = MACH_READ_FROM(double, buf);
+    buf += 8;
+    column.correlation_ = MACH_READ_FROM(double, buf);
+    buf += 8;
+    uint32_t bound_count = MACH_READ_UINT32(buf);
+    buf += 4;
+    for (uint32_t i = 0; i < bound_count; i++) {
+      Field *bound = nullptr;
+      buf += Field::DeserializeFrom(buf, column.type_, &bound, false);
+      column.bounds_.emplace_back(bound);
+    }
+    statistics->columns_.emplace_back(std::move(column));
+  }
+  return buf - p;
+}
+
+/*
+ * 统计信息页格式:
+ *  首页: | NextPageId (4) | DATA |
+ *  后续页: | NextPageId (4) | DATA |
+ * DATA连起来是序列化后的统计信息，开头的MagicNum用于校验
+ */
+page_id_t TableStatistics::WriteToPages(BufferPoolManager *buffer_pool_manager) const {
+  std::vector<char> data(GetSerializedSize());
+  SerializeTo(data.data());
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  page_id_t prev_page_id = INVALID_PAGE_ID;
+  size_t offset = 0;
+  while (offset < data.size()) {
+    page_id_t page_id;
+    auto page = buffer_pool_manager->NewPage(page_id);
+    if (page == nullptr) {
+      LOG(WARNING) << "No free page for the table statistics" << std::endl;
+      FreePages(buffer_pool_manager, first_page_id);
+      return INVALID_PAGE_ID;
+    }
+    size_t len = std::min(data.size() - offset, static_cast<size_t>(PAGE_SIZE - 4));
+    MACH_WRITE_TO(page_id_t, page->GetData(), INVALID_PAGE_ID);
+    memcpy(page->GetData() + 4, data.data() + offset, len);
+    offset += len;
+    buffer_pool_manager->UnpinPage(page_id, true);
+    if (prev_page_id == INVALID_PAGE_ID) {
+      first_page_id = page_id;
+    } else {
+      auto prev = buffer_pool_manager->FetchPage(prev_page_id);
+      MACH_WRITE_TO(page_id_t, prev->GetData(), page_id);
+      buffer_pool_manager->UnpinPage(prev_page_id, true);
+    }
+    prev_page_id = page_id;
+  }
+  return first_page_id;
+}
+
+TableStatistics *TableStatistics::ReadFromPages(BufferPoolManager *buffer_pool_manager, page_id_t page_id) {
+  std::vector<char> data;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = buffer_pool_manager->FetchPage(page_id);
+    if (page == nullptr) {
+      return nullptr;
+    }
+    data.insert(data.end(), page->GetData() + 4, page->GetData() + PAGE_SIZE);
+    page_id_t next = MACH_READ_FROM(page_id_t, page->GetData());
+    buffer_pool_manager->UnpinPage(page_id, false);
+    page_id = next;
+  }
+  if (data.size() < 4 || MACH_READ_UINT32(data.data()) != STATISTICS_MAGIC_NUM) {
+    return nullptr;
+  }
+  TableStatistics *statistics = nullptr;
+  DeserializeFrom(data.data(), statistics);
+  return statistics;
+}
+
+void TableStatistics::FreePages(BufferPoolManager *buffer_pool_manager, page_id_t page_id) {
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = buffer_pool_manager->FetchPage(page_id);
+    if (page == nullptr) {
+      return;
+    }
+    page_id_t next = MACH_READ_FROM(page_id_t, page->GetData());
+    buffer_pool_manager->UnpinPage(page_id, false);
+    buffer_pool_manager->DeletePage(page_id);
+    page_id = next;
+  }
+}
@@ -1,5 +1,8 @@
 #include "catalog/table.h"
 
+#include "catalog/statistics.h"
+#include "index/clustered_index.h"
+
 uint32_t TableMetadata::SerializeTo(char *buf) const {
   char *p = buf;
   uint32_t ofs = GetSerializedSize();
@@ -18,6 +21,12 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
   // table heap root page id
   MACH_WRITE_TO(page_id_t, buf, root_page_id_);
   buf += 4;
+  // clustered flag
+  MACH_WRITE_UINT32(buf, clustered_ ? 1 : 0);
+  buf += 4;
+  // statistics page id
+  MACH_WRITE_TO(page_id_t, buf, stats_page_id_);
+  buf += 4;
   // table schema
   buf += schema_->SerializeTo(buf);
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
@@ -25,7 +34,7 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
 }
 
 uint32_t TableMetadata::GetSerializedSize() const {
-  return 4 * 3 + MACH_STR_SERIALIZED_SIZE(table_name_) + schema_->GetSerializedSize();
+  return 5 * 4 + MACH_STR_SERIALIZED_SIZE(table_name_) + schema_->GetSerializedSize();
 }
 
 /**
@@ -52,11 +61,18 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
   // table heap root page id
   page_id_t root_page_id = MACH_READ_FROM(page_id_t, buf);
   buf += 4;
+  // clustered flag
+  bool clustered = MACH_READ_UINT32(buf) != 0;
+  buf += 4;
+  // statistics page id
+  page_id_t stats_page_id = MACH_READ_FROM(page_id_t, buf);
+  buf += 4;
   // table schema
   TableSchema *schema = nullptr;
   buf += TableSchema::DeserializeFrom(buf, schema);
   // allocate space for table metadata
-  table_meta = new TableMetadata(table_id, table_name, root_page_id, schema);
+  table_meta = new TableMetadata(table_id, table_name, root_page_id, schema, clustered);
+  table_meta->stats_page_id_ = stats_page_id;
   return buf - p;
 }
 
@@ -65,10 +81,62 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
  *
  * @param heap Memory heap passed by TableInfo
  */
-TableMetadata *TableMetadata::Create(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema) {
+TableMetadata *TableMetadata::Create(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema,
+                                     bool clustered) {
   // allocate space for table metadata
-  return new TableMetadata(table_id, table_name, root_page_id, schema);
+  return new TableMetadata(table_id, table_name, root_page_id, schema, clustered);
+}
+
+TableMetadata::TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema,
+                             bool clustered)
+    : table_id_(table_id), table_name_(table_name), root_page_id_(root_page_id), schema_(schema), clustered_(clustered) {}
+
+TableInfo::~TableInfo() {
+  delete table_meta_;
+  delete table_heap_;
+  delete statistics_;
+}
+
+void TableInfo::SetStatistics(TableStatistics *statistics) {
+  delete statistics_;
+  statistics_ = statistics;
+}
+
+bool TableInfo::InsertTuple(Row &row, Txn *txn) {
+  if (IsClustered()) {
+    return clustered_index_->InsertRow(row, txn);
+  }
+  return table_heap_->InsertTuple(row, txn);
 }
 
-TableMetadata::TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema)
-    : table_id_(table_id), table_name_(table_name), root_page_id_(root_page_id), schema_(schema) {}
+bool TableInfo::MarkDelete(const RowId &rid, Txn *txn) {
+  if (IsClustered()) {
+    return clustered_index_->RemoveRow(rid, txn);
+  }
+  return table_heap_->MarkDelete(rid, txn);
+}
+
+bool TableInfo::UpdateTuple(Row &row, const RowId &rid, Txn *txn) {
+  if (IsClustered()) {
+    return clustered_index_->UpdateRow(row, rid, txn);
+  }
+  return table_heap_->UpdateTuple(row, rid, txn);
+}
+
+bool TableInfo::GetTuple(Row *row, Txn *txn) {
+  if (IsClustered()) {
+    return clustered_index_->GetRow(row, txn);
+  }
+  return table_heap_->GetTuple(row, txn);
+}
+
+TableIterator TableInfo::Begin(Txn *txn) {
+  if (IsClustered()) {
+    return clustered_index_->Begin(txn);
+  }
+  return table_heap_->Begin(txn);
+}
+
+TableIterator TableInfo::End() {
+  return TableIterator(nullptr, nullptr, nullptr);
+}
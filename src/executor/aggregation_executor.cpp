@@ -0,0 +1,402 @@
+#include "executor/executors/aggregation_executor.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "index/bloom_filter.h"
+
+AggregationExecutor::AggregationExecutor(ExecuteContext *exec_ctx, const AggregationPlanNode *plan,
+                                         std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+void AggregationExecutor::Init() {
+  child_->Init();
+  const Schema *input_schema = child_->GetOutputSchema();
+  key_schema_.reset(Schema::ShallowCopySchema(input_schema, plan_->GetGroupBys()));
+  const auto &types = plan_->GetAggregateTypes();
+  states_.assign(types.size(), AggregateStates());
+  state_bytes_ = 0;
+  for (size_t k = 0; k < types.size(); k++) {
+    // 每个聚集按输入列的类型选一种状态数组，avg总是累加double
+    TypeId column_type = types[k] == AggregationType::CountStarAggregate
+                             ? kTypeInvalid
+                             : input_schema->GetColumn(plan_->GetAggregateColumns()[k])->GetType();
+    switch (types[k]) {
+      case AggregationType::CountStarAggregate:
+      case AggregationType::CountAggregate:
+        states_[k].value_type_ = kTypeInvalid;
+        break;
+      case AggregationType::AvgAggregate:
+        states_[k].value_type_ = kTypeFloat;
+        break;
+      default:
+        states_[k].value_type_ = column_type;
+        break;
+    }
+    state_bytes_ += sizeof(int64_t) + (states_[k].value_type_ == kTypeChar
+                                           ? sizeof(std::string)
+                                           : (states_[k].value_type_ == kTypeInvalid ? 0 : sizeof(int64_t)));
+  }
+  ResetGroups();
+  spilled_ = false;
+  partitions_.clear();
+  partition_ = 0;
+  cursor_ = 0;
+  row_chunk_.Reset(GetOutputSchema());
+  row_pos_ = 0;
+  DataChunk input;
+  if (plan_->GetGroupBys().empty()) {
+    // 不分组时只有一个组，不用hash表
+    AddStates();
+    group_count_ = 1;
+    while (child_->NextBatch(&input)) {
+      UpdateStates(input, [](size_t) { return 0U; });
+    }
+    return;
+  }
+  while (child_->NextBatch(&input)) {
+    AggregateChunk(input, true);
+  }
+  for (auto &partition : partitions_) {
+    partition->Rewind();
+  }
+}
+
+bool AggregationExecutor::Next(Row *row, RowId *rid) {
+  while (row_pos_ >= row_chunk_.GetSelectedCount()) {
+    if (!NextBatch(&row_chunk_)) {
+      return false;
+    }
+    row_pos_ = 0;
+  }
+  row_chunk_.GetRow(row_pos_++, row);
+  *rid = row->GetRowId();
+  return true;
+}
+
+bool AggregationExecutor::NextBatch(DataChunk *chunk) {
+  chunk->Reset(GetOutputSchema());
+  while (cursor_ >= group_count_) {
+    if (!LoadPartition()) {
+      return false;
+    }
+  }
+  const auto &output_columns = plan_->GetOutputColumns();
+  size_t end = std::min(group_count_, cursor_ + DataChunk::CAPACITY);
+  std::vector<Field> fields;
+  for (; cursor_ < end; cursor_++) {
+    fields.clear();
+    for (const auto &column : output_columns) {
+      fields.push_back(column.first == 0 ? groups_.GetColumn(column.second).GetField(cursor_)
+                                         : FinalValue(column.second, cursor_));
+    }
+    chunk->AppendRow(Row(fields), RowId());
+  }
+  return true;
+}
+
+void AggregationExecutor::ResetGroups() {
+  groups_ = DataChunk();
+  groups_.Reset(key_schema_.get());
+  group_hashes_.clear();
+  group_count_ = 0;
+  slots_.assign(16, NO_GROUP);
+  mask_ = slots_.size() - 1;
+  for (auto &state : states_) {
+    state.counts_.clear();
+    state.ints_.clear();
+    state.doubles_.clear();
+    state.chars_.clear();
+  }
+  char_bytes_ = 0;
+}
+
+void AggregationExecutor::AggregateChunk(const DataChunk &chunk, bool may_spill) {
+  const auto &selection = chunk.GetSelection();
+  row_groups_.resize(selection.size());
+  for (size_t i = 0; i < selection.size(); i++) {
+    uint32_t pos = selection[i];
+    uint64_t hash = HashKeys(chunk, pos);
+    uint32_t group = FindOrAddGroup(chunk, pos, hash, may_spill);
+    if (group == NO_GROUP) {
+      // 内存满后新组的行按hash的高位分区写到临时页，已有的组仍在内存里聚集
+      if (!spilled_) {
+        spilled_ = true;
+        for (size_t p = 0; p < PARTITION_COUNT; p++) {
+          partitions_.push_back(
+              std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager(), child_->GetOutputSchema()));
+        }
+      }
+      partitions_[(hash >> 32) % PARTITION_COUNT]->AppendRowAt(chunk, pos);
+    }
+    row_groups_[i] = group;
+  }
+  UpdateStates(chunk, [this](size_t i) { return row_groups_[i]; });
+}
+
+template <typename GroupOf>
+void AggregationExecutor::UpdateStates(const DataChunk &chunk, GroupOf group_of) {
+  const auto &selection = chunk.GetSelection();
+  const auto &types = plan_->GetAggregateTypes();
+  // 每个聚集按类型走一个循环，跳过null参数
+  auto for_each = [&](const uint8_t *nulls, auto update) {
+    for (size_t i = 0; i < selection.size(); i++) {
+      uint32_t pos = selection[i];
+      uint32_t group = group_of(i);
+      if (group != NO_GROUP && (nulls == nullptr || nulls[pos] == 0)) {
+        update(group, pos);
+      }
+    }
+  };
+  for (size_t k = 0; k < types.size(); k++) {
+    AggregateStates &state = states_[k];
+    int64_t *counts = state.counts_.data();
+    if (types[k] == AggregationType::CountStarAggregate) {
+      for_each(nullptr, [counts](uint32_t group, uint32_t) { counts[group]++; });
+      continue;
+    }
+    const ColumnVector &column = chunk.GetColumn(plan_->GetAggregateColumns()[k]);
+    const uint8_t *nulls = column.GetNulls();
+    const int32_t *ints = column.GetInts();
+    const float *floats = column.GetFloats();
+    switch (types[k]) {
+      case AggregationType::CountAggregate:
+        for_each(nulls, [counts](uint32_t group, uint32_t) { counts[group]++; });
+        break;
+      case AggregationType::SumAggregate:
+      case AggregationType::AvgAggregate:
+        if (state.value_type_ == kTypeInt) {
+          int64_t *sums = state.ints_.data();
+          for_each(nulls, [counts, sums, ints](uint32_t group, uint32_t pos) {
+            sums[group] += ints[pos];
+            counts[group]++;
+          });
+        } else if (column.GetType() == kTypeInt) {
+          double *sums = state.doubles_.data();
+          for_each(nulls, [counts, sums, ints](uint32_t group, uint32_t pos) {
+            sums[group] += ints[pos];
+            counts[group]++;
+          });
+        } else {
+          double *sums = state.doubles_.data();
+          for_each(nulls, [counts, sums, floats](uint32_t group, uint32_t pos) {
+            sums[group] += floats[pos];
+            counts[group]++;
+          });
+        }
+        break;
+      case AggregationType::MinAggregate:
+      case AggregationType::MaxAggregate: {
+        bool is_min = types[k] == AggregationType::MinAggregate;
+        if (state.value_type_ == kTypeInt) {
+          int64_t *values = state.ints_.data();
+          for_each(nulls, [counts, values, ints, is_min](uint32_t group, uint32_t pos) {
+            if (counts[group]++ == 0 || (is_min ? ints[pos] < values[group] : ints[pos] > values[group])) {
+              values[group] = ints[pos];
+            }
+          });
+        } else if (state.value_type_ == kTypeFloat) {
+          double *values = state.doubles_.data();
+          for_each(nulls, [counts, values, floats, is_min](uint32_t group, uint32_t pos) {
+            if (counts[group]++ == 0 || (is_min ? floats[pos] < values[group] : floats[pos] > values[group])) {
+              values[group] = floats[pos];
+            }
+          });
+        } else {
+          auto &values = state.chars_;
+          for_each(nulls, [&](uint32_t group, uint32_t pos) {
+            const char *data = column.GetChars(pos);
+            uint32_t length = column.GetLength(pos);
+            int cmp = counts[group] == 0 ? 0 : values[group].compare(0, std::string::npos, data, length);
+            if (counts[group]++ == 0 || (is_min ? cmp > 0 : cmp < 0)) {
+              char_bytes_ += length;
+              char_bytes_ -= values[group].size();
+              values[group].assign(data, length);
+            }
+          });
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+uint32_t AggregationExecutor::FindOrAddGroup(const DataChunk &chunk, uint32_t pos, uint64_t hash, bool may_spill) {
+  for (size_t slot = hash & mask_; slots_[slot] != NO_GROUP; slot = (slot + 1) & mask_) {
+    uint32_t group = slots_[slot];
+    if (group_hashes_[group] == hash && KeysEqual(group, chunk, pos)) {
+      return group;
+    }
+  }
+  if (may_spill && GroupMemory() > exec_ctx_->GetWorkMemory()) {
+    return NO_GROUP;
+  }
+  return AddGroup(chunk, pos, hash);
+}
+
+uint32_t AggregationExecutor::AddGroup(const DataChunk &chunk, uint32_t pos, uint64_t hash) {
+  // 负载不超过一半
+  if ((group_count_ + 1) * 2 > slots_.size()) {
+    Grow();
+  }
+  size_t slot = hash & mask_;
+  while (slots_[slot] != NO_GROUP) {
+    slot = (slot + 1) & mask_;
+  }
+  slots_[slot] = group_count_;
+  groups_.AppendRowAt(chunk, pos, plan_->GetGroupBys());
+  group_hashes_.push_back(hash);
+  AddStates();
+  return group_count_++;
+}
+
+void AggregationExecutor::AddStates() {
+  for (auto &state : states_) {
+    state.counts_.push_back(0);
+    switch (state.value_type_) {
+      case kTypeInt:
+        state.ints_.push_back(0);
+        break;
+      case kTypeFloat:
+        state.doubles_.push_back(0);
+        break;
+      case kTypeChar:
+        state.chars_.emplace_back();
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void AggregationExecutor::Grow() {
+  slots_.assign(slots_.size() * 2, NO_GROUP);
+  mask_ = slots_.size() - 1;
+  for (uint32_t group = 0; group < group_count_; group++) {
+    size_t slot = group_hashes_[group] & mask_;
+    while (slots_[slot] != NO_GROUP) {
+      slot = (slot + 1) & mask_;
+    }
+    slots_[slot] = group;
+  }
+}
+
+uint64_t AggregationExecutor::HashKeys(const DataChunk &chunk, uint32_t pos) const {
+  uint64_t result = 0;
+  for (auto key : plan_->GetGroupBys()) {
+    const ColumnVector &column = chunk.GetColumn(key);
+    uint64_t value_hash;
+    if (column.IsNull(pos)) {
+      // null也是一个组
+      value_hash = 0x9e3779b97f4a7c15ULL;
+    } else {
+      switch (column.GetType()) {
+        case kTypeInt:
+          value_hash = BloomFilter::Hash(reinterpret_cast<const char *>(column.GetInts() + pos), sizeof(int32_t));
+          break;
+        case kTypeFloat: {
+          // -0和0是同一组，hash也要相同
+          float value = column.GetFloats()[pos] == 0 ? 0.0f : column.GetFloats()[pos];
+          value_hash = BloomFilter::Hash(reinterpret_cast<const char *>(&value), sizeof(float));
+          break;
+        }
+        default:
+          value_hash = BloomFilter::Hash(column.GetChars(pos), column.GetLength(pos));
+          break;
+      }
+    }
+    result = result * 0x100000001b3ULL ^ value_hash;
+  }
+  return result;
+}
+
+bool AggregationExecutor::KeysEqual(uint32_t group, const DataChunk &chunk, uint32_t pos) const {
+  const auto &group_bys = plan_->GetGroupBys();
+  for (size_t k = 0; k < group_bys.size(); k++) {
+    const ColumnVector &key = groups_.GetColumn(k);
+    const ColumnVector &column = chunk.GetColumn(group_bys[k]);
+    if (key.IsNull(group) || column.IsNull(pos)) {
+      if (key.IsNull(group) != column.IsNull(pos)) {
+        return false;
+      }
+      continue;
+    }
+    switch (key.GetType()) {
+      case kTypeInt:
+        if (key.GetInts()[group] != column.GetInts()[pos]) {
+          return false;
+        }
+        break;
+      case kTypeFloat:
+        if (key.GetFloats()[group] != column.GetFloats()[pos]) {
+          return false;
+        }
+        break;
+      default:
+        if (key.GetLength(group) != column.GetLength(pos) ||
+            memcmp(key.GetChars(group), column.GetChars(pos), key.GetLength(group)) != 0) {
+          return false;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+size_t AggregationExecutor::GroupMemory() const {
+  return groups_.GetMemoryUsage() + slots_.size() * sizeof(uint32_t) + group_hashes_.size() * sizeof(uint64_t) +
+         group_count_ * state_bytes_ + char_bytes_;
+}
+
+Field AggregationExecutor::FinalValue(size_t agg, uint32_t group) const {
+  const AggregateStates &state = states_[agg];
+  int64_t count = state.counts_[group];
+  switch (plan_->GetAggregateTypes()[agg]) {
+    case AggregationType::CountStarAggregate:
+    case AggregationType::CountAggregate:
+      return Field(kTypeInt, static_cast<int32_t>(count));
+    case AggregationType::AvgAggregate:
+      return count == 0 ? Field(kTypeFloat) : Field(kTypeFloat, static_cast<float>(state.doubles_[group] / count));
+    default:
+      break;
+  }
+  if (count == 0) {
+    return Field(state.value_type_);
+  }
+  switch (state.value_type_) {
+    case kTypeInt: {
+      int64_t value = state.ints_[group];
+      if (value < INT32_MIN || value > INT32_MAX) {
+        throw std::runtime_error("integer out of range in sum");
+      }
+      return Field(kTypeInt, static_cast<int32_t>(value));
+    }
+    case kTypeFloat:
+      return Field(kTypeFloat, static_cast<float>(state.doubles_[group]));
+    default:
+      return Field(kTypeChar, const_cast<char *>(state.chars_[group].data()), state.chars_[group].size(), true);
+  }
+}
+
+bool AggregationExecutor::LoadPartition() {
+  if (!spilled_) {
+    return false;
+  }
+  while (partition_ < PARTITION_COUNT) {
+    // 读完的分区释放临时页
+    auto partition = std::move(partitions_[partition_++]);
+    if (partition->GetRowCount() == 0) {
+      continue;
+    }
+    ResetGroups();
+    DataChunk input;
+    while (partition->Read(&input)) {
+      AggregateChunk(input, false);
+    }
+    cursor_ = 0;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,51 @@
+#include "executor/executors/bitmap_heap_scan_executor.h"
+
+#include <algorithm>
+
+BitmapHeapScanExecutor::BitmapHeapScanExecutor(ExecuteContext *exec_ctx, const BitmapHeapScanPlanNode *plan)
+    : IndexScanExecutor(exec_ctx, plan) {}
+
+void BitmapHeapScanExecutor::Init() {
+  IndexScanExecutor::Init();
+  page_rows_.clear();
+  page_cursor_ = 0;
+  pages_read_ = 0;
+  // clustered table的行在叶子上(rows_)，结果很少时逐行读
+  bitmap_ = !table_info_->IsClustered() && result_.size() >= BitmapHeapScanPlanNode::MIN_BITMAP_ROWS;
+  if (bitmap_ && !std::is_sorted(result_.begin(), result_.end(),
+                                 [](const RowId &a, const RowId &b) { return a.Get() < b.Get(); })) {
+    std::sort(result_.begin(), result_.end(), [](const RowId &a, const RowId &b) { return a.Get() < b.Get(); });
+  }
+}
+
+/*
+ * 同一页的row id在排序后相邻，一次pin住整页读出所有行
+ */
+bool BitmapHeapScanExecutor::ReadNextPage() {
+  page_rows_.clear();
+  page_cursor_ = 0;
+  while (page_rows_.empty() && cursor_ < result_.size()) {
+    page_id_t page_id = result_[cursor_].GetPageId();
+    size_t end = cursor_ + 1;
+    while (end < result_.size() && result_[end].GetPageId() == page_id) {
+      end++;
+    }
+    table_info_->GetTableHeap()->GetTuples(result_.begin() + cursor_, result_.begin() + end, page_rows_, nullptr);
+    pages_read_++;
+    cursor_ = end;
+  }
+  return !page_rows_.empty();
+}
+
+bool BitmapHeapScanExecutor::Next(Row *row, RowId *rid) {
+  if (!bitmap_) {
+    return IndexScanExecutor::Next(row, rid);
+  }
+  while (page_cursor_ < page_rows_.size() || ReadNextPage()) {
+    const Row &source = page_rows_[page_cursor_++];
+    if (Emit(source, source.GetRowId(), row, rid)) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -13,19 +13,91 @@ void DeleteExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
   exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->GetTableName(), index_info_);
   txn_ = exec_ctx_->GetTransaction();
+  // 删除会合并clustered table的叶子，先取出所有要删除的记录再删除
+  if (table_info_->IsClustered()) {
+    Row row;
+    RowId rid;
+    while (NextChild(&row, &rid)) {
+      row.SetRowId(rid);
+      source_rows_.push_back(row);
+    }
+    source_drained_ = true;
+  }
 }
 
-bool DeleteExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
-  if (child_executor_->Next(row, rid)) {
-    if (!table_info_->GetTableHeap()->MarkDelete(*rid, txn_)) {
+bool DeleteExecutor::NextChild(Row *row, RowId *rid) {
+  while (child_cursor_ >= child_chunk_.GetSelectedCount()) {
+    // 子节点取完后chunk被清空，游标也要归零
+    child_cursor_ = 0;
+    if (!child_executor_->NextBatch(&child_chunk_)) {
       return false;
     }
-    Row key_row;
-    for (auto info : index_info_) {  // 更新索引
-      row->GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), key_row);
-      info->GetIndex()->RemoveEntry(key_row, *rid, txn_);
+  }
+  child_chunk_.GetRow(child_cursor_++, row);
+  *rid = row->GetRowId();
+  return true;
+}
+
+bool DeleteExecutor::NextSource(Row *row, RowId *rid) {
+  if (!source_drained_) {
+    return NextChild(row, rid);
+  }
+  if (source_cursor_ == source_rows_.size()) {
+    return false;
+  }
+  *row = source_rows_[source_cursor_++];
+  *rid = row->GetRowId();
+  return true;
+}
+
+bool DeleteExecutor::Next(Row *row, RowId *rid) {
+  if (cursor_ == rows_.size() && !DeleteBatch()) {
+    return false;
+  }
+  *row = rows_[cursor_];
+  *rid = row->GetRowId();
+  cursor_++;
+  return true;
+}
+
+bool DeleteExecutor::NextBatch(DataChunk *chunk) {
+  chunk->Reset(GetOutputSchema());
+  if (cursor_ == rows_.size() && !DeleteBatch()) {
+    return false;
+  }
+  for (; cursor_ < rows_.size(); cursor_++) {
+    chunk->AppendRow(rows_[cursor_], rows_[cursor_].GetRowId());
+  }
+  return true;
+}
+
+bool DeleteExecutor::DeleteBatch() {
+  rows_.clear();
+  cursor_ = 0;
+  if (stopped_) {
+    return false;
+  }
+  Row row;
+  RowId rid;
+  std::vector<RowId> rids;
+  while (rows_.size() < DML_BATCH_SIZE && NextSource(&row, &rid)) {
+    if (!table_info_->MarkDelete(rid, txn_)) {
+      stopped_ = true;
+      break;
     }
-    return true;
+    row.SetRowId(rid);
+    rows_.push_back(row);
+    rids.push_back(rid);
+  }
+  if (rows_.empty()) {
+    return false;
   }
-  return false;
-}
\ No newline at end of file
+  std::vector<Row> keys(rows_.size());
+  for (auto info : index_info_) {  // 更新索引
+    for (size_t i = 0; i < rows_.size(); i++) {
+      rows_[i].GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), keys[i]);
+    }
+    info->RemoveEntries(keys, rids, txn_);
+  }
+  return true;
+}
@@ -1,16 +1,29 @@
 #include "executor/execute_engine.h"
 
 #include <dirent.h>
+#include <strings.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
+#include <iomanip>
 
+#include "catalog/statistics.h"
 #include "common/result_writer.h"
+#include "executor/executors/aggregation_executor.h"
+#include "executor/executors/bitmap_heap_scan_executor.h"
 #include "executor/executors/delete_executor.h"
+#include "executor/executors/hash_join_executor.h"
+#include "executor/executors/index_nested_loop_join_executor.h"
+#include "executor/executors/index_only_scan_executor.h"
 #include "executor/executors/index_scan_executor.h"
 #include "executor/executors/insert_executor.h"
+#include "executor/executors/limit_executor.h"
+#include "executor/executors/parallel_seq_scan_executor.h"
 #include "executor/executors/seq_scan_executor.h"
+#include "executor/executors/sort_executor.h"
 #include "executor/executors/update_executor.h"
 #include "executor/executors/values_executor.h"
 #include "glog/logging.h"
@@ -43,12 +56,24 @@ std::unique_ptr<AbstractExecutor> ExecuteEngine::CreateExecutor(ExecuteContext *
   switch (plan->GetType()) {
     // Create a new sequential scan executor
     case PlanType::SeqScan: {
-      return std::make_unique<SeqScanExecutor>(exec_ctx, dynamic_cast<const SeqScanPlanNode *>(plan.get()));
+      auto seq_scan_plan = dynamic_cast<const SeqScanPlanNode *>(plan.get());
+      if (seq_scan_plan->GetParallelism() > 1) {
+        return std::make_unique<ParallelSeqScanExecutor>(exec_ctx, seq_scan_plan);
+      }
+      return std::make_unique<SeqScanExecutor>(exec_ctx, seq_scan_plan);
     }
     // Create a new index scan executor
     case PlanType::IndexScan: {
       return std::make_unique<IndexScanExecutor>(exec_ctx, dynamic_cast<const IndexScanPlanNode *>(plan.get()));
     }
+    case PlanType::IndexOnlyScan: {
+      return std::make_unique<IndexOnlyScanExecutor>(exec_ctx,
+                                                     dynamic_cast<const IndexOnlyScanPlanNode *>(plan.get()));
+    }
+    case PlanType::BitmapHeapScan: {
+      return std::make_unique<BitmapHeapScanExecutor>(exec_ctx,
+                                                      dynamic_cast<const BitmapHeapScanPlanNode *>(plan.get()));
+    }
     // Create a new update executor
     case PlanType::Update: {
       auto update_plan = dynamic_cast<const UpdatePlanNode *>(plan.get());
@@ -69,6 +94,31 @@ std::unique_ptr<AbstractExecutor> ExecuteEngine::CreateExecutor(ExecuteContext *
     case PlanType::Values: {
       return std::make_unique<ValuesExecutor>(exec_ctx, dynamic_cast<const ValuesPlanNode *>(plan.get()));
     }
+    case PlanType::HashJoin: {
+      auto hash_join_plan = dynamic_cast<const HashJoinPlanNode *>(plan.get());
+      auto left_executor = CreateExecutor(exec_ctx, hash_join_plan->GetLeftPlan());
+      auto right_executor = CreateExecutor(exec_ctx, hash_join_plan->GetRightPlan());
+      return std::make_unique<HashJoinExecutor>(exec_ctx, hash_join_plan, std::move(left_executor),
+                                                std::move(right_executor));
+    }
+    case PlanType::Aggregation: {
+      auto aggregation_plan = dynamic_cast<const AggregationPlanNode *>(plan.get());
+      return std::make_unique<AggregationExecutor>(exec_ctx, aggregation_plan,
+                                                   CreateExecutor(exec_ctx, aggregation_plan->GetChildPlan()));
+    }
+    case PlanType::Limit: {
+      auto limit_plan = dynamic_cast<const LimitPlanNode *>(plan.get());
+      return std::make_unique<LimitExecutor>(exec_ctx, limit_plan, CreateExecutor(exec_ctx, limit_plan->GetChildPlan()));
+    }
+    case PlanType::Sort: {
+      auto sort_plan = dynamic_cast<const SortPlanNode *>(plan.get());
+      return std::make_unique<SortExecutor>(exec_ctx, sort_plan, CreateExecutor(exec_ctx, sort_plan->GetChildPlan()));
+    }
+    case PlanType::IndexNestedLoopJoin: {
+      auto index_join_plan = dynamic_cast<const IndexNestedLoopJoinPlanNode *>(plan.get());
+      return std::make_unique<IndexNestedLoopJoinExecutor>(exec_ctx, index_join_plan,
+                                                           CreateExecutor(exec_ctx, index_join_plan->GetOuterPlan()));
+    }
     default:
       throw std::logic_error("Unsupported plan type.");
   }
@@ -76,23 +126,33 @@ std::unique_ptr<AbstractExecutor> ExecuteEngine::CreateExecutor(ExecuteContext *
 
 dberr_t ExecuteEngine::ExecutePlan(const AbstractPlanNodeRef &plan, std::vector<Row> *result_set, Txn *txn,
                                    ExecuteContext *exec_ctx) {
+  if (result_set == nullptr) {
+    ResultSink counter;
+    return ExecutePlan(plan, &counter, txn, exec_ctx);
+  }
+  RowCollector collector(result_set);
+  dberr_t result = ExecutePlan(plan, &collector, txn, exec_ctx);
+  if (result != DB_SUCCESS) {
+    result_set->clear();
+  }
+  return result;
+}
+
+dberr_t ExecuteEngine::ExecutePlan(const AbstractPlanNodeRef &plan, ResultSink *sink, Txn *txn,
+                                   ExecuteContext *exec_ctx) {
   // Construct the executor for the abstract plan node
   auto executor = CreateExecutor(exec_ctx, plan);
 
   try {
     executor->Init();
-    RowId rid{};
-    Row row{};
-    while (executor->Next(&row, &rid)) {
-      if (result_set != nullptr) {
-        result_set->push_back(row);
-      }
+    sink->Begin(plan->OutputSchema());
+    DataChunk chunk;
+    while (executor->NextBatch(&chunk)) {
+      sink->Consume(chunk);
     }
+    sink->End();
   } catch (const exception &ex) {
     std::cout << "Error Encountered in Executor Execution: " << ex.what() << std::endl;
-    if (result_set != nullptr) {
-      result_set->clear();
-    }
     return DB_FAILED;
   }
   return DB_SUCCESS;
@@ -104,7 +164,12 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
   }
   auto start_time = std::chrono::system_clock::now();
   unique_ptr<ExecuteContext> context(nullptr);
-  if (!current_db_.empty()) context = dbs_[current_db_]->MakeExecuteContext(nullptr);
+  if (!current_db_.empty()) {
+    context = dbs_[current_db_]->MakeExecuteContext(nullptr);
+    context->SetParallelism(parallelism_);
+    context->SetScanOrderPreserved(preserve_scan_order_);
+    context->SetWorkMemory(work_memory_);
+  }
   switch (ast->type_) {
     case kNodeCreateDB:
       return ExecuteCreateDatabase(ast, context.get());
@@ -120,6 +185,10 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
       return ExecuteCreateTable(ast, context.get());
     case kNodeDropTable:
       return ExecuteDropTable(ast, context.get());
+    case kNodeAnalyze:
+      return ExecuteAnalyze(ast, context.get());
+    case kNodeExplain:
+      return ExecuteExplain(ast, context.get());
     case kNodeShowIndexes:
       return ExecuteShowIndexes(ast, context.get());
     case kNodeCreateIndex:
@@ -136,68 +205,38 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
       return ExecuteExecfile(ast, context.get());
     case kNodeQuit:
       return ExecuteQuit(ast, context.get());
+    case kNodeSet:
+      return ExecuteSet(ast, context.get());
     default:
       break;
   }
   // Plan the query.
   Planner planner(context.get());
-  std::vector<Row> result_set{};
   try {
     planner.PlanQuery(ast);
-    // Execute the query.
-    ExecutePlan(planner.plan_, &result_set, nullptr, context.get());
   } catch (const exception &ex) {
     std::cout << "Error Encountered in Planner: " << ex.what() << std::endl;
     return DB_FAILED;
   }
+  auto type = planner.plan_->GetType();
+  bool is_query = type == PlanType::SeqScan || type == PlanType::IndexScan || type == PlanType::IndexOnlyScan ||
+                  type == PlanType::BitmapHeapScan || type == PlanType::HashJoin ||
+                  type == PlanType::IndexNestedLoopJoin || type == PlanType::Aggregation || type == PlanType::Sort ||
+                  type == PlanType::Limit;
+  // 查询的行边执行边输出，其他语句只计数
+  std::unique_ptr<ResultSink> sink =
+      is_query ? ResultSink::Create(output_format_, std::cout) : std::make_unique<ResultSink>();
+  if (ExecutePlan(planner.plan_, sink.get(), nullptr, context.get()) != DB_SUCCESS) {
+    return DB_FAILED;
+  }
   auto stop_time = std::chrono::system_clock::now();
   double duration_time =
       double((std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time)).count());
-  // Return the result set as string.
+  // tsv和二进制输出留给程序读取，统计信息写到stderr
   std::stringstream ss;
   ResultWriter writer(ss);
-
-  if (planner.plan_->GetType() == PlanType::SeqScan || planner.plan_->GetType() == PlanType::IndexScan) {
-    auto schema = planner.plan_->OutputSchema();
-    auto num_of_columns = schema->GetColumnCount();
-    if (!result_set.empty()) {
-      // find the max width for each column
-      vector<int> data_width(num_of_columns, 0);
-      for (const auto &row : result_set) {
-        for (uint32_t i = 0; i < num_of_columns; i++) {
-          data_width[i] = max(data_width[i], int(row.GetField(i)->toString().size()));
-        }
-      }
-      int k = 0;
-      for (const auto &column : schema->GetColumns()) {
-        data_width[k] = max(data_width[k], int(column->GetName().length()));
-        k++;
-      }
-      // Generate header for the result set.
-      writer.Divider(data_width);
-      k = 0;
-      writer.BeginRow();
-      for (const auto &column : schema->GetColumns()) {
-        writer.WriteHeaderCell(column->GetName(), data_width[k++]);
-      }
-      writer.EndRow();
-      writer.Divider(data_width);
-
-      // Transforming result set into strings.
-      for (const auto &row : result_set) {
-        writer.BeginRow();
-        for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
-          writer.WriteCell(row.GetField(i)->toString(), data_width[i]);
-        }
-        writer.EndRow();
-      }
-      writer.Divider(data_width);
-    }
-    writer.EndInformation(result_set.size(), duration_time, true);
-  } else {
-    writer.EndInformation(result_set.size(), duration_time, false);
-  }
-  std::cout << writer.stream_.rdbuf();
+  writer.EndInformation(sink->GetRowCount(), duration_time, is_query);
+  (is_query && output_format_ != OutputFormat::kTable ? std::cerr : std::cout) << writer.stream_.rdbuf();
   return DB_SUCCESS;
 }
 
@@ -427,9 +466,25 @@ dberr_t ExecuteEngine::ExecuteCreateTable(pSyntaxNode ast, ExecuteContext *conte
       return DB_FAILED;
     }
   }
+  // 建表选项，CLUSTERED表示记录按主键存放在主键索引中
+  bool clustered = false;
+  auto option_node = column_definition_list_node->next_;
+  if (option_node != nullptr && option_node->type_ == kNodeTableOption) {
+    string option(option_node->child_->val_);
+    std::transform(option.begin(), option.end(), option.begin(), ::tolower);
+    if (option != "clustered") {
+      cout << "Unknown table option " + option << endl;
+      return DB_FAILED;
+    }
+    clustered = true;
+  }
   Schema *schema = new Schema(columns);
   // 建表
-  dbs_[current_db_]->catalog_mgr_->CreateTable(table_name, schema, context->GetTransaction(), table_info);
+  if (dbs_[current_db_]->catalog_mgr_->CreateTable(table_name, schema, context->GetTransaction(), table_info, clustered) != DB_SUCCESS) {
+    cout << "Table " + table_name + " can not be clustered, it needs a single int primary key and a row of at most "
+         << ClusteredIndex::MAX_KEY_SIZE << " bytes" << endl;
+    return DB_FAILED;
+  }
   cout << "Table " + table_name + " is created successfully" << endl;
   return DB_SUCCESS;
 }
@@ -451,6 +506,66 @@ dberr_t ExecuteEngine::ExecuteDropTable(pSyntaxNode ast, ExecuteContext *context
   return DB_SUCCESS;
 }
 
+dberr_t ExecuteEngine::ExecuteAnalyze(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteAnalyze" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    cout << "No database selected" << endl;
+    return DB_FAILED;
+  }
+  string table_name = ast->child_->val_;
+  auto catalog = dbs_[current_db_]->catalog_mgr_;
+  dberr_t result = catalog->AnalyzeTable(table_name, nullptr);
+  if (result == DB_TABLE_NOT_EXIST) {
+    cout << "Table " + table_name + " doesn't exist" << endl;
+    return DB_FAILED;
+  }
+  if (result != DB_SUCCESS) {
+    cout << "Failed to analyze table " + table_name << endl;
+    return DB_FAILED;
+  }
+  TableInfo *table_info = nullptr;
+  catalog->GetTable(table_name, table_info);
+  auto statistics = table_info->GetStatistics();
+  cout << "Table " + table_name + " analyzed: " << statistics->GetRowCount() << " rows, "
+       << statistics->GetSampleSize() << " sampled" << endl;
+  return DB_SUCCESS;
+}
+
+/**
+ * 每个计划节点一行，子节点缩进；ANALYZE过的表附上估计的行数和代价
+ */
+dberr_t ExecuteEngine::ExecuteExplain(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteExplain" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    cout << "No database selected" << endl;
+    return DB_FAILED;
+  }
+  Planner planner(context);
+  try {
+    planner.PlanQuery(ast->child_);
+  } catch (const exception &ex) {
+    std::cout << "Error Encountered in Planner: " << ex.what() << std::endl;
+    return DB_FAILED;
+  }
+  std::function<void(const AbstractPlanNodeRef &, int)> print = [&print](const AbstractPlanNodeRef &plan, int depth) {
+    cout << string(depth * 2, ' ') << (depth == 0 ? "" : "-> ") << plan->ToString();
+    if (plan->GetEstimatedCost() >= 0) {
+      cout << fixed << setprecision(2) << "  (rows=" << plan->GetEstimatedRows()
+           << " cost=" << plan->GetEstimatedCost() << ")" << defaultfloat;
+    }
+    cout << endl;
+    for (const auto &child : plan->GetChildren()) {
+      print(child, depth + 1);
+    }
+  };
+  print(planner.plan_, 0);
+  return DB_SUCCESS;
+}
+
 dberr_t ExecuteEngine::ExecuteShowIndexes(pSyntaxNode ast, ExecuteContext *context) {
 #ifdef ENABLE_EXECUTE_DEBUG
   LOG(INFO) << "ExecuteShowIndexes" << std::endl;
@@ -476,33 +591,63 @@ dberr_t ExecuteEngine::ExecuteShowIndexes(pSyntaxNode ast, ExecuteContext *conte
     cout << "Empty set (0.00 sec)" << endl;
     return DB_SUCCESS;
   }
-  uint max_table_name_width = 10; // "Table_name"
-  uint max_index_name_width = 10; // "Index_name"
+  // b+树索引显示常驻buffer pool的上层页占用的内存，art索引显示整棵树占用的内存，bloom filter也常驻内存
+  vector<string> header{"Table_name", "Index_name", "Index_type", "Pinned_levels", "Pinned_memory", "Bloom_filter"};
+  vector<vector<string>> rows;
+  size_t total_pinned_bytes = 0;
   for (const auto &itr : tables) {
-      if (itr->GetTableName().length() > max_table_name_width) max_table_name_width = itr->GetTableName().length();
-      vector<IndexInfo *> indexes;
-      dbs_[current_db_]->catalog_mgr_->GetTableIndexes(itr->GetTableName(), indexes);
-      for (const auto &index : indexes) {
-          if (index->GetIndexName().length() > max_index_name_width) max_index_name_width = index->GetIndexName().length();
+    vector<IndexInfo *> indexes;
+    dbs_[current_db_]->catalog_mgr_->GetTableIndexes(itr->GetTableName(), indexes);
+    for (const auto &index : indexes) {
+      string levels = "-", memory = "-";
+      auto bptree = dynamic_cast<BPlusTreeIndex *>(index->GetIndex());
+      if (bptree != nullptr) {
+        levels = to_string(bptree->GetPinnedLevels());
+        memory = to_string(bptree->GetPinnedBytes() / 1024) + " KB";
+        total_pinned_bytes += bptree->GetPinnedBytes();
       }
-  }
-  cout << "+" << setfill('-') << setw(max_table_name_width + 2) << "";
-  cout << "+" << setfill('-') << setw(max_index_name_width + 2) << ""
-       << "+" << endl;
-  cout << "| " << std::left << setfill(' ') << setw(max_table_name_width) << "Table_name" << " | " << std::left << setfill(' ') << setw(max_index_name_width) << "Index_name" << " |" << endl;
-  cout << "+" << setfill('-') << setw(max_table_name_width + 2) << "";
-  cout << "+" << setfill('-') << setw(max_index_name_width + 2) << ""
-       << "+" << endl;
-  for (const auto &itr : tables) {
-      vector<IndexInfo *> indexes;
-      dbs_[current_db_]->catalog_mgr_->GetTableIndexes(itr->GetTableName(), indexes);
-      for (const auto &index : indexes) {
-          cout << "| " << std::left << setfill(' ') << setw(max_table_name_width) << itr->GetTableName() << " | " << std::left << setfill(' ') << setw(max_index_name_width) << index->GetIndexName() << " |" << endl;
+      auto art = dynamic_cast<ArtIndex *>(index->GetIndex());
+      if (art != nullptr) {
+        memory = to_string(art->GetMemoryUsage() / 1024) + " KB";
+        total_pinned_bytes += art->GetMemoryUsage();
+      }
+      string bloom = "-";
+      if (index->HasBloomFilter()) {
+        bloom = to_string(index->GetBloomFilterBytes() / 1024) + " KB";
+        total_pinned_bytes += index->GetBloomFilterBytes();
       }
+      rows.push_back({itr->GetTableName(), index->GetIndexName(), index->GetIndexType(), levels, memory, bloom});
+    }
   }
-  cout << "+" << setfill('-') << setw(max_table_name_width + 2) << "";
-  cout << "+" << setfill('-') << setw(max_index_name_width + 2) << ""
-       << "+" << endl;
+  vector<uint> width;
+  for (const auto &name : header) {
+    width.push_back(name.length());
+  }
+  for (const auto &row : rows) {
+    for (size_t i = 0; i < row.size(); i++) {
+      width[i] = max(width[i], (uint)row[i].length());
+    }
+  }
+  auto print_divider = [&width]() {
+    for (auto w : width) {
+      cout << "+" << setfill('-') << setw(w + 2) << "";
+    }
+    cout << "+" << endl;
+  };
+  auto print_row = [&width](const vector<string> &row) {
+    for (size_t i = 0; i < row.size(); i++) {
+      cout << "| " << std::left << setfill(' ') << setw(width[i]) << row[i] << " ";
+    }
+    cout << "|" << endl;
+  };
+  print_divider();
+  print_row(header);
+  print_divider();
+  for (const auto &row : rows) {
+    print_row(row);
+  }
+  print_divider();
+  cout << "Pinned index memory: " << total_pinned_bytes / 1024 << " KB" << endl;
   return DB_SUCCESS;
 }
 
@@ -524,8 +669,18 @@ dberr_t ExecuteEngine::ExecuteCreateIndex(pSyntaxNode ast, ExecuteContext *conte
   for (auto identifier_node = column_list_node->child_; identifier_node != nullptr; identifier_node = identifier_node->next_) {
     index_keys.push_back(identifier_node->val_);
   }
+  // USING子句指定索引类型，默认为b+树
+  string index_type = "bptree";
+  if (column_list_node->next_ != nullptr && column_list_node->next_->type_ == kNodeIndexType) {
+    index_type = column_list_node->next_->child_->val_;
+    std::transform(index_type.begin(), index_type.end(), index_type.begin(), ::tolower);
+    if (index_type != "bptree" && index_type != "btree" && index_type != "hash" && index_type != "art") {
+      cout << "Unknown index type " + index_type << endl;
+      return DB_FAILED;
+    }
+  }
   IndexInfo *index_info = nullptr;
-  dberr_t result = dbs_[current_db_]->catalog_mgr_->CreateIndex(table_name, index_name, index_keys, context->GetTransaction(), index_info, "bptree");
+  dberr_t result = dbs_[current_db_]->catalog_mgr_->CreateIndex(table_name, index_name, index_keys, context->GetTransaction(), index_info, index_type);
   switch (result) {
     case DB_SUCCESS:
       cout << "Index " + index_name + " is created successfully" << endl;
@@ -555,34 +710,15 @@ dberr_t ExecuteEngine::ExecuteDropIndex(pSyntaxNode ast, ExecuteContext *context
     return DB_FAILED;
   }
   string index_name = ast->child_->val_;
-  // 找到index所在table
-  vector<TableInfo *> tables;
-  if (dbs_[current_db_]->catalog_mgr_->GetTables(tables) == DB_FAILED) {
+  string table_name;
+  if (!FindIndexTable(index_name, table_name)) {
     cout << "Index " + index_name + " doesn't exist" << endl;
     return DB_FAILED;
   }
-  bool found = false;
-  string table_name;
-  for (const auto &itr : tables) {
-    vector<IndexInfo *> indexes;
-    if (dbs_[current_db_]->catalog_mgr_->GetTableIndexes(itr->GetTableName(), indexes) != DB_INDEX_NOT_FOUND) {
-      for (const auto &index : indexes) {
-        if (index->GetIndexName() == index_name) {
-          table_name = itr->GetTableName();
-          found = true;
-          break;
-        }
-      }
-    }
-    if (found) {
-      break;
-    }
-  }
-  if (!found) {
-    cout << "Index " + index_name + " doesn't exist" << endl;
+  if (dbs_[current_db_]->catalog_mgr_->DropIndex(table_name, index_name) != DB_SUCCESS) {
+    cout << "Index " + index_name + " holds the rows of clustered table " + table_name + " and can not be dropped" << endl;
     return DB_FAILED;
   }
-  dbs_[current_db_]->catalog_mgr_->DropIndex(table_name, index_name);
   cout << "Index " + index_name + " is dropped successfully" << endl;
   return DB_SUCCESS;
 }
@@ -685,3 +821,96 @@ dberr_t ExecuteEngine::ExecuteQuit(pSyntaxNode ast, ExecuteContext *context) {
 #endif
   return DB_QUIT;
 }
+
+dberr_t ExecuteEngine::ExecuteSet(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteSet" << std::endl;
+#endif
+  string name = ast->child_->val_;
+  string value = ast->child_->next_->val_;
+  // 数字按字符串保存，可能带小数点或负号
+  char *end = nullptr;
+  long number = strtol(value.c_str(), &end, 10);
+  bool integer = *end == '\0';
+  // 索引的设置写入索引的元数据，重新打开数据库后仍然有效
+  if (ast->child_->next_->next_ != nullptr) {
+    if (current_db_.empty()) {
+      cout << "No database selected" << endl;
+      return DB_FAILED;
+    }
+    string index_name = ast->child_->next_->next_->val_;
+    if (strcasecmp(name.c_str(), "pinned_levels") != 0) {
+      cout << "Unknown index setting " << name << endl;
+      return DB_FAILED;
+    }
+    if (!integer || number < 0) {
+      cout << "Pinned_levels must not be negative" << endl;
+      return DB_FAILED;
+    }
+    string table_name;
+    if (!FindIndexTable(index_name, table_name)) {
+      cout << "Index " + index_name + " doesn't exist" << endl;
+      return DB_FAILED;
+    }
+    if (dbs_[current_db_]->catalog_mgr_->SetIndexPinnedLevels(table_name, index_name, number) != DB_SUCCESS) {
+      cout << "Index " + index_name + " is not a bptree index" << endl;
+      return DB_FAILED;
+    }
+    return DB_SUCCESS;
+  }
+  if (strcasecmp(name.c_str(), "parallelism") == 0) {
+    if (!integer || number < 1 || number > static_cast<long>(MAX_PARALLELISM)) {
+      cout << "Parallelism must be between 1 and " << MAX_PARALLELISM << endl;
+      return DB_FAILED;
+    }
+    parallelism_ = number;
+  } else if (strcasecmp(name.c_str(), "parallel_order") == 0) {
+    if (!integer || (number != 0 && number != 1)) {
+      cout << "Parallel_order must be 0 or 1" << endl;
+      return DB_FAILED;
+    }
+    preserve_scan_order_ = number == 1;
+  } else if (strcasecmp(name.c_str(), "work_mem") == 0) {
+    if (!integer || number < static_cast<long>(MIN_WORK_MEMORY_KB)) {
+      cout << "Work_mem must be at least " << MIN_WORK_MEMORY_KB << " KB" << endl;
+      return DB_FAILED;
+    }
+    work_memory_ = static_cast<size_t>(number) << 10;
+  } else if (strcasecmp(name.c_str(), "output") == 0) {
+    if (strcasecmp(value.c_str(), "table") == 0) {
+      output_format_ = OutputFormat::kTable;
+    } else if (strcasecmp(value.c_str(), "tsv") == 0) {
+      output_format_ = OutputFormat::kTsv;
+    } else if (strcasecmp(value.c_str(), "binary") == 0) {
+      output_format_ = OutputFormat::kBinary;
+    } else {
+      cout << "Output must be table, tsv or binary" << endl;
+      return DB_FAILED;
+    }
+  } else {
+    cout << "Unknown setting " << name << endl;
+    return DB_FAILED;
+  }
+  return DB_SUCCESS;
+}
+
+bool ExecuteEngine::FindIndexTable(const string &index_name, string &table_name) {
+  // 同一个数据库中index名不重复，遍历所有表找到index所在table
+  vector<TableInfo *> tables;
+  if (dbs_[current_db_]->catalog_mgr_->GetTables(tables) == DB_FAILED) {
+    return false;
+  }
+  for (const auto &itr : tables) {
+    vector<IndexInfo *> indexes;
+    if (dbs_[current_db_]->catalog_mgr_->GetTableIndexes(itr->GetTableName(), indexes) == DB_INDEX_NOT_FOUND) {
+      continue;
+    }
+    for (const auto &index : indexes) {
+      if (index->GetIndexName() == index_name) {
+        table_name = itr->GetTableName();
+        return true;
+      }
+    }
+  }
+  return false;
+}
@@ -0,0 +1,312 @@
+#include "executor/executors/hash_join_executor.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "index/bloom_filter.h"
+
+HashJoinExecutor::HashJoinExecutor(ExecuteContext *exec_ctx, const HashJoinPlanNode *plan,
+                                   std::unique_ptr<AbstractExecutor> &&left,
+                                   std::unique_ptr<AbstractExecutor> &&right)
+    : AbstractExecutor(exec_ctx), plan_(plan) {
+  children_[0] = std::move(left);
+  children_[1] = std::move(right);
+  keys_[0] = &plan_->GetLeftKeys();
+  keys_[1] = &plan_->GetRightKeys();
+}
+
+void HashJoinExecutor::Init() {
+  for (uint32_t side = 0; side < 2; side++) {
+    children_[side]->Init();
+    const Schema *schema = children_[side]->GetOutputSchema();
+    column_maps_[side].clear();
+    for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+      column_maps_[side].push_back(i);
+    }
+    buffers_[side] = DataChunk();
+    buffers_[side].Reset(schema);
+    finished_[side] = false;
+    partitions_[side].clear();
+  }
+  spilled_ = false;
+  partition_ = 0;
+  partition_loaded_ = false;
+  probe_ = nullptr;
+  probe_index_ = 0;
+  match_ = NO_ROW;
+  row_chunk_.Reset(GetOutputSchema());
+  row_pos_ = 0;
+  size_t budget = exec_ctx_->GetWorkMemory();
+  DataChunk input;
+  while (true) {
+    // 读完且放得下的一边做build，两边都读完时选小的
+    int built = -1;
+    for (int side = 0; side < 2; side++) {
+      if (finished_[side] && TableSize(buffers_[side]) <= budget &&
+          (built < 0 || TableSize(buffers_[side]) < TableSize(buffers_[built]))) {
+        built = side;
+      }
+    }
+    if (built >= 0) {
+      build_side_ = built;
+      build_ = std::move(buffers_[built]);
+      buffers_[built] = DataChunk();
+      BuildTable();
+      // 没有build行时不用再读另一边
+      if (build_.GetSize() == 0) {
+        finished_[1 - built] = true;
+        buffers_[1 - built].Reset(children_[1 - built]->GetOutputSchema());
+      }
+      return;
+    }
+    // 两边都放不下时spill，只要有一边还放得下就继续读
+    if (std::min(TableSize(buffers_[0]), TableSize(buffers_[1])) > budget) {
+      Spill();
+      return;
+    }
+    // 先读占内存少的一边，先读完的就是小的一边
+    uint32_t side = finished_[0] ? 1 : (finished_[1] ? 0 : (TableSize(buffers_[0]) <= TableSize(buffers_[1]) ? 0 : 1));
+    if (children_[side]->NextBatch(&input)) {
+      buffers_[side].AppendSelected(input, column_maps_[side]);
+    } else {
+      finished_[side] = true;
+    }
+  }
+}
+
+bool HashJoinExecutor::Next(Row *row, RowId *rid) {
+  while (row_pos_ >= row_chunk_.GetSelectedCount()) {
+    if (!NextBatch(&row_chunk_)) {
+      return false;
+    }
+    row_pos_ = 0;
+  }
+  row_chunk_.GetRow(row_pos_++, row);
+  *rid = row->GetRowId();
+  return true;
+}
+
+bool HashJoinExecutor::NextBatch(DataChunk *chunk) {
+  chunk->Reset(GetOutputSchema());
+  build_matches_.clear();
+  probe_matches_.clear();
+  while (true) {
+    if (probe_ != nullptr) {
+      Probe();
+    }
+    if (!build_matches_.empty()) {
+      break;
+    }
+    if (!NextProbeChunk()) {
+      return false;
+    }
+  }
+  if (build_side_ == 0) {
+    chunk->AppendJoined(build_, build_matches_, *probe_, probe_matches_, plan_->GetOutputColumns());
+  } else {
+    chunk->AppendJoined(*probe_, probe_matches_, build_, build_matches_, plan_->GetOutputColumns());
+  }
+  return true;
+}
+
+bool HashJoinExecutor::HashKeys(const DataChunk &chunk, size_t pos, const std::vector<uint32_t> &keys,
+                                uint64_t *hash) {
+  uint64_t result = 0;
+  for (auto key : keys) {
+    const ColumnVector &column = chunk.GetColumn(key);
+    if (column.IsNull(pos)) {
+      return false;
+    }
+    uint64_t value_hash;
+    switch (column.GetType()) {
+      case kTypeInt:
+        value_hash = BloomFilter::Hash(reinterpret_cast<const char *>(column.GetInts() + pos), sizeof(int32_t));
+        break;
+      case kTypeFloat: {
+        // -0和0相等，hash也要相同
+        float value = column.GetFloats()[pos] == 0 ? 0.0f : column.GetFloats()[pos];
+        value_hash = BloomFilter::Hash(reinterpret_cast<const char *>(&value), sizeof(float));
+        break;
+      }
+      default:
+        value_hash = BloomFilter::Hash(column.GetChars(pos), column.GetLength(pos));
+        break;
+    }
+    result = result * 0x100000001b3ULL ^ value_hash;
+  }
+  *hash = result;
+  return true;
+}
+
+bool HashJoinExecutor::KeysEqual(uint32_t build_pos, uint32_t probe_pos) const {
+  const auto &build_keys = *keys_[build_side_];
+  const auto &probe_keys = *keys_[1 - build_side_];
+  for (size_t i = 0; i < build_keys.size(); i++) {
+    const ColumnVector &build = build_.GetColumn(build_keys[i]);
+    const ColumnVector &probe = probe_->GetColumn(probe_keys[i]);
+    switch (build.GetType()) {
+      case kTypeInt:
+        if (build.GetInts()[build_pos] != probe.GetInts()[probe_pos]) {
+          return false;
+        }
+        break;
+      case kTypeFloat:
+        if (build.GetFloats()[build_pos] != probe.GetFloats()[probe_pos]) {
+          return false;
+        }
+        break;
+      default:
+        if (build.GetLength(build_pos) != probe.GetLength(probe_pos) ||
+            memcmp(build.GetChars(build_pos), probe.GetChars(probe_pos), build.GetLength(build_pos)) != 0) {
+          return false;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+void HashJoinExecutor::BuildTable() {
+  size_t rows = build_.GetSize();
+  size_t buckets = 1;
+  while (buckets < rows * 2) {
+    buckets <<= 1;
+  }
+  heads_.assign(buckets, NO_ROW);
+  mask_ = buckets - 1;
+  next_.resize(rows);
+  hashes_.resize(rows);
+  const auto &keys = *keys_[build_side_];
+  for (uint32_t pos = 0; pos < rows; pos++) {
+    // key为null的行不进hash表
+    if (!HashKeys(build_, pos, keys, &hashes_[pos])) {
+      continue;
+    }
+    uint32_t &head = heads_[hashes_[pos] & mask_];
+    next_[pos] = head;
+    head = pos;
+  }
+}
+
+void HashJoinExecutor::Spill() {
+  spilled_ = true;
+  DataChunk input;
+  for (uint32_t side = 0; side < 2; side++) {
+    for (size_t i = 0; i < PARTITION_COUNT; i++) {
+      partitions_[side].push_back(
+          std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager(), children_[side]->GetOutputSchema()));
+    }
+    Partition(side, buffers_[side]);
+    buffers_[side] = DataChunk();
+    while (!finished_[side] && children_[side]->NextBatch(&input)) {
+      Partition(side, input);
+    }
+    finished_[side] = true;
+    for (auto &partition : partitions_[side]) {
+      partition->Rewind();
+    }
+  }
+}
+
+void HashJoinExecutor::Partition(uint32_t side, const DataChunk &chunk) {
+  uint64_t hash;
+  for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+    uint32_t pos = chunk.GetSelected(i);
+    // 分区用hash的高位，hash表的桶用低位
+    if (HashKeys(chunk, pos, *keys_[side], &hash)) {
+      partitions_[side][(hash >> 32) % PARTITION_COUNT]->AppendRowAt(chunk, pos);
+    }
+  }
+}
+
+bool HashJoinExecutor::NextProbeChunk() {
+  probe_index_ = 0;
+  match_ = NO_ROW;
+  if (!spilled_) {
+    uint32_t probe_side = 1 - build_side_;
+    // 先探测选build一边时读进来的行，再读剩下的
+    if (probe_ == nullptr) {
+      probe_ = &buffers_[probe_side];
+      return true;
+    }
+    buffers_[probe_side] = DataChunk();
+    probe_ = &probe_chunk_;
+    if (!finished_[probe_side] && children_[probe_side]->NextBatch(&probe_chunk_)) {
+      return true;
+    }
+    finished_[probe_side] = true;
+    return false;
+  }
+  while (true) {
+    if (partition_loaded_) {
+      if (partitions_[1 - build_side_][partition_]->Read(&probe_chunk_)) {
+        probe_ = &probe_chunk_;
+        return true;
+      }
+      // 这一对分区做完了，释放临时页
+      partitions_[0][partition_].reset();
+      partitions_[1][partition_].reset();
+      partition_loaded_ = false;
+      partition_++;
+    }
+    if (partition_ >= PARTITION_COUNT) {
+      return false;
+    }
+    const auto &left = partitions_[0][partition_];
+    const auto &right = partitions_[1][partition_];
+    if (left->GetRowCount() == 0 || right->GetRowCount() == 0) {
+      partitions_[0][partition_].reset();
+      partitions_[1][partition_].reset();
+      partition_++;
+      continue;
+    }
+    // 每对分区在小的一边上建hash表
+    build_side_ = left->GetByteCount() <= right->GetByteCount() ? 0 : 1;
+    build_ = DataChunk();
+    build_.Reset(children_[build_side_]->GetOutputSchema());
+    DataChunk input;
+    while (partitions_[build_side_][partition_]->Read(&input)) {
+      build_.AppendSelected(input, column_maps_[build_side_]);
+    }
+    BuildTable();
+    partition_loaded_ = true;
+  }
+}
+
+void HashJoinExecutor::Probe() {
+  const auto &probe_keys = *keys_[1 - build_side_];
+  while (build_matches_.size() < DataChunk::CAPACITY) {
+    if (match_ == NO_ROW) {
+      if (probe_index_ >= probe_->GetSelectedCount()) {
+        return;
+      }
+      probe_pos_ = probe_->GetSelected(probe_index_++);
+      if (HashKeys(*probe_, probe_pos_, probe_keys, &probe_hash_)) {
+        match_ = heads_[probe_hash_ & mask_];
+        probe_row_loaded_ = false;
+      }
+      continue;
+    }
+    uint32_t build_pos = match_;
+    match_ = next_[build_pos];
+    if (hashes_[build_pos] == probe_hash_ && KeysEqual(build_pos, probe_pos_) && MatchPredicate(build_pos)) {
+      build_matches_.push_back(build_pos);
+      probe_matches_.push_back(probe_pos_);
+    }
+  }
+}
+
+bool HashJoinExecutor::MatchPredicate(uint32_t build_pos) {
+  const auto &predicate = plan_->predicate_;
+  if (predicate == nullptr) {
+    return true;
+  }
+  if (!probe_row_loaded_) {
+    probe_->GetRowAt(probe_pos_, &probe_row_);
+    probe_row_loaded_ = true;
+  }
+  build_.GetRowAt(build_pos, &build_row_);
+  const Row *left = build_side_ == 0 ? &build_row_ : &probe_row_;
+  const Row *right = build_side_ == 0 ? &probe_row_ : &build_row_;
+  return predicate->EvaluateJoin(left, right).CompareEquals(Field(kTypeInt, 1)) == CmpBool::kTrue;
+}
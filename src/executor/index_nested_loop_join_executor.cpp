@@ -0,0 +1,179 @@
+#include "executor/executors/index_nested_loop_join_executor.h"
+
+#include <algorithm>
+#include <cstring>
+
+IndexNestedLoopJoinExecutor::IndexNestedLoopJoinExecutor(ExecuteContext *exec_ctx,
+                                                         const IndexNestedLoopJoinPlanNode *plan,
+                                                         std::unique_ptr<AbstractExecutor> &&outer)
+    : AbstractExecutor(exec_ctx), plan_(plan), outer_(std::move(outer)) {}
+
+void IndexNestedLoopJoinExecutor::Init() {
+  outer_->Init();
+  exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
+  outer_matches_.clear();
+  inner_matches_.clear();
+  match_cursor_ = 0;
+  lookup_count_ = 0;
+  pages_read_ = 0;
+  row_chunk_.Reset(GetOutputSchema());
+  row_pos_ = 0;
+}
+
+bool IndexNestedLoopJoinExecutor::Next(Row *row, RowId *rid) {
+  while (row_pos_ >= row_chunk_.GetSelectedCount()) {
+    if (!NextBatch(&row_chunk_)) {
+      return false;
+    }
+    row_pos_ = 0;
+  }
+  row_chunk_.GetRow(row_pos_++, row);
+  *rid = row->GetRowId();
+  return true;
+}
+
+bool IndexNestedLoopJoinExecutor::NextBatch(DataChunk *chunk) {
+  chunk->Reset(GetOutputSchema());
+  while (match_cursor_ >= outer_matches_.size()) {
+    if (!JoinNextChunk()) {
+      return false;
+    }
+  }
+  size_t end = std::min(outer_matches_.size(), match_cursor_ + DataChunk::CAPACITY);
+  std::vector<uint32_t> outer(outer_matches_.begin() + match_cursor_, outer_matches_.begin() + end);
+  std::vector<uint32_t> inner(inner_matches_.begin() + match_cursor_, inner_matches_.begin() + end);
+  chunk->AppendJoined(outer_chunk_, outer, inner_chunk_, inner, plan_->GetOutputColumns());
+  match_cursor_ = end;
+  return true;
+}
+
+bool IndexNestedLoopJoinExecutor::JoinNextChunk() {
+  outer_matches_.clear();
+  inner_matches_.clear();
+  match_cursor_ = 0;
+  outer_row_pos_ = UINT32_MAX;
+  if (!outer_->NextBatch(&outer_chunk_)) {
+    return false;
+  }
+  Txn *txn = exec_ctx_->GetTransaction();
+  // 一个chunk的key一起查，b+树按key的顺序沿叶子找，bloom filter排除的key不查
+  const auto &lookup_columns = plan_->GetLookupColumns();
+  std::vector<Row> keys;
+  std::vector<uint32_t> key_positions;
+  for (size_t i = 0; i < outer_chunk_.GetSelectedCount(); i++) {
+    uint32_t pos = outer_chunk_.GetSelected(i);
+    std::vector<Field> fields;
+    bool has_null = false;
+    for (auto column : lookup_columns) {
+      const ColumnVector &vector = outer_chunk_.GetColumn(column);
+      if (vector.IsNull(pos)) {
+        has_null = true;
+        break;
+      }
+      fields.push_back(vector.GetField(pos));
+    }
+    if (!has_null) {
+      keys.emplace_back(fields);
+      key_positions.push_back(pos);
+    }
+  }
+  lookup_count_ += keys.size();
+  std::vector<std::vector<RowId>> results;
+  plan_->GetIndex()->LookupMany(keys, results, txn);
+  // (row id, outer行)按row id排序，每个heap页只读一次
+  std::vector<std::pair<int64_t, uint32_t>> pairs;
+  for (size_t k = 0; k < keys.size(); k++) {
+    for (const auto &rid : results[k]) {
+      pairs.emplace_back(rid.Get(), key_positions[k]);
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  std::vector<RowId> rids;
+  for (const auto &pair : pairs) {
+    if (rids.empty() || rids.back().Get() != pair.first) {
+      rids.emplace_back(pair.first);
+    }
+  }
+  inner_chunk_.Reset(table_info_->GetSchema());
+  for (size_t begin = 0; begin < rids.size();) {
+    size_t end = begin + 1;
+    while (end < rids.size() && rids[end].GetPageId() == rids[begin].GetPageId()) {
+      end++;
+    }
+    table_info_->GetTableHeap()->GetTuples(rids.begin() + begin, rids.begin() + end, &inner_chunk_, txn);
+    pages_read_++;
+    begin = end;
+  }
+  std::vector<bool> passed(inner_chunk_.GetSize(), plan_->GetInnerFilter() == nullptr);
+  if (plan_->GetInnerFilter() != nullptr) {
+    plan_->GetInnerFilter()->FilterBatch(inner_chunk_, inner_chunk_.GetSelection());
+    for (auto pos : inner_chunk_.GetSelection()) {
+      passed[pos] = true;
+    }
+  }
+  // 读出的行也按row id排列，已删除的行不在其中
+  std::vector<std::pair<uint32_t, uint32_t>> matches;
+  size_t inner_pos = 0;
+  for (const auto &pair : pairs) {
+    while (inner_pos < inner_chunk_.GetSize() && inner_chunk_.GetRowId(inner_pos).Get() < pair.first) {
+      inner_pos++;
+    }
+    if (inner_pos < inner_chunk_.GetSize() && inner_chunk_.GetRowId(inner_pos).Get() == pair.first &&
+        passed[inner_pos] && KeysEqual(pair.second, inner_pos)) {
+      matches.emplace_back(pair.second, inner_pos);
+    }
+  }
+  // 按outer行的顺序输出
+  std::sort(matches.begin(), matches.end());
+  for (const auto &match : matches) {
+    if (MatchPredicate(match.first, match.second)) {
+      outer_matches_.push_back(match.first);
+      inner_matches_.push_back(match.second);
+    }
+  }
+  return true;
+}
+
+bool IndexNestedLoopJoinExecutor::KeysEqual(uint32_t outer_pos, uint32_t inner_pos) const {
+  const auto &outer_keys = plan_->GetOuterKeys();
+  const auto &inner_keys = plan_->GetInnerKeys();
+  for (size_t i = 0; i < outer_keys.size(); i++) {
+    const ColumnVector &outer = outer_chunk_.GetColumn(outer_keys[i]);
+    const ColumnVector &inner = inner_chunk_.GetColumn(inner_keys[i]);
+    if (outer.IsNull(outer_pos) || inner.IsNull(inner_pos)) {
+      return false;
+    }
+    switch (outer.GetType()) {
+      case kTypeInt:
+        if (outer.GetInts()[outer_pos] != inner.GetInts()[inner_pos]) {
+          return false;
+        }
+        break;
+      case kTypeFloat:
+        if (outer.GetFloats()[outer_pos] != inner.GetFloats()[inner_pos]) {
+          return false;
+        }
+        break;
+      default:
+        if (outer.GetLength(outer_pos) != inner.GetLength(inner_pos) ||
+            memcmp(outer.GetChars(outer_pos), inner.GetChars(inner_pos), outer.GetLength(outer_pos)) != 0) {
+          return false;
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+bool IndexNestedLoopJoinExecutor::MatchPredicate(uint32_t outer_pos, uint32_t inner_pos) {
+  const auto &predicate = plan_->GetPredicate();
+  if (predicate == nullptr) {
+    return true;
+  }
+  if (outer_row_pos_ != outer_pos) {
+    outer_chunk_.GetRowAt(outer_pos, &outer_row_);
+    outer_row_pos_ = outer_pos;
+  }
+  inner_chunk_.GetRowAt(inner_pos, &inner_row_);
+  return predicate->EvaluateJoin(&outer_row_, &inner_row_).CompareEquals(Field(kTypeInt, 1)) == CmpBool::kTrue;
+}
@@ -0,0 +1,72 @@
+#include "executor/executors/index_only_scan_executor.h"
+
+IndexOnlyScanExecutor::IndexOnlyScanExecutor(ExecuteContext *exec_ctx, const IndexOnlyScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+void IndexOnlyScanExecutor::Init() {
+  exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
+  index_ = dynamic_cast<BPlusTreeIndex *>(plan_->index_->GetIndex());
+  ASSERT(index_ != nullptr, "Index only scan needs a b+ tree index.");
+  auto key_schema = plan_->index_->GetIndexKeySchema();
+  key_index_.assign(table_info_->GetSchema()->GetColumnCount(), -1);
+  for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+    key_index_[key_schema->GetColumn(i)->GetTableInd()] = i;
+  }
+  range_ = KeyRange(plan_->GetPredicate(), key_schema);
+  end_ = index_->GetEndIterator();
+  Row start_key;
+  if (range_.IsEmpty()) {
+    iterator_ = index_->GetEndIterator();
+  } else if (range_.GetStartKey(start_key)) {
+    iterator_ = index_->GetLowerBoundIterator(start_key);
+  } else {
+    iterator_ = index_->GetBeginIterator();
+  }
+}
+
+bool IndexOnlyScanExecutor::Next(Row *row, RowId *rid) {
+  auto predicate = plan_->GetCompiledPredicate();
+  auto key_schema = plan_->index_->GetIndexKeySchema();
+  auto table_schema = table_info_->GetSchema();
+  const KeyManager &processor = index_->GetKeyManager();
+  while (iterator_ != end_) {
+    auto entry = *iterator_;
+    Row key_row(INVALID_ROWID);
+    processor.DeserializeToKey(entry.first, key_row, key_schema);
+    int location = range_.Locate(key_row);
+    // 超过范围上界，后面的entry都不满足
+    if (location > 0) {
+      iterator_ = end_;
+      return false;
+    }
+    ++iterator_;
+    if (location < 0) {
+      continue;
+    }
+    if (!range_.IsExact()) {
+      // 按表的列顺序组装，不在key中的列为null（planner保证用不到）
+      std::vector<Field> fields;
+      fields.reserve(key_index_.size());
+      for (uint32_t i = 0; i < key_index_.size(); i++) {
+        if (key_index_[i] >= 0) {
+          fields.emplace_back(*key_row.GetField(key_index_[i]));
+        } else {
+          fields.emplace_back(table_schema->GetColumn(i)->GetType());
+        }
+      }
+      Row table_row(fields);
+      if (!predicate->EvaluatePredicate(table_row)) {
+        continue;
+      }
+    }
+    *rid = entry.second;
+    std::vector<Field> output;
+    for (auto column : plan_->OutputSchema()->GetColumns()) {
+      output.emplace_back(*key_row.GetField(key_index_[column->GetTableInd()]));
+    }
+    *row = Row(output);
+    row->SetRowId(entry.second);
+    return true;
+  }
+  return false;
+}
@@ -1,5 +1,8 @@
 #include "executor/executors/index_scan_executor.h"
 
+#include "index/b_plus_tree_index.h"
+#include "index/clustered_index.h"
+
 class RowidCompare {
  public:
   bool operator()(RowId rid1, RowId rid2) { return rid1.Get() < rid2.Get(); }
@@ -10,9 +13,32 @@ IndexScanExecutor::IndexScanExecutor(ExecuteContext *exec_ctx, const IndexScanPl
 
 void IndexScanExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
-  auto first_row = table_info_->GetTableHeap()->Begin(nullptr);
-  result_ = IndexScan(plan_->GetPredicate());
+  CollectRowIds();
+  cursor_ = 0;
   is_schema_same_ = SchemaEqual(table_info_->GetSchema(), plan_->OutputSchema());
+  column_map_.clear();
+  for (auto column : plan_->OutputSchema()->GetColumns()) {
+    column_map_.push_back(column->GetTableInd());
+  }
+}
+
+void IndexScanExecutor::CollectRowIds() {
+  rows_.clear();
+  result_.clear();
+  scanned_entries_ = 0;
+  if (plan_->range_ != nullptr) {
+    StartRange();
+    if (plan_->collect_all_) {
+      ReadRange(SIZE_MAX);
+    }
+    return;
+  }
+  if (!IndexScan(plan_->GetPredicate(), result_)) {
+    // 计划保证不会走到这里，保守起见检查所有行
+    for (auto iter = table_info_->Begin(nullptr); iter != table_info_->End(); ++iter) {
+      result_.push_back(iter->GetRowId());
+    }
+  }
 }
 
 bool IndexScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *output_schema) {
@@ -44,58 +70,193 @@ void IndexScanExecutor::TupleTransfer(const Schema *table_schema, const Schema *
   *output_row = Row(dest_row);
 }
 
-vector<RowId> IndexScanExecutor::IndexScan(AbstractExpressionRef predicate) {
+bool IndexScanExecutor::IndexScan(const AbstractExpressionRef &predicate, vector<RowId> &result) {
   switch (predicate->GetType()) {
     case ExpressionType::LogicExpression: {
-      vector<RowId> lhs = IndexScan(predicate->GetChildAt(0));
-      vector<RowId> rhs = IndexScan(predicate->GetChildAt(1));
-      if (lhs.empty()) return rhs;
-      if (rhs.empty()) return lhs;
-      sort(lhs.begin(), lhs.end(), RowidCompare());
-      sort(rhs.begin(), rhs.end(), RowidCompare());
-      vector<RowId> result;
+      vector<RowId> lhs, rhs;
+      bool lhs_restricted = IndexScan(predicate->GetChildAt(0), lhs);
+      bool rhs_restricted = IndexScan(predicate->GetChildAt(1), rhs);
+      if (dynamic_pointer_cast<LogicExpression>(predicate)->logic_type_ == LogicType::Or) {
+        // OR的任意一支不能用索引缩小时，只能全部检查
+        if (!lhs_restricted || !rhs_restricted) {
+          return false;
+        }
+        set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), back_inserter(result), RowidCompare());
+        return true;
+      }
+      if (!lhs_restricted || !rhs_restricted) {
+        result = lhs_restricted ? std::move(lhs) : std::move(rhs);
+        return lhs_restricted || rhs_restricted;
+      }
       set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), back_inserter(result), RowidCompare());
-      return result;
+      return true;
     }
     case ExpressionType::ComparisonExpression: {
-      std::vector<RowId> ret;
+      auto column = dynamic_pointer_cast<ColumnValueExpression>(predicate->GetChildAt(0));
       std::vector<Field> fields{predicate->GetChildAt(1)->Evaluate(nullptr)};
+      if (column == nullptr || fields[0].IsNull()) {
+        return false;
+      }
       Row key(fields);
+      auto comparison = dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType();
+      if (comparison != "=" && comparison != "<>" && comparison != "<" && comparison != "<=" && comparison != ">" &&
+          comparison != ">=") {
+        return false;
+      }
       for (auto index : plan_->indexes_) {
-        uint32_t col_idx = dynamic_pointer_cast<ColumnValueExpression>(predicate->GetChildAt(0))->GetColIdx();
-        if (col_idx == index->GetIndexKeySchema()->GetColumn(0)->GetTableInd()) {
-          index->GetIndex()->ScanKey(key, ret, nullptr,
-                                     dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType());
-          break;
+        if (column->GetColIdx() != index->GetIndexKeySchema()->GetColumn(0)->GetTableInd()) {
+          continue;
+        }
+        if (comparison == "=" && !index->MayContain(key)) {
+          return true;
         }
+        if (index->GetIndex()->ScanKey(key, result, nullptr, comparison) == DB_FAILED) {
+          result.clear();
+          return false;
+        }
+        // 按row id排序，求交、求并和回表都按页的顺序进行
+        sort(result.begin(), result.end(), RowidCompare());
+        return true;
       }
-      return ret;
+      return false;
     }
     default:
+      return false;
+  }
+}
+
+void IndexScanExecutor::StartRange() {
+  const KeyRange &range = *plan_->range_;
+  auto index = dynamic_cast<BPlusTreeIndex *>(plan_->indexes_[0]->GetIndex());
+  ASSERT(index != nullptr, "Range scan needs a b+ tree index.");
+  range_end_ = index->GetEndIterator();
+  read_size_ = FIRST_READ_ENTRIES;
+  Row start_key;
+  if (range.IsEmpty()) {
+    range_iterator_ = range_end_;
+  } else if (range.GetStartKey(start_key)) {
+    range_iterator_ = index->GetLowerBoundIterator(start_key);
+  } else {
+    range_iterator_ = index->GetBeginIterator();
+  }
+}
+
+void IndexScanExecutor::ReadRange(size_t max_entries) {
+  const KeyRange &range = *plan_->range_;
+  auto index_info = plan_->indexes_[0];
+  auto index = dynamic_cast<BPlusTreeIndex *>(index_info->GetIndex());
+  const KeyManager &processor = index->GetKeyManager();
+  // clustered index的叶子上就是整行，不用再回表
+  auto clustered_index = dynamic_cast<ClusteredIndex *>(index);
+  size_t read = 0;
+  for (; range_iterator_ != range_end_ && read < max_entries; ++range_iterator_) {
+    auto entry = *range_iterator_;
+    Row key_row(INVALID_ROWID);
+    processor.DeserializeToKey(entry.first, key_row, index_info->GetIndexKeySchema());
+    scanned_entries_++;
+    int location = range.Locate(key_row);
+    if (location > 0) {
+      // 放开停留的叶子
+      range_iterator_ = range_end_;
       break;
+    }
+    if (location == 0) {
+      result_.push_back(entry.second);
+      read++;
+      if (clustered_index != nullptr) {
+        rows_.emplace_back();
+        clustered_index->ReadRow(entry.first, rows_.back());
+      }
+    }
   }
 }
 
+bool IndexScanExecutor::HasMore() {
+  if (cursor_ < result_.size()) {
+    return true;
+  }
+  if (plan_->range_ == nullptr || range_iterator_ == range_end_) {
+    return false;
+  }
+  // 取完一批再读下一批叶子，每批加倍，只要前几行的扫描只读开头的几页
+  result_.clear();
+  rows_.clear();
+  cursor_ = 0;
+  ReadRange(read_size_);
+  read_size_ = std::min(read_size_ * 2, DataChunk::CAPACITY);
+  return !result_.empty();
+}
+
+bool IndexScanExecutor::Emit(const Row &source, const RowId &source_rid, Row *row, RowId *rid) {
+  if (plan_->need_filter_ && !plan_->GetCompiledPredicate()->EvaluatePredicate(source)) {
+    return false;
+  }
+  *rid = source_rid;
+  if (!is_schema_same_) {
+    TupleTransfer(table_info_->GetSchema(), plan_->OutputSchema(), &source, row);
+  } else {
+    *row = source;
+  }
+  return true;
+}
+
 bool IndexScanExecutor::Next(Row *row, RowId *rid) {
-  auto predicate = plan_->GetPredicate();
-  auto table_schema = table_info_->GetSchema();
-  while (cursor_ < result_.size()) {
-    auto p_row = new Row(result_[cursor_]);
-    table_info_->GetTableHeap()->GetTuple(p_row, nullptr);
-    if (plan_->need_filter_) {
-      if (!predicate->Evaluate(p_row).CompareEquals(Field(kTypeInt, 1))) {
+  while (HasMore()) {
+    size_t current = cursor_++;
+    if (current < rows_.size()) {
+      if (Emit(rows_[current], result_[current], row, rid)) {
+        return true;
+      }
+      continue;
+    }
+    Row fetched(result_[current]);
+    if (table_info_->GetTuple(&fetched, nullptr) && Emit(fetched, result_[current], row, rid)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IndexScanExecutor::NextBatch(DataChunk *chunk) {
+  const Schema *output_schema = plan_->OutputSchema();
+  DataChunk *source = is_schema_same_ ? chunk : &scan_chunk_;
+  const Schema *source_schema = is_schema_same_ ? output_schema : table_info_->GetSchema();
+  chunk->Reset(output_schema);
+  while (HasMore()) {
+    source->Reset(source_schema);
+    while (cursor_ < result_.size() && !source->IsFull()) {
+      if (cursor_ < rows_.size()) {
+        source->AppendRow(rows_[cursor_], result_[cursor_]);
         cursor_++;
         continue;
       }
+      if (table_info_->IsClustered()) {
+        Row fetched(result_[cursor_]);
+        if (table_info_->GetTuple(&fetched, nullptr)) {
+          source->AppendRow(fetched, result_[cursor_]);
+        }
+        cursor_++;
+        continue;
+      }
+      // 相邻的同一页的row id一起读
+      page_id_t page_id = result_[cursor_].GetPageId();
+      size_t end = cursor_ + 1;
+      size_t room = DataChunk::CAPACITY - source->GetSize();
+      while (end < result_.size() && end - cursor_ < room && result_[end].GetPageId() == page_id) {
+        end++;
+      }
+      table_info_->GetTableHeap()->GetTuples(result_.begin() + cursor_, result_.begin() + end, source, nullptr);
+      cursor_ = end;
+    }
+    if (plan_->need_filter_) {
+      plan_->GetPredicate()->FilterBatch(*source, source->GetSelection());
     }
-    *rid = result_[cursor_];
-    if (!is_schema_same_) {
-      TupleTransfer(table_schema, plan_->OutputSchema(), p_row, row);
-    } else {
-      *row = *p_row;
+    if (source != chunk) {
+      chunk->AppendSelected(*source, column_map_);
+    }
+    if (chunk->GetSelectedCount() > 0) {
+      return true;
     }
-    cursor_++;
-    return true;
   }
   return false;
 }
@@ -4,6 +4,10 @@
 
 #include "executor/executors/insert_executor.h"
 
+#include <unordered_set>
+
+#include "index/art_index.h"
+
 InsertExecutor::InsertExecutor(ExecuteContext *exec_ctx, const InsertPlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
@@ -16,29 +20,79 @@ void InsertExecutor::Init() {
 }
 
 bool InsertExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
+  if (pending_ == 0 && !InsertBatch()) {
+    return false;
+  }
+  pending_--;
+  return true;
+}
+
+bool InsertExecutor::NextBatch(DataChunk *chunk) {
+  chunk->Reset(nullptr);
+  if (pending_ == 0 && !InsertBatch()) {
+    return false;
+  }
+  Row inserted;
+  for (; pending_ > 0; pending_--) {
+    chunk->AppendRow(inserted, INVALID_ROWID);
+  }
+  return true;
+}
+
+bool InsertExecutor::InsertBatch() {
+  if (stopped_) {
+    return false;
+  }
+  std::vector<Row> rows;
   Row insert_row;
   RowId insert_rid;
-  if (child_executor_->Next(&insert_row, &insert_rid)) {
-    // 先扫描index，确保插入记录在任意一个index中不存在
-    for (auto info : index_info_) {
-      Row key_row;
-      insert_row.GetKeyFromRow(schema_, info->GetIndexKeySchema(), key_row);
-      vector<RowId> result;
-      info->GetIndex()->ScanKey(key_row, result, exec_ctx_->GetTransaction(), "=");
-      if (!result.empty()) {
-        cout << "Duplicate key found in index " << info->GetIndexName() << endl;
-        return false;
-      }
+  while (rows.size() < DML_BATCH_SIZE && child_executor_->Next(&insert_row, &insert_rid)) {
+    rows.push_back(insert_row);
+  }
+  if (rows.empty()) {
+    return false;
+  }
+  // 先批量查每个唯一index，插入记录在index中已经存在或者和同一批中前面的记录重复时，只插入它之前的记录
+  size_t accepted = rows.size();
+  IndexInfo *duplicate_index = nullptr;
+  std::vector<std::vector<Row>> keys(index_info_.size());
+  for (size_t i = 0; i < index_info_.size(); i++) {
+    auto info = index_info_[i];
+    keys[i].resize(rows.size());
+    for (size_t j = 0; j < rows.size(); j++) {
+      rows[j].GetKeyFromRow(schema_, info->GetIndexKeySchema(), keys[i][j]);
     }
-    if (table_info_->GetTableHeap()->InsertTuple(insert_row, exec_ctx_->GetTransaction())) {
-      Row key_row;
-      insert_rid = insert_row.GetRowId();
-      for (auto info : index_info_) {  // 更新索引
-        insert_row.GetKeyFromRow(schema_, info->GetIndexKeySchema(), key_row);
-        info->GetIndex()->InsertEntry(key_row, insert_rid, exec_ctx_->GetTransaction());
+    if (!info->IsUnique()) {
+      continue;
+    }
+    vector<vector<RowId>> result;
+    info->LookupMany(keys[i], result, exec_ctx_->GetTransaction());
+    std::unordered_set<std::string> batch_keys;
+    for (size_t j = 0; j < accepted; j++) {
+      if (!result[j].empty() || !batch_keys.insert(ArtIndex::EncodeKey(keys[i][j], info->GetIndexKeySchema())).second) {
+        accepted = j;
+        duplicate_index = info;
+        break;
       }
-      return true;
     }
   }
-  return false;
-}
\ No newline at end of file
+  if (duplicate_index != nullptr) {
+    cout << "Duplicate key found in index " << duplicate_index->GetIndexName() << endl;
+    stopped_ = true;
+  }
+  std::vector<RowId> rids;
+  for (size_t j = 0; j < accepted; j++) {
+    if (!table_info_->InsertTuple(rows[j], exec_ctx_->GetTransaction())) {
+      accepted = j;
+      stopped_ = true;
+      break;
+    }
+    rids.push_back(rows[j].GetRowId());
+  }
+  for (size_t i = 0; i < index_info_.size(); i++) {  // 更新索引
+    keys[i].resize(accepted);
+    index_info_[i]->InsertEntries(keys[i], rids, exec_ctx_->GetTransaction());
+  }
+  pending_ = accepted;
+  return accepted > 0;
+}
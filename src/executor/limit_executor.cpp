@@ -0,0 +1,44 @@
+#include "executor/executors/limit_executor.h"
+
+#include <algorithm>
+
+LimitExecutor::LimitExecutor(ExecuteContext *exec_ctx, const LimitPlanNode *plan,
+                             std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+void LimitExecutor::Init() {
+  child_->Init();
+  skipped_ = 0;
+  emitted_ = 0;
+}
+
+bool LimitExecutor::Next(Row *row, RowId *rid) {
+  while (emitted_ < plan_->GetLimit() && child_->Next(row, rid)) {
+    if (skipped_ < plan_->GetOffset()) {
+      skipped_++;
+      continue;
+    }
+    emitted_++;
+    return true;
+  }
+  return false;
+}
+
+bool LimitExecutor::NextBatch(DataChunk *chunk) {
+  // 到了limit就不再向子节点要行
+  while (emitted_ < plan_->GetLimit() && child_->NextBatch(chunk)) {
+    auto &selection = chunk->GetSelection();
+    // offset之前的行只计数，不输出
+    size_t skip = std::min(selection.size(), plan_->GetOffset() - skipped_);
+    selection.erase(selection.begin(), selection.begin() + skip);
+    skipped_ += skip;
+    if (selection.size() > plan_->GetLimit() - emitted_) {
+      selection.resize(plan_->GetLimit() - emitted_);
+    }
+    emitted_ += selection.size();
+    if (!selection.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,229 @@
+#include "executor/executors/parallel_seq_scan_executor.h"
+
+#include <algorithm>
+
+#include "record/filter_kernels.h"
+
+ParallelSeqScanExecutor::ParallelSeqScanExecutor(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan)
+    : AbstractExecutor(exec_ctx), plan_(plan) {}
+
+ParallelSeqScanExecutor::~ParallelSeqScanExecutor() { Stop(); }
+
+void ParallelSeqScanExecutor::Init() {
+  Stop();
+  exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
+  schema_ = plan_->OutputSchema();
+  column_map_.clear();
+  for (auto column : schema_->GetColumns()) {
+    column_map_.push_back(column->GetTableInd());
+  }
+  // 按表的列序输出全部列时直接解码到输出的chunk
+  is_schema_same_ = column_map_.size() == table_info_->GetSchema()->GetColumnCount();
+  for (uint32_t i = 0; i < column_map_.size() && is_schema_same_; i++) {
+    is_schema_same_ = column_map_[i] == i;
+  }
+  cursor_ = std::make_unique<PageChainCursor>(exec_ctx_->GetBufferPoolManager(),
+                                              table_info_->GetTableHeap()->GetFirstPageId());
+  size_t parallelism = std::max<size_t>(plan_->GetParallelism(), 1);
+  queues_.clear();
+  for (size_t i = 0; i < parallelism; i++) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  done_.clear();
+  next_seq_ = 0;
+  window_ = 2 * parallelism * MORSELS_PER_REFILL;
+  running_workers_ = parallelism;
+  stopped_ = false;
+  error_ = nullptr;
+  chunks_.clear();
+  chunk_pos_ = 0;
+  row_chunk_.Reset(schema_);
+  row_pos_ = 0;
+  for (size_t i = 0; i < parallelism; i++) {
+    workers_.emplace_back(&ParallelSeqScanExecutor::Work, this, i);
+  }
+}
+
+bool ParallelSeqScanExecutor::Next(Row *row, RowId *rid) {
+  while (row_pos_ >= row_chunk_.GetSelectedCount()) {
+    if (!NextBatch(&row_chunk_)) {
+      return false;
+    }
+    row_pos_ = 0;
+  }
+  row_chunk_.GetRow(row_pos_++, row);
+  *rid = row->GetRowId();
+  return true;
+}
+
+bool ParallelSeqScanExecutor::NextBatch(DataChunk *chunk) {
+  while (chunk_pos_ >= chunks_.size()) {
+    if (!TakeChunks()) {
+      chunk->Reset(schema_);
+      return false;
+    }
+  }
+  *chunk = std::move(chunks_[chunk_pos_++]);
+  return true;
+}
+
+bool ParallelSeqScanExecutor::TakeChunks() {
+  bool preserve_order = plan_->IsOrderPreserved();
+  std::unique_lock<std::mutex> lock(latch_);
+  auto ready = [&]() {
+    return !done_.empty() && (!preserve_order || done_.begin()->first == next_seq_);
+  };
+  done_cv_.wait(lock, [&]() { return error_ != nullptr || running_workers_ == 0 || ready(); });
+  if (error_ != nullptr) {
+    std::rethrow_exception(error_);
+  }
+  if (!ready()) {
+    return false;
+  }
+  chunks_ = std::move(done_.begin()->second);
+  chunk_pos_ = 0;
+  done_.erase(done_.begin());
+  next_seq_++;
+  lock.unlock();
+  returned_cv_.notify_all();
+  return true;
+}
+
+void ParallelSeqScanExecutor::Work(size_t worker) {
+  bool preserve_order = plan_->IsOrderPreserved();
+  DataChunk source;
+  std::vector<uint64_t> bitmap;
+  Morsel morsel;
+  try {
+    while (TakeMorsel(worker, &morsel)) {
+      {
+        // 保序时只扫描离下一个要返回的morsel不远的，否则只限制做完没取走的个数
+        std::unique_lock<std::mutex> lock(latch_);
+        returned_cv_.wait(lock, [&]() {
+          return stopped_ || (preserve_order ? morsel.seq_ < next_seq_ + window_ : done_.size() < window_);
+        });
+        if (stopped_) {
+          break;
+        }
+      }
+      std::vector<DataChunk> chunks;
+      ScanMorsel(morsel, &source, &bitmap, &chunks);
+      {
+        std::lock_guard<std::mutex> lock(latch_);
+        done_.emplace(morsel.seq_, std::move(chunks));
+      }
+      done_cv_.notify_all();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(latch_);
+    if (error_ == nullptr) {
+      error_ = std::current_exception();
+    }
+    stopped_ = true;
+  }
+  {
+    std::lock_guard<std::mutex> lock(latch_);
+    running_workers_--;
+  }
+  done_cv_.notify_all();
+  returned_cv_.notify_all();
+}
+
+bool ParallelSeqScanExecutor::TakeMorsel(size_t worker, Morsel *morsel) {
+  auto &own = *queues_[worker];
+  {
+    std::lock_guard<std::mutex> lock(own.latch_);
+    if (!own.morsels_.empty()) {
+      *morsel = std::move(own.morsels_.front());
+      own.morsels_.pop_front();
+      return true;
+    }
+  }
+  // 从页链上取一批，扫描第一个，其余留在自己的队列里，别的线程空闲时可以偷走
+  bool taken = false;
+  Morsel next;
+  for (size_t i = 0; i < MORSELS_PER_REFILL && cursor_->Next(MORSEL_PAGES, &next.pages_, &next.seq_); i++) {
+    if (!taken) {
+      *morsel = std::move(next);
+      next = Morsel();
+      taken = true;
+    } else {
+      std::lock_guard<std::mutex> lock(own.latch_);
+      own.morsels_.push_back(std::move(next));
+      next = Morsel();
+    }
+  }
+  if (taken) {
+    return true;
+  }
+  // 页链取完了，从别的线程的队列尾部偷
+  for (size_t i = 1; i < queues_.size(); i++) {
+    auto &victim = *queues_[(worker + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.latch_);
+    if (!victim.morsels_.empty()) {
+      *morsel = std::move(victim.morsels_.back());
+      victim.morsels_.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ParallelSeqScanExecutor::ScanMorsel(const Morsel &morsel, DataChunk *source, std::vector<uint64_t> *bitmap,
+                                         std::vector<DataChunk> *chunks) {
+  auto table_heap = table_info_->GetTableHeap();
+  const Schema *source_schema = is_schema_same_ ? schema_ : table_info_->GetSchema();
+  source->Reset(source_schema);
+  for (auto page_id : morsel.pages_) {
+    uint32_t slot = 0;
+    // 页没读完说明chunk满了
+    while (!table_heap->ScanPage(page_id, &slot, source, exec_ctx_->GetTransaction())) {
+      Flush(source, bitmap, chunks);
+      source->Reset(source_schema);
+    }
+  }
+  Flush(source, bitmap, chunks);
+}
+
+void ParallelSeqScanExecutor::Flush(DataChunk *source, std::vector<uint64_t> *bitmap,
+                                    std::vector<DataChunk> *chunks) {
+  if (source->GetSize() == 0) {
+    return;
+  }
+  auto predicate = plan_->GetPredicate();
+  if (predicate != nullptr) {
+    bitmap->resize(FilterKernels::WordCount(source->GetSize()));
+    if (predicate->FilterBitmap(*source, bitmap->data())) {
+      source->SelectBitmap(bitmap->data());
+    } else {
+      predicate->FilterBatch(*source, source->GetSelection());
+    }
+  }
+  if (source->GetSelectedCount() == 0) {
+    return;
+  }
+  if (is_schema_same_) {
+    chunks->push_back(std::move(*source));
+    // 移走后的chunk不能再按原来的列复用
+    *source = DataChunk();
+    return;
+  }
+  // 选中的行少时几次合并到一个chunk
+  if (chunks->empty() || chunks->back().GetSize() + source->GetSelectedCount() > DataChunk::CAPACITY) {
+    chunks->emplace_back();
+    chunks->back().Reset(schema_);
+  }
+  chunks->back().AppendSelected(*source, column_map_);
+}
+
+void ParallelSeqScanExecutor::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(latch_);
+    stopped_ = true;
+  }
+  returned_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
@@ -0,0 +1,265 @@
+#include "executor/result_sink.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+std::unique_ptr<ResultSink> ResultSink::Create(OutputFormat format, std::ostream &stream) {
+  switch (format) {
+    case OutputFormat::kTsv:
+      return std::make_unique<TsvSink>(stream);
+    case OutputFormat::kBinary:
+      return std::make_unique<BinarySink>(stream);
+    default:
+      return std::make_unique<TableSink>(stream);
+  }
+}
+
+void ResultSink::AppendText(const ColumnVector &column, size_t pos, std::string *out) {
+  if (column.IsNull(pos)) {
+    out->append("NULL");
+    return;
+  }
+  switch (column.GetType()) {
+    case TypeId::kTypeInt:
+      out->append(std::to_string(column.GetInts()[pos]));
+      break;
+    case TypeId::kTypeFloat:
+      out->append(std::to_string(column.GetFloats()[pos]));
+      break;
+    default: {
+      // 与Field::toString相同，到第一个'\0'为止
+      const char *chars = column.GetChars(pos);
+      out->append(chars, std::find(chars, chars + column.GetLength(pos), '\0') - chars);
+      break;
+    }
+  }
+}
+
+void RowCollector::Write(const DataChunk &chunk) {
+  for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+    rows_out_->emplace_back();
+    chunk.GetRow(i, &rows_out_->back());
+  }
+}
+
+void TableSink::Begin(const Schema *schema) {
+  ResultSink::Begin(schema);
+  widths_.clear();
+  for (auto column : schema->GetColumns()) {
+    widths_.push_back(column->GetName().size());
+  }
+  sample_.clear();
+  sampling_ = true;
+}
+
+void TableSink::AppendDivider(std::string *out) const {
+  out->push_back('+');
+  for (auto width : widths_) {
+    out->append(width + 2, '-');
+    out->push_back('+');
+  }
+  out->push_back('\n');
+}
+
+void TableSink::AppendLine(const std::vector<std::string> &cells, std::string *out) const {
+  out->push_back('|');
+  for (size_t i = 0; i < cells.size(); i++) {
+    out->push_back(' ');
+    out->append(cells[i]);
+    out->append(cells[i].size() < widths_[i] ? widths_[i] - cells[i].size() : 0, ' ');
+    out->append(" |");
+  }
+  out->push_back('\n');
+}
+
+void TableSink::Write(const DataChunk &chunk) {
+  uint32_t column_count = chunk.GetColumnCount();
+  std::string out;
+  std::vector<std::string> cells(column_count);
+  for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+    uint32_t pos = chunk.GetSelected(i);
+    for (uint32_t j = 0; j < column_count; j++) {
+      cells[j].clear();
+      AppendText(chunk.GetColumn(j), pos, &cells[j]);
+    }
+    // 样本之外还有行，结果不会在样本内结束
+    if (sampling_ && sample_.size() == SAMPLE_ROWS) {
+      WriteSample(false);
+    }
+    if (!sampling_) {
+      AppendLine(cells, &out);
+      continue;
+    }
+    for (uint32_t j = 0; j < column_count; j++) {
+      widths_[j] = std::max(widths_[j], cells[j].size());
+    }
+    sample_.push_back(cells);
+  }
+  // 每个chunk写一次，之后的行不再留在内存中
+  if (!out.empty()) {
+    stream_.write(out.data(), out.size());
+    stream_.flush();
+  }
+}
+
+/*
+ * 样本不是全部结果时，类型决定的最大长度不太宽的列（int、短char）按最大长度对齐
+ */
+void TableSink::WriteSample(bool complete) {
+  if (!complete) {
+    for (uint32_t i = 0; i < widths_.size(); i++) {
+      const Column *column = schema_->GetColumn(i);
+      size_t type_width = 0;
+      if (column->GetType() == TypeId::kTypeInt) {
+        type_width = std::to_string(INT32_MIN).size();
+      } else if (column->GetType() == TypeId::kTypeChar) {
+        type_width = column->GetLength();
+      }
+      if (type_width <= MAX_SCHEMA_WIDTH) {
+        widths_[i] = std::max(widths_[i], type_width);
+      }
+    }
+  }
+  std::string out;
+  AppendDivider(&out);
+  std::vector<std::string> names;
+  for (auto column : schema_->GetColumns()) {
+    names.push_back(column->GetName());
+  }
+  AppendLine(names, &out);
+  AppendDivider(&out);
+  for (const auto &cells : sample_) {
+    AppendLine(cells, &out);
+  }
+  stream_.write(out.data(), out.size());
+  stream_.flush();
+  sample_.clear();
+  sample_.shrink_to_fit();
+  sampling_ = false;
+}
+
+void TableSink::End() {
+  if (rows_ == 0) {
+    return;
+  }
+  if (sampling_) {
+    WriteSample(true);
+  }
+  std::string out;
+  AppendDivider(&out);
+  stream_.write(out.data(), out.size());
+  stream_.flush();
+}
+
+void TsvSink::Begin(const Schema *schema) {
+  ResultSink::Begin(schema);
+  std::string out;
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    out.append(i == 0 ? "" : "\t").append(schema->GetColumn(i)->GetName());
+  }
+  out.push_back('\n');
+  stream_.write(out.data(), out.size());
+}
+
+void TsvSink::Write(const DataChunk &chunk) {
+  std::string out;
+  char buf[32];
+  for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+    uint32_t pos = chunk.GetSelected(i);
+    for (uint32_t j = 0; j < chunk.GetColumnCount(); j++) {
+      if (j > 0) {
+        out.push_back('\t');
+      }
+      const ColumnVector &column = chunk.GetColumn(j);
+      if (column.IsNull(pos)) {
+        out.append("\\N");
+        continue;
+      }
+      switch (column.GetType()) {
+        case TypeId::kTypeInt:
+          out.append(std::to_string(column.GetInts()[pos]));
+          break;
+        case TypeId::kTypeFloat:
+          out.append(buf, snprintf(buf, sizeof(buf), "%.9g", column.GetFloats()[pos]));
+          break;
+        default: {
+          const char *chars = column.GetChars(pos);
+          for (uint32_t k = 0; k < column.GetLength(pos); k++) {
+            switch (chars[k]) {
+              case '\\':
+                out.append("\\\\");
+                break;
+              case '\t':
+                out.append("\\t");
+                break;
+              case '\n':
+                out.append("\\n");
+                break;
+              case '\r':
+                out.append("\\r");
+                break;
+              default:
+                out.push_back(chars[k]);
+            }
+          }
+          break;
+        }
+      }
+    }
+    out.push_back('\n');
+  }
+  stream_.write(out.data(), out.size());
+  stream_.flush();
+}
+
+void BinarySink::Begin(const Schema *schema) {
+  ResultSink::Begin(schema);
+  std::string out(MAGIC, sizeof(MAGIC) - 1);
+  uint32_t column_count = schema->GetColumnCount();
+  out.append(reinterpret_cast<const char *>(&column_count), sizeof(uint32_t));
+  for (auto column : schema->GetColumns()) {
+    out.push_back(static_cast<char>(column->GetType()));
+    uint32_t length = column->GetName().size();
+    out.append(reinterpret_cast<const char *>(&length), sizeof(uint32_t));
+    out.append(column->GetName());
+  }
+  stream_.write(out.data(), out.size());
+}
+
+void BinarySink::Write(const DataChunk &chunk) {
+  std::string out;
+  for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+    uint32_t pos = chunk.GetSelected(i);
+    out.push_back(1);
+    for (uint32_t j = 0; j < chunk.GetColumnCount(); j++) {
+      const ColumnVector &column = chunk.GetColumn(j);
+      bool is_null = column.IsNull(pos);
+      out.push_back(is_null ? 1 : 0);
+      if (is_null) {
+        continue;
+      }
+      switch (column.GetType()) {
+        case TypeId::kTypeInt:
+          out.append(reinterpret_cast<const char *>(column.GetInts() + pos), sizeof(int32_t));
+          break;
+        case TypeId::kTypeFloat:
+          out.append(reinterpret_cast<const char *>(column.GetFloats() + pos), sizeof(float));
+          break;
+        default: {
+          uint32_t length = column.GetLength(pos);
+          out.append(reinterpret_cast<const char *>(&length), sizeof(uint32_t));
+          out.append(column.GetChars(pos), length);
+          break;
+        }
+      }
+    }
+  }
+  stream_.write(out.data(), out.size());
+  stream_.flush();
+}
+
+void BinarySink::End() {
+  stream_.put(0);
+  stream_.flush();
+}
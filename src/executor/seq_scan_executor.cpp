@@ -40,22 +40,24 @@ void SeqScanExecutor::TupleTransfer(const Schema *table_schema, const Schema *ou
 
 void SeqScanExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
-  auto first_row = table_info_->GetTableHeap()->Begin(nullptr);
-  iterator_ = (table_info_->GetTableHeap()->Begin(exec_ctx_->GetTransaction()));
+  iterator_ = table_info_->Begin(exec_ctx_->GetTransaction());
   schema_ = plan_->OutputSchema();
   is_schema_same_ = SchemaEqual(table_info_->GetSchema(), schema_);
+  cursor_.Set(table_info_->IsClustered() ? INVALID_PAGE_ID : table_info_->GetTableHeap()->GetFirstPageId(), 0);
+  column_map_.clear();
+  for (auto column : schema_->GetColumns()) {
+    column_map_.push_back(column->GetTableInd());
+  }
 }
 
 bool SeqScanExecutor::Next(Row *row, RowId *rid) {
-  auto predicate = plan_->GetPredicate();
+  auto predicate = plan_->GetCompiledPredicate();
   auto table_schema = table_info_->GetSchema();
-  while (iterator_ != table_info_->GetTableHeap()->End()) {
+  while (iterator_ != table_info_->End()) {
     auto p_row = &(*iterator_);
-    if (predicate != nullptr) {
-      if (!predicate->Evaluate(p_row).CompareEquals(Field(kTypeInt, 1))) {
-        iterator_++;
-        continue;
-      }
+    if (predicate != nullptr && !predicate->EvaluatePredicate(*p_row)) {
+      ++iterator_;
+      continue;
     }
     *rid = iterator_->GetRowId();
     if (!is_schema_same_) {
@@ -63,8 +65,45 @@ bool SeqScanExecutor::Next(Row *row, RowId *rid) {
     } else {
       *row = *p_row;
     }
-    iterator_++;
+    ++iterator_;
     return true;
   }
   return false;
 }
+
+bool SeqScanExecutor::NextBatch(DataChunk *chunk) {
+  auto predicate = plan_->GetPredicate();
+  auto table_schema = table_info_->GetSchema();
+  // 输出和表的列相同时直接解码到chunk，过滤只改选择向量
+  DataChunk *source = is_schema_same_ ? chunk : &scan_chunk_;
+  const Schema *source_schema = is_schema_same_ ? schema_ : table_schema;
+  chunk->Reset(schema_);
+  while (true) {
+    source->Reset(source_schema);
+    if (table_info_->IsClustered()) {
+      for (; iterator_ != table_info_->End() && !source->IsFull(); ++iterator_) {
+        source->AppendRow(*iterator_, iterator_->GetRowId());
+      }
+    } else {
+      table_info_->GetTableHeap()->ScanTuples(&cursor_, source, exec_ctx_->GetTransaction());
+    }
+    if (source->GetSize() == 0) {
+      return false;
+    }
+    if (predicate != nullptr) {
+      // 能用SIMD kernel时按位图过滤，否则按选择向量
+      bitmap_.resize(FilterKernels::WordCount(source->GetSize()));
+      if (predicate->FilterBitmap(*source, bitmap_.data())) {
+        source->SelectBitmap(bitmap_.data());
+      } else {
+        predicate->FilterBatch(*source, source->GetSelection());
+      }
+    }
+    if (source != chunk) {
+      chunk->AppendSelected(*source, column_map_);
+    }
+    if (chunk->GetSelectedCount() > 0) {
+      return true;
+    }
+  }
+}
@@ -0,0 +1,346 @@
+#include "executor/executors/sort_executor.h"
+
+#include <algorithm>
+#include <cstring>
+
+SortExecutor::SortExecutor(ExecuteContext *exec_ctx, const SortPlanNode *plan,
+                           std::unique_ptr<AbstractExecutor> &&child)
+    : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child)) {}
+
+void SortExecutor::Init() {
+  child_->Init();
+  const Schema *schema = GetOutputSchema();
+  column_map_.clear();
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    column_map_.push_back(i);
+  }
+  // int和float的前缀就是整个值，char只有前7个字节
+  prefix_exact_ = schema->GetColumn(plan_->GetOrderBys()[0].first)->GetType() != kTypeChar;
+  int64_t limit = plan_->GetLimit();
+  limit_ = limit == SortPlanNode::NO_LIMIT ? SIZE_MAX : static_cast<size_t>(limit);
+  top_n_ = limit != SortPlanNode::NO_LIMIT && limit <= TOP_N_MAX_ROWS;
+  chunks_.clear();
+  entries_.clear();
+  memory_ = 0;
+  dropped_ = 0;
+  runs_.clear();
+  run_count_ = 0;
+  merge_heap_.clear();
+  cursor_ = 0;
+  emitted_ = 0;
+  row_chunk_.Reset(schema);
+  row_pos_ = 0;
+  if (limit_ == 0) {
+    return;
+  }
+  if (!top_n_) {
+    SortAll();
+    return;
+  }
+  DataChunk input;
+  while (child_->NextBatch(&input)) {
+    PushTopN(input);
+  }
+  std::sort_heap(entries_.begin(), entries_.end(),
+                 [this](const SortEntry &lhs, const SortEntry &rhs) { return Less(lhs, rhs); });
+}
+
+/*
+ * 前缀最高字节是null标记，null为0排在所有值前面；其余7个字节是值的大端编码：int翻转符号位，
+ * float负数取反、正数翻转符号位（同ArtIndex::EncodeKey），char取前7个字节、不足补0。降序时整个取反
+ */
+uint64_t SortExecutor::MakePrefix(const DataChunk &chunk, size_t pos) const {
+  const auto &order_by = plan_->GetOrderBys()[0];
+  const ColumnVector &column = chunk.GetColumn(order_by.first);
+  uint64_t prefix = 0;
+  if (!column.IsNull(pos)) {
+    prefix = 1ULL << 56;
+    switch (column.GetType()) {
+      case kTypeInt:
+        prefix |= static_cast<uint64_t>(static_cast<uint32_t>(column.GetInts()[pos]) ^ 0x80000000u) << 24;
+        break;
+      case kTypeFloat: {
+        // -0.0和0.0相等
+        float value = column.GetFloats()[pos] == 0 ? 0 : column.GetFloats()[pos];
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(uint32_t));
+        bits = (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+        prefix |= static_cast<uint64_t>(bits) << 24;
+        break;
+      }
+      default: {
+        const char *chars = column.GetChars(pos);
+        uint32_t length = std::min(column.GetLength(pos), 7U);
+        for (uint32_t j = 0; j < length; j++) {
+          prefix |= static_cast<uint64_t>(static_cast<uint8_t>(chars[j])) << (8 * (6 - j));
+        }
+        break;
+      }
+    }
+  }
+  return order_by.second ? ~prefix : prefix;
+}
+
+int SortExecutor::CompareRows(uint64_t lhs_prefix, const DataChunk &lhs, size_t lhs_pos, uint64_t rhs_prefix,
+                              const DataChunk &rhs, size_t rhs_pos) const {
+  if (lhs_prefix != rhs_prefix) {
+    return lhs_prefix < rhs_prefix ? -1 : 1;
+  }
+  const auto &order_bys = plan_->GetOrderBys();
+  for (size_t k = prefix_exact_ ? 1 : 0; k < order_bys.size(); k++) {
+    const ColumnVector &left = lhs.GetColumn(order_bys[k].first);
+    const ColumnVector &right = rhs.GetColumn(order_bys[k].first);
+    int cmp = 0;
+    bool left_null = left.IsNull(lhs_pos);
+    bool right_null = right.IsNull(rhs_pos);
+    if (left_null || right_null) {
+      cmp = left_null == right_null ? 0 : (left_null ? -1 : 1);
+    } else {
+      switch (left.GetType()) {
+        case kTypeInt: {
+          int32_t a = left.GetInts()[lhs_pos];
+          int32_t b = right.GetInts()[rhs_pos];
+          cmp = a < b ? -1 : (a > b ? 1 : 0);
+          break;
+        }
+        case kTypeFloat: {
+          float a = left.GetFloats()[lhs_pos];
+          float b = right.GetFloats()[rhs_pos];
+          cmp = a < b ? -1 : (a > b ? 1 : 0);
+          break;
+        }
+        default: {
+          // 与TypeChar的比较一致：逐字节比较，相同时短的在前
+          uint32_t a = left.GetLength(lhs_pos);
+          uint32_t b = right.GetLength(rhs_pos);
+          cmp = memcmp(left.GetChars(lhs_pos), right.GetChars(rhs_pos), std::min(a, b));
+          if (cmp == 0) {
+            cmp = a < b ? -1 : (a > b ? 1 : 0);
+          }
+          break;
+        }
+      }
+    }
+    if (cmp != 0) {
+      return order_bys[k].second ? -cmp : cmp;
+    }
+  }
+  return 0;
+}
+
+/*
+ * 子节点的chunk原样保留，只排序entry；超过work memory时把已读的行排好序写成一个run
+ */
+void SortExecutor::SortAll() {
+  size_t work_memory = exec_ctx_->GetWorkMemory();
+  while (true) {
+    chunks_.emplace_back();
+    DataChunk &chunk = chunks_.back();
+    if (!child_->NextBatch(&chunk)) {
+      chunks_.pop_back();
+      break;
+    }
+    auto index = static_cast<uint32_t>(chunks_.size() - 1);
+    for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+      uint32_t pos = chunk.GetSelected(i);
+      entries_.push_back({MakePrefix(chunk, pos), index, pos});
+    }
+    memory_ += chunk.GetMemoryUsage() + chunk.GetSelectedCount() * sizeof(SortEntry);
+    if (memory_ > work_memory) {
+      SpillRun();
+    }
+  }
+  if (runs_.empty()) {
+    std::sort(entries_.begin(), entries_.end(),
+              [this](const SortEntry &lhs, const SortEntry &rhs) { return Less(lhs, rhs); });
+    return;
+  }
+  if (!entries_.empty()) {
+    SpillRun();
+  }
+  // run太多时先把最早的几个合并成一个，直到剩下的能一次合并
+  size_t fan_in = MergeFanIn();
+  while (runs_.size() > fan_in) {
+    MergeRuns(0, fan_in);
+  }
+  StartMerge();
+}
+
+void SortExecutor::SpillRun() {
+  std::sort(entries_.begin(), entries_.end(),
+            [this](const SortEntry &lhs, const SortEntry &rhs) { return Less(lhs, rhs); });
+  auto run = std::make_unique<Run>();
+  run->file_ = std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager(), GetOutputSchema());
+  for (const auto &entry : entries_) {
+    run->file_->AppendRowAt(chunks_[entry.chunk_], entry.pos_);
+  }
+  runs_.push_back(std::move(run));
+  run_count_++;
+  chunks_.clear();
+  entries_.clear();
+  memory_ = 0;
+}
+
+void SortExecutor::PushTopN(const DataChunk &input) {
+  auto less = [this](const SortEntry &lhs, const SortEntry &rhs) { return Less(lhs, rhs); };
+  for (size_t i = 0; i < input.GetSelectedCount(); i++) {
+    uint32_t pos = input.GetSelected(i);
+    uint64_t prefix = MakePrefix(input, pos);
+    // 不在前limit_行中的行不用拷贝
+    bool full = entries_.size() >= limit_;
+    if (full) {
+      const SortEntry &top = entries_.front();
+      if (CompareRows(prefix, input, pos, top.prefix_, chunks_[top.chunk_], top.pos_) >= 0) {
+        continue;
+      }
+    }
+    if (chunks_.empty() || chunks_.back().IsFull()) {
+      chunks_.emplace_back();
+      chunks_.back().Reset(GetOutputSchema());
+    }
+    chunks_.back().AppendRowAt(input, pos, column_map_);
+    SortEntry entry{prefix, static_cast<uint32_t>(chunks_.size() - 1),
+                    static_cast<uint32_t>(chunks_.back().GetSize() - 1)};
+    if (full) {
+      std::pop_heap(entries_.begin(), entries_.end(), less);
+      entries_.back() = entry;
+      dropped_++;
+    } else {
+      entries_.push_back(entry);
+    }
+    std::push_heap(entries_.begin(), entries_.end(), less);
+    if (dropped_ > entries_.size() && dropped_ > DataChunk::CAPACITY) {
+      CompactTopN();
+    }
+  }
+}
+
+void SortExecutor::CompactTopN() {
+  std::vector<DataChunk> compacted;
+  for (auto &entry : entries_) {
+    if (compacted.empty() || compacted.back().IsFull()) {
+      compacted.emplace_back();
+      compacted.back().Reset(GetOutputSchema());
+    }
+    compacted.back().AppendRowAt(chunks_[entry.chunk_], entry.pos_, column_map_);
+    entry.chunk_ = compacted.size() - 1;
+    entry.pos_ = compacted.back().GetSize() - 1;
+  }
+  chunks_ = std::move(compacted);
+  dropped_ = 0;
+}
+
+/*
+ * 每个run合并时占一个chunk和一页的缓冲，chunk的大小按run中行的平均长度估计
+ */
+size_t SortExecutor::MergeFanIn() const {
+  size_t rows = 0;
+  size_t bytes = 0;
+  for (const auto &run : runs_) {
+    rows += run->file_->GetRowCount();
+    bytes += run->file_->GetByteCount();
+  }
+  size_t run_memory = (rows == 0 ? 0 : bytes / rows * DataChunk::CAPACITY) + PAGE_SIZE;
+  return std::max<size_t>(2, exec_ctx_->GetWorkMemory() / run_memory);
+}
+
+void SortExecutor::MergeRuns(size_t first, size_t count) {
+  std::vector<std::unique_ptr<Run>> merging;
+  for (size_t i = first; i < first + count; i++) {
+    merging.push_back(std::move(runs_[i]));
+  }
+  runs_.erase(runs_.begin() + first, runs_.begin() + first + count);
+  std::swap(runs_, merging);
+  StartMerge();
+  auto merged = std::make_unique<Run>();
+  merged->file_ = std::make_unique<SpillFile>(exec_ctx_->GetBufferPoolManager(), GetOutputSchema());
+  while (!merge_heap_.empty()) {
+    const Run &top = *runs_[merge_heap_.front()];
+    merged->file_->AppendRowAt(top.chunk_, top.pos_);
+    PopMerged(nullptr);
+  }
+  // 合并完的run连同临时页一起释放
+  std::swap(runs_, merging);
+  runs_.push_back(std::move(merged));
+  run_count_++;
+}
+
+void SortExecutor::StartMerge() {
+  merge_heap_.clear();
+  for (size_t i = 0; i < runs_.size(); i++) {
+    Run &run = *runs_[i];
+    run.file_->Rewind();
+    if (run.file_->Read(&run.chunk_)) {
+      run.pos_ = 0;
+      run.prefix_ = MakePrefix(run.chunk_, 0);
+      merge_heap_.push_back(i);
+    }
+  }
+  std::make_heap(merge_heap_.begin(), merge_heap_.end(),
+                 [this](size_t lhs, size_t rhs) { return RunAfter(lhs, rhs); });
+}
+
+bool SortExecutor::AdvanceRun(Run *run) {
+  if (++run->pos_ >= run->chunk_.GetSize()) {
+    if (!run->file_->Read(&run->chunk_)) {
+      return false;
+    }
+    run->pos_ = 0;
+  }
+  run->prefix_ = MakePrefix(run->chunk_, run->pos_);
+  return true;
+}
+
+bool SortExecutor::RunAfter(size_t lhs, size_t rhs) const {
+  const Run &left = *runs_[lhs];
+  const Run &right = *runs_[rhs];
+  return CompareRows(left.prefix_, left.chunk_, left.pos_, right.prefix_, right.chunk_, right.pos_) > 0;
+}
+
+bool SortExecutor::PopMerged(DataChunk *chunk) {
+  if (merge_heap_.empty()) {
+    return false;
+  }
+  auto after = [this](size_t lhs, size_t rhs) { return RunAfter(lhs, rhs); };
+  std::pop_heap(merge_heap_.begin(), merge_heap_.end(), after);
+  Run &run = *runs_[merge_heap_.back()];
+  if (chunk != nullptr) {
+    chunk->AppendRowAt(run.chunk_, run.pos_, column_map_);
+  }
+  if (AdvanceRun(&run)) {
+    std::push_heap(merge_heap_.begin(), merge_heap_.end(), after);
+  } else {
+    merge_heap_.pop_back();
+  }
+  return true;
+}
+
+bool SortExecutor::Next(Row *row, RowId *rid) {
+  while (row_pos_ >= row_chunk_.GetSelectedCount()) {
+    if (!NextBatch(&row_chunk_)) {
+      return false;
+    }
+    row_pos_ = 0;
+  }
+  row_chunk_.GetRow(row_pos_++, row);
+  *rid = row->GetRowId();
+  return true;
+}
+
+bool SortExecutor::NextBatch(DataChunk *chunk) {
+  chunk->Reset(GetOutputSchema());
+  while (!chunk->IsFull() && emitted_ < limit_) {
+    if (!runs_.empty()) {
+      if (!PopMerged(chunk)) {
+        break;
+      }
+    } else if (cursor_ < entries_.size()) {
+      const SortEntry &entry = entries_[cursor_++];
+      chunk->AppendRowAt(chunks_[entry.chunk_], entry.pos_, column_map_);
+    } else {
+      break;
+    }
+    emitted_++;
+  }
+  return chunk->GetSelectedCount() > 0;
+}
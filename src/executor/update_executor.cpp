@@ -4,6 +4,8 @@
 
 #include "executor/executors/update_executor.h"
 
+#include "index/art_index.h"
+
 UpdateExecutor::UpdateExecutor(ExecuteContext *exec_ctx, const UpdatePlanNode *plan,
                                std::unique_ptr<AbstractExecutor> &&child_executor)
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
@@ -13,27 +15,112 @@ void UpdateExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
   exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->GetTableName(), index_info_);
   txn_ = exec_ctx_->GetTransaction();
+  // clustered table的记录随主键移动，扫描叶子时修改会把改过的记录再读一遍，先取出所有要更新的记录
+  if (table_info_->IsClustered()) {
+    Row src_row;
+    RowId src_rid;
+    while (NextChild(&src_row, &src_rid)) {
+      src_row.SetRowId(src_rid);
+      source_rows_.push_back(src_row);
+    }
+    source_drained_ = true;
+  }
+}
+
+bool UpdateExecutor::NextChild(Row *row, RowId *rid) {
+  while (child_cursor_ >= child_chunk_.GetSelectedCount()) {
+    // 子节点取完后chunk被清空，游标也要归零
+    child_cursor_ = 0;
+    if (!child_executor_->NextBatch(&child_chunk_)) {
+      return false;
+    }
+  }
+  child_chunk_.GetRow(child_cursor_++, row);
+  *rid = row->GetRowId();
+  return true;
+}
+
+bool UpdateExecutor::NextSource(Row *row, RowId *rid) {
+  if (!source_drained_) {
+    return NextChild(row, rid);
+  }
+  if (source_cursor_ == source_rows_.size()) {
+    return false;
+  }
+  *row = source_rows_[source_cursor_++];
+  *rid = row->GetRowId();
+  return true;
 }
 
 bool UpdateExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
+  if (pending_ == 0 && !UpdateBatch()) {
+    return false;
+  }
+  pending_--;
+  return true;
+}
+
+bool UpdateExecutor::NextBatch(DataChunk *chunk) {
+  chunk->Reset(nullptr);
+  if (pending_ == 0 && !UpdateBatch()) {
+    return false;
+  }
+  Row updated;
+  for (; pending_ > 0; pending_--) {
+    chunk->AppendRow(updated, INVALID_ROWID);
+  }
+  return true;
+}
+
+bool UpdateExecutor::UpdateBatch() {
+  if (stopped_) {
+    return false;
+  }
+  std::vector<Row> src_rows;
+  std::vector<Row> dest_rows;
+  std::vector<RowId> src_rids;
   Row src_row;
   RowId src_rid;
-  if (child_executor_->Next(&src_row, &src_rid)) {
+  while (src_rows.size() < DML_BATCH_SIZE && NextSource(&src_row, &src_rid)) {
     Row dest_row = GenerateUpdatedTuple(src_row);
-    if (!table_info_->GetTableHeap()->UpdateTuple(dest_row, src_rid, txn_)) {
-      return false;
+    if (!table_info_->UpdateTuple(dest_row, src_rid, txn_)) {
+      stopped_ = true;
+      break;
     }
-    Row src_key_row;
-    Row dest_key_row;
-    for (auto info : index_info_) {  // 更新索引
-      src_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), src_key_row);
-      dest_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), dest_key_row);
-      info->GetIndex()->RemoveEntry(src_key_row, src_rid, txn_);
-      info->GetIndex()->InsertEntry(dest_key_row, src_rid, txn_);
+    src_rows.push_back(src_row);
+    dest_rows.push_back(dest_row);
+    src_rids.push_back(src_rid);
+  }
+  if (src_rows.empty()) {
+    return false;
+  }
+  auto schema = table_info_->GetSchema();
+  for (auto info : index_info_) {  // 更新索引
+    auto key_schema = info->GetIndexKeySchema();
+    std::vector<Row> src_keys;
+    std::vector<Row> dest_keys;
+    std::vector<RowId> changed_src_rids;
+    std::vector<RowId> changed_dest_rids;
+    for (size_t i = 0; i < src_rows.size(); i++) {
+      Row src_key_row;
+      Row dest_key_row;
+      src_rows[i].GetKeyFromRow(schema, key_schema, src_key_row);
+      dest_rows[i].GetKeyFromRow(schema, key_schema, dest_key_row);
+      // 记录移动后(heap换页或clustered table改主键)，key不变的entry也要指向新的row id
+      if (src_rids[i] == dest_rows[i].GetRowId() &&
+          ArtIndex::EncodeKey(src_key_row, key_schema) == ArtIndex::EncodeKey(dest_key_row, key_schema)) {
+        continue;
+      }
+      src_keys.push_back(src_key_row);
+      dest_keys.push_back(dest_key_row);
+      changed_src_rids.push_back(src_rids[i]);
+      changed_dest_rids.push_back(dest_rows[i].GetRowId());
     }
-    return true;
+    info->RemoveEntries(src_keys, changed_src_rids, txn_);
+    info->InsertEntries(dest_keys, changed_dest_rids, txn_);
   }
-  return false;
+  pending_ = src_rows.size();
+  return true;
 }
 
 Row UpdateExecutor::GenerateUpdatedTuple(const Row &src_row) {
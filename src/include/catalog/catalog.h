@@ -75,7 +75,12 @@ class CatalogManager {
 
   ~CatalogManager();
 
-  dberr_t CreateTable(const std::string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info);
+  /**
+   * Create a table with an index on each unique column and one on the primary key. The rows of a
+   * clustered table are stored in its primary key index, which must be a single int column.
+   */
+  dberr_t CreateTable(const std::string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info,
+                      bool clustered = false);
 
   dberr_t GetTable(const std::string &table_name, TableInfo *&table_info);
 
@@ -87,6 +92,15 @@ class CatalogManager {
 
   dberr_t GetTableIndexes(const std::string &table_name, std::vector<IndexInfo *> &indexes) const;
 
+  /** Pin the top levels of a b+ tree index, 0 unpins them, kept across restarts. Fails for other index types. */
+  dberr_t SetIndexPinnedLevels(const std::string &table_name, const std::string &index_name, int levels);
+
+  /** Add or drop the bloom filter of an index, unique indexes get one when they are created. */
+  dberr_t SetIndexBloomFilter(const std::string &table_name, const std::string &index_name, bool enable);
+
+  /** Rebuild the statistics of a table (ANALYZE), they replace the previous ones on disk. */
+  dberr_t AnalyzeTable(const std::string &table_name, Txn *txn);
+
   dberr_t DropTable(const std::string &table_name);
 
   dberr_t DropIndex(const std::string &table_name, const std::string &index_name);
@@ -94,10 +108,24 @@ class CatalogManager {
  private:
   dberr_t FlushCatalogMetaPage() const;
 
+  dberr_t FlushIndexMetaPage(index_id_t index_id) const;
+
+  dberr_t FlushTableMetaPage(table_id_t table_id) const;
+
+  /** Read the statistics of a loaded table, if it was analyzed. */
+  void LoadStatistics(TableInfo *table_info);
+
+  dberr_t DropIndex(const std::string &table_name, const std::string &index_name, bool drop_table);
+
   dberr_t LoadTable(const table_id_t table_id, const page_id_t page_id);
 
   dberr_t LoadIndex(const index_id_t index_id, const page_id_t page_id);
 
+  /** Insert the rows of the table into a new index, POPULATE_BATCH_SIZE sorted keys at a time. */
+  dberr_t PopulateIndex(IndexInfo *index_info, TableInfo *table_info, Txn *txn);
+
+  static constexpr size_t POPULATE_BATCH_SIZE = 16384;
+
   dberr_t GetTable(const table_id_t table_id, TableInfo *&table_info);
 
  private:
@@ -6,15 +6,21 @@
 #include "catalog/table.h"
 #include "common/macros.h"
 #include "common/rowid.h"
+#include "index/art_index.h"
 #include "index/b_plus_tree_index.h"
+#include "index/bloom_filter.h"
+#include "index/clustered_index.h"
 #include "index/generic_key.h"
+#include "index/hash_index.h"
 #include "record/schema.h"
 
 class IndexMetadata {
   friend class IndexInfo;
 
  public:
-  static IndexMetadata *Create(const index_id_t index_id, const std::string &index_name, const table_id_t table_id, const std::vector<uint32_t> &key_map);
+  static IndexMetadata *Create(const index_id_t index_id, const std::string &index_name, const table_id_t table_id, const std::vector<uint32_t> &key_map, bool unique = true,
+                                const std::string &index_type = "bptree", page_id_t bloom_page_id = INVALID_PAGE_ID,
+                                uint32_t pinned_levels = 0);
 
   uint32_t SerializeTo(char *buf) const;
 
@@ -32,10 +38,19 @@ class IndexMetadata {
 
   inline index_id_t GetIndexId() const { return index_id_; }
 
+  inline bool IsUnique() const { return unique_; }
+
+  inline std::string GetIndexType() const { return index_type_; }
+
+  inline page_id_t GetBloomPageId() const { return bloom_page_id_; }
+
+  inline uint32_t GetPinnedLevels() const { return pinned_levels_; }
+
  private:
   IndexMetadata() = delete;
 
-  explicit IndexMetadata(const index_id_t index_id, const std::string &index_name, const table_id_t table_id, const std::vector<uint32_t> &key_map);
+  explicit IndexMetadata(const index_id_t index_id, const std::string &index_name, const table_id_t table_id, const std::vector<uint32_t> &key_map, bool unique,
+                         const std::string &index_type, page_id_t bloom_page_id, uint32_t pinned_levels);
 
  private:
   static constexpr uint32_t INDEX_METADATA_MAGIC_NUM = 344528;
@@ -43,10 +58,23 @@ class IndexMetadata {
   std::string index_name_;
   table_id_t table_id_;
   std::vector<uint32_t> key_map_; /** The mapping of index key to tuple key */
+  bool unique_;                   /** Whether the index rejects duplicate keys */
+  std::string index_type_;        /** "bptree", "hash", "art" or "clustered" (rows of a clustered table) */
+  page_id_t bloom_page_id_;       /** First page of the persisted bloom filter, INVALID_PAGE_ID if none */
+  uint32_t pinned_levels_;        /** Top levels of a b+ tree index kept pinned in the buffer pool */
 };
 
 /**
  * The IndexInfo class maintains metadata about a index.
+ *
+ * An index can keep a bloom filter over its keys, which answers most lookups of absent keys
+ * (e.g. the duplicate check of every insert into a unique index) without touching the index.
+ * The filter is only maintained by InsertEntry and RemoveEntry of IndexInfo, writes that go
+ * to GetIndex() directly must not be followed by MayContain.
+ *
+ * The filter is persisted to a chain of pages every few thousand changes and when the catalog
+ * closes. The first page records whether the copy on disk is complete, an incomplete copy
+ * (the database was not closed after the last change) is rebuilt from the table rows.
  */
 class IndexInfo {
  public:
@@ -56,15 +84,30 @@ class IndexInfo {
     delete meta_data_;
     delete index_;
     delete key_schema_;
+    delete filter_;
   }
 
   void Init(IndexMetadata *meta_data, TableInfo *table_info, BufferPoolManager *buffer_pool_manager) {
     // Step1: init index metadata and table info
     meta_data_ = meta_data;
+    table_info_ = table_info;
+    buffer_pool_manager_ = buffer_pool_manager;
     // Step2: mapping index key to key schema
     key_schema_ = Schema::ShallowCopySchema(table_info->GetSchema(), meta_data->GetKeyMapping());
     // Step3: call CreateIndex to create the index
-    index_ = CreateIndex(buffer_pool_manager, "bptree");
+    index_ = CreateIndex(buffer_pool_manager, meta_data->GetIndexType());
+    // Step4: a clustered index holds the rows of its table
+    if (meta_data->GetIndexType() == "clustered" && index_ != nullptr) {
+      table_info->SetClusteredIndex(dynamic_cast<ClusteredIndex *>(index_));
+    }
+    // Step5: load the bloom filter if the index has one
+    if (meta_data->GetBloomPageId() != INVALID_PAGE_ID) {
+      LoadBloomFilter();
+    }
+    // Step6: pin the top levels of a b+ tree index again
+    if (meta_data->GetPinnedLevels() != 0) {
+      SetPinnedLevels(meta_data->GetPinnedLevels());
+    }
   }
 
   inline Index *GetIndex() { return index_; }
@@ -73,15 +116,76 @@ class IndexInfo {
 
   IndexSchema *GetIndexKeySchema() { return key_schema_; }
 
+  bool IsUnique() const { return meta_data_->IsUnique(); }
+
+  std::string GetIndexType() const { return meta_data_->GetIndexType(); }
+
+  IndexMetadata *GetMetadata() { return meta_data_; }
+
+  /** Insert into the index and its bloom filter. */
+  dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn);
+
+  /** Remove from the index, the key stays in the bloom filter until it is rebuilt. */
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn);
+
+  /** Batched InsertEntry, @return DB_FAILED if any key was a duplicate */
+  dberr_t InsertEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn);
+
+  dberr_t RemoveEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn);
+
+  /** Equality lookups of a batch of keys, keys ruled out by the bloom filter are not probed. */
+  dberr_t LookupMany(const std::vector<Row> &keys, std::vector<std::vector<RowId>> &results, Txn *txn);
+
+  /** @return false if the index definitely has no entry equal to key */
+  bool MayContain(const Row &key) const;
+
+  bool HasBloomFilter() const { return filter_ != nullptr; }
+
+  size_t GetBloomFilterBytes() const { return filter_ == nullptr ? 0 : filter_->GetMemoryUsage(); }
+
+  /** Build a bloom filter from the table rows and persist it, the caller rewrites the metadata page. */
+  void CreateBloomFilter();
+
+  /** Drop the bloom filter and free its pages, the caller rewrites the metadata page. */
+  void DropBloomFilter();
+
+  /** Write the bloom filter to its pages and mark the copy on disk complete. */
+  void FlushBloomFilter();
+
+  /**
+   * Keep the top levels of a b+ tree index pinned, the caller rewrites the metadata page.
+   * @return DB_FAILED if the index is not a b+ tree
+   */
+  dberr_t SetPinnedLevels(int levels);
+
  private:
+  static constexpr uint32_t BLOOM_FILTER_MAGIC_NUM = 725163;
+  /** Changes between two flushes, at least a quarter of the filter capacity */
+  static constexpr size_t BLOOM_FLUSH_INTERVAL = 4096;
+
   explicit IndexInfo() : meta_data_{nullptr}, index_{nullptr}, key_schema_{nullptr} {}
 
   Index *CreateIndex(BufferPoolManager *buffer_pool_manager, const string &index_type);
 
+  uint64_t HashKey(const Row &key) const;
+
+  void LoadBloomFilter();
+
+  // Refill the filter with the keys of the table rows, sized for twice as many keys.
+  void RebuildBloomFilter();
+
+  // Count changes, marking the copy on disk incomplete on the first change after a flush.
+  void OnBloomFilterChange(size_t count = 1);
+
  private:
   IndexMetadata *meta_data_;
   Index *index_;
   IndexSchema *key_schema_;
+  TableInfo *table_info_{nullptr};
+  BufferPoolManager *buffer_pool_manager_{nullptr};
+  BloomFilter *filter_{nullptr};
+  size_t filter_keys_{0};     /** Keys inserted into the filter since it was built */
+  size_t filter_changes_{0};  /** Changes since the last flush */
 };
 
 #endif  // MINISQL_INDEXES_H
@@ -0,0 +1,125 @@
+#ifndef MINISQL_STATISTICS_H
+#define MINISQL_STATISTICS_H
+
+#include <memory>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "concurrency/txn.h"
+#include "record/field.h"
+#include "record/row.h"
+#include "record/schema.h"
+
+class TableInfo;
+
+/**
+ * Statistics of one column, built by ANALYZE from a sample of the table rows.
+ *
+ * The histogram is equi-depth: bounds_ holds the minimum, the maximum and the values between
+ * them that split the sorted non-null sample into buckets of the same size. A value filling a
+ * whole bucket (bounds_[i] == bounds_[i + 1]) is at least that frequent.
+ */
+class ColumnStatistics {
+  friend class TableStatistics;
+
+ public:
+  static constexpr uint32_t MAX_BUCKETS = 64;
+
+  explicit ColumnStatistics(TypeId type) : type_(type) {}
+
+  inline TypeId GetType() const { return type_; }
+
+  inline double GetNullFraction() const { return null_fraction_; }
+
+  /** @return Estimated number of distinct non-null values in the table */
+  inline double GetDistinctCount() const { return distinct_; }
+
+  /**
+   * @return Correlation between the order of the values and the order of the rows in the table, from -1
+   * to 1. Near 1 or -1, rows with neighbouring values sit on the same pages.
+   */
+  inline double GetCorrelation() const { return correlation_; }
+
+  inline size_t GetBucketCount() const { return bounds_.empty() ? 0 : bounds_.size() - 1; }
+
+  inline const std::vector<std::unique_ptr<Field>> &GetBounds() const { return bounds_; }
+
+  /** @return Estimated fraction of the rows equal to value (nulls never are) */
+  double EstimateEqual(const Field &value) const;
+
+  /** @return Estimated fraction of the rows less than (or equal to, if inclusive) value */
+  double EstimateLess(const Field &value, bool inclusive) const;
+
+  /**
+   * @param comparison One of "=", "<>", "<", "<=", ">", ">=", "is", "not" as in ComparisonExpression
+   * @return Estimated fraction of the rows for which `column comparison value` holds
+   */
+  double EstimateComparison(const std::string &comparison, const Field &value) const;
+
+ private:
+  // Position of value inside bucket, 0 at its lower bound and 1 at its upper bound
+  double PositionInBucket(size_t bucket, const Field &value) const;
+
+  TypeId type_;
+  double null_fraction_{0};
+  double distinct_{0};
+  double correlation_{0};
+  std::vector<std::unique_ptr<Field>> bounds_;
+};
+
+/**
+ * Statistics of a table, built by ANALYZE and read by the planner to estimate how many rows a
+ * predicate selects. The table is scanned once: rows and pages are counted exactly and a uniform
+ * sample of at most SAMPLE_SIZE rows (reservoir sampling) is kept for the column statistics.
+ *
+ * Statistics are persisted to a chain of pages referenced by the table metadata. They are not
+ * maintained by later inserts and deletes, ANALYZE again to refresh them.
+ */
+class TableStatistics {
+ public:
+  static constexpr uint32_t SAMPLE_SIZE = 30000;
+
+  /**
+   * Scan the table and build its statistics.
+   * @param seed Seed of the sample, so that a build can be repeated
+   */
+  static TableStatistics *Build(TableInfo *table_info, Txn *txn, uint32_t seed = 0);
+
+  inline uint64_t GetRowCount() const { return row_count_; }
+
+  inline uint32_t GetSampleSize() const { return sample_size_; }
+
+  /** @return Pages holding the rows, heap pages or the leaves of a clustered table */
+  inline uint32_t GetPageCount() const { return page_count_; }
+
+  inline const ColumnStatistics &GetColumn(uint32_t column) const { return columns_[column]; }
+
+  inline uint32_t GetColumnCount() const { return columns_.size(); }
+
+  uint32_t SerializeTo(char *buf) const;
+
+  uint32_t GetSerializedSize() const;
+
+  static uint32_t DeserializeFrom(char *buf, TableStatistics *&statistics);
+
+  /** Write the statistics to a new chain of pages, @return the first page */
+  page_id_t WriteToPages(BufferPoolManager *buffer_pool_manager) const;
+
+  static TableStatistics *ReadFromPages(BufferPoolManager *buffer_pool_manager, page_id_t page_id);
+
+  static void FreePages(BufferPoolManager *buffer_pool_manager, page_id_t page_id);
+
+ private:
+  static constexpr uint32_t STATISTICS_MAGIC_NUM = 513087;
+
+  // Fill the column statistics from the sampled rows of a table with row_count_ rows, positions holds
+  // the place of each sampled row in the scan.
+  void BuildColumns(const Schema *schema, const std::vector<Row> &sample, const std::vector<uint64_t> &positions);
+
+  uint64_t row_count_{0};
+  uint32_t sample_size_{0};
+  uint32_t page_count_{0};
+  std::vector<ColumnStatistics> columns_;
+};
+
+#endif  // MINISQL_STATISTICS_H
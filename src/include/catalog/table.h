@@ -7,6 +7,9 @@
 #include "record/schema.h"
 #include "storage/table_heap.h"
 
+class ClusteredIndex;
+class TableStatistics;
+
 class TableMetadata {
   friend class TableInfo;
 
@@ -22,7 +25,8 @@ class TableMetadata {
   /*
    * will create new table schema and owned by mem heap
    */
-  static TableMetadata *Create(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema);
+  static TableMetadata *Create(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema,
+                               bool clustered = false);
 
   inline table_id_t GetTableId() const { return table_id_; }
 
@@ -32,30 +36,41 @@ class TableMetadata {
 
   inline Schema *GetSchema() const { return schema_; }
 
+  /** Rows are stored in the leaves of the primary key index instead of a table heap. */
+  inline bool IsClustered() const { return clustered_; }
+
+  /** First page of the statistics written by ANALYZE, INVALID_PAGE_ID if the table was never analyzed */
+  inline page_id_t GetStatisticsPageId() const { return stats_page_id_; }
+
+  inline void SetStatisticsPageId(page_id_t page_id) { stats_page_id_ = page_id; }
+
  private:
   TableMetadata() = delete;
 
-  TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema);
+  TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema, bool clustered);
 
  private:
   static constexpr uint32_t TABLE_METADATA_MAGIC_NUM = 344528;
   table_id_t table_id_;
   std::string table_name_;
-  page_id_t root_page_id_;
+  page_id_t root_page_id_;  /** First page of the table heap, INVALID_PAGE_ID for a clustered table */
   Schema *schema_;
+  bool clustered_;
+  page_id_t stats_page_id_{INVALID_PAGE_ID};
 };
 
 /**
  * The TableInfo class maintains metadata about a table.
+ *
+ * The rows of a table live in its table heap, or for a clustered table in the leaves of its primary
+ * key index, which the catalog attaches when it creates or loads that index. Executors read and write
+ * rows through the tuple methods here, which work on either storage.
  */
 class TableInfo {
  public:
   static TableInfo *Create() { return new TableInfo(); }
 
-  ~TableInfo() {
-    delete table_meta_;
-    delete table_heap_;
-  }
+  ~TableInfo();
 
   void Init(TableMetadata *table_meta, TableHeap *table_heap) {
     table_meta_ = table_meta;
@@ -72,12 +87,44 @@ class TableInfo {
 
   inline page_id_t GetRootPageId() const { return table_meta_->root_page_id_; }
 
+  inline bool IsClustered() const { return table_meta_->clustered_; }
+
+  inline ClusteredIndex *GetClusteredIndex() const { return clustered_index_; }
+
+  inline void SetClusteredIndex(ClusteredIndex *clustered_index) { clustered_index_ = clustered_index; }
+
+  inline TableMetadata *GetMetadata() const { return table_meta_; }
+
+  /** Statistics of the last ANALYZE, null if the table was never analyzed */
+  inline const TableStatistics *GetStatistics() const { return statistics_; }
+
+  /** Replace the statistics, which are owned by the table info from now on. */
+  void SetStatistics(TableStatistics *statistics);
+
+  /** Insert a row, the row id of the new row is set in row. */
+  bool InsertTuple(Row &row, Txn *txn);
+
+  bool MarkDelete(const RowId &rid, Txn *txn);
+
+  /** Replace the row at rid, the row id of the new row is set in row (a clustered row moves with its key). */
+  bool UpdateTuple(Row &row, const RowId &rid, Txn *txn);
+
+  /** Read the row at row->GetRowId(). */
+  bool GetTuple(Row *row, Txn *txn);
+
+  /** Rows in heap order, or in primary key order for a clustered table. */
+  TableIterator Begin(Txn *txn);
+
+  TableIterator End();
+
  private:
   explicit TableInfo(){};
 
  private:
   TableMetadata *table_meta_;
-  TableHeap *table_heap_;
+  TableHeap *table_heap_;                     /** Null for a clustered table */
+  ClusteredIndex *clustered_index_{nullptr};  /** Owned by the IndexInfo of the primary key */
+  TableStatistics *statistics_{nullptr};
 };
 
 #endif  // MINISQL_TABLE_H
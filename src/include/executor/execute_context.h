@@ -12,6 +12,9 @@
 
 class ExecuteContext {
  public:
+  /** Default memory of an operator holding rows, e.g. the hash table of a hash join */
+  static constexpr size_t DEFAULT_WORK_MEMORY = 64 << 20;
+
   /**
    * Creates an ExecuteContext for the recovery that is executing the query.
    * @param transaction The recovery executing the query
@@ -34,6 +37,21 @@ class ExecuteContext {
   /** @return the buffer pool manager */
   BufferPoolManager *GetBufferPoolManager() { return bpm_; }
 
+  /** @return Worker threads of a sequential scan on a heap table, 1 scans on the calling thread */
+  size_t GetParallelism() const { return parallelism_; }
+
+  void SetParallelism(size_t parallelism) { parallelism_ = parallelism; }
+
+  /** @return Whether a parallel scan has to return its rows in table order */
+  bool IsScanOrderPreserved() const { return preserve_scan_order_; }
+
+  void SetScanOrderPreserved(bool preserve) { preserve_scan_order_ = preserve; }
+
+  /** @return Bytes of rows an operator may hold in memory before it spills them to temporary pages */
+  size_t GetWorkMemory() const { return work_memory_; }
+
+  void SetWorkMemory(size_t work_memory) { work_memory_ = work_memory; }
+
  private:
   /** The recovery context associated with this executor context */
   Txn *transaction_;
@@ -41,6 +59,10 @@ class ExecuteContext {
   CatalogManager *catalog_;
   /** The buffer pool manager associated with this executor context */
   BufferPoolManager *bpm_;
+  /** Session settings of the parallel sequential scan */
+  size_t parallelism_{1};
+  bool preserve_scan_order_{false};
+  size_t work_memory_{DEFAULT_WORK_MEMORY};
 };
 
 #endif  // MINISQL_EXECUTE_CONTEXT_H
@@ -10,6 +10,7 @@
 #include "concurrency/txn.h"
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
+#include "executor/result_sink.h"
 #include "executor/plans/abstract_plan.h"
 #include "record/row.h"
 
@@ -22,6 +23,11 @@ extern "C" {
  */
 class ExecuteEngine {
  public:
+  /** Most worker threads a sequential scan may use */
+  static constexpr size_t MAX_PARALLELISM = 64;
+  /** Least work memory of an operator, in KB */
+  static constexpr size_t MIN_WORK_MEMORY_KB = 64;
+
   ExecuteEngine();
 
   ~ExecuteEngine() {
@@ -38,11 +44,21 @@ class ExecuteEngine {
   dberr_t ExecutePlan(const AbstractPlanNodeRef &plan, std::vector<Row> *result_set, Txn *txn,
                       ExecuteContext *exec_ctx);
 
+  /**
+   * Execute a plan, handing each chunk of rows to sink as it is produced.
+   * @return DB_FAILED if the executor throws, the rows consumed until then stay with sink
+   */
+  dberr_t ExecutePlan(const AbstractPlanNodeRef &plan, ResultSink *sink, Txn *txn, ExecuteContext *exec_ctx);
+
   void ExecuteInformation(dberr_t result);
 
- private:
+ /**
+   * Build the executor tree of a plan, children first.
+   * @return The executor of the root of plan
+   */
   static std::unique_ptr<AbstractExecutor> CreateExecutor(ExecuteContext *exec_ctx, const AbstractPlanNodeRef &plan);
 
+ private:
   dberr_t ExecuteCreateDatabase(pSyntaxNode ast, ExecuteContext *context);
 
   dberr_t ExecuteDropDatabase(pSyntaxNode ast, ExecuteContext *context);
@@ -57,6 +73,10 @@ class ExecuteEngine {
 
   dberr_t ExecuteDropTable(pSyntaxNode ast, ExecuteContext *context);
 
+  dberr_t ExecuteAnalyze(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteExplain(pSyntaxNode ast, ExecuteContext *context);
+
   dberr_t ExecuteShowIndexes(pSyntaxNode ast, ExecuteContext *context);
 
   dberr_t ExecuteCreateIndex(pSyntaxNode ast, ExecuteContext *context);
@@ -73,9 +93,26 @@ class ExecuteEngine {
 
   dberr_t ExecuteQuit(pSyntaxNode ast, ExecuteContext *context);
 
+  /**
+   * Change a setting of the session: parallelism (worker threads of a sequential scan, 1 to
+   * MAX_PARALLELISM), parallel_order (1 if a parallel scan returns its rows in table order),
+   * work_mem (KB of rows an operator holds in memory before it spills, at least MIN_WORK_MEMORY_KB)
+   * or output (table, tsv or binary, how the rows of a query are written, see ResultSink).
+   * With an index name it changes a setting of the index in the current database instead:
+   * pinned_levels (top levels of a b+ tree index kept in the buffer pool, 0 unpins them).
+   */
+  dberr_t ExecuteSet(pSyntaxNode ast, ExecuteContext *context);
+
+  /** @return false if no table of the current database has an index named index_name */
+  bool FindIndexTable(const std::string &index_name, std::string &table_name);
+
  private:
   std::unordered_map<std::string, DBStorageEngine *> dbs_; /** all opened databases */
   std::string current_db_;                                 /** current database */
+  size_t parallelism_{1};                                  /** workers of a sequential scan */
+  bool preserve_scan_order_{false};                        /** parallel scans return rows in table order */
+  size_t work_memory_{ExecuteContext::DEFAULT_WORK_MEMORY}; /** bytes of rows an operator holds in memory */
+  OutputFormat output_format_{OutputFormat::kTable};        /** how the rows of a query are written */
 };
 
 #endif  // MINISQL_EXECUTE_ENGINE_H
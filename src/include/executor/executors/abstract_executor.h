@@ -2,13 +2,19 @@
 #define MINISQL_ABSTRACT_EXECUTOR_H
 
 #include "executor/execute_context.h"
+#include "record/data_chunk.h"
+
 /**
- * The AbstractExecutor implements the Volcano row-at-a-time iterator model.
+ * The AbstractExecutor implements the Volcano row-at-a-time iterator model, and its vectorized
+ * variant: NextBatch() hands over up to DataChunk::CAPACITY rows as column vectors at once.
  * This is the base class from which all executors in the execution engine
  * inherit, and defines the minimal interface that all executors support.
  */
 class AbstractExecutor {
  public:
+  /** Rows the DML executors pull from their child before maintaining the indexes in one batch */
+  static constexpr size_t DML_BATCH_SIZE = 1024;
+
   /**
    * Construct a new AbstractExecutor instance.
    * @param exec_ctx the executor context that the executor runs with
@@ -32,6 +38,23 @@ class AbstractExecutor {
    */
   virtual bool Next(Row *row, RowId *rid) = 0;
 
+  /**
+   * Yield the next batch of rows from this executor. This default adapter pulls them one by one
+   * through Next(), executors with a columnar path override it. Pull rows from an executor either
+   * with Next() or with NextBatch(), not both.
+   * @param[out] chunk Rows of the output schema, those produced are listed in its selection vector
+   * @return `true` if at least one row was produced, `false` if there are no more rows
+   */
+  virtual bool NextBatch(DataChunk *chunk) {
+    chunk->Reset(GetOutputSchema());
+    Row row;
+    RowId rid;
+    while (!chunk->IsFull() && Next(&row, &rid)) {
+      chunk->AppendRow(row, rid);
+    }
+    return chunk->GetSelectedCount() > 0;
+  }
+
   /** @return The schema of the rows that this executor produces */
   virtual const Schema *GetOutputSchema() const = 0;
 
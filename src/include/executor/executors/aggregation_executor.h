@@ -0,0 +1,146 @@
+#ifndef MINISQL_AGGREGATION_EXECUTOR_H
+#define MINISQL_AGGREGATION_EXECUTOR_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/aggregation_plan.h"
+#include "storage/spill_file.h"
+
+/**
+ * AggregationExecutor computes the aggregates of its plan over the rows of its child, reading the
+ * whole input in Init(). The states of the aggregates are typed arrays indexed by group, updated a
+ * chunk and an aggregate at a time.
+ *
+ * Without group by columns all rows fall in a single group and no hash table is built. Otherwise
+ * the groups are found in an open addressing hash table on their keys. Once the groups exceed the
+ * work memory of the context, the rows of groups already in the table are still aggregated in
+ * memory while the rows of new groups are split into PARTITION_COUNT partitions by the hash of their
+ * keys and spilled to temporary pages; each partition is aggregated in memory after the groups of
+ * the table have been emitted. A partition still larger than the work memory is aggregated in memory
+ * all the same.
+ */
+class AggregationExecutor : public AbstractExecutor {
+ public:
+  /** Partitions of the input once it is spilled */
+  static constexpr size_t PARTITION_COUNT = 16;
+
+  AggregationExecutor(ExecuteContext *exec_ctx, const AggregationPlanNode *plan,
+                      std::unique_ptr<AbstractExecutor> &&child);
+
+  /** Aggregate the rows of the child, spilling the rows of the groups that do not fit */
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  /**
+   * Yield the rows of the next groups, at most DataChunk::CAPACITY of them.
+   * @param[out] chunk Rows of the output schema, without row ids, all selected
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /** @return Whether rows of new groups were partitioned to temporary pages */
+  bool IsSpilled() const { return spilled_; }
+
+ private:
+  /** Empty slot of the hash table, and the group of a row left to a partition */
+  static constexpr uint32_t NO_GROUP = UINT32_MAX;
+
+  /**
+   * The state of one aggregate for every group. counts_ holds the arguments that are not null; the
+   * value is in ints_ for the sum, min and max of an int column, in chars_ for the min and max of a
+   * char column and in doubles_ for the other sums, mins and maxes and for averages; value_type_
+   * tells which, kTypeInvalid for a count.
+   */
+  struct AggregateStates {
+    TypeId value_type_{kTypeInvalid};
+    std::vector<int64_t> counts_;
+    std::vector<int64_t> ints_;
+    std::vector<double> doubles_;
+    std::vector<std::string> chars_;
+  };
+
+  /** Forget the groups and their states */
+  void ResetGroups();
+
+  /** Aggregate the selected rows of chunk, or send the rows of new groups to the partitions once spilled */
+  void AggregateChunk(const DataChunk &chunk, bool may_spill);
+
+  /**
+   * Update the states of every aggregate with the selected rows of chunk.
+   * @param group_of The group of the i-th selected row, NO_GROUP to skip it
+   */
+  template <typename GroupOf>
+  void UpdateStates(const DataChunk &chunk, GroupOf group_of);
+
+  /**
+   * Find the group of the keys of the row at position pos of chunk, add it if it is new.
+   * @param may_spill Whether a new group is refused once the groups exceed the work memory
+   * @return The group, NO_GROUP if it was refused
+   */
+  uint32_t FindOrAddGroup(const DataChunk &chunk, uint32_t pos, uint64_t hash, bool may_spill);
+
+  /** Add a group for the keys of the row at position pos of chunk */
+  uint32_t AddGroup(const DataChunk &chunk, uint32_t pos, uint64_t hash);
+
+  /** Add the initial states of a new group */
+  void AddStates();
+
+  /** Double the slots of the hash table */
+  void Grow();
+
+  /** @return The hash of the group by columns of the row at position pos of chunk, nulls included */
+  uint64_t HashKeys(const DataChunk &chunk, uint32_t pos) const;
+
+  /** @return Whether the keys of group equal the group by columns of the row at position pos of chunk */
+  bool KeysEqual(uint32_t group, const DataChunk &chunk, uint32_t pos) const;
+
+  /** @return Bytes the groups take, for the work memory */
+  size_t GroupMemory() const;
+
+  /** @return The final value of the aggregate at index agg for group */
+  Field FinalValue(size_t agg, uint32_t group) const;
+
+  /** Aggregate the next non-empty partition. @return false when none is left */
+  bool LoadPartition();
+
+  const AggregationPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_;
+  /** Schema of the group keys, the group by columns of the child */
+  std::unique_ptr<Schema> key_schema_;
+
+  /** Keys of the groups in order of appearance, and the hash of each */
+  DataChunk groups_;
+  std::vector<uint64_t> group_hashes_;
+  size_t group_count_{0};
+  /** Open addressing table of groups with linear probing, a power of two of slots */
+  std::vector<uint32_t> slots_;
+  uint64_t mask_{0};
+  std::vector<AggregateStates> states_;
+  /** Bytes of the states of a group, and of the values in the chars_ states */
+  size_t state_bytes_{0};
+  size_t char_bytes_{0};
+  /** Group of each selected row of the chunk being aggregated */
+  std::vector<uint32_t> row_groups_;
+
+  /** Partitions of the rows of new groups once spilled, and the next one to aggregate */
+  bool spilled_{false};
+  std::vector<std::unique_ptr<SpillFile>> partitions_;
+  size_t partition_{0};
+
+  /** Next group to emit */
+  size_t cursor_{0};
+
+  /** Chunk of Next() and its next row */
+  DataChunk row_chunk_;
+  size_t row_pos_{0};
+};
+
+#endif  // MINISQL_AGGREGATION_EXECUTOR_H
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include "executor/executors/index_scan_executor.h"
+#include "executor/plans/bitmap_heap_scan_plan.h"
+
+/**
+ * BitmapHeapScanExecutor reads the rows behind the row ids of an index scan in heap order, one
+ * pinned page at a time. Below BitmapHeapScanPlanNode::MIN_BITMAP_ROWS row ids it fetches them
+ * one by one like IndexScanExecutor. NextBatch() of IndexScanExecutor reads the sorted row ids a
+ * page at a time as well.
+ */
+class BitmapHeapScanExecutor : public IndexScanExecutor {
+ public:
+  BitmapHeapScanExecutor(ExecuteContext *exec_ctx, const BitmapHeapScanPlanNode *plan);
+
+  /** Collect and sort the row ids */
+  void Init() override;
+
+  /**
+   * Yield the next matching row in heap order.
+   * @param[out] row The next row produced by the scan
+   * @param[out] rid The next row RID produced by the scan
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  bool Next(Row *row, RowId *rid) override;
+
+  /** @return Heap pages read by the scan so far */
+  inline size_t GetPagesRead() const { return pages_read_; }
+
+ private:
+  /** Read the rows of the next page of result_ into page_rows_, @return false at the end */
+  bool ReadNextPage();
+
+  bool bitmap_{false};
+  /** Rows of the current page that are left to emit */
+  std::vector<Row> page_rows_;
+  size_t page_cursor_{0};
+  size_t pages_read_{0};
+};
@@ -13,7 +13,9 @@
 
 /**
  * DeletedExecutor executes a delete on a table.
- * Deleted values are always pulled from a child.
+ * Deleted values are always pulled from a child through NextBatch(), DML_BATCH_SIZE rows at a
+ * time so the index entries of a batch are removed as one sorted batch. The rows of a clustered table
+ * are pulled from the child before the first delete.
  */
 class DeleteExecutor : public AbstractExecutor {
  public:
@@ -40,6 +42,13 @@ class DeleteExecutor : public AbstractExecutor {
    */
   bool Next(Row *row, RowId *rid) override;
 
+  /**
+   * Delete the next batch of rows.
+   * @param[out] chunk The deleted rows
+   * @return `true` if a row was deleted, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
   /** @return The output schema for the delete */
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
@@ -51,6 +60,28 @@ class DeleteExecutor : public AbstractExecutor {
   std::vector<IndexInfo *> index_info_;
   /** The child executor from which RIDs for deleted rows are pulled */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** Deleted rows of the current batch and the next one to yield */
+  std::vector<Row> rows_;
+  size_t cursor_{0};
+  bool stopped_{false};
+
+  /** Batch of rows pulled from the child and the next one to take */
+  DataChunk child_chunk_;
+  size_t child_cursor_{0};
+
+  /** Rows pulled from the child in Init, for a clustered table */
+  std::vector<Row> source_rows_;
+  size_t source_cursor_{0};
+  bool source_drained_{false};
+
+  /** Next row of the child, taken from its batches */
+  bool NextChild(Row *row, RowId *rid);
+
+  /** Next row to delete, from the child or from source_rows_ */
+  bool NextSource(Row *row, RowId *rid);
+
+  /** Pull and delete the next batch of rows, @return false if no row was deleted */
+  bool DeleteBatch();
 };
 
 #endif  // MINISQL_DELETE_EXECUTOR_H
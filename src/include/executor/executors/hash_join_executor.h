@@ -0,0 +1,138 @@
+#ifndef MINISQL_HASH_JOIN_EXECUTOR_H
+#define MINISQL_HASH_JOIN_EXECUTOR_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/hash_join_plan.h"
+#include "storage/spill_file.h"
+
+/**
+ * HashJoinExecutor builds a hash table on the smaller of its inputs and probes it with the rows of
+ * the other. Both children are read a chunk at a time, always the one holding fewer bytes, until
+ * one of them ends: its rows become the hash table if they fit in the work memory of the context,
+ * the rows read from the other are probed first and then the rest of its input.
+ *
+ * When the rows read from each input exceed the work memory before either ends, both inputs are
+ * split into PARTITION_COUNT partitions by the hash of their keys and spilled to temporary pages
+ * (grace hash join); each pair of partitions is then joined in memory, built on the smaller one. A
+ * partition still larger than the work memory is joined in memory all the same.
+ */
+class HashJoinExecutor : public AbstractExecutor {
+ public:
+  /** Partitions of each input when it is spilled */
+  static constexpr size_t PARTITION_COUNT = 16;
+
+  HashJoinExecutor(ExecuteContext *exec_ctx, const HashJoinPlanNode *plan, std::unique_ptr<AbstractExecutor> &&left,
+                   std::unique_ptr<AbstractExecutor> &&right);
+
+  /** Read the inputs until the build side is known, or spill them */
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  /**
+   * Yield the joined rows of one chunk of the probe side, at most DataChunk::CAPACITY of them.
+   * @param[out] chunk Rows of the output schema, without row ids, all selected
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /** @return Whether the inputs were partitioned to temporary pages */
+  bool IsSpilled() const { return spilled_; }
+
+  /** @return 0 if the hash table holds rows of the left child, 1 of the right one */
+  uint32_t GetBuildSide() const { return build_side_; }
+
+ private:
+  /** End of a hash chain */
+  static constexpr uint32_t NO_ROW = UINT32_MAX;
+
+  /** Extra bytes the hash table takes per build row */
+  static constexpr size_t TABLE_BYTES_PER_ROW = sizeof(uint64_t) + 3 * sizeof(uint32_t);
+
+  /** @return Bytes the rows of buffer take as a hash table */
+  static size_t TableSize(const DataChunk &buffer) {
+    return buffer.GetMemoryUsage() + buffer.GetSize() * TABLE_BYTES_PER_ROW;
+  }
+
+  /**
+   * Hash the key columns of the row at position pos of chunk.
+   * @return false if a key is null, the row matches nothing
+   */
+  static bool HashKeys(const DataChunk &chunk, size_t pos, const std::vector<uint32_t> &keys, uint64_t *hash);
+
+  /** @return Whether the keys of the build row at build_pos equal the keys of the probe row at probe_pos */
+  bool KeysEqual(uint32_t build_pos, uint32_t probe_pos) const;
+
+  /** Make the rows of build_ the hash table */
+  void BuildTable();
+
+  /** Split both inputs into partitions on temporary pages */
+  void Spill();
+
+  /** Add the selected rows of chunk, read from side, to the partitions of their keys */
+  void Partition(uint32_t side, const DataChunk &chunk);
+
+  /** Move to the next chunk of the probe side. @return false at the end of the join */
+  bool NextProbeChunk();
+
+  /** Pair the rows of probe_ with their matches until DataChunk::CAPACITY pairs are found or probe_ ends */
+  void Probe();
+
+  /** @return Whether the build row at build_pos and the probe row of probe_ meet the predicate */
+  bool MatchPredicate(uint32_t build_pos);
+
+  const HashJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> children_[2];
+  /** Key columns of the left and the right rows */
+  const std::vector<uint32_t> *keys_[2];
+  /** All columns of each child, in order */
+  std::vector<uint32_t> column_maps_[2];
+  bool finished_[2]{false, false};
+  bool spilled_{false};
+  uint32_t build_side_{0};
+
+  /** Rows read from each child before the build side is known */
+  DataChunk buffers_[2];
+  /** Rows of the hash table; holds every build row, past DataChunk::CAPACITY */
+  DataChunk build_;
+  /** Hash chains: first row of each bucket, next row of each row, hash of each row */
+  std::vector<uint32_t> heads_;
+  std::vector<uint32_t> next_;
+  std::vector<uint64_t> hashes_;
+  uint64_t mask_{0};
+
+  /** Partitions of the left and right rows once spilled */
+  std::vector<std::unique_ptr<SpillFile>> partitions_[2];
+  /** Partition being joined, and whether its build side is loaded */
+  size_t partition_{0};
+  bool partition_loaded_{false};
+
+  /** Rows of the probe side being probed: buffers_ of the probe side, or probe_chunk_ */
+  DataChunk *probe_{nullptr};
+  DataChunk probe_chunk_;
+  /** Next selected row of probe_, the row being probed and its next candidate */
+  size_t probe_index_{0};
+  uint32_t probe_pos_{0};
+  uint64_t probe_hash_{0};
+  uint32_t match_{NO_ROW};
+  /** Rows for the predicate, the probe row is materialized once for its candidates */
+  Row build_row_;
+  Row probe_row_;
+  bool probe_row_loaded_{false};
+  /** Joined rows found: positions in build_ and in probe_ */
+  std::vector<uint32_t> build_matches_;
+  std::vector<uint32_t> probe_matches_;
+
+  /** Chunk of Next() and its next row */
+  DataChunk row_chunk_;
+  size_t row_pos_{0};
+};
+
+#endif  // MINISQL_HASH_JOIN_EXECUTOR_H
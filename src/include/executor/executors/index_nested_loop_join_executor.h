@@ -0,0 +1,77 @@
+#ifndef MINISQL_INDEX_NESTED_LOOP_JOIN_EXECUTOR_H
+#define MINISQL_INDEX_NESTED_LOOP_JOIN_EXECUTOR_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/index_nested_loop_join_plan.h"
+
+/**
+ * IndexNestedLoopJoinExecutor looks up the inner rows of each outer row in an index of the inner
+ * table instead of reading that table. The outer rows are handled a chunk at a time: the keys of a
+ * chunk are looked up together with IndexInfo::LookupMany, which a b+ tree answers in key order with
+ * one descent and a walk along the leaves, then the row ids found are sorted so that each heap page
+ * is fetched once for the chunk. The joined rows come out in the order of the outer rows.
+ */
+class IndexNestedLoopJoinExecutor : public AbstractExecutor {
+ public:
+  IndexNestedLoopJoinExecutor(ExecuteContext *exec_ctx, const IndexNestedLoopJoinPlanNode *plan,
+                              std::unique_ptr<AbstractExecutor> &&outer);
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  /**
+   * Yield the joined rows of the outer rows, at most DataChunk::CAPACITY of them.
+   * @param[out] chunk Rows of the output schema, without row ids, all selected
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /** @return Index lookups made so far, one per outer row with a key */
+  size_t GetLookupCount() const { return lookup_count_; }
+
+  /** @return Heap pages of the inner table fetched so far */
+  size_t GetPagesRead() const { return pages_read_; }
+
+ private:
+  /** Look up the keys of the next outer chunk and fetch their inner rows. @return false at the end */
+  bool JoinNextChunk();
+
+  /** @return Whether the keys of the outer row at outer_pos equal those of the inner row at inner_pos */
+  bool KeysEqual(uint32_t outer_pos, uint32_t inner_pos) const;
+
+  /** @return Whether the outer row at outer_pos and the inner row at inner_pos meet the predicate */
+  bool MatchPredicate(uint32_t outer_pos, uint32_t inner_pos);
+
+  const IndexNestedLoopJoinPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> outer_;
+  TableInfo *table_info_{nullptr};
+
+  /** The outer chunk being joined and the inner rows of its keys, in heap order */
+  DataChunk outer_chunk_;
+  DataChunk inner_chunk_;
+  /** Joined rows of the outer chunk: positions in outer_chunk_ and in inner_chunk_, the next to emit */
+  std::vector<uint32_t> outer_matches_;
+  std::vector<uint32_t> inner_matches_;
+  size_t match_cursor_{0};
+  /** Rows for the predicate, the outer row is materialized once for its matches */
+  Row outer_row_;
+  Row inner_row_;
+  uint32_t outer_row_pos_{UINT32_MAX};
+
+  size_t lookup_count_{0};
+  size_t pages_read_{0};
+
+  /** Chunk of Next() and its next row */
+  DataChunk row_chunk_;
+  size_t row_pos_{0};
+};
+
+#endif  // MINISQL_INDEX_NESTED_LOOP_JOIN_EXECUTOR_H
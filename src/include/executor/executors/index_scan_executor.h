@@ -1,18 +1,25 @@
 #pragma once
 
+#include <algorithm>
+#include <deque>
 #include <vector>
 
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/index_scan_plan.h"
+#include "index/index_iterator.h"
 #include "planner/expressions/column_value_expression.h"
 #include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/logic_expression.h"
 
 /**
  * The IndexScanExecutor executor can over a table.
  */
 class IndexScanExecutor : public AbstractExecutor {
  public:
+  /** Entries of a range scan read for the first rows, doubled for each further read up to a chunk */
+  static constexpr size_t FIRST_READ_ENTRIES = 16;
+
   /**
    * Construct a new SeqScanExecutor instance.
    * @param exec_ctx The executor context
@@ -31,20 +38,78 @@ class IndexScanExecutor : public AbstractExecutor {
    */
   bool Next(Row *row, RowId *rid) override;
 
+  /**
+   * Yield the next batch of rows of the index scan, in the order of the row ids. Row ids next to
+   * each other on one heap page are decoded from it with one fetch.
+   * @param[out] chunk The rows produced by the scan
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
   /** @return The output schema for the sequential scan */
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
+  /** @return Index entries a range scan has read so far */
+  size_t GetScannedEntries() const { return scanned_entries_; }
+
   bool SchemaEqual(const Schema *table_schema, const Schema *output_schema);
 
   void TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row, Row *output_row);
 
- private:
-  vector<RowId> IndexScan(AbstractExpressionRef predicate);
+ protected:
+  /** Fill result_ with the row ids of the scan (and rows_ for a clustered range). */
+  void CollectRowIds();
+
+  /**
+   * Check source against the predicate if the plan needs it and project it to the output schema.
+   * @return false if source does not match
+   */
+  bool Emit(const Row &source, const RowId &source_rid, Row *row, RowId *rid);
+
+  /**
+   * Collect the row ids of the rows that may match the predicate from the indexes of the plan, sorted.
+   * The row ids of AND are intersected and those of OR merged.
+   * @return false if the indexes do not narrow the predicate down, result is then left empty
+   */
+  bool IndexScan(const AbstractExpressionRef &predicate, vector<RowId> &result);
+
+  /** Position the iterator of the range scan at the start of plan_->range_. */
+  void StartRange();
+
+  /**
+   * Read the row ids of the next entries in plan_->range_ into result_, going on over the leaf pages.
+   * The rows of a clustered index are decoded from the leaves into rows_ on the way.
+   * @param max_entries Entries in the range to read at most
+   */
+  void ReadRange(size_t max_entries);
+
+  /**
+   * @return Whether result_ has a row id after the cursor, reading the next entries of a range scan
+   * into it once the previous ones are used up
+   */
+  bool HasMore();
 
   /** The sequential scan plan node to be executed */
   const IndexScanPlanNode *plan_;
   TableInfo *table_info_{};
+  /**
+   * Row ids of the scan. Under an update or delete they are all collected in Init, so that a change
+   * of the index or a moved row cannot make the scan meet a row twice (the Halloween problem). A
+   * range scan of a select holds only the entries read last.
+   */
   vector<RowId> result_;
+  /** Rows of result_ read by ReadRange, empty if they are fetched from the table in Next */
+  std::deque<Row> rows_;
   size_t cursor_ = 0;
+  /** Next entry of the range scan, at range_end_ after the range */
+  IndexIterator range_iterator_;
+  IndexIterator range_end_;
+  /** Entries in the range the next ReadRange of HasMore reads */
+  size_t read_size_ = FIRST_READ_ENTRIES;
+  size_t scanned_entries_ = 0;
   bool is_schema_same_;
+  /** Rows in the table schema before the projection, unless the schemas are the same */
+  DataChunk scan_chunk_;
+  /** Table column of each output column */
+  std::vector<uint32_t> column_map_;
 };
\ No newline at end of file
@@ -12,7 +12,10 @@
 /**
  * InsertExecutor executes an insert on a table.
  *
- * Inserted values are always pulled from a child executor.
+ * Inserted values are always pulled from a child executor, DML_BATCH_SIZE rows at a time: the
+ * duplicate checks and the index inserts of a batch each go to the index as one sorted batch.
+ * The insert stops at the first row with a duplicate key, the rows before it are inserted.
+ * The child is a VALUES list whose literals are evaluated row by row, it is pulled with Next().
  */
 class InsertExecutor : public AbstractExecutor {
  public:
@@ -38,6 +41,13 @@ class InsertExecutor : public AbstractExecutor {
    */
   bool Next([[maybe_unused]] Row *row, RowId *rid) override;
 
+  /**
+   * Insert the next batch of rows.
+   * @param[out] chunk One row without columns for each inserted row
+   * @return `true` if a row was inserted, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
   /** @return The output schema for the insert */
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
@@ -48,6 +58,13 @@ class InsertExecutor : public AbstractExecutor {
   TableInfo *table_info_{};
   const Schema *schema_{};
   std::vector<IndexInfo *> index_info_;
+  /** Inserted rows not yielded by Next yet */
+  size_t pending_{0};
+  /** A duplicate key or a failed insert ended the insert */
+  bool stopped_{false};
+
+  /** Pull, check and insert the next batch of rows, @return false if no row was inserted */
+  bool InsertBatch();
 };
 
 #endif  // MINISQL_INSERT_EXECUTOR_H
@@ -0,0 +1,38 @@
+#ifndef MINISQL_LIMIT_EXECUTOR_H
+#define MINISQL_LIMIT_EXECUTOR_H
+
+#include <memory>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/limit_plan.h"
+
+/**
+ * LimitExecutor drops the first offset rows of its child and passes on the next ones up to the
+ * limit of its plan, then stops asking the child for more.
+ */
+class LimitExecutor : public AbstractExecutor {
+ public:
+  LimitExecutor(ExecuteContext *exec_ctx, const LimitPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child);
+
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  /**
+   * Yield the next rows of the child, the selection of the chunks cut at the offset and the limit.
+   * @return `true` if a row was produced, `false` once the limit is reached or the child is exhausted
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+ private:
+  const LimitPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_;
+  /** Rows skipped and produced so far */
+  size_t skipped_{0};
+  size_t emitted_{0};
+};
+
+#endif  // MINISQL_LIMIT_EXECUTOR_H
@@ -0,0 +1,118 @@
+#ifndef MINISQL_PARALLEL_SEQ_SCAN_EXECUTOR_H
+#define MINISQL_PARALLEL_SEQ_SCAN_EXECUTOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/seq_scan_plan.h"
+#include "storage/page_chain_cursor.h"
+
+/**
+ * ParallelSeqScanExecutor scans a heap table with the worker threads of the plan, morsel-driven:
+ * the page chain is cut into morsels of a few pages, a worker takes several morsels at a time into
+ * its own queue and, once the chain is used up, steals from the back of the queues of the others.
+ * Each worker decodes, filters and projects its morsels into data chunks like SeqScanExecutor.
+ *
+ * The chunks of a morsel are returned together, in any order, or in table order if the plan asks
+ * for it. Workers wait while too many morsels are done and not returned yet, or in table order
+ * while their morsel is too far ahead of the one to return next.
+ */
+class ParallelSeqScanExecutor : public AbstractExecutor {
+ public:
+  /** Pages of a morsel */
+  static constexpr size_t MORSEL_PAGES = 4;
+  /** Morsels a worker takes from the page chain at once */
+  static constexpr size_t MORSELS_PER_REFILL = 4;
+
+  ParallelSeqScanExecutor(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan);
+
+  /** Stops and joins the workers */
+  ~ParallelSeqScanExecutor() override;
+
+  /** Start the workers */
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  /**
+   * Yield the rows of a chunk scanned by a worker.
+   * @param[out] chunk Rows of the output schema, those produced are listed in its selection vector
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+ private:
+  struct Morsel {
+    /** Position of the morsel in the page chain */
+    size_t seq_{0};
+    std::vector<page_id_t> pages_;
+  };
+
+  /** Morsels taken by a worker and not scanned yet */
+  struct WorkerQueue {
+    std::mutex latch_;
+    std::deque<Morsel> morsels_;
+  };
+
+  void Work(size_t worker);
+
+  /** Take a morsel from the own queue, else from the page chain, else from the queue of another worker */
+  bool TakeMorsel(size_t worker, Morsel *morsel);
+
+  void ScanMorsel(const Morsel &morsel, DataChunk *source, std::vector<uint64_t> *bitmap,
+                  std::vector<DataChunk> *chunks);
+
+  /** Filter the tuples of source and add the selected ones to chunks */
+  void Flush(DataChunk *source, std::vector<uint64_t> *bitmap, std::vector<DataChunk> *chunks);
+
+  /** Wait for the chunks of the next morsel to return, false after the last one */
+  bool TakeChunks();
+
+  void Stop();
+
+  const SeqScanPlanNode *plan_;
+  TableInfo *table_info_{};
+  const Schema *schema_{};
+  bool is_schema_same_{false};
+  /** Table column of each output column */
+  std::vector<uint32_t> column_map_;
+  std::unique_ptr<PageChainCursor> cursor_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  /** Guards the members up to error_ */
+  std::mutex latch_;
+  /** Signalled when a morsel is done or a worker exits */
+  std::condition_variable done_cv_;
+  /** Signalled when a morsel is returned or the scan stops */
+  std::condition_variable returned_cv_;
+  /** Chunks of the morsels done and not returned, by position */
+  std::map<size_t, std::vector<DataChunk>> done_;
+  /** Position of the next morsel to return in table order */
+  size_t next_seq_{0};
+  /** Morsels that may be done ahead of the ones returned */
+  size_t window_{0};
+  size_t running_workers_{0};
+  bool stopped_{false};
+  /** First exception of a worker, thrown by NextBatch() */
+  std::exception_ptr error_;
+
+  /** Chunks of the morsel being returned */
+  std::vector<DataChunk> chunks_;
+  size_t chunk_pos_{0};
+  /** Chunk of Next() and its next row */
+  DataChunk row_chunk_;
+  size_t row_pos_{0};
+};
+
+#endif  // MINISQL_PARALLEL_SEQ_SCAN_EXECUTOR_H
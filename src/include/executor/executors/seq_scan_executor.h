@@ -10,9 +10,13 @@
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/seq_scan_plan.h"
+#include "record/filter_kernels.h"
 
 /**
  * The SeqScanExecutor executor executes a sequential table scan.
+ * NextBatch() decodes the tuples of heap pages straight into column vectors, filters them there
+ * (with the SIMD FilterKernels when the predicate has them) and copies the selected values of the
+ * output columns.
  */
 class SeqScanExecutor : public AbstractExecutor {
  public:
@@ -34,6 +38,13 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   bool Next(Row *row, RowId *rid) override;
 
+  /**
+   * Yield the next batch of rows from the sequential scan.
+   * @param[out] chunk The rows produced by the scan, in table order
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
   /** @return The output schema for the sequential scan */
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
@@ -48,6 +59,14 @@ class SeqScanExecutor : public AbstractExecutor {
   TableIterator iterator_;
   const Schema *schema_{};
   bool is_schema_same_;
+  /** Position of the next tuple of NextBatch() in a heap table */
+  RowId cursor_;
+  /** Tuples in the table schema before the projection, unless the schemas are the same */
+  DataChunk scan_chunk_;
+  /** Table column of each output column */
+  std::vector<uint32_t> column_map_;
+  /** Rows of a batch that satisfy the predicate, one bit each */
+  std::vector<uint64_t> bitmap_;
 };
 
 #endif  // MINISQL_SEQ_SCAN_EXECUTOR_H
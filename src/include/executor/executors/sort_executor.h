@@ -0,0 +1,149 @@
+#ifndef MINISQL_SORT_EXECUTOR_H
+#define MINISQL_SORT_EXECUTOR_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "executor/execute_context.h"
+#include "executor/executors/abstract_executor.h"
+#include "executor/plans/sort_plan.h"
+#include "storage/spill_file.h"
+
+/**
+ * SortExecutor orders the rows of its child, reading the whole input in Init(). The input chunks
+ * are kept as they are and an array of entries is sorted instead, one per row: the position of the
+ * row and a normalized prefix of its first order by column, 8 bytes whose unsigned order is the
+ * order of the values. Most comparisons are decided by the prefixes alone; only equal prefixes are
+ * compared column by column.
+ *
+ * Once the rows exceed the work memory of the context, the entries are sorted and their rows
+ * written to temporary pages as a sorted run. The runs are merged in NextBatch() with a heap, at
+ * most as many at a time as there is memory to read a chunk of each; more runs are first merged
+ * into longer ones.
+ *
+ * With a limit of at most TOP_N_MAX_ROWS rows, only the first limit rows seen so far are kept in a
+ * heap whose top is the last of them. A row after the top is dropped before it is copied, and the
+ * rows that left the heap are compacted away once they outnumber the rows in it.
+ */
+class SortExecutor : public AbstractExecutor {
+ public:
+  /** Largest limit kept in a heap, a larger one sorts the whole input */
+  static constexpr int64_t TOP_N_MAX_ROWS = 1 << 16;
+
+  SortExecutor(ExecuteContext *exec_ctx, const SortPlanNode *plan, std::unique_ptr<AbstractExecutor> &&child);
+
+  /** Sort the rows of the child, spilling sorted runs when they do not fit */
+  void Init() override;
+
+  bool Next(Row *row, RowId *rid) override;
+
+  /**
+   * Yield the next rows in order, at most DataChunk::CAPACITY of them.
+   * @param[out] chunk Rows of the output schema, all selected
+   * @return `true` if a row was produced, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
+  const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
+
+  /** @return Sorted runs written to temporary pages, 0 if the rows were sorted in memory */
+  size_t GetRunCount() const { return run_count_; }
+
+  /** @return Whether the rows were kept in a top-N heap */
+  bool IsTopN() const { return top_n_; }
+
+ private:
+  /** A row of chunks_ to sort and the prefix of its first order by column */
+  struct SortEntry {
+    uint64_t prefix_;
+    uint32_t chunk_;
+    uint32_t pos_;
+  };
+
+  /** A sorted run being merged and its current row, the selected row pos_ of chunk_ */
+  struct Run {
+    std::unique_ptr<SpillFile> file_;
+    DataChunk chunk_;
+    size_t pos_{0};
+    uint64_t prefix_{0};
+  };
+
+  /** @return The normalized prefix of the first order by column of the row at position pos of chunk */
+  uint64_t MakePrefix(const DataChunk &chunk, size_t pos) const;
+
+  /** @return <0, 0 or >0 as the row at lhs_pos of lhs comes before, with or after the row at rhs_pos of rhs */
+  int CompareRows(uint64_t lhs_prefix, const DataChunk &lhs, size_t lhs_pos, uint64_t rhs_prefix,
+                  const DataChunk &rhs, size_t rhs_pos) const;
+
+  inline bool Less(const SortEntry &lhs, const SortEntry &rhs) const {
+    return CompareRows(lhs.prefix_, chunks_[lhs.chunk_], lhs.pos_, rhs.prefix_, chunks_[rhs.chunk_], rhs.pos_) < 0;
+  }
+
+  /** Read all rows of the child into chunks_ and entries_, spilling runs past the work memory */
+  void SortAll();
+
+  /** Sort entries_ and write their rows to a new run, then forget them */
+  void SpillRun();
+
+  /** Keep the selected rows of input that are among the first limit_ rows so far in the heap */
+  void PushTopN(const DataChunk &input);
+
+  /** Copy the rows of the heap to new chunks, dropping the rows that left it */
+  void CompactTopN();
+
+  /** @return Runs that can be merged at once in the work memory */
+  size_t MergeFanIn() const;
+
+  /** Merge runs [first, first + count) of runs_ into a new run at the end of runs_ */
+  void MergeRuns(size_t first, size_t count);
+
+  /** Start reading every run of runs_ and build the merge heap */
+  void StartMerge();
+
+  /** Move run to its next row. @return false after its last row */
+  bool AdvanceRun(Run *run);
+
+  /** @return Whether the current row of run lhs comes after that of run rhs, for the merge heap */
+  bool RunAfter(size_t lhs, size_t rhs) const;
+
+  /**
+   * Move past the first row of the runs being merged.
+   * @param[out] chunk Chunk the row is appended to, nullptr to only move past it
+   * @return false when the runs are exhausted
+   */
+  bool PopMerged(DataChunk *chunk);
+
+  const SortPlanNode *plan_;
+  std::unique_ptr<AbstractExecutor> child_;
+  /** Each output column taken from the same column */
+  std::vector<uint32_t> column_map_;
+  /** Whether two equal prefixes are enough to tell the first order by column is equal */
+  bool prefix_exact_{false};
+  /** Rows to produce at most */
+  size_t limit_{0};
+  bool top_n_{false};
+
+  /** Rows being sorted, in the chunks they came in (or copied to by the heap) */
+  std::vector<DataChunk> chunks_;
+  std::vector<SortEntry> entries_;
+  /** Bytes of chunks_ and entries_, for the work memory */
+  size_t memory_{0};
+  /** Rows of chunks_ that left the heap */
+  size_t dropped_{0};
+
+  std::vector<std::unique_ptr<Run>> runs_;
+  size_t run_count_{0};
+  /** Indexes of runs_ that still have rows, the first current row on top */
+  std::vector<size_t> merge_heap_;
+
+  /** Next entry to emit, and rows emitted */
+  size_t cursor_{0};
+  size_t emitted_{0};
+
+  /** Chunk of Next() and its next row */
+  DataChunk row_chunk_;
+  size_t row_pos_{0};
+};
+
+#endif  // MINISQL_SORT_EXECUTOR_H
@@ -5,13 +5,18 @@
 #ifndef MINISQL_UPDATE_EXECUTOR_H
 #define MINISQL_UPDATE_EXECUTOR_H
 
+#include <vector>
+
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/update_plan.h"
 
 /**
  * UpdateExecutor executes an update on a table.
- * Updated values are always pulled from a child.
+ * Updated values are always pulled from a child through NextBatch(), DML_BATCH_SIZE rows at a time: the old
+ * keys of a batch are removed from each index before the new keys are inserted, both as
+ * one sorted batch, and entries whose key and row id did not change are left alone.
+ * The rows of a clustered table are pulled from the child before the first update.
  */
 class UpdateExecutor : public AbstractExecutor {
   friend class UpdatePlanNode;
@@ -40,6 +45,13 @@ class UpdateExecutor : public AbstractExecutor {
    */
   bool Next([[maybe_unused]] Row *row, RowId *rid) override;
 
+  /**
+   * Update the next batch of rows.
+   * @param[out] chunk One row without columns for each updated row
+   * @return `true` if a row was updated, `false` if there are no more rows
+   */
+  bool NextBatch(DataChunk *chunk) override;
+
   /** @return The output schema for the update */
   const Schema *GetOutputSchema() const override { return plan_->OutputSchema(); }
 
@@ -59,6 +71,27 @@ class UpdateExecutor : public AbstractExecutor {
   std::vector<IndexInfo *> index_info_;
   /** The child executor to obtain value from */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** Updated rows not yielded by Next yet */
+  size_t pending_{0};
+  bool stopped_{false};
+
+  /** Batch of rows pulled from the child and the next one to take */
+  DataChunk child_chunk_;
+  size_t child_cursor_{0};
+
+  /** Rows pulled from the child in Init, for a clustered table */
+  std::vector<Row> source_rows_;
+  size_t source_cursor_{0};
+  bool source_drained_{false};
+
+  /** Next row of the child, taken from its batches */
+  bool NextChild(Row *row, RowId *rid);
+
+  /** Next row to update, from the child or from source_rows_ */
+  bool NextSource(Row *row, RowId *rid);
+
+  /** Pull and update the next batch of rows, @return false if no row was updated */
+  bool UpdateBatch();
 };
 
 #endif  // MINISQL_UPDATE_EXECUTOR_H
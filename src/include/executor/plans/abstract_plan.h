@@ -8,6 +8,7 @@
 #include <record/schema.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -15,14 +16,19 @@
 enum class PlanType {
   SeqScan,
   IndexScan,
+  IndexOnlyScan,
+  BitmapHeapScan,
   Insert,
   Update,
   Delete,
   Values,
   Aggregation,
+  Sort,
   Limit,
   Distinct,
   NestedLoopJoin,
+  HashJoin,
+  IndexNestedLoopJoin,
 };
 
 class AbstractPlanNode;
@@ -59,6 +65,21 @@ class AbstractPlanNode {
   /** @return the type of this plan node */
   virtual PlanType GetType() const = 0;
 
+  /** @return One line describing this plan node, printed by EXPLAIN */
+  virtual std::string ToString() const = 0;
+
+  /** Record the output rows and the cost estimated by the planner. */
+  void SetEstimate(double rows, double cost) {
+    estimated_rows_ = rows;
+    estimated_cost_ = cost;
+  }
+
+  /** @return Estimated output rows, negative if the table has no statistics */
+  double GetEstimatedRows() const { return estimated_rows_; }
+
+  /** @return Estimated cost in sequential page reads (see CostModel), negative if the table has no statistics */
+  double GetEstimatedCost() const { return estimated_cost_; }
+
  private:
   /**
    * The schema for the output of this plan node. In the volcano model, every plan node will spit out rows,
@@ -68,6 +89,9 @@ class AbstractPlanNode {
 
   /** The children of this plan node. */
   std::vector<AbstractPlanNodeRef> children_;
+
+  double estimated_rows_{-1};
+  double estimated_cost_{-1};
 };
 
 #endif  // MINISQL_ABSTRACT_PLAN_H
@@ -0,0 +1,82 @@
+#ifndef MINISQL_AGGREGATION_PLAN_H
+#define MINISQL_AGGREGATION_PLAN_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+
+/** AggregationType enumerates the aggregate functions of a select list. */
+enum class AggregationType { CountStarAggregate, CountAggregate, SumAggregate, MinAggregate, MaxAggregate, AvgAggregate };
+
+/**
+ * The AggregationPlanNode groups the rows of its child by the group by columns and computes the
+ * aggregates of each group. Null group keys form a group of their own. COUNT counts the rows whose
+ * argument is not null, the other functions skip null arguments and give null when a group has none.
+ * SUM of an int column is an int, AVG is always a float, MIN and MAX keep the type of their column.
+ * Without group by columns there is exactly one output row, even for no input rows.
+ */
+class AggregationPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new AggregationPlanNode instance.
+   * @param output The output schema of the aggregation
+   * @param child The plan of the rows to aggregate
+   * @param group_bys Columns of the child rows the rows are grouped by
+   * @param agg_types The aggregate functions
+   * @param agg_columns Column of the child rows each aggregate reads, unused for COUNT(*)
+   * @param output_columns Source of each output column: (0, index in group_bys) or (1, index in agg_types)
+   */
+  AggregationPlanNode(const Schema *output, AbstractPlanNodeRef child, std::vector<uint32_t> group_bys,
+                      std::vector<AggregationType> agg_types, std::vector<uint32_t> agg_columns,
+                      std::vector<std::pair<uint32_t, uint32_t>> output_columns)
+      : AbstractPlanNode(output, {std::move(child)}),
+        group_bys_(std::move(group_bys)),
+        agg_types_(std::move(agg_types)),
+        agg_columns_(std::move(agg_columns)),
+        output_columns_(std::move(output_columns)) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::Aggregation; }
+
+  std::string ToString() const override {
+    std::string str = group_bys_.empty() ? "Aggregate" : "HashAggregate";
+    for (size_t i = 0; i < agg_types_.size(); i++) {
+      str += (i == 0 ? " " : ", ") + GetAggregateName(i);
+    }
+    for (size_t i = 0; i < group_bys_.size(); i++) {
+      str += (i == 0 ? " group by " : ", ") + GetChildPlan()->OutputSchema()->GetColumn(group_bys_[i])->GetName();
+    }
+    return str;
+  }
+
+  /** @return The aggregate at index i as written in a select list, e.g. "sum(amount)" */
+  std::string GetAggregateName(size_t i) const {
+    static const char *names[] = {"count", "count", "sum", "min", "max", "avg"};
+    std::string arg = agg_types_[i] == AggregationType::CountStarAggregate
+                          ? "*"
+                          : GetChildPlan()->OutputSchema()->GetColumn(agg_columns_[i])->GetName();
+    return std::string(names[static_cast<int>(agg_types_[i])]) + "(" + arg + ")";
+  }
+
+  AbstractPlanNodeRef GetChildPlan() const { return GetChildAt(0); }
+
+  const std::vector<uint32_t> &GetGroupBys() const { return group_bys_; }
+
+  const std::vector<AggregationType> &GetAggregateTypes() const { return agg_types_; }
+
+  const std::vector<uint32_t> &GetAggregateColumns() const { return agg_columns_; }
+
+  const std::vector<std::pair<uint32_t, uint32_t>> &GetOutputColumns() const { return output_columns_; }
+
+  std::vector<uint32_t> group_bys_;
+
+  std::vector<AggregationType> agg_types_;
+
+  std::vector<uint32_t> agg_columns_;
+
+  std::vector<std::pair<uint32_t, uint32_t>> output_columns_;
+};
+
+#endif  // MINISQL_AGGREGATION_PLAN_H
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "executor/plans/index_scan_plan.h"
+
+/**
+ * BitmapHeapScanPlanNode collects the row ids of an index scan like IndexScanPlanNode, then sorts them
+ * and reads each heap page they point to once, taking all of its matching rows while it is pinned.
+ * Only used for heap tables, a clustered table reads its rows from the index leaves.
+ */
+class BitmapHeapScanPlanNode : public IndexScanPlanNode {
+ public:
+  /** Below this many row ids they are fetched one by one, sorting is not worth it then */
+  static constexpr size_t MIN_BITMAP_ROWS = 8;
+
+  /** Creates a bitmap heap scan over the row ids of the indexes, intersected (AND) or merged (OR). */
+  BitmapHeapScanPlanNode(const Schema *output, std::string table_name, std::vector<IndexInfo *> indexes,
+                         bool need_filter, AbstractExpressionRef filter_predicate = nullptr)
+      : IndexScanPlanNode(output, std::move(table_name), std::move(indexes), need_filter,
+                          std::move(filter_predicate)) {}
+
+  /** Creates a bitmap heap scan over the row ids of a key range, all of them collected to sort them. */
+  BitmapHeapScanPlanNode(const Schema *output, std::string table_name, IndexInfo *index, KeyRange range,
+                         AbstractExpressionRef filter_predicate)
+      : IndexScanPlanNode(output, std::move(table_name), index, std::move(range), std::move(filter_predicate)) {
+    collect_all_ = true;
+  }
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::BitmapHeapScan; }
+
+  std::string ToString() const override { return "BitmapHeapScan" + DescribeScan(); }
+};
@@ -27,6 +27,8 @@ class DeletePlanNode : public AbstractPlanNode {
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::Delete; }
 
+  std::string ToString() const override { return "Delete on " + table_name_; }
+
   /** @return The identifier of the table from which rows are deleted*/
   std::string GetTableName() const { return table_name_; }
 
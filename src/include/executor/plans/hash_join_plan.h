@@ -0,0 +1,69 @@
+#ifndef MINISQL_HASH_JOIN_PLAN_H
+#define MINISQL_HASH_JOIN_PLAN_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+#include "planner/expressions/abstract_expression.h"
+
+/**
+ * The HashJoinPlanNode joins the rows of its left and right child whose key columns are equal, a
+ * cross join without keys. Rows with a null key never match.
+ */
+class HashJoinPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new HashJoinPlanNode instance.
+   * @param output The output schema of the join
+   * @param left_keys Key columns of the left rows, compared with right_keys in pairs
+   * @param right_keys Key columns of the right rows, each of the type of its left key
+   * @param predicate Condition the joined rows have to meet besides the keys, its columns with row
+   * index 0 are of the left row and with 1 of the right row; nullptr if none
+   * @param output_columns Source of each output column: (0, column of the left row) or (1, column of
+   * the right row)
+   */
+  HashJoinPlanNode(const Schema *output, AbstractPlanNodeRef left, AbstractPlanNodeRef right,
+                   std::vector<uint32_t> left_keys, std::vector<uint32_t> right_keys, AbstractExpressionRef predicate,
+                   std::vector<std::pair<uint32_t, uint32_t>> output_columns)
+      : AbstractPlanNode(output, {std::move(left), std::move(right)}),
+        left_keys_(std::move(left_keys)),
+        right_keys_(std::move(right_keys)),
+        predicate_(std::move(predicate)),
+        output_columns_(std::move(output_columns)) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::HashJoin; }
+
+  std::string ToString() const override {
+    std::string str = "HashJoin";
+    for (size_t i = 0; i < left_keys_.size(); i++) {
+      str += (i == 0 ? " on " : " and ") + GetLeftPlan()->OutputSchema()->GetColumn(left_keys_[i])->GetName() +
+             " = " + GetRightPlan()->OutputSchema()->GetColumn(right_keys_[i])->GetName();
+    }
+    return str + (left_keys_.empty() ? " without keys" : "") + (predicate_ != nullptr ? " with filter" : "");
+  }
+
+  AbstractPlanNodeRef GetLeftPlan() const { return GetChildAt(0); }
+
+  AbstractPlanNodeRef GetRightPlan() const { return GetChildAt(1); }
+
+  const std::vector<uint32_t> &GetLeftKeys() const { return left_keys_; }
+
+  const std::vector<uint32_t> &GetRightKeys() const { return right_keys_; }
+
+  AbstractExpressionRef GetPredicate() const { return predicate_; }
+
+  const std::vector<std::pair<uint32_t, uint32_t>> &GetOutputColumns() const { return output_columns_; }
+
+  std::vector<uint32_t> left_keys_;
+
+  std::vector<uint32_t> right_keys_;
+
+  AbstractExpressionRef predicate_;
+
+  std::vector<std::pair<uint32_t, uint32_t>> output_columns_;
+};
+
+#endif  // MINISQL_HASH_JOIN_PLAN_H
@@ -0,0 +1,103 @@
+#ifndef MINISQL_INDEX_NESTED_LOOP_JOIN_PLAN_H
+#define MINISQL_INDEX_NESTED_LOOP_JOIN_PLAN_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+#include "catalog/indexes.h"
+#include "planner/expressions/abstract_expression.h"
+
+/**
+ * The IndexNestedLoopJoinPlanNode joins the rows of its child, the outer input, with the rows of a
+ * heap table found through a b+ tree index of that table: the key of each lookup is made of outer
+ * columns equal to the index key columns. Rows with a null key never match.
+ */
+class IndexNestedLoopJoinPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new IndexNestedLoopJoinPlanNode instance.
+   * @param output The output schema of the join
+   * @param outer The plan of the outer rows
+   * @param table_name The inner table
+   * @param inner_schema The columns of the inner table as the join names them
+   * @param index The index of the inner table, every key column is one of inner_keys
+   * @param outer_keys Key columns of the outer rows, compared with inner_keys in pairs
+   * @param inner_keys Key columns of the inner rows, each of the type of its outer key
+   * @param lookup_columns The outer column of each index key column, in key order
+   * @param inner_filter Condition on the inner rows alone, its columns refer to the table; nullptr if none
+   * @param predicate Condition the joined rows have to meet besides the keys, its columns with row
+   * index 0 are of the outer row and with 1 of the inner row; nullptr if none
+   * @param output_columns Source of each output column: (0, column of the outer row) or (1, column of
+   * the inner row)
+   */
+  IndexNestedLoopJoinPlanNode(const Schema *output, AbstractPlanNodeRef outer, std::string table_name,
+                              const Schema *inner_schema, IndexInfo *index, std::vector<uint32_t> outer_keys,
+                              std::vector<uint32_t> inner_keys, std::vector<uint32_t> lookup_columns,
+                              AbstractExpressionRef inner_filter, AbstractExpressionRef predicate,
+                              std::vector<std::pair<uint32_t, uint32_t>> output_columns)
+      : AbstractPlanNode(output, {std::move(outer)}),
+        table_name_(std::move(table_name)),
+        inner_schema_(inner_schema),
+        index_(index),
+        outer_keys_(std::move(outer_keys)),
+        inner_keys_(std::move(inner_keys)),
+        lookup_columns_(std::move(lookup_columns)),
+        inner_filter_(std::move(inner_filter)),
+        predicate_(std::move(predicate)),
+        output_columns_(std::move(output_columns)) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::IndexNestedLoopJoin; }
+
+  std::string ToString() const override {
+    std::string str = "IndexNestedLoopJoin";
+    for (size_t i = 0; i < outer_keys_.size(); i++) {
+      str += (i == 0 ? " on " : " and ") + GetOuterPlan()->OutputSchema()->GetColumn(outer_keys_[i])->GetName() +
+             " = " + inner_schema_->GetColumn(inner_keys_[i])->GetName();
+    }
+    return str + " using " + index_->GetIndexName() + (inner_filter_ != nullptr ? " with inner filter" : "") +
+           (predicate_ != nullptr ? " with filter" : "");
+  }
+
+  AbstractPlanNodeRef GetOuterPlan() const { return GetChildAt(0); }
+
+  const std::string &GetTableName() const { return table_name_; }
+
+  const Schema *GetInnerSchema() const { return inner_schema_; }
+
+  IndexInfo *GetIndex() const { return index_; }
+
+  const std::vector<uint32_t> &GetOuterKeys() const { return outer_keys_; }
+
+  const std::vector<uint32_t> &GetInnerKeys() const { return inner_keys_; }
+
+  const std::vector<uint32_t> &GetLookupColumns() const { return lookup_columns_; }
+
+  AbstractExpressionRef GetInnerFilter() const { return inner_filter_; }
+
+  AbstractExpressionRef GetPredicate() const { return predicate_; }
+
+  const std::vector<std::pair<uint32_t, uint32_t>> &GetOutputColumns() const { return output_columns_; }
+
+  std::string table_name_;
+
+  const Schema *inner_schema_;
+
+  IndexInfo *index_;
+
+  std::vector<uint32_t> outer_keys_;
+
+  std::vector<uint32_t> inner_keys_;
+
+  std::vector<uint32_t> lookup_columns_;
+
+  AbstractExpressionRef inner_filter_;
+
+  AbstractExpressionRef predicate_;
+
+  std::vector<std::pair<uint32_t, uint32_t>> output_columns_;
+};
+
+#endif  // MINISQL_INDEX_NESTED_LOOP_JOIN_PLAN_H
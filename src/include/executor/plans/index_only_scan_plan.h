@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "abstract_plan.h"
+#include "catalog/catalog.h"
+#include "planner/compiled_predicate.h"
+#include "planner/expressions/abstract_expression.h"
+
+/**
+ * IndexOnlyScanPlanNode scans a b+ tree index whose key contains every column used by the
+ * output and the predicate, so rows are decoded from the leaf entries without visiting the table heap.
+ */
+class IndexOnlyScanPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Creates a new index only scan plan node.
+   * @param output the output format of this scan plan node
+   * @param table_name The identifier of table to be scanned
+   * @param index The covering index
+   */
+  IndexOnlyScanPlanNode(const Schema *output, std::string table_name, IndexInfo *index,
+                        AbstractExpressionRef filter_predicate = nullptr)
+      : AbstractPlanNode(output, {}),
+        table_name_(std::move(table_name)),
+        index_(index),
+        filter_predicate_(std::move(filter_predicate)),
+        compiled_predicate_(CompiledPredicate::Compile(filter_predicate_)) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::IndexOnlyScan; }
+
+  std::string ToString() const override {
+    return "IndexOnlyScan on " + table_name_ + " using " + index_->GetIndexName() +
+           (filter_predicate_ != nullptr ? " with filter" : "");
+  }
+
+  /** @return The identifier of the table that should be scanned */
+  std::string GetTableName() const { return table_name_; }
+
+  AbstractExpressionRef GetPredicate() const { return filter_predicate_; }
+
+  /** @return The predicate compiled when the node is built, nullptr without predicate */
+  const CompiledPredicate *GetCompiledPredicate() const { return compiled_predicate_.get(); }
+
+  /** The table name */
+  std::string table_name_;
+
+  /** The covering index */
+  IndexInfo *index_;
+
+  /** The predicate to filter the index entries.*/
+  AbstractExpressionRef filter_predicate_;
+
+  /** filter_predicate_ with its comparisons bound to their columns and constants */
+  std::unique_ptr<CompiledPredicate> compiled_predicate_;
+};
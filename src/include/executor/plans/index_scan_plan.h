@@ -1,11 +1,14 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "abstract_plan.h"
 #include "catalog/catalog.h"
+#include "planner/compiled_predicate.h"
 #include "planner/expressions/abstract_expression.h"
+#include "planner/key_range.h"
 
 /**
  * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
@@ -23,16 +26,50 @@ class IndexScanPlanNode : public AbstractPlanNode {
         table_name_(std::move(table_name)),
         indexes_(std::move(indexes)),
         need_filter_(need_filter),
-        filter_predicate_(std::move(filter_predicate)) {}
+        filter_predicate_(std::move(filter_predicate)),
+        compiled_predicate_(CompiledPredicate::Compile(filter_predicate_)) {}
+
+  /**
+   * Creates an index scan plan node that answers the predicate with one bounded leaf scan.
+   * @param output the output format of this scan plan node
+   * @param table_name The identifier of table to be scanned
+   * @param index The b+ tree index to be scanned
+   * @param range The range of the predicate over the index key
+   */
+  IndexScanPlanNode(const Schema *output, std::string table_name, IndexInfo *index, KeyRange range,
+                    AbstractExpressionRef filter_predicate)
+      : AbstractPlanNode(output, {}),
+        table_name_(std::move(table_name)),
+        indexes_{index},
+        need_filter_(!range.IsExact()),
+        filter_predicate_(std::move(filter_predicate)),
+        compiled_predicate_(CompiledPredicate::Compile(filter_predicate_)),
+        range_(std::make_unique<KeyRange>(std::move(range))) {}
 
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::IndexScan; }
 
+  /** A range scan names its index, otherwise the row ids of the indexes are intersected (AND) or merged (OR). */
+  std::string ToString() const override { return "IndexScan" + DescribeScan(); }
+
+  /** @return The table, the indexes and how they are used, e.g. " on t using a (range) with filter" */
+  std::string DescribeScan() const {
+    std::string result = " on " + table_name_ + " using ";
+    for (size_t i = 0; i < indexes_.size(); i++) {
+      result += (i == 0 ? "" : ", ") + indexes_[i]->GetIndexName();
+    }
+    result += range_ != nullptr ? " (range)" : (indexes_.size() > 1 ? " (row id set)" : " (row ids)");
+    return result + (need_filter_ ? " with filter" : "");
+  }
+
   /** @return The identifier of the table that should be scanned */
   std::string GetTableName() const { return table_name_; }
 
   AbstractExpressionRef GetPredicate() const { return filter_predicate_; }
 
+  /** @return The predicate compiled when the node is built, nullptr without predicate */
+  const CompiledPredicate *GetCompiledPredicate() const { return compiled_predicate_.get(); }
+
   /** The table name */
   std::string table_name_;
 
@@ -44,4 +81,16 @@ class IndexScanPlanNode : public AbstractPlanNode {
 
   /** The predicate to filter in IndexScan.*/
   AbstractExpressionRef filter_predicate_;
+
+  /** filter_predicate_ with its comparisons bound to their columns and constants */
+  std::unique_ptr<CompiledPredicate> compiled_predicate_;
+
+  /** The key range scanned on indexes_[0], null if every comparison is scanned separately */
+  std::unique_ptr<KeyRange> range_;
+
+  /**
+   * Whether the range is read to the end in Init, as under an update or delete. Otherwise the leaves
+   * are read as the rows are asked for, and a scan that is stopped early reads only the first ones.
+   */
+  bool collect_all_ = false;
 };
\ No newline at end of file
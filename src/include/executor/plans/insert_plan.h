@@ -26,6 +26,8 @@ class InsertPlanNode : public AbstractPlanNode {
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::Insert; }
 
+  std::string ToString() const override { return "Insert on " + table_name_; }
+
   /** @return The identifier of the table which rows are inserted intol*/
   std::string GetTableName() const { return table_name_; }
 
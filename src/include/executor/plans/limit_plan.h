@@ -0,0 +1,42 @@
+#ifndef MINISQL_LIMIT_PLAN_H
+#define MINISQL_LIMIT_PLAN_H
+
+#include <string>
+#include <utility>
+
+#include "abstract_plan.h"
+
+/**
+ * The LimitPlanNode skips the first offset rows of its child and produces the next limit rows, in
+ * the order the child produces them, and stops reading the child there.
+ */
+class LimitPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Construct a new LimitPlanNode instance.
+   * @param child The plan of the rows, its output schema is that of the limit
+   * @param limit Rows to produce at most
+   * @param offset Rows of the child to skip first
+   */
+  LimitPlanNode(AbstractPlanNodeRef child, size_t limit, size_t offset = 0)
+      : AbstractPlanNode(child->OutputSchema(), {child}), limit_(limit), offset_(offset) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::Limit; }
+
+  std::string ToString() const override {
+    return "Limit " + std::to_string(limit_) + (offset_ > 0 ? " offset " + std::to_string(offset_) : "");
+  }
+
+  AbstractPlanNodeRef GetChildPlan() const { return GetChildAt(0); }
+
+  size_t GetLimit() const { return limit_; }
+
+  size_t GetOffset() const { return offset_; }
+
+  size_t limit_;
+
+  size_t offset_;
+};
+
+#endif  // MINISQL_LIMIT_PLAN_H
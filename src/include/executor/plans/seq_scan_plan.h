@@ -7,6 +7,7 @@
 
 #include "abstract_plan.h"
 #include "catalog/catalog.h"
+#include "planner/compiled_predicate.h"
 #include "planner/expressions/abstract_expression.h"
 
 class SeqScanPlanNode : public AbstractPlanNode {
@@ -19,21 +20,52 @@ class SeqScanPlanNode : public AbstractPlanNode {
   SeqScanPlanNode(const Schema *output, std::string table_name, AbstractExpressionRef filter_predicate = nullptr)
       : AbstractPlanNode(output, {}),
         table_name_(std::move(table_name)),
-        filter_predicate_(std::move(filter_predicate)) {}
+        filter_predicate_(std::move(filter_predicate)),
+        compiled_predicate_(CompiledPredicate::Compile(filter_predicate_)) {}
 
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::SeqScan; }
 
+  std::string ToString() const override {
+    std::string str = "SeqScan on " + table_name_ + (filter_predicate_ != nullptr ? " with filter" : "");
+    if (parallelism_ > 1) {
+      str += ", " + std::to_string(parallelism_) + " workers" + (preserve_order_ ? " in order" : "");
+    }
+    return str;
+  }
+
   /** @return The identifier of the table that should be scanned */
   std::string GetTableName() const { return table_name_; }
 
   AbstractExpressionRef GetPredicate() const { return filter_predicate_; }
 
+  /** @return The predicate compiled when the node is built, nullptr without predicate */
+  const CompiledPredicate *GetCompiledPredicate() const { return compiled_predicate_.get(); }
+
+  /** @return Worker threads scanning the table, 1 for a scan on the calling thread */
+  size_t GetParallelism() const { return parallelism_; }
+
+  /** @return Whether the workers return their rows in table order */
+  bool IsOrderPreserved() const { return preserve_order_; }
+
+  /** Scan the pages of a heap table with parallelism workers */
+  void SetParallelism(size_t parallelism, bool preserve_order) {
+    parallelism_ = parallelism;
+    preserve_order_ = preserve_order;
+  }
+
   /** The table name */
   std::string table_name_;
 
   /** The predicate to filter in SeqScan.*/
   AbstractExpressionRef filter_predicate_;
+
+  /** filter_predicate_ with its comparisons bound to their columns and constants */
+  std::unique_ptr<CompiledPredicate> compiled_predicate_;
+
+  size_t parallelism_{1};
+
+  bool preserve_order_{false};
 };
 
 #endif  // MINISQL_SEQ_SCAN_PLAN_H
@@ -0,0 +1,53 @@
+#ifndef MINISQL_SORT_PLAN_H
+#define MINISQL_SORT_PLAN_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_plan.h"
+
+/**
+ * The SortPlanNode orders the rows of its child by the order by columns, each ascending or
+ * descending. Nulls come before every value in ascending order and after them in descending order,
+ * as in the keys of a b+ tree index. With a limit only the first limit rows are produced, which
+ * are kept in a bounded heap instead of sorting the whole input.
+ */
+class SortPlanNode : public AbstractPlanNode {
+ public:
+  /** No limit */
+  static constexpr int64_t NO_LIMIT = -1;
+
+  /**
+   * Construct a new SortPlanNode instance.
+   * @param child The plan of the rows to sort, its output schema is that of the sort
+   * @param order_bys Columns of the child rows to sort by, each with whether it is descending
+   * @param limit Rows to produce at most, NO_LIMIT for all
+   */
+  SortPlanNode(AbstractPlanNodeRef child, std::vector<std::pair<uint32_t, bool>> order_bys, int64_t limit = NO_LIMIT)
+      : AbstractPlanNode(child->OutputSchema(), {child}), order_bys_(std::move(order_bys)), limit_(limit) {}
+
+  /** @return The type of the plan node */
+  PlanType GetType() const override { return PlanType::Sort; }
+
+  std::string ToString() const override {
+    std::string str = limit_ == NO_LIMIT ? "Sort" : "TopN " + std::to_string(limit_);
+    for (size_t i = 0; i < order_bys_.size(); i++) {
+      str += (i == 0 ? " by " : ", ") + OutputSchema()->GetColumn(order_bys_[i].first)->GetName() +
+             (order_bys_[i].second ? " desc" : "");
+    }
+    return str;
+  }
+
+  AbstractPlanNodeRef GetChildPlan() const { return GetChildAt(0); }
+
+  const std::vector<std::pair<uint32_t, bool>> &GetOrderBys() const { return order_bys_; }
+
+  int64_t GetLimit() const { return limit_; }
+
+  std::vector<std::pair<uint32_t, bool>> order_bys_;
+
+  int64_t limit_;
+};
+
+#endif  // MINISQL_SORT_PLAN_H
@@ -30,6 +30,8 @@ class UpdatePlanNode : public AbstractPlanNode {
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::Update; }
 
+  std::string ToString() const override { return "Update on " + table_name_; }
+
   /** @return The identifier of the table into which rows are inserted */
   std::string GetTableName() const { return table_name_; }
 
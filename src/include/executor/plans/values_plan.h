@@ -27,6 +27,8 @@ class ValuesPlanNode : public AbstractPlanNode {
   /** @return The type of the plan node */
   PlanType GetType() const override { return PlanType::Values; }
 
+  std::string ToString() const override { return "Values (" + std::to_string(values_.size()) + " rows)"; }
+
   const std::vector<std::vector<AbstractExpressionRef>> &GetValues() const { return values_; }
 
   std::vector<std::vector<AbstractExpressionRef>> values_;
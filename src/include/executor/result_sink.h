@@ -0,0 +1,160 @@
+#ifndef MINISQL_RESULT_SINK_H
+#define MINISQL_RESULT_SINK_H
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "record/data_chunk.h"
+#include "record/row.h"
+#include "record/schema.h"
+
+/** How the rows of a query are written out, see ResultSink::Create */
+enum class OutputFormat { kTable, kTsv, kBinary };
+
+/**
+ * ResultSink receives the rows of a plan chunk by chunk as the executor produces them. The base
+ * sink only counts them, which is all a statement without result rows needs. The sinks that write
+ * the rows out hold at most a bounded number of them, so the memory of a query does not grow with
+ * the size of its result and the first rows are out before the last ones are read.
+ */
+class ResultSink {
+ public:
+  virtual ~ResultSink() = default;
+
+  /**
+   * Create the sink writing the rows of a query to stream.
+   * @param format kTable for the aligned table of the shell, kTsv for tab separated lines and
+   * kBinary for length prefixed values, see TsvSink and BinarySink
+   */
+  static std::unique_ptr<ResultSink> Create(OutputFormat format, std::ostream &stream);
+
+  /** Start a result with rows of schema. */
+  virtual void Begin(const Schema *schema) { schema_ = schema; }
+
+  /** Take the selected rows of chunk. */
+  void Consume(const DataChunk &chunk) {
+    rows_ += chunk.GetSelectedCount();
+    Write(chunk);
+  }
+
+  /** Finish the result after the last chunk. */
+  virtual void End() {}
+
+  /** @return Rows consumed so far */
+  size_t GetRowCount() const { return rows_; }
+
+ protected:
+  /** Handle the selected rows of chunk, called for each chunk consumed */
+  virtual void Write(const DataChunk &) {}
+
+  /**
+   * Append the value at position pos of column as text, as Field::toString() formats it.
+   */
+  static void AppendText(const ColumnVector &column, size_t pos, std::string *out);
+
+  const Schema *schema_{nullptr};
+  size_t rows_{0};
+};
+
+/** RowCollector keeps every row, for callers that need the rows themselves. */
+class RowCollector : public ResultSink {
+ public:
+  explicit RowCollector(std::vector<Row> *rows) : rows_out_(rows) {}
+
+ protected:
+  void Write(const DataChunk &chunk) override;
+
+ private:
+  std::vector<Row> *rows_out_;
+};
+
+/**
+ * TableSink writes the rows as the table of the shell, a header between dividers, a line per row
+ * with the cells padded to the width of their column and a closing divider.
+ *
+ * The widths are fixed before the first row is written. The first SAMPLE_ROWS rows are held back
+ * as text; when the result ends within them the widths fit every cell exactly. Otherwise the widths
+ * come from the sample, widened to the longest value the column type allows when that is at most
+ * MAX_SCHEMA_WIDTH (an int, a short char). The sample is then written and every later chunk goes out
+ * as it comes. A later cell longer than its column is written in full and shifts the rest of its line.
+ */
+class TableSink : public ResultSink {
+ public:
+  /** Rows formatted before the widths are fixed */
+  static constexpr size_t SAMPLE_ROWS = 1024;
+  /** Widest column whose width is taken from its type when the sample does not hold every row */
+  static constexpr size_t MAX_SCHEMA_WIDTH = 32;
+
+  explicit TableSink(std::ostream &stream) : stream_(stream) {}
+
+  void Begin(const Schema *schema) override;
+
+  void End() override;
+
+ protected:
+  void Write(const DataChunk &chunk) override;
+
+ private:
+  /** Fix the widths, write the header and the rows of the sample */
+  void WriteSample(bool complete);
+
+  /** Append a divider line of the widths to out */
+  void AppendDivider(std::string *out) const;
+
+  /** Append a line of the cells, each padded to the width of its column, to out */
+  void AppendLine(const std::vector<std::string> &cells, std::string *out) const;
+
+  std::ostream &stream_;
+  std::vector<size_t> widths_;
+  /** Cells of the rows held back until the widths are fixed */
+  std::vector<std::vector<std::string>> sample_;
+  bool sampling_{true};
+};
+
+/**
+ * TsvSink writes a line of the column names, then a line per row with its values separated by tabs.
+ * A null is written as \N; a backslash, tab, newline or carriage return in a char value is escaped
+ * as \\, \t, \n or \r. Floats are written with 9 significant digits, which read back to the same
+ * value. Each chunk is written as it comes.
+ */
+class TsvSink : public ResultSink {
+ public:
+  explicit TsvSink(std::ostream &stream) : stream_(stream) {}
+
+  void Begin(const Schema *schema) override;
+
+ protected:
+  void Write(const DataChunk &chunk) override;
+
+ private:
+  std::ostream &stream_;
+};
+
+/**
+ * BinarySink writes the rows unformatted, in host byte order:
+ *
+ * | MAGIC (8) | column count (4) | per column: type id (1) | name length (4) | name |
+ *
+ * then for each row a byte 1 followed by each value, a null flag (1) and unless it is null the int
+ * (4), the float (4) or the length (4) and bytes of the char. A byte 0 ends the result.
+ */
+class BinarySink : public ResultSink {
+ public:
+  static constexpr char MAGIC[9] = "MSQLROWS";
+
+  explicit BinarySink(std::ostream &stream) : stream_(stream) {}
+
+  void Begin(const Schema *schema) override;
+
+  void End() override;
+
+ protected:
+  void Write(const DataChunk &chunk) override;
+
+ private:
+  std::ostream &stream_;
+};
+
+#endif  // MINISQL_RESULT_SINK_H
@@ -0,0 +1,120 @@
+#ifndef MINISQL_ADAPTIVE_RADIX_TREE_H
+#define MINISQL_ADAPTIVE_RADIX_TREE_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/rowid.h"
+
+/**
+ * In-memory adaptive radix tree (Leis et al., ICDE 2013) over binary-comparable keys.
+ *
+ * Inner nodes adapt their fanout to the number of children (Node4, Node16, Node48 and
+ * Node256) and compress common paths: a node keeps the length of its compressed path
+ * and the first MAX_PREFIX_LEN bytes of it, longer paths are checked against the key
+ * of a leaf below the node. Leaves hold the full key and the row id.
+ *
+ * The tree lives on the heap, not in the buffer pool. Keys must be prefix free (no key
+ * is a proper prefix of another), which the key encoding of ArtIndex guarantees.
+ */
+class AdaptiveRadixTree {
+ public:
+  static constexpr uint32_t MAX_PREFIX_LEN = 8;
+
+  struct Node;
+  struct Leaf;
+
+  /**
+   * Iterator over the leaves in key order. It keeps the path from the root to the current
+   * leaf, so it is invalidated by any insert or remove.
+   */
+  class Iterator {
+    friend class AdaptiveRadixTree;
+
+   public:
+    Iterator() = default;
+
+    const std::string &Key() const;
+
+    RowId Value() const;
+
+    bool IsEnd() const { return leaf_ == nullptr; }
+
+    Iterator &operator++();
+
+    bool operator==(const Iterator &itr) const { return leaf_ == itr.leaf_; }
+
+    bool operator!=(const Iterator &itr) const { return !(*this == itr); }
+
+   private:
+    // Descend to the smallest leaf of node, pushing the inner nodes passed.
+    void PushMin(const Node *node);
+
+    // Move to the smallest leaf after the subtree of the top of the stack.
+    void Advance();
+
+    // (inner node, position of the child being visited)
+    std::vector<std::pair<const Node *, int>> stack_;
+    const Leaf *leaf_{nullptr};
+  };
+
+  AdaptiveRadixTree() = default;
+
+  ~AdaptiveRadixTree();
+
+  AdaptiveRadixTree(const AdaptiveRadixTree &) = delete;
+
+  AdaptiveRadixTree &operator=(const AdaptiveRadixTree &) = delete;
+
+  /** @return false if the key exists */
+  bool Insert(const std::string &key, RowId value);
+
+  /** @return false if the key does not exist */
+  bool Remove(const std::string &key);
+
+  bool GetValue(const std::string &key, RowId &value) const;
+
+  Iterator Begin() const;
+
+  /** Iterator to the first key >= key. */
+  Iterator LowerBound(const std::string &key) const;
+
+  Iterator End() const { return Iterator(); }
+
+  void Clear();
+
+  size_t GetSize() const { return size_; }
+
+  /** Bytes allocated for the nodes and leaves. */
+  size_t GetMemoryUsage() const { return memory_; }
+
+ private:
+  Node *NewNode(uint8_t type);
+
+  Leaf *NewLeaf(const std::string &key, RowId value);
+
+  void FreeNode(Node *node);
+
+  void FreeTree(Node *node);
+
+  bool Insert(Node *&ref, const std::string &key, uint32_t depth, RowId value);
+
+  bool Remove(Node *&ref, const std::string &key, uint32_t depth);
+
+  // Add a child to the inner node at ref, growing it into a larger node type if it is full.
+  void AddChild(Node *&ref, uint8_t byte, Node *child);
+
+  // Remove the child of the inner node at ref, shrinking or collapsing the node if it gets sparse.
+  void RemoveChild(Node *&ref, uint8_t byte);
+
+  // Number of prefix bytes of node that match key from depth.
+  uint32_t PrefixMismatch(const Node *node, const std::string &key, uint32_t depth) const;
+
+  Node *root_{nullptr};
+  size_t size_{0};
+  size_t memory_{0};
+};
+
+#endif  // MINISQL_ADAPTIVE_RADIX_TREE_H
@@ -0,0 +1,57 @@
+#ifndef MINISQL_ART_INDEX_H
+#define MINISQL_ART_INDEX_H
+
+#include <string>
+
+#include "index/adaptive_radix_tree.h"
+#include "index/index.h"
+
+/**
+ * Memory resident index on an adaptive radix tree, created by CREATE INDEX ... USING art.
+ * Nothing of it is written to disk, the catalog rebuilds the tree from the table heap when
+ * it loads the index. It answers the same comparison operators as BPlusTreeIndex.
+ */
+class ArtIndex : public Index {
+ public:
+  ArtIndex(index_id_t index_id, IndexSchema *key_schema, bool unique = true);
+
+  dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn) override;
+
+  dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, std::string compare_operator = "=") override;
+
+  dberr_t Destroy() override;
+
+  AdaptiveRadixTree::Iterator GetBeginIterator() const { return container_.Begin(); }
+
+  AdaptiveRadixTree::Iterator GetEndIterator() const { return container_.End(); }
+
+  /** Iterator to the first entry whose columns are >= key. */
+  AdaptiveRadixTree::Iterator GetLowerBoundIterator(const Row &key) const;
+
+  bool IsUnique() const { return unique_; }
+
+  size_t GetMemoryUsage() const { return container_.GetMemoryUsage(); }
+
+  /**
+   * Binary-comparable form of a key row, comparing two encoded keys with memcmp gives the
+   * order of the rows. Each field starts with 0 if it is null (so null sorts first) or 1
+   * followed by the value: ints and floats big-endian with the sign bit flipped (negative
+   * floats flip every bit), chars with 0 escaped as 0 0xFF and terminated by 0 0. The
+   * encoding is self-delimiting, so no key is a prefix of another.
+   */
+  static std::string EncodeKey(const Row &key, Schema *key_schema);
+
+ private:
+  // Non-unique keys end with the row id, which makes every entry distinct.
+  std::string MakeKey(const Row &key, RowId row_id) const;
+
+  // first entry > key, i.e. past the entries that start with key
+  AdaptiveRadixTree::Iterator UpperBound(const std::string &key) const;
+
+  bool unique_;
+  AdaptiveRadixTree container_;
+};
+
+#endif  // MINISQL_ART_INDEX_H
@@ -1,6 +1,7 @@
 #ifndef MINISQL_B_PLUS_TREE_H
 #define MINISQL_B_PLUS_TREE_H
 
+#include <deque>
 #include <queue>
 #include <string>
 #include <vector>
@@ -16,10 +17,16 @@
  *
  * Implementation of simple b+ tree data structure where internal pages direct
  * the search and leaf pages contain actual data.
- * (1) We only support unique key
+ * (1) Keys are unique in the tree; duplicate column values are stored with a
+ *     row id suffix appended by the KeyManager of a non-unique index
  * (2) support insert & remove
  * (3) The structure should shrink and grow dynamically
  * (4) Implement index iterator for range scan
+ * (5) Keys are stored variable-length with page prefix compression, and leaf splits
+ *     push the shortest separator up, so a page splits / merges by the bytes it uses
+ *     unless an explicit max size is given
+ * (6) The internal pages of the top levels can be kept pinned with child pointers
+ *     resolved in memory, so a search skips the buffer pool page table up there
  */
 class BPlusTree {
   using InternalPage = BPlusTreeInternalPage;
@@ -28,6 +35,12 @@ class BPlusTree {
  public:
   explicit BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager, const KeyManager &comparator, int leaf_max_size = UNDEFINED_SIZE, int internal_max_size = UNDEFINED_SIZE);
 
+  ~BPlusTree();
+
+  BPlusTree(const BPlusTree &) = delete;
+
+  BPlusTree &operator=(const BPlusTree &) = delete;
+
   // Returns true if this B+ tree has no keys and values.
   bool IsEmpty() const;
 
@@ -40,6 +53,21 @@ class BPlusTree {
   // return the value associated with a given key
   bool GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction = nullptr);
 
+  /**
+   * Batched operations. Every key is first searched in the leaf of the previous key of the batch,
+   * which stays pinned along with the separators around it, and the search only starts from the
+   * root when the key falls outside of them. Keys sorted in tree order share the descents.
+   */
+  // results[i] gets the value of keys[i], or with high_keys every value in [keys[i], high_keys[i]]
+  void GetValues(const std::vector<GenericKey *> &keys, std::vector<std::vector<RowId>> &results,
+                 const std::vector<GenericKey *> *high_keys = nullptr, Txn *transaction = nullptr);
+
+  // inserted[i] is false if keys[i] is a duplicate, @return the number of inserted keys
+  int InsertMany(const std::vector<GenericKey *> &keys, const std::vector<RowId> &values, std::vector<bool> &inserted,
+                 Txn *transaction = nullptr);
+
+  void RemoveMany(const std::vector<GenericKey *> &keys, Txn *transaction = nullptr);
+
   IndexIterator Begin();
 
   IndexIterator Begin(const GenericKey *key);
@@ -52,9 +80,29 @@ class BPlusTree {
   // used to check whether all pages are unpinned
   bool Check();
 
+  // number of levels from the root to the leaves, 0 for an empty tree
+  int GetHeight();
+
+  // number of pages used by the tree
+  int GetPageCount(page_id_t page_id = INVALID_PAGE_ID);
+
   // destroy the b plus tree
   void Destroy(page_id_t current_page_id = INVALID_PAGE_ID);
 
+  /**
+   * Keep the internal pages of the top levels pinned, 0 turns it off. Leaves are never pinned,
+   * and a level is skipped when it would take more than 1/MAX_PINNED_FRACTION of the buffer pool.
+   * The pinned pages are released by a split or merge and pinned again by the next search.
+   */
+  void SetPinnedLevels(int levels);
+
+  int GetPinnedLevels() const { return pinned_levels_; }
+
+  // number of pages held pinned by the top levels
+  size_t GetPinnedPageCount() const { return pinned_nodes_.size(); }
+
+  static constexpr size_t MAX_PINNED_FRACTION = 8;
+
   void PrintTree(std::ofstream &out, Schema *schema) {
     if (IsEmpty()) {
       return;
@@ -77,6 +125,10 @@ class BPlusTree {
 
   InternalPage *Split(InternalPage *node, Txn *transaction);
 
+  bool CanCoalesce(LeafPage *neighbor_node, LeafPage *node, InternalPage *parent, int index);
+
+  bool CanCoalesce(InternalPage *neighbor_node, InternalPage *node, InternalPage *parent, int index);
+
   template <typename N>
   bool CoalesceOrRedistribute(N *&node, Txn *transaction = nullptr);
 
@@ -94,6 +146,46 @@ class BPlusTree {
 
   void UpdateRootPageId(int insert_record = 0);
 
+  /** An internal page held pinned, children point to the pinned nodes of the next level if there is one. */
+  struct PinnedNode {
+    Page *page;
+    std::vector<PinnedNode *> children;
+  };
+
+  /** The leaf of the last key of a batch, with the separators around it (low inclusive, high exclusive). */
+  struct LeafCursor {
+    explicit LeafCursor(int key_size)
+        : low(reinterpret_cast<GenericKey *>(malloc(key_size))), high(reinterpret_cast<GenericKey *>(malloc(key_size))) {}
+
+    ~LeafCursor() {
+      free(low);
+      free(high);
+    }
+
+    LeafPage *leaf{nullptr};
+    bool dirty{false};
+    // false after the cursor moved along the leaf chain, the separators are unknown then
+    bool fenced{false};
+    bool has_low{false};
+    bool has_high{false};
+    GenericKey *low;
+    GenericKey *high;
+  };
+
+  // leaf holding key, the cursor's leaf if key lies between its separators
+  LeafPage *SeekLeaf(LeafCursor &cursor, const GenericKey *key);
+
+  void ReleaseLeaf(LeafCursor &cursor);
+
+  // pin the top pinned_levels_ levels if they are not pinned
+  void PinUpperLevels();
+
+  // unpin the top levels before the structure of the tree changes
+  void ReleasePinnedPages();
+
+  // bytes at the end of a key stored verbatim (row id suffix of a non-unique key)
+  int KeyTail() const { return processor_.GetKeySize() - processor_.GetRowSpace(); }
+
   /* Debug Routines for FREE!! */
   void ToGraph(BPlusTreePage *page, BufferPoolManager *bpm, std::ofstream &out, Schema *schema) const;
 
@@ -106,6 +198,9 @@ class BPlusTree {
   KeyManager processor_;
   int leaf_max_size_;
   int internal_max_size_;
+  int pinned_levels_{0};
+  // level order, the root first; deque keeps the node addresses stable
+  std::deque<PinnedNode> pinned_nodes_;
 };
 
 #endif  // MINISQL_B_PLUS_TREE_H
@@ -7,7 +7,8 @@
 
 class BPlusTreeIndex : public Index {
  public:
-  BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size, BufferPoolManager *buffer_pool_manager);
+  BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size, BufferPoolManager *buffer_pool_manager,
+                 bool unique = true);
 
   dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
 
@@ -17,13 +18,55 @@ class BPlusTreeIndex : public Index {
 
   dberr_t Destroy() override;
 
+  dberr_t InsertEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn) override;
+
+  dberr_t RemoveEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn) override;
+
+  dberr_t LookupMany(const std::vector<Row> &keys, std::vector<std::vector<RowId>> &results, Txn *txn) override;
+
   IndexIterator GetBeginIterator();
 
   IndexIterator GetBeginIterator(GenericKey *key);
 
   IndexIterator GetEndIterator();
 
+  /** Iterator to the first entry whose columns are >= key. */
+  IndexIterator GetLowerBoundIterator(const Row &key);
+
+  bool IsUnique() const { return processor_.IsUnique(); }
+
+  const KeyManager &GetKeyManager() const { return processor_; }
+
+  /** Keep the top levels of a hot index pinned in the buffer pool (see BPlusTree::SetPinnedLevels). */
+  void SetPinnedLevels(int levels) { container_.SetPinnedLevels(levels); }
+
+  int GetPinnedLevels() const { return container_.GetPinnedLevels(); }
+
+  /** Buffer pool memory held by the pinned levels. */
+  size_t GetPinnedBytes() const { return container_.GetPinnedPageCount() * PAGE_SIZE; }
+
  protected:
+  BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, const KeyManager &processor,
+                 BufferPoolManager *buffer_pool_manager);
+
+  /** Iterator to the first entry whose columns are >= key (key has been serialized by processor_). */
+  IndexIterator LowerBound(GenericKey *key);
+
+  /** Iterator to the first entry whose columns are > key. */
+  IndexIterator UpperBound(GenericKey *key);
+
+  /** Iterator to the first entry whose first column is not null, the null keys sort first. */
+  IndexIterator NonNullBegin();
+
+  /**
+   * Serialize a batch of keys into one buffer, with the row id suffix if row_ids is given.
+   * @param[out] keys The serialized keys in tree order
+   * @param[out] order order[i] is the position of keys[i] in rows
+   * @return The buffer holding the keys, to be freed by the caller
+   */
+  char *SerializeBatch(const std::vector<Row> &rows, const std::vector<RowId> *row_ids, std::vector<GenericKey *> &keys,
+                       std::vector<size_t> &order);
+
   // comparator for key
   KeyManager processor_;
   // container
@@ -0,0 +1,56 @@
+#ifndef MINISQL_BLOOM_FILTER_H
+#define MINISQL_BLOOM_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Split block Bloom filter. The bit array is cut into 32 byte blocks of eight 32-bit
+ * words, a key picks one block from the high half of its hash and sets one bit in every
+ * word of the block from the low half. A probe therefore touches a single cache line.
+ *
+ * Bits can not be cleared: removed keys stay in the filter until it is rebuilt, so the
+ * filter only ever answers "definitely absent" or "maybe present".
+ */
+class BloomFilter {
+ public:
+  static constexpr uint32_t WORDS_PER_BLOCK = 8;
+  static constexpr uint32_t BLOCK_SIZE = WORDS_PER_BLOCK * sizeof(uint32_t);
+  /** Keys per block at full load, 16 bits per key keeps false positives below 0.5% */
+  static constexpr uint32_t KEYS_PER_BLOCK = 16;
+
+  explicit BloomFilter(uint32_t num_blocks = 1);
+
+  /** 64-bit hash of a byte string, stable across runs since the filter is persisted. */
+  static uint64_t Hash(const char *data, size_t len);
+
+  /** Number of blocks (a power of two) for the given number of keys. */
+  static uint32_t BlocksFor(size_t num_keys);
+
+  void Insert(uint64_t hash);
+
+  bool MayContain(uint64_t hash) const;
+
+  /** Drop every key and resize the filter to num_blocks. */
+  void Reset(uint32_t num_blocks);
+
+  uint32_t GetNumBlocks() const { return num_blocks_; }
+
+  /** Keys the filter holds before its false positive rate degrades. */
+  size_t GetCapacity() const { return static_cast<size_t>(num_blocks_) * KEYS_PER_BLOCK; }
+
+  size_t GetMemoryUsage() const { return words_.size() * sizeof(uint32_t); }
+
+  const char *GetData() const { return reinterpret_cast<const char *>(words_.data()); }
+
+  char *GetData() { return reinterpret_cast<char *>(words_.data()); }
+
+ private:
+  const uint32_t *BlockOf(uint64_t hash) const;
+
+  uint32_t num_blocks_;
+  std::vector<uint32_t> words_;
+};
+
+#endif  // MINISQL_BLOOM_FILTER_H
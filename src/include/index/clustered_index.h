@@ -0,0 +1,82 @@
+#ifndef MINISQL_CLUSTERED_INDEX_H
+#define MINISQL_CLUSTERED_INDEX_H
+
+#include "index/b_plus_tree_index.h"
+#include "storage/table_iterator.h"
+
+/**
+ * Primary key index of a clustered (index-organized) table, created by CREATE TABLE ... CLUSTERED.
+ * The table has no heap: every leaf entry is the serialized primary key followed by the serialized
+ * row as the key payload (see KeyManager::GetPayload), so rows are kept in primary key order and a
+ * primary key range is read with one walk along the leaf chain.
+ *
+ * The primary key is a single int column and doubles as the row id (RowIdOf / KeyOf). Secondary
+ * indexes therefore point at primary key values, which stay valid when leaves split or merge.
+ *
+ * Rows are written through InsertRow / RemoveRow / UpdateRow (see TableInfo). The entry writes of
+ * the Index interface, which the executors call to maintain every index of the table, do nothing.
+ */
+class ClusteredIndex : public BPlusTreeIndex {
+ public:
+  ClusteredIndex(index_id_t index_id, IndexSchema *key_schema, Schema *table_schema,
+                 BufferPoolManager *buffer_pool_manager);
+
+  /** @return Key size holding the rows of table_schema, 0 if the table can not be clustered on key_schema */
+  static size_t KeySizeFor(const Schema *key_schema, const Schema *table_schema);
+
+  dberr_t InsertEntry(const Row &, RowId, Txn *) override { return DB_SUCCESS; }
+
+  dberr_t RemoveEntry(const Row &, RowId, Txn *) override { return DB_SUCCESS; }
+
+  dberr_t InsertEntries(const std::vector<Row> &, const std::vector<RowId> &, Txn *) override { return DB_SUCCESS; }
+
+  dberr_t RemoveEntries(const std::vector<Row> &, const std::vector<RowId> &, Txn *) override { return DB_SUCCESS; }
+
+  /**
+   * Insert a row, its row id is set to RowIdOf(primary key).
+   * @return false if the primary key is null or exists
+   */
+  bool InsertRow(Row &row, Txn *txn);
+
+  /** @return false if there is no row at rid */
+  bool RemoveRow(const RowId &rid, Txn *txn);
+
+  /**
+   * Replace the row at rid. A new primary key moves the row, its row id is set to the new one.
+   * @return false if there is no row at rid or the new primary key is taken
+   */
+  bool UpdateRow(Row &row, const RowId &rid, Txn *txn);
+
+  /** Read the row at row->GetRowId(). */
+  bool GetRow(Row *row, Txn *txn);
+
+  /** Decode the row stored in a leaf entry. */
+  void ReadRow(const GenericKey *key, Row &row) const;
+
+  /** Rows in primary key order. */
+  TableIterator Begin(Txn *txn);
+
+  TableIterator End();
+
+  static RowId RowIdOf(int32_t key) { return RowId(key, ROW_ID_SLOT); }
+
+  static int32_t KeyOf(const RowId &rid) { return rid.GetPageId(); }
+
+  /** Slot number of every clustered row id, keeps RowIdOf(-1) apart from INVALID_ROWID */
+  static constexpr uint32_t ROW_ID_SLOT = UINT32_MAX;
+
+  /** Larger rows would leave too few per leaf */
+  static constexpr size_t MAX_KEY_SIZE = PAGE_SIZE / 8;
+
+ private:
+  /** Primary key row followed by the row. */
+  void SerializeRow(const Row &row, GenericKey *key);
+
+  void SerializeKey(int32_t key_value, GenericKey *key);
+
+  Schema *table_schema_;
+  // table column of the primary key
+  uint32_t key_column_{0};
+};
+
+#endif  // MINISQL_CLUSTERED_INDEX_H
@@ -0,0 +1,67 @@
+#ifndef MINISQL_EXTENDIBLE_HASH_TABLE_H
+#define MINISQL_EXTENDIBLE_HASH_TABLE_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "concurrency/txn.h"
+#include "index/generic_key.h"
+#include "page/hash_table_bucket_page.h"
+#include "page/hash_table_directory_page.h"
+
+/**
+ * Disk-backed extendible hash table mapping keys to row ids.
+ *
+ * (1) The directory page is registered in the index roots page like a b+ tree root
+ * (2) A full bucket splits and the directory doubles when needed; a bucket that
+ *     becomes empty merges into its split image and the directory shrinks
+ * (3) Keys are compared bytewise as serialized by the KeyManager. Equality lookups
+ *     only look at the row part, so non-unique keys with a row id suffix work too
+ * (4) Buckets at the maximum depth chain overflow pages, e.g. for heavily duplicated keys
+ */
+class ExtendibleHashTable {
+ public:
+  explicit ExtendibleHashTable(index_id_t index_id, BufferPoolManager *buffer_pool_manager, const KeyManager &KM);
+
+  // Returns true if this hash table has no pages.
+  bool IsEmpty() const;
+
+  // Insert a key-value pair, return false for a duplicate key.
+  bool Insert(GenericKey *key, const RowId &value, Txn *transaction = nullptr);
+
+  // Remove a key and its value.
+  void Remove(const GenericKey *key, Txn *transaction = nullptr);
+
+  // Collect the values of all keys whose columns equal those of key.
+  bool GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction = nullptr);
+
+  // destroy the hash table
+  void Destroy();
+
+  // used to check whether all pages are unpinned
+  bool Check();
+
+  uint32_t GetGlobalDepth();
+
+  // number of pages used by the hash table
+  int GetPageCount();
+
+ private:
+  uint32_t Hash(const GenericKey *key) const;
+
+  void StartNewTable();
+
+  void SplitBucket(HashTableDirectoryPage *directory, uint32_t bucket_idx, HashTableBucketPage *bucket);
+
+  void MergeBucket(HashTableDirectoryPage *directory, uint32_t bucket_idx);
+
+  void UpdateRootPageId(int insert_record = 0);
+
+  // member variable
+  index_id_t index_id_;
+  page_id_t directory_page_id_{INVALID_PAGE_ID};
+  BufferPoolManager *buffer_pool_manager_;
+  KeyManager processor_;
+};
+
+#endif  // MINISQL_EXTENDIBLE_HASH_TABLE_H
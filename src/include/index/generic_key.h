@@ -1,6 +1,8 @@
 #ifndef MINISQL_GENERIC_KEY_H
 #define MINISQL_GENERIC_KEY_H
 
+#include <cstdint>
+#include <algorithm>
 #include <cstring>
 
 #include "record/field.h"
@@ -21,7 +23,7 @@ class KeyManager {
     // initialize to 0
     [[maybe_unused]] uint32_t size = key.GetSerializedSize(schema);
     ASSERT(key.GetFieldCount() == schema->GetColumnCount(), "field nums not match.");
-    ASSERT(size <= (uint32_t)key_size_, "Index key size exceed max key size.");
+    ASSERT(size <= (uint32_t)GetRowSpace(), "Index key size exceed max key size.");
     memset(key_buf->data, 0, key_size_);
     key.SerializeTo(key_buf->data, schema);
   }
@@ -34,41 +36,224 @@ class KeyManager {
   // compare
   [[nodiscard]] inline int CompareKeys(const GenericKey *lhs, const GenericKey *rhs) const {
     //    ASSERT(malloc_usable_size((void *)&lhs) == malloc_usable_size((void *)&rhs), "key size not match.");
+    int32_t lhs_int, rhs_int;
+    if (GetIntKey(lhs, lhs_int) && GetIntKey(rhs, rhs_int)) {
+      // 单个int列的非null key直接比较值，不用反序列化成Row
+      if (lhs_int != rhs_int) {
+        return lhs_int < rhs_int ? -1 : 1;
+      }
+    } else {
+      uint32_t column_count = key_schema_->GetColumnCount();
+      Row lhs_key(INVALID_ROWID);
+      Row rhs_key(INVALID_ROWID);
+      DeserializeToKey(lhs, lhs_key, key_schema_);
+      DeserializeToKey(rhs, rhs_key, key_schema_);
+
+      for (uint32_t i = 0; i < column_count; i++) {
+        Field *lhs_value = lhs_key.GetField(i);
+        Field *rhs_value = rhs_key.GetField(i);
+
+        // null排在所有值之前，与ArtIndex::EncodeKey的字节序一致
+        if (lhs_value->IsNull() || rhs_value->IsNull()) {
+          if (lhs_value->IsNull() != rhs_value->IsNull()) {
+            return lhs_value->IsNull() ? -1 : 1;
+          }
+          continue;
+        }
+
+        if (lhs_value->CompareLessThan(*rhs_value) == CmpBool::kTrue) {
+          return -1;
+        }
+
+        if (lhs_value->CompareGreaterThan(*rhs_value) == CmpBool::kTrue) {
+          return 1;
+        }
+      }
+    }
+    // 非唯一索引：字段相同时按row id后缀排序
+    if (!unique_) {
+      int64_t lhs_rid = GetRowIdSuffix(lhs);
+      int64_t rhs_rid = GetRowIdSuffix(rhs);
+      if (lhs_rid != rhs_rid) {
+        return lhs_rid < rhs_rid ? -1 : 1;
+      }
+    }
+    // equals
+    return 0;
+  }
+
+  /**
+   * Build the shortest separator sep with left < sep <= right (suffix truncation). The first
+   * field in which the keys differ is cut to the shortest prefix of right's value that is still
+   * greater than left's value and the fields after it are stored as null. Only char fields are
+   * truncated, otherwise right is copied as is (without its payload).
+   */
+  inline void ShortestSeparator(const GenericKey *left, const GenericKey *right, GenericKey *sep) const {
+    memcpy(sep->data, right->data, key_size_);
+    StripPayload(sep);
     uint32_t column_count = key_schema_->GetColumnCount();
     Row lhs_key(INVALID_ROWID);
     Row rhs_key(INVALID_ROWID);
-    DeserializeToKey(lhs, lhs_key, key_schema_);
-    DeserializeToKey(rhs, rhs_key, key_schema_);
-
+    DeserializeToKey(left, lhs_key, key_schema_);
+    DeserializeToKey(right, rhs_key, key_schema_);
     for (uint32_t i = 0; i < column_count; i++) {
       Field *lhs_value = lhs_key.GetField(i);
       Field *rhs_value = rhs_key.GetField(i);
-
-      if (lhs_value->CompareLessThan(*rhs_value) == CmpBool::kTrue) {
-        return -1;
+      if (lhs_value->CompareEquals(*rhs_value) == CmpBool::kTrue) {
+        continue;
       }
-
-      if (lhs_value->CompareGreaterThan(*rhs_value) == CmpBool::kTrue) {
-        return 1;
+      if (rhs_value->GetTypeId() != TypeId::kTypeChar || lhs_value->IsNull() || rhs_value->IsNull()) {
+        return;
+      }
+      uint32_t lhs_len = lhs_value->GetLength(), rhs_len = rhs_value->GetLength();
+      uint32_t len = 0;
+      while (len < lhs_len && len < rhs_len && lhs_value->GetData()[len] == rhs_value->GetData()[len]) {
+        len++;
+      }
+      // 第一个不同的字符也要保留
+      len++;
+      if (len >= rhs_len) {
+        return;
       }
+      std::vector<Field> fields;
+      for (uint32_t j = 0; j < column_count; j++) {
+        if (j < i) {
+          fields.emplace_back(*rhs_key.GetField(j));
+        } else if (j == i) {
+          fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(rhs_value->GetData()), len, true);
+        } else {
+          fields.emplace_back(key_schema_->GetColumn(j)->GetType());
+        }
+      }
+      SerializeFromKey(sep, Row(fields), key_schema_);
+      if (!unique_) {
+        SetRowIdSuffix(sep, MIN_ROWID_SUFFIX);
+      }
+      return;
+    }
+  }
+
+  /**
+   * Non-unique keys carry the row id in the last 8 bytes of the key buffer, which makes
+   * every entry in the tree distinct. Use MIN_ROWID_SUFFIX / MAX_ROWID_SUFFIX to build
+   * the lower / upper bound of all entries sharing the same column values.
+   */
+  inline void SetRowIdSuffix(GenericKey *key_buf, int64_t row_id) const {
+    ASSERT(!unique_, "Row id suffix is only used by non-unique keys.");
+    memcpy(key_buf->data + key_size_ - sizeof(int64_t), &row_id, sizeof(int64_t));
+  }
+
+  inline int64_t GetRowIdSuffix(const GenericKey *key_buf) const {
+    int64_t row_id;
+    memcpy(&row_id, key_buf->data + key_size_ - sizeof(int64_t), sizeof(int64_t));
+    return row_id;
+  }
+
+  /**
+   * Single int column keys are serialized as | magic (4) | null bitmap (4) | value (4) |, pages of
+   * such an index keep the values in a dense int32 array as well and search it with SIMD
+   * (see index/int_key_search.h).
+   */
+  inline bool IsIntKey() const { return int_key_ && int_search_; }
+
+  /** Turn the int search array of new pages on or off, e.g. to compare both layouts. */
+  inline void SetIntSearch(bool enable) { int_search_ = enable; }
+
+  /** @return `false` if the key is null or not a single int column key */
+  inline bool GetIntKey(const GenericKey *key_buf, int32_t &value) const {
+    return int_key_ && ReadIntKey(key_buf->data, GetRowSpace(), value);
+  }
+
+  /** @return Whether the first column of the key is null, such keys sort before all others */
+  inline bool IsFirstFieldNull(const GenericKey *key_buf) const {
+    uint32_t null_bitmap;
+    memcpy(&null_bitmap, key_buf->data + sizeof(uint32_t), sizeof(uint32_t));
+    return (null_bitmap & 1) != 0;
+  }
+
+  /** Read the int value from the first row_len bytes of a serialized single int key, missing bytes are 0. */
+  static inline bool ReadIntKey(const char *row, int row_len, int32_t &value) {
+    char buf[INT_KEY_VALUE_OFFSET + sizeof(int32_t)] = {0};
+    memcpy(buf, row, std::min<int>(row_len, sizeof(buf)));
+    uint32_t null_bitmap;
+    memcpy(&null_bitmap, buf + INT_KEY_VALUE_OFFSET - sizeof(uint32_t), sizeof(uint32_t));
+    memcpy(&value, buf + INT_KEY_VALUE_OFFSET, sizeof(int32_t));
+    return null_bitmap == 0;
+  }
+
+  /**
+   * Keys of a clustered index carry the table row behind the key row, from byte payload_offset
+   * on (see ClusteredIndex). The payload takes no part in comparisons, and internal pages only
+   * need the key row of a separator.
+   */
+  inline bool HasPayload() const { return payload_offset_ > 0; }
+
+  inline char *GetPayload(GenericKey *key_buf) const { return key_buf->data + payload_offset_; }
+
+  inline const char *GetPayload(const GenericKey *key_buf) const { return key_buf->data + payload_offset_; }
+
+  inline void StripPayload(GenericKey *key_buf) const {
+    if (HasPayload()) {
+      memset(key_buf->data + payload_offset_, 0, GetRowSpace() - payload_offset_);
     }
-    // equals
-    return 0;
   }
 
   inline int GetKeySize() const { return key_size_; }
 
+  inline bool IsUnique() const { return unique_; }
+
+  /** Bytes available for the serialized key row. */
+  inline int GetRowSpace() const { return unique_ ? key_size_ : key_size_ - (int)sizeof(int64_t); }
+
   KeyManager(const KeyManager &other) {
     this->key_schema_ = other.key_schema_;
     this->key_size_ = other.key_size_;
+    this->unique_ = other.unique_;
+    this->int_key_ = other.int_key_;
+    this->int_search_ = other.int_search_;
+    this->payload_offset_ = other.payload_offset_;
   }
 
   // constructor
-  KeyManager(Schema *key_schema, size_t key_size) : key_size_(key_size), key_schema_(key_schema) {}
+  KeyManager(Schema *key_schema, size_t key_size, bool unique = true, int payload_offset = 0)
+      : key_size_(key_size), key_schema_(key_schema), unique_(unique), payload_offset_(payload_offset) {
+    int_key_ = key_schema->GetColumnCount() == 1 && key_schema->GetColumn(0)->GetType() == TypeId::kTypeInt;
+  }
+
+  static constexpr int64_t MIN_ROWID_SUFFIX = INT64_MIN;
+  static constexpr int64_t MAX_ROWID_SUFFIX = INT64_MAX;
+  static constexpr int INT_KEY_VALUE_OFFSET = 8;
 
  private:
   int key_size_;
   Schema *key_schema_;
+  bool unique_{true};
+  bool int_key_{false};
+  bool int_search_{true};
+  int payload_offset_{0};
+};
+
+/**
+ * KeyBuffer holds one key of key_size bytes, for the keys decoded out of b+ tree pages. Keys of
+ * at most INLINE_SIZE bytes live in the buffer itself, so a search over short keys does not allocate.
+ */
+class KeyBuffer {
+ public:
+  static constexpr int INLINE_SIZE = 128;
+
+  explicit KeyBuffer(int key_size) : heap_(key_size > INLINE_SIZE ? static_cast<char *>(malloc(key_size)) : nullptr) {}
+
+  ~KeyBuffer() { free(heap_); }
+
+  KeyBuffer(const KeyBuffer &) = delete;
+
+  KeyBuffer &operator=(const KeyBuffer &) = delete;
+
+  inline GenericKey *Get() { return reinterpret_cast<GenericKey *>(heap_ != nullptr ? heap_ : inline_); }
+
+ private:
+  char inline_[INLINE_SIZE];
+  char *heap_;
 };
 
 #endif  // MINISQL_GENERIC_KEY_H
@@ -2,6 +2,8 @@
 #define MINISQL_INDEX_H
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "common/dberr.h"
 #include "concurrency/txn.h"
@@ -17,10 +19,41 @@ class Index {
 
   virtual dberr_t RemoveEntry(const Row &key, RowId row_id, Txn *txn) = 0;
 
-  virtual dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, string compare_operator = "=") = 0;
+  virtual dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, std::string compare_operator = "=") = 0;
 
   virtual dberr_t Destroy() = 0;
 
+  /**
+   * Batched InsertEntry / RemoveEntry / ScanKey("="), indexes that can share work between the
+   * keys of a batch override them.
+   * @return DB_FAILED if any key was rejected as a duplicate, the other keys are inserted
+   */
+  virtual dberr_t InsertEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn) {
+    dberr_t result = DB_SUCCESS;
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (InsertEntry(keys[i], row_ids[i], txn) != DB_SUCCESS) {
+        result = DB_FAILED;
+      }
+    }
+    return result;
+  }
+
+  virtual dberr_t RemoveEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn) {
+    for (size_t i = 0; i < keys.size(); i++) {
+      RemoveEntry(keys[i], row_ids[i], txn);
+    }
+    return DB_SUCCESS;
+  }
+
+  /** results[i] holds the row ids of the entries equal to keys[i] */
+  virtual dberr_t LookupMany(const std::vector<Row> &keys, std::vector<std::vector<RowId>> &results, Txn *txn) {
+    results.assign(keys.size(), {});
+    for (size_t i = 0; i < keys.size(); i++) {
+      ScanKey(keys[i], results[i], txn, "=");
+    }
+    return DB_SUCCESS;
+  }
+
  protected:
   index_id_t index_id_;
   IndexSchema *key_schema_;
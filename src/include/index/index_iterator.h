@@ -1,6 +1,8 @@
 #ifndef MINISQL_INDEX_ITERATOR_H
 #define MINISQL_INDEX_ITERATOR_H
 
+#include <vector>
+
 #include "page/b_plus_tree_leaf_page.h"
 
 class IndexIterator {
@@ -12,9 +14,16 @@ class IndexIterator {
 
   explicit IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index = 0);
 
+  IndexIterator(const IndexIterator &other);
+
+  IndexIterator &operator=(const IndexIterator &other);
+
   ~IndexIterator();
 
-  /** Return the key/value pair this iterator is currently pointing at. */
+  /**
+   * Return the key/value pair this iterator is currently pointing at. The key is decoded into a
+   * buffer of the iterator and stays valid until the next dereference.
+   */
   std::pair<GenericKey *, RowId> operator*();
 
   /** Move to the next key/value pair.*/
@@ -26,12 +35,16 @@ class IndexIterator {
   /** Return whether two iterators are not equal. */
   bool operator!=(const IndexIterator &itr) const;
 
+  /** Leaf page of the current entry. */
+  page_id_t GetPageId() const { return current_page_id; }
+
  private:
   page_id_t current_page_id{INVALID_PAGE_ID};
   LeafPage *page{nullptr};
   int item_index{0};
   BufferPoolManager *buffer_pool_manager{nullptr};
   // add your own private member variables here
+  std::vector<char> key_;
 };
 
 #endif  // MINISQL_INDEX_ITERATOR_H
@@ -0,0 +1,31 @@
+#ifndef MINISQL_INT_KEY_SEARCH_H
+#define MINISQL_INT_KEY_SEARCH_H
+
+#include <cstdint>
+
+/**
+ * Lower bound over a sorted array of int32 keys stored unaligned in a page. The kernel is
+ * picked once at runtime from the instruction sets of the cpu (AVX2, SSE2 or plain scalar):
+ * a binary search narrows the range down to a small window, then the SIMD kernel counts the
+ * keys less than the target in the window without branches.
+ */
+class IntKeySearch {
+ public:
+  enum class Kernel { kScalar, kSSE, kAVX2 };
+
+  /** @return The first index i in [0, n) with keys[i] >= target, n if there is none */
+  static int LowerBound(const char *keys, int n, int32_t target);
+
+  /** @return The kernel in use */
+  static Kernel GetKernel();
+
+  /** Use the given kernel, or the best supported one below it. Used by tests and benchmarks. */
+  static Kernel SetKernel(Kernel kernel);
+
+  /** @return The best kernel supported by the cpu */
+  static Kernel DetectKernel();
+
+  static const char *KernelName(Kernel kernel);
+};
+
+#endif  // MINISQL_INT_KEY_SEARCH_H
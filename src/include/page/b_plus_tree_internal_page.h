@@ -7,6 +7,7 @@
 
 #include "index/generic_key.h"
 #include "page/b_plus_tree_page.h"
+#include "page/slotted_key_area.h"
 
 #define INTERNAL_PAGE_HEADER_SIZE 28
 /**
@@ -17,18 +18,21 @@
  * the first key always remains invalid. That is to say, any search/lookup
  * should ignore the first key.
  *
- * Internal page format (keys are stored in increasing order):
- *  --------------------------------------------------------------------------
- * | HEADER | KEY(1)+PAGE_ID(1) | KEY(2)+PAGE_ID(2) | ... | KEY(n)+PAGE_ID(n) |
- *  --------------------------------------------------------------------------
+ * Internal page format (keys are stored in increasing order, see page/slotted_key_area.h):
+ *  ----------------------------------------------------------------------------------
+ * | HEADER | AREA HEADER | PREFIX | SLOT(1)+PAGE_ID(1) | ... | FREE | KEY(n) ... KEY(1) |
+ *  ----------------------------------------------------------------------------------
+ * Separator keys pushed up from leaf splits are suffix truncated (see
+ * KeyManager::ShortestSeparator), and the bytes shared by all keys are stored once.
  */
 class BPlusTreeInternalPage : public BPlusTreePage {
  public:
   // must call initialize method after "create" a new node
   void Init(page_id_t page_id, page_id_t parent_id = INVALID_PAGE_ID, int key_size = UNDEFINED_SIZE,
-            int max_size = UNDEFINED_SIZE);
+            int max_size = UNDEFINED_SIZE, int key_tail = 0, bool int_keys = false);
 
-  GenericKey *KeyAt(int index);
+  /** Decode the key at index into key, a buffer of key size bytes, and return it */
+  GenericKey *KeyAt(int index, GenericKey *key);
 
   void SetKeyAt(int index, GenericKey *key);
 
@@ -38,12 +42,11 @@ class BPlusTreeInternalPage : public BPlusTreePage {
 
   void SetValueAt(int index, page_id_t value);
 
-  void *PairPtrAt(int index);
-
-  void PairCopy(void *dest, void *src, int pair_num = 1);
-
   page_id_t Lookup(const GenericKey *key, const KeyManager &KP);
 
+  // index of the child that key belongs to
+  int LookupIndex(const GenericKey *key, const KeyManager &KP);
+
   void PopulateNewRoot(const page_id_t &old_value, GenericKey *new_key, const page_id_t &new_value);
 
   int InsertNodeAfter(const page_id_t &old_value, GenericKey *new_key, const page_id_t &new_value);
@@ -52,6 +55,19 @@ class BPlusTreeInternalPage : public BPlusTreePage {
 
   page_id_t RemoveAndReturnOnlyChild();
 
+  // space management
+  bool HasRoomFor(const GenericKey *key);
+
+  bool CanReplaceKeyAt(int index, const GenericKey *key);
+
+  bool CanPrependWith(const GenericKey *first_key, const GenericKey *old_first_key);
+
+  bool IsUnderflow();
+
+  bool CanMergeWith(BPlusTreeInternalPage *other, GenericKey *middle_key);
+
+  int GetUsedBytes();
+
   // Split and Merge utility methods
   void MoveAllTo(BPlusTreeInternalPage *recipient, GenericKey *middle_key, BufferPoolManager *buffer_pool_manager);
 
@@ -62,7 +78,9 @@ class BPlusTreeInternalPage : public BPlusTreePage {
   void MoveLastToFrontOf(BPlusTreeInternalPage *recipient, GenericKey *middle_key, BufferPoolManager *buffer_pool_manager);
 
  private:
-  void CopyNFrom(void *src, int size, BufferPoolManager *buffer_pool_manager);
+  SlottedKeyArea Area() { return SlottedKeyArea(this, data_, sizeof(data_), sizeof(page_id_t)); }
+
+  void CopyNFrom(const std::vector<SlottedKeyArea::Item> &items, BufferPoolManager *buffer_pool_manager);
 
   void CopyLastFrom(GenericKey *key, page_id_t value, BufferPoolManager *buffer_pool_manager);
 
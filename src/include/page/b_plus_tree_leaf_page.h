@@ -6,26 +6,30 @@
  *
  * Store indexed key and record id(record id = page id combined with slot id,
  * see include/common/rid.h for detailed implementation) together within leaf
- * page. Only support unique key.
+ * page. Keys are unique within the tree (see KeyManager for non-unique indexes).
 
- * Leaf page format (keys are stored in order):
- *  ----------------------------------------------------------------------
- * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
- *  ----------------------------------------------------------------------
+ * Leaf page format (keys are stored in order, see page/slotted_key_area.h):
+ *  ----------------------------------------------------------------------------
+ * | HEADER | AREA HEADER | PREFIX | SLOT(1)+RID(1) | ... | FREE | KEY(n) ... KEY(1) |
+ *  ----------------------------------------------------------------------------
  *
- *  Header format (size in byte, 24 bytes in total):
+ *  Header format (size in byte, 32 bytes in total):
  *  ---------------------------------------------------------------------
- * | PageType (4) | CurrentSize (4) | MaxSize (4) | ParentPageId (4) |
+ * | PageType (4) | KeySize (4) | LSN (4) | CurrentSize (4) | MaxSize (4) |
  *  ---------------------------------------------------------------------
- *  ------------------------------
- * | PageId (4) | NextPageId (4)
- *  ------------------------------
+ *  ---------------------------------------------------
+ * | ParentPageId (4) | PageId (4) | NextPageId (4)
+ *  ---------------------------------------------------
+ *
+ * Keys are variable length, so a page is full when it runs out of bytes. MaxSize
+ * optionally caps the number of entries (UNDEFINED_SIZE means no cap).
  */
 #include <utility>
 #include <vector>
 
 #include "index/generic_key.h"
 #include "page/b_plus_tree_page.h"
+#include "page/slotted_key_area.h"
 
 #define LEAF_PAGE_HEADER_SIZE 32
 
@@ -33,14 +37,16 @@ class BPlusTreeLeafPage : public BPlusTreePage {
  public:
   // After creating a new leaf page from buffer pool, must call initialize
   // method to set default values
-  void Init(page_id_t page_id, page_id_t parent_id = INVALID_PAGE_ID, int key_size = UNDEFINED_SIZE, int max_size = UNDEFINED_SIZE);
+  void Init(page_id_t page_id, page_id_t parent_id = INVALID_PAGE_ID, int key_size = UNDEFINED_SIZE, int max_size = UNDEFINED_SIZE,
+            int key_tail = 0, bool int_keys = false);
 
   // helper methods
   page_id_t GetNextPageId() const;
 
   void SetNextPageId(page_id_t next_page_id);
 
-  GenericKey *KeyAt(int index);
+  /** Decode the key at index into key, a buffer of key size bytes, and return it */
+  GenericKey *KeyAt(int index, GenericKey *key);
 
   void SetKeyAt(int index, GenericKey *key);
 
@@ -50,11 +56,18 @@ class BPlusTreeLeafPage : public BPlusTreePage {
 
   int KeyIndex(const GenericKey *key, const KeyManager &comparator);
 
-  void *PairPtrAt(int index);
+  std::pair<GenericKey *, RowId> GetItem(int index, GenericKey *key);
+
+  // space management
+  bool HasRoomFor(const GenericKey *key);
+
+  bool IsUnderflow();
 
-  void PairCopy(void *dest, void *src, int pair_num = 1);
+  bool CanMergeWith(BPlusTreeLeafPage *other);
 
-  std::pair<GenericKey *, RowId> GetItem(int index);
+  int GetUsedBytes();
+
+  int GetPrefixLength();
 
   // insert and delete methods
   int Insert(GenericKey *key, const RowId &value, const KeyManager &comparator);
@@ -73,7 +86,9 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   void MoveLastToFrontOf(BPlusTreeLeafPage *recipient);
 
  private:
-  void CopyNFrom(void *src, int size);
+  SlottedKeyArea Area() { return SlottedKeyArea(this, data_, sizeof(data_), sizeof(RowId)); }
+
+  void CopyNFrom(const std::vector<SlottedKeyArea::Item> &items);
 
   void CopyLastFrom(GenericKey *key, const RowId value);
 
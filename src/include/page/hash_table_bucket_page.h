@@ -0,0 +1,61 @@
+#ifndef MINISQL_HASH_TABLE_BUCKET_PAGE_H
+#define MINISQL_HASH_TABLE_BUCKET_PAGE_H
+
+#include "common/config.h"
+#include "common/rowid.h"
+#include "index/generic_key.h"
+
+#define HASH_BUCKET_PAGE_HEADER_SIZE 16
+
+/**
+ * Bucket page of the extendible hash index. Entries are unordered and stored densely,
+ * a removed entry is replaced by the last one. A bucket whose local depth can not grow
+ * any more keeps further entries in a chain of overflow pages.
+ *
+ * Format (size in byte):
+ *  ----------------------------------------------------------------------------
+ * | PageId (4) | NextPageId (4) | KeySize (4) | CurrentSize (4) |
+ *  ----------------------------------------------------------------------------
+ * | KEY(0) | RID(0) | KEY(1) | RID(1) | ... | KEY(n-1) | RID(n-1) | FREE SPACE |
+ *  ----------------------------------------------------------------------------
+ */
+class HashTableBucketPage {
+ public:
+  void Init(page_id_t page_id, int key_size);
+
+  page_id_t GetPageId() const;
+
+  page_id_t GetNextPageId() const;
+
+  void SetNextPageId(page_id_t next_page_id);
+
+  int GetSize() const;
+
+  int GetMaxSize() const;
+
+  bool IsFull() const;
+
+  bool IsEmpty() const;
+
+  GenericKey *KeyAt(int index);
+
+  RowId ValueAt(int index) const;
+
+  /** Index of the entry whose first len key bytes equal those of key, starting from begin, -1 if none. */
+  int Find(const GenericKey *key, int len, int begin = 0);
+
+  void Append(const GenericKey *key, const RowId &value);
+
+  void RemoveAt(int index);
+
+ private:
+  char *EntryAt(int index);
+
+  page_id_t page_id_;
+  page_id_t next_page_id_;
+  int key_size_;
+  int size_;
+  char data_[PAGE_SIZE - HASH_BUCKET_PAGE_HEADER_SIZE];
+};
+
+#endif  // MINISQL_HASH_TABLE_BUCKET_PAGE_H
@@ -0,0 +1,60 @@
+#ifndef MINISQL_HASH_TABLE_DIRECTORY_PAGE_H
+#define MINISQL_HASH_TABLE_DIRECTORY_PAGE_H
+
+#include <cstdint>
+
+#include "common/config.h"
+
+#define HASH_DIRECTORY_ARRAY_SIZE 512
+#define HASH_MAX_GLOBAL_DEPTH 9
+
+/**
+ * Directory page of the extendible hash index. Slot i of the directory points to the
+ * bucket page holding the keys whose lowest global_depth hash bits equal i; several
+ * slots share one bucket when the local depth of the bucket is smaller.
+ *
+ * Format (size in byte):
+ *  -----------------------------------------------------------------------------
+ * | PageId (4) | GlobalDepth (4) | LocalDepths (512) | BucketPageIds (2048) |
+ *  -----------------------------------------------------------------------------
+ */
+class HashTableDirectoryPage {
+ public:
+  void Init(page_id_t page_id, page_id_t bucket_page_id);
+
+  page_id_t GetPageId() const;
+
+  page_id_t GetBucketPageId(uint32_t bucket_idx) const;
+
+  void SetBucketPageId(uint32_t bucket_idx, page_id_t bucket_page_id);
+
+  /** The slot that shares all but the highest local depth bit with bucket_idx. */
+  uint32_t GetSplitImageIndex(uint32_t bucket_idx) const;
+
+  uint32_t GetGlobalDepth() const;
+
+  uint32_t GetGlobalDepthMask() const;
+
+  uint32_t GetLocalDepth(uint32_t bucket_idx) const;
+
+  void SetLocalDepth(uint32_t bucket_idx, uint32_t local_depth);
+
+  /** Double the directory, the new upper half mirrors the lower half. */
+  void IncrGlobalDepth();
+
+  void DecrGlobalDepth();
+
+  /** Whether every local depth is below the global depth, so that the directory can be halved. */
+  bool CanShrink() const;
+
+  /** Number of slots in use. */
+  uint32_t Size() const;
+
+ private:
+  page_id_t page_id_;
+  uint32_t global_depth_;
+  uint8_t local_depths_[HASH_DIRECTORY_ARRAY_SIZE];
+  page_id_t bucket_page_ids_[HASH_DIRECTORY_ARRAY_SIZE];
+};
+
+#endif  // MINISQL_HASH_TABLE_DIRECTORY_PAGE_H
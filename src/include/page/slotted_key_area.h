@@ -0,0 +1,155 @@
+#ifndef MINISQL_SLOTTED_KEY_AREA_H
+#define MINISQL_SLOTTED_KEY_AREA_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "index/generic_key.h"
+#include "page/b_plus_tree_page.h"
+
+/**
+ * slotted_key_area.h
+ *
+ * Variable-length key storage shared by leaf and internal pages. A GenericKey is a
+ * fixed key_size buffer holding a serialized row padded with zeros (plus an optional
+ * tail such as the row id suffix of a non-unique index). Only the significant bytes
+ * are stored, and the bytes shared by every key of the page are stored once.
+ *
+ * Area format (the data part of a b+ tree page, after the page header):
+ *  ----------------------------------------------------------------------------------------
+ * | AREA HEADER | PREFIX | [INT(0) ... INT(n-1)] | SLOT(0) | ... | SLOT(n-1) | FREE | ENTRIES |
+ *  ----------------------------------------------------------------------------------------
+ *  Area header (10 bytes):
+ *  --------------------------------------------------------------------------
+ * | PrefixLen (2) | TailSize (2) | HeapTop (2) | FragBytes (2) | Flags (2) |
+ *  --------------------------------------------------------------------------
+ *  Slot: | EntryOffset (2) | EntryLen (2) | Value (value_size) |
+ *
+ * An entry holds the row bytes of the key after the page prefix with the zero padding
+ * trimmed, followed by TailSize verbatim bytes. Entries grow downwards from the end of the
+ * page. KeyAt() decodes a key into a buffer of the caller, reading a key leaves the page as is.
+ *
+ * Pages of a single int column index (INT_KEYS flag) also keep the key values in a dense
+ * int32 array in front of the slots, so a search runs over contiguous keys with SIMD
+ * instead of decoding a row per probe. Slots without a key and null keys store INT32_MIN,
+ * a page that has seen a null key (NULL_KEY flag) falls back to the generic search.
+ */
+class SlottedKeyArea {
+ public:
+  /** Key and value of one slot, with the key in its page independent compact form. */
+  struct Item {
+    std::string key;
+    bool has_key{true};
+    int64_t value{0};
+  };
+
+  static constexpr int AREA_HEADER_SIZE = 10;
+
+  SlottedKeyArea(BPlusTreePage *page, char *data, int data_size, int value_size)
+      : page_(page), data_(data), data_size_(data_size), value_size_(value_size) {}
+
+  void Init(int tail_size, bool int_keys = false);
+
+  /**
+   * Decode the key at index into key, a buffer of key size bytes.
+   * @return key
+   */
+  GenericKey *KeyAt(int index, GenericKey *key) const;
+
+  bool HasKey(int index) const;
+
+  void ValueAt(int index, void *value) const;
+
+  void SetValueAt(int index, const void *value);
+
+  /** Compact form of a full key, independent of the page prefix. */
+  std::string Encode(const GenericKey *key) const;
+
+  void InsertAt(int index, const std::string &key, const void *value, bool has_key = true);
+
+  void RemoveAt(int index);
+
+  void SetKeyAt(int index, const std::string &key);
+
+  /** Copy out the items [begin, end). */
+  std::vector<Item> Items(int begin, int end) const;
+
+  /** Rewrite the area with the given items, choosing the longest common prefix. */
+  void Rebuild(const std::vector<Item> &items);
+
+  /** Bytes needed after inserting key (including prefix shrinking). */
+  int InsertCost(const std::string &key) const;
+
+  /** Bytes needed to store the items in an empty area. */
+  int RequiredBytes(const std::vector<Item> &items) const;
+
+  int GetCapacity() const;
+
+  int GetUsedBytes() const;
+
+  int GetFreeBytes() const { return GetCapacity() - GetUsedBytes(); }
+
+  int GetPrefixLen() const;
+
+  /** @return Whether searches can use the int key array of this page */
+  bool CanSearchInt() const;
+
+  /**
+   * Find the slots in [begin, end) whose int key equals target.
+   * @param[out] lo The first slot with int key >= target
+   * @param[out] hi The first slot with int key > target
+   */
+  void IntEqualRange(int32_t target, int begin, int end, int &lo, int &hi) const;
+
+ private:
+  static constexpr int OFFSET_PREFIX_LEN = 0;
+  static constexpr int OFFSET_TAIL_SIZE = 2;
+  static constexpr int OFFSET_HEAP_TOP = 4;
+  static constexpr int OFFSET_FRAG_BYTES = 6;
+  static constexpr int OFFSET_FLAGS = 8;
+  /** EntryLen of a slot without a key */
+  static constexpr uint16_t NO_KEY = 0xFFFF;
+  static constexpr uint16_t INT_KEYS = 1;
+  static constexpr uint16_t NULL_KEY = 2;
+
+  uint16_t Flags() const;
+
+  void SetFlags(uint16_t flags);
+
+  /** Bytes of int key array used by one slot. */
+  int IntSize() const { return (Flags() & INT_KEYS) != 0 ? sizeof(int32_t) : 0; }
+
+  /** Slot plus int key bytes of one entry. */
+  int EntrySize() const { return SlotSize() + IntSize(); }
+
+  int IntOff(int index) const { return AREA_HEADER_SIZE + GetPrefixLen() + index * sizeof(int32_t); }
+
+  /** Store the int key of a compact key at index, marking the page if the key is null. */
+  void WriteIntKey(int index, const std::string &key, bool has_key);
+
+  uint16_t Read16(int off) const;
+
+  void Write16(int off, uint16_t v);
+
+  int SlotSize() const { return 4 + value_size_; }
+
+  int SlotOff(int index) const {
+    return AREA_HEADER_SIZE + GetPrefixLen() + page_->GetSize() * IntSize() + index * SlotSize();
+  }
+
+  int HeapEnd() const { return data_size_; }
+
+  int TailSize() const;
+
+  int KeyedCount() const;
+
+  static int CommonPrefix(const char *a, int a_len, const char *b, int b_len);
+
+  BPlusTreePage *page_;
+  char *data_;
+  int data_size_;
+  int value_size_;
+};
+
+#endif  // MINISQL_SLOTTED_KEY_AREA_H
@@ -24,6 +24,7 @@
 #include "concurrency/lock_manager.h"
 #include "concurrency/txn.h"
 #include "page/page.h"
+#include "record/data_chunk.h"
 #include "record/row.h"
 #include "recovery/log_manager.h"
 
@@ -58,6 +59,17 @@ class TablePage : public Page {
 
   bool GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager);
 
+  /** Decode the tuple of rid into chunk, @return false if it does not exist */
+  bool GetTuple(const RowId &rid, DataChunk *chunk);
+
+  /**
+   * Decode the live tuples from slot_num on into chunk until it is full.
+   * @return The slot after the last one read, GetTupleCount() once the page is done
+   */
+  uint32_t ScanTuples(uint32_t slot_num, DataChunk *chunk);
+
+  inline uint32_t GetSlotCount() { return GetTupleCount(); }
+
   bool GetFirstTupleRid(RowId *first_rid);
 
   bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid);
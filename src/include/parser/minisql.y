@@ -7,6 +7,8 @@
   int yyerror(char* error);
 %}
 
+%define api.header.include {"parser/minisql_yacc.h"}
+
 %union {
 	pSyntaxNode syntax_node;
 }
@@ -16,6 +18,8 @@
 %token <syntax_node> DATABASE DATABASES TABLE TABLES INDEX INDEXES
 %token <syntax_node> ON FROM WHERE INTO SET VALUES PRIMARY KEY UNIQUE
 %token <syntax_node> CHAR INT FLOAT AND OR NOT IS FLAGNULL
+%token <syntax_node> GROUP ORDER BY ASC DESC LIMIT OFFSET ANALYZE EXPLAIN JOIN
+%token <syntax_node> COUNT SUM MIN MAX AVG
 %token <syntax_node> IDENTIFIER STRING NUMBER EQ NE LE GE
 
 %type <syntax_node> start sql
@@ -24,10 +28,12 @@
 %type <syntax_node> column_definition_list column_definition column_type column_list
 %type <syntax_node> sql_create_index sql_drop_index sql_show_indexes
 %type <syntax_node> sql_trx_begin sql_trx_commit sql_trx_rollback
-%type <syntax_node> sql_select select_columns column_values column_value operator
+%type <syntax_node> sql_select select_columns select_list select_item aggregate_function
+%type <syntax_node> select_clauses order_by_limit limit_clause group_by_list order_by_list order_by_item
+%type <syntax_node> from_tables identifier column_name column_values column_value operator
 %type <syntax_node> connector where_conditions where_condition
 %type <syntax_node> sql_insert sql_delete sql_update update_values update_value
-%type <syntax_node> sql_quit sql_exec_file
+%type <syntax_node> sql_quit sql_exec_file sql_analyze sql_explain explainable sql_set
 
 %%
 
@@ -58,17 +64,20 @@ sql:
   | sql_trx_rollback { $$ = $1; }
   | sql_quit { $$ = $1; }
   | sql_exec_file { $$ = $1; }
+  | sql_analyze { $$ = $1; }
+  | sql_explain { $$ = $1; }
+  | sql_set { $$ = $1; }
   ;
 
 sql_create_database:
-  CREATE DATABASE IDENTIFIER {
+  CREATE DATABASE identifier {
     $$ = CreateSyntaxNode(kNodeCreateDB, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
   ;
 
 sql_drop_database:
-  DROP DATABASE IDENTIFIER {
+  DROP DATABASE identifier {
     $$ = CreateSyntaxNode(kNodeDropDB, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
@@ -81,7 +90,7 @@ sql_show_databases:
   ;
 
 sql_use_database:
-  USE IDENTIFIER {
+  USE identifier {
     $$ = CreateSyntaxNode(kNodeUseDB, NULL);
     SyntaxNodeAddChildren($$, $2);
   }
@@ -94,21 +103,31 @@ sql_show_tables:
   ;
 
 sql_create_table:
-  CREATE TABLE IDENTIFIER '(' column_definition_list ')' {
+  CREATE TABLE identifier '(' column_definition_list ')' {
     $$ = CreateSyntaxNode(kNodeCreateTable, NULL);
     pSyntaxNode list_node = CreateSyntaxNode(kNodeColumnDefinitionList, NULL);
     SyntaxNodeAddChildren(list_node, $5);
     SyntaxNodeAddChildren($$, $3);
     SyntaxNodeAddChildren($$, list_node);
   }
+  | CREATE TABLE identifier '(' column_definition_list ')' IDENTIFIER {
+    $$ = CreateSyntaxNode(kNodeCreateTable, NULL);
+    pSyntaxNode list_node = CreateSyntaxNode(kNodeColumnDefinitionList, NULL);
+    SyntaxNodeAddChildren(list_node, $5);
+    SyntaxNodeAddChildren($$, $3);
+    SyntaxNodeAddChildren($$, list_node);
+    pSyntaxNode option_node = CreateSyntaxNode(kNodeTableOption, "table option");
+    SyntaxNodeAddChildren(option_node, $7);
+    SyntaxNodeAddChildren($$, option_node);
+  }
   ;
 
 column_list:
-  IDENTIFIER ',' column_list {
+  identifier ',' column_list {
     $$ = $1;
     SyntaxNodeAddSibling($$, $3);
   }
-  | IDENTIFIER {
+  | identifier {
     $$ = $1;
   }
   ;
@@ -128,12 +147,12 @@ column_definition_list:
   ;
 
 column_definition:
-  IDENTIFIER column_type UNIQUE {
+  identifier column_type UNIQUE {
     $$ = CreateSyntaxNode(kNodeColumnDefinition, "unique");
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $2);
   }
-  | IDENTIFIER column_type {
+  | identifier column_type {
     $$ = CreateSyntaxNode(kNodeColumnDefinition, NULL);
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $2);
@@ -153,15 +172,63 @@ column_type:
   }
   ;
 
+sql_analyze:
+  ANALYZE identifier {
+    $$ = CreateSyntaxNode(kNodeAnalyze, NULL);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  ;
+
+sql_explain:
+  EXPLAIN explainable {
+    $$ = CreateSyntaxNode(kNodeExplain, NULL);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  ;
+
+explainable:
+  sql_select { $$ = $1; }
+  | sql_insert { $$ = $1; }
+  | sql_delete { $$ = $1; }
+  | sql_update { $$ = $1; }
+  ;
+
+/* 会话设置，如set parallelism = 4、set output = tsv，名字和值由执行引擎检查 */
+sql_set:
+  SET IDENTIFIER EQ NUMBER {
+    $$ = CreateSyntaxNode(kNodeSet, NULL);
+    SyntaxNodeAddChildren($$, $2);
+    SyntaxNodeAddSibling($2, $4);
+  }
+  | SET IDENTIFIER EQ IDENTIFIER {
+    $$ = CreateSyntaxNode(kNodeSet, NULL);
+    SyntaxNodeAddChildren($$, $2);
+    SyntaxNodeAddSibling($2, $4);
+  }
+  /* table是关键字，set output = table时作为值 */
+  | SET IDENTIFIER EQ TABLE {
+    $$ = CreateSyntaxNode(kNodeSet, NULL);
+    SyntaxNodeAddChildren($$, $2);
+    SyntaxNodeAddSibling($2, CreateSyntaxNode(kNodeIdentifier, "table"));
+  }
+  /* 索引的设置，如set pinned_levels = 2 on t_id，第三个孩子是索引名 */
+  | SET IDENTIFIER EQ NUMBER ON identifier {
+    $$ = CreateSyntaxNode(kNodeSet, NULL);
+    SyntaxNodeAddChildren($$, $2);
+    SyntaxNodeAddSibling($2, $4);
+    SyntaxNodeAddSibling($4, $6);
+  }
+  ;
+
 sql_drop_table:
-  DROP TABLE IDENTIFIER {
+  DROP TABLE identifier {
     $$ = CreateSyntaxNode(kNodeDropTable, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
   ;
 
 sql_create_index:
-  CREATE INDEX IDENTIFIER ON IDENTIFIER '(' column_list ')' {
+  CREATE INDEX identifier ON identifier '(' column_list ')' {
     $$ = CreateSyntaxNode(kNodeCreateIndex, NULL);
     SyntaxNodeAddChildren($$, $3);
     SyntaxNodeAddChildren($$, $5);
@@ -169,7 +236,7 @@ sql_create_index:
     SyntaxNodeAddChildren(index_keys_node, $7);
     SyntaxNodeAddChildren($$, index_keys_node);
   }
-  | CREATE INDEX IDENTIFIER ON IDENTIFIER '(' column_list ')' USING IDENTIFIER {
+  | CREATE INDEX identifier ON identifier '(' column_list ')' USING IDENTIFIER {
       $$ = CreateSyntaxNode(kNodeCreateIndex, NULL);
       SyntaxNodeAddChildren($$, $3);
       SyntaxNodeAddChildren($$, $5);
@@ -183,7 +250,7 @@ sql_create_index:
   ;
 
 sql_drop_index:
-  DROP INDEX IDENTIFIER {
+  DROP INDEX identifier {
     $$ = CreateSyntaxNode(kNodeDropIndex, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
@@ -196,18 +263,131 @@ sql_show_indexes:
   ;
 
 sql_select:
-  SELECT select_columns FROM IDENTIFIER {
+  SELECT select_columns FROM from_tables select_clauses {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
+    if ($5 != NULL) {
+      SyntaxNodeAddChildren($$, $5);
+    }
   }
-  | SELECT select_columns FROM IDENTIFIER WHERE where_conditions {
+  | SELECT select_columns FROM from_tables WHERE where_conditions select_clauses {
     $$ = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren($$, $2);
     SyntaxNodeAddChildren($$, $4);
     pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
     SyntaxNodeAddChildren(condition_node, $6);
     SyntaxNodeAddChildren($$, condition_node);
+    if ($7 != NULL) {
+      SyntaxNodeAddChildren($$, $7);
+    }
+  }
+  ;
+
+/* FROM和WHERE之后依次是group by、order by和limit子句，都可以省略，全部省略时为NULL */
+select_clauses:
+  order_by_limit {
+    $$ = $1;
+  }
+  | GROUP BY group_by_list order_by_limit {
+    $$ = CreateSyntaxNode(kNodeGroupBy, NULL);
+    SyntaxNodeAddChildren($$, $3);
+    if ($4 != NULL) {
+      SyntaxNodeAddSibling($$, $4);
+    }
+  }
+  ;
+
+order_by_limit:
+  limit_clause {
+    $$ = $1;
+  }
+  | ORDER BY order_by_list limit_clause {
+    $$ = CreateSyntaxNode(kNodeOrderBy, NULL);
+    SyntaxNodeAddChildren($$, $3);
+    if ($4 != NULL) {
+      SyntaxNodeAddSibling($$, $4);
+    }
+  }
+  ;
+
+limit_clause:
+  /* empty */ {
+    $$ = NULL;
+  }
+  | LIMIT NUMBER {
+    $$ = CreateSyntaxNode(kNodeLimit, NULL);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  | LIMIT NUMBER OFFSET NUMBER {
+    $$ = CreateSyntaxNode(kNodeLimit, NULL);
+    SyntaxNodeAddChildren($$, $2);
+    pSyntaxNode offset_node = CreateSyntaxNode(kNodeOffset, NULL);
+    SyntaxNodeAddChildren(offset_node, $4);
+    SyntaxNodeAddSibling($$, offset_node);
+  }
+  ;
+
+group_by_list:
+  column_name ',' group_by_list {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | column_name {
+    $$ = $1;
+  }
+  ;
+
+order_by_list:
+  order_by_item ',' order_by_list {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | order_by_item {
+    $$ = $1;
+  }
+  ;
+
+/* 排序方向作为列的子节点 */
+order_by_item:
+  column_name {
+    $$ = $1;
+  }
+  | column_name ASC {
+    $$ = $1;
+    SyntaxNodeAddChildren($$, CreateSyntaxNode(kNodeIdentifier, "asc"));
+  }
+  | column_name DESC {
+    $$ = $1;
+    SyntaxNodeAddChildren($$, CreateSyntaxNode(kNodeIdentifier, "desc"));
+  }
+  ;
+
+/* 一张表时就是表名，多张表时是kNodeJoin，子节点依次是表名和跟在表名后的ON条件 */
+from_tables:
+  identifier {
+    $$ = $1;
+  }
+  | from_tables ',' identifier {
+    if ($1->type_ == kNodeJoin) {
+      $$ = $1;
+    } else {
+      $$ = CreateSyntaxNode(kNodeJoin, NULL);
+      SyntaxNodeAddChildren($$, $1);
+    }
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | from_tables JOIN identifier ON where_conditions {
+    if ($1->type_ == kNodeJoin) {
+      $$ = $1;
+    } else {
+      $$ = CreateSyntaxNode(kNodeJoin, NULL);
+      SyntaxNodeAddChildren($$, $1);
+    }
+    SyntaxNodeAddChildren($$, $3);
+    pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
+    SyntaxNodeAddChildren(condition_node, $5);
+    SyntaxNodeAddChildren($$, condition_node);
   }
   ;
 
@@ -215,12 +395,101 @@ select_columns:
   '*' {
     $$ = CreateSyntaxNode(kNodeAllColumns, NULL);
   }
-  | column_list {
+  | select_list {
     $$ = CreateSyntaxNode(kNodeColumnList, "select columns");
     SyntaxNodeAddChildren($$, $1);
   }
   ;
 
+select_list:
+  select_item ',' select_list {
+    $$ = $1;
+    SyntaxNodeAddSibling($$, $3);
+  }
+  | select_item {
+    $$ = $1;
+  }
+  ;
+
+/* 列或聚集函数，只有count能用*，由planner检查 */
+select_item:
+  column_name {
+    $$ = $1;
+  }
+  | aggregate_function '(' column_name ')' {
+    $$ = $1;
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | aggregate_function '(' '*' ')' {
+    $$ = $1;
+    SyntaxNodeAddChildren($$, CreateSyntaxNode(kNodeAllColumns, NULL));
+  }
+  ;
+
+aggregate_function:
+  COUNT {
+    $$ = CreateSyntaxNode(kNodeFunction, "count");
+  }
+  | SUM {
+    $$ = CreateSyntaxNode(kNodeFunction, "sum");
+  }
+  | MIN {
+    $$ = CreateSyntaxNode(kNodeFunction, "min");
+  }
+  | MAX {
+    $$ = CreateSyntaxNode(kNodeFunction, "max");
+  }
+  | AVG {
+    $$ = CreateSyntaxNode(kNodeFunction, "avg");
+  }
+  ;
+
+/* 名字，非保留的关键字也可以作为名字 */
+identifier:
+  IDENTIFIER {
+    $$ = $1;
+  }
+  | COUNT {
+    $$ = $1;
+  }
+  | SUM {
+    $$ = $1;
+  }
+  | MIN {
+    $$ = $1;
+  }
+  | MAX {
+    $$ = $1;
+  }
+  | AVG {
+    $$ = $1;
+  }
+  | LIMIT {
+    $$ = $1;
+  }
+  | OFFSET {
+    $$ = $1;
+  }
+  | ANALYZE {
+    $$ = $1;
+  }
+  | EXPLAIN {
+    $$ = $1;
+  }
+  ;
+
+/* 列名，可以用表名限定，如c.id，合并成一个identifier */
+column_name:
+  identifier {
+    $$ = $1;
+  }
+  | identifier '.' identifier {
+    $$ = $1;
+    $$->val_ = (char *)realloc($$->val_, strlen($1->val_) + strlen($3->val_) + 2);
+    strcat(strcat($$->val_, "."), $3->val_);
+  }
+  ;
+
 where_conditions:
   where_conditions connector where_condition  {
     $$ = $2;
@@ -242,7 +511,12 @@ connector:
   ;
 
 where_condition:
-  IDENTIFIER operator column_value {
+  column_name operator column_value {
+    $$ = $2;
+    SyntaxNodeAddChildren($$, $1);
+    SyntaxNodeAddChildren($$, $3);
+  }
+  | column_name operator column_name {
     $$ = $2;
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $3);
@@ -289,7 +563,7 @@ operator:
   ;
 
 sql_insert:
-  INSERT INTO IDENTIFIER VALUES '(' column_values ')' {
+  INSERT INTO identifier VALUES '(' column_values ')' {
     $$ = CreateSyntaxNode(kNodeInsert, NULL);
     SyntaxNodeAddChildren($$, $3);
     pSyntaxNode col_val_node = CreateSyntaxNode(kNodeColumnValues, NULL);
@@ -309,11 +583,11 @@ column_values:
   ;
 
 sql_delete:
-  DELETE FROM IDENTIFIER {
+  DELETE FROM identifier {
     $$ = CreateSyntaxNode(kNodeDelete, NULL);
     SyntaxNodeAddChildren($$, $3);
   }
-  | DELETE FROM IDENTIFIER WHERE where_conditions {
+  | DELETE FROM identifier WHERE where_conditions {
     $$ = CreateSyntaxNode(kNodeDelete, NULL);
     SyntaxNodeAddChildren($$, $3);
     pSyntaxNode condition_node = CreateSyntaxNode(kNodeConditions, NULL);
@@ -323,14 +597,14 @@ sql_delete:
   ;
 
 sql_update:
-  UPDATE IDENTIFIER SET update_values {
+  UPDATE identifier SET update_values {
     $$ = CreateSyntaxNode(kNodeUpdate, NULL);
     SyntaxNodeAddChildren($$, $2);
     pSyntaxNode upd_values_node = CreateSyntaxNode(kNodeUpdateValues, NULL);
     SyntaxNodeAddChildren(upd_values_node, $4);
     SyntaxNodeAddChildren($$, upd_values_node);
   }
-  | UPDATE IDENTIFIER SET update_values WHERE where_conditions {
+  | UPDATE identifier SET update_values WHERE where_conditions {
     $$ = CreateSyntaxNode(kNodeUpdate, NULL);
     SyntaxNodeAddChildren($$, $2);
     // update values
@@ -355,7 +629,7 @@ update_values:
   ;
 
 update_value:
-  IDENTIFIER EQ column_value {
+  identifier EQ column_value {
     $$ = CreateSyntaxNode(kNodeUpdateValue, NULL);
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $3);
@@ -8,6 +8,9 @@
 
 void MinisqlParserMovePos(int line, char *text);
 
+/** @return The token of the keyword text, case-insensitive, 0 if text is not one of the keywords */
+int MinisqlParserKeyword(char *text);
+
 void MinisqlParserSetRoot(pSyntaxNode node);
 
 void MinisqlParserSetError(char *msg);
@@ -43,7 +43,17 @@ typedef enum {
   kNodeIndexType,            /** type of index */
   kNodeTrxBegin,             /** begin recovery command */
   kNodeTrxCommit,            /** commit recovery command */
-  kNodeTrxRollback           /** rollback recovery command */
+  kNodeTrxRollback,          /** rollback recovery command */
+  kNodeTableOption,          /** storage option of create table, e.g. clustered */
+  kNodeAnalyze,              /** analyze command, rebuilds the statistics of a table */
+  kNodeExplain,              /** explain command, prints the plan of a select, insert, delete or update */
+  kNodeSet,                  /** set command, changes a setting of the session, e.g. parallelism */
+  kNodeJoin,                 /** tables of a select from several tables, each followed by its join conditions */
+  kNodeFunction,             /** aggregate function in a select list, its argument column or kNodeAllColumns as child */
+  kNodeGroupBy,              /** group by clause of a select, contains the grouped columns */
+  kNodeOrderBy,              /** order by clause of a select, contains the columns, each with asc or desc as child */
+  kNodeLimit,                /** limit clause of a select, contains the number of rows */
+  kNodeOffset                /** offset clause after a limit, contains the number of rows to skip */
 } SyntaxNodeType;
 
 /**
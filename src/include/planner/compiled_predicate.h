@@ -0,0 +1,62 @@
+#ifndef MINISQL_COMPILED_PREDICATE_H
+#define MINISQL_COMPILED_PREDICATE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "planner/expressions/abstract_expression.h"
+#include "record/row.h"
+
+/**
+ * CompiledPredicate is a predicate lowered once, when its plan node is built, into an array of typed
+ * terms. A comparison of a column with a constant knows its operator, the index of the column and the
+ * constant as a plain value, so a row is checked without comparing strings and without building a
+ * Field per comparison. Any other shape of expression is kept as it is and evaluated through
+ * AbstractExpression::Evaluate().
+ */
+class CompiledPredicate {
+ public:
+  /** @return The compiled predicate, nullptr if predicate is nullptr */
+  static std::unique_ptr<CompiledPredicate> Compile(const AbstractExpressionRef &predicate);
+
+  /** @return Whether the predicate is true on row, a null result is false */
+  bool EvaluatePredicate(const Row &row) const { return Evaluate(root_, row); }
+
+  /** @return The number of terms evaluated through the expression tree */
+  size_t GetFallbackCount() const { return fallback_count_; }
+
+ private:
+  enum class TermType { And, Or, CompareInt, CompareFloat, CompareChar, CompareNull, Constant, Expression };
+
+  struct Term {
+    TermType type_{TermType::Constant};
+    CompareOp op_{CompareOp::Equal};
+    uint32_t col_idx_{0};
+    /** Children of And and Or */
+    uint32_t left_{0};
+    uint32_t right_{0};
+    int32_t int_value_{0};
+    float float_value_{0};
+    std::string chars_;
+    /** Result of a Constant term */
+    bool value_{false};
+    AbstractExpressionRef expression_;
+  };
+
+  CompiledPredicate() = default;
+
+  /** @return The index of the term of expression, after the terms of its children */
+  uint32_t CompileTerm(const AbstractExpressionRef &expression);
+
+  /** @return false if the comparison is not a column compared with a constant of its type */
+  static bool CompileComparison(const AbstractExpressionRef &expression, Term &term);
+
+  bool Evaluate(uint32_t index, const Row &row) const;
+
+  std::vector<Term> terms_;
+  uint32_t root_{0};
+  size_t fallback_count_{0};
+};
+
+#endif  // MINISQL_COMPILED_PREDICATE_H
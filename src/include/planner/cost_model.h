@@ -0,0 +1,76 @@
+#ifndef MINISQL_COST_MODEL_H
+#define MINISQL_COST_MODEL_H
+
+#include "catalog/indexes.h"
+#include "catalog/statistics.h"
+
+/**
+ * CostModel prices the access paths of one analyzed table, in units of one page read in order.
+ * A page read out of order costs RANDOM_PAGE_COST, and every row, index entry and comparison
+ * handled adds a small CPU cost. Row and page counts come from the statistics of ANALYZE.
+ */
+class CostModel {
+ public:
+  static constexpr double SEQ_PAGE_COST = 1.0;
+  static constexpr double RANDOM_PAGE_COST = 4.0;
+  static constexpr double CPU_TUPLE_COST = 0.01;
+  static constexpr double CPU_INDEX_TUPLE_COST = 0.005;
+  static constexpr double CPU_OPERATOR_COST = 0.0025;
+  /** B+ tree leaves are about this full after splits */
+  static constexpr double LEAF_FILL_FACTOR = 0.7;
+
+  explicit CostModel(const TableStatistics *statistics);
+
+  inline double GetRowCount() const { return rows_; }
+
+  inline double GetPageCount() const { return pages_; }
+
+  /** Read every page in order, evaluating conditions comparisons on each row. */
+  double SeqScan(size_t conditions) const;
+
+  /**
+   * Find the first matching entry of an index and read entries entries from there. The entries of
+   * a clustered index hold the rows, which are decoded on the way.
+   */
+  double IndexScan(IndexInfo *index, double entries) const;
+
+  /**
+   * Look up lookups keys of a b+ tree index in key order, as IndexInfo::LookupMany does for a batch:
+   * the upper levels stay in the buffer pool, each distinct leaf holding the entries of the keys is
+   * read once and the leaves are visited from left to right.
+   * @param entries_per_key Entries equal to each key
+   */
+  double IndexLookups(IndexInfo *index, double lookups, double entries_per_key) const;
+
+  /**
+   * Fetch rows by row id, each distinct page is read once.
+   * @param correlation Correlation of the fetch order with the table order, see ColumnStatistics.
+   * Uncorrelated rows are read at random, fully correlated ones from consecutive pages.
+   */
+  double FetchRows(double rows, double correlation = 0) const;
+
+  /**
+   * Fetch rows by sorted row id, each distinct page is read once and in heap order. The more pages
+   * are read, the closer together they lie and the more a page costs like a sequential read.
+   */
+  double FetchSortedRows(double rows) const;
+
+  /** Sort and intersect or merge row id sets holding entries row ids in total. */
+  double MergeRowIds(double entries) const;
+
+  /** Evaluate conditions comparisons on each of rows rows. */
+  double Filter(double rows, size_t conditions) const;
+
+  /**
+   * Sort rows rows of about width bytes each, see SortExecutor: rows beyond work_memory are written
+   * to sorted runs and read back once to merge them.
+   * @param limit Rows kept in a top-N heap, negative to sort all rows
+   */
+  static double Sort(double rows, double width, size_t work_memory, double limit = -1);
+
+ private:
+  double rows_;
+  double pages_;
+};
+
+#endif  // MINISQL_COST_MODEL_H
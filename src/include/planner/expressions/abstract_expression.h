@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "record/data_chunk.h"
 #include "record/row.h"
 #include "record/schema.h"
 
@@ -44,6 +45,30 @@ class AbstractExpression {
    */
   virtual Field EvaluateJoin(const Row *left_row, const Row *right_row) const = 0;
 
+  /**
+   * Narrow selection down to the positions of the rows of chunk for which this predicate is true.
+   * This default materializes each selected row and evaluates it, comparisons and logic
+   * expressions work on the column vectors instead.
+   */
+  virtual void FilterBatch(const DataChunk &chunk, std::vector<uint32_t> &selection) const {
+    Row row;
+    size_t kept = 0;
+    for (uint32_t pos : selection) {
+      chunk.GetRowAt(pos, &row);
+      if (Evaluate(&row).CompareEquals(Field(kTypeInt, 1)) == CmpBool::kTrue) {
+        selection[kept++] = pos;
+      }
+    }
+    selection.resize(kept);
+  }
+
+  /**
+   * Set bit i % 64 of bits[i / 64] if this predicate is true on the row at position i of chunk, with
+   * the SIMD kernels of FilterKernels.
+   * @return false if a part of the predicate has no kernel, bits are undefined and FilterBatch() is used instead
+   */
+  virtual bool FilterBitmap(const DataChunk & /* chunk */, uint64_t * /* bits */) const { return false; }
+
   /** @return the child_idx'th child of this expression */
   const AbstractExpressionRef &GetChildAt(uint32_t child_idx) const { return children_[child_idx]; }
 
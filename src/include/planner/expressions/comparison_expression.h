@@ -5,9 +5,12 @@
 #ifndef MINISQL_COMPARISON_EXPRESSION_H
 #define MINISQL_COMPARISON_EXPRESSION_H
 
+#include <string>
 #include <utility>
 
 #include "abstract_expression.h"
+#include "column_value_expression.h"
+#include "constant_value_expression.h"
 #include "record/schema.h"
 
 /**
@@ -16,9 +19,10 @@
 class ComparisonExpression : public AbstractExpression {
  public:
   /** Creates a new comparison expression representing (left comp_type right). */
-  ComparisonExpression(AbstractExpressionRef left, AbstractExpressionRef right, string comp_type)
+  ComparisonExpression(AbstractExpressionRef left, AbstractExpressionRef right, std::string comp_type)
       : AbstractExpression({std::move(left), std::move(right)}, TypeId::kTypeInt, ExpressionType::ComparisonExpression),
-        comp_type_{std::move(comp_type)} {}
+        comp_type_{std::move(comp_type)},
+        op_(Str2CompareOp(comp_type_)) {}
 
   /** e.g. evaluate the result of id = 1 */
   Field Evaluate(const Row *row) const override {
@@ -33,31 +37,91 @@ class ComparisonExpression : public AbstractExpression {
     return Field(kTypeInt, PerformComparison(lhs, rhs));
   }
 
+  /** column op constant is evaluated on the column vector, anything else row by row */
+  void FilterBatch(const DataChunk &chunk, std::vector<uint32_t> &selection) const override {
+    auto column = dynamic_cast<const ColumnValueExpression *>(GetChildAt(0).get());
+    if (column != nullptr && column->GetColIdx() < chunk.GetColumnCount()) {
+      const ColumnVector &vector = chunk.GetColumn(column->GetColIdx());
+      if (op_ == CompareOp::IsNull || op_ == CompareOp::NotNull) {
+        vector.SelectNull(op_ == CompareOp::IsNull, selection);
+        return;
+      }
+      auto constant = dynamic_cast<const ConstantValueExpression *>(GetChildAt(1).get());
+      if (constant != nullptr && vector.SelectCompare(op_, constant->val_, selection)) {
+        return;
+      }
+    }
+    AbstractExpression::FilterBatch(chunk, selection);
+  }
+
+  /** column op constant on an int or float column, and is null / not null on any column */
+  bool FilterBitmap(const DataChunk &chunk, uint64_t *bits) const override {
+    auto column = dynamic_cast<const ColumnValueExpression *>(GetChildAt(0).get());
+    if (column == nullptr || column->GetColIdx() >= chunk.GetColumnCount()) {
+      return false;
+    }
+    const ColumnVector &vector = chunk.GetColumn(column->GetColIdx());
+    if (op_ == CompareOp::IsNull || op_ == CompareOp::NotNull) {
+      vector.NullBitmap(op_ == CompareOp::IsNull, bits);
+      return true;
+    }
+    auto constant = dynamic_cast<const ConstantValueExpression *>(GetChildAt(1).get());
+    return constant != nullptr && vector.CompareBitmap(op_, constant->val_, bits);
+  }
+
   std::string GetComparisonType() { return comp_type_; }
 
- private:
-  CmpBool PerformComparison(const Field &lhs, const Field &rhs) const {
-    if (comp_type_ == "=")
-      return lhs.CompareEquals(rhs);
-    else if (comp_type_ == "<>")
-      return lhs.CompareNotEquals(rhs);
-    else if (comp_type_ == "<")
-      return lhs.CompareLessThan(rhs);
-    else if (comp_type_ == "<=")
-      return lhs.CompareLessThanEquals(rhs);
-    else if (comp_type_ == ">")
-      return lhs.CompareGreaterThan(rhs);
-    else if (comp_type_ == ">=")
-      return lhs.CompareGreaterThanEquals(rhs);
-    else if (comp_type_ == "is")
-      return GetCmpBool(lhs.IsNull());
-    else if (comp_type_ == "not")
-      return GetCmpBool(!lhs.IsNull());
+  CompareOp GetCompareOp() const { return op_; }
+
+  static CompareOp Str2CompareOp(const std::string &comp_type) {
+    if (comp_type == "=")
+      return CompareOp::Equal;
+    else if (comp_type == "<>")
+      return CompareOp::NotEqual;
+    else if (comp_type == "<")
+      return CompareOp::LessThan;
+    else if (comp_type == "<=")
+      return CompareOp::LessThanEquals;
+    else if (comp_type == ">")
+      return CompareOp::GreaterThan;
+    else if (comp_type == ">=")
+      return CompareOp::GreaterThanEquals;
+    else if (comp_type == "is")
+      return CompareOp::IsNull;
+    else if (comp_type == "not")
+      return CompareOp::NotNull;
     else
       throw std::logic_error("Unsupported comparison type");
   }
 
+ private:
+  CmpBool PerformComparison(const Field &lhs, const Field &rhs) const {
+    switch (op_) {
+      case CompareOp::Equal:
+        return lhs.CompareEquals(rhs);
+      case CompareOp::NotEqual:
+        return lhs.CompareNotEquals(rhs);
+      case CompareOp::LessThan:
+        return lhs.CompareLessThan(rhs);
+      case CompareOp::LessThanEquals:
+        return lhs.CompareLessThanEquals(rhs);
+      case CompareOp::GreaterThan:
+        return lhs.CompareGreaterThan(rhs);
+      case CompareOp::GreaterThanEquals:
+        return lhs.CompareGreaterThanEquals(rhs);
+      case CompareOp::IsNull:
+        return GetCmpBool(lhs.IsNull());
+      case CompareOp::NotNull:
+        return GetCmpBool(!lhs.IsNull());
+      default:
+        throw std::logic_error("Unsupported comparison type");
+    }
+  }
+
   std::string comp_type_;
+
+  /** comp_type_ resolved once */
+  CompareOp op_;
 };
 
 #endif  // MINISQL_COMPARISON_EXPRESSION_H
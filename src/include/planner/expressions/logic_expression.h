@@ -5,7 +5,11 @@
 #ifndef MINISQL_LOGIC_EXPRESSION_H
 #define MINISQL_LOGIC_EXPRESSION_H
 
+#include <algorithm>
+
 #include "abstract_expression.h"
+#include "comparison_expression.h"
+#include "record/filter_kernels.h"
 
 /** ArithmeticType represents the type of logic operation that we want to perform. */
 enum class LogicType { And, Or };
@@ -37,6 +41,40 @@ class LogicExpression : public AbstractExpression {
     return Field(kTypeInt, PerformComputation(lhs, rhs));
   }
 
+  /** AND narrows the selection by both sides in turn, OR checks the right side on the rest of the left */
+  void FilterBatch(const DataChunk &chunk, std::vector<uint32_t> &selection) const override {
+    if (logic_type_ == LogicType::And) {
+      GetChildAt(0)->FilterBatch(chunk, selection);
+      GetChildAt(1)->FilterBatch(chunk, selection);
+      return;
+    }
+    std::vector<uint32_t> lhs(selection);
+    GetChildAt(0)->FilterBatch(chunk, lhs);
+    std::vector<uint32_t> rest;
+    std::set_difference(selection.begin(), selection.end(), lhs.begin(), lhs.end(), std::back_inserter(rest));
+    GetChildAt(1)->FilterBatch(chunk, rest);
+    selection.clear();
+    std::merge(lhs.begin(), lhs.end(), rest.begin(), rest.end(), std::back_inserter(selection));
+  }
+
+  /** AND / OR of the bitmaps of both sides, a lower and an upper bound on one column take one pass */
+  bool FilterBitmap(const DataChunk &chunk, uint64_t *bits) const override {
+    if (logic_type_ == LogicType::And && FilterBetween(chunk, bits)) {
+      return true;
+    }
+    if (!GetChildAt(0)->FilterBitmap(chunk, bits)) {
+      return false;
+    }
+    std::vector<uint64_t> rhs(FilterKernels::WordCount(chunk.GetSize()));
+    if (!GetChildAt(1)->FilterBitmap(chunk, rhs.data())) {
+      return false;
+    }
+    for (size_t i = 0; i < rhs.size(); i++) {
+      bits[i] = logic_type_ == LogicType::And ? bits[i] & rhs[i] : bits[i] | rhs[i];
+    }
+    return true;
+  }
+
   static LogicType Char2Type(char *val) {
     if (!strcmp(val, "and"))
       return LogicType::And;
@@ -49,6 +87,35 @@ class LogicExpression : public AbstractExpression {
   LogicType logic_type_;
 
  private:
+  /** col > lower AND col < upper, >= and <= too, in either order */
+  bool FilterBetween(const DataChunk &chunk, uint64_t *bits) const {
+    auto lower = dynamic_cast<const ComparisonExpression *>(GetChildAt(0).get());
+    auto upper = dynamic_cast<const ComparisonExpression *>(GetChildAt(1).get());
+    if (lower == nullptr || upper == nullptr) {
+      return false;
+    }
+    if (lower->GetCompareOp() == CompareOp::LessThan || lower->GetCompareOp() == CompareOp::LessThanEquals) {
+      std::swap(lower, upper);
+    }
+    CompareOp lower_op = lower->GetCompareOp();
+    CompareOp upper_op = upper->GetCompareOp();
+    if ((lower_op != CompareOp::GreaterThan && lower_op != CompareOp::GreaterThanEquals) ||
+        (upper_op != CompareOp::LessThan && upper_op != CompareOp::LessThanEquals)) {
+      return false;
+    }
+    auto lower_column = dynamic_cast<const ColumnValueExpression *>(lower->GetChildAt(0).get());
+    auto upper_column = dynamic_cast<const ColumnValueExpression *>(upper->GetChildAt(0).get());
+    auto lower_value = dynamic_cast<const ConstantValueExpression *>(lower->GetChildAt(1).get());
+    auto upper_value = dynamic_cast<const ConstantValueExpression *>(upper->GetChildAt(1).get());
+    if (lower_column == nullptr || upper_column == nullptr || lower_value == nullptr || upper_value == nullptr ||
+        lower_column->GetColIdx() != upper_column->GetColIdx() || lower_column->GetColIdx() >= chunk.GetColumnCount()) {
+      return false;
+    }
+    return chunk.GetColumn(lower_column->GetColIdx())
+        .BetweenBitmap(lower_value->val_, lower_op == CompareOp::GreaterThanEquals, upper_value->val_,
+                       upper_op == CompareOp::LessThanEquals, bits);
+  }
+
   CmpBool GetFieldAsCmpBool(const Field &val) const {
     if (val.IsNull()) {
       return CmpBool::kNull;
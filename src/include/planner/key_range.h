@@ -0,0 +1,88 @@
+#ifndef MINISQL_KEY_RANGE_H
+#define MINISQL_KEY_RANGE_H
+
+#include <memory>
+#include <vector>
+
+#include "planner/expressions/abstract_expression.h"
+#include "record/row.h"
+#include "record/schema.h"
+
+/**
+ * KeyRange is the part of a predicate that one b+ tree leaf scan can answer: equality on a
+ * prefix of the key columns followed by an optional range on the next key column. All the
+ * comparisons joined by AND at the top of the predicate are merged per column, so
+ * `a = 1 AND b > 5 AND b <= 9` on an (a, b) index becomes a = [1, 1], b = (5, 9].
+ */
+class KeyRange {
+ public:
+  KeyRange() = default;
+
+  /**
+   * Build the range of the predicate over the key columns.
+   * @param predicate The predicate, columns refer to the table schema
+   * @param key_schema The key schema of the index
+   */
+  KeyRange(const AbstractExpressionRef &predicate, const Schema *key_schema);
+
+  /** @return The number of leading key columns compared with "=" */
+  uint32_t GetEqualityCount() const { return eq_count_; }
+
+  /** @return Whether the key column after the equality prefix has a lower or upper bound */
+  bool HasRange() const { return has_range_; }
+
+  /** @return The number of key columns that narrow the scan */
+  uint32_t GetMatchedColumns() const { return eq_count_ + (has_range_ ? 1 : 0); }
+
+  /** @return Whether the conjuncts contradict each other, e.g. a > 5 AND a < 3 */
+  bool IsEmpty() const { return empty_; }
+
+  /** @return Whether the range alone decides the predicate, i.e. rows in the range need no filtering */
+  bool IsExact() const { return exact_; }
+
+  /** @return Whether this range narrows the scan more than other */
+  bool IsTighterThan(const KeyRange &other) const;
+
+  /**
+   * Build the smallest key of the range. A key column with only an upper bound takes its minimum
+   * value, the columns after the bounded ones take null, which sorts before every value.
+   * @return `false` if the range has no lower bound and the scan starts from the first entry
+   */
+  bool GetStartKey(Row &key) const;
+
+  /**
+   * Locate a key relative to the range.
+   * @return -1 if the key is before the range (or has a null in a bounded column), 0 if it is in
+   * the range and 1 if it is after the range, all the keys after it are out of the range too
+   */
+  int Locate(const Row &key) const;
+
+  /** Minimum value of a type, used to pad the start key. */
+  static Field MinField(TypeId type);
+
+ private:
+  /** Bounds of one key column, a point if lower == upper and neither is strict. */
+  struct Interval {
+    std::unique_ptr<Field> lower_;
+    std::unique_ptr<Field> upper_;
+    bool lower_strict_{false};
+    bool upper_strict_{false};
+
+    bool IsPoint() const;
+  };
+
+  /** @return `false` if the comparison cannot be merged into the intervals */
+  bool Merge(const AbstractExpressionRef &predicate, std::vector<Interval> &intervals,
+             std::vector<uint32_t> &merged_columns);
+
+  static int Compare(const Field &lhs, const Field &rhs);
+
+  std::vector<Interval> intervals_;
+  std::vector<TypeId> key_types_;
+  uint32_t eq_count_{0};
+  bool has_range_{false};
+  bool empty_{false};
+  bool exact_{false};
+};
+
+#endif  // MINISQL_KEY_RANGE_H
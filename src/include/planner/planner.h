@@ -5,14 +5,29 @@
 #ifndef MINISQL_PLANNER_H
 #define MINISQL_PLANNER_H
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
 #include "common/instance.h"
 #include "executor/plans/abstract_plan.h"
+#include "executor/plans/aggregation_plan.h"
+#include "executor/plans/bitmap_heap_scan_plan.h"
 #include "executor/plans/delete_plan.h"
+#include "executor/plans/hash_join_plan.h"
+#include "executor/plans/index_nested_loop_join_plan.h"
+#include "executor/plans/index_only_scan_plan.h"
 #include "executor/plans/index_scan_plan.h"
 #include "executor/plans/insert_plan.h"
+#include "executor/plans/limit_plan.h"
 #include "executor/plans/seq_scan_plan.h"
+#include "executor/plans/sort_plan.h"
 #include "executor/plans/update_plan.h"
 #include "executor/plans/values_plan.h"
+#include "planner/cost_model.h"
+#include "planner/key_range.h"
 #include "planner/statement/abstract_statement.h"
 #include "planner/statement/delete_statement.h"
 #include "planner/statement/insert_statement.h"
@@ -23,6 +38,8 @@
  * The planner takes a bound statement, and transforms it into the BusTub plan tree.
  * The plan tree will be taken by the execution engine to execute the statement.
  */
+class TableStatistics;
+
 class Planner {
  public:
   explicit Planner(ExecuteContext *context) : context_(context) {}
@@ -40,11 +57,159 @@ class Planner {
 
   AbstractPlanNodeRef PlanUpdate(std::shared_ptr<UpdateStatement> statement);
 
+  /**
+   * Aggregate the rows of child, the columns of the select list of an aggregating select, into the
+   * groups and the aggregates of that list; estimated when child is.
+   */
+  AbstractPlanNodeRef PlanAggregation(const std::shared_ptr<SelectStatement> &statement,
+                                      const AbstractPlanNodeRef &child);
+
+  /** Sort child, the rows of the select list, by the ORDER BY clause, keeping the rows up to the row goal if any */
+  AbstractPlanNodeRef PlanSort(const std::shared_ptr<SelectStatement> &statement, const AbstractPlanNodeRef &child);
+
+  /**
+   * Produce the LIMIT rows of child after skipping the OFFSET rows. A scan stops once the limit is
+   * reached, so only its share of rows up to the row goal is counted in the cost.
+   */
+  AbstractPlanNodeRef PlanLimit(const std::shared_ptr<SelectStatement> &statement, const AbstractPlanNodeRef &child);
+
+  /** @return Rows of the input a select needs at most, LIMIT + OFFSET, or -1 without LIMIT */
+  static double RowGoal(const std::shared_ptr<SelectStatement> &statement);
+
+  /**
+   * @return Whether the rows of plan, a scan of the table of a single table select, already come in
+   * the order of the ORDER BY clause: the key order of a b+ tree range or index only scan, or of the
+   * clustered index for a sequential scan of a clustered table.
+   */
+  bool ProvidesOrder(const std::shared_ptr<SelectStatement> &statement, const AbstractPlanNodeRef &plan);
+
+  /**
+   * Choose between chosen, the access path of a select with ORDER BY, followed by a sort and a scan
+   * of a b+ tree index in the order of the clause. With statistics the cheapest is kept, counting
+   * only the rows fetched up to the LIMIT for the index; without them the index is used when it
+   * covers the select or there is a LIMIT.
+   */
+  AbstractPlanNodeRef PlanOrderedScan(const std::shared_ptr<SelectStatement> &statement,
+                                      const AbstractPlanNodeRef &chosen);
+
+  /** @return Estimated bytes of a row of schema in a chunk */
+  static double RowWidth(const Schema *schema);
+
+  /**
+   * Choose the access path of a select.
+   * @param out_schema The output schema of the scan
+   * @param allow_index_only Whether the rows may be read from an index key instead of the table
+   */
+  AbstractPlanNodeRef PlanScan(const std::shared_ptr<SelectStatement> &statement, const Schema *out_schema,
+                               bool allow_index_only);
+
+  /**
+   * Plan the scan of an analyzed table: price a sequential scan and every index access path with
+   * CostModel and keep the cheapest, annotated with its estimated output rows and cost.
+   */
+  AbstractPlanNodeRef PlanScanByCost(const std::shared_ptr<SelectStatement> &statement, const Schema *out_schema,
+                                     bool allow_index_only, const std::vector<IndexInfo *> &indexes,
+                                     std::unordered_map<uint32_t, bool> &equality_only,
+                                     const TableStatistics *statistics);
+
+  /**
+   * Plan a select from several tables: each table is scanned with its own conditions, then they are
+   * joined left-deep in FROM order on the equalities between the tables joined so far and the next
+   * one (see PlanJoinStep). The other conditions on several tables filter the join adding their last
+   * table.
+   */
+  AbstractPlanNodeRef PlanJoin(const std::shared_ptr<SelectStatement> &statement);
+
+  /**
+   * Join left, the tables before position table, with right, the scan of the table at that position.
+   * When both inputs and the table have statistics, the join is priced as a hash join and as an index
+   * nested-loop join on every b+ tree index of the table whose key columns are all among right_keys,
+   * looking up each estimated outer row; the cheapest is kept with its estimate. Otherwise it is a
+   * hash join. The arguments are those of HashJoinPlanNode.
+   */
+  AbstractPlanNodeRef PlanJoinStep(const std::shared_ptr<SelectStatement> &statement, size_t table,
+                                   const AbstractPlanNodeRef &left, const AbstractPlanNodeRef &right,
+                                   std::vector<uint32_t> left_keys, std::vector<uint32_t> right_keys,
+                                   const AbstractExpressionRef &predicate, const Schema *output,
+                                   std::vector<std::pair<uint32_t, uint32_t>> output_columns);
+
+  /** @return Distinct values of a column of a join from the statistics of its table, 0 if it has none */
+  double DistinctCount(const std::shared_ptr<SelectStatement> &statement, uint32_t column);
+
+  /** Plan the scan of the table at position table of a join, all its columns named "table.column" */
+  AbstractPlanNodeRef PlanJoinInput(const std::shared_ptr<SelectStatement> &statement, size_t table);
+
+  /**
+   * Rewrite a condition over the joined row for a join: the columns before offset are read from the
+   * left row (row index 0), the others from the right row (row index 1).
+   */
+  static AbstractExpressionRef SplitJoinColumns(const AbstractExpressionRef &condition, uint32_t offset);
+
+  /** @return The largest column index in the expression */
+  static uint32_t LastColumn(const AbstractExpressionRef &expr);
+
+  /**
+   * Plan the child scan of a delete or an update: whole table rows with their row ids, through an
+   * index when the where clause allows it.
+   */
+  AbstractPlanNodeRef PlanRowScan(pSyntaxNode ast, const std::string &table_name, const AbstractExpressionRef &where,
+                                  const std::vector<uint32_t> &column_in_condition);
+
   /** the root plan node of the plan tree */
   AbstractPlanNodeRef plan_;
 
   Schema *MakeOutputSchema(const std::vector<std::pair<std::string, AbstractExpressionRef>> &exprs);
 
+  /** Find a b+ tree index whose key holds every column in the select list and the predicate. */
+  static IndexInfo *ChooseCoveringIndex(const std::shared_ptr<SelectStatement> &statement,
+                                        const std::vector<IndexInfo *> &indexes);
+
+  /**
+   * Find the b+ tree index whose key range of the predicate is the tightest.
+   * @param[out] range The key range of the predicate over the chosen index
+   * @return The chosen index, nullptr if no index narrows the scan
+   */
+  static IndexInfo *ChooseRangeIndex(const std::shared_ptr<SelectStatement> &statement,
+                                     const std::vector<IndexInfo *> &indexes, KeyRange &range);
+
+  /** Record for each column in the predicate whether it is only compared with "=". */
+  static void CollectEqualityColumns(const AbstractExpressionRef &predicate, std::unordered_map<uint32_t, bool> &equality_only);
+
+  /**
+   * For each column in the predicate, pick the single column index whose row ids answer its comparisons:
+   * a hash index if the column is only compared with "=", else an art index, else a b+ tree.
+   */
+  static std::map<uint32_t, IndexInfo *> ChooseColumnIndexes(
+      const std::shared_ptr<SelectStatement> &statement, const std::vector<IndexInfo *> &indexes,
+      std::unordered_map<uint32_t, bool> &equality_only);
+
+  /**
+   * Check whether the row ids of column_indexes narrow the predicate down, the way IndexScanExecutor
+   * intersects them for AND and merges them for OR.
+   * @param[out] exact Whether the row ids are exactly the rows matching the predicate
+   */
+  static bool CoversRowIds(const AbstractExpressionRef &predicate,
+                           const std::map<uint32_t, IndexInfo *> &column_indexes, bool &exact);
+
+  /**
+   * Price the index lookups IndexScanExecutor makes for the comparisons of the predicate on column_indexes.
+   * @param[out] entries Estimated number of row ids the lookups return
+   */
+  static double RowIdLookupCost(const AbstractExpressionRef &predicate,
+                                const std::map<uint32_t, IndexInfo *> &column_indexes,
+                                const TableStatistics *statistics, const CostModel &cost_model, double &entries);
+
+  /** @return The number of comparisons in the predicate */
+  static size_t CountComparisons(const AbstractExpressionRef &predicate);
+
+  /**
+   * Estimate the fraction of the rows an index on columns fetches for the predicate, from the statistics
+   * of ANALYZE. Comparisons on other columns do not narrow an index scan and count as 1.
+   * @param conjuncts_only Count OR terms as 1 too, for a single range scan that cannot merge them
+   */
+  static double EstimateSelectivity(const AbstractExpressionRef &predicate, const TableStatistics *statistics,
+                                    const std::unordered_set<uint32_t> &columns, bool conjuncts_only = false);
+
   /** Catalog will be used during the planning process. SHOULD ONLY BE USED IN
    * CODE PATH OF `PlanQuery`.
    */
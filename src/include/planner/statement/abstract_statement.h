@@ -37,15 +37,23 @@ class AbstractStatement {
   /**
    * Make a column value expression.
    * @param table_name The name of the table
-   * @param col The ptr to the SyntaxNode of the column
+   * @param col The ptr to the SyntaxNode of the column, "column" or "table.column"
    * @return A owning pointer to the ColumnValueExpression
    */
   AbstractExpressionRef MakeColumnValueExpression(const std::string &table_name, pSyntaxNode col) {
     TableInfo *info = nullptr;
     context_->GetCatalog()->GetTable(table_name, info);
     auto schema = info->GetSchema();
+    std::string name = col->val_;
+    auto dot = name.find('.');
+    if (dot != std::string::npos) {
+      if (name.substr(0, dot) != table_name) {
+        throw std::logic_error("the column does not exist in table");
+      }
+      name = name.substr(dot + 1);
+    }
     uint32_t index;
-    if (schema->GetColumnIndex(col->val_, index) != DB_SUCCESS) {
+    if (schema->GetColumnIndex(name, index) != DB_SUCCESS) {
       throw std::logic_error("the column does not exist in table");
     }
     auto col_type = schema->GetColumn(index)->GetType();
@@ -111,6 +119,9 @@ class AbstractStatement {
       case kNodeCompareOperator: {
         pSyntaxNode col = ast->child_;
         pSyntaxNode value = ast->child_->next_;
+        if (value->type_ == kNodeIdentifier) {
+          throw std::logic_error("a column can only be compared with a column of another table");
+        }
         auto col_expr = MakeColumnValueExpression(table_name, col);
         auto const_expr = MakeConstantValueExpression(col_expr->GetReturnType(), value);
         if (column_in_condition) {
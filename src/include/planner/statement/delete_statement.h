@@ -27,7 +27,7 @@ class DeleteStatement : public AbstractStatement {
         break;
       }
       case kNodeConditions: {
-        where_ = MakePredicate(ast->child_, table_name_);
+        where_ = MakePredicate(ast->child_, table_name_, &column_in_condition_);
         break;
       }
       default:
@@ -42,6 +42,9 @@ class DeleteStatement : public AbstractStatement {
   /** Bound WHERE clause. */
   AbstractExpressionRef where_ = nullptr;
 
+  /** Index of columns in condition. */
+  std::vector<uint32_t> column_in_condition_;
+
   std::string ToString() const override {
     std::stringstream sstream;
     sstream << "Delete {{\\n  table={" << table_name_ << "}\\n }}";
@@ -5,7 +5,17 @@
 #ifndef MINISQL_SELECT_STATEMENT_H
 #define MINISQL_SELECT_STATEMENT_H
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <strings.h>
+#include <utility>
+#include <vector>
+
 #include "abstract_statement.h"
+#include "executor/plans/aggregation_plan.h"
 
 class SelectStatement : public AbstractStatement {
  public:
@@ -26,16 +36,45 @@ class SelectStatement : public AbstractStatement {
         table_name_ = ast->val_;
         break;
       }
+      case kNodeJoin: {
+        MakeJoin(ast->child_);
+        break;
+      }
       case kNodeAllColumns:
       case kNodeColumnList: {
         SyntaxTree2Statement(ast->next_);
         MakeColumnList(ast->child_);
+        MakeOrderBy(order_by_ast_);
         return;
       }
       case kNodeConditions: {
+        if (!join_tables_.empty()) {
+          MakeJoinConditions(ast->child_);
+          break;
+        }
         where_ = MakePredicate(ast->child_, table_name_, &column_in_condition_, &has_or);
         break;
       }
+      case kNodeGroupBy: {
+        MakeGroupBy(ast->child_);
+        break;
+      }
+      case kNodeOrderBy: {
+        // 排序列要在select列表绑定之后才能找到
+        order_by_ast_ = ast->child_;
+        break;
+      }
+      case kNodeLimit:
+      case kNodeOffset: {
+        char *end = nullptr;
+        long long count = strtoll(ast->child_->val_, &end, 10);
+        if (*end != '\0' || count < 0) {
+          throw std::logic_error(std::string("the ") + (ast->type_ == kNodeLimit ? "limit" : "offset") +
+                                 " must be a non-negative integer");
+        }
+        (ast->type_ == kNodeLimit ? limit_ : offset_) = count;
+        break;
+      }
       default:
         throw std::logic_error("the ast_type is not supported in planner yet");
     }
@@ -43,6 +82,18 @@ class SelectStatement : public AbstractStatement {
   };
 
   void MakeColumnList(pSyntaxNode ast) {
+    bool has_function = false;
+    for (auto item = ast; item != nullptr; item = item->next_) {
+      has_function |= item->type_ == kNodeFunction;
+    }
+    if (has_function || !group_by_.empty()) {
+      MakeAggregateList(ast);
+      return;
+    }
+    if (!join_tables_.empty()) {
+      MakeJoinColumnList(ast);
+      return;
+    }
     TableInfo *info = nullptr;
     context_->GetCatalog()->GetTable(table_name_, info);
     auto schema = info->GetSchema();
@@ -54,23 +105,305 @@ class SelectStatement : public AbstractStatement {
       }
     } else {
       while (ast) {
-        uint32_t index;
-        if (schema->GetColumnIndex(ast->val_, index) != DB_SUCCESS) {
-          throw std::logic_error("the column does not exist in table");
-        }
-        auto expr = std::make_shared<ColumnValueExpression>(0, index, schema->GetColumn(index)->GetType());
-        column_list_.emplace_back(make_pair(ast->val_, expr));
+        column_list_.emplace_back(make_pair(ast->val_, MakeColumnValueExpression(table_name_, ast)));
         ast = ast->next_;
       }
     }
   }
 
+  /** Bind the GROUP BY clause, its columns are read first */
+  void MakeGroupBy(pSyntaxNode ast) {
+    for (; ast != nullptr; ast = ast->next_) {
+      uint32_t input = AddInputColumn(ast->val_, MakeSelectColumn(ast));
+      if (std::find(group_by_.begin(), group_by_.end(), input) == group_by_.end()) {
+        group_by_.push_back(input);
+      }
+    }
+  }
+
+  /**
+   * Bind the select list of a select with aggregates or GROUP BY: a plain column has to be one of
+   * GROUP BY, column_list_ becomes the columns the groups and the aggregates read.
+   */
+  void MakeAggregateList(pSyntaxNode ast) {
+    if (!ast) {
+      throw std::logic_error("select * cannot be used with group by");
+    }
+    for (; ast != nullptr; ast = ast->next_) {
+      if (ast->type_ != kNodeFunction) {
+        uint32_t input = AddInputColumn(ast->val_, MakeSelectColumn(ast));
+        auto group = std::find(group_by_.begin(), group_by_.end(), input);
+        if (group == group_by_.end()) {
+          throw std::logic_error("the column " + std::string(ast->val_) +
+                                 " must appear in the group by clause or be used in an aggregate function");
+        }
+        aggregate_outputs_.emplace_back(ast->val_, std::make_pair(0, group - group_by_.begin()));
+        continue;
+      }
+      // 函数名由parser给出，都是小写
+      std::string function = ast->val_;
+      pSyntaxNode arg = ast->child_;
+      AggregationType type;
+      if (function == "count") {
+        type = arg->type_ == kNodeAllColumns ? AggregationType::CountStarAggregate : AggregationType::CountAggregate;
+      } else if (function == "sum") {
+        type = AggregationType::SumAggregate;
+      } else if (function == "min") {
+        type = AggregationType::MinAggregate;
+      } else if (function == "max") {
+        type = AggregationType::MaxAggregate;
+      } else if (function == "avg") {
+        type = AggregationType::AvgAggregate;
+      } else {
+        throw std::logic_error("the function " + std::string(ast->val_) + " does not exist");
+      }
+      uint32_t input = 0;
+      if (type != AggregationType::CountStarAggregate) {
+        if (arg->type_ == kNodeAllColumns) {
+          throw std::logic_error("only count can take *");
+        }
+        auto column = MakeSelectColumn(arg);
+        if ((type == AggregationType::SumAggregate || type == AggregationType::AvgAggregate) &&
+            column->GetReturnType() == TypeId::kTypeChar) {
+          throw std::logic_error("the function " + function + " takes a numeric column");
+        }
+        input = AddInputColumn(arg->val_, column);
+      }
+      aggregates_.emplace_back(type, input);
+      aggregate_outputs_.emplace_back(function + "(" + (arg->type_ == kNodeAllColumns ? "*" : arg->val_) + ")",
+                                      std::make_pair(1, aggregates_.size() - 1));
+    }
+  }
+
+  /**
+   * Bind the ORDER BY clause to the output columns. A column has to be in the select list, and be
+   * one of GROUP BY in an aggregating select.
+   */
+  void MakeOrderBy(pSyntaxNode ast) {
+    for (; ast != nullptr; ast = ast->next_) {
+      bool descending = ast->child_ != nullptr && strcasecmp(ast->child_->val_, "desc") == 0;
+      uint32_t col_idx = std::dynamic_pointer_cast<ColumnValueExpression>(MakeSelectColumn(ast))->GetColIdx();
+      auto is_column = [this, col_idx](uint32_t input) {
+        return std::dynamic_pointer_cast<ColumnValueExpression>(column_list_[input].second)->GetColIdx() == col_idx;
+      };
+      uint32_t output = 0;
+      uint32_t output_count = IsAggregate() ? aggregate_outputs_.size() : column_list_.size();
+      for (; output < output_count; output++) {
+        if (IsAggregate() ? aggregate_outputs_[output].second.first == 0 &&
+                                is_column(group_by_[aggregate_outputs_[output].second.second])
+                          : is_column(output)) {
+          break;
+        }
+      }
+      if (output == output_count) {
+        throw std::logic_error("the column " + std::string(ast->val_) + " must be in the select list to order by it");
+      }
+      order_by_.emplace_back(output, descending);
+    }
+  }
+
+  /** @return The column named by ast, of the table or of the joined row */
+  AbstractExpressionRef MakeSelectColumn(pSyntaxNode ast) {
+    return join_tables_.empty() ? MakeColumnValueExpression(table_name_, ast) : MakeJoinColumnExpression(ast->val_);
+  }
+
+  /** @return The position of column in column_list_, added under name if it is not there yet */
+  uint32_t AddInputColumn(const std::string &name, const AbstractExpressionRef &column) {
+    uint32_t col_idx = std::dynamic_pointer_cast<ColumnValueExpression>(column)->GetColIdx();
+    for (uint32_t i = 0; i < column_list_.size(); i++) {
+      if (std::dynamic_pointer_cast<ColumnValueExpression>(column_list_[i].second)->GetColIdx() == col_idx) {
+        return i;
+      }
+    }
+    column_list_.emplace_back(name, column);
+    return column_list_.size() - 1;
+  }
+
+  /** @return Whether the select computes aggregates, grouped or not */
+  bool IsAggregate() const { return !aggregate_outputs_.empty(); }
+
+  /**
+   * Bind the tables of a select from several tables and their ON conditions.
+   * @param ast The first child of kNodeJoin
+   */
+  void MakeJoin(pSyntaxNode ast) {
+    std::vector<pSyntaxNode> on_conditions;
+    for (; ast != nullptr; ast = ast->next_) {
+      if (ast->type_ == kNodeConditions) {
+        on_conditions.push_back(ast->child_);
+        continue;
+      }
+      TableInfo *info = nullptr;
+      if (context_->GetCatalog()->GetTable(ast->val_, info) != DB_SUCCESS) {
+        std::stringstream error_info;
+        error_info << "the table " << ast->val_ << " is not exist.";
+        throw std::logic_error(error_info.str());
+      }
+      if (std::find(join_tables_.begin(), join_tables_.end(), ast->val_) != join_tables_.end()) {
+        std::stringstream error_info;
+        error_info << "the table " << ast->val_ << " appears more than once.";
+        throw std::logic_error(error_info.str());
+      }
+      join_offsets_.push_back(join_tables_.empty()
+                                  ? 0
+                                  : join_offsets_.back() + GetTableSchema(join_tables_.size() - 1)->GetColumnCount());
+      join_tables_.push_back(ast->val_);
+    }
+    table_where_.resize(join_tables_.size());
+    table_column_in_condition_.resize(join_tables_.size());
+    // 内连接的ON条件和WHERE条件一样处理
+    for (auto condition : on_conditions) {
+      MakeJoinConditions(condition);
+    }
+  }
+
+  /**
+   * Split the conditions of a join at AND: a condition on one table goes to the where clause of
+   * that table, the others are kept in join_conditions_.
+   */
+  void MakeJoinConditions(pSyntaxNode ast) {
+    if (ast->type_ == kNodeConnector && !strcmp(ast->val_, "and")) {
+      MakeJoinConditions(ast->child_);
+      MakeJoinConditions(ast->child_->next_);
+      return;
+    }
+    std::set<size_t> tables;
+    CollectTables(ast, &tables);
+    if (tables.size() == 1) {
+      size_t table = *tables.begin();
+      auto predicate = MakePredicate(ast, join_tables_[table], &table_column_in_condition_[table]);
+      table_where_[table] = table_where_[table] == nullptr
+                                ? predicate
+                                : MakeLogicExpression(table_where_[table], predicate, LogicType::And);
+      return;
+    }
+    join_conditions_.push_back(MakeJoinPredicate(ast));
+  }
+
+  /** Add the tables of the columns in the conditions ast to tables */
+  void CollectTables(pSyntaxNode ast, std::set<size_t> *tables) {
+    if (ast->type_ == kNodeConnector) {
+      CollectTables(ast->child_, tables);
+      CollectTables(ast->child_->next_, tables);
+      return;
+    }
+    auto column = ResolveColumn(ast->child_->val_);
+    tables->insert(column.first);
+    pSyntaxNode value = ast->child_->next_;
+    if (value->type_ == kNodeIdentifier) {
+      auto other = ResolveColumn(value->val_);
+      if (other.first == column.first) {
+        throw std::logic_error("a column can only be compared with a column of another table");
+      }
+      tables->insert(other.first);
+    }
+  }
+
+  /** Make the predicate of conditions on several tables, over the columns of all tables in FROM order */
+  AbstractExpressionRef MakeJoinPredicate(pSyntaxNode ast) {
+    if (ast->type_ == kNodeConnector) {
+      auto left = MakeJoinPredicate(ast->child_);
+      auto right = MakeJoinPredicate(ast->child_->next_);
+      return MakeLogicExpression(left, right, LogicExpression::Char2Type(ast->val_));
+    }
+    auto col_expr = MakeJoinColumnExpression(ast->child_->val_);
+    pSyntaxNode value = ast->child_->next_;
+    if (value->type_ != kNodeIdentifier) {
+      return MakeComparisonExpression(col_expr, MakeConstantValueExpression(col_expr->GetReturnType(), value),
+                                      ast->val_);
+    }
+    auto other_expr = MakeJoinColumnExpression(value->val_);
+    if (other_expr->GetReturnType() != col_expr->GetReturnType()) {
+      throw std::logic_error("the columns compared are of different types");
+    }
+    return MakeComparisonExpression(col_expr, other_expr, ast->val_);
+  }
+
+  /** Bind the select list of a join, "*" is every column of every table named "table.column" */
+  void MakeJoinColumnList(pSyntaxNode ast) {
+    if (!ast) {
+      for (size_t table = 0; table < join_tables_.size(); table++) {
+        for (auto column : GetTableSchema(table)->GetColumns()) {
+          auto expr = std::make_shared<ColumnValueExpression>(0, join_offsets_[table] + column->GetTableInd(),
+                                                              column->GetType());
+          column_list_.emplace_back(make_pair(join_tables_[table] + "." + column->GetName(), expr));
+        }
+      }
+      return;
+    }
+    for (; ast != nullptr; ast = ast->next_) {
+      column_list_.emplace_back(make_pair(ast->val_, MakeJoinColumnExpression(ast->val_)));
+    }
+  }
+
+  /** @return The column named name, numbered over the columns of all tables in FROM order */
+  AbstractExpressionRef MakeJoinColumnExpression(const std::string &name) {
+    auto column = ResolveColumn(name);
+    auto type = GetTableSchema(column.first)->GetColumn(column.second)->GetType();
+    return std::make_shared<ColumnValueExpression>(0, join_offsets_[column.first] + column.second, type);
+  }
+
+  /**
+   * Find a column of the tables of a join.
+   * @param name "column", which only one of the tables may have, or "table.column"
+   * @return The position of its table in join_tables_ and its index in the table
+   */
+  std::pair<size_t, uint32_t> ResolveColumn(const std::string &name) {
+    auto dot = name.find('.');
+    std::string table_name = dot == std::string::npos ? "" : name.substr(0, dot);
+    std::string column_name = dot == std::string::npos ? name : name.substr(dot + 1);
+    std::pair<size_t, uint32_t> found{join_tables_.size(), 0};
+    for (size_t table = 0; table < join_tables_.size(); table++) {
+      uint32_t index;
+      if ((!table_name.empty() && table_name != join_tables_[table]) ||
+          GetTableSchema(table)->GetColumnIndex(column_name, index) != DB_SUCCESS) {
+        continue;
+      }
+      if (found.first != join_tables_.size()) {
+        throw std::logic_error("the column " + name + " is ambiguous");
+      }
+      found = {table, index};
+    }
+    if (found.first == join_tables_.size()) {
+      throw std::logic_error("the column " + name + " does not exist in the tables");
+    }
+    return found;
+  }
+
+  /** @return The schema of the table at position table of join_tables_ */
+  Schema *GetTableSchema(size_t table) {
+    TableInfo *info = nullptr;
+    context_->GetCatalog()->GetTable(join_tables_[table], info);
+    return info->GetSchema();
+  }
+
   /** Bound FROM clause. */
   std::string table_name_;
 
-  /** Bound SELECT list. */
+  /** Bound SELECT list; for an aggregating select the columns its groups and aggregates read. */
   std::vector<std::pair<std::string, AbstractExpressionRef>> column_list_;
 
+  /** Bound GROUP BY clause, positions in column_list_. */
+  std::vector<uint32_t> group_by_;
+
+  /** Aggregates of the select list: the function and the position of its column in column_list_ (0 for COUNT(*)) */
+  std::vector<std::pair<AggregationType, uint32_t>> aggregates_;
+
+  /** Name and source of each column of an aggregating select: (0, index in group_by_) or (1, index in aggregates_) */
+  std::vector<std::pair<std::string, std::pair<uint32_t, uint32_t>>> aggregate_outputs_;
+
+  /** Bound ORDER BY clause: an output column and whether it is descending, for each column to sort by. */
+  std::vector<std::pair<uint32_t, bool>> order_by_;
+
+  /** Columns of the ORDER BY clause, bound after the select list. */
+  pSyntaxNode order_by_ast_ = nullptr;
+
+  /** Bound LIMIT clause, -1 without limit. */
+  int64_t limit_ = -1;
+
+  /** Rows of the OFFSET clause skipped before the limit, 0 without offset. */
+  int64_t offset_ = 0;
+
   /** Index of columns in condition. */
   std::vector<uint32_t> column_in_condition_;
 
@@ -80,6 +413,20 @@ class SelectStatement : public AbstractStatement {
   /** Bound WHERE clause. */
   AbstractExpressionRef where_ = nullptr;
 
+  /** Tables of a select from several tables, in FROM order; empty for a single table */
+  std::vector<std::string> join_tables_;
+
+  /** Position of the first column of each table of join_tables_ in the joined row */
+  std::vector<uint32_t> join_offsets_;
+
+  /** Conditions on a single table of join_tables_, over its own columns */
+  std::vector<AbstractExpressionRef> table_where_;
+
+  std::vector<std::vector<uint32_t>> table_column_in_condition_;
+
+  /** AND-ed conditions on several tables of join_tables_, over the columns of the joined row */
+  std::vector<AbstractExpressionRef> join_conditions_;
+
   std::string ToString() const override {
     std::stringstream sstream;
     sstream << "Select {{\\n  table={" << table_name_ << "},\\n  columns={";
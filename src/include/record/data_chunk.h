@@ -0,0 +1,215 @@
+#ifndef MINISQL_DATA_CHUNK_H
+#define MINISQL_DATA_CHUNK_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/rowid.h"
+#include "record/field.h"
+#include "record/row.h"
+#include "record/schema.h"
+
+/**
+ * ColumnVector holds the values of one column for the rows of a DataChunk. Int and float values
+ * sit in a typed array, chars in one byte buffer with the offset of each value. A null value keeps
+ * a zero slot and is flagged in the null array.
+ */
+class ColumnVector {
+ public:
+  explicit ColumnVector(TypeId type) : type_(type) { Clear(); }
+
+  inline TypeId GetType() const { return type_; }
+
+  inline size_t GetSize() const { return nulls_.size(); }
+
+  /** Remove all values, keeping the memory */
+  void Clear();
+
+  void Reserve(size_t size);
+
+  void Append(const Field &field);
+
+  /**
+   * Decode one value written by Field::SerializeTo, nothing is stored for a null.
+   * @return Bytes read
+   */
+  uint32_t AppendSerialized(const char *buf, bool is_null);
+
+  /** Append the values of source at the selected positions */
+  void AppendSelected(const ColumnVector &source, const std::vector<uint32_t> &selection);
+
+  /** Append value i of source */
+  void AppendAt(const ColumnVector &source, size_t i);
+
+  /**
+   * Write value i the way AppendSerialized() reads it, nothing for a null.
+   * @return Bytes written
+   */
+  uint32_t SerializeAt(size_t i, char *buf) const;
+
+  /** @return Bytes SerializeAt() writes for value i */
+  uint32_t GetSerializedSize(size_t i) const;
+
+  /** @return Bytes taken by the values, for the memory budget of an operator */
+  size_t GetMemoryUsage() const;
+
+  inline bool IsNull(size_t i) const { return nulls_[i] != 0; }
+
+  inline const uint8_t *GetNulls() const { return nulls_.data(); }
+
+  inline const int32_t *GetInts() const { return ints_.data(); }
+
+  inline const float *GetFloats() const { return floats_.data(); }
+
+  inline const char *GetChars(size_t i) const { return chars_.data() + offsets_[i]; }
+
+  inline uint32_t GetLength(size_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+  /** @return Value i as a field owning a copy of its chars */
+  Field GetField(size_t i) const;
+
+  /**
+   * Keep the selected positions whose value compares true with constant, nulls never do.
+   * @param op Any operator but IsNull and NotNull, see SelectNull()
+   * @return false if the operator or the type of constant is not supported, selection is untouched
+   */
+  bool SelectCompare(CompareOp op, const Field &constant, std::vector<uint32_t> &selection) const;
+
+  /** Keep the selected positions that are null (is_null) or not null */
+  void SelectNull(bool is_null, std::vector<uint32_t> &selection) const;
+
+  /**
+   * Set bit i of bits if value i compares true with constant, nulls never do, see FilterKernels.
+   * @param op Any operator but IsNull and NotNull, see NullBitmap()
+   * @return false for a char column, a constant of another type or an unsupported operator
+   */
+  bool CompareBitmap(CompareOp op, const Field &constant, uint64_t *bits) const;
+
+  /**
+   * Set bit i of bits if lower <= value i <= upper, < instead of <= on a side that is not inclusive.
+   * @return false for a char column or bounds of another type
+   */
+  bool BetweenBitmap(const Field &lower, bool lower_inclusive, const Field &upper, bool upper_inclusive,
+                     uint64_t *bits) const;
+
+  /** Set bit i of bits if value i is null (is_null) or not null */
+  void NullBitmap(bool is_null, uint64_t *bits) const;
+
+ private:
+  TypeId type_;
+  std::vector<uint8_t> nulls_;
+  std::vector<int32_t> ints_;
+  std::vector<float> floats_;
+  /** Value i of a char column is chars_[offsets_[i], offsets_[i + 1]) */
+  std::vector<uint32_t> offsets_;
+  std::vector<char> chars_;
+};
+
+/**
+ * DataChunk is a batch of up to CAPACITY rows stored column by column, the unit the executors
+ * exchange through NextBatch(). Filters do not move values, they narrow the selection vector
+ * listing the positions of the rows that still qualify, in ascending order.
+ */
+class DataChunk {
+ public:
+  static constexpr size_t CAPACITY = 1024;
+
+  DataChunk() = default;
+
+  /**
+   * Empty the chunk for rows of schema, one vector per column. The vectors keep their memory while
+   * the schema stays the same. A chunk without schema takes its column types from the first row
+   * appended, a row without fields only counts.
+   */
+  void Reset(const Schema *schema);
+
+  inline const Schema *GetSchema() const { return schema_; }
+
+  /** @return Rows stored, selected or not */
+  inline size_t GetSize() const { return row_ids_.size(); }
+
+  inline bool IsFull() const { return row_ids_.size() >= CAPACITY; }
+
+  inline size_t GetColumnCount() const { return columns_.size(); }
+
+  inline const ColumnVector &GetColumn(uint32_t i) const { return columns_[i]; }
+
+  inline const RowId &GetRowId(size_t i) const { return row_ids_[i]; }
+
+  inline size_t GetSelectedCount() const { return selection_.size(); }
+
+  /** @return Position of the i-th selected row */
+  inline uint32_t GetSelected(size_t i) const { return selection_[i]; }
+
+  inline std::vector<uint32_t> &GetSelection() { return selection_; }
+
+  inline const std::vector<uint32_t> &GetSelection() const { return selection_; }
+
+  /** Keep the selected rows whose bit is set, bit i % 64 of bits[i / 64] for the row at position i */
+  void SelectBitmap(const uint64_t *bits);
+
+  /** Append a row, selected */
+  void AppendRow(const Row &row, const RowId &rid);
+
+  /**
+   * Append a row written by Row::SerializeTo with the schema of the chunk, selected.
+   * @return Bytes read
+   */
+  uint32_t AppendSerialized(const char *buf, const RowId &rid);
+
+  /**
+   * Append the selected rows of source, column i of this chunk taken from column column_map[i] of
+   * source. The rows appended are selected.
+   */
+  void AppendSelected(const DataChunk &source, const std::vector<uint32_t> &column_map);
+
+  /**
+   * Append the row at position pos of source, column i of this chunk taken from column column_map[i]
+   * of source. The row appended is selected, with the row id of the source row.
+   */
+  void AppendRowAt(const DataChunk &source, size_t pos, const std::vector<uint32_t> &column_map);
+
+  /**
+   * Append the joined rows of left and right: row k is made of the row at left_pos[k] of left and
+   * the row at right_pos[k] of right, column i of this chunk is column column_map[i].second of left
+   * if column_map[i].first is 0, of right otherwise. The rows appended are selected, without row id.
+   */
+  void AppendJoined(const DataChunk &left, const std::vector<uint32_t> &left_pos, const DataChunk &right,
+                    const std::vector<uint32_t> &right_pos,
+                    const std::vector<std::pair<uint32_t, uint32_t>> &column_map);
+
+  /**
+   * Write the row at position pos in the format of spilled rows: a null flag per column, then the
+   * values that are not null as Field::SerializeTo writes them. Unlike Row::SerializeTo it takes
+   * any number of columns.
+   * @return Bytes written
+   */
+  uint32_t PackRowAt(size_t pos, char *buf) const;
+
+  /** @return Bytes PackRowAt() writes for the row at position pos */
+  uint32_t GetPackedSize(size_t pos) const;
+
+  /**
+   * Append a row written by PackRowAt() from a chunk with the same columns, selected, without row id.
+   * @return Bytes read
+   */
+  uint32_t AppendPacked(const char *buf);
+
+  /** @return Bytes taken by the rows stored, for the memory budget of an operator */
+  size_t GetMemoryUsage() const;
+
+  /** Materialize the row at position pos, with its row id */
+  void GetRowAt(size_t pos, Row *row) const;
+
+  /** Materialize the i-th selected row, with its row id */
+  inline void GetRow(size_t i, Row *row) const { GetRowAt(selection_[i], row); }
+
+ private:
+  const Schema *schema_{nullptr};
+  std::vector<ColumnVector> columns_;
+  std::vector<RowId> row_ids_;
+  std::vector<uint32_t> selection_;
+};
+
+#endif  // MINISQL_DATA_CHUNK_H
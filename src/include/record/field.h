@@ -89,6 +89,12 @@ class Field {
 
   inline const char *GetData() const { return Type::GetInstance(type_id_)->GetData(*this); }
 
+  /** @return The value of a non null int field, read without going through its Type */
+  inline int32_t GetInteger() const { return value_.integer_; }
+
+  /** @return The value of a non null float field, read without going through its Type */
+  inline float GetFloat() const { return value_.float_; }
+
   inline uint32_t SerializeTo(char *buf) const { return Type::GetInstance(type_id_)->SerializeTo(*this, buf); }
 
   inline static uint32_t DeserializeFrom(char *buf, const TypeId type_id, Field **field, bool is_null) {
@@ -129,7 +135,7 @@ class Field {
     std::swap(first.manage_data_, second.manage_data_);
   }
 
-  std::string toString() {
+  std::string toString() const {
     if (is_null_)
       return "NULL";
     else if (type_id_ == kTypeInt)
@@ -0,0 +1,86 @@
+#ifndef MINISQL_FILTER_KERNELS_H
+#define MINISQL_FILTER_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "record/types.h"
+
+/**
+ * FilterKernels compare a column of values with constants and write the result as a selection
+ * bitmap: bit i % 64 of word i / 64 is set if row i matches, a null row (nulls[i] != 0) never does.
+ * Every word up to the last row is written and the bits after the last row are 0.
+ *
+ * There are two sets of kernels, AVX2 ones comparing 8 values per instruction and scalar ones;
+ * Get() picks the AVX2 kernels once if the CPU supports them.
+ */
+class FilterKernels {
+ public:
+  using CompareIntFunc = void (*)(const int32_t *values, const uint8_t *nulls, size_t size, CompareOp op,
+                                  int32_t constant, uint64_t *bits);
+  using CompareFloatFunc = void (*)(const float *values, const uint8_t *nulls, size_t size, CompareOp op,
+                                    float constant, uint64_t *bits);
+  using BetweenIntFunc = void (*)(const int32_t *values, const uint8_t *nulls, size_t size, int32_t lower,
+                                  bool lower_inclusive, int32_t upper, bool upper_inclusive, uint64_t *bits);
+  using BetweenFloatFunc = void (*)(const float *values, const uint8_t *nulls, size_t size, float lower,
+                                    bool lower_inclusive, float upper, bool upper_inclusive, uint64_t *bits);
+  using NotNullFunc = void (*)(const uint8_t *nulls, size_t size, uint64_t *bits);
+
+  FilterKernels(const char *name, CompareIntFunc compare_int, CompareFloatFunc compare_float,
+                BetweenIntFunc between_int, BetweenFloatFunc between_float, NotNullFunc not_null)
+      : name_(name),
+        compare_int_(compare_int),
+        compare_float_(compare_float),
+        between_int_(between_int),
+        between_float_(between_float),
+        not_null_(not_null) {}
+
+  /** @return The AVX2 kernels if the CPU supports AVX2, otherwise the scalar ones */
+  static const FilterKernels &Get();
+
+  static const FilterKernels &Scalar();
+
+  /** @return The AVX2 kernels, nullptr if this build or the CPU has no AVX2 */
+  static const FilterKernels *Avx2();
+
+  /** @return Words of a bitmap of size rows */
+  static size_t WordCount(size_t size) { return (size + 63) / 64; }
+
+  inline const char *GetName() const { return name_; }
+
+  /** @param op Any operator but IsNull and NotNull */
+  inline void CompareInt(const int32_t *values, const uint8_t *nulls, size_t size, CompareOp op, int32_t constant,
+                         uint64_t *bits) const {
+    compare_int_(values, nulls, size, op, constant, bits);
+  }
+
+  /** @param op Any operator but IsNull and NotNull */
+  inline void CompareFloat(const float *values, const uint8_t *nulls, size_t size, CompareOp op, float constant,
+                           uint64_t *bits) const {
+    compare_float_(values, nulls, size, op, constant, bits);
+  }
+
+  /** Rows with lower <= value <= upper, < instead of <= on a side that is not inclusive */
+  inline void BetweenInt(const int32_t *values, const uint8_t *nulls, size_t size, int32_t lower,
+                         bool lower_inclusive, int32_t upper, bool upper_inclusive, uint64_t *bits) const {
+    between_int_(values, nulls, size, lower, lower_inclusive, upper, upper_inclusive, bits);
+  }
+
+  inline void BetweenFloat(const float *values, const uint8_t *nulls, size_t size, float lower, bool lower_inclusive,
+                           float upper, bool upper_inclusive, uint64_t *bits) const {
+    between_float_(values, nulls, size, lower, lower_inclusive, upper, upper_inclusive, bits);
+  }
+
+  /** Rows that are not null */
+  inline void NotNull(const uint8_t *nulls, size_t size, uint64_t *bits) const { not_null_(nulls, size, bits); }
+
+ private:
+  const char *name_;
+  CompareIntFunc compare_int_;
+  CompareFloatFunc compare_float_;
+  BetweenIntFunc between_int_;
+  BetweenFloatFunc between_float_;
+  NotNullFunc not_null_;
+};
+
+#endif  // MINISQL_FILTER_KERNELS_H
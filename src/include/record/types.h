@@ -16,6 +16,9 @@ inline CmpBool GetCmpBool(bool boolean) {
   return boolean ? CmpBool::kTrue : CmpBool::kFalse;
 }
 
+/** Comparison operators of a condition, IsNull and NotNull ("is null", "not null") take no right operand */
+enum class CompareOp { Equal = 0, NotEqual, LessThan, LessThanEquals, GreaterThan, GreaterThanEquals, IsNull, NotNull };
+
 class Type {
  public:
   explicit Type(TypeId type_id) : type_id_(type_id) {}
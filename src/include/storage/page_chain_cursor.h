@@ -0,0 +1,35 @@
+#ifndef MINISQL_PAGE_CHAIN_CURSOR_H
+#define MINISQL_PAGE_CHAIN_CURSOR_H
+
+#include <mutex>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+
+/**
+ * PageChainCursor hands the pages of a table heap out to threads scanning it together, a run of
+ * consecutive pages at a time. Only the cursor follows TablePage::GetNextPageId(), under its latch;
+ * the threads read the tuples of the pages they got without it.
+ */
+class PageChainCursor {
+ public:
+  PageChainCursor(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id)
+      : buffer_pool_manager_(buffer_pool_manager), next_page_id_(first_page_id) {}
+
+  /**
+   * Take the next pages of the chain.
+   * @param[in] count Pages to take, fewer are taken at the end of the chain
+   * @param[out] pages The pages, in chain order
+   * @param[out] seq Number of the run, runs are numbered 0, 1, ... in chain order
+   * @return false if the chain has no page left
+   */
+  bool Next(size_t count, std::vector<page_id_t> *pages, size_t *seq);
+
+ private:
+  BufferPoolManager *buffer_pool_manager_;
+  std::mutex latch_;
+  page_id_t next_page_id_;
+  size_t next_seq_{0};
+};
+
+#endif  // MINISQL_PAGE_CHAIN_CURSOR_H
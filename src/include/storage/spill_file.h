@@ -0,0 +1,67 @@
+#ifndef MINISQL_SPILL_FILE_H
+#define MINISQL_SPILL_FILE_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/macros.h"
+#include "record/data_chunk.h"
+
+/**
+ * SpillFile is a run of temporary rows kept in pages of the buffer pool, for the operators whose
+ * input does not fit in their memory budget. Rows are appended in the format of
+ * DataChunk::PackRowAt(), then Rewind() and Read() return them in the same order. A page starts
+ * with its number of rows; the page being written is filled in memory, so a page is only pinned
+ * while it is copied to or from the buffer pool. The pages are deleted with the file.
+ */
+class SpillFile {
+ public:
+  SpillFile(BufferPoolManager *buffer_pool_manager, const Schema *schema);
+
+  ~SpillFile();
+
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /** Append the row at position pos of chunk, whose columns are those of the schema */
+  void AppendRowAt(const DataChunk &chunk, size_t pos);
+
+  /** Append the selected rows of chunk */
+  void Append(const DataChunk &chunk);
+
+  /** Write out the page being filled, the next Read() starts from the first row */
+  void Rewind();
+
+  /**
+   * Read the next rows into chunk until it is full.
+   * @return false after the last row
+   */
+  bool Read(DataChunk *chunk);
+
+  inline const Schema *GetSchema() const { return schema_; }
+
+  inline size_t GetRowCount() const { return row_count_; }
+
+  /** @return Bytes of the rows appended */
+  inline size_t GetByteCount() const { return byte_count_; }
+
+  inline size_t GetPageCount() const { return pages_.size(); }
+
+ private:
+  void WritePage();
+
+  BufferPoolManager *buffer_pool_manager_;
+  const Schema *schema_;
+  std::vector<page_id_t> pages_;
+  /** The page being written, or a copy of the page being read */
+  std::vector<char> buffer_;
+  uint32_t offset_;
+  uint32_t page_rows_{0};
+  size_t row_count_{0};
+  size_t byte_count_{0};
+  /** Position of the next row to read: page, offset in it and rows of the page left */
+  size_t read_page_{0};
+  uint32_t read_offset_{0};
+  uint32_t read_rows_{0};
+};
+
+#endif  // MINISQL_SPILL_FILE_H
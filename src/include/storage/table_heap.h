@@ -5,6 +5,7 @@
 #include "concurrency/lock_manager.h"
 #include "page/header_page.h"
 #include "page/table_page.h"
+#include "record/data_chunk.h"
 #include "recovery/log_manager.h"
 #include "storage/table_iterator.h"
 
@@ -40,7 +41,7 @@ class TableHeap {
 
   /**
    * if the new tuple is too large to fit in the old page, return false (will delete and insert)
-   * @param[in] row Tuple of new row
+   * @param[in/out] row Tuple of new row, the rid where it is stored is wrapped in object row
    * @param[in] rid Rid of the old tuple
    * @param[in] txn Txn performing the update
    * @return true is update is successful.
@@ -69,6 +70,37 @@ class TableHeap {
    */
   bool GetTuple(Row *row, Txn *txn);
 
+  /**
+   * Read the tuples of row ids that all lie on one page, fetching and latching the page once.
+   * @param[in] begin, end The row ids, in slot order
+   * @param[out] rows The tuples that exist are appended, in the order of the row ids
+   */
+  void GetTuples(std::vector<RowId>::const_iterator begin, std::vector<RowId>::const_iterator end,
+                 std::vector<Row> &rows, Txn *txn);
+
+  /**
+   * Decode the tuples of row ids that all lie on one page straight into chunk, whose schema is the
+   * schema of the table. Row ids whose tuple is gone are skipped.
+   */
+  void GetTuples(std::vector<RowId>::const_iterator begin, std::vector<RowId>::const_iterator end,
+                 DataChunk *chunk, Txn *txn);
+
+  /**
+   * Decode the live tuples from cursor on into chunk until it is full or the heap ends, without
+   * building rows. Each page is latched once per call.
+   * @param[in/out] cursor Position of the next tuple to read, starts at the first slot of the first
+   * page, its page id is INVALID_PAGE_ID after the last page
+   */
+  void ScanTuples(RowId *cursor, DataChunk *chunk, Txn *txn);
+
+  /**
+   * Decode the live tuples of one page from *slot on into chunk until it is full, without following
+   * the page chain; scans of different pages may run on different threads.
+   * @param[in/out] slot The next slot to read
+   * @return Whether the page has been read to its end
+   */
+  bool ScanPage(page_id_t page_id, uint32_t *slot, DataChunk *chunk, Txn *txn);
+
   void FreeTableHeap() {
     auto next_page_id = first_page_id_;
     while (next_page_id != INVALID_PAGE_ID) {
@@ -3,9 +3,11 @@
 
 #include "common/rowid.h"
 #include "concurrency/txn.h"
+#include "index/index_iterator.h"
 #include "record/row.h"
 
 class TableHeap;
+class ClusteredIndex;
 
 class TableIterator {
  public:
@@ -13,6 +15,9 @@ class TableIterator {
   
   explicit TableIterator(TableHeap *table_heap, Row* row, Txn *txn);
 
+  /** Iterator over the leaf entries of a clustered table, starting at iter. */
+  explicit TableIterator(ClusteredIndex *clustered_index, const IndexIterator &iter, Txn *txn);
+
   TableIterator(const TableIterator &other);
 
   virtual ~TableIterator();
@@ -31,10 +36,18 @@ class TableIterator {
 
   TableIterator operator++(int);
 
+  /** Page holding the current row, a heap page or a leaf of a clustered table. */
+  page_id_t GetPageId() const;
+
 private:
+  // 读出leaf_iter_指向的行，到达末尾时row_为空
+  void ReadClusteredRow();
+
   Row *row_;
   TableHeap *table_heap_;
   Txn *txn_;
+  ClusteredIndex *clustered_index_{nullptr};
+  IndexIterator leaf_iter_;
 };
 
 #endif  // MINISQL_TABLE_ITERATOR_H
@@ -0,0 +1,739 @@
+#include "index/adaptive_radix_tree.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common/macros.h"
+
+namespace {
+enum NodeType : uint8_t { kNode4, kNode16, kNode48, kNode256, kLeaf };
+}  // namespace
+
+struct AdaptiveRadixTree::Node {
+  uint8_t type;
+  uint16_t num_children{0};
+  uint32_t prefix_len{0};
+  uint8_t prefix[MAX_PREFIX_LEN]{};
+};
+
+struct AdaptiveRadixTree::Leaf : public AdaptiveRadixTree::Node {
+  std::string key;
+  RowId value;
+};
+
+namespace {
+using Node = AdaptiveRadixTree::Node;
+using Leaf = AdaptiveRadixTree::Leaf;
+constexpr uint32_t MAX_PREFIX_LEN = AdaptiveRadixTree::MAX_PREFIX_LEN;
+
+// keys are kept sorted in Node4 and Node16
+struct Node4 : public Node {
+  uint8_t keys[4]{};
+  Node *children[4]{};
+};
+
+struct Node16 : public Node {
+  uint8_t keys[16]{};
+  Node *children[16]{};
+};
+
+// child_index[byte] is the slot of the child plus 1, 0 if there is no child
+struct Node48 : public Node {
+  uint8_t child_index[256]{};
+  Node *children[48]{};
+};
+
+struct Node256 : public Node {
+  Node *children[256]{};
+};
+
+size_t NodeBytes(const Node *node) {
+  switch (node->type) {
+    case kNode4:
+      return sizeof(Node4);
+    case kNode16:
+      return sizeof(Node16);
+    case kNode48:
+      return sizeof(Node48);
+    case kNode256:
+      return sizeof(Node256);
+    default:
+      return sizeof(Leaf) + static_cast<const Leaf *>(node)->key.capacity();
+  }
+}
+
+Node **FindChild(Node *node, uint8_t byte) {
+  switch (node->type) {
+    case kNode4: {
+      auto n = static_cast<Node4 *>(node);
+      for (int i = 0; i < n->num_children; i++) {
+        if (n->keys[i] == byte) {
+          return &n->children[i];
+        }
+      }
+      return nullptr;
+    }
+    case kNode16: {
+      auto n = static_cast<Node16 *>(node);
+#if defined(__SSE2__)
+      // 16个key一次比较
+      __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i *>(n->keys)));
+      int mask = _mm_movemask_epi8(cmp) & ((1 << n->num_children) - 1);
+      return mask != 0 ? &n->children[__builtin_ctz(mask)] : nullptr;
+#else
+      for (int i = 0; i < n->num_children; i++) {
+        if (n->keys[i] == byte) {
+          return &n->children[i];
+        }
+      }
+      return nullptr;
+#endif
+    }
+    case kNode48: {
+      auto n = static_cast<Node48 *>(node);
+      return n->child_index[byte] != 0 ? &n->children[n->child_index[byte] - 1] : nullptr;
+    }
+    case kNode256: {
+      auto n = static_cast<Node256 *>(node);
+      return n->children[byte] != nullptr ? &n->children[byte] : nullptr;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+/*
+ * Positions of the children in key order: the index in the key array of Node4 / Node16,
+ * the key byte itself for Node48 / Node256.
+ */
+int LowerPos(const Node *node, int byte) {
+  switch (node->type) {
+    case kNode4: {
+      auto n = static_cast<const Node4 *>(node);
+      for (int i = 0; i < n->num_children; i++) {
+        if (n->keys[i] >= byte) {
+          return i;
+        }
+      }
+      return -1;
+    }
+    case kNode16: {
+      auto n = static_cast<const Node16 *>(node);
+      for (int i = 0; i < n->num_children; i++) {
+        if (n->keys[i] >= byte) {
+          return i;
+        }
+      }
+      return -1;
+    }
+    case kNode48: {
+      auto n = static_cast<const Node48 *>(node);
+      for (int b = byte; b < 256; b++) {
+        if (n->child_index[b] != 0) {
+          return b;
+        }
+      }
+      return -1;
+    }
+    case kNode256: {
+      auto n = static_cast<const Node256 *>(node);
+      for (int b = byte; b < 256; b++) {
+        if (n->children[b] != nullptr) {
+          return b;
+        }
+      }
+      return -1;
+    }
+    default:
+      return -1;
+  }
+}
+
+int NextPos(const Node *node, int pos) {
+  if (node->type == kNode4 || node->type == kNode16) {
+    return pos + 1 < node->num_children ? pos + 1 : -1;
+  }
+  return pos + 1 < 256 ? LowerPos(node, pos + 1) : -1;
+}
+
+uint8_t KeyAt(const Node *node, int pos) {
+  switch (node->type) {
+    case kNode4:
+      return static_cast<const Node4 *>(node)->keys[pos];
+    case kNode16:
+      return static_cast<const Node16 *>(node)->keys[pos];
+    default:
+      return static_cast<uint8_t>(pos);
+  }
+}
+
+const Node *ChildAt(const Node *node, int pos) {
+  switch (node->type) {
+    case kNode4:
+      return static_cast<const Node4 *>(node)->children[pos];
+    case kNode16:
+      return static_cast<const Node16 *>(node)->children[pos];
+    case kNode48: {
+      auto n = static_cast<const Node48 *>(node);
+      return n->children[n->child_index[pos] - 1];
+    }
+    default:
+      return static_cast<const Node256 *>(node)->children[pos];
+  }
+}
+
+const Leaf *Minimum(const Node *node) {
+  while (node->type != kLeaf) {
+    node = ChildAt(node, LowerPos(node, 0));
+  }
+  return static_cast<const Leaf *>(node);
+}
+
+void CopyHeader(Node *dst, const Node *src) {
+  dst->num_children = src->num_children;
+  dst->prefix_len = src->prefix_len;
+  memcpy(dst->prefix, src->prefix, MAX_PREFIX_LEN);
+}
+}  // namespace
+
+/*****************************************************************************
+ * ITERATOR
+ *****************************************************************************/
+const std::string &AdaptiveRadixTree::Iterator::Key() const {
+  return leaf_->key;
+}
+
+RowId AdaptiveRadixTree::Iterator::Value() const {
+  return leaf_->value;
+}
+
+AdaptiveRadixTree::Iterator &AdaptiveRadixTree::Iterator::operator++() {
+  Advance();
+  return *this;
+}
+
+void AdaptiveRadixTree::Iterator::PushMin(const Node *node) {
+  while (node->type != kLeaf) {
+    int pos = LowerPos(node, 0);
+    stack_.emplace_back(node, pos);
+    node = ChildAt(node, pos);
+  }
+  leaf_ = static_cast<const Leaf *>(node);
+}
+
+void AdaptiveRadixTree::Iterator::Advance() {
+  while (!stack_.empty()) {
+    auto &top = stack_.back();
+    int next = NextPos(top.first, top.second);
+    if (next >= 0) {
+      top.second = next;
+      PushMin(ChildAt(top.first, next));
+      return;
+    }
+    stack_.pop_back();
+  }
+  leaf_ = nullptr;
+}
+
+/*****************************************************************************
+ * ALLOCATION
+ *****************************************************************************/
+AdaptiveRadixTree::~AdaptiveRadixTree() {
+  Clear();
+}
+
+void AdaptiveRadixTree::Clear() {
+  FreeTree(root_);
+  root_ = nullptr;
+  size_ = 0;
+}
+
+Node *AdaptiveRadixTree::NewNode(uint8_t type) {
+  Node *node;
+  switch (type) {
+    case kNode4:
+      node = new Node4();
+      break;
+    case kNode16:
+      node = new Node16();
+      break;
+    case kNode48:
+      node = new Node48();
+      break;
+    default:
+      node = new Node256();
+      break;
+  }
+  node->type = type;
+  memory_ += NodeBytes(node);
+  return node;
+}
+
+Leaf *AdaptiveRadixTree::NewLeaf(const std::string &key, RowId value) {
+  auto leaf = new Leaf();
+  leaf->type = kLeaf;
+  leaf->key = key;
+  leaf->value = value;
+  memory_ += NodeBytes(leaf);
+  return leaf;
+}
+
+void AdaptiveRadixTree::FreeNode(Node *node) {
+  memory_ -= NodeBytes(node);
+  switch (node->type) {
+    case kNode4:
+      delete static_cast<Node4 *>(node);
+      break;
+    case kNode16:
+      delete static_cast<Node16 *>(node);
+      break;
+    case kNode48:
+      delete static_cast<Node48 *>(node);
+      break;
+    case kNode256:
+      delete static_cast<Node256 *>(node);
+      break;
+    default:
+      delete static_cast<Leaf *>(node);
+      break;
+  }
+}
+
+void AdaptiveRadixTree::FreeTree(Node *node) {
+  if (node == nullptr) {
+    return;
+  }
+  if (node->type != kLeaf) {
+    for (int pos = LowerPos(node, 0); pos >= 0; pos = NextPos(node, pos)) {
+      FreeTree(const_cast<Node *>(ChildAt(node, pos)));
+    }
+  }
+  FreeNode(node);
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+/*
+ * 路径压缩超过MAX_PREFIX_LEN的部分只在叶子处比较完整的key
+ */
+bool AdaptiveRadixTree::GetValue(const std::string &key, RowId &value) const {
+  Node *node = root_;
+  uint32_t depth = 0;
+  while (node != nullptr) {
+    if (node->type == kLeaf) {
+      auto leaf = static_cast<Leaf *>(node);
+      if (leaf->key != key) {
+        return false;
+      }
+      value = leaf->value;
+      return true;
+    }
+    if (node->prefix_len != 0) {
+      uint32_t len = std::min(node->prefix_len, MAX_PREFIX_LEN);
+      if (depth + len > key.size() || memcmp(node->prefix, key.data() + depth, len) != 0) {
+        return false;
+      }
+      depth += node->prefix_len;
+    }
+    if (depth >= key.size()) {
+      return false;
+    }
+    Node **child = FindChild(node, static_cast<uint8_t>(key[depth]));
+    if (child == nullptr) {
+      return false;
+    }
+    node = *child;
+    depth++;
+  }
+  return false;
+}
+
+AdaptiveRadixTree::Iterator AdaptiveRadixTree::Begin() const {
+  Iterator iter;
+  if (root_ != nullptr) {
+    iter.PushMin(root_);
+  }
+  return iter;
+}
+
+/*
+ * Walk down along key, the first subtree whose keys are all greater than key holds the result
+ * in its smallest leaf, a subtree whose keys are all less than key moves the iterator past it.
+ */
+AdaptiveRadixTree::Iterator AdaptiveRadixTree::LowerBound(const std::string &key) const {
+  Iterator iter;
+  const Node *node = root_;
+  uint32_t depth = 0;
+  if (node == nullptr) {
+    return iter;
+  }
+  while (true) {
+    if (node->type == kLeaf) {
+      auto leaf = static_cast<const Leaf *>(node);
+      if (leaf->key.compare(key) >= 0) {
+        iter.leaf_ = leaf;
+      } else {
+        iter.Advance();
+      }
+      return iter;
+    }
+    if (node->prefix_len != 0) {
+      const char *prefix = node->prefix_len <= MAX_PREFIX_LEN ? reinterpret_cast<const char *>(node->prefix)
+                                                               : Minimum(node)->key.data() + depth;
+      uint32_t len = std::min<uint32_t>(node->prefix_len, key.size() - depth);
+      int cmp = memcmp(prefix, key.data() + depth, len);
+      if (cmp > 0 || (cmp == 0 && len < node->prefix_len)) {
+        iter.PushMin(node);
+        return iter;
+      }
+      if (cmp < 0) {
+        iter.Advance();
+        return iter;
+      }
+      depth += node->prefix_len;
+    }
+    if (depth >= key.size()) {
+      iter.PushMin(node);
+      return iter;
+    }
+    auto byte = static_cast<uint8_t>(key[depth]);
+    int pos = LowerPos(node, byte);
+    if (pos < 0) {
+      iter.Advance();
+      return iter;
+    }
+    iter.stack_.emplace_back(node, pos);
+    const Node *child = ChildAt(node, pos);
+    if (KeyAt(node, pos) != byte) {
+      iter.PushMin(child);
+      return iter;
+    }
+    node = child;
+    depth++;
+  }
+}
+
+uint32_t AdaptiveRadixTree::PrefixMismatch(const Node *node, const std::string &key, uint32_t depth) const {
+  uint32_t limit = std::min<uint32_t>(node->prefix_len, key.size() - depth);
+  uint32_t i = 0;
+  for (uint32_t stored = std::min(limit, MAX_PREFIX_LEN); i < stored; i++) {
+    if (node->prefix[i] != static_cast<uint8_t>(key[depth + i])) {
+      return i;
+    }
+  }
+  if (node->prefix_len > MAX_PREFIX_LEN) {
+    // 超出部分从子树中任意一个叶子的key中读取
+    const Leaf *leaf = Minimum(node);
+    for (; i < limit; i++) {
+      if (leaf->key[depth + i] != key[depth + i]) {
+        return i;
+      }
+    }
+  }
+  return i;
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+bool AdaptiveRadixTree::Insert(const std::string &key, RowId value) {
+  if (!Insert(root_, key, 0, value)) {
+    return false;
+  }
+  size_++;
+  return true;
+}
+
+bool AdaptiveRadixTree::Insert(Node *&ref, const std::string &key, uint32_t depth, RowId value) {
+  Node *node = ref;
+  if (node == nullptr) {
+    ref = NewLeaf(key, value);
+    return true;
+  }
+  if (node->type == kLeaf) {
+    auto leaf = static_cast<Leaf *>(node);
+    if (leaf->key == key) {
+      return false;
+    }
+    // 两个key的公共部分成为新节点的压缩路径
+    uint32_t limit = std::min(leaf->key.size(), key.size());
+    uint32_t lcp = 0;
+    while (depth + lcp < limit && leaf->key[depth + lcp] == key[depth + lcp]) {
+      lcp++;
+    }
+    ASSERT(depth + lcp < limit, "Radix tree keys must be prefix free.");
+    Node *new_node = NewNode(kNode4);
+    new_node->prefix_len = lcp;
+    memcpy(new_node->prefix, key.data() + depth, std::min(lcp, MAX_PREFIX_LEN));
+    AddChild(new_node, static_cast<uint8_t>(leaf->key[depth + lcp]), leaf);
+    AddChild(new_node, static_cast<uint8_t>(key[depth + lcp]), NewLeaf(key, value));
+    ref = new_node;
+    return true;
+  }
+  if (node->prefix_len != 0) {
+    uint32_t mismatch = PrefixMismatch(node, key, depth);
+    if (mismatch < node->prefix_len) {
+      // 压缩路径在mismatch处分叉
+      Node *new_node = NewNode(kNode4);
+      new_node->prefix_len = mismatch;
+      memcpy(new_node->prefix, node->prefix, std::min(mismatch, MAX_PREFIX_LEN));
+      uint8_t edge;
+      if (node->prefix_len <= MAX_PREFIX_LEN) {
+        edge = node->prefix[mismatch];
+        node->prefix_len -= mismatch + 1;
+        memmove(node->prefix, node->prefix + mismatch + 1, node->prefix_len);
+      } else {
+        const Leaf *leaf = Minimum(node);
+        edge = static_cast<uint8_t>(leaf->key[depth + mismatch]);
+        node->prefix_len -= mismatch + 1;
+        memcpy(node->prefix, leaf->key.data() + depth + mismatch + 1, std::min(node->prefix_len, MAX_PREFIX_LEN));
+      }
+      AddChild(new_node, edge, node);
+      AddChild(new_node, static_cast<uint8_t>(key[depth + mismatch]), NewLeaf(key, value));
+      ref = new_node;
+      return true;
+    }
+    depth += node->prefix_len;
+  }
+  ASSERT(depth < key.size(), "Radix tree keys must be prefix free.");
+  Node **child = FindChild(node, static_cast<uint8_t>(key[depth]));
+  if (child != nullptr) {
+    return Insert(*child, key, depth + 1, value);
+  }
+  AddChild(ref, static_cast<uint8_t>(key[depth]), NewLeaf(key, value));
+  return true;
+}
+
+void AdaptiveRadixTree::AddChild(Node *&ref, uint8_t byte, Node *child) {
+  switch (ref->type) {
+    case kNode4: {
+      auto n = static_cast<Node4 *>(ref);
+      if (n->num_children < 4) {
+        int i = 0;
+        while (i < n->num_children && n->keys[i] < byte) {
+          i++;
+        }
+        memmove(n->keys + i + 1, n->keys + i, n->num_children - i);
+        memmove(n->children + i + 1, n->children + i, (n->num_children - i) * sizeof(Node *));
+        n->keys[i] = byte;
+        n->children[i] = child;
+        n->num_children++;
+        return;
+      }
+      auto grown = static_cast<Node16 *>(NewNode(kNode16));
+      CopyHeader(grown, n);
+      memcpy(grown->keys, n->keys, sizeof(n->keys));
+      memcpy(grown->children, n->children, sizeof(n->children));
+      FreeNode(n);
+      ref = grown;
+      break;
+    }
+    case kNode16: {
+      auto n = static_cast<Node16 *>(ref);
+      if (n->num_children < 16) {
+        int i = 0;
+        while (i < n->num_children && n->keys[i] < byte) {
+          i++;
+        }
+        memmove(n->keys + i + 1, n->keys + i, n->num_children - i);
+        memmove(n->children + i + 1, n->children + i, (n->num_children - i) * sizeof(Node *));
+        n->keys[i] = byte;
+        n->children[i] = child;
+        n->num_children++;
+        return;
+      }
+      auto grown = static_cast<Node48 *>(NewNode(kNode48));
+      CopyHeader(grown, n);
+      for (int i = 0; i < 16; i++) {
+        grown->children[i] = n->children[i];
+        grown->child_index[n->keys[i]] = i + 1;
+      }
+      FreeNode(n);
+      ref = grown;
+      break;
+    }
+    case kNode48: {
+      auto n = static_cast<Node48 *>(ref);
+      if (n->num_children < 48) {
+        int slot = 0;
+        while (n->children[slot] != nullptr) {
+          slot++;
+        }
+        n->children[slot] = child;
+        n->child_index[byte] = slot + 1;
+        n->num_children++;
+        return;
+      }
+      auto grown = static_cast<Node256 *>(NewNode(kNode256));
+      CopyHeader(grown, n);
+      for (int b = 0; b < 256; b++) {
+        if (n->child_index[b] != 0) {
+          grown->children[b] = n->children[n->child_index[b] - 1];
+        }
+      }
+      FreeNode(n);
+      ref = grown;
+      break;
+    }
+    default: {
+      auto n = static_cast<Node256 *>(ref);
+      n->children[byte] = child;
+      n->num_children++;
+      return;
+    }
+  }
+  // 节点已换成更大的类型
+  AddChild(ref, byte, child);
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+bool AdaptiveRadixTree::Remove(const std::string &key) {
+  if (!Remove(root_, key, 0)) {
+    return false;
+  }
+  size_--;
+  return true;
+}
+
+bool AdaptiveRadixTree::Remove(Node *&ref, const std::string &key, uint32_t depth) {
+  Node *node = ref;
+  if (node == nullptr) {
+    return false;
+  }
+  if (node->type == kLeaf) {
+    if (static_cast<Leaf *>(node)->key != key) {
+      return false;
+    }
+    FreeNode(node);
+    ref = nullptr;
+    return true;
+  }
+  if (node->prefix_len != 0) {
+    if (PrefixMismatch(node, key, depth) != node->prefix_len) {
+      return false;
+    }
+    depth += node->prefix_len;
+  }
+  if (depth >= key.size()) {
+    return false;
+  }
+  auto byte = static_cast<uint8_t>(key[depth]);
+  Node **child = FindChild(node, byte);
+  if (child == nullptr) {
+    return false;
+  }
+  if ((*child)->type != kLeaf) {
+    return Remove(*child, key, depth + 1);
+  }
+  if (static_cast<Leaf *>(*child)->key != key) {
+    return false;
+  }
+  Node *leaf = *child;
+  RemoveChild(ref, byte);
+  FreeNode(leaf);
+  return true;
+}
+
+void AdaptiveRadixTree::RemoveChild(Node *&ref, uint8_t byte) {
+  switch (ref->type) {
+    case kNode4: {
+      auto n = static_cast<Node4 *>(ref);
+      int i = 0;
+      while (n->keys[i] != byte) {
+        i++;
+      }
+      memmove(n->keys + i, n->keys + i + 1, n->num_children - i - 1);
+      memmove(n->children + i, n->children + i + 1, (n->num_children - i - 1) * sizeof(Node *));
+      n->num_children--;
+      if (n->num_children > 1) {
+        return;
+      }
+      // 只剩一个孩子时把本节点的路径并入孩子
+      Node *child = n->children[0];
+      if (child->type != kLeaf) {
+        uint8_t prefix[MAX_PREFIX_LEN];
+        uint32_t len = std::min(n->prefix_len, MAX_PREFIX_LEN);
+        memcpy(prefix, n->prefix, len);
+        if (len < MAX_PREFIX_LEN) {
+          prefix[len++] = n->keys[0];
+        }
+        uint32_t copy = std::min(child->prefix_len, MAX_PREFIX_LEN - len);
+        memcpy(prefix + len, child->prefix, copy);
+        memcpy(child->prefix, prefix, len + copy);
+        child->prefix_len += n->prefix_len + 1;
+      }
+      FreeNode(n);
+      ref = child;
+      return;
+    }
+    case kNode16: {
+      auto n = static_cast<Node16 *>(ref);
+      int i = 0;
+      while (n->keys[i] != byte) {
+        i++;
+      }
+      memmove(n->keys + i, n->keys + i + 1, n->num_children - i - 1);
+      memmove(n->children + i, n->children + i + 1, (n->num_children - i - 1) * sizeof(Node *));
+      n->num_children--;
+      if (n->num_children > 3) {
+        return;
+      }
+      auto shrunk = static_cast<Node4 *>(NewNode(kNode4));
+      CopyHeader(shrunk, n);
+      memcpy(shrunk->keys, n->keys, n->num_children);
+      memcpy(shrunk->children, n->children, n->num_children * sizeof(Node *));
+      FreeNode(n);
+      ref = shrunk;
+      return;
+    }
+    case kNode48: {
+      auto n = static_cast<Node48 *>(ref);
+      n->children[n->child_index[byte] - 1] = nullptr;
+      n->child_index[byte] = 0;
+      n->num_children--;
+      if (n->num_children > 12) {
+        return;
+      }
+      auto shrunk = static_cast<Node16 *>(NewNode(kNode16));
+      CopyHeader(shrunk, n);
+      int count = 0;
+      for (int b = 0; b < 256; b++) {
+        if (n->child_index[b] != 0) {
+          shrunk->keys[count] = static_cast<uint8_t>(b);
+          shrunk->children[count++] = n->children[n->child_index[b] - 1];
+        }
+      }
+      FreeNode(n);
+      ref = shrunk;
+      return;
+    }
+    default: {
+      auto n = static_cast<Node256 *>(ref);
+      n->children[byte] = nullptr;
+      n->num_children--;
+      if (n->num_children > 37) {
+        return;
+      }
+      auto shrunk = static_cast<Node48 *>(NewNode(kNode48));
+      CopyHeader(shrunk, n);
+      int count = 0;
+      for (int b = 0; b < 256; b++) {
+        if (n->children[b] != nullptr) {
+          shrunk->children[count] = n->children[b];
+          shrunk->child_index[b] = ++count;
+        }
+      }
+      FreeNode(n);
+      ref = shrunk;
+      return;
+    }
+  }
+}
@@ -0,0 +1,142 @@
+#include "index/art_index.h"
+
+#include <cstring>
+
+namespace {
+void AppendBigEndian(std::string &buf, uint64_t value, int bytes) {
+  for (int i = bytes - 1; i >= 0; i--) {
+    buf.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+  }
+}
+}  // namespace
+
+ArtIndex::ArtIndex(index_id_t index_id, IndexSchema *key_schema, bool unique)
+    : Index(index_id, key_schema), unique_(unique) {}
+
+std::string ArtIndex::EncodeKey(const Row &key, Schema *key_schema) {
+  ASSERT(key.GetFieldCount() == key_schema->GetColumnCount(), "field nums not match.");
+  std::string buf;
+  for (uint32_t i = 0; i < key.GetFieldCount(); i++) {
+    Field *field = key.GetField(i);
+    if (field->IsNull()) {
+      buf.push_back('\0');
+      continue;
+    }
+    buf.push_back('\1');
+    switch (field->GetTypeId()) {
+      case TypeId::kTypeInt: {
+        int32_t value;
+        field->SerializeTo(reinterpret_cast<char *>(&value));
+        AppendBigEndian(buf, static_cast<uint32_t>(value) ^ 0x80000000u, 4);
+        break;
+      }
+      case TypeId::kTypeFloat: {
+        float value;
+        field->SerializeTo(reinterpret_cast<char *>(&value));
+        // -0.0和0.0相等，编码也要相同
+        if (value == 0) {
+          value = 0;
+        }
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(uint32_t));
+        bits = (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+        AppendBigEndian(buf, bits, 4);
+        break;
+      }
+      case TypeId::kTypeChar: {
+        const char *data = field->GetData();
+        for (uint32_t j = 0; j < field->GetLength(); j++) {
+          buf.push_back(data[j]);
+          if (data[j] == '\0') {
+            buf.push_back('\xFF');
+          }
+        }
+        buf.append(2, '\0');
+        break;
+      }
+      default:
+        ASSERT(false, "Unsupported key type.");
+    }
+  }
+  return buf;
+}
+
+std::string ArtIndex::MakeKey(const Row &key, RowId row_id) const {
+  std::string buf = EncodeKey(key, key_schema_);
+  if (!unique_) {
+    AppendBigEndian(buf, static_cast<uint64_t>(row_id.Get()) ^ (1ull << 63), 8);
+  }
+  return buf;
+}
+
+dberr_t ArtIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
+  if (!container_.Insert(MakeKey(key, row_id), row_id)) {
+    return DB_FAILED;
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t ArtIndex::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
+  container_.Remove(MakeKey(key, row_id));
+  return DB_SUCCESS;
+}
+
+AdaptiveRadixTree::Iterator ArtIndex::GetLowerBoundIterator(const Row &key) const {
+  return container_.LowerBound(EncodeKey(key, key_schema_));
+}
+
+AdaptiveRadixTree::Iterator ArtIndex::UpperBound(const std::string &key) const {
+  auto iter = container_.LowerBound(key);
+  while (!iter.IsEnd() && iter.Key().compare(0, key.size(), key) == 0) {
+    ++iter;
+  }
+  return iter;
+}
+
+/*
+ * Same half-open ranges [lower, upper) as BPlusTreeIndex::ScanKey, entries whose first
+ * column is null sort first and never satisfy a comparison.
+ */
+dberr_t ArtIndex::ScanKey(const Row &key, std::vector<RowId> &result, Txn *txn, std::string compare_operator) {
+  if (key.GetFieldCount() == 0 || key.GetField(0)->IsNull()) {
+    return DB_KEY_NOT_FOUND;
+  }
+  std::string target = EncodeKey(key, key_schema_);
+  auto collect = [&result](AdaptiveRadixTree::Iterator iter, const AdaptiveRadixTree::Iterator &stop) {
+    for (; iter != stop; ++iter) {
+      result.emplace_back(iter.Value());
+    }
+  };
+  auto end_iter = container_.End();
+  auto non_null_begin = container_.LowerBound(std::string(1, '\1'));
+  if (compare_operator == "=") {
+    RowId row_id;
+    if (unique_) {
+      if (container_.GetValue(target, row_id)) {
+        result.push_back(row_id);
+      }
+    } else {
+      collect(container_.LowerBound(target), UpperBound(target));
+    }
+  } else if (compare_operator == ">") {
+    collect(UpperBound(target), end_iter);
+  } else if (compare_operator == ">=") {
+    collect(container_.LowerBound(target), end_iter);
+  } else if (compare_operator == "<") {
+    collect(non_null_begin, container_.LowerBound(target));
+  } else if (compare_operator == "<=") {
+    collect(non_null_begin, UpperBound(target));
+  } else if (compare_operator == "<>") {
+    collect(non_null_begin, container_.LowerBound(target));
+    collect(UpperBound(target), end_iter);
+  }
+  if (!result.empty())
+    return DB_SUCCESS;
+  else
+    return DB_KEY_NOT_FOUND;
+}
+
+dberr_t ArtIndex::Destroy() {
+  container_.Clear();
+  return DB_SUCCESS;
+}
@@ -1,5 +1,6 @@
 #include "index/b_plus_tree.h"
 
+#include <algorithm>
 #include <string>
 
 #include "glog/logging.h"
@@ -13,12 +14,7 @@ BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager
       processor_(KM),
       leaf_max_size_(leaf_max_size),
       internal_max_size_(internal_max_size) {
-  if (leaf_max_size_ == UNDEFINED_SIZE) {
-    leaf_max_size_ = (PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / (KM.GetKeySize() + sizeof(RowId)) - 1;
-  }
-  if (internal_max_size_ == UNDEFINED_SIZE) {
-    internal_max_size_ = leaf_max_size_;
-  }
+  // 未指定max size时页按字节数决定是否分裂/合并，key变长存储
   // leaf_max_size_ = 4; // for debug
   // internal_max_size_ = 4; // for debug
   auto page = reinterpret_cast<IndexRootsPage *>(buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID)->GetData());
@@ -28,8 +24,13 @@ BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager
   buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
 }
 
+BPlusTree::~BPlusTree() {
+  ReleasePinnedPages();
+}
+
 void BPlusTree::Destroy(page_id_t current_page_id) {
   if (current_page_id == INVALID_PAGE_ID) {
+    ReleasePinnedPages();
     current_page_id = root_page_id_;
   }
   if (current_page_id == INVALID_PAGE_ID) {
@@ -37,7 +38,7 @@ void BPlusTree::Destroy(page_id_t current_page_id) {
   }
   auto page = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(current_page_id)->GetData());
   if (!page->IsLeafPage()) {
-    auto internal_page = reinterpret_cast<InternalPage *>(buffer_pool_manager_->FetchPage(current_page_id)->GetData());
+    auto internal_page = reinterpret_cast<InternalPage *>(page);
     for (int i = 0; i < internal_page->GetSize(); i++) {
       Destroy(internal_page->ValueAt(i));
     }
@@ -46,6 +47,7 @@ void BPlusTree::Destroy(page_id_t current_page_id) {
     auto root_page = reinterpret_cast<IndexRootsPage *>(buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID)->GetData());
     root_page->Delete(index_id_);
     buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+    root_page_id_ = INVALID_PAGE_ID;
   }
   buffer_pool_manager_->UnpinPage(current_page_id, false);
   buffer_pool_manager_->DeletePage(current_page_id);
@@ -70,6 +72,7 @@ bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn
   if (IsEmpty()) {
     return false;
   }
+  PinUpperLevels();
   auto page = FindLeafPage(key, root_page_id_);
   auto leaf_page = reinterpret_cast<BPlusTreeLeafPage *>(page->GetData());
   RowId value;
@@ -90,8 +93,8 @@ bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn
  * Insert constant key & value pair into b+ tree
  * if current tree is empty, start new tree, update root page id and insert
  * entry, otherwise insert into leaf page.
- * @return: since we only support unique key, if user try to insert duplicate
- * keys return false, otherwise return true.
+ * @return: if user try to insert duplicate keys return false, otherwise return
+ * true. Non-unique indexes make keys distinct with a row id suffix (see KeyManager).
  */
 bool BPlusTree::Insert(GenericKey *key, const RowId &value, Txn *transaction) {
   if (IsEmpty()) {
@@ -111,7 +114,7 @@ void BPlusTree::StartNewTree(GenericKey *key, const RowId &value) {
   auto page = buffer_pool_manager_->NewPage(root_page_id_);
   ASSERT(page != nullptr, "out of memory");
   auto leaf_page = reinterpret_cast<BPlusTreeLeafPage *>(page->GetData());
-  leaf_page->Init(page->GetPageId(), INVALID_PAGE_ID, processor_.GetKeySize(), leaf_max_size_);
+  leaf_page->Init(page->GetPageId(), INVALID_PAGE_ID, processor_.GetKeySize(), leaf_max_size_, KeyTail(), processor_.IsIntKey());
   leaf_page->Insert(key, value, processor_);
   // root page id更新
   UpdateRootPageId(1);
@@ -123,8 +126,8 @@ void BPlusTree::StartNewTree(GenericKey *key, const RowId &value) {
  * User needs to first find the right leaf page as insertion target, then look
  * through leaf page to see whether insert key exist or not. If exist, return
  * immediately, otherwise insert entry. Remember to deal with split if necessary.
- * @return: since we only support unique key, if user try to insert duplicate
- * keys return false, otherwise return true.
+ * @return: if user try to insert duplicate keys return false, otherwise return
+ * true. Non-unique indexes make keys distinct with a row id suffix (see KeyManager).
  */
 bool BPlusTree::InsertIntoLeaf(GenericKey *key, const RowId &value, Txn *transaction) {
   if (IsEmpty()) {
@@ -138,15 +141,29 @@ bool BPlusTree::InsertIntoLeaf(GenericKey *key, const RowId &value, Txn *transac
     buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
     return false;
   }
-  // 没有这个key，插入并处理split
-  leaf_page->Insert(key, value, processor_);
-  if (leaf_page->GetSize() > leaf_page->GetMaxSize()) {
+  // 没有这个key，放不下时先split，再插入到key所属的那一半
+  if (!leaf_page->HasRoomFor(key)) {
+    ReleasePinnedPages();
+  }
+  while (!leaf_page->HasRoomFor(key)) {
     auto new_page = Split(leaf_page, transaction);
     new_page->SetNextPageId(leaf_page->GetNextPageId());
     leaf_page->SetNextPageId(new_page->GetPageId());
-    InsertIntoParent(leaf_page, new_page->KeyAt(0), new_page, transaction);
-    buffer_pool_manager_->UnpinPage(new_page->GetPageId(), true);
+    // 父节点中只需要一个能区分两页的最短key
+    GenericKey *separator = processor_.InitKey();
+    KeyBuffer left(processor_.GetKeySize()), right(processor_.GetKeySize());
+    processor_.ShortestSeparator(leaf_page->KeyAt(leaf_page->GetSize() - 1, left.Get()), new_page->KeyAt(0, right.Get()),
+                                 separator);
+    InsertIntoParent(leaf_page, separator, new_page, transaction);
+    if (processor_.CompareKeys(key, separator) >= 0) {
+      buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), true);
+      leaf_page = new_page;
+    } else {
+      buffer_pool_manager_->UnpinPage(new_page->GetPageId(), true);
+    }
+    free(separator);
   }
+  leaf_page->Insert(key, value, processor_);
   buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), true);
   return true;
 }
@@ -162,7 +179,7 @@ BPlusTreeInternalPage *BPlusTree::Split(InternalPage *node, Txn *transaction) {
   // new过调用完之后要unpin
   auto recipient = reinterpret_cast<BPlusTreeInternalPage *>(buffer_pool_manager_->NewPage(new_page_id)->GetData());
   ASSERT(recipient != nullptr, "out of memory");
-  recipient->Init(new_page_id, node->GetParentPageId(), processor_.GetKeySize(), internal_max_size_);
+  recipient->Init(new_page_id, node->GetParentPageId(), processor_.GetKeySize(), internal_max_size_, KeyTail(), processor_.IsIntKey());
   node->MoveHalfTo(recipient, buffer_pool_manager_);
   return recipient;
 }
@@ -172,7 +189,7 @@ BPlusTreeLeafPage *BPlusTree::Split(LeafPage *node, Txn *transaction) {
   // new过调用完之后要unpin
   auto recipient = reinterpret_cast<BPlusTreeLeafPage *>(buffer_pool_manager_->NewPage(new_page_id)->GetData());
   ASSERT(recipient != nullptr, "out of memory");
-  recipient->Init(new_page_id, node->GetParentPageId(), processor_.GetKeySize(), leaf_max_size_);
+  recipient->Init(new_page_id, node->GetParentPageId(), processor_.GetKeySize(), leaf_max_size_, KeyTail(), processor_.IsIntKey());
   node->MoveHalfTo(recipient);
   return recipient;
 }
@@ -192,22 +209,33 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
     auto new_root_page = reinterpret_cast<BPlusTreeInternalPage *>(buffer_pool_manager_->NewPage(root_page_id_)->GetData());
     ASSERT(new_root_page != nullptr, "out of memory");
     UpdateRootPageId(0);
-    new_root_page->Init(root_page_id_, INVALID_PAGE_ID, processor_.GetKeySize(), internal_max_size_);
+    new_root_page->Init(root_page_id_, INVALID_PAGE_ID, processor_.GetKeySize(), internal_max_size_, KeyTail(), processor_.IsIntKey());
     new_root_page->PopulateNewRoot(old_node->GetPageId(), key, new_node->GetPageId());
     old_node->SetParentPageId(root_page_id_);
     new_node->SetParentPageId(root_page_id_);
     buffer_pool_manager_->UnpinPage(root_page_id_, true);
   } else {
-    // 不是根，如果父节点满了，要递归split
+    // 不是根，如果父节点放不下，先递归split
+    GenericKey *separator = processor_.InitKey();
+    memcpy(separator, key, processor_.GetKeySize());
     page_id_t parent_page_id = old_node->GetParentPageId();
     auto parent_page = reinterpret_cast<BPlusTreeInternalPage *>(buffer_pool_manager_->FetchPage(parent_page_id)->GetData());
-    parent_page->InsertNodeAfter(old_node->GetPageId(), key, new_node->GetPageId());
-    if (parent_page->GetSize() > parent_page->GetMaxSize()) {
+    while (!parent_page->HasRoomFor(separator)) {
       auto new_page = Split(parent_page, transaction);
-      InsertIntoParent(parent_page, new_page->KeyAt(0), new_page, transaction);
-      buffer_pool_manager_->UnpinPage(new_page->GetPageId(), true);
+      KeyBuffer first(processor_.GetKeySize());
+      InsertIntoParent(parent_page, new_page->KeyAt(0, first.Get()), new_page, transaction);
+      // old_node被移到右半边时，新的节点也插到右半边
+      if (new_page->ValueIndex(old_node->GetPageId()) != -1) {
+        buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
+        parent_page = new_page;
+      } else {
+        buffer_pool_manager_->UnpinPage(new_page->GetPageId(), true);
+      }
     }
-    buffer_pool_manager_->UnpinPage(parent_page_id, true);
+    parent_page->InsertNodeAfter(old_node->GetPageId(), separator, new_node->GetPageId());
+    new_node->SetParentPageId(parent_page->GetPageId());
+    buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
+    free(separator);
   }
 }
 
@@ -233,15 +261,147 @@ void BPlusTree::Remove(const GenericKey *key, Txn *transaction) {
     return;
   }
   leaf_page->RemoveAndDeleteRecord(key, processor_);
-  if (leaf_page->GetSize() < leaf_page->GetMinSize()) {
+  if (leaf_page->IsUnderflow()) {
+    ReleasePinnedPages();
     CoalesceOrRedistribute(leaf_page, transaction);
   }
   buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), true);
 }
 
-/* 
- * User needs to first find the sibling of input page. If sibling's size + input
- * page's size > page's max size, then redistribute. Otherwise, merge.
+/*****************************************************************************
+ * BATCH
+ *****************************************************************************/
+/*
+ * Point lookups, or range lookups [keys[i], high_keys[i]] when high_keys is given. A range
+ * may continue on the next leaves, the cursor then loses the separators and the next key
+ * starts from the root again.
+ */
+void BPlusTree::GetValues(const std::vector<GenericKey *> &keys, std::vector<std::vector<RowId>> &results,
+                          const std::vector<GenericKey *> *high_keys, Txn *transaction) {
+  results.resize(keys.size());
+  if (IsEmpty()) {
+    return;
+  }
+  PinUpperLevels();
+  LeafCursor cursor(processor_.GetKeySize());
+  KeyBuffer key_buf(processor_.GetKeySize());
+  for (size_t i = 0; i < keys.size(); i++) {
+    auto leaf_page = SeekLeaf(cursor, keys[i]);
+    if (high_keys == nullptr) {
+      RowId value;
+      if (leaf_page->Lookup(keys[i], value, processor_)) {
+        results[i].push_back(value);
+      }
+      continue;
+    }
+    GenericKey *high_key = (*high_keys)[i];
+    int index = leaf_page->KeyIndex(keys[i], processor_);
+    while (true) {
+      if (index < leaf_page->GetSize()) {
+        if (processor_.CompareKeys(leaf_page->KeyAt(index, key_buf.Get()), high_key) > 0) {
+          break;
+        }
+        results[i].push_back(leaf_page->ValueAt(index++));
+        continue;
+      }
+      // 读到页尾，范围在右边界之前结束时不用看下一页
+      if (cursor.fenced && cursor.has_high && processor_.CompareKeys(high_key, cursor.high) < 0) {
+        break;
+      }
+      page_id_t next_page_id = leaf_page->GetNextPageId();
+      if (next_page_id == INVALID_PAGE_ID) {
+        break;
+      }
+      ReleaseLeaf(cursor);
+      leaf_page = reinterpret_cast<LeafPage *>(buffer_pool_manager_->FetchPage(next_page_id)->GetData());
+      cursor.leaf = leaf_page;
+      index = 0;
+    }
+  }
+  ReleaseLeaf(cursor);
+}
+
+/*
+ * Keys that fit into the cursor's leaf are inserted in place, a key that needs a split goes
+ * through InsertIntoLeaf and the next key starts from the root.
+ */
+int BPlusTree::InsertMany(const std::vector<GenericKey *> &keys, const std::vector<RowId> &values,
+                          std::vector<bool> &inserted, Txn *transaction) {
+  inserted.assign(keys.size(), false);
+  int count = 0;
+  LeafCursor cursor(processor_.GetKeySize());
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (IsEmpty()) {
+      StartNewTree(keys[i], values[i]);
+      inserted[i] = true;
+      count++;
+      continue;
+    }
+    auto leaf_page = SeekLeaf(cursor, keys[i]);
+    RowId tmpvalue;
+    if (leaf_page->Lookup(keys[i], tmpvalue, processor_)) {
+      continue;
+    }
+    if (leaf_page->HasRoomFor(keys[i])) {
+      leaf_page->Insert(keys[i], values[i], processor_);
+      cursor.dirty = true;
+      inserted[i] = true;
+    } else {
+      ReleaseLeaf(cursor);
+      inserted[i] = InsertIntoLeaf(keys[i], values[i], transaction);
+    }
+    count += inserted[i] ? 1 : 0;
+  }
+  ReleaseLeaf(cursor);
+  return count;
+}
+
+void BPlusTree::RemoveMany(const std::vector<GenericKey *> &keys, Txn *transaction) {
+  LeafCursor cursor(processor_.GetKeySize());
+  for (auto key : keys) {
+    if (IsEmpty()) {
+      break;
+    }
+    auto leaf_page = SeekLeaf(cursor, key);
+    RowId tmpvalue;
+    if (!leaf_page->Lookup(key, tmpvalue, processor_)) {
+      continue;
+    }
+    leaf_page->RemoveAndDeleteRecord(key, processor_);
+    cursor.dirty = true;
+    if (leaf_page->IsUnderflow()) {
+      // 合并或重分配会改变树的结构，下一个key从根开始找
+      ReleasePinnedPages();
+      CoalesceOrRedistribute(leaf_page, transaction);
+      buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), true);
+      cursor.leaf = nullptr;
+      cursor.fenced = false;
+    }
+  }
+  ReleaseLeaf(cursor);
+}
+
+/*
+ * Whether node and its sibling fit into one page, index is the position of node in parent
+ */
+bool BPlusTree::CanCoalesce(LeafPage *neighbor_node, LeafPage *node, InternalPage *parent, int index) {
+  if (index == 0) {
+    return node->CanMergeWith(neighbor_node);
+  }
+  return neighbor_node->CanMergeWith(node);
+}
+
+bool BPlusTree::CanCoalesce(InternalPage *neighbor_node, InternalPage *node, InternalPage *parent, int index) {
+  KeyBuffer middle_key(processor_.GetKeySize());
+  if (index == 0) {
+    return node->CanMergeWith(neighbor_node, parent->KeyAt(1, middle_key.Get()));
+  }
+  return neighbor_node->CanMergeWith(node, parent->KeyAt(index, middle_key.Get()));
+}
+
+/*
+ * User needs to first find the sibling of input page. If the entries of sibling
+ * and input page do not fit into one page, then redistribute. Otherwise, merge.
  * Using template N to represent either internal page or leaf page.
  * @return: true means target page should be deleted, false means no
  * deletion happens
@@ -256,7 +416,7 @@ bool BPlusTree::CoalesceOrRedistribute(N *&node, Txn *transaction) {
   int neighbor_index = (index == 0) ? 1 : index - 1;
   auto neighbor_page = reinterpret_cast<N *>(buffer_pool_manager_->FetchPage(parent_page->ValueAt(neighbor_index))->GetData());
   bool delete_tag;
-  if (neighbor_page->GetSize() + node->GetSize() > node->GetMaxSize()) {
+  if (!CanCoalesce(neighbor_page, node, parent_page, index)) {
     Redistribute(neighbor_page, node, index);
     delete_tag = false;
   } else {
@@ -289,7 +449,7 @@ bool BPlusTree::Coalesce(LeafPage *&neighbor_node, LeafPage *&node, InternalPage
     buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
     buffer_pool_manager_->DeletePage(node->GetPageId());
   }
-  if (parent->GetSize() < parent->GetMinSize()) {
+  if (parent->IsUnderflow()) {
     // parent节点少于minSize，递归处理
     return CoalesceOrRedistribute(parent, transaction);
   }
@@ -297,20 +457,21 @@ bool BPlusTree::Coalesce(LeafPage *&neighbor_node, LeafPage *&node, InternalPage
 }
 
 bool BPlusTree::Coalesce(InternalPage *&neighbor_node, InternalPage *&node, InternalPage *&parent, int index, Txn *transaction) {
+  KeyBuffer key_buf(processor_.GetKeySize());
   if (index == 0) {
-    GenericKey *middle_key = parent->KeyAt(1);
+    GenericKey *middle_key = parent->KeyAt(1, key_buf.Get());
     neighbor_node->MoveAllTo(node, middle_key, buffer_pool_manager_);
     parent->Remove(1);
     buffer_pool_manager_->UnpinPage(neighbor_node->GetPageId(), false);
     buffer_pool_manager_->DeletePage(neighbor_node->GetPageId());
   } else {
-    GenericKey *middle_key = parent->KeyAt(index);
+    GenericKey *middle_key = parent->KeyAt(index, key_buf.Get());
     node->MoveAllTo(neighbor_node, middle_key, buffer_pool_manager_);
     parent->Remove(index);
     buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
     buffer_pool_manager_->DeletePage(node->GetPageId());
   }
-  if (parent->GetSize() < parent->GetMinSize()) {
+  if (parent->IsUnderflow()) {
     // parent节点少于minSize，递归处理
     return CoalesceOrRedistribute(parent, transaction);
   }
@@ -327,16 +488,27 @@ bool BPlusTree::Coalesce(InternalPage *&neighbor_node, InternalPage *&node, Inte
  * 让node从neighbor拿一个节点
  */
 void BPlusTree::Redistribute(LeafPage *neighbor_node, LeafPage *node, int index) {
-  page_id_t parent_page_id = node->GetParentPageId(); 
+  page_id_t parent_page_id = node->GetParentPageId();
   auto parent_page = reinterpret_cast<BPlusTreeInternalPage *>(buffer_pool_manager_->FetchPage(parent_page_id)->GetData());
+  // 父节点中的key不带clustered index叶子上的整行
+  KeyBuffer moved(processor_.GetKeySize()), separator(processor_.GetKeySize());
+  // key长度不定，移动后node或parent放不下时就不做调整
   if (index == 0) {
     // node在最左边，neighbor在右边
-    neighbor_node->MoveFirstToEndOf(node);
-    parent_page->SetKeyAt(1, neighbor_node->KeyAt(0));
+    if (neighbor_node->GetSize() > 1 && node->HasRoomFor(neighbor_node->KeyAt(0, moved.Get())) &&
+        parent_page->CanReplaceKeyAt(1, neighbor_node->KeyAt(1, separator.Get()))) {
+      neighbor_node->MoveFirstToEndOf(node);
+      processor_.StripPayload(neighbor_node->KeyAt(0, separator.Get()));
+      parent_page->SetKeyAt(1, separator.Get());
+    }
   } else {
     // neighbor在左边
-    neighbor_node->MoveLastToFrontOf(node);
-    parent_page->SetKeyAt(index, node->KeyAt(0));
+    GenericKey *last_key = neighbor_node->KeyAt(neighbor_node->GetSize() - 1, moved.Get());
+    if (node->HasRoomFor(last_key) && parent_page->CanReplaceKeyAt(index, last_key)) {
+      neighbor_node->MoveLastToFrontOf(node);
+      processor_.StripPayload(node->KeyAt(0, separator.Get()));
+      parent_page->SetKeyAt(index, separator.Get());
+    }
   }
   buffer_pool_manager_->UnpinPage(parent_page_id, true);
 }
@@ -344,16 +516,23 @@ void BPlusTree::Redistribute(LeafPage *neighbor_node, LeafPage *node, int index)
 void BPlusTree::Redistribute(InternalPage *neighbor_node, InternalPage *node, int index) {
   page_id_t parent_page_id = node->GetParentPageId();
   auto parent_page = reinterpret_cast<BPlusTreeInternalPage *>(buffer_pool_manager_->FetchPage(parent_page_id)->GetData());
+  KeyBuffer middle_buf(processor_.GetKeySize()), key_buf(processor_.GetKeySize());
   if (index == 0) {
     // node在最左边，neighbor在右边
-    GenericKey *middle_key = parent_page->KeyAt(1);
-    neighbor_node->MoveFirstToEndOf(node, middle_key, buffer_pool_manager_);
-    parent_page->SetKeyAt(1, neighbor_node->KeyAt(0));
+    GenericKey *middle_key = parent_page->KeyAt(1, middle_buf.Get());
+    if (neighbor_node->GetSize() > 1 && node->HasRoomFor(middle_key) &&
+        parent_page->CanReplaceKeyAt(1, neighbor_node->KeyAt(1, key_buf.Get()))) {
+      neighbor_node->MoveFirstToEndOf(node, middle_key, buffer_pool_manager_);
+      parent_page->SetKeyAt(1, neighbor_node->KeyAt(0, key_buf.Get()));
+    }
   } else {
     // neighbor在左边
-    GenericKey *middle_key = parent_page->KeyAt(index);
-    neighbor_node->MoveLastToFrontOf(node, middle_key, buffer_pool_manager_);
-    parent_page->SetKeyAt(index, node->KeyAt(0));
+    GenericKey *middle_key = parent_page->KeyAt(index, middle_buf.Get());
+    GenericKey *last_key = neighbor_node->KeyAt(neighbor_node->GetSize() - 1, key_buf.Get());
+    if (node->CanPrependWith(last_key, middle_key) && parent_page->CanReplaceKeyAt(index, last_key)) {
+      neighbor_node->MoveLastToFrontOf(node, middle_key, buffer_pool_manager_);
+      parent_page->SetKeyAt(index, node->KeyAt(0, key_buf.Get()));
+    }
   }
   buffer_pool_manager_->UnpinPage(parent_page_id, true);
 }
@@ -407,6 +586,7 @@ IndexIterator BPlusTree::Begin() {
   if (IsEmpty()) {
     return End();
   }
+  PinUpperLevels();
   auto leaf_page = reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(nullptr, root_page_id_, true)->GetData());
   buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
   return IndexIterator(leaf_page->GetPageId(), buffer_pool_manager_, 0);
@@ -421,9 +601,17 @@ IndexIterator BPlusTree::Begin(const GenericKey *key) {
   if (IsEmpty()) {
     return End();
   }
+  PinUpperLevels();
   auto leaf_page = reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(key, root_page_id_)->GetData());
+  page_id_t page_id = leaf_page->GetPageId();
+  int index = leaf_page->KeyIndex(key, processor_);
+  // key比该页所有key都大时，位置落在下一页的开头，保证与其他迭代器比较时位置唯一
+  if (index >= leaf_page->GetSize()) {
+    page_id = leaf_page->GetNextPageId();
+    index = 0;
+  }
   buffer_pool_manager_->UnpinPage(leaf_page->GetPageId(), false);
-  return IndexIterator(leaf_page->GetPageId(), buffer_pool_manager_, leaf_page->KeyIndex(key, processor_));
+  return IndexIterator(page_id, buffer_pool_manager_, index);
 }
 
 /*
@@ -447,6 +635,19 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
   if (page_id == INVALID_PAGE_ID) {
     return nullptr;
   }
+  if (page_id == root_page_id_ && !pinned_nodes_.empty()) {
+    // 上层页常驻内存，沿child指针下降，到未pin的层再通过buffer pool取页
+    const PinnedNode *pinned = &pinned_nodes_.front();
+    while (true) {
+      auto internal_node = reinterpret_cast<BPlusTreeInternalPage *>(pinned->page->GetData());
+      int index = leftMost ? 0 : internal_node->LookupIndex(key, processor_);
+      if (pinned->children.empty()) {
+        page_id = internal_node->ValueAt(index);
+        break;
+      }
+      pinned = pinned->children[index];
+    }
+  }
   // 由于Page和BPlusTreePage无继承关系，因此返回值和类型判断要分开来
   auto page = buffer_pool_manager_->FetchPage(page_id);
   auto node = reinterpret_cast<BPlusTreePage *>(page->GetData());
@@ -465,6 +666,166 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
   return FindLeafPage(key, next_level_page_id, leftMost);
 }
 
+/*
+ * Reuse the cursor's leaf if key lies in [low, high), otherwise search from the root and
+ * remember the closest separators on both sides of the path.
+ * Note: the returned leaf stays pinned until ReleaseLeaf.
+ */
+BPlusTreeLeafPage *BPlusTree::SeekLeaf(LeafCursor &cursor, const GenericKey *key) {
+  if (cursor.leaf != nullptr && cursor.fenced && (!cursor.has_low || processor_.CompareKeys(key, cursor.low) >= 0) &&
+      (!cursor.has_high || processor_.CompareKeys(key, cursor.high) < 0)) {
+    return cursor.leaf;
+  }
+  ReleaseLeaf(cursor);
+  cursor.has_low = cursor.has_high = false;
+  auto track = [this, &cursor](BPlusTreeInternalPage *node, int index) {
+    // 越往下的分隔key越紧
+    if (index > 0) {
+      node->KeyAt(index, cursor.low);
+      cursor.has_low = true;
+    }
+    if (index + 1 < node->GetSize()) {
+      node->KeyAt(index + 1, cursor.high);
+      cursor.has_high = true;
+    }
+  };
+  page_id_t page_id = root_page_id_;
+  if (!pinned_nodes_.empty()) {
+    const PinnedNode *pinned = &pinned_nodes_.front();
+    while (true) {
+      auto internal_node = reinterpret_cast<BPlusTreeInternalPage *>(pinned->page->GetData());
+      int index = internal_node->LookupIndex(key, processor_);
+      track(internal_node, index);
+      if (pinned->children.empty()) {
+        page_id = internal_node->ValueAt(index);
+        break;
+      }
+      pinned = pinned->children[index];
+    }
+  }
+  while (true) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    auto node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    if (node->IsLeafPage()) {
+      cursor.leaf = reinterpret_cast<LeafPage *>(page->GetData());
+      break;
+    }
+    auto internal_node = reinterpret_cast<BPlusTreeInternalPage *>(page->GetData());
+    int index = internal_node->LookupIndex(key, processor_);
+    track(internal_node, index);
+    page_id_t next_page_id = internal_node->ValueAt(index);
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  cursor.fenced = true;
+  cursor.dirty = false;
+  return cursor.leaf;
+}
+
+void BPlusTree::ReleaseLeaf(LeafCursor &cursor) {
+  if (cursor.leaf != nullptr) {
+    buffer_pool_manager_->UnpinPage(cursor.leaf->GetPageId(), cursor.dirty);
+  }
+  cursor.leaf = nullptr;
+  cursor.dirty = false;
+  cursor.fenced = false;
+}
+
+void BPlusTree::SetPinnedLevels(int levels) {
+  ReleasePinnedPages();
+  pinned_levels_ = std::max(levels, 0);
+  PinUpperLevels();
+}
+
+/*
+ * Pin the internal pages level by level from the root, a level is pinned completely or not at all
+ */
+void BPlusTree::PinUpperLevels() {
+  if (pinned_levels_ == 0 || !pinned_nodes_.empty() || IsEmpty()) {
+    return;
+  }
+  int levels = std::min(pinned_levels_, GetHeight() - 1);
+  if (levels <= 0) {
+    return;
+  }
+  size_t budget = buffer_pool_manager_->GetPoolSize() / MAX_PINNED_FRACTION;
+  if (budget == 0) {
+    return;
+  }
+  pinned_nodes_.push_back({buffer_pool_manager_->FetchPage(root_page_id_), {}});
+  size_t level_begin = 0;
+  for (int level = 1; level < levels; level++) {
+    size_t level_end = pinned_nodes_.size();
+    size_t next_count = 0;
+    for (size_t i = level_begin; i < level_end; i++) {
+      next_count += reinterpret_cast<InternalPage *>(pinned_nodes_[i].page->GetData())->GetSize();
+    }
+    if (level_end + next_count > budget) {
+      break;
+    }
+    for (size_t i = level_begin; i < level_end; i++) {
+      auto internal_node = reinterpret_cast<InternalPage *>(pinned_nodes_[i].page->GetData());
+      for (int j = 0; j < internal_node->GetSize(); j++) {
+        pinned_nodes_.push_back({buffer_pool_manager_->FetchPage(internal_node->ValueAt(j)), {}});
+        pinned_nodes_[i].children.push_back(&pinned_nodes_.back());
+      }
+    }
+    level_begin = level_end;
+  }
+}
+
+void BPlusTree::ReleasePinnedPages() {
+  for (auto &node : pinned_nodes_) {
+    buffer_pool_manager_->UnpinPage(node.page->GetPageId(), false);
+  }
+  pinned_nodes_.clear();
+}
+
+/*
+ * Height of the tree, the root is level 1
+ */
+int BPlusTree::GetHeight() {
+  int height = 0;
+  page_id_t page_id = root_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto node = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    height++;
+    page_id_t next_page_id = INVALID_PAGE_ID;
+    if (!node->IsLeafPage()) {
+      next_page_id = reinterpret_cast<InternalPage *>(node)->ValueAt(0);
+    }
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  return height;
+}
+
+/*
+ * Count the pages of the subtree rooted at page_id (the whole tree by default)
+ */
+int BPlusTree::GetPageCount(page_id_t page_id) {
+  if (page_id == INVALID_PAGE_ID) {
+    page_id = root_page_id_;
+  }
+  if (page_id == INVALID_PAGE_ID) {
+    return 0;
+  }
+  auto node = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+  std::vector<page_id_t> children;
+  if (!node->IsLeafPage()) {
+    auto internal_node = reinterpret_cast<InternalPage *>(node);
+    for (int i = 0; i < internal_node->GetSize(); i++) {
+      children.push_back(internal_node->ValueAt(i));
+    }
+  }
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  int count = 1;
+  for (auto child : children) {
+    count += GetPageCount(child);
+  }
+  return count;
+}
+
 /*
  * Update/Insert root page id in header page(where page_id = INDEX_ROOTS_PAGE_ID, 
  * header_page is defined under include/page/header_page.h)
@@ -504,9 +865,10 @@ void BPlusTree::ToGraph(BPlusTreePage *page, BufferPoolManager *bpm, std::ofstre
         << "max_size=" << leaf->GetMaxSize() << ",min_size=" << leaf->GetMinSize() << ",size=" << leaf->GetSize()
         << "</TD></TR>\n";
     out << "<TR>";
+    KeyBuffer key(processor_.GetKeySize());
     for (int i = 0; i < leaf->GetSize(); i++) {
       Row ans;
-      processor_.DeserializeToKey(leaf->KeyAt(i), ans, schema);
+      processor_.DeserializeToKey(leaf->KeyAt(i, key.Get()), ans, schema);
       out << "<TD>" << ans.GetField(0)->toString() << "</TD>\n";
     }
     out << "</TR>";
@@ -538,11 +900,12 @@ void BPlusTree::ToGraph(BPlusTreePage *page, BufferPoolManager *bpm, std::ofstre
         << "max_size=" << inner->GetMaxSize() << ",min_size=" << inner->GetMinSize() << ",size=" << inner->GetSize()
         << "</TD></TR>\n";
     out << "<TR>";
+    KeyBuffer key(processor_.GetKeySize());
     for (int i = 0; i < inner->GetSize(); i++) {
       out << "<TD PORT=\"p" << inner->ValueAt(i) << "\">";
       if (i > 0) {
         Row ans;
-        processor_.DeserializeToKey(inner->KeyAt(i), ans, schema);
+        processor_.DeserializeToKey(inner->KeyAt(i, key.Get()), ans, schema);
         out << ans.GetField(0)->toString();
       } else {
         out << " ";
@@ -582,16 +945,18 @@ void BPlusTree::ToString(BPlusTreePage *page, BufferPoolManager *bpm) const {
     auto *leaf = reinterpret_cast<LeafPage *>(page);
     std::cout << "Leaf Page: " << leaf->GetPageId() << " parent: " << leaf->GetParentPageId()
               << " next: " << leaf->GetNextPageId() << std::endl;
+    KeyBuffer key(processor_.GetKeySize());
     for (int i = 0; i < leaf->GetSize(); i++) {
-      std::cout << leaf->KeyAt(i) << ",";
+      std::cout << leaf->KeyAt(i, key.Get()) << ",";
     }
     std::cout << std::endl;
     std::cout << std::endl;
   } else {
     auto *internal = reinterpret_cast<InternalPage *>(page);
     std::cout << "Internal Page: " << internal->GetPageId() << " parent: " << internal->GetParentPageId() << std::endl;
+    KeyBuffer key(processor_.GetKeySize());
     for (int i = 0; i < internal->GetSize(); i++) {
-      std::cout << internal->KeyAt(i) << ": " << internal->ValueAt(i) << ",";
+      std::cout << internal->KeyAt(i, key.Get()) << ": " << internal->ValueAt(i) << ",";
     }
     std::cout << std::endl;
     std::cout << std::endl;
@@ -603,6 +968,8 @@ void BPlusTree::ToString(BPlusTreePage *page, BufferPoolManager *bpm) const {
 }
 
 bool BPlusTree::Check() {
+  // 常驻的上层页不算泄漏，下一次查找会重新pin
+  ReleasePinnedPages();
   bool all_unpinned = buffer_pool_manager_->CheckAllUnpinned();
   if (!all_unpinned) {
     LOG(ERROR) << "problem in page unpin" << endl;
@@ -1,20 +1,30 @@
 #include "index/b_plus_tree_index.h"
 
+#include <algorithm>
+
+#include "index/art_index.h"
 #include "index/generic_key.h"
 #include "utils/tree_file_mgr.h"
 BPlusTreeIndex::BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size,
-                               BufferPoolManager *buffer_pool_manager)
+                               BufferPoolManager *buffer_pool_manager, bool unique)
     : Index(index_id, key_schema),
-      processor_(key_schema_, key_size),
+      processor_(key_schema_, key_size, unique),
       container_(index_id, buffer_pool_manager, processor_) {}
 
+BPlusTreeIndex::BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, const KeyManager &processor,
+                               BufferPoolManager *buffer_pool_manager)
+    : Index(index_id, key_schema), processor_(processor), container_(index_id, buffer_pool_manager, processor_) {}
+
 dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
   // ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
   GenericKey *index_key = processor_.InitKey();
   processor_.SerializeFromKey(index_key, key, key_schema_);
+  if (!processor_.IsUnique()) {
+    processor_.SetRowIdSuffix(index_key, row_id.Get());
+  }
 
   bool status = container_.Insert(index_key, row_id, txn);
-  delete index_key;
+  free(index_key);
   //  TreeFileManagers mgr("tree_");
   //  static int i = 0;
   //  if (i % 10 == 0) container_.PrintTree(mgr[i]);
@@ -29,49 +39,163 @@ dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
 dberr_t BPlusTreeIndex::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
   GenericKey *index_key = processor_.InitKey();
   processor_.SerializeFromKey(index_key, key, key_schema_);
+  if (!processor_.IsUnique()) {
+    processor_.SetRowIdSuffix(index_key, row_id.Get());
+  }
 
   container_.Remove(index_key, txn);
-  delete index_key;
+  free(index_key);
   return DB_SUCCESS;
 }
 
+/*
+ * 按key的字节序编码排序 (与树中的顺序一致，null也排在最前)，相邻的key落在同一个叶子上
+ */
+char *BPlusTreeIndex::SerializeBatch(const std::vector<Row> &rows, const std::vector<RowId> *row_ids,
+                                     std::vector<GenericKey *> &keys, std::vector<size_t> &order) {
+  size_t key_size = processor_.GetKeySize();
+  auto buf = reinterpret_cast<char *>(malloc(key_size * rows.size() + 1));
+  std::vector<std::string> encoded(rows.size());
+  order.resize(rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    encoded[i] = ArtIndex::EncodeKey(rows[i], key_schema_);
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    int cmp = encoded[a].compare(encoded[b]);
+    if (cmp != 0 || row_ids == nullptr) {
+      return cmp < 0;
+    }
+    return (*row_ids)[a].Get() < (*row_ids)[b].Get();
+  });
+  keys.resize(rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    auto key = reinterpret_cast<GenericKey *>(buf + i * key_size);
+    processor_.SerializeFromKey(key, rows[order[i]], key_schema_);
+    if (row_ids != nullptr && !processor_.IsUnique()) {
+      processor_.SetRowIdSuffix(key, (*row_ids)[order[i]].Get());
+    }
+    keys[i] = key;
+  }
+  return buf;
+}
+
+dberr_t BPlusTreeIndex::InsertEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn) {
+  std::vector<GenericKey *> index_keys;
+  std::vector<size_t> order;
+  char *buf = SerializeBatch(keys, &row_ids, index_keys, order);
+  std::vector<RowId> values(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    values[i] = row_ids[order[i]];
+  }
+  std::vector<bool> inserted;
+  size_t count = container_.InsertMany(index_keys, values, inserted, txn);
+  free(buf);
+  return count == keys.size() ? DB_SUCCESS : DB_FAILED;
+}
+
+dberr_t BPlusTreeIndex::RemoveEntries(const std::vector<Row> &keys, const std::vector<RowId> &row_ids, Txn *txn) {
+  std::vector<GenericKey *> index_keys;
+  std::vector<size_t> order;
+  char *buf = SerializeBatch(keys, &row_ids, index_keys, order);
+  container_.RemoveMany(index_keys, txn);
+  free(buf);
+  return DB_SUCCESS;
+}
+
+/*
+ * 唯一索引做点查，非唯一索引查 [key + 最小row id, key + 最大row id] 的范围
+ */
+dberr_t BPlusTreeIndex::LookupMany(const std::vector<Row> &keys, std::vector<std::vector<RowId>> &results, Txn *txn) {
+  std::vector<GenericKey *> index_keys;
+  std::vector<size_t> order;
+  char *buf = SerializeBatch(keys, nullptr, index_keys, order);
+  std::vector<std::vector<RowId>> sorted_results;
+  if (processor_.IsUnique()) {
+    container_.GetValues(index_keys, sorted_results, nullptr, txn);
+  } else {
+    size_t key_size = processor_.GetKeySize();
+    auto high_buf = reinterpret_cast<char *>(malloc(key_size * keys.size() + 1));
+    std::vector<GenericKey *> high_keys(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      high_keys[i] = reinterpret_cast<GenericKey *>(high_buf + i * key_size);
+      memcpy(high_keys[i], index_keys[i], key_size);
+      processor_.SetRowIdSuffix(index_keys[i], KeyManager::MIN_ROWID_SUFFIX);
+      processor_.SetRowIdSuffix(high_keys[i], KeyManager::MAX_ROWID_SUFFIX);
+    }
+    container_.GetValues(index_keys, sorted_results, &high_keys, txn);
+    free(high_buf);
+  }
+  free(buf);
+  results.assign(keys.size(), {});
+  for (size_t i = 0; i < keys.size(); i++) {
+    results[order[i]] = std::move(sorted_results[i]);
+  }
+  return DB_SUCCESS;
+}
+
+IndexIterator BPlusTreeIndex::LowerBound(GenericKey *key) {
+  if (!processor_.IsUnique()) {
+    processor_.SetRowIdSuffix(key, KeyManager::MIN_ROWID_SUFFIX);
+  }
+  return container_.Begin(key);
+}
+
+IndexIterator BPlusTreeIndex::UpperBound(GenericKey *key) {
+  if (!processor_.IsUnique()) {
+    processor_.SetRowIdSuffix(key, KeyManager::MAX_ROWID_SUFFIX);
+    return container_.Begin(key);
+  }
+  // 唯一索引中相等的key至多一个
+  auto iter = container_.Begin(key);
+  if (iter != container_.End() && processor_.CompareKeys((*iter).first, key) == 0) {
+    ++iter;
+  }
+  return iter;
+}
+
+IndexIterator BPlusTreeIndex::NonNullBegin() {
+  auto iter = GetBeginIterator();
+  auto end_iter = GetEndIterator();
+  while (iter != end_iter && processor_.IsFirstFieldNull((*iter).first)) {
+    ++iter;
+  }
+  return iter;
+}
+
+/*
+ * All operators are answered with the half-open ranges [lower, upper) of the leaf
+ * chain, where lower is the first entry >= key and upper the first entry > key.
+ * Entries whose first column is null sort first and never satisfy a comparison.
+ */
 dberr_t BPlusTreeIndex::ScanKey(const Row &key, vector<RowId> &result, Txn *txn, string compare_operator) {
   GenericKey *index_key = processor_.InitKey();
   processor_.SerializeFromKey(index_key, key, key_schema_);
   auto end_iter = GetEndIterator();
-  if (compare_operator == "=") {
-    container_.GetValue(index_key, result, txn);
-  } else if (compare_operator == ">") {
-    auto iter = GetBeginIterator(index_key);
-    if (container_.GetValue(index_key, result, txn)) ++iter;
-    result.clear();
-    for (; iter != end_iter; ++iter) {
+  auto collect = [&result](IndexIterator iter, const IndexIterator &stop) {
+    for (; iter != stop; ++iter) {
       result.emplace_back((*iter).second);
     }
-  } else if (compare_operator == ">=") {
-    for (auto iter = GetBeginIterator(index_key); iter != end_iter; ++iter) {
-      result.emplace_back((*iter).second);
+  };
+  if (compare_operator == "=") {
+    if (processor_.IsUnique()) {
+      container_.GetValue(index_key, result, txn);
+    } else {
+      collect(LowerBound(index_key), UpperBound(index_key));
     }
+  } else if (compare_operator == ">") {
+    collect(UpperBound(index_key), end_iter);
+  } else if (compare_operator == ">=") {
+    collect(LowerBound(index_key), end_iter);
   } else if (compare_operator == "<") {
-    auto stop_iter = GetBeginIterator(index_key);
-    for (auto iter = GetBeginIterator(); iter != stop_iter; ++iter) {
-      result.emplace_back((*iter).second);
-    }
+    collect(NonNullBegin(), LowerBound(index_key));
   } else if (compare_operator == "<=") {
-    auto stop_iter = GetBeginIterator(index_key);
-    for (auto iter = GetBeginIterator(); iter != stop_iter; ++iter) {
-      result.emplace_back((*iter).second);
-    }
-    container_.GetValue(index_key, result, txn);
+    collect(NonNullBegin(), UpperBound(index_key));
   } else if (compare_operator == "<>") {
-    for (auto iter = GetBeginIterator(); iter != end_iter; ++iter) {
-      result.emplace_back((*iter).second);
-    }
-    vector<RowId> temp;
-    if (container_.GetValue(index_key, temp, txn))
-      result.erase(find(result.begin(), result.end(), temp[0]));
+    collect(NonNullBegin(), LowerBound(index_key));
+    collect(UpperBound(index_key), end_iter);
   }
-  delete index_key;
+  free(index_key);
   if (!result.empty())
     return DB_SUCCESS;
   else
@@ -93,4 +217,12 @@ IndexIterator BPlusTreeIndex::GetBeginIterator(GenericKey *key) {
 
 IndexIterator BPlusTreeIndex::GetEndIterator() {
   return container_.End();
-}
\ No newline at end of file
+}
+
+IndexIterator BPlusTreeIndex::GetLowerBoundIterator(const Row &key) {
+  GenericKey *index_key = processor_.InitKey();
+  processor_.SerializeFromKey(index_key, key, key_schema_);
+  auto iter = LowerBound(index_key);
+  free(index_key);
+  return iter;
+}
@@ -0,0 +1,72 @@
+#include "index/bloom_filter.h"
+
+#include <cstring>
+
+// 每个word用一个奇数乘子从hash低32位取出一个bit位置 (同parquet的split block bloom filter)
+static constexpr uint32_t SALT[BloomFilter::WORDS_PER_BLOCK] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                                               0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+static inline uint64_t Mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+BloomFilter::BloomFilter(uint32_t num_blocks) { Reset(num_blocks); }
+
+uint64_t BloomFilter::Hash(const char *data, size_t len) {
+  uint64_t h = 0x9e3779b97f4a7c15ULL ^ (len * 0x100000001b3ULL);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t v;
+    memcpy(&v, data + i, sizeof(uint64_t));
+    h = Mix(h ^ v);
+  }
+  uint64_t tail = 0;
+  memcpy(&tail, data + i, len - i);
+  return Mix(h ^ tail);
+}
+
+uint32_t BloomFilter::BlocksFor(size_t num_keys) {
+  uint32_t blocks = 1;
+  while (static_cast<size_t>(blocks) * KEYS_PER_BLOCK < num_keys) {
+    blocks <<= 1;
+  }
+  return blocks;
+}
+
+void BloomFilter::Reset(uint32_t num_blocks) {
+  num_blocks_ = num_blocks == 0 ? 1 : num_blocks;
+  words_.assign(static_cast<size_t>(num_blocks_) * WORDS_PER_BLOCK, 0);
+}
+
+/*
+ * hash高32位按块数缩放得到块号，避免取模
+ */
+const uint32_t *BloomFilter::BlockOf(uint64_t hash) const {
+  uint64_t block = ((hash >> 32) * num_blocks_) >> 32;
+  return words_.data() + block * WORDS_PER_BLOCK;
+}
+
+void BloomFilter::Insert(uint64_t hash) {
+  auto block = const_cast<uint32_t *>(BlockOf(hash));
+  auto low = static_cast<uint32_t>(hash);
+  for (uint32_t i = 0; i < WORDS_PER_BLOCK; i++) {
+    block[i] |= 1U << ((low * SALT[i]) >> 27);
+  }
+}
+
+bool BloomFilter::MayContain(uint64_t hash) const {
+  const uint32_t *block = BlockOf(hash);
+  auto low = static_cast<uint32_t>(hash);
+  // 不提前退出，8个word的判断可以被编译器向量化
+  uint32_t missing = 0;
+  for (uint32_t i = 0; i < WORDS_PER_BLOCK; i++) {
+    uint32_t bit = 1U << ((low * SALT[i]) >> 27);
+    missing |= ~block[i] & bit;
+  }
+  return missing == 0;
+}
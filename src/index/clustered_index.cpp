@@ -0,0 +1,122 @@
+#include "index/clustered_index.h"
+
+/*
+ * key: | 主键的key row (magic num + null bitmap + int) | 整行 (按表的schema序列化) | 0 ... |
+ */
+static constexpr int KEY_ROW_SIZE = KeyManager::INT_KEY_VALUE_OFFSET + sizeof(int32_t);
+
+ClusteredIndex::ClusteredIndex(index_id_t index_id, IndexSchema *key_schema, Schema *table_schema,
+                               BufferPoolManager *buffer_pool_manager)
+    : BPlusTreeIndex(index_id, key_schema, KeyManager(key_schema, KeySizeFor(key_schema, table_schema), true, KEY_ROW_SIZE),
+                     buffer_pool_manager),
+      table_schema_(table_schema) {
+  key_column_ = key_schema->GetColumn(0)->GetTableInd();
+}
+
+size_t ClusteredIndex::KeySizeFor(const Schema *key_schema, const Schema *table_schema) {
+  if (key_schema->GetColumnCount() != 1 || key_schema->GetColumn(0)->GetType() != TypeId::kTypeInt) {
+    return 0;
+  }
+  // 序列化后的row: magic num + null bitmap + 各字段(char字段带4字节长度)
+  size_t size = KEY_ROW_SIZE + 2 * sizeof(uint32_t);
+  for (auto col : table_schema->GetColumns()) {
+    size += col->GetLength();
+    if (col->GetType() == TypeId::kTypeChar) {
+      size += sizeof(uint32_t);
+    }
+  }
+  return size <= MAX_KEY_SIZE ? size : 0;
+}
+
+void ClusteredIndex::SerializeKey(int32_t key_value, GenericKey *key) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, key_value)};
+  processor_.SerializeFromKey(key, Row(fields), key_schema_);
+}
+
+void ClusteredIndex::SerializeRow(const Row &row, GenericKey *key) {
+  SerializeKey(KeyOf(row.GetRowId()), key);
+  row.SerializeTo(processor_.GetPayload(key), table_schema_);
+}
+
+void ClusteredIndex::ReadRow(const GenericKey *key, Row &row) const {
+  row = Row();
+  row.DeserializeFrom(const_cast<char *>(processor_.GetPayload(key)), table_schema_);
+  int32_t key_value = 0;
+  processor_.GetIntKey(key, key_value);
+  row.SetRowId(RowIdOf(key_value));
+}
+
+bool ClusteredIndex::InsertRow(Row &row, Txn *txn) {
+  Field *field = row.GetField(key_column_);
+  if (field->IsNull()) {
+    return false;
+  }
+  int32_t key_value;
+  field->SerializeTo(reinterpret_cast<char *>(&key_value));
+  row.SetRowId(RowIdOf(key_value));
+  GenericKey *key = processor_.InitKey();
+  SerializeRow(row, key);
+  bool inserted = container_.Insert(key, row.GetRowId(), txn);
+  free(key);
+  return inserted;
+}
+
+bool ClusteredIndex::RemoveRow(const RowId &rid, Txn *txn) {
+  GenericKey *key = processor_.InitKey();
+  SerializeKey(KeyOf(rid), key);
+  std::vector<RowId> result;
+  bool found = container_.GetValue(key, result, txn);
+  if (found) {
+    container_.Remove(key, txn);
+  }
+  free(key);
+  return found;
+}
+
+/*
+ * 主键不变时删除后原位插入；主键改变时先插入新行，新主键已存在则不做修改
+ */
+bool ClusteredIndex::UpdateRow(Row &row, const RowId &rid, Txn *txn) {
+  Field *field = row.GetField(key_column_);
+  if (field->IsNull()) {
+    return false;
+  }
+  int32_t key_value;
+  field->SerializeTo(reinterpret_cast<char *>(&key_value));
+  if (key_value != KeyOf(rid)) {
+    Row new_row(row);
+    if (!InsertRow(new_row, txn)) {
+      return false;
+    }
+    if (!RemoveRow(rid, txn)) {
+      RemoveRow(new_row.GetRowId(), txn);
+      return false;
+    }
+    row.SetRowId(new_row.GetRowId());
+    return true;
+  }
+  if (!RemoveRow(rid, txn)) {
+    return false;
+  }
+  return InsertRow(row, txn);
+}
+
+bool ClusteredIndex::GetRow(Row *row, Txn *txn) {
+  GenericKey *key = processor_.InitKey();
+  SerializeKey(KeyOf(row->GetRowId()), key);
+  auto iter = container_.Begin(key);
+  bool found = iter != container_.End() && processor_.CompareKeys((*iter).first, key) == 0;
+  if (found) {
+    ReadRow((*iter).first, *row);
+  }
+  free(key);
+  return found;
+}
+
+TableIterator ClusteredIndex::Begin(Txn *txn) {
+  return TableIterator(this, container_.Begin(), txn);
+}
+
+TableIterator ClusteredIndex::End() {
+  return TableIterator(nullptr, nullptr, nullptr);
+}
@@ -0,0 +1,383 @@
+#include "index/extendible_hash_table.h"
+
+#include <unordered_set>
+#include <utility>
+
+#include "glog/logging.h"
+#include "page/index_roots_page.h"
+
+ExtendibleHashTable::ExtendibleHashTable(index_id_t index_id, BufferPoolManager *buffer_pool_manager,
+                                         const KeyManager &KM)
+    : index_id_(index_id), buffer_pool_manager_(buffer_pool_manager), processor_(KM) {
+  auto page = reinterpret_cast<IndexRootsPage *>(buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID)->GetData());
+  if (!page->GetRootId(index_id, &directory_page_id_)) {
+    directory_page_id_ = INVALID_PAGE_ID;
+  }
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, false);
+}
+
+bool ExtendibleHashTable::IsEmpty() const {
+  return directory_page_id_ == INVALID_PAGE_ID;
+}
+
+/*
+ * Hash the row part of the key, the zero padding after the serialized row is skipped
+ */
+uint32_t ExtendibleHashTable::Hash(const GenericKey *key) const {
+  auto data = reinterpret_cast<const unsigned char *>(key);
+  int len = processor_.GetRowSpace();
+  while (len > 0 && data[len - 1] == 0) {
+    len--;
+  }
+  // FNV-1a，再用murmur3的finalizer打散低位
+  uint64_t h = 14695981039346656037ULL;
+  for (int i = 0; i < len; i++) {
+    h ^= data[i];
+    h *= 1099511628211ULL;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<uint32_t>(h);
+}
+
+/*****************************************************************************
+ * SEARCH
+ *****************************************************************************/
+/*
+ * Collect the values of every entry whose row part equals key, following the
+ * overflow chain of the bucket
+ * @return : true means key exists
+ */
+bool ExtendibleHashTable::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction) {
+  if (IsEmpty()) {
+    return false;
+  }
+  auto directory = reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
+  page_id_t page_id = directory->GetBucketPageId(Hash(key) & directory->GetGlobalDepthMask());
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  size_t old_size = result.size();
+  int len = processor_.GetRowSpace();
+  while (page_id != INVALID_PAGE_ID) {
+    auto bucket = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    for (int i = bucket->Find(key, len); i != -1; i = bucket->Find(key, len, i + 1)) {
+      result.push_back(bucket->ValueAt(i));
+    }
+    page_id_t next_page_id = bucket->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  return result.size() > old_size;
+}
+
+/*****************************************************************************
+ * INSERTION
+ *****************************************************************************/
+/*
+ * Create the directory page and its first bucket, then register the directory
+ * in the index roots page
+ */
+void ExtendibleHashTable::StartNewTable() {
+  page_id_t bucket_page_id;
+  auto bucket_page = buffer_pool_manager_->NewPage(bucket_page_id);
+  ASSERT(bucket_page != nullptr, "out of memory");
+  reinterpret_cast<HashTableBucketPage *>(bucket_page->GetData())->Init(bucket_page_id, processor_.GetKeySize());
+  auto directory_page = buffer_pool_manager_->NewPage(directory_page_id_);
+  ASSERT(directory_page != nullptr, "out of memory");
+  reinterpret_cast<HashTableDirectoryPage *>(directory_page->GetData())->Init(directory_page_id_, bucket_page_id);
+  UpdateRootPageId(1);
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, true);
+}
+
+/*
+ * Insert key & value pair. A full bucket is split (doubling the directory when its
+ * local depth equals the global depth) until the key fits; a bucket that can not
+ * be split any more gets an overflow page.
+ * @return: false if the key already exists
+ */
+bool ExtendibleHashTable::Insert(GenericKey *key, const RowId &value, Txn *transaction) {
+  if (IsEmpty()) {
+    StartNewTable();
+  }
+  auto directory = reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
+  uint32_t hash = Hash(key);
+  // 唯一性检查：整个key（包括row id后缀）相同才算重复
+  page_id_t page_id = directory->GetBucketPageId(hash & directory->GetGlobalDepthMask());
+  while (page_id != INVALID_PAGE_ID) {
+    auto bucket = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    bool found = bucket->Find(key, processor_.GetKeySize()) != -1;
+    page_id_t next_page_id = bucket->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    if (found) {
+      buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+      return false;
+    }
+    page_id = next_page_id;
+  }
+  bool directory_dirty = false;
+  while (true) {
+    uint32_t bucket_idx = hash & directory->GetGlobalDepthMask();
+    page_id = directory->GetBucketPageId(bucket_idx);
+    auto bucket = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    if (!bucket->IsFull()) {
+      bucket->Append(key, value);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      break;
+    }
+    if (directory->GetLocalDepth(bucket_idx) < HASH_MAX_GLOBAL_DEPTH) {
+      SplitBucket(directory, bucket_idx, bucket);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      directory_dirty = true;
+      continue;
+    }
+    // 已经不能再分裂，写入overflow链中第一个有空位的页
+    while (bucket->IsFull() && bucket->GetNextPageId() != INVALID_PAGE_ID) {
+      page_id_t next_page_id = bucket->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      page_id = next_page_id;
+      bucket = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    }
+    if (bucket->IsFull()) {
+      page_id_t overflow_page_id;
+      auto overflow_page = buffer_pool_manager_->NewPage(overflow_page_id);
+      ASSERT(overflow_page != nullptr, "out of memory");
+      auto overflow = reinterpret_cast<HashTableBucketPage *>(overflow_page->GetData());
+      overflow->Init(overflow_page_id, processor_.GetKeySize());
+      bucket->SetNextPageId(overflow_page_id);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      page_id = overflow_page_id;
+      bucket = overflow;
+    }
+    bucket->Append(key, value);
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    break;
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, directory_dirty);
+  return true;
+}
+
+/*
+ * Split the bucket at bucket_idx into itself and a new split image, the entries
+ * are redistributed by the next hash bit. The caller unpins bucket.
+ */
+void ExtendibleHashTable::SplitBucket(HashTableDirectoryPage *directory, uint32_t bucket_idx,
+                                      HashTableBucketPage *bucket) {
+  uint32_t local_depth = directory->GetLocalDepth(bucket_idx);
+  if (local_depth == directory->GetGlobalDepth()) {
+    directory->IncrGlobalDepth();
+  }
+  page_id_t image_page_id;
+  auto image_page = buffer_pool_manager_->NewPage(image_page_id);
+  ASSERT(image_page != nullptr, "out of memory");
+  auto image = reinterpret_cast<HashTableBucketPage *>(image_page->GetData());
+  image->Init(image_page_id, processor_.GetKeySize());
+  // 指向该bucket的slot中，新增的那一位为1的改为指向image
+  page_id_t bucket_page_id = bucket->GetPageId();
+  for (uint32_t i = 0; i < directory->Size(); i++) {
+    if (directory->GetBucketPageId(i) == bucket_page_id) {
+      directory->SetLocalDepth(i, local_depth + 1);
+      if ((i >> local_depth) & 1) {
+        directory->SetBucketPageId(i, image_page_id);
+      }
+    }
+  }
+  for (int i = 0; i < bucket->GetSize();) {
+    if ((Hash(bucket->KeyAt(i)) >> local_depth) & 1) {
+      image->Append(bucket->KeyAt(i), bucket->ValueAt(i));
+      bucket->RemoveAt(i);
+    } else {
+      i++;
+    }
+  }
+  buffer_pool_manager_->UnpinPage(image_page_id, true);
+}
+
+/*****************************************************************************
+ * REMOVE
+ *****************************************************************************/
+/*
+ * Delete key & value pair. An emptied overflow page is unlinked from the chain and
+ * an emptied bucket is merged into its split image.
+ */
+void ExtendibleHashTable::Remove(const GenericKey *key, Txn *transaction) {
+  if (IsEmpty()) {
+    return;
+  }
+  auto directory = reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
+  uint32_t bucket_idx = Hash(key) & directory->GetGlobalDepthMask();
+  page_id_t bucket_page_id = directory->GetBucketPageId(bucket_idx);
+  page_id_t prev_page_id = INVALID_PAGE_ID;
+  page_id_t page_id = bucket_page_id;
+  bool merge = false;
+  while (page_id != INVALID_PAGE_ID) {
+    auto bucket = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    int index = bucket->Find(key, processor_.GetKeySize());
+    if (index == -1) {
+      page_id_t next_page_id = bucket->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      prev_page_id = page_id;
+      page_id = next_page_id;
+      continue;
+    }
+    bucket->RemoveAt(index);
+    if (!bucket->IsEmpty()) {
+      buffer_pool_manager_->UnpinPage(page_id, true);
+    } else if (prev_page_id != INVALID_PAGE_ID) {
+      // 空的overflow页从链上摘掉
+      auto prev = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(prev_page_id)->GetData());
+      prev->SetNextPageId(bucket->GetNextPageId());
+      buffer_pool_manager_->UnpinPage(prev_page_id, true);
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      buffer_pool_manager_->DeletePage(page_id);
+    } else if (bucket->GetNextPageId() != INVALID_PAGE_ID) {
+      // bucket空了但还有overflow页，把下一页的内容搬过来
+      page_id_t next_page_id = bucket->GetNextPageId();
+      auto next = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(next_page_id)->GetData());
+      for (int i = 0; i < next->GetSize(); i++) {
+        bucket->Append(next->KeyAt(i), next->ValueAt(i));
+      }
+      bucket->SetNextPageId(next->GetNextPageId());
+      buffer_pool_manager_->UnpinPage(next_page_id, false);
+      buffer_pool_manager_->DeletePage(next_page_id);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+    } else {
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      merge = true;
+    }
+    break;
+  }
+  if (merge) {
+    MergeBucket(directory, bucket_idx);
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, merge);
+}
+
+/*
+ * Merge the empty bucket at bucket_idx into its split image while the image has
+ * the same local depth, then shrink the directory as far as possible
+ */
+void ExtendibleHashTable::MergeBucket(HashTableDirectoryPage *directory, uint32_t bucket_idx) {
+  while (directory->GetLocalDepth(bucket_idx) > 0) {
+    uint32_t local_depth = directory->GetLocalDepth(bucket_idx);
+    uint32_t image_idx = directory->GetSplitImageIndex(bucket_idx);
+    if (directory->GetLocalDepth(image_idx) != local_depth) {
+      break;
+    }
+    page_id_t bucket_page_id = directory->GetBucketPageId(bucket_idx);
+    page_id_t image_page_id = directory->GetBucketPageId(image_idx);
+    auto bucket = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(bucket_page_id)->GetData());
+    bool empty = bucket->IsEmpty() && bucket->GetNextPageId() == INVALID_PAGE_ID;
+    buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+    if (!empty) {
+      // image可能也是空的，换个方向合并
+      auto image = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(image_page_id)->GetData());
+      empty = image->IsEmpty() && image->GetNextPageId() == INVALID_PAGE_ID;
+      buffer_pool_manager_->UnpinPage(image_page_id, false);
+      if (!empty) {
+        break;
+      }
+      std::swap(bucket_page_id, image_page_id);
+    }
+    for (uint32_t i = 0; i < directory->Size(); i++) {
+      page_id_t page_id = directory->GetBucketPageId(i);
+      if (page_id == bucket_page_id || page_id == image_page_id) {
+        directory->SetBucketPageId(i, image_page_id);
+        directory->SetLocalDepth(i, local_depth - 1);
+      }
+    }
+    buffer_pool_manager_->DeletePage(bucket_page_id);
+    bucket_idx &= (1U << (local_depth - 1)) - 1;
+  }
+  while (directory->CanShrink()) {
+    directory->DecrGlobalDepth();
+  }
+}
+
+/*****************************************************************************
+ * UTILITIES AND DEBUG
+ *****************************************************************************/
+void ExtendibleHashTable::Destroy() {
+  if (IsEmpty()) {
+    return;
+  }
+  auto directory = reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
+  std::unordered_set<page_id_t> buckets;
+  for (uint32_t i = 0; i < directory->Size(); i++) {
+    buckets.insert(directory->GetBucketPageId(i));
+  }
+  for (auto page_id : buckets) {
+    while (page_id != INVALID_PAGE_ID) {
+      auto bucket = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+      page_id_t next_page_id = bucket->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      buffer_pool_manager_->DeletePage(page_id);
+      page_id = next_page_id;
+    }
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  buffer_pool_manager_->DeletePage(directory_page_id_);
+  auto root_page = reinterpret_cast<IndexRootsPage *>(buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID)->GetData());
+  root_page->Delete(index_id_);
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+  directory_page_id_ = INVALID_PAGE_ID;
+}
+
+uint32_t ExtendibleHashTable::GetGlobalDepth() {
+  if (IsEmpty()) {
+    return 0;
+  }
+  auto directory = reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
+  uint32_t global_depth = directory->GetGlobalDepth();
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  return global_depth;
+}
+
+/*
+ * Directory page, bucket pages and overflow pages
+ */
+int ExtendibleHashTable::GetPageCount() {
+  if (IsEmpty()) {
+    return 0;
+  }
+  auto directory = reinterpret_cast<HashTableDirectoryPage *>(buffer_pool_manager_->FetchPage(directory_page_id_)->GetData());
+  std::unordered_set<page_id_t> buckets;
+  for (uint32_t i = 0; i < directory->Size(); i++) {
+    buckets.insert(directory->GetBucketPageId(i));
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  int count = 1;
+  for (auto page_id : buckets) {
+    while (page_id != INVALID_PAGE_ID) {
+      auto bucket = reinterpret_cast<HashTableBucketPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+      page_id_t next_page_id = bucket->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      page_id = next_page_id;
+      count++;
+    }
+  }
+  return count;
+}
+
+/*
+ * Update/Insert the directory page id in the index roots page
+ */
+void ExtendibleHashTable::UpdateRootPageId(int insert_record) {
+  auto root_page = reinterpret_cast<IndexRootsPage *>(buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID)->GetData());
+  if (insert_record) {
+    root_page->Insert(index_id_, directory_page_id_);
+  } else {
+    root_page->Update(index_id_, directory_page_id_);
+  }
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+}
+
+bool ExtendibleHashTable::Check() {
+  bool all_unpinned = buffer_pool_manager_->CheckAllUnpinned();
+  if (!all_unpinned) {
+    LOG(ERROR) << "problem in page unpin" << endl;
+  }
+  return all_unpinned;
+}
@@ -0,0 +1,54 @@
+#include "index/hash_index.h"
+
+HashIndex::HashIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size,
+                     BufferPoolManager *buffer_pool_manager, bool unique)
+    : Index(index_id, key_schema),
+      processor_(key_schema_, key_size, unique),
+      container_(index_id, buffer_pool_manager, processor_) {}
+
+dberr_t HashIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
+  GenericKey *index_key = processor_.InitKey();
+  processor_.SerializeFromKey(index_key, key, key_schema_);
+  if (!processor_.IsUnique()) {
+    processor_.SetRowIdSuffix(index_key, row_id.Get());
+  }
+  bool status = container_.Insert(index_key, row_id, txn);
+  free(index_key);
+  if (!status) {
+    return DB_FAILED;
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t HashIndex::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
+  GenericKey *index_key = processor_.InitKey();
+  processor_.SerializeFromKey(index_key, key, key_schema_);
+  if (!processor_.IsUnique()) {
+    processor_.SetRowIdSuffix(index_key, row_id.Get());
+  }
+  container_.Remove(index_key, txn);
+  free(index_key);
+  return DB_SUCCESS;
+}
+
+/*
+ * 哈希索引只支持等值查询
+ */
+dberr_t HashIndex::ScanKey(const Row &key, vector<RowId> &result, Txn *txn, string compare_operator) {
+  if (compare_operator != "=") {
+    return DB_FAILED;
+  }
+  GenericKey *index_key = processor_.InitKey();
+  processor_.SerializeFromKey(index_key, key, key_schema_);
+  bool found = container_.GetValue(index_key, result, txn);
+  free(index_key);
+  if (found)
+    return DB_SUCCESS;
+  else
+    return DB_KEY_NOT_FOUND;
+}
+
+dberr_t HashIndex::Destroy() {
+  container_.Destroy();
+  return DB_SUCCESS;
+}
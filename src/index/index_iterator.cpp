@@ -14,13 +14,35 @@ IndexIterator::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int inde
   page = reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id)->GetData());
 }
 
+// 拷贝时需要重新pin页面，否则析构时会重复unpin
+IndexIterator::IndexIterator(const IndexIterator &other)
+    : IndexIterator(other.current_page_id, other.buffer_pool_manager, other.item_index) {}
+
+IndexIterator &IndexIterator::operator=(const IndexIterator &other) {
+  if (this == &other) {
+    return *this;
+  }
+  if (current_page_id != INVALID_PAGE_ID) {
+    buffer_pool_manager->UnpinPage(current_page_id, false);
+  }
+  current_page_id = other.current_page_id;
+  item_index = other.item_index;
+  buffer_pool_manager = other.buffer_pool_manager;
+  page = nullptr;
+  if (current_page_id != INVALID_PAGE_ID) {
+    page = reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id)->GetData());
+  }
+  return *this;
+}
+
 IndexIterator::~IndexIterator() {
   if (current_page_id != INVALID_PAGE_ID)
     buffer_pool_manager->UnpinPage(current_page_id, false);
 }
 
 std::pair<GenericKey *, RowId> IndexIterator::operator*() {
-  return std::make_pair(page->KeyAt(item_index), page->ValueAt(item_index));
+  key_.resize(page->GetKeySize());
+  return page->GetItem(item_index, reinterpret_cast<GenericKey *>(key_.data()));
 }
 
 IndexIterator &IndexIterator::operator++() {
@@ -0,0 +1,112 @@
+#include "index/int_key_search.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define INT_KEY_SEARCH_X86
+#endif
+
+static inline int32_t ReadKey(const char *keys, int index) {
+  int32_t key;
+  memcpy(&key, keys + index * sizeof(int32_t), sizeof(int32_t));
+  return key;
+}
+
+static int CountLessScalar(const char *keys, int n, int32_t target) {
+  int count = 0;
+  for (int i = 0; i < n; i++) {
+    count += ReadKey(keys, i) < target ? 1 : 0;
+  }
+  return count;
+}
+
+#ifdef INT_KEY_SEARCH_X86
+static int CountLessSSE(const char *keys, int n, int32_t target) {
+  __m128i t = _mm_set1_epi32(target);
+  int count = 0;
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i * sizeof(int32_t)));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(t, k)));
+    count += __builtin_popcount(mask);
+  }
+  return count + CountLessScalar(keys + i * sizeof(int32_t), n - i, target);
+}
+
+__attribute__((target("avx2"))) static int CountLessAVX2(const char *keys, int n, int32_t target) {
+  __m256i t = _mm256_set1_epi32(target);
+  int count = 0;
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i * sizeof(int32_t)));
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(t, k)));
+    count += __builtin_popcount(mask);
+  }
+  return count + CountLessScalar(keys + i * sizeof(int32_t), n - i, target);
+}
+#endif
+
+IntKeySearch::Kernel IntKeySearch::DetectKernel() {
+#ifdef INT_KEY_SEARCH_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Kernel::kAVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return Kernel::kSSE;
+  }
+#endif
+  return Kernel::kScalar;
+}
+
+static IntKeySearch::Kernel active_kernel = IntKeySearch::DetectKernel();
+
+IntKeySearch::Kernel IntKeySearch::GetKernel() {
+  return active_kernel;
+}
+
+IntKeySearch::Kernel IntKeySearch::SetKernel(Kernel kernel) {
+  active_kernel = static_cast<int>(kernel) < static_cast<int>(DetectKernel()) ? kernel : DetectKernel();
+  return active_kernel;
+}
+
+const char *IntKeySearch::KernelName(Kernel kernel) {
+  switch (kernel) {
+    case Kernel::kAVX2:
+      return "avx2";
+    case Kernel::kSSE:
+      return "sse";
+    default:
+      return "scalar";
+  }
+}
+
+/*
+ * 先二分到window以内，再在window内数小于target的key个数，标量版本一直二分到底
+ */
+int IntKeySearch::LowerBound(const char *keys, int n, int32_t target) {
+  int (*count_less)(const char *, int, int32_t) = nullptr;
+  int window = 0;
+#ifdef INT_KEY_SEARCH_X86
+  if (active_kernel == Kernel::kAVX2) {
+    count_less = CountLessAVX2;
+    window = 64;
+  } else if (active_kernel == Kernel::kSSE) {
+    count_less = CountLessSSE;
+    window = 32;
+  }
+#endif
+  int lo = 0;
+  int len = n;
+  while (len > window) {
+    int half = len / 2;
+    if (ReadKey(keys, lo + half) < target) {
+      lo += half + 1;
+      len -= half + 1;
+    } else {
+      len = half;
+    }
+  }
+  return count_less == nullptr ? lo : lo + count_less(keys + lo * sizeof(int32_t), len, target);
+}
@@ -2,10 +2,6 @@
 
 #include "index/generic_key.h"
 
-#define pairs_off (data_)
-#define pair_size (GetKeySize() + sizeof(page_id_t))
-#define key_off 0
-#define val_off GetKeySize()
 
 /*****************************************************************************
  * HELPER METHODS AND UTILITIES
@@ -15,33 +11,37 @@
  * Including set page type, set current size, set page id, set parent id and set
  * max page size
  */
-void BPlusTreeInternalPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size) {
+void BPlusTreeInternalPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size, int key_tail, bool int_keys) {
   SetPageId(page_id);
   SetParentPageId(parent_id);
   SetKeySize(key_size);
   SetMaxSize(max_size);
   SetPageType(IndexPageType::INTERNAL_PAGE);
   SetSize(0);
+  Area().Init(key_tail, int_keys);
 }
 
 /*
  * Helper method to get/set the key associated with input "index"(a.k.a
  * array offset)
  */
-GenericKey *BPlusTreeInternalPage::KeyAt(int index) {
-  return reinterpret_cast<GenericKey *>(pairs_off + index * pair_size + key_off);
+GenericKey *BPlusTreeInternalPage::KeyAt(int index, GenericKey *key) {
+  return Area().KeyAt(index, key);
 }
 
 void BPlusTreeInternalPage::SetKeyAt(int index, GenericKey *key) {
-  memcpy(pairs_off + index * pair_size + key_off, key, GetKeySize());
+  auto area = Area();
+  area.SetKeyAt(index, area.Encode(key));
 }
 
 page_id_t BPlusTreeInternalPage::ValueAt(int index) const {
-  return *reinterpret_cast<const page_id_t *>(pairs_off + index * pair_size + val_off);
+  page_id_t value;
+  const_cast<BPlusTreeInternalPage *>(this)->Area().ValueAt(index, &value);
+  return value;
 }
 
 void BPlusTreeInternalPage::SetValueAt(int index, page_id_t value) {
-  *reinterpret_cast<page_id_t *>(pairs_off + index * pair_size + val_off) = value;
+  Area().SetValueAt(index, &value);
 }
 
 int BPlusTreeInternalPage::ValueIndex(const page_id_t &value) const {
@@ -52,12 +52,79 @@ int BPlusTreeInternalPage::ValueIndex(const page_id_t &value) const {
   return -1;
 }
 
-void *BPlusTreeInternalPage::PairPtrAt(int index) {
-  return KeyAt(index);
+/*****************************************************************************
+ * SPACE MANAGEMENT
+ *****************************************************************************/
+/*
+ * Whether new_key can be inserted without overflowing the page
+ */
+bool BPlusTreeInternalPage::HasRoomFor(const GenericKey *key) {
+  if (GetMaxSize() != UNDEFINED_SIZE && GetSize() >= GetMaxSize()) {
+    return false;
+  }
+  auto area = Area();
+  return area.InsertCost(area.Encode(key)) <= area.GetFreeBytes();
+}
+
+/*
+ * Whether the key at index can be replaced by key without overflowing the page
+ */
+bool BPlusTreeInternalPage::CanReplaceKeyAt(int index, const GenericKey *key) {
+  auto area = Area();
+  auto items = area.Items(0, GetSize());
+  items[index].key = area.Encode(key);
+  items[index].has_key = true;
+  return area.RequiredBytes(items) <= area.GetCapacity();
 }
 
-void BPlusTreeInternalPage::PairCopy(void *dest, void *src, int pair_num) {
-  memcpy(dest, src, pair_num * (GetKeySize() + sizeof(page_id_t)));
+/*
+ * Whether a new first entry with first_key fits, when the current first entry gets old_first_key
+ */
+bool BPlusTreeInternalPage::CanPrependWith(const GenericKey *first_key, const GenericKey *old_first_key) {
+  if (GetMaxSize() != UNDEFINED_SIZE && GetSize() >= GetMaxSize()) {
+    return false;
+  }
+  auto area = Area();
+  auto items = area.Items(0, GetSize());
+  SlottedKeyArea::Item item;
+  item.key = area.Encode(first_key);
+  if (!items.empty()) {
+    items[0].key = area.Encode(old_first_key);
+    items[0].has_key = true;
+  }
+  items.insert(items.begin(), item);
+  return area.RequiredBytes(items) <= area.GetCapacity();
+}
+
+/*
+ * Less than half of the page is in use
+ */
+bool BPlusTreeInternalPage::IsUnderflow() {
+  if (GetMaxSize() != UNDEFINED_SIZE) {
+    return GetSize() < GetMinSize();
+  }
+  auto area = Area();
+  return area.GetUsedBytes() * 2 < area.GetCapacity();
+}
+
+/*
+ * Whether all entries of this page, the middle key and entries of other fit into one page
+ */
+bool BPlusTreeInternalPage::CanMergeWith(BPlusTreeInternalPage *other, GenericKey *middle_key) {
+  if (GetMaxSize() != UNDEFINED_SIZE && GetSize() + other->GetSize() > GetMaxSize()) {
+    return false;
+  }
+  auto area = Area();
+  auto items = area.Items(0, GetSize());
+  auto other_items = other->Area().Items(0, other->GetSize());
+  other_items[0].key = area.Encode(middle_key);
+  other_items[0].has_key = true;
+  items.insert(items.end(), other_items.begin(), other_items.end());
+  return area.RequiredBytes(items) <= area.GetCapacity();
+}
+
+int BPlusTreeInternalPage::GetUsedBytes() {
+  return Area().GetUsedBytes();
 }
 
 /*****************************************************************************
@@ -70,17 +137,35 @@ void BPlusTreeInternalPage::PairCopy(void *dest, void *src, int pair_num) {
  * 用了二分查找
  */
 page_id_t BPlusTreeInternalPage::Lookup(const GenericKey *key, const KeyManager &KM) {
+  return ValueAt(LookupIndex(key, KM));
+}
+
+int BPlusTreeInternalPage::LookupIndex(const GenericKey *key, const KeyManager &KM) {
   int l = 1, r = GetSize() - 1, index = 0;
+  int32_t target;
+  auto area = Area();
+  if (area.CanSearchInt() && KM.GetIntKey(key, target)) {
+    // 在int数组上找到值相等的一段，非唯一索引再按row id后缀二分
+    int lo, hi;
+    area.IntEqualRange(target, 1, GetSize(), lo, hi);
+    if (KM.IsUnique()) {
+      return hi - 1;
+    }
+    index = lo - 1;
+    l = lo;
+    r = hi - 1;
+  }
+  KeyBuffer mid_key(GetKeySize());
   while (l <= r) {
     int mid = (l + r) >> 1;
-    if (KM.CompareKeys(KeyAt(mid), key) <= 0) { //key >= KeyAt(mid)
+    if (KM.CompareKeys(KeyAt(mid, mid_key.Get()), key) <= 0) { //key >= KeyAt(mid)
       index = mid;
       l = mid + 1;
     } else {
       r = mid - 1;
     }
   }
-  return ValueAt(index);
+  return index;
 }
 
 /*****************************************************************************
@@ -93,10 +178,13 @@ page_id_t BPlusTreeInternalPage::Lookup(const GenericKey *key, const KeyManager
  * NOTE: This method is only called within InsertIntoParent()(b_plus_tree.cpp)
  */
 void BPlusTreeInternalPage::PopulateNewRoot(const page_id_t &old_value, GenericKey *new_key, const page_id_t &new_value) {
-  SetSize(2);
-  SetValueAt(0, old_value);
-  SetKeyAt(1, new_key);
-  SetValueAt(1, new_value);
+  auto area = Area();
+  std::vector<SlottedKeyArea::Item> items(2);
+  items[0].has_key = false;
+  items[0].value = old_value;
+  items[1].key = area.Encode(new_key);
+  items[1].value = new_value;
+  area.Rebuild(items);
 }
 
 /*
@@ -106,11 +194,8 @@ void BPlusTreeInternalPage::PopulateNewRoot(const page_id_t &old_value, GenericK
  */
 int BPlusTreeInternalPage::InsertNodeAfter(const page_id_t &old_value, GenericKey *new_key, const page_id_t &new_value) {
   int index = ValueIndex(old_value);
-  int pair_num = GetSize() - index - 1;
-  PairCopy(PairPtrAt(index + 2), PairPtrAt(index + 1), pair_num);
-  IncreaseSize(1);
-  SetKeyAt(index + 1, new_key);
-  SetValueAt(index + 1, new_value);
+  auto area = Area();
+  area.InsertAt(index + 1, area.Encode(new_key), &new_value);
   return GetSize();
 }
 
@@ -125,8 +210,9 @@ int BPlusTreeInternalPage::InsertNodeAfter(const page_id_t &old_value, GenericKe
 void BPlusTreeInternalPage::MoveHalfTo(BPlusTreeInternalPage *recipient, BufferPoolManager *buffer_pool_manager) {
   ASSERT(recipient != nullptr, "recipient is null!");
   int half = GetSize() / 2;
-  recipient->CopyNFrom(PairPtrAt(GetSize() - half), half, buffer_pool_manager);
-  IncreaseSize(-half);
+  auto area = Area();
+  recipient->CopyNFrom(area.Items(GetSize() - half, GetSize()), buffer_pool_manager);
+  area.Rebuild(area.Items(0, GetSize() - half));
 }
 
 /* Copy entries into me, starting from {items} and copy {size} entries.
@@ -134,9 +220,12 @@ void BPlusTreeInternalPage::MoveHalfTo(BPlusTreeInternalPage *recipient, BufferP
  * So I need to 'adopt' them by changing their parent page id, which needs to be persisted with BufferPoolManger
  *
  */
-void BPlusTreeInternalPage::CopyNFrom(void *src, int size, BufferPoolManager *buffer_pool_manager) {
-  PairCopy(PairPtrAt(GetSize()), src, size);
-  IncreaseSize(size);
+void BPlusTreeInternalPage::CopyNFrom(const std::vector<SlottedKeyArea::Item> &items, BufferPoolManager *buffer_pool_manager) {
+  auto area = Area();
+  auto all = area.Items(0, GetSize());
+  all.insert(all.end(), items.begin(), items.end());
+  area.Rebuild(all);
+  int size = items.size();
   for (int i = 0; i < size; i++) {
     page_id_t child_page_id = ValueAt(GetSize() - size + i);
     // 很坑，BPlusTreePage父类不是Page，因此直接将数据强转成BPlusTreePage*
@@ -155,8 +244,7 @@ void BPlusTreeInternalPage::CopyNFrom(void *src, int size, BufferPoolManager *bu
  * NOTE: store key&value pair continuously after deletion
  */
 void BPlusTreeInternalPage::Remove(int index) {
-  PairCopy(PairPtrAt(index), PairPtrAt(index + 1), GetSize() - index - 1);
-  IncreaseSize(-1);
+  Area().RemoveAt(index);
 }
 
 /*
@@ -166,7 +254,7 @@ void BPlusTreeInternalPage::Remove(int index) {
 page_id_t BPlusTreeInternalPage::RemoveAndReturnOnlyChild() {
   ASSERT(GetSize() == 1, "have more than one child!");
   page_id_t child_page_id = ValueAt(0);
-  SetSize(0);
+  Area().Rebuild({});
   return child_page_id;
 }
 
@@ -183,9 +271,12 @@ page_id_t BPlusTreeInternalPage::RemoveAndReturnOnlyChild() {
  */
 void BPlusTreeInternalPage::MoveAllTo(BPlusTreeInternalPage *recipient, GenericKey *middle_key, BufferPoolManager *buffer_pool_manager) {
   ASSERT(recipient != nullptr, "recipient is null!");
-  SetKeyAt(0, middle_key);
-  recipient->CopyNFrom(PairPtrAt(0), GetSize(), buffer_pool_manager);
-  SetSize(0);
+  auto area = Area();
+  auto items = area.Items(0, GetSize());
+  items[0].key = area.Encode(middle_key);
+  items[0].has_key = true;
+  recipient->CopyNFrom(items, buffer_pool_manager);
+  area.Rebuild({});
 }
 
 /*****************************************************************************
@@ -201,8 +292,7 @@ void BPlusTreeInternalPage::MoveAllTo(BPlusTreeInternalPage *recipient, GenericK
  */
 void BPlusTreeInternalPage::MoveFirstToEndOf(BPlusTreeInternalPage *recipient, GenericKey *middle_key, BufferPoolManager *buffer_pool_manager) {
   ASSERT(recipient != nullptr, "recipient is null!");
-  SetKeyAt(0, middle_key);
-  recipient->CopyNFrom(PairPtrAt(0), 1, buffer_pool_manager);
+  recipient->CopyLastFrom(middle_key, ValueAt(0), buffer_pool_manager);
   Remove(0);
 }
 
@@ -211,9 +301,8 @@ void BPlusTreeInternalPage::MoveFirstToEndOf(BPlusTreeInternalPage *recipient, G
  * So I need to 'adopt' it by changing its parent page id, which needs to be persisted with BufferPoolManger
  */
 void BPlusTreeInternalPage::CopyLastFrom(GenericKey *key, const page_id_t value, BufferPoolManager *buffer_pool_manager) {
-  SetKeyAt(GetSize(), key);
-  SetValueAt(GetSize(), value);
-  IncreaseSize(1);
+  auto area = Area();
+  area.InsertAt(GetSize(), area.Encode(key), &value);
   auto child_page = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager->FetchPage(value)->GetData());
   child_page->SetParentPageId(GetPageId());
   buffer_pool_manager->UnpinPage(value, true);
@@ -228,7 +317,8 @@ void BPlusTreeInternalPage::MoveLastToFrontOf(BPlusTreeInternalPage *recipient,
   ASSERT(recipient != nullptr, "recipient is null!");
   recipient->SetKeyAt(0, middle_key);
   recipient->CopyFirstFrom(ValueAt(GetSize() - 1), buffer_pool_manager);
-  recipient->SetKeyAt(0, KeyAt(GetSize() - 1));
+  KeyBuffer key(GetKeySize());
+  recipient->SetKeyAt(0, KeyAt(GetSize() - 1, key.Get()));
   Remove(GetSize() - 1);
 }
 
@@ -237,9 +327,7 @@ void BPlusTreeInternalPage::MoveLastToFrontOf(BPlusTreeInternalPage *recipient,
  * So I need to 'adopt' it by changing its parent page id, which needs to be persisted with BufferPoolManger
  */
 void BPlusTreeInternalPage::CopyFirstFrom(const page_id_t value, BufferPoolManager *buffer_pool_manager) {
-  PairCopy(PairPtrAt(1), PairPtrAt(0), GetSize());
-  SetValueAt(0, value);
-  IncreaseSize(1);
+  Area().InsertAt(0, std::string(), &value, false);
   auto child_page = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager->FetchPage(value)->GetData());
   child_page->SetParentPageId(GetPageId());
   buffer_pool_manager->UnpinPage(value, true);
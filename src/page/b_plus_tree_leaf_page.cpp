@@ -4,10 +4,6 @@
 
 #include "index/generic_key.h"
 
-#define pairs_off (data_)
-#define pair_size (GetKeySize() + sizeof(RowId))
-#define key_off 0
-#define val_off GetKeySize()
 /*****************************************************************************
  * HELPER METHODS AND UTILITIES
  *****************************************************************************/
@@ -18,7 +14,7 @@
  * next page id and set max size
  * 未初始化next_page_id
  */
-void BPlusTreeLeafPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size) {
+void BPlusTreeLeafPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size, int key_tail, bool int_keys) {
   SetPageId(page_id);
   SetParentPageId(parent_id);
   SetKeySize(key_size);
@@ -26,6 +22,7 @@ void BPlusTreeLeafPage::Init(page_id_t page_id, page_id_t parent_id, int key_siz
   SetPageType(IndexPageType::LEAF_PAGE);
   SetNextPageId(INVALID_PAGE_ID);
   SetSize(0);
+  Area().Init(key_tail, int_keys);
 }
 
 /**
@@ -49,9 +46,20 @@ void BPlusTreeLeafPage::SetNextPageId(page_id_t next_page_id) {
  */
 int BPlusTreeLeafPage::KeyIndex(const GenericKey *key, const KeyManager &KM) {
   int l = 0, r = GetSize() - 1, index = GetSize();
+  int32_t target;
+  auto area = Area();
+  if (area.CanSearchInt() && KM.GetIntKey(key, target)) {
+    // 在int数组上找到值相等的一段，非唯一索引再按row id后缀二分
+    area.IntEqualRange(target, 0, GetSize(), l, index);
+    if (KM.IsUnique()) {
+      return l;
+    }
+    r = index - 1;
+  }
+  KeyBuffer mid_key(GetKeySize());
   while (l <= r) {
     int mid = (l + r) >> 1;
-    if (KM.CompareKeys(KeyAt(mid), key) >= 0) { //key <= KeyAt(mid)
+    if (KM.CompareKeys(KeyAt(mid, mid_key.Get()), key) >= 0) { //key <= KeyAt(mid)
       index = mid;
       r = mid - 1;
     } else {
@@ -65,36 +73,78 @@ int BPlusTreeLeafPage::KeyIndex(const GenericKey *key, const KeyManager &KM) {
  * Helper method to find and return the key associated with input "index"(a.k.a
  * array offset)
  */
-GenericKey *BPlusTreeLeafPage::KeyAt(int index) {
-  return reinterpret_cast<GenericKey *>(pairs_off + index * pair_size + key_off);
+GenericKey *BPlusTreeLeafPage::KeyAt(int index, GenericKey *key) {
+  return Area().KeyAt(index, key);
 }
 
 void BPlusTreeLeafPage::SetKeyAt(int index, GenericKey *key) {
-  memcpy(pairs_off + index * pair_size + key_off, key, GetKeySize());
+  auto area = Area();
+  area.SetKeyAt(index, area.Encode(key));
 }
 
 RowId BPlusTreeLeafPage::ValueAt(int index) const {
-  return *reinterpret_cast<const RowId *>(pairs_off + index * pair_size + val_off);
+  RowId value;
+  const_cast<BPlusTreeLeafPage *>(this)->Area().ValueAt(index, &value);
+  return value;
 }
 
 void BPlusTreeLeafPage::SetValueAt(int index, RowId value) {
-  *reinterpret_cast<RowId *>(pairs_off + index * pair_size + val_off) = value;
+  Area().SetValueAt(index, &value);
 }
 
-void *BPlusTreeLeafPage::PairPtrAt(int index) {
-  return KeyAt(index);
+/*
+ * Helper method to find and return the key & value pair associated with input
+ * "index"(a.k.a. array offset)
+ */
+std::pair<GenericKey *, RowId> BPlusTreeLeafPage::GetItem(int index, GenericKey *key) {
+  return {KeyAt(index, key), ValueAt(index)};
 }
 
-void BPlusTreeLeafPage::PairCopy(void *dest, void *src, int pair_num) {
-  memcpy(dest, src, pair_num * (GetKeySize() + sizeof(RowId)));
+/*****************************************************************************
+ * SPACE MANAGEMENT
+ *****************************************************************************/
+/*
+ * Whether key can be inserted without overflowing the page
+ */
+bool BPlusTreeLeafPage::HasRoomFor(const GenericKey *key) {
+  if (GetMaxSize() != UNDEFINED_SIZE && GetSize() >= GetMaxSize()) {
+    return false;
+  }
+  auto area = Area();
+  return area.InsertCost(area.Encode(key)) <= area.GetFreeBytes();
 }
 
 /*
- * Helper method to find and return the key & value pair associated with input
- * "index"(a.k.a. array offset)
+ * Less than half of the page is in use
  */
-std::pair<GenericKey *, RowId> BPlusTreeLeafPage::GetItem(int index) {
-  return {KeyAt(index), ValueAt(index)};
+bool BPlusTreeLeafPage::IsUnderflow() {
+  if (GetMaxSize() != UNDEFINED_SIZE) {
+    return GetSize() < GetMinSize();
+  }
+  auto area = Area();
+  return area.GetUsedBytes() * 2 < area.GetCapacity();
+}
+
+/*
+ * Whether all entries of this page and other fit into one page
+ */
+bool BPlusTreeLeafPage::CanMergeWith(BPlusTreeLeafPage *other) {
+  if (GetMaxSize() != UNDEFINED_SIZE && GetSize() + other->GetSize() > GetMaxSize()) {
+    return false;
+  }
+  auto area = Area();
+  auto items = area.Items(0, GetSize());
+  auto other_items = other->Area().Items(0, other->GetSize());
+  items.insert(items.end(), other_items.begin(), other_items.end());
+  return area.RequiredBytes(items) <= area.GetCapacity();
+}
+
+int BPlusTreeLeafPage::GetUsedBytes() {
+  return Area().GetUsedBytes();
+}
+
+int BPlusTreeLeafPage::GetPrefixLength() {
+  return Area().GetPrefixLen();
 }
 
 /*****************************************************************************
@@ -106,16 +156,8 @@ std::pair<GenericKey *, RowId> BPlusTreeLeafPage::GetItem(int index) {
  */
 int BPlusTreeLeafPage::Insert(GenericKey *key, const RowId &value, const KeyManager &KM) {
   int index = KeyIndex(key, KM);
-  if (index == GetSize()) {
-    SetKeyAt(index, key);
-    SetValueAt(index, value);
-    IncreaseSize(1);
-    return GetSize();
-  }
-  PairCopy(PairPtrAt(index + 1), PairPtrAt(index), GetSize() - index);
-  SetKeyAt(index, key);
-  SetValueAt(index, value);
-  IncreaseSize(1);
+  auto area = Area();
+  area.InsertAt(index, area.Encode(key), &value);
   return GetSize();
 }
 
@@ -124,20 +166,24 @@ int BPlusTreeLeafPage::Insert(GenericKey *key, const RowId &value, const KeyMana
  *****************************************************************************/
 /*
  * Remove half of key & value pairs from this page to "recipient" page
+ * 两页都会重建，各自重新计算公共前缀
  */
 void BPlusTreeLeafPage::MoveHalfTo(BPlusTreeLeafPage *recipient) {
   ASSERT(recipient != nullptr, "recipient is null!");
   int half = GetSize() / 2;
-  recipient->CopyNFrom(PairPtrAt(GetSize() - half), half);
-  IncreaseSize(-half);
+  auto area = Area();
+  recipient->CopyNFrom(area.Items(GetSize() - half, GetSize()));
+  area.Rebuild(area.Items(0, GetSize() - half));
 }
 
 /*
- * Copy starting from items, and copy {size} number of elements into me.
+ * Append the items to the end of my entries.
  */
-void BPlusTreeLeafPage::CopyNFrom(void *src, int size) {
-  PairCopy(PairPtrAt(GetSize()), src, size);
-  IncreaseSize(size);
+void BPlusTreeLeafPage::CopyNFrom(const std::vector<SlottedKeyArea::Item> &items) {
+  auto area = Area();
+  auto all = area.Items(0, GetSize());
+  all.insert(all.end(), items.begin(), items.end());
+  area.Rebuild(all);
 }
 
 /*****************************************************************************
@@ -153,7 +199,8 @@ bool BPlusTreeLeafPage::Lookup(const GenericKey *key, RowId &value, const KeyMan
   if (index == GetSize()) {
     return false;
   }
-  if (KM.CompareKeys(KeyAt(index), key) == 0) {
+  KeyBuffer found(GetKeySize());
+  if (KM.CompareKeys(KeyAt(index, found.Get()), key) == 0) {
     value = ValueAt(index);
     return true;
   }
@@ -171,11 +218,11 @@ bool BPlusTreeLeafPage::Lookup(const GenericKey *key, RowId &value, const KeyMan
  */
 int BPlusTreeLeafPage::RemoveAndDeleteRecord(const GenericKey *key, const KeyManager &KM) {
   int index = KeyIndex(key, KM);
-  if (index == GetSize() || KM.CompareKeys(KeyAt(index), key) != 0) {
+  KeyBuffer found(GetKeySize());
+  if (index == GetSize() || KM.CompareKeys(KeyAt(index, found.Get()), key) != 0) {
     return GetSize();
   }
-  PairCopy(PairPtrAt(index), PairPtrAt(index + 1), GetSize() - index - 1);
-  IncreaseSize(-1);
+  Area().RemoveAt(index);
   return GetSize();
 }
 
@@ -189,9 +236,9 @@ int BPlusTreeLeafPage::RemoveAndDeleteRecord(const GenericKey *key, const KeyMan
  */
 void BPlusTreeLeafPage::MoveAllTo(BPlusTreeLeafPage *recipient) {
   ASSERT(recipient != nullptr, "recipient is null!");
-  recipient->CopyNFrom(PairPtrAt(0), GetSize());
+  recipient->CopyNFrom(Area().Items(0, GetSize()));
   recipient->SetNextPageId(GetNextPageId());
-  SetSize(0);
+  Area().Rebuild({});
 }
 
 /*****************************************************************************
@@ -202,18 +249,17 @@ void BPlusTreeLeafPage::MoveAllTo(BPlusTreeLeafPage *recipient) {
  */
 void BPlusTreeLeafPage::MoveFirstToEndOf(BPlusTreeLeafPage *recipient) {
   ASSERT(recipient != nullptr, "recipient is null!");
-  recipient->CopyLastFrom(KeyAt(0), ValueAt(0));
-  PairCopy(PairPtrAt(0), PairPtrAt(1), GetSize() - 1);
-  IncreaseSize(-1);
+  KeyBuffer key(GetKeySize());
+  recipient->CopyLastFrom(KeyAt(0, key.Get()), ValueAt(0));
+  Area().RemoveAt(0);
 }
 
 /*
  * Copy the item into the end of my item list. (Append item to my array)
  */
 void BPlusTreeLeafPage::CopyLastFrom(GenericKey *key, const RowId value) {
-  SetKeyAt(GetSize(), key);
-  SetValueAt(GetSize(), value);
-  IncreaseSize(1);
+  auto area = Area();
+  area.InsertAt(GetSize(), area.Encode(key), &value);
 }
 
 /*
@@ -221,16 +267,15 @@ void BPlusTreeLeafPage::CopyLastFrom(GenericKey *key, const RowId value) {
  */
 void BPlusTreeLeafPage::MoveLastToFrontOf(BPlusTreeLeafPage *recipient) {
   ASSERT(recipient != nullptr, "recipient is null!");
-  recipient->CopyFirstFrom(KeyAt(GetSize() - 1), ValueAt(GetSize() - 1));
-  IncreaseSize(-1);
+  KeyBuffer key(GetKeySize());
+  recipient->CopyFirstFrom(KeyAt(GetSize() - 1, key.Get()), ValueAt(GetSize() - 1));
+  Area().RemoveAt(GetSize() - 1);
 }
 
 /*
  * Insert item at the front of my items. Move items accordingly.
  */
 void BPlusTreeLeafPage::CopyFirstFrom(GenericKey *key, const RowId value) {
-  PairCopy(PairPtrAt(1), PairPtrAt(0), GetSize());
-  SetKeyAt(0, key);
-  SetValueAt(0, value);
-  IncreaseSize(1);
+  auto area = Area();
+  area.InsertAt(0, area.Encode(key), &value);
 }
\ No newline at end of file
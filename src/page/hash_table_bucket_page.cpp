@@ -0,0 +1,77 @@
+#include "page/hash_table_bucket_page.h"
+
+void HashTableBucketPage::Init(page_id_t page_id, int key_size) {
+  page_id_ = page_id;
+  next_page_id_ = INVALID_PAGE_ID;
+  key_size_ = key_size;
+  size_ = 0;
+}
+
+page_id_t HashTableBucketPage::GetPageId() const {
+  return page_id_;
+}
+
+page_id_t HashTableBucketPage::GetNextPageId() const {
+  return next_page_id_;
+}
+
+void HashTableBucketPage::SetNextPageId(page_id_t next_page_id) {
+  next_page_id_ = next_page_id;
+}
+
+int HashTableBucketPage::GetSize() const {
+  return size_;
+}
+
+int HashTableBucketPage::GetMaxSize() const {
+  return sizeof(data_) / (key_size_ + sizeof(RowId));
+}
+
+bool HashTableBucketPage::IsFull() const {
+  return size_ >= GetMaxSize();
+}
+
+bool HashTableBucketPage::IsEmpty() const {
+  return size_ == 0;
+}
+
+char *HashTableBucketPage::EntryAt(int index) {
+  return data_ + index * (key_size_ + sizeof(RowId));
+}
+
+GenericKey *HashTableBucketPage::KeyAt(int index) {
+  return reinterpret_cast<GenericKey *>(EntryAt(index));
+}
+
+RowId HashTableBucketPage::ValueAt(int index) const {
+  RowId value;
+  memcpy(&value, const_cast<HashTableBucketPage *>(this)->EntryAt(index) + key_size_, sizeof(RowId));
+  return value;
+}
+
+/*
+ * key是SerializeFromKey得到的定长buffer，相等的key逐字节相同，直接比较字节
+ */
+int HashTableBucketPage::Find(const GenericKey *key, int len, int begin) {
+  for (int i = begin; i < size_; i++) {
+    if (memcmp(EntryAt(i), key, len) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void HashTableBucketPage::Append(const GenericKey *key, const RowId &value) {
+  ASSERT(!IsFull(), "Hash bucket overflow.");
+  char *entry = EntryAt(size_);
+  memcpy(entry, key, key_size_);
+  memcpy(entry + key_size_, &value, sizeof(RowId));
+  size_++;
+}
+
+void HashTableBucketPage::RemoveAt(int index) {
+  size_--;
+  if (index != size_) {
+    memcpy(EntryAt(index), EntryAt(size_), key_size_ + sizeof(RowId));
+  }
+}
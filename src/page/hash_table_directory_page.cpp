@@ -0,0 +1,78 @@
+#include "page/hash_table_directory_page.h"
+
+#include "common/macros.h"
+
+/*
+ * Init method after creating a new directory page, all keys go to bucket_page_id
+ */
+void HashTableDirectoryPage::Init(page_id_t page_id, page_id_t bucket_page_id) {
+  page_id_ = page_id;
+  global_depth_ = 0;
+  local_depths_[0] = 0;
+  bucket_page_ids_[0] = bucket_page_id;
+}
+
+page_id_t HashTableDirectoryPage::GetPageId() const {
+  return page_id_;
+}
+
+page_id_t HashTableDirectoryPage::GetBucketPageId(uint32_t bucket_idx) const {
+  return bucket_page_ids_[bucket_idx];
+}
+
+void HashTableDirectoryPage::SetBucketPageId(uint32_t bucket_idx, page_id_t bucket_page_id) {
+  bucket_page_ids_[bucket_idx] = bucket_page_id;
+}
+
+uint32_t HashTableDirectoryPage::GetSplitImageIndex(uint32_t bucket_idx) const {
+  uint32_t local_depth = local_depths_[bucket_idx];
+  ASSERT(local_depth > 0, "Bucket with local depth 0 has no split image.");
+  return bucket_idx ^ (1U << (local_depth - 1));
+}
+
+uint32_t HashTableDirectoryPage::GetGlobalDepth() const {
+  return global_depth_;
+}
+
+uint32_t HashTableDirectoryPage::GetGlobalDepthMask() const {
+  return (1U << global_depth_) - 1;
+}
+
+uint32_t HashTableDirectoryPage::GetLocalDepth(uint32_t bucket_idx) const {
+  return local_depths_[bucket_idx];
+}
+
+void HashTableDirectoryPage::SetLocalDepth(uint32_t bucket_idx, uint32_t local_depth) {
+  local_depths_[bucket_idx] = local_depth;
+}
+
+void HashTableDirectoryPage::IncrGlobalDepth() {
+  ASSERT(global_depth_ < HASH_MAX_GLOBAL_DEPTH, "Hash directory is full.");
+  uint32_t size = Size();
+  for (uint32_t i = 0; i < size; i++) {
+    local_depths_[i + size] = local_depths_[i];
+    bucket_page_ids_[i + size] = bucket_page_ids_[i];
+  }
+  global_depth_++;
+}
+
+void HashTableDirectoryPage::DecrGlobalDepth() {
+  ASSERT(global_depth_ > 0, "Hash directory can not shrink.");
+  global_depth_--;
+}
+
+bool HashTableDirectoryPage::CanShrink() const {
+  if (global_depth_ == 0) {
+    return false;
+  }
+  for (uint32_t i = 0; i < Size(); i++) {
+    if (local_depths_[i] == global_depth_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t HashTableDirectoryPage::Size() const {
+  return 1U << global_depth_;
+}
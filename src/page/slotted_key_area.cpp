@@ -0,0 +1,313 @@
+#include "page/slotted_key_area.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include "index/int_key_search.h"
+
+uint16_t SlottedKeyArea::Read16(int off) const {
+  uint16_t v;
+  memcpy(&v, data_ + off, sizeof(uint16_t));
+  return v;
+}
+
+void SlottedKeyArea::Write16(int off, uint16_t v) {
+  memcpy(data_ + off, &v, sizeof(uint16_t));
+}
+
+void SlottedKeyArea::Init(int tail_size, bool int_keys) {
+  ASSERT(HeapEnd() - AREA_HEADER_SIZE >= 4 * (page_->GetKeySize() + SlotSize()), "Key size too large for a page.");
+  Write16(OFFSET_PREFIX_LEN, 0);
+  Write16(OFFSET_TAIL_SIZE, tail_size);
+  Write16(OFFSET_HEAP_TOP, HeapEnd());
+  Write16(OFFSET_FRAG_BYTES, 0);
+  Write16(OFFSET_FLAGS, int_keys ? INT_KEYS : 0);
+}
+
+uint16_t SlottedKeyArea::Flags() const {
+  return Read16(OFFSET_FLAGS);
+}
+
+void SlottedKeyArea::SetFlags(uint16_t flags) {
+  Write16(OFFSET_FLAGS, flags);
+}
+
+bool SlottedKeyArea::CanSearchInt() const {
+  return Flags() == INT_KEYS;
+}
+
+void SlottedKeyArea::WriteIntKey(int index, const std::string &key, bool has_key) {
+  int32_t value = INT_MIN;
+  if (has_key && !KeyManager::ReadIntKey(key.data(), key.size() - TailSize(), value)) {
+    value = INT_MIN;
+    SetFlags(Flags() | NULL_KEY);
+  }
+  memcpy(data_ + IntOff(index), &value, sizeof(int32_t));
+}
+
+void SlottedKeyArea::IntEqualRange(int32_t target, int begin, int end, int &lo, int &hi) const {
+  const char *keys = data_ + IntOff(begin);
+  lo = begin + IntKeySearch::LowerBound(keys, end - begin, target);
+  if (target == INT_MAX) {
+    hi = end;
+    return;
+  }
+  hi = lo + IntKeySearch::LowerBound(data_ + IntOff(lo), end - lo, target + 1);
+}
+
+int SlottedKeyArea::GetPrefixLen() const {
+  return Read16(OFFSET_PREFIX_LEN);
+}
+
+int SlottedKeyArea::TailSize() const {
+  return Read16(OFFSET_TAIL_SIZE);
+}
+
+int SlottedKeyArea::GetCapacity() const {
+  return HeapEnd() - AREA_HEADER_SIZE;
+}
+
+int SlottedKeyArea::GetUsedBytes() const {
+  return GetPrefixLen() + page_->GetSize() * EntrySize() + (HeapEnd() - Read16(OFFSET_HEAP_TOP) - Read16(OFFSET_FRAG_BYTES));
+}
+
+int SlottedKeyArea::CommonPrefix(const char *a, int a_len, const char *b, int b_len) {
+  int len = std::min(a_len, b_len);
+  int i = 0;
+  while (i < len && a[i] == b[i]) {
+    i++;
+  }
+  return i;
+}
+
+bool SlottedKeyArea::HasKey(int index) const {
+  return Read16(SlotOff(index) + 2) != NO_KEY;
+}
+
+int SlottedKeyArea::KeyedCount() const {
+  int count = 0;
+  for (int i = 0; i < page_->GetSize(); i++) {
+    count += HasKey(i) ? 1 : 0;
+  }
+  return count;
+}
+
+/*
+ * 解码到调用者的key中，读取时不写页面
+ */
+GenericKey *SlottedKeyArea::KeyAt(int index, GenericKey *key) const {
+  int key_size = page_->GetKeySize();
+  char *buf = reinterpret_cast<char *>(key);
+  int slot = SlotOff(index);
+  uint16_t len = Read16(slot + 2);
+  if (len == NO_KEY) {
+    memset(buf, 0, key_size);
+    return key;
+  }
+  int prefix_len = GetPrefixLen();
+  int tail = TailSize();
+  int row_rest = len - tail;
+  const char *entry = data_ + Read16(slot);
+  memcpy(buf, data_ + AREA_HEADER_SIZE, prefix_len);
+  memcpy(buf + prefix_len, entry, row_rest);
+  memset(buf + prefix_len + row_rest, 0, key_size - tail - prefix_len - row_rest);
+  memcpy(buf + key_size - tail, entry + row_rest, tail);
+  return key;
+}
+
+void SlottedKeyArea::ValueAt(int index, void *value) const {
+  memcpy(value, data_ + SlotOff(index) + 4, value_size_);
+}
+
+void SlottedKeyArea::SetValueAt(int index, const void *value) {
+  memcpy(data_ + SlotOff(index) + 4, value, value_size_);
+}
+
+std::string SlottedKeyArea::Encode(const GenericKey *key) const {
+  auto raw = reinterpret_cast<const char *>(key);
+  int key_size = page_->GetKeySize();
+  int tail = TailSize();
+  int row_len = key_size - tail;
+  while (row_len > 0 && raw[row_len - 1] == 0) {
+    row_len--;
+  }
+  std::string compact(raw, row_len);
+  compact.append(raw + key_size - tail, tail);
+  return compact;
+}
+
+std::vector<SlottedKeyArea::Item> SlottedKeyArea::Items(int begin, int end) const {
+  std::vector<Item> items(end - begin);
+  int prefix_len = GetPrefixLen();
+  for (int i = begin; i < end; i++) {
+    Item &item = items[i - begin];
+    int slot = SlotOff(i);
+    uint16_t len = Read16(slot + 2);
+    item.has_key = len != NO_KEY;
+    if (item.has_key) {
+      item.key.reserve(prefix_len + len);
+      item.key.assign(data_ + AREA_HEADER_SIZE, prefix_len);
+      item.key.append(data_ + Read16(slot), len);
+    }
+    memcpy(&item.value, data_ + slot + 4, value_size_);
+  }
+  return items;
+}
+
+int SlottedKeyArea::RequiredBytes(const std::vector<Item> &items) const {
+  int tail = TailSize();
+  const Item *first = nullptr;
+  int prefix_len = 0;
+  int total = 0;
+  int keyed = 0;
+  for (auto &item : items) {
+    if (!item.has_key) {
+      continue;
+    }
+    int row_len = item.key.size() - tail;
+    if (first == nullptr) {
+      first = &item;
+      prefix_len = row_len;
+    } else {
+      prefix_len = std::min(prefix_len, CommonPrefix(first->key.data(), prefix_len, item.key.data(), row_len));
+    }
+    total += item.key.size();
+    keyed++;
+  }
+  return total - keyed * prefix_len + prefix_len + items.size() * EntrySize();
+}
+
+void SlottedKeyArea::Rebuild(const std::vector<Item> &items) {
+  ASSERT(RequiredBytes(items) <= GetCapacity(), "Page overflow when rebuilding slotted keys.");
+  int tail = TailSize();
+  const Item *first = nullptr;
+  int prefix_len = 0;
+  for (auto &item : items) {
+    if (!item.has_key) {
+      continue;
+    }
+    int row_len = item.key.size() - tail;
+    if (first == nullptr) {
+      first = &item;
+      prefix_len = row_len;
+    } else {
+      prefix_len = std::min(prefix_len, CommonPrefix(first->key.data(), prefix_len, item.key.data(), row_len));
+    }
+  }
+  Write16(OFFSET_PREFIX_LEN, prefix_len);
+  Write16(OFFSET_FRAG_BYTES, 0);
+  SetFlags(Flags() & ~NULL_KEY);
+  if (first != nullptr) {
+    memcpy(data_ + AREA_HEADER_SIZE, first->key.data(), prefix_len);
+  }
+  page_->SetSize(items.size());
+  int heap_top = HeapEnd();
+  for (size_t i = 0; i < items.size(); i++) {
+    int slot = SlotOff(i);
+    if (items[i].has_key) {
+      int len = items[i].key.size() - prefix_len;
+      heap_top -= len;
+      memcpy(data_ + heap_top, items[i].key.data() + prefix_len, len);
+      Write16(slot, heap_top);
+      Write16(slot + 2, len);
+    } else {
+      Write16(slot, heap_top);
+      Write16(slot + 2, NO_KEY);
+    }
+    memcpy(data_ + slot + 4, &items[i].value, value_size_);
+    if (IntSize() != 0) {
+      WriteIntKey(i, items[i].key, items[i].has_key);
+    }
+  }
+  Write16(OFFSET_HEAP_TOP, heap_top);
+}
+
+int SlottedKeyArea::InsertCost(const std::string &key) const {
+  int prefix_len = GetPrefixLen();
+  int row_len = key.size() - TailSize();
+  int common = CommonPrefix(data_ + AREA_HEADER_SIZE, prefix_len, key.data(), row_len);
+  if (common == prefix_len) {
+    return key.size() - prefix_len + EntrySize();
+  }
+  // 公共前缀变短，页内已有的每个key都要多存(prefix_len - common)个字节
+  int grow = prefix_len - common;
+  return key.size() - common + EntrySize() + KeyedCount() * grow - grow;
+}
+
+void SlottedKeyArea::InsertAt(int index, const std::string &key, const void *value, bool has_key) {
+  int size = page_->GetSize();
+  int prefix_len = GetPrefixLen();
+  int row_len = key.size() - TailSize();
+  int len = has_key ? key.size() - prefix_len : 0;
+  bool prefix_match = !has_key || (size > 0 && row_len >= prefix_len &&
+                                   memcmp(data_ + AREA_HEADER_SIZE, key.data(), prefix_len) == 0);
+  if (!prefix_match || Read16(OFFSET_HEAP_TOP) - SlotOff(size) < len + EntrySize()) {
+    // 前缀不匹配、空页或者空闲空间不连续时，整页重建
+    auto items = Items(0, size);
+    Item item;
+    item.key = key;
+    item.has_key = has_key;
+    memcpy(&item.value, value, value_size_);
+    items.insert(items.begin() + index, std::move(item));
+    Rebuild(items);
+    return;
+  }
+  int heap_top = Read16(OFFSET_HEAP_TOP) - len;
+  memcpy(data_ + heap_top, key.data() + prefix_len, len);
+  Write16(OFFSET_HEAP_TOP, heap_top);
+  if (IntSize() != 0) {
+    // int数组变长，slot数组整体后移4字节，先移动后面的部分以免覆盖
+    int slots = SlotOff(0);
+    int slot_size = SlotSize();
+    memmove(data_ + slots + IntSize() + (index + 1) * slot_size, data_ + slots + index * slot_size,
+            (size - index) * slot_size);
+    memmove(data_ + slots + IntSize(), data_ + slots, index * slot_size);
+    memmove(data_ + IntOff(index + 1), data_ + IntOff(index), (size - index) * IntSize());
+    WriteIntKey(index, key, has_key);
+  } else {
+    int slot = SlotOff(index);
+    memmove(data_ + slot + SlotSize(), data_ + slot, (size - index) * SlotSize());
+  }
+  page_->IncreaseSize(1);
+  int slot = SlotOff(index);
+  Write16(slot, heap_top);
+  Write16(slot + 2, has_key ? len : NO_KEY);
+  memcpy(data_ + slot + 4, value, value_size_);
+}
+
+void SlottedKeyArea::RemoveAt(int index) {
+  int size = page_->GetSize();
+  int slot = SlotOff(index);
+  uint16_t len = Read16(slot + 2);
+  if (len != NO_KEY) {
+    if (Read16(slot) == Read16(OFFSET_HEAP_TOP)) {
+      Write16(OFFSET_HEAP_TOP, Read16(OFFSET_HEAP_TOP) + len);
+    } else {
+      Write16(OFFSET_FRAG_BYTES, Read16(OFFSET_FRAG_BYTES) + len);
+    }
+  }
+  if (IntSize() != 0) {
+    int slots = SlotOff(0);
+    int slot_size = SlotSize();
+    memmove(data_ + IntOff(index), data_ + IntOff(index + 1), (size - index - 1) * IntSize());
+    memmove(data_ + slots - IntSize(), data_ + slots, index * slot_size);
+    memmove(data_ + slots - IntSize() + index * slot_size, data_ + slot + slot_size, (size - index - 1) * slot_size);
+  } else {
+    memmove(data_ + slot, data_ + slot + SlotSize(), (size - index - 1) * SlotSize());
+  }
+  page_->IncreaseSize(-1);
+  if (size == 1) {
+    Write16(OFFSET_PREFIX_LEN, 0);
+    Write16(OFFSET_HEAP_TOP, HeapEnd());
+    Write16(OFFSET_FRAG_BYTES, 0);
+    SetFlags(Flags() & ~NULL_KEY);
+  }
+}
+
+void SlottedKeyArea::SetKeyAt(int index, const std::string &key) {
+  int64_t value = 0;
+  ValueAt(index, &value);
+  RemoveAt(index);
+  InsertAt(index, key, &value);
+}
@@ -165,6 +165,26 @@ bool TablePage::GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_m
   return true;
 }
 
+bool TablePage::GetTuple(const RowId &rid, DataChunk *chunk) {
+  uint32_t slot_num = rid.GetSlotNum();
+  if (slot_num >= GetTupleCount() || IsDeleted(GetTupleSize(slot_num))) {
+    return false;
+  }
+  chunk->AppendSerialized(GetData() + GetTupleOffsetAtSlot(slot_num), rid);
+  return true;
+}
+
+uint32_t TablePage::ScanTuples(uint32_t slot_num, DataChunk *chunk) {
+  uint32_t tuple_count = GetTupleCount();
+  page_id_t page_id = GetTablePageId();
+  for (; slot_num < tuple_count && !chunk->IsFull(); slot_num++) {
+    if (!IsDeleted(GetTupleSize(slot_num))) {
+      chunk->AppendSerialized(GetData() + GetTupleOffsetAtSlot(slot_num), RowId(page_id, slot_num));
+    }
+  }
+  return slot_num;
+}
+
 bool TablePage::GetFirstTupleRid(RowId *first_rid) {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); i++) {
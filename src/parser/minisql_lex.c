@@ -1171,13 +1171,15 @@ YY_RULE_SETUP
 #line 208 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
+  /* group、order等关键字在parser.c的关键字表中查找，count等非保留的关键字也可以作为名字 */
   yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
-  return IDENTIFIER;
+  int keyword = MinisqlParserKeyword(yytext);
+  return keyword != 0 ? keyword : IDENTIFIER;
 }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 214 "minisql.l"
+#line 216 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
@@ -1186,7 +1188,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 220 "minisql.l"
+#line 222 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
@@ -1195,7 +1197,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 226 "minisql.l"
+#line 228 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return EQ;
@@ -1203,7 +1205,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 231 "minisql.l"
+#line 233 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return NE;
@@ -1211,7 +1213,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 236 "minisql.l"
+#line 238 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return LE;
@@ -1219,7 +1221,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 241 "minisql.l"
+#line 243 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return GE;
@@ -1227,7 +1229,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 246 "minisql.l"
+#line 248 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return (',');
@@ -1235,7 +1237,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 251 "minisql.l"
+#line 253 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('*');
@@ -1243,7 +1245,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 256 "minisql.l"
+#line 258 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return (';');
@@ -1251,7 +1253,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 49:
 YY_RULE_SETUP
-#line 261 "minisql.l"
+#line 263 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('\'');
@@ -1259,7 +1261,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 50:
 YY_RULE_SETUP
-#line 266 "minisql.l"
+#line 268 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('<');
@@ -1267,7 +1269,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 51:
 YY_RULE_SETUP
-#line 271 "minisql.l"
+#line 273 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('>');
@@ -1275,7 +1277,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 52:
 YY_RULE_SETUP
-#line 276 "minisql.l"
+#line 278 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return ('(');
@@ -1283,7 +1285,7 @@ YY_RULE_SETUP
 	YY_BREAK
 case 53:
 YY_RULE_SETUP
-#line 281 "minisql.l"
+#line 283 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
   return (')');
@@ -1292,15 +1294,20 @@ YY_RULE_SETUP
 case 54:
 /* rule 54 can match eol */
 YY_RULE_SETUP
-#line 286 "minisql.l"
+#line 288 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
 }
 	YY_BREAK
 case 55:
 YY_RULE_SETUP
-#line 290 "minisql.l"
+#line 292 "minisql.l"
 {
+  /* 限定列名中的点，如c.id */
+  if (yytext[0] == '.') {
+    MinisqlParserMovePos(yylineno, yytext);
+    return ('.');
+  }
   char str[128] = {0};
   sprintf(str, "Unrecognized token [%s] in input sql.", yytext);
   MinisqlParserSetError(str);
@@ -1308,10 +1315,10 @@ YY_RULE_SETUP
 	YY_BREAK
 case 56:
 YY_RULE_SETUP
-#line 296 "minisql.l"
+#line 303 "minisql.l"
 ECHO;
 	YY_BREAK
-#line 1314 "../../parser/minisql_lex.c"
+#line 1321 "../../parser/minisql_lex.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -2320,7 +2327,7 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 296 "minisql.l"
+#line 303 "minisql.l"
 
 
 int yywrap() {
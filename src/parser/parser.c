@@ -1,7 +1,9 @@
 #include "parser/parser.h"
 
 #include <stdio.h>
+#include <strings.h>
 
+#include "parser/minisql_yacc.h"
 #include "parser/syntax_tree.h"
 
 pSyntaxNode minisql_parser_root_node_ = NULL;
@@ -12,6 +14,16 @@ int minisql_parser_error_ = 0;
 char *minisql_parser_error_message_ = NULL;
 int minisql_parser_debug_node_count_ = 0;
 
+// minisql.l中identifier的规则先查这张表，表中的词作为关键字返回
+static const struct {
+  const char *word_;
+  int token_;
+} minisql_parser_keywords_[] = {
+    {"group", GROUP}, {"order", ORDER}, {"by", BY}, {"asc", ASC}, {"desc", DESC}, {"limit", LIMIT}, {"offset", OFFSET},
+    {"analyze", ANALYZE}, {"explain", EXPLAIN}, {"join", JOIN},
+    {"count", COUNT}, {"sum", SUM}, {"min", MIN}, {"max", MAX}, {"avg", AVG},
+};
+
 void MinisqlParserMovePos(int line, char *text) {
   size_t i = 0;
   while (i < strlen(text)) {
@@ -31,6 +43,15 @@ void MinisqlParserMovePos(int line, char *text) {
   }
 }
 
+int MinisqlParserKeyword(char *text) {
+  for (size_t i = 0; i < sizeof(minisql_parser_keywords_) / sizeof(minisql_parser_keywords_[0]); i++) {
+    if (strcasecmp(text, minisql_parser_keywords_[i].word_) == 0) {
+      return minisql_parser_keywords_[i].token_;
+    }
+  }
+  return 0;
+}
+
 void MinisqlParserSetRoot(pSyntaxNode node) {
   minisql_parser_root_node_ = node;
 }
@@ -170,6 +170,26 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeTrxCommit";
     case kNodeTrxRollback:
       return "kNodeTrxRollback";
+    case kNodeTableOption:
+      return "kNodeTableOption";
+    case kNodeAnalyze:
+      return "kNodeAnalyze";
+    case kNodeExplain:
+      return "kNodeExplain";
+    case kNodeSet:
+      return "kNodeSet";
+    case kNodeJoin:
+      return "kNodeJoin";
+    case kNodeFunction:
+      return "kNodeFunction";
+    case kNodeGroupBy:
+      return "kNodeGroupBy";
+    case kNodeOrderBy:
+      return "kNodeOrderBy";
+    case kNodeLimit:
+      return "kNodeLimit";
+    case kNodeOffset:
+      return "kNodeOffset";
     default:
       return "error type";
   }
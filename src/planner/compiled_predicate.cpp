@@ -0,0 +1,139 @@
+#include "planner/compiled_predicate.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+
+namespace {
+
+template <typename T>
+inline bool CompareValues(CompareOp op, T lhs, T rhs) {
+  switch (op) {
+    case CompareOp::Equal:
+      return lhs == rhs;
+    case CompareOp::NotEqual:
+      return lhs != rhs;
+    case CompareOp::LessThan:
+      return lhs < rhs;
+    case CompareOp::LessThanEquals:
+      return lhs <= rhs;
+    case CompareOp::GreaterThan:
+      return lhs > rhs;
+    case CompareOp::GreaterThanEquals:
+      return lhs >= rhs;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<CompiledPredicate> CompiledPredicate::Compile(const AbstractExpressionRef &predicate) {
+  if (predicate == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<CompiledPredicate> compiled(new CompiledPredicate());
+  compiled->root_ = compiled->CompileTerm(predicate);
+  return compiled;
+}
+
+uint32_t CompiledPredicate::CompileTerm(const AbstractExpressionRef &expression) {
+  Term term;
+  auto logic = std::dynamic_pointer_cast<LogicExpression>(expression);
+  if (logic != nullptr) {
+    term.type_ = logic->logic_type_ == LogicType::And ? TermType::And : TermType::Or;
+    term.left_ = CompileTerm(logic->GetChildAt(0));
+    term.right_ = CompileTerm(logic->GetChildAt(1));
+  } else if (!CompileComparison(expression, term)) {
+    term.type_ = TermType::Expression;
+    term.expression_ = expression;
+    fallback_count_++;
+  }
+  terms_.push_back(std::move(term));
+  return terms_.size() - 1;
+}
+
+bool CompiledPredicate::CompileComparison(const AbstractExpressionRef &expression, Term &term) {
+  auto comparison = std::dynamic_pointer_cast<ComparisonExpression>(expression);
+  if (comparison == nullptr) {
+    return false;
+  }
+  auto column = std::dynamic_pointer_cast<ColumnValueExpression>(comparison->GetChildAt(0));
+  if (column == nullptr || column->GetRowIdx() != 0) {
+    return false;
+  }
+  term.op_ = comparison->GetCompareOp();
+  term.col_idx_ = column->GetColIdx();
+  if (term.op_ == CompareOp::IsNull || term.op_ == CompareOp::NotNull) {
+    term.type_ = TermType::CompareNull;
+    return true;
+  }
+  auto constant = std::dynamic_pointer_cast<ConstantValueExpression>(comparison->GetChildAt(1));
+  if (constant == nullptr || constant->val_.GetTypeId() != column->GetReturnType()) {
+    return false;
+  }
+  const Field &value = constant->val_;
+  if (value.IsNull()) {
+    // 和null比较的结果是null，不成立
+    term.type_ = TermType::Constant;
+    term.value_ = false;
+    return true;
+  }
+  switch (value.GetTypeId()) {
+    case kTypeInt:
+      term.type_ = TermType::CompareInt;
+      term.int_value_ = value.GetInteger();
+      return true;
+    case kTypeFloat:
+      term.type_ = TermType::CompareFloat;
+      term.float_value_ = value.GetFloat();
+      return true;
+    case kTypeChar:
+      term.type_ = TermType::CompareChar;
+      term.chars_.assign(value.GetData(), value.GetLength());
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool CompiledPredicate::Evaluate(uint32_t index, const Row &row) const {
+  const Term &term = terms_[index];
+  switch (term.type_) {
+    case TermType::And:
+      return Evaluate(term.left_, row) && Evaluate(term.right_, row);
+    case TermType::Or:
+      return Evaluate(term.left_, row) || Evaluate(term.right_, row);
+    case TermType::CompareInt: {
+      const Field *field = row.GetField(term.col_idx_);
+      return !field->IsNull() && CompareValues(term.op_, field->GetInteger(), term.int_value_);
+    }
+    case TermType::CompareFloat: {
+      const Field *field = row.GetField(term.col_idx_);
+      return !field->IsNull() && CompareValues(term.op_, field->GetFloat(), term.float_value_);
+    }
+    case TermType::CompareChar: {
+      const Field *field = row.GetField(term.col_idx_);
+      if (field->IsNull()) {
+        return false;
+      }
+      // 和TypeChar一样按字节比较，前缀相同时短的小
+      uint32_t length = field->GetLength();
+      int ret = memcmp(field->GetData(), term.chars_.data(), std::min<size_t>(length, term.chars_.size()));
+      if (ret == 0) {
+        ret = static_cast<int>(length) - static_cast<int>(term.chars_.size());
+      }
+      return CompareValues(term.op_, ret, 0);
+    }
+    case TermType::CompareNull:
+      return row.GetField(term.col_idx_)->IsNull() == (term.op_ == CompareOp::IsNull);
+    case TermType::Constant:
+      return term.value_;
+    default:
+      return term.expression_->Evaluate(&row).CompareEquals(Field(kTypeInt, 1)) == CmpBool::kTrue;
+  }
+}
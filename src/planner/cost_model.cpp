@@ -0,0 +1,111 @@
+#include "planner/cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "index/b_plus_tree_index.h"
+#include "page/b_plus_tree_leaf_page.h"
+
+CostModel::CostModel(const TableStatistics *statistics)
+    : rows_(static_cast<double>(statistics->GetRowCount())),
+      pages_(std::max(1.0, static_cast<double>(statistics->GetPageCount()))) {}
+
+double CostModel::SeqScan(size_t conditions) const {
+  return pages_ * SEQ_PAGE_COST + rows_ * CPU_TUPLE_COST + Filter(rows_, conditions);
+}
+
+/*
+ * 上层内部节点通常在buffer pool中，下降一次按一次随机读计；hash索引一次随机读到桶页，art索引在内存中
+ */
+double CostModel::IndexScan(IndexInfo *index, double entries) const {
+  double cpu = entries * CPU_INDEX_TUPLE_COST;
+  const std::string &type = index->GetIndexType();
+  if (type == "art") {
+    return cpu;
+  }
+  if (type == "hash") {
+    return RANDOM_PAGE_COST + cpu;
+  }
+  if (type == "clustered") {
+    // 叶子就是表的页
+    double leaves = rows_ == 0 ? 0 : std::ceil(entries / rows_ * pages_);
+    return RANDOM_PAGE_COST + leaves * SEQ_PAGE_COST + cpu + entries * CPU_TUPLE_COST;
+  }
+  double per_leaf = 1;
+  auto bptree = dynamic_cast<BPlusTreeIndex *>(index->GetIndex());
+  if (bptree != nullptr) {
+    per_leaf = std::max(1.0, (PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) * LEAF_FILL_FACTOR /
+                                 (bptree->GetKeyManager().GetKeySize() + sizeof(RowId)));
+  }
+  return RANDOM_PAGE_COST + std::ceil(entries / per_leaf) * SEQ_PAGE_COST + cpu;
+}
+
+/*
+ * 有序查找时要读的叶子和排序后回表的页一样估计：读的叶子越多越接近顺序读。每次查找在内部节点上二分
+ */
+double CostModel::IndexLookups(IndexInfo *index, double lookups, double entries_per_key) const {
+  if (lookups <= 0) {
+    return 0;
+  }
+  double per_leaf = 1;
+  auto bptree = dynamic_cast<BPlusTreeIndex *>(index->GetIndex());
+  if (bptree != nullptr) {
+    per_leaf = std::max(1.0, (PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) * LEAF_FILL_FACTOR /
+                                 (bptree->GetKeyManager().GetKeySize() + sizeof(RowId)));
+  }
+  double leaves = std::max(1.0, std::ceil(rows_ / per_leaf));
+  double touched = lookups * std::max(1.0, entries_per_key / per_leaf);
+  double pages = std::min(leaves, 2 * leaves * touched / (2 * leaves + touched));
+  double page_cost = pages >= 2 ? RANDOM_PAGE_COST - (RANDOM_PAGE_COST - SEQ_PAGE_COST) * std::sqrt(pages / leaves)
+                                : RANDOM_PAGE_COST;
+  double search = lookups * std::log2(std::max(2.0, rows_)) * CPU_OPERATOR_COST;
+  return pages * page_cost + search + lookups * entries_per_key * CPU_INDEX_TUPLE_COST;
+}
+
+/*
+ * Mackert-Lohman: 在T页中随机取N行，读到的不同页数约为 2TN / (2T + N)，不超过T；
+ * 完全相关时只顺序读 N / rows * T 页。两者之间按相关系数的平方插值（同PostgreSQL）
+ */
+double CostModel::FetchRows(double rows, double correlation) const {
+  if (rows <= 0) {
+    return 0;
+  }
+  double max_io = std::min(pages_, 2 * pages_ * rows / (2 * pages_ + rows)) * RANDOM_PAGE_COST;
+  double min_io = RANDOM_PAGE_COST + (std::ceil(std::min(1.0, rows / rows_) * pages_) - 1) * SEQ_PAGE_COST;
+  double squared = correlation * correlation;
+  return max_io + squared * (std::min(max_io, min_io) - max_io) + rows * CPU_TUPLE_COST;
+}
+
+/*
+ * 每页的代价从RANDOM_PAGE_COST随读的页占比的平方根降到SEQ_PAGE_COST（同PostgreSQL的bitmap heap scan）
+ */
+double CostModel::FetchSortedRows(double rows) const {
+  if (rows <= 0) {
+    return 0;
+  }
+  double pages = std::min(pages_, 2 * pages_ * rows / (2 * pages_ + rows));
+  double page_cost = pages >= 2 ? RANDOM_PAGE_COST - (RANDOM_PAGE_COST - SEQ_PAGE_COST) * std::sqrt(pages / pages_)
+                                : RANDOM_PAGE_COST;
+  return pages * page_cost + rows * CPU_TUPLE_COST;
+}
+
+double CostModel::MergeRowIds(double entries) const {
+  return entries <= 1 ? 0 : entries * std::log2(entries) * CPU_OPERATOR_COST;
+}
+
+double CostModel::Filter(double rows, size_t conditions) const { return rows * conditions * CPU_OPERATOR_COST; }
+
+/*
+ * 比较次数按 n log n 估计，top-N时堆只有limit行；写出的run每页写一次、合并时读一次
+ */
+double CostModel::Sort(double rows, double width, size_t work_memory, double limit) {
+  if (rows <= 1) {
+    return 0;
+  }
+  double depth = std::log2(std::max(2.0, limit >= 0 ? std::min(limit, rows) : rows));
+  double cost = rows * depth * CPU_OPERATOR_COST;
+  if (limit < 0 && rows * width > work_memory) {
+    cost += 2 * std::ceil(rows * width / PAGE_SIZE) * SEQ_PAGE_COST;
+  }
+  return cost;
+}
@@ -0,0 +1,177 @@
+#include "planner/key_range.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/logic_expression.h"
+
+bool KeyRange::Interval::IsPoint() const {
+  return lower_ != nullptr && upper_ != nullptr && !lower_strict_ && !upper_strict_ &&
+         lower_->CompareEquals(*upper_) == CmpBool::kTrue;
+}
+
+int KeyRange::Compare(const Field &lhs, const Field &rhs) {
+  if (lhs.CompareLessThan(rhs) == CmpBool::kTrue) {
+    return -1;
+  }
+  return lhs.CompareGreaterThan(rhs) == CmpBool::kTrue ? 1 : 0;
+}
+
+Field KeyRange::MinField(TypeId type) {
+  switch (type) {
+    case TypeId::kTypeInt:
+      return Field(TypeId::kTypeInt, INT_MIN);
+    case TypeId::kTypeFloat:
+      return Field(TypeId::kTypeFloat, -FLT_MAX);
+    default:
+      return Field(TypeId::kTypeChar, const_cast<char *>(""), 0, true);
+  }
+}
+
+bool KeyRange::Merge(const AbstractExpressionRef &predicate, std::vector<Interval> &intervals,
+                     std::vector<uint32_t> &merged_columns) {
+  if (predicate->GetType() == ExpressionType::LogicExpression) {
+    if (std::dynamic_pointer_cast<LogicExpression>(predicate)->logic_type_ != LogicType::And) {
+      return false;
+    }
+    bool lhs = Merge(predicate->GetChildAt(0), intervals, merged_columns);
+    bool rhs = Merge(predicate->GetChildAt(1), intervals, merged_columns);
+    return lhs && rhs;
+  }
+  if (predicate->GetType() != ExpressionType::ComparisonExpression) {
+    return false;
+  }
+  auto column = std::dynamic_pointer_cast<ColumnValueExpression>(predicate->GetChildAt(0));
+  if (column == nullptr) {
+    return false;
+  }
+  std::string op = std::dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType();
+  if (op != "=" && op != "<" && op != "<=" && op != ">" && op != ">=") {
+    return false;
+  }
+  Field value = predicate->GetChildAt(1)->Evaluate(nullptr);
+  auto key_col = std::find(merged_columns.begin(), merged_columns.end(), column->GetColIdx());
+  if (value.IsNull() || key_col == merged_columns.end()) {
+    return false;
+  }
+  Interval &interval = intervals[key_col - merged_columns.begin()];
+  // 下界取最大值，上界取最小值，相等时严格不等号优先
+  if (op == "=" || op == ">" || op == ">=") {
+    bool strict = op == ">";
+    int cmp = interval.lower_ == nullptr ? 1 : Compare(value, *interval.lower_);
+    if (cmp > 0) {
+      interval.lower_ = std::make_unique<Field>(value);
+      interval.lower_strict_ = strict;
+    } else if (cmp == 0) {
+      interval.lower_strict_ = interval.lower_strict_ || strict;
+    }
+  }
+  if (op == "=" || op == "<" || op == "<=") {
+    bool strict = op == "<";
+    int cmp = interval.upper_ == nullptr ? -1 : Compare(value, *interval.upper_);
+    if (cmp < 0) {
+      interval.upper_ = std::make_unique<Field>(value);
+      interval.upper_strict_ = strict;
+    } else if (cmp == 0) {
+      interval.upper_strict_ = interval.upper_strict_ || strict;
+    }
+  }
+  return true;
+}
+
+KeyRange::KeyRange(const AbstractExpressionRef &predicate, const Schema *key_schema) {
+  uint32_t key_count = key_schema->GetColumnCount();
+  std::vector<uint32_t> key_columns(key_count);
+  for (uint32_t i = 0; i < key_count; i++) {
+    key_columns[i] = key_schema->GetColumn(i)->GetTableInd();
+    key_types_.push_back(key_schema->GetColumn(i)->GetType());
+  }
+  intervals_.resize(key_count);
+  if (predicate == nullptr) {
+    exact_ = true;
+    return;
+  }
+  bool all_merged = Merge(predicate, intervals_, key_columns);
+  for (auto &interval : intervals_) {
+    if (interval.lower_ != nullptr && interval.upper_ != nullptr) {
+      int cmp = Compare(*interval.lower_, *interval.upper_);
+      if (cmp > 0 || (cmp == 0 && (interval.lower_strict_ || interval.upper_strict_))) {
+        empty_ = true;
+      }
+    }
+  }
+  while (eq_count_ < key_count && intervals_[eq_count_].IsPoint()) {
+    eq_count_++;
+  }
+  has_range_ = eq_count_ < key_count &&
+               (intervals_[eq_count_].lower_ != nullptr || intervals_[eq_count_].upper_ != nullptr);
+  // 范围之后的列上还有条件时，扫描结果需要再过滤
+  bool bounded_after = false;
+  for (uint32_t i = GetMatchedColumns(); i < key_count; i++) {
+    bounded_after = bounded_after || intervals_[i].lower_ != nullptr || intervals_[i].upper_ != nullptr;
+  }
+  exact_ = all_merged && !bounded_after;
+  intervals_.resize(GetMatchedColumns());
+}
+
+bool KeyRange::IsTighterThan(const KeyRange &other) const {
+  if (empty_ != other.empty_) {
+    return empty_;
+  }
+  if (eq_count_ != other.eq_count_) {
+    return eq_count_ > other.eq_count_;
+  }
+  if (has_range_ != other.has_range_) {
+    return has_range_;
+  }
+  return exact_ && !other.exact_;
+}
+
+bool KeyRange::GetStartKey(Row &key) const {
+  if (eq_count_ == 0 && (!has_range_ || intervals_[0].lower_ == nullptr)) {
+    return false;
+  }
+  // 等值前缀和范围下界之后的列取null，null排在最前；只有上界的列取最小值，跳过它的null
+  std::vector<Field> fields;
+  for (uint32_t i = 0; i < key_types_.size(); i++) {
+    if (i < intervals_.size() && intervals_[i].lower_ != nullptr) {
+      fields.emplace_back(*intervals_[i].lower_);
+    } else if (i < intervals_.size() && intervals_[i].upper_ != nullptr) {
+      fields.emplace_back(MinField(key_types_[i]));
+    } else {
+      fields.emplace_back(key_types_[i]);
+    }
+  }
+  key = Row(fields);
+  return true;
+}
+
+int KeyRange::Locate(const Row &key) const {
+  for (uint32_t i = 0; i < intervals_.size(); i++) {
+    const Field *field = key.GetField(i);
+    const Interval &interval = intervals_[i];
+    if (field->IsNull()) {
+      // null排在所有值之前，没有界的列可以是null
+      if (interval.lower_ != nullptr || interval.upper_ != nullptr) {
+        return -1;
+      }
+      continue;
+    }
+    if (interval.lower_ != nullptr) {
+      int cmp = Compare(*field, *interval.lower_);
+      if (cmp < 0 || (cmp == 0 && interval.lower_strict_)) {
+        return -1;
+      }
+    }
+    if (interval.upper_ != nullptr) {
+      int cmp = Compare(*field, *interval.upper_);
+      if (cmp > 0 || (cmp == 0 && interval.upper_strict_)) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
@@ -3,6 +3,8 @@
 //
 #include "planner/planner.h"
 
+#include "catalog/statistics.h"
+
 void Planner::PlanQuery(pSyntaxNode ast) {
   switch (ast->type_) {
     case kNodeSelect: {
@@ -34,27 +36,659 @@ void Planner::PlanQuery(pSyntaxNode ast) {
   }
 }
 AbstractPlanNodeRef Planner::PlanSelect(std::shared_ptr<SelectStatement> statement) {
-  auto out_schema = MakeOutputSchema(statement->column_list_);
+  AbstractPlanNodeRef plan;
+  if (!statement->join_tables_.empty()) {
+    plan = PlanJoin(statement);
+  } else {
+    plan = PlanScan(statement, MakeOutputSchema(statement->column_list_), true);
+    if (!statement->order_by_.empty() && !statement->IsAggregate()) {
+      plan = PlanOrderedScan(statement, plan);
+    }
+    // 只有查询的heap表顺序扫描并行，删除和更新仍在一个线程里扫描
+    TableInfo *table_info = nullptr;
+    context_->GetCatalog()->GetTable(statement->table_name_, table_info);
+    if (plan->GetType() == PlanType::SeqScan && context_->GetParallelism() > 1 && !table_info->IsClustered()) {
+      // 计划刚建好，还没有别处引用
+      auto seq_scan =
+          std::const_pointer_cast<SeqScanPlanNode>(std::static_pointer_cast<const SeqScanPlanNode>(plan));
+      seq_scan->SetParallelism(context_->GetParallelism(), context_->IsScanOrderPreserved());
+    }
+  }
+  if (statement->IsAggregate()) {
+    plan = PlanAggregation(statement, plan);
+  }
+  if (!statement->order_by_.empty() && !ProvidesOrder(statement, plan)) {
+    // top-N保留到offset + limit行，offset再由limit跳过
+    plan = PlanSort(statement, plan);
+    if (statement->offset_ == 0) {
+      return plan;
+    }
+  }
+  if (statement->limit_ >= 0) {
+    plan = PlanLimit(statement, plan);
+  }
+  return plan;
+}
+
+AbstractPlanNodeRef Planner::PlanSort(const std::shared_ptr<SelectStatement> &statement,
+                                      const AbstractPlanNodeRef &child) {
+  double goal = RowGoal(statement);
+  auto plan = make_shared<SortPlanNode>(child, statement->order_by_, static_cast<int64_t>(goal));
+  double rows = child->GetEstimatedRows();
+  if (rows >= 0) {
+    plan->SetEstimate(goal >= 0 ? std::min(rows, goal) : rows,
+                      child->GetEstimatedCost() + CostModel::Sort(rows, RowWidth(child->OutputSchema()),
+                                                                  context_->GetWorkMemory(), goal));
+  }
+  return plan;
+}
+
+/*
+ * 扫描边读边输出，到limit就停止；排序、聚合和join要先读完输入，代价不变
+ */
+AbstractPlanNodeRef Planner::PlanLimit(const std::shared_ptr<SelectStatement> &statement,
+                                       const AbstractPlanNodeRef &child) {
+  auto plan = make_shared<LimitPlanNode>(child, statement->limit_, statement->offset_);
+  double rows = child->GetEstimatedRows();
+  if (rows < 0) {
+    return plan;
+  }
+  double offset = static_cast<double>(statement->offset_);
+  double cost = child->GetEstimatedCost();
+  bool streaming = child->GetType() == PlanType::SeqScan || child->GetType() == PlanType::IndexOnlyScan ||
+                   (child->GetType() == PlanType::IndexScan &&
+                    std::static_pointer_cast<const IndexScanPlanNode>(child)->range_ != nullptr);
+  if (streaming && rows > 0) {
+    cost *= std::min(1.0, RowGoal(statement) / rows);
+  }
+  plan->SetEstimate(std::min(std::max(0.0, rows - offset), static_cast<double>(statement->limit_)), cost);
+  return plan;
+}
+
+double Planner::RowGoal(const std::shared_ptr<SelectStatement> &statement) {
+  return statement->limit_ >= 0 ? static_cast<double>(statement->limit_ + statement->offset_) : -1;
+}
+
+/*
+ * 等值条件固定了索引的前几列时，这几列在所有行上都相同，排序列可以跳过它们；
+ * 其余排序列依次是索引接下来的列，且都是升序
+ */
+bool Planner::ProvidesOrder(const std::shared_ptr<SelectStatement> &statement, const AbstractPlanNodeRef &plan) {
+  if (!statement->join_tables_.empty() || statement->IsAggregate()) {
+    return false;
+  }
+  const Schema *key_schema = nullptr;
+  switch (plan->GetType()) {
+    case PlanType::IndexScan: {
+      auto index_scan = std::static_pointer_cast<const IndexScanPlanNode>(plan);
+      if (index_scan->range_ == nullptr) {
+        return false;
+      }
+      key_schema = index_scan->indexes_[0]->GetIndexKeySchema();
+      break;
+    }
+    case PlanType::IndexOnlyScan:
+      key_schema = std::static_pointer_cast<const IndexOnlyScanPlanNode>(plan)->index_->GetIndexKeySchema();
+      break;
+    case PlanType::SeqScan: {
+      // clustered表按主键顺序扫描
+      if (std::static_pointer_cast<const SeqScanPlanNode>(plan)->GetParallelism() > 1) {
+        return false;
+      }
+      vector<IndexInfo *> indexes;
+      context_->GetCatalog()->GetTableIndexes(statement->table_name_, indexes);
+      for (auto index : indexes) {
+        if (index->GetIndexType() == "clustered") {
+          key_schema = index->GetIndexKeySchema();
+        }
+      }
+      if (key_schema == nullptr) {
+        return false;
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+  KeyRange range(statement->where_, key_schema);
+  uint32_t next = range.GetEqualityCount();
+  for (const auto &order_by : statement->order_by_) {
+    uint32_t column = plan->OutputSchema()->GetColumn(order_by.first)->GetTableInd();
+    bool fixed = false;
+    for (uint32_t i = 0; i < range.GetEqualityCount(); i++) {
+      fixed |= key_schema->GetColumn(i)->GetTableInd() == column;
+    }
+    if (fixed) {
+      continue;
+    }
+    if (order_by.second || next >= key_schema->GetColumnCount() || key_schema->GetColumn(next)->GetTableInd() != column) {
+      return false;
+    }
+    next++;
+  }
+  return true;
+}
+
+/*
+ * 候选是每个能给出这个顺序的b+树(或clustered)索引上的扫描。有limit时回表只做到第limit行为止。
+ * 没有统计信息时，只在索引覆盖查询或者有limit时用索引的顺序
+ */
+AbstractPlanNodeRef Planner::PlanOrderedScan(const std::shared_ptr<SelectStatement> &statement,
+                                             const AbstractPlanNodeRef &chosen) {
+  if (ProvidesOrder(statement, chosen)) {
+    return chosen;
+  }
   vector<IndexInfo *> indexes;
-  vector<IndexInfo *> available_index;
   context_->GetCatalog()->GetTableIndexes(statement->table_name_, indexes);
+  TableInfo *table_info = nullptr;
+  context_->GetCatalog()->GetTable(statement->table_name_, table_info);
+  const TableStatistics *statistics = table_info->GetStatistics();
+  const auto &where = statement->where_;
+  std::vector<uint32_t> needed(statement->column_in_condition_);
+  for (const auto &column : statement->column_list_) {
+    needed.push_back(dynamic_pointer_cast<ColumnValueExpression>(column.second)->GetColIdx());
+  }
+  double limit = RowGoal(statement);
+  std::shared_ptr<AbstractPlanNode> best;
+  double best_cost = 0;
+  for (auto index : indexes) {
+    bool clustered = index->GetIndexType() == "clustered";
+    if (index->GetIndexType() != "bptree" && !clustered) {
+      continue;
+    }
+    std::unordered_set<uint32_t> key_columns;
+    for (auto column : index->GetIndexKeySchema()->GetColumns()) {
+      key_columns.insert(column->GetTableInd());
+    }
+    bool index_only = !clustered && std::all_of(needed.begin(), needed.end(), [&key_columns](uint32_t col_id) {
+      return key_columns.count(col_id) != 0;
+    });
+    KeyRange range(where, index->GetIndexKeySchema());
+    std::shared_ptr<AbstractPlanNode> candidate;
+    if (index_only) {
+      candidate = make_shared<IndexOnlyScanPlanNode>(chosen->OutputSchema(), statement->table_name_, index, where);
+    } else {
+      candidate = make_shared<IndexScanPlanNode>(chosen->OutputSchema(), statement->table_name_, index,
+                                                 KeyRange(where, index->GetIndexKeySchema()), where);
+    }
+    if (!ProvidesOrder(statement, candidate)) {
+      continue;
+    }
+    if (statistics == nullptr) {
+      if (best == nullptr || index_only) {
+        best = candidate;
+      }
+      continue;
+    }
+    // 与PlanScanByCost中索引扫描的代价相同，有limit时回表和过滤只算到第limit行
+    CostModel cost_model(statistics);
+    double rows = cost_model.GetRowCount();
+    std::unordered_set<uint32_t> range_columns;
+    for (uint32_t i = 0; i < range.GetMatchedColumns(); i++) {
+      range_columns.insert(index->GetIndexKeySchema()->GetColumn(i)->GetTableInd());
+    }
+    double entries = range.IsEmpty() ? 0 : rows * EstimateSelectivity(where, statistics, range_columns, true);
+    size_t conditions = CountComparisons(where);
+    double per_row_cost = cost_model.Filter(entries, conditions);
+    if (!index_only) {
+      uint32_t leading = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
+      double correlation =
+          leading < statistics->GetColumnCount() ? statistics->GetColumn(leading).GetCorrelation() : 0;
+      per_row_cost = (clustered ? 0 : cost_model.FetchRows(entries, correlation)) + (range.IsExact() ? 0 : per_row_cost);
+    }
+    double scan_cost = cost_model.IndexScan(index, entries);
+    candidate->SetEstimate(chosen->GetEstimatedRows(), scan_cost + per_row_cost);
+    double fraction = limit >= 0 && chosen->GetEstimatedRows() > 0
+                          ? std::min(1.0, limit / chosen->GetEstimatedRows())
+                          : 1;
+    double cost = scan_cost + per_row_cost * fraction;
+    if (best == nullptr || cost < best_cost) {
+      best = candidate;
+      best_cost = cost;
+    }
+  }
+  if (best == nullptr) {
+    return chosen;
+  }
+  if (statistics == nullptr) {
+    return best->GetType() == PlanType::IndexOnlyScan || limit >= 0 ? best : chosen;
+  }
+  double sort_cost = CostModel::Sort(chosen->GetEstimatedRows(), RowWidth(chosen->OutputSchema()),
+                                     context_->GetWorkMemory(), limit);
+  return best_cost < chosen->GetEstimatedCost() + sort_cost ? best : chosen;
+}
+
+double Planner::RowWidth(const Schema *schema) {
+  double width = 0;
+  for (auto column : schema->GetColumns()) {
+    width += 1 + (column->GetType() == kTypeChar ? column->GetLength() : sizeof(int32_t));
+  }
+  return width;
+}
+
+/*
+ * 输入只有group by和聚集函数读的列。分组数估计为各group by列不同值个数之积，不超过输入行数
+ */
+AbstractPlanNodeRef Planner::PlanAggregation(const std::shared_ptr<SelectStatement> &statement,
+                                             const AbstractPlanNodeRef &child) {
+  const Schema *input = child->OutputSchema();
+  std::vector<AggregationType> agg_types;
+  std::vector<uint32_t> agg_columns;
+  for (const auto &aggregate : statement->aggregates_) {
+    agg_types.push_back(aggregate.first);
+    agg_columns.push_back(aggregate.second);
+  }
+  std::vector<Column *> columns;
+  std::vector<std::pair<uint32_t, uint32_t>> output_columns;
+  for (const auto &output : statement->aggregate_outputs_) {
+    uint32_t index = columns.size();
+    const auto &source = output.second;
+    const Column *column = nullptr;
+    TypeId type = kTypeInt;
+    if (source.first == 0) {
+      column = input->GetColumn(statement->group_by_[source.second]);
+      type = column->GetType();
+    } else if (agg_types[source.second] != AggregationType::CountStarAggregate &&
+               agg_types[source.second] != AggregationType::CountAggregate) {
+      column = input->GetColumn(agg_columns[source.second]);
+      type = agg_types[source.second] == AggregationType::AvgAggregate ? kTypeFloat : column->GetType();
+    }
+    columns.push_back(type == kTypeChar ? new Column(output.first, type, column->GetLength(), index, true, false)
+                                        : new Column(output.first, type, index, true, false));
+    output_columns.push_back(source);
+  }
+  auto plan = make_shared<AggregationPlanNode>(new Schema(columns), child, statement->group_by_, std::move(agg_types),
+                                               std::move(agg_columns), std::move(output_columns));
+  double input_rows = child->GetEstimatedRows();
+  if (input_rows >= 0) {
+    double groups = 1;
+    for (auto input_column : statement->group_by_) {
+      uint32_t col_idx =
+          std::dynamic_pointer_cast<ColumnValueExpression>(statement->column_list_[input_column].second)->GetColIdx();
+      double distinct = 0;
+      if (!statement->join_tables_.empty()) {
+        distinct = DistinctCount(statement, col_idx);
+      } else {
+        TableInfo *info = nullptr;
+        context_->GetCatalog()->GetTable(statement->table_name_, info);
+        distinct = info->GetStatistics()->GetColumn(col_idx).GetDistinctCount();
+      }
+      groups *= std::max(distinct, 1.0);
+    }
+    groups = statement->group_by_.empty() ? 1 : std::min(groups, std::max(input_rows, 1.0));
+    double per_row = (statement->group_by_.size() + statement->aggregates_.size()) * CostModel::CPU_OPERATOR_COST;
+    plan->SetEstimate(groups, child->GetEstimatedCost() + input_rows * (CostModel::CPU_TUPLE_COST + per_row) +
+                                  groups * CostModel::CPU_TUPLE_COST);
+  }
+  return plan;
+}
+
+AbstractPlanNodeRef Planner::PlanJoin(const std::shared_ptr<SelectStatement> &statement) {
+  const auto &offsets = statement->join_offsets_;
+  // 每个跨表条件在它用到的最后一张表加入时检查
+  std::vector<std::vector<AbstractExpressionRef>> step_conditions(statement->join_tables_.size());
+  for (const auto &condition : statement->join_conditions_) {
+    size_t table = std::upper_bound(offsets.begin(), offsets.end(), LastColumn(condition)) - offsets.begin() - 1;
+    step_conditions[table].push_back(condition);
+  }
+  auto copy_column = [](const Column *column, uint32_t index) {
+    return column->GetType() == TypeId::kTypeChar
+               ? new Column(column->GetName(), column->GetType(), column->GetLength(), index, column->IsNullable(),
+                            false)
+               : new Column(column->GetName(), column->GetType(), index, column->IsNullable(), false);
+  };
+  AbstractPlanNodeRef plan = PlanJoinInput(statement, 0);
+  for (size_t table = 1; table < statement->join_tables_.size(); table++) {
+    auto right = PlanJoinInput(statement, table);
+    std::vector<uint32_t> left_keys;
+    std::vector<uint32_t> right_keys;
+    AbstractExpressionRef predicate = nullptr;
+    for (const auto &condition : step_conditions[table]) {
+      auto split = SplitJoinColumns(condition, offsets[table]);
+      // 左右各一列的等值条件做hash key，其余的在join时过滤
+      if (split->GetType() == ExpressionType::ComparisonExpression &&
+          std::dynamic_pointer_cast<ComparisonExpression>(split)->GetComparisonType() == "=") {
+        auto lhs = std::dynamic_pointer_cast<ColumnValueExpression>(split->GetChildAt(0));
+        auto rhs = std::dynamic_pointer_cast<ColumnValueExpression>(split->GetChildAt(1));
+        if (lhs != nullptr && rhs != nullptr && lhs->GetRowIdx() != rhs->GetRowIdx()) {
+          left_keys.push_back(lhs->GetRowIdx() == 0 ? lhs->GetColIdx() : rhs->GetColIdx());
+          right_keys.push_back(lhs->GetRowIdx() == 0 ? rhs->GetColIdx() : lhs->GetColIdx());
+          continue;
+        }
+      }
+      predicate = predicate == nullptr ? split : std::make_shared<LogicExpression>(predicate, split, LogicType::And);
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> output_columns;
+    Schema *output = nullptr;
+    if (table + 1 == statement->join_tables_.size()) {
+      // 最后一次join输出select的列
+      for (const auto &column : statement->column_list_) {
+        uint32_t col_idx = std::dynamic_pointer_cast<ColumnValueExpression>(column.second)->GetColIdx();
+        output_columns.emplace_back(col_idx < offsets[table] ? 0 : 1,
+                                    col_idx < offsets[table] ? col_idx : col_idx - offsets[table]);
+      }
+      output = MakeOutputSchema(statement->column_list_);
+    } else {
+      std::vector<Column *> columns;
+      for (uint32_t side = 0; side < 2; side++) {
+        auto schema = side == 0 ? plan->OutputSchema() : right->OutputSchema();
+        for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+          output_columns.emplace_back(side, i);
+          columns.push_back(copy_column(schema->GetColumn(i), columns.size()));
+        }
+      }
+      output = new Schema(columns);
+    }
+    plan = PlanJoinStep(statement, table, plan, right, std::move(left_keys), std::move(right_keys), predicate, output,
+                        std::move(output_columns));
+  }
+  return plan;
+}
+
+/*
+ * 两边都有估计时，估计join的行数和代价：每对key的选择率取1 / 两列不同值个数的较大者。
+ * 内表的b+树索引的key列都在等值条件中时，估计按批有序查索引、排序回表的代价，比建hash表便宜就用索引
+ */
+AbstractPlanNodeRef Planner::PlanJoinStep(const std::shared_ptr<SelectStatement> &statement, size_t table,
+                                          const AbstractPlanNodeRef &left, const AbstractPlanNodeRef &right,
+                                          std::vector<uint32_t> left_keys, std::vector<uint32_t> right_keys,
+                                          const AbstractExpressionRef &predicate, const Schema *output,
+                                          std::vector<std::pair<uint32_t, uint32_t>> output_columns) {
+  const std::string &table_name = statement->join_tables_[table];
+  TableInfo *info = nullptr;
+  context_->GetCatalog()->GetTable(table_name, info);
+  const TableStatistics *statistics = info->GetStatistics();
+  double outer_rows = left->GetEstimatedRows();
+  double inner_rows = right->GetEstimatedRows();
+  if (outer_rows < 0 || inner_rows < 0 || statistics == nullptr) {
+    return std::make_shared<HashJoinPlanNode>(output, left, right, std::move(left_keys), std::move(right_keys),
+                                              predicate, std::move(output_columns));
+  }
+  double selectivity = 1;
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    double distinct = std::max(DistinctCount(statement, left_keys[i]),
+                               statistics->GetColumn(right_keys[i]).GetDistinctCount());
+    selectivity /= std::max(1.0, distinct);
+  }
+  double rows = outer_rows * inner_rows * selectivity;
+  double best_cost = left->GetEstimatedCost() + right->GetEstimatedCost() +
+                     (outer_rows + inner_rows) * CostModel::CPU_TUPLE_COST;
+  IndexInfo *best_index = nullptr;
+  std::vector<uint32_t> best_lookup;
+  std::vector<IndexInfo *> indexes;
+  context_->GetCatalog()->GetTableIndexes(table_name, indexes);
+  CostModel cost_model(statistics);
+  const auto &inner_filter = statement->table_where_[table];
   for (auto index : indexes) {
-    if (index->GetIndexKeySchema()->GetColumns().size() == 1) {
-      auto col_id = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
-      if (std::find(statement->column_in_condition_.begin(), statement->column_in_condition_.end(), col_id) !=
-          statement->column_in_condition_.end()) {
-        available_index.push_back(index);
+    if (index->GetIndexType() != "bptree" || info->IsClustered()) {
+      continue;
+    }
+    // 每个key列都要有外表的列对应
+    std::vector<uint32_t> lookup;
+    double key_distinct = 1;
+    for (auto column : index->GetIndexKeySchema()->GetColumns()) {
+      auto pos = std::find(right_keys.begin(), right_keys.end(), column->GetTableInd());
+      if (pos == right_keys.end()) {
+        break;
       }
+      lookup.push_back(left_keys[pos - right_keys.begin()]);
+      key_distinct *= std::max(1.0, statistics->GetColumn(column->GetTableInd()).GetDistinctCount());
+    }
+    if (lookup.size() != index->GetIndexKeySchema()->GetColumnCount()) {
+      continue;
+    }
+    double table_rows = cost_model.GetRowCount();
+    double per_key = index->IsUnique() ? std::min(1.0, table_rows)
+                                       : table_rows / std::min(key_distinct, std::max(1.0, table_rows));
+    double fetched = outer_rows * per_key;
+    double cost = left->GetEstimatedCost() + cost_model.IndexLookups(index, outer_rows, per_key) +
+                  cost_model.FetchSortedRows(fetched) + cost_model.Filter(fetched, CountComparisons(inner_filter));
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_index = index;
+      best_lookup = std::move(lookup);
+    }
+  }
+  std::shared_ptr<AbstractPlanNode> join;
+  if (best_index != nullptr) {
+    join = std::make_shared<IndexNestedLoopJoinPlanNode>(output, left, table_name, right->OutputSchema(), best_index,
+                                                         std::move(left_keys), std::move(right_keys),
+                                                         std::move(best_lookup), inner_filter, predicate,
+                                                         std::move(output_columns));
+  } else {
+    join = std::make_shared<HashJoinPlanNode>(output, left, right, std::move(left_keys), std::move(right_keys),
+                                              predicate, std::move(output_columns));
+  }
+  join->SetEstimate(rows, best_cost);
+  return join;
+}
+
+double Planner::DistinctCount(const std::shared_ptr<SelectStatement> &statement, uint32_t column) {
+  const auto &offsets = statement->join_offsets_;
+  size_t table = std::upper_bound(offsets.begin(), offsets.end(), column) - offsets.begin() - 1;
+  TableInfo *info = nullptr;
+  context_->GetCatalog()->GetTable(statement->join_tables_[table], info);
+  if (info->GetStatistics() == nullptr) {
+    return 0;
+  }
+  return info->GetStatistics()->GetColumn(column - offsets[table]).GetDistinctCount();
+}
+
+AbstractPlanNodeRef Planner::PlanJoinInput(const std::shared_ptr<SelectStatement> &statement, size_t table) {
+  const std::string &table_name = statement->join_tables_[table];
+  TableInfo *info = nullptr;
+  context_->GetCatalog()->GetTable(table_name, info);
+  std::vector<Column *> columns;
+  for (auto column : info->GetSchema()->GetColumns()) {
+    std::string name = table_name + "." + column->GetName();
+    columns.push_back(column->GetType() == TypeId::kTypeChar
+                          ? new Column(name, column->GetType(), column->GetLength(), column->GetTableInd(),
+                                       column->IsNullable(), false)
+                          : new Column(name, column->GetType(), column->GetTableInd(), column->IsNullable(), false));
+  }
+  auto scan = make_shared<SelectStatement>(statement->ast_, context_);
+  scan->table_name_ = table_name;
+  scan->where_ = statement->table_where_[table];
+  scan->column_in_condition_ = statement->table_column_in_condition_[table];
+  scan->MakeColumnList(nullptr);
+  return PlanScan(scan, new Schema(columns), false);
+}
+
+AbstractExpressionRef Planner::SplitJoinColumns(const AbstractExpressionRef &condition, uint32_t offset) {
+  switch (condition->GetType()) {
+    case ExpressionType::ColumnExpression: {
+      auto column = std::dynamic_pointer_cast<ColumnValueExpression>(condition);
+      uint32_t col_idx = column->GetColIdx();
+      return std::make_shared<ColumnValueExpression>(col_idx < offset ? 0 : 1,
+                                                     col_idx < offset ? col_idx : col_idx - offset,
+                                                     condition->GetReturnType());
     }
+    case ExpressionType::ComparisonExpression:
+      return std::make_shared<ComparisonExpression>(
+          SplitJoinColumns(condition->GetChildAt(0), offset), SplitJoinColumns(condition->GetChildAt(1), offset),
+          std::dynamic_pointer_cast<ComparisonExpression>(condition)->GetComparisonType());
+    case ExpressionType::LogicExpression:
+      return std::make_shared<LogicExpression>(SplitJoinColumns(condition->GetChildAt(0), offset),
+                                               SplitJoinColumns(condition->GetChildAt(1), offset),
+                                               std::dynamic_pointer_cast<LogicExpression>(condition)->logic_type_);
+    default:
+      return condition;
   }
-  if (available_index.empty() || statement->has_or) {
+}
+
+uint32_t Planner::LastColumn(const AbstractExpressionRef &expr) {
+  if (expr->GetType() == ExpressionType::ColumnExpression) {
+    return std::dynamic_pointer_cast<ColumnValueExpression>(expr)->GetColIdx();
+  }
+  uint32_t last = 0;
+  for (const auto &child : expr->GetChildren()) {
+    last = std::max(last, LastColumn(child));
+  }
+  return last;
+}
+
+AbstractPlanNodeRef Planner::PlanScan(const std::shared_ptr<SelectStatement> &statement, const Schema *out_schema,
+                                      bool allow_index_only) {
+  vector<IndexInfo *> indexes;
+  context_->GetCatalog()->GetTableIndexes(statement->table_name_, indexes);
+  std::unordered_map<uint32_t, bool> equality_only;
+  if (statement->where_ != nullptr) {
+    CollectEqualityColumns(statement->where_, equality_only);
+  }
+  // ANALYZE过的表按代价选择访问路径
+  TableInfo *table_info = nullptr;
+  context_->GetCatalog()->GetTable(statement->table_name_, table_info);
+  if (table_info->GetStatistics() != nullptr) {
+    return PlanScanByCost(statement, out_schema, allow_index_only, indexes, equality_only,
+                          table_info->GetStatistics());
+  }
+  // 输出列和条件列都在某个b+树索引的key中时，直接扫描索引
+  IndexInfo *covering = allow_index_only ? ChooseCoveringIndex(statement, indexes) : nullptr;
+  if (covering != nullptr) {
+    return make_shared<IndexOnlyScanPlanNode>(out_schema, statement->table_name_, covering, statement->where_);
+  }
+  // AND连接的条件合并成一个b+树(或clustered)索引上的范围（等值前缀 + 下一列的范围），只需扫描一次叶子
+  KeyRange range;
+  IndexInfo *range_index = ChooseRangeIndex(statement, indexes, range);
+  if (range_index != nullptr) {
+    // 只有一个等值条件且该列有hash或art索引时，不经过buffer pool的点查更快
+    uint32_t leading = range_index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
+    bool prefer_point = range.GetEqualityCount() == 1 && !range.HasRange() && equality_only[leading] &&
+                        std::any_of(indexes.begin(), indexes.end(), [leading](IndexInfo *index) {
+                          return (index->GetIndexType() == "hash" || index->GetIndexType() == "art") &&
+                                 index->GetIndexKeySchema()->GetColumns().size() == 1 &&
+                                 index->GetIndexKeySchema()->GetColumn(0)->GetTableInd() == leading;
+                        });
+    if (!prefer_point) {
+      return make_shared<IndexScanPlanNode>(out_schema, statement->table_name_, range_index, std::move(range),
+                                            statement->where_);
+    }
+  }
+  // 各列索引的row id按AND求交、按OR求并，OR的每一支都有索引时才能用
+  auto column_indexes = ChooseColumnIndexes(statement, indexes, equality_only);
+  bool exact = true;
+  if (statement->where_ == nullptr || !CoversRowIds(statement->where_, column_indexes, exact)) {
     return make_shared<SeqScanPlanNode>(out_schema, statement->table_name_, statement->where_);
   }
-  return make_shared<IndexScanPlanNode>(out_schema, statement->table_name_, available_index,
-                                        available_index.size() != statement->column_in_condition_.size(),
+  vector<IndexInfo *> available_index;
+  for (const auto &entry : column_indexes) {
+    available_index.push_back(entry.second);
+  }
+  return make_shared<IndexScanPlanNode>(out_schema, statement->table_name_, available_index, !exact,
                                         statement->where_);
 }
 
+/**
+ * 候选路径：顺序扫描、覆盖索引扫描、每个b+树索引上的范围扫描、单列索引的row id集合
+ * （AND求交，OR求并），后两种在heap表上还可以排序row id后按页读(bitmap heap scan)，取估计代价最小的
+ */
+AbstractPlanNodeRef Planner::PlanScanByCost(const std::shared_ptr<SelectStatement> &statement,
+                                            const Schema *out_schema, bool allow_index_only,
+                                            const vector<IndexInfo *> &indexes,
+                                            std::unordered_map<uint32_t, bool> &equality_only,
+                                            const TableStatistics *statistics) {
+  CostModel cost_model(statistics);
+  TableInfo *table_info = nullptr;
+  context_->GetCatalog()->GetTable(statement->table_name_, table_info);
+  bool heap = !table_info->IsClustered();
+  const auto &where = statement->where_;
+  const std::string &table_name = statement->table_name_;
+  double rows = cost_model.GetRowCount();
+  size_t conditions = CountComparisons(where);
+  std::unordered_set<uint32_t> all_columns;
+  for (uint32_t i = 0; i < statistics->GetColumnCount(); i++) {
+    all_columns.insert(i);
+  }
+  double out_rows = rows * EstimateSelectivity(where, statistics, all_columns);
+  std::shared_ptr<AbstractPlanNode> best = make_shared<SeqScanPlanNode>(out_schema, table_name, where);
+  double best_cost = cost_model.SeqScan(conditions);
+  auto consider = [&best, &best_cost](const std::shared_ptr<AbstractPlanNode> &plan, double cost) {
+    if (cost < best_cost) {
+      best = plan;
+      best_cost = cost;
+    }
+  };
+  // 覆盖索引：只读索引中的范围
+  std::vector<uint32_t> needed(statement->column_in_condition_);
+  for (const auto &column : statement->column_list_) {
+    needed.push_back(dynamic_pointer_cast<ColumnValueExpression>(column.second)->GetColIdx());
+  }
+  for (auto index : indexes) {
+    bool clustered = index->GetIndexType() == "clustered";
+    if (index->GetIndexType() != "bptree" && !clustered) {
+      continue;
+    }
+    KeyRange range(where, index->GetIndexKeySchema());
+    std::unordered_set<uint32_t> range_columns;
+    for (uint32_t i = 0; i < range.GetMatchedColumns(); i++) {
+      range_columns.insert(index->GetIndexKeySchema()->GetColumn(i)->GetTableInd());
+    }
+    double entries = range.IsEmpty() ? 0 : rows * EstimateSelectivity(where, statistics, range_columns, true);
+    double scan_cost = cost_model.IndexScan(index, entries);
+    std::unordered_set<uint32_t> key_columns;
+    for (auto column : index->GetIndexKeySchema()->GetColumns()) {
+      key_columns.insert(column->GetTableInd());
+    }
+    bool covered = std::all_of(needed.begin(), needed.end(),
+                               [&key_columns](uint32_t col_id) { return key_columns.count(col_id) != 0; });
+    if (allow_index_only && covered && !clustered) {
+      consider(make_shared<IndexOnlyScanPlanNode>(out_schema, table_name, index, where),
+               scan_cost + cost_model.Filter(entries, conditions));
+    }
+    if (where == nullptr || (range.GetMatchedColumns() == 0 && !range.IsEmpty())) {
+      continue;
+    }
+    // 按索引顺序回表，相关性取索引第一列的
+    uint32_t leading = index->GetIndexKeySchema()->GetColumn(0)->GetTableInd();
+    double correlation =
+        leading < statistics->GetColumnCount() ? statistics->GetColumn(leading).GetCorrelation() : 0;
+    double fetch_cost = clustered ? 0 : cost_model.FetchRows(entries, correlation);
+    double filter_cost = range.IsExact() ? 0 : cost_model.Filter(entries, conditions);
+    // 回表的页不按顺序时，排序后每页只读一次
+    if (heap && entries >= BitmapHeapScanPlanNode::MIN_BITMAP_ROWS) {
+      consider(make_shared<BitmapHeapScanPlanNode>(out_schema, table_name, index,
+                                                   KeyRange(where, index->GetIndexKeySchema()), where),
+               scan_cost + cost_model.MergeRowIds(entries) + cost_model.FetchSortedRows(entries) + filter_cost);
+    }
+    consider(make_shared<IndexScanPlanNode>(out_schema, table_name, index, std::move(range), where),
+             scan_cost + fetch_cost + filter_cost);
+  }
+  // 单列索引上的row id集合：全部索引一起用，或者只用其中一个
+  auto column_indexes = ChooseColumnIndexes(statement, indexes, equality_only);
+  std::vector<std::map<uint32_t, IndexInfo *>> index_sets;
+  if (column_indexes.size() > 1) {
+    index_sets.push_back(column_indexes);
+  }
+  for (const auto &entry : column_indexes) {
+    index_sets.push_back({entry});
+  }
+  for (const auto &index_set : index_sets) {
+    bool exact = true;
+    if (!CoversRowIds(where, index_set, exact)) {
+      continue;
+    }
+    double lookup_entries = 0;
+    double lookup_cost = RowIdLookupCost(where, index_set, statistics, cost_model, lookup_entries);
+    std::unordered_set<uint32_t> columns;
+    vector<IndexInfo *> set_indexes;
+    for (const auto &entry : index_set) {
+      columns.insert(entry.first);
+      set_indexes.push_back(entry.second);
+    }
+    double fetched = rows * EstimateSelectivity(where, statistics, columns);
+    double merge_cost = CountComparisons(where) > 1 ? cost_model.MergeRowIds(lookup_entries) : 0;
+    double filter_cost = exact ? 0 : cost_model.Filter(fetched, conditions);
+    if (heap && fetched >= BitmapHeapScanPlanNode::MIN_BITMAP_ROWS) {
+      consider(make_shared<BitmapHeapScanPlanNode>(out_schema, table_name, set_indexes, !exact, where),
+               lookup_cost + merge_cost + cost_model.FetchSortedRows(fetched) + filter_cost);
+    }
+    consider(make_shared<IndexScanPlanNode>(out_schema, table_name, set_indexes, !exact, where),
+             lookup_cost + merge_cost + cost_model.FetchRows(fetched) + filter_cost);
+  }
+  best->SetEstimate(out_rows, best_cost);
+  return best;
+}
+
 AbstractPlanNodeRef Planner::PlanInsert(std::shared_ptr<InsertStatement> statement) {
   auto value_plan = std::make_shared<ValuesPlanNode>(nullptr, statement->raw_values_);
   return std::make_shared<InsertPlanNode>(nullptr, value_plan, statement->table_name_);
@@ -63,18 +697,272 @@ AbstractPlanNodeRef Planner::PlanInsert(std::shared_ptr<InsertStatement> stateme
 AbstractPlanNodeRef Planner::PlanDelete(std::shared_ptr<DeleteStatement> statement) {
   TableInfo *info = nullptr;
   context_->GetCatalog()->GetTable(statement->table_name_, info);
-  auto scan_plan = make_shared<SeqScanPlanNode>(info->GetSchema(), statement->table_name_, statement->where_);
+  auto scan_plan = PlanRowScan(statement->ast_, statement->table_name_, statement->where_,
+                               statement->column_in_condition_);
   return std::make_shared<DeletePlanNode>(info->GetSchema(), scan_plan, statement->table_name_);
 }
 
 AbstractPlanNodeRef Planner::PlanUpdate(std::shared_ptr<UpdateStatement> statement) {
   TableInfo *info = nullptr;
   context_->GetCatalog()->GetTable(statement->table_name_, info);
-  auto scan_plan = make_shared<SeqScanPlanNode>(info->GetSchema(), statement->table_name_, statement->where_);
+  auto scan_plan = PlanRowScan(statement->ast_, statement->table_name_, statement->where_,
+                               statement->column_in_condition_);
   return std::make_shared<UpdatePlanNode>(info->GetSchema(), scan_plan, statement->table_name_,
                                           statement->update_attrs);
 }
 
+/**
+ * 按select * from table where ...选择访问路径。索引扫描在Init中就取出全部row id，之后的修改
+ * 即使改了索引列、移动了记录，也不会让扫描再次遇到改过的行（Halloween problem）
+ */
+AbstractPlanNodeRef Planner::PlanRowScan(pSyntaxNode ast, const std::string &table_name,
+                                         const AbstractExpressionRef &where,
+                                         const std::vector<uint32_t> &column_in_condition) {
+  TableInfo *info = nullptr;
+  context_->GetCatalog()->GetTable(table_name, info);
+  auto scan = make_shared<SelectStatement>(ast, context_);
+  scan->table_name_ = table_name;
+  scan->where_ = where;
+  scan->column_in_condition_ = column_in_condition;
+  scan->MakeColumnList(nullptr);
+  auto plan = PlanScan(scan, info->GetSchema(), false);
+  if (plan->GetType() == PlanType::IndexScan) {
+    // 计划刚建好，还没有别处引用
+    auto index_scan =
+        std::const_pointer_cast<IndexScanPlanNode>(std::static_pointer_cast<const IndexScanPlanNode>(plan));
+    index_scan->collect_all_ = true;
+  }
+  return plan;
+}
+
+void Planner::CollectEqualityColumns(const AbstractExpressionRef &predicate,
+                                     std::unordered_map<uint32_t, bool> &equality_only) {
+  if (predicate->GetType() == ExpressionType::ComparisonExpression) {
+    uint32_t col_idx = dynamic_pointer_cast<ColumnValueExpression>(predicate->GetChildAt(0))->GetColIdx();
+    bool is_equal = dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType() == "=";
+    auto iter = equality_only.find(col_idx);
+    equality_only[col_idx] = (iter == equality_only.end() || iter->second) && is_equal;
+    return;
+  }
+  for (const auto &child : predicate->GetChildren()) {
+    CollectEqualityColumns(child, equality_only);
+  }
+}
+
+IndexInfo *Planner::ChooseCoveringIndex(const std::shared_ptr<SelectStatement> &statement,
+                                        const vector<IndexInfo *> &indexes) {
+  std::vector<uint32_t> needed(statement->column_in_condition_);
+  for (const auto &column : statement->column_list_) {
+    needed.push_back(dynamic_pointer_cast<ColumnValueExpression>(column.second)->GetColIdx());
+  }
+  IndexInfo *chosen = nullptr;
+  KeyRange chosen_range;
+  for (auto index : indexes) {
+    if (index->GetIndexType() != "bptree") {
+      continue;
+    }
+    std::unordered_set<uint32_t> key_columns;
+    for (auto column : index->GetIndexKeySchema()->GetColumns()) {
+      key_columns.insert(column->GetTableInd());
+    }
+    bool covered = std::all_of(needed.begin(), needed.end(),
+                               [&key_columns](uint32_t col_id) { return key_columns.count(col_id) != 0; });
+    if (!covered) {
+      continue;
+    }
+    // 优先选条件能缩小扫描范围的索引
+    KeyRange range(statement->where_, index->GetIndexKeySchema());
+    if (chosen == nullptr || range.IsTighterThan(chosen_range)) {
+      chosen = index;
+      chosen_range = std::move(range);
+    }
+  }
+  return chosen;
+}
+
+IndexInfo *Planner::ChooseRangeIndex(const std::shared_ptr<SelectStatement> &statement,
+                                     const vector<IndexInfo *> &indexes, KeyRange &range) {
+  if (statement->where_ == nullptr) {
+    return nullptr;
+  }
+  IndexInfo *chosen = nullptr;
+  for (auto index : indexes) {
+    bool clustered = index->GetIndexType() == "clustered";
+    if (index->GetIndexType() != "bptree" && !clustered) {
+      continue;
+    }
+    KeyRange candidate(statement->where_, index->GetIndexKeySchema());
+    if (candidate.GetMatchedColumns() == 0 && !candidate.IsEmpty()) {
+      continue;
+    }
+    // 范围相同时选clustered index，叶子上就是整行，不用回表
+    if (chosen == nullptr || candidate.IsTighterThan(range) || (clustered && !range.IsTighterThan(candidate))) {
+      chosen = index;
+      range = std::move(candidate);
+    }
+  }
+  return chosen;
+}
+
+std::map<uint32_t, IndexInfo *> Planner::ChooseColumnIndexes(
+    const std::shared_ptr<SelectStatement> &statement, const vector<IndexInfo *> &indexes,
+    std::unordered_map<uint32_t, bool> &equality_only) {
+  std::map<uint32_t, IndexInfo *> chosen_indexes;
+  // 每个条件列选一个索引：只有等值条件时优先用hash索引，其次是内存中的art索引，最后是b+树
+  for (auto col_id : statement->column_in_condition_) {
+    IndexInfo *chosen = nullptr;
+    for (auto index : indexes) {
+      if (index->GetIndexKeySchema()->GetColumns().size() != 1 ||
+          index->GetIndexKeySchema()->GetColumn(0)->GetTableInd() != col_id) {
+        continue;
+      }
+      if (index->GetIndexType() == "hash") {
+        if (equality_only[col_id]) {
+          chosen = index;
+          break;
+        }
+      } else if (index->GetIndexType() == "art") {
+        chosen = index;
+      } else if (chosen == nullptr) {
+        chosen = index;
+      }
+    }
+    if (chosen != nullptr) {
+      chosen_indexes[col_id] = chosen;
+    }
+  }
+  return chosen_indexes;
+}
+
+bool Planner::CoversRowIds(const AbstractExpressionRef &predicate,
+                           const std::map<uint32_t, IndexInfo *> &column_indexes, bool &exact) {
+  if (predicate->GetType() == ExpressionType::LogicExpression) {
+    bool lhs = CoversRowIds(predicate->GetChildAt(0), column_indexes, exact);
+    bool rhs = CoversRowIds(predicate->GetChildAt(1), column_indexes, exact);
+    if (std::dynamic_pointer_cast<LogicExpression>(predicate)->logic_type_ == LogicType::And) {
+      return lhs || rhs;
+    }
+    return lhs && rhs;
+  }
+  if (predicate->GetType() == ExpressionType::ComparisonExpression) {
+    auto column = std::dynamic_pointer_cast<ColumnValueExpression>(predicate->GetChildAt(0));
+    std::string op = std::dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType();
+    auto iter = column == nullptr ? column_indexes.end() : column_indexes.find(column->GetColIdx());
+    bool answered = iter != column_indexes.end() && !predicate->GetChildAt(1)->Evaluate(nullptr).IsNull() &&
+                    (op == "=" || (iter->second->GetIndexType() != "hash" &&
+                                   (op == "<" || op == "<=" || op == ">" || op == ">=" || op == "<>")));
+    exact = exact && answered;
+    return answered;
+  }
+  exact = false;
+  return false;
+}
+
+double Planner::RowIdLookupCost(const AbstractExpressionRef &predicate,
+                                const std::map<uint32_t, IndexInfo *> &column_indexes,
+                                const TableStatistics *statistics, const CostModel &cost_model, double &entries) {
+  if (predicate->GetType() != ExpressionType::ComparisonExpression) {
+    double cost = 0;
+    for (const auto &child : predicate->GetChildren()) {
+      cost += RowIdLookupCost(child, column_indexes, statistics, cost_model, entries);
+    }
+    return cost;
+  }
+  auto column = std::dynamic_pointer_cast<ColumnValueExpression>(predicate->GetChildAt(0));
+  auto iter = column == nullptr ? column_indexes.end() : column_indexes.find(column->GetColIdx());
+  if (iter == column_indexes.end() || column->GetColIdx() >= statistics->GetColumnCount()) {
+    return 0;
+  }
+  std::string op = std::dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType();
+  if (iter->second->GetIndexType() == "hash" && op != "=") {
+    return 0;
+  }
+  Field value = predicate->GetChildAt(1)->Evaluate(nullptr);
+  double found = value.IsNull() ? 0
+                                : cost_model.GetRowCount() *
+                                      statistics->GetColumn(column->GetColIdx()).EstimateComparison(op, value);
+  entries += found;
+  return cost_model.IndexScan(iter->second, found);
+}
+
+size_t Planner::CountComparisons(const AbstractExpressionRef &predicate) {
+  if (predicate == nullptr) {
+    return 0;
+  }
+  if (predicate->GetType() == ExpressionType::ComparisonExpression) {
+    return 1;
+  }
+  size_t count = 0;
+  for (const auto &child : predicate->GetChildren()) {
+    count += CountComparisons(child);
+  }
+  return count;
+}
+
+/**
+ * AND连接的条件中，同一列上的范围条件合起来估计，其余条件视为独立
+ */
+double Planner::EstimateSelectivity(const AbstractExpressionRef &predicate, const TableStatistics *statistics,
+                                    const std::unordered_set<uint32_t> &columns, bool conjuncts_only) {
+  if (predicate == nullptr) {
+    return 1;
+  }
+  if (predicate->GetType() == ExpressionType::LogicExpression &&
+      std::dynamic_pointer_cast<LogicExpression>(predicate)->logic_type_ == LogicType::Or) {
+    if (conjuncts_only) {
+      return 1;
+    }
+    double lhs = EstimateSelectivity(predicate->GetChildAt(0), statistics, columns);
+    double rhs = EstimateSelectivity(predicate->GetChildAt(1), statistics, columns);
+    return lhs + rhs - lhs * rhs;
+  }
+  std::vector<AbstractExpressionRef> terms;
+  std::function<void(const AbstractExpressionRef &)> flatten = [&terms, &flatten](const AbstractExpressionRef &expr) {
+    if (expr->GetType() == ExpressionType::LogicExpression &&
+        std::dynamic_pointer_cast<LogicExpression>(expr)->logic_type_ == LogicType::And) {
+      flatten(expr->GetChildAt(0));
+      flatten(expr->GetChildAt(1));
+    } else {
+      terms.push_back(expr);
+    }
+  };
+  flatten(predicate);
+  double selectivity = 1;
+  // 列 -> (小于下界的行占比, 小于等于上界的行占比)
+  std::unordered_map<uint32_t, std::pair<double, double>> ranges;
+  for (const auto &term : terms) {
+    if (term->GetType() == ExpressionType::LogicExpression) {
+      selectivity *= EstimateSelectivity(term, statistics, columns, conjuncts_only);
+      continue;
+    }
+    if (term->GetType() != ExpressionType::ComparisonExpression) {
+      continue;
+    }
+    auto column = std::dynamic_pointer_cast<ColumnValueExpression>(term->GetChildAt(0));
+    if (column == nullptr || columns.count(column->GetColIdx()) == 0 ||
+        column->GetColIdx() >= statistics->GetColumnCount()) {
+      continue;
+    }
+    const ColumnStatistics &column_stats = statistics->GetColumn(column->GetColIdx());
+    std::string op = std::dynamic_pointer_cast<ComparisonExpression>(term)->GetComparisonType();
+    Field value = term->GetChildAt(1)->Evaluate(nullptr);
+    if (value.IsNull() || (op != "<" && op != "<=" && op != ">" && op != ">=")) {
+      selectivity *= column_stats.EstimateComparison(op, value);
+      continue;
+    }
+    auto &range = ranges.emplace(column->GetColIdx(), std::make_pair(0.0, 1 - column_stats.GetNullFraction())).first->second;
+    if (op == "<" || op == "<=") {
+      range.second = std::min(range.second, column_stats.EstimateLess(value, op == "<="));
+    } else {
+      range.first = std::max(range.first, column_stats.EstimateLess(value, op == ">"));
+    }
+  }
+  for (const auto &range : ranges) {
+    selectivity *= std::max(0.0, range.second.second - range.second.first);
+  }
+  return selectivity;
+}
+
 Schema *Planner::MakeOutputSchema(const vector<std::pair<std::string, AbstractExpressionRef>> &exprs) {
   std::vector<Column *> cols;
   cols.reserve(exprs.size());
@@ -0,0 +1,480 @@
+#include "record/data_chunk.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "record/filter_kernels.h"
+
+namespace {
+
+/*
+ * 只保留比较成立的位置：无条件写入，成立时才前进，循环中没有分支
+ */
+template <typename T, typename Compare>
+void SelectValues(const T *values, const uint8_t *nulls, T constant, Compare compare,
+                  std::vector<uint32_t> &selection) {
+  size_t kept = 0;
+  for (uint32_t pos : selection) {
+    selection[kept] = pos;
+    kept += static_cast<size_t>(!nulls[pos] & compare(values[pos], constant));
+  }
+  selection.resize(kept);
+}
+
+template <typename T, typename Value>
+bool SelectByComparison(CompareOp op, const Value &values, const uint8_t *nulls, T constant,
+                        std::vector<uint32_t> &selection) {
+  switch (op) {
+    case CompareOp::Equal:
+      SelectValues(values, nulls, constant, [](T a, T b) { return a == b; }, selection);
+      return true;
+    case CompareOp::NotEqual:
+      SelectValues(values, nulls, constant, [](T a, T b) { return a != b; }, selection);
+      return true;
+    case CompareOp::LessThan:
+      SelectValues(values, nulls, constant, [](T a, T b) { return a < b; }, selection);
+      return true;
+    case CompareOp::LessThanEquals:
+      SelectValues(values, nulls, constant, [](T a, T b) { return a <= b; }, selection);
+      return true;
+    case CompareOp::GreaterThan:
+      SelectValues(values, nulls, constant, [](T a, T b) { return a > b; }, selection);
+      return true;
+    case CompareOp::GreaterThanEquals:
+      SelectValues(values, nulls, constant, [](T a, T b) { return a >= b; }, selection);
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+void ColumnVector::Clear() {
+  nulls_.clear();
+  ints_.clear();
+  floats_.clear();
+  offsets_.assign(1, 0);
+  chars_.clear();
+}
+
+void ColumnVector::Reserve(size_t size) {
+  nulls_.reserve(size);
+  switch (type_) {
+    case kTypeInt:
+      ints_.reserve(size);
+      break;
+    case kTypeFloat:
+      floats_.reserve(size);
+      break;
+    case kTypeChar:
+      offsets_.reserve(size + 1);
+      break;
+    default:
+      break;
+  }
+}
+
+void ColumnVector::Append(const Field &field) {
+  bool is_null = field.IsNull();
+  ASSERT(is_null || field.GetTypeId() == type_, "Field type does not match the column.");
+  nulls_.push_back(is_null);
+  switch (type_) {
+    case kTypeInt: {
+      int32_t value = 0;
+      if (!is_null) {
+        field.SerializeTo(reinterpret_cast<char *>(&value));
+      }
+      ints_.push_back(value);
+      break;
+    }
+    case kTypeFloat: {
+      float value = 0;
+      if (!is_null) {
+        field.SerializeTo(reinterpret_cast<char *>(&value));
+      }
+      floats_.push_back(value);
+      break;
+    }
+    case kTypeChar:
+      if (!is_null) {
+        chars_.insert(chars_.end(), field.GetData(), field.GetData() + field.GetLength());
+      }
+      offsets_.push_back(chars_.size());
+      break;
+    default:
+      break;
+  }
+}
+
+uint32_t ColumnVector::AppendSerialized(const char *buf, bool is_null) {
+  nulls_.push_back(is_null);
+  switch (type_) {
+    case kTypeInt:
+      ints_.push_back(is_null ? 0 : MACH_READ_INT32(buf));
+      return is_null ? 0 : sizeof(int32_t);
+    case kTypeFloat:
+      floats_.push_back(is_null ? 0 : MACH_READ_FROM(float, buf));
+      return is_null ? 0 : sizeof(float);
+    case kTypeChar: {
+      if (is_null) {
+        offsets_.push_back(chars_.size());
+        return 0;
+      }
+      uint32_t len = MACH_READ_UINT32(buf);
+      chars_.insert(chars_.end(), buf + sizeof(uint32_t), buf + sizeof(uint32_t) + len);
+      offsets_.push_back(chars_.size());
+      return len + sizeof(uint32_t);
+    }
+    default:
+      ASSERT(false, "Unsupported column type.");
+      return 0;
+  }
+}
+
+void ColumnVector::AppendSelected(const ColumnVector &source, const std::vector<uint32_t> &selection) {
+  ASSERT(type_ == source.type_, "Column types do not match.");
+  for (uint32_t pos : selection) {
+    nulls_.push_back(source.nulls_[pos]);
+  }
+  switch (type_) {
+    case kTypeInt:
+      for (uint32_t pos : selection) {
+        ints_.push_back(source.ints_[pos]);
+      }
+      break;
+    case kTypeFloat:
+      for (uint32_t pos : selection) {
+        floats_.push_back(source.floats_[pos]);
+      }
+      break;
+    case kTypeChar:
+      for (uint32_t pos : selection) {
+        chars_.insert(chars_.end(), source.GetChars(pos), source.GetChars(pos) + source.GetLength(pos));
+        offsets_.push_back(chars_.size());
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void ColumnVector::AppendAt(const ColumnVector &source, size_t i) {
+  ASSERT(type_ == source.type_, "Column types do not match.");
+  nulls_.push_back(source.nulls_[i]);
+  switch (type_) {
+    case kTypeInt:
+      ints_.push_back(source.ints_[i]);
+      break;
+    case kTypeFloat:
+      floats_.push_back(source.floats_[i]);
+      break;
+    case kTypeChar:
+      chars_.insert(chars_.end(), source.GetChars(i), source.GetChars(i) + source.GetLength(i));
+      offsets_.push_back(chars_.size());
+      break;
+    default:
+      break;
+  }
+}
+
+uint32_t ColumnVector::SerializeAt(size_t i, char *buf) const {
+  if (IsNull(i)) {
+    return 0;
+  }
+  switch (type_) {
+    case kTypeInt:
+      MACH_WRITE_INT32(buf, ints_[i]);
+      return sizeof(int32_t);
+    case kTypeFloat:
+      MACH_WRITE_TO(float, buf, floats_[i]);
+      return sizeof(float);
+    case kTypeChar: {
+      uint32_t len = GetLength(i);
+      MACH_WRITE_UINT32(buf, len);
+      memcpy(buf + sizeof(uint32_t), GetChars(i), len);
+      return len + sizeof(uint32_t);
+    }
+    default:
+      ASSERT(false, "Unsupported column type.");
+      return 0;
+  }
+}
+
+uint32_t ColumnVector::GetSerializedSize(size_t i) const {
+  if (IsNull(i)) {
+    return 0;
+  }
+  return type_ == kTypeChar ? GetLength(i) + sizeof(uint32_t) : sizeof(int32_t);
+}
+
+size_t ColumnVector::GetMemoryUsage() const {
+  return nulls_.size() + ints_.size() * sizeof(int32_t) + floats_.size() * sizeof(float) +
+         (type_ == kTypeChar ? offsets_.size() * sizeof(uint32_t) : 0) + chars_.size();
+}
+
+Field ColumnVector::GetField(size_t i) const {
+  if (IsNull(i)) {
+    return Field(type_);
+  }
+  switch (type_) {
+    case kTypeInt:
+      return Field(kTypeInt, ints_[i]);
+    case kTypeFloat:
+      return Field(kTypeFloat, floats_[i]);
+    default:
+      return Field(kTypeChar, const_cast<char *>(GetChars(i)), GetLength(i), true);
+  }
+}
+
+bool ColumnVector::SelectCompare(CompareOp op, const Field &constant, std::vector<uint32_t> &selection) const {
+  if (constant.GetTypeId() != type_ || op == CompareOp::IsNull || op == CompareOp::NotNull) {
+    return false;
+  }
+  if (constant.IsNull()) {
+    // 和null比较的结果是null，不成立
+    selection.clear();
+    return true;
+  }
+  switch (type_) {
+    case kTypeInt: {
+      int32_t value;
+      constant.SerializeTo(reinterpret_cast<char *>(&value));
+      return SelectByComparison(op, ints_.data(), nulls_.data(), value, selection);
+    }
+    case kTypeFloat: {
+      float value;
+      constant.SerializeTo(reinterpret_cast<char *>(&value));
+      return SelectByComparison(op, floats_.data(), nulls_.data(), value, selection);
+    }
+    case kTypeChar: {
+      // 和TypeChar一样按字节比较，前缀相同时短的小
+      std::string value(constant.GetData(), constant.GetLength());
+      std::vector<int> order(GetSize());
+      for (uint32_t pos : selection) {
+        if (!nulls_[pos]) {
+          int ret = memcmp(GetChars(pos), value.data(), std::min<size_t>(GetLength(pos), value.size()));
+          order[pos] = ret != 0 ? ret : static_cast<int>(GetLength(pos)) - static_cast<int>(value.size());
+        }
+      }
+      return SelectByComparison(op, order.data(), nulls_.data(), 0, selection);
+    }
+    default:
+      return false;
+  }
+}
+
+void ColumnVector::SelectNull(bool is_null, std::vector<uint32_t> &selection) const {
+  size_t kept = 0;
+  for (uint32_t pos : selection) {
+    selection[kept] = pos;
+    kept += static_cast<size_t>((nulls_[pos] != 0) == is_null);
+  }
+  selection.resize(kept);
+}
+
+bool ColumnVector::CompareBitmap(CompareOp op, const Field &constant, uint64_t *bits) const {
+  if (constant.GetTypeId() != type_ || type_ == kTypeChar || op == CompareOp::IsNull || op == CompareOp::NotNull) {
+    return false;
+  }
+  if (constant.IsNull()) {
+    std::fill(bits, bits + FilterKernels::WordCount(GetSize()), 0);
+    return true;
+  }
+  if (type_ == kTypeInt) {
+    FilterKernels::Get().CompareInt(ints_.data(), nulls_.data(), GetSize(), op, constant.GetInteger(), bits);
+  } else {
+    FilterKernels::Get().CompareFloat(floats_.data(), nulls_.data(), GetSize(), op, constant.GetFloat(), bits);
+  }
+  return true;
+}
+
+bool ColumnVector::BetweenBitmap(const Field &lower, bool lower_inclusive, const Field &upper, bool upper_inclusive,
+                                 uint64_t *bits) const {
+  if (lower.GetTypeId() != type_ || upper.GetTypeId() != type_ || type_ == kTypeChar) {
+    return false;
+  }
+  if (lower.IsNull() || upper.IsNull()) {
+    std::fill(bits, bits + FilterKernels::WordCount(GetSize()), 0);
+    return true;
+  }
+  if (type_ == kTypeInt) {
+    FilterKernels::Get().BetweenInt(ints_.data(), nulls_.data(), GetSize(), lower.GetInteger(), lower_inclusive,
+                                    upper.GetInteger(), upper_inclusive, bits);
+  } else {
+    FilterKernels::Get().BetweenFloat(floats_.data(), nulls_.data(), GetSize(), lower.GetFloat(), lower_inclusive,
+                                      upper.GetFloat(), upper_inclusive, bits);
+  }
+  return true;
+}
+
+void ColumnVector::NullBitmap(bool is_null, uint64_t *bits) const {
+  size_t words = FilterKernels::WordCount(GetSize());
+  FilterKernels::Get().NotNull(nulls_.data(), GetSize(), bits);
+  if (is_null) {
+    for (size_t i = 0; i < words; i++) {
+      bits[i] = ~bits[i];
+    }
+    // 最后一行之后的位保持为0
+    if (GetSize() % 64 != 0) {
+      bits[words - 1] &= (static_cast<uint64_t>(1) << (GetSize() % 64)) - 1;
+    }
+  }
+}
+
+void DataChunk::Reset(const Schema *schema) {
+  row_ids_.clear();
+  selection_.clear();
+  if (schema == schema_ && (schema != nullptr || !columns_.empty())) {
+    for (auto &column : columns_) {
+      column.Clear();
+    }
+    return;
+  }
+  schema_ = schema;
+  columns_.clear();
+  row_ids_.reserve(CAPACITY);
+  selection_.reserve(CAPACITY);
+  if (schema == nullptr) {
+    return;
+  }
+  for (auto column : schema->GetColumns()) {
+    columns_.emplace_back(column->GetType());
+    columns_.back().Reserve(CAPACITY);
+  }
+}
+
+void DataChunk::SelectBitmap(const uint64_t *bits) {
+  if (selection_.size() == row_ids_.size()) {
+    // 全部选中时直接展开置位的位置
+    selection_.clear();
+    for (size_t word = 0; word < FilterKernels::WordCount(row_ids_.size()); word++) {
+      for (uint64_t mask = bits[word]; mask != 0; mask &= mask - 1) {
+        selection_.push_back(word * 64 + __builtin_ctzll(mask));
+      }
+    }
+    return;
+  }
+  size_t kept = 0;
+  for (uint32_t pos : selection_) {
+    selection_[kept] = pos;
+    kept += (bits[pos / 64] >> (pos % 64)) & 1;
+  }
+  selection_.resize(kept);
+}
+
+void DataChunk::AppendRow(const Row &row, const RowId &rid) {
+  // 没有schema时按第一行的类型建列
+  if (schema_ == nullptr && row_ids_.empty() && columns_.empty()) {
+    for (size_t i = 0; i < row.GetFieldCount(); i++) {
+      columns_.emplace_back(row.GetField(i)->GetTypeId());
+    }
+  }
+  ASSERT(row.GetFieldCount() == columns_.size(), "Row does not match the columns of the chunk.");
+  for (size_t i = 0; i < columns_.size(); i++) {
+    columns_[i].Append(*row.GetField(i));
+  }
+  selection_.push_back(row_ids_.size());
+  row_ids_.push_back(rid);
+}
+
+uint32_t DataChunk::AppendSerialized(const char *buf, const RowId &rid) {
+  const char *start = buf;
+  // magic number之后是null bitmap
+  buf += sizeof(uint32_t);
+  uint32_t null_bitmap = MACH_READ_UINT32(buf);
+  buf += sizeof(uint32_t);
+  for (size_t i = 0; i < columns_.size(); i++) {
+    buf += columns_[i].AppendSerialized(buf, (null_bitmap & (1U << i)) != 0);
+  }
+  selection_.push_back(row_ids_.size());
+  row_ids_.push_back(rid);
+  return buf - start;
+}
+
+void DataChunk::AppendSelected(const DataChunk &source, const std::vector<uint32_t> &column_map) {
+  ASSERT(column_map.size() == columns_.size(), "Column map does not match the columns of the chunk.");
+  for (size_t i = 0; i < columns_.size(); i++) {
+    columns_[i].AppendSelected(source.columns_[column_map[i]], source.selection_);
+  }
+  for (uint32_t pos : source.selection_) {
+    selection_.push_back(row_ids_.size());
+    row_ids_.push_back(source.row_ids_[pos]);
+  }
+}
+
+void DataChunk::AppendRowAt(const DataChunk &source, size_t pos, const std::vector<uint32_t> &column_map) {
+  ASSERT(column_map.size() == columns_.size(), "Column map does not match the columns of the chunk.");
+  for (size_t i = 0; i < columns_.size(); i++) {
+    columns_[i].AppendAt(source.columns_[column_map[i]], pos);
+  }
+  selection_.push_back(row_ids_.size());
+  row_ids_.push_back(source.row_ids_[pos]);
+}
+
+void DataChunk::GetRowAt(size_t pos, Row *row) const {
+  std::vector<Field> fields;
+  fields.reserve(columns_.size());
+  for (const auto &column : columns_) {
+    fields.emplace_back(column.GetField(pos));
+  }
+  *row = Row(fields);
+  row->SetRowId(row_ids_[pos]);
+}
+
+void DataChunk::AppendJoined(const DataChunk &left, const std::vector<uint32_t> &left_pos, const DataChunk &right,
+                             const std::vector<uint32_t> &right_pos,
+                             const std::vector<std::pair<uint32_t, uint32_t>> &column_map) {
+  ASSERT(column_map.size() == columns_.size(), "Column map does not match the columns of the chunk.");
+  ASSERT(left_pos.size() == right_pos.size(), "Joined rows do not match.");
+  for (size_t i = 0; i < columns_.size(); i++) {
+    if (column_map[i].first == 0) {
+      columns_[i].AppendSelected(left.columns_[column_map[i].second], left_pos);
+    } else {
+      columns_[i].AppendSelected(right.columns_[column_map[i].second], right_pos);
+    }
+  }
+  for (size_t k = 0; k < left_pos.size(); k++) {
+    selection_.push_back(row_ids_.size());
+    row_ids_.emplace_back();
+  }
+}
+
+uint32_t DataChunk::PackRowAt(size_t pos, char *buf) const {
+  char *start = buf;
+  for (const auto &column : columns_) {
+    *buf++ = static_cast<char>(column.IsNull(pos));
+  }
+  for (const auto &column : columns_) {
+    buf += column.SerializeAt(pos, buf);
+  }
+  return buf - start;
+}
+
+uint32_t DataChunk::GetPackedSize(size_t pos) const {
+  uint32_t size = columns_.size();
+  for (const auto &column : columns_) {
+    size += column.GetSerializedSize(pos);
+  }
+  return size;
+}
+
+uint32_t DataChunk::AppendPacked(const char *buf) {
+  const char *start = buf;
+  const char *nulls = buf;
+  buf += columns_.size();
+  for (size_t i = 0; i < columns_.size(); i++) {
+    buf += columns_[i].AppendSerialized(buf, nulls[i] != 0);
+  }
+  selection_.push_back(row_ids_.size());
+  row_ids_.emplace_back();
+  return buf - start;
+}
+
+size_t DataChunk::GetMemoryUsage() const {
+  size_t size = row_ids_.size() * (sizeof(RowId) + sizeof(uint32_t));
+  for (const auto &column : columns_) {
+    size += column.GetMemoryUsage();
+  }
+  return size;
+}
@@ -0,0 +1,284 @@
+#include "record/filter_kernels.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MINISQL_AVX2_KERNELS
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+/*
+ * 标量实现：每64行拼成一个字，null的行不成立，循环中没有分支
+ */
+template <typename T, typename Match>
+void ScalarBits(const T *values, const uint8_t *nulls, size_t size, Match match, uint64_t *bits) {
+  for (size_t begin = 0; begin < size; begin += 64) {
+    size_t count = std::min<size_t>(64, size - begin);
+    uint64_t word = 0;
+    for (size_t i = 0; i < count; i++) {
+      word |= static_cast<uint64_t>((!nulls[begin + i]) & match(values[begin + i])) << i;
+    }
+    bits[begin / 64] = word;
+  }
+}
+
+template <typename T>
+void ScalarCompare(const T *values, const uint8_t *nulls, size_t size, CompareOp op, T constant, uint64_t *bits) {
+  switch (op) {
+    case CompareOp::Equal:
+      ScalarBits(values, nulls, size, [constant](T value) { return value == constant; }, bits);
+      break;
+    case CompareOp::NotEqual:
+      ScalarBits(values, nulls, size, [constant](T value) { return value != constant; }, bits);
+      break;
+    case CompareOp::LessThan:
+      ScalarBits(values, nulls, size, [constant](T value) { return value < constant; }, bits);
+      break;
+    case CompareOp::LessThanEquals:
+      ScalarBits(values, nulls, size, [constant](T value) { return value <= constant; }, bits);
+      break;
+    case CompareOp::GreaterThan:
+      ScalarBits(values, nulls, size, [constant](T value) { return value > constant; }, bits);
+      break;
+    case CompareOp::GreaterThanEquals:
+      ScalarBits(values, nulls, size, [constant](T value) { return value >= constant; }, bits);
+      break;
+    default:
+      std::fill(bits, bits + FilterKernels::WordCount(size), 0);
+      break;
+  }
+}
+
+template <typename T>
+void ScalarBetween(const T *values, const uint8_t *nulls, size_t size, T lower, bool lower_inclusive, T upper,
+                   bool upper_inclusive, uint64_t *bits) {
+  ScalarBits(
+      values, nulls, size,
+      [=](T value) {
+        return (lower_inclusive ? value >= lower : value > lower) & (upper_inclusive ? value <= upper : value < upper);
+      },
+      bits);
+}
+
+void ScalarNotNull(const uint8_t *nulls, size_t size, uint64_t *bits) {
+  ScalarBits(nulls, nulls, size, [](uint8_t) { return true; }, bits);
+}
+
+#ifdef MINISQL_AVX2_KERNELS
+
+/** 64个null标记转成非null位 */
+AVX2_TARGET inline uint64_t NotNullWord(const uint8_t *nulls) {
+  __m256i zero = _mm256_setzero_si256();
+  auto low = static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(nulls)), zero)));
+  auto high = static_cast<uint32_t>(_mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(nulls + 32)), zero)));
+  return low | static_cast<uint64_t>(high) << 32;
+}
+
+/*
+ * 每次比较8个值得到8位，8次拼成64行的一个字；不足64行的尾部交给标量实现
+ */
+template <typename T, typename Lanes>
+AVX2_TARGET void Avx2Bits(const T *values, const uint8_t *nulls, size_t size, const Lanes &lanes, uint64_t *bits) {
+  for (size_t word = 0; word < size / 64; word++) {
+    const T *block = values + word * 64;
+    uint64_t result = 0;
+    for (size_t i = 0; i < 8; i++) {
+      result |= static_cast<uint64_t>(lanes(block + i * 8)) << (i * 8);
+    }
+    bits[word] = result & NotNullWord(nulls + word * 64);
+  }
+}
+
+template <CompareOp Op>
+struct IntCompareLanes {
+  __m256i constant_;
+
+  AVX2_TARGET uint32_t operator()(const int32_t *values) const {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+    __m256i mask;
+    // 只有=和>，其余取反或交换操作数
+    bool negate = Op == CompareOp::NotEqual || Op == CompareOp::LessThanEquals || Op == CompareOp::GreaterThanEquals;
+    if (Op == CompareOp::Equal || Op == CompareOp::NotEqual) {
+      mask = _mm256_cmpeq_epi32(value, constant_);
+    } else if (Op == CompareOp::GreaterThan || Op == CompareOp::LessThanEquals) {
+      mask = _mm256_cmpgt_epi32(value, constant_);
+    } else {
+      mask = _mm256_cmpgt_epi32(constant_, value);
+    }
+    auto lanes = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+    return negate ? ~lanes & 0xFF : lanes;
+  }
+};
+
+template <int Predicate>
+struct FloatCompareLanes {
+  __m256 constant_;
+
+  AVX2_TARGET uint32_t operator()(const float *values) const {
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(values), constant_, Predicate)));
+  }
+};
+
+template <bool LowerInclusive, bool UpperInclusive>
+struct IntBetweenLanes {
+  __m256i lower_;
+  __m256i upper_;
+
+  AVX2_TARGET uint32_t operator()(const int32_t *values) const {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+    auto below = static_cast<uint32_t>(_mm256_movemask_ps(
+        _mm256_castsi256_ps(LowerInclusive ? _mm256_cmpgt_epi32(lower_, value) : _mm256_cmpgt_epi32(value, lower_))));
+    auto above = static_cast<uint32_t>(_mm256_movemask_ps(
+        _mm256_castsi256_ps(UpperInclusive ? _mm256_cmpgt_epi32(value, upper_) : _mm256_cmpgt_epi32(upper_, value))));
+    return (LowerInclusive ? ~below : below) & (UpperInclusive ? ~above : above) & 0xFF;
+  }
+};
+
+template <bool LowerInclusive, bool UpperInclusive>
+struct FloatBetweenLanes {
+  __m256 lower_;
+  __m256 upper_;
+
+  AVX2_TARGET uint32_t operator()(const float *values) const {
+    __m256 value = _mm256_loadu_ps(values);
+    __m256 low = LowerInclusive ? _mm256_cmp_ps(value, lower_, _CMP_GE_OQ) : _mm256_cmp_ps(value, lower_, _CMP_GT_OQ);
+    __m256 high = UpperInclusive ? _mm256_cmp_ps(value, upper_, _CMP_LE_OQ) : _mm256_cmp_ps(value, upper_, _CMP_LT_OQ);
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_and_ps(low, high)));
+  }
+};
+
+AVX2_TARGET void Avx2CompareInt(const int32_t *values, const uint8_t *nulls, size_t size, CompareOp op,
+                                int32_t constant, uint64_t *bits) {
+  __m256i broadcast = _mm256_set1_epi32(constant);
+  switch (op) {
+    case CompareOp::Equal:
+      Avx2Bits(values, nulls, size, IntCompareLanes<CompareOp::Equal>{broadcast}, bits);
+      break;
+    case CompareOp::NotEqual:
+      Avx2Bits(values, nulls, size, IntCompareLanes<CompareOp::NotEqual>{broadcast}, bits);
+      break;
+    case CompareOp::LessThan:
+      Avx2Bits(values, nulls, size, IntCompareLanes<CompareOp::LessThan>{broadcast}, bits);
+      break;
+    case CompareOp::LessThanEquals:
+      Avx2Bits(values, nulls, size, IntCompareLanes<CompareOp::LessThanEquals>{broadcast}, bits);
+      break;
+    case CompareOp::GreaterThan:
+      Avx2Bits(values, nulls, size, IntCompareLanes<CompareOp::GreaterThan>{broadcast}, bits);
+      break;
+    case CompareOp::GreaterThanEquals:
+      Avx2Bits(values, nulls, size, IntCompareLanes<CompareOp::GreaterThanEquals>{broadcast}, bits);
+      break;
+    default:
+      ScalarCompare(values, nulls, size, op, constant, bits);
+      return;
+  }
+  size_t done = size / 64 * 64;
+  ScalarCompare(values + done, nulls + done, size - done, op, constant, bits + done / 64);
+}
+
+AVX2_TARGET void Avx2CompareFloat(const float *values, const uint8_t *nulls, size_t size, CompareOp op,
+                                  float constant, uint64_t *bits) {
+  __m256 broadcast = _mm256_set1_ps(constant);
+  // 有序比较，和C++的比较运算一样NaN只满足<>
+  switch (op) {
+    case CompareOp::Equal:
+      Avx2Bits(values, nulls, size, FloatCompareLanes<_CMP_EQ_OQ>{broadcast}, bits);
+      break;
+    case CompareOp::NotEqual:
+      Avx2Bits(values, nulls, size, FloatCompareLanes<_CMP_NEQ_UQ>{broadcast}, bits);
+      break;
+    case CompareOp::LessThan:
+      Avx2Bits(values, nulls, size, FloatCompareLanes<_CMP_LT_OQ>{broadcast}, bits);
+      break;
+    case CompareOp::LessThanEquals:
+      Avx2Bits(values, nulls, size, FloatCompareLanes<_CMP_LE_OQ>{broadcast}, bits);
+      break;
+    case CompareOp::GreaterThan:
+      Avx2Bits(values, nulls, size, FloatCompareLanes<_CMP_GT_OQ>{broadcast}, bits);
+      break;
+    case CompareOp::GreaterThanEquals:
+      Avx2Bits(values, nulls, size, FloatCompareLanes<_CMP_GE_OQ>{broadcast}, bits);
+      break;
+    default:
+      ScalarCompare(values, nulls, size, op, constant, bits);
+      return;
+  }
+  size_t done = size / 64 * 64;
+  ScalarCompare(values + done, nulls + done, size - done, op, constant, bits + done / 64);
+}
+
+AVX2_TARGET void Avx2BetweenInt(const int32_t *values, const uint8_t *nulls, size_t size, int32_t lower,
+                                bool lower_inclusive, int32_t upper, bool upper_inclusive, uint64_t *bits) {
+  __m256i low = _mm256_set1_epi32(lower);
+  __m256i high = _mm256_set1_epi32(upper);
+  if (lower_inclusive && upper_inclusive) {
+    Avx2Bits(values, nulls, size, IntBetweenLanes<true, true>{low, high}, bits);
+  } else if (lower_inclusive) {
+    Avx2Bits(values, nulls, size, IntBetweenLanes<true, false>{low, high}, bits);
+  } else if (upper_inclusive) {
+    Avx2Bits(values, nulls, size, IntBetweenLanes<false, true>{low, high}, bits);
+  } else {
+    Avx2Bits(values, nulls, size, IntBetweenLanes<false, false>{low, high}, bits);
+  }
+  size_t done = size / 64 * 64;
+  ScalarBetween(values + done, nulls + done, size - done, lower, lower_inclusive, upper, upper_inclusive,
+                bits + done / 64);
+}
+
+AVX2_TARGET void Avx2BetweenFloat(const float *values, const uint8_t *nulls, size_t size, float lower,
+                                  bool lower_inclusive, float upper, bool upper_inclusive, uint64_t *bits) {
+  __m256 low = _mm256_set1_ps(lower);
+  __m256 high = _mm256_set1_ps(upper);
+  if (lower_inclusive && upper_inclusive) {
+    Avx2Bits(values, nulls, size, FloatBetweenLanes<true, true>{low, high}, bits);
+  } else if (lower_inclusive) {
+    Avx2Bits(values, nulls, size, FloatBetweenLanes<true, false>{low, high}, bits);
+  } else if (upper_inclusive) {
+    Avx2Bits(values, nulls, size, FloatBetweenLanes<false, true>{low, high}, bits);
+  } else {
+    Avx2Bits(values, nulls, size, FloatBetweenLanes<false, false>{low, high}, bits);
+  }
+  size_t done = size / 64 * 64;
+  ScalarBetween(values + done, nulls + done, size - done, lower, lower_inclusive, upper, upper_inclusive,
+                bits + done / 64);
+}
+
+AVX2_TARGET void Avx2NotNull(const uint8_t *nulls, size_t size, uint64_t *bits) {
+  for (size_t word = 0; word < size / 64; word++) {
+    bits[word] = NotNullWord(nulls + word * 64);
+  }
+  size_t done = size / 64 * 64;
+  ScalarNotNull(nulls + done, size - done, bits + done / 64);
+}
+
+#endif  // MINISQL_AVX2_KERNELS
+
+}  // namespace
+
+const FilterKernels &FilterKernels::Scalar() {
+  static const FilterKernels kernels("scalar", ScalarCompare<int32_t>, ScalarCompare<float>, ScalarBetween<int32_t>,
+                                     ScalarBetween<float>, ScalarNotNull);
+  return kernels;
+}
+
+const FilterKernels *FilterKernels::Avx2() {
+#ifdef MINISQL_AVX2_KERNELS
+  static const bool supported = __builtin_cpu_supports("avx2");
+  static const FilterKernels kernels("avx2", Avx2CompareInt, Avx2CompareFloat, Avx2BetweenInt, Avx2BetweenFloat,
+                                     Avx2NotNull);
+  return supported ? &kernels : nullptr;
+#else
+  return nullptr;
+#endif
+}
+
+const FilterKernels &FilterKernels::Get() {
+  static const FilterKernels &kernels = Avx2() != nullptr ? *Avx2() : Scalar();
+  return kernels;
+}
@@ -0,0 +1,26 @@
+#include "storage/page_chain_cursor.h"
+
+#include "page/table_page.h"
+
+bool PageChainCursor::Next(size_t count, std::vector<page_id_t> *pages, size_t *seq) {
+  std::lock_guard<std::mutex> guard(latch_);
+  pages->clear();
+  while (pages->size() < count && next_page_id_ != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id_));
+    if (page == nullptr) {
+      next_page_id_ = INVALID_PAGE_ID;
+      break;
+    }
+    pages->push_back(next_page_id_);
+    page->RLatch();
+    page_id_t next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(next_page_id_, false);
+    next_page_id_ = next_page_id;
+  }
+  if (pages->empty()) {
+    return false;
+  }
+  *seq = next_seq_++;
+  return true;
+}
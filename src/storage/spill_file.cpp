@@ -0,0 +1,80 @@
+#include "storage/spill_file.h"
+
+#include <cstring>
+#include <stdexcept>
+
+SpillFile::SpillFile(BufferPoolManager *buffer_pool_manager, const Schema *schema)
+    : buffer_pool_manager_(buffer_pool_manager), schema_(schema), buffer_(PAGE_SIZE), offset_(sizeof(uint32_t)) {}
+
+SpillFile::~SpillFile() {
+  for (auto page_id : pages_) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+}
+
+void SpillFile::AppendRowAt(const DataChunk &chunk, size_t pos) {
+  uint32_t size = chunk.GetPackedSize(pos);
+  if (offset_ + size > PAGE_SIZE) {
+    if (page_rows_ == 0) {
+      throw std::runtime_error("a row is too large to spill");
+    }
+    WritePage();
+  }
+  offset_ += chunk.PackRowAt(pos, buffer_.data() + offset_);
+  page_rows_++;
+  row_count_++;
+  byte_count_ += size;
+}
+
+void SpillFile::Append(const DataChunk &chunk) {
+  for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+    AppendRowAt(chunk, chunk.GetSelected(i));
+  }
+}
+
+void SpillFile::WritePage() {
+  page_id_t page_id;
+  auto page = buffer_pool_manager_->NewPage(page_id);
+  if (page == nullptr) {
+    throw std::runtime_error("no free frame in the buffer pool to spill to");
+  }
+  MACH_WRITE_UINT32(buffer_.data(), page_rows_);
+  memcpy(page->GetData(), buffer_.data(), PAGE_SIZE);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  pages_.push_back(page_id);
+  offset_ = sizeof(uint32_t);
+  page_rows_ = 0;
+}
+
+void SpillFile::Rewind() {
+  if (page_rows_ > 0) {
+    WritePage();
+  }
+  read_page_ = 0;
+  read_rows_ = 0;
+}
+
+bool SpillFile::Read(DataChunk *chunk) {
+  chunk->Reset(schema_);
+  while (!chunk->IsFull()) {
+    if (read_rows_ == 0) {
+      if (read_page_ >= pages_.size()) {
+        break;
+      }
+      // 整页拷出来，读的时候不占着buffer pool的帧
+      auto page = buffer_pool_manager_->FetchPage(pages_[read_page_]);
+      if (page == nullptr) {
+        throw std::runtime_error("no free frame in the buffer pool to read spilled rows");
+      }
+      memcpy(buffer_.data(), page->GetData(), PAGE_SIZE);
+      buffer_pool_manager_->UnpinPage(pages_[read_page_], false);
+      read_page_++;
+      read_rows_ = MACH_READ_UINT32(buffer_.data());
+      read_offset_ = sizeof(uint32_t);
+      continue;
+    }
+    read_offset_ += chunk->AppendPacked(buffer_.data() + read_offset_);
+    read_rows_--;
+  }
+  return chunk->GetSelectedCount() > 0;
+}
@@ -69,6 +69,7 @@ bool TableHeap::UpdateTuple(Row &row, const RowId &rid, Txn *txn) {
   if (page->UpdateTuple(row, &old_row, schema_, txn, lock_manager_, log_manager_)) {
     page->WUnlatch();
     buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+    row.SetRowId(rid);
     return true;
   }
   page->WUnlatch();
@@ -122,6 +123,83 @@ bool TableHeap::GetTuple(Row *row, Txn *txn) {
   return true;
 }
 
+void TableHeap::GetTuples(std::vector<RowId>::const_iterator begin, std::vector<RowId>::const_iterator end,
+                          std::vector<Row> &rows, Txn *txn) {
+  if (begin == end) {
+    return;
+  }
+  page_id_t page_id = begin->GetPageId();
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return;
+  }
+  page->RLatch();
+  for (auto iter = begin; iter != end; ++iter) {
+    ASSERT(iter->GetPageId() == page_id, "Row ids must lie on one page.");
+    rows.emplace_back(*iter);
+    if (!page->GetTuple(&rows.back(), schema_, txn, lock_manager_)) {
+      rows.pop_back();
+    }
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+}
+
+void TableHeap::GetTuples(std::vector<RowId>::const_iterator begin, std::vector<RowId>::const_iterator end,
+                          DataChunk *chunk, Txn *txn) {
+  if (begin == end) {
+    return;
+  }
+  page_id_t page_id = begin->GetPageId();
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return;
+  }
+  page->RLatch();
+  for (auto iter = begin; iter != end; ++iter) {
+    ASSERT(iter->GetPageId() == page_id, "Row ids must lie on one page.");
+    page->GetTuple(*iter, chunk);
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+}
+
+void TableHeap::ScanTuples(RowId *cursor, DataChunk *chunk, Txn *txn) {
+  page_id_t page_id = cursor->GetPageId();
+  uint32_t slot = cursor->GetSlotNum();
+  while (page_id != INVALID_PAGE_ID && !chunk->IsFull()) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page == nullptr) {
+      page_id = INVALID_PAGE_ID;
+      break;
+    }
+    page->RLatch();
+    slot = page->ScanTuples(slot, chunk);
+    // 这一页读完才换下一页，否则下次从slot继续
+    page_id_t next_page_id = slot < page->GetSlotCount() ? page_id : page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    if (next_page_id != page_id) {
+      page_id = next_page_id;
+      slot = 0;
+    }
+  }
+  cursor->Set(page_id, slot);
+}
+
+bool TableHeap::ScanPage(page_id_t page_id, uint32_t *slot, DataChunk *chunk, Txn *txn) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return true;
+  }
+  page->RLatch();
+  *slot = page->ScanTuples(*slot, chunk);
+  bool done = *slot >= page->GetSlotCount();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return done;
+}
+
 void TableHeap::DeleteTable(page_id_t page_id) {
   if (page_id != INVALID_PAGE_ID) {
     auto temp_table_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));  // 删除table_heap
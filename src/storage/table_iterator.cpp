@@ -1,6 +1,7 @@
 #include "storage/table_iterator.h"
 
 #include "common/macros.h"
+#include "index/clustered_index.h"
 #include "storage/table_heap.h"
 
 TableIterator::TableIterator() {
@@ -10,16 +11,36 @@ TableIterator::TableIterator() {
 }
 
 TableIterator::TableIterator(TableHeap *table_heap, Row* row, Txn *txn)
-    : table_heap_(table_heap),
-      row_(row),
+    : row_(row),
+      table_heap_(table_heap),
       txn_(txn) {}
 
-TableIterator::TableIterator(const TableIterator &other) {
+TableIterator::TableIterator(ClusteredIndex *clustered_index, const IndexIterator &iter, Txn *txn)
+    : row_(nullptr),
+      table_heap_(nullptr),
+      txn_(txn),
+      clustered_index_(clustered_index),
+      leaf_iter_(iter) {
+  ReadClusteredRow();
+}
+
+TableIterator::TableIterator(const TableIterator &other) : leaf_iter_(other.leaf_iter_) {
   table_heap_ = other.table_heap_;
+  row_ = nullptr;
   if (other.row_ != nullptr) {
     row_ = new Row(*other.row_);
   }
   txn_ = other.txn_;
+  clustered_index_ = other.clustered_index_;
+}
+
+void TableIterator::ReadClusteredRow() {
+  delete row_;
+  row_ = nullptr;
+  if (leaf_iter_ != clustered_index_->GetEndIterator()) {
+    row_ = new Row();
+    clustered_index_->ReadRow((*leaf_iter_).first, *row_);
+  }
 }
 
 TableIterator::~TableIterator() {
@@ -48,7 +69,11 @@ Row *TableIterator::operator->() {
 }
 
 TableIterator &TableIterator::operator=(const TableIterator &itr) noexcept {
+  if (this == &itr) {
+    return *this;
+  }
   table_heap_ = itr.table_heap_;
+  delete row_;
   if (itr.row_ != nullptr) {
     row_ = new Row(*itr.row_);
   }
@@ -56,11 +81,26 @@ TableIterator &TableIterator::operator=(const TableIterator &itr) noexcept {
     row_ = nullptr;
   }
   txn_ = itr.txn_;
+  clustered_index_ = itr.clustered_index_;
+  leaf_iter_ = itr.leaf_iter_;
   return *this;
 }
 
+page_id_t TableIterator::GetPageId() const {
+  if (clustered_index_ != nullptr) {
+    return leaf_iter_.GetPageId();
+  }
+  return row_ == nullptr ? INVALID_PAGE_ID : row_->GetRowId().GetPageId();
+}
+
 // ++iter
 TableIterator &TableIterator::operator++() {
+  // clustered表按主键顺序沿叶子链读取
+  if (clustered_index_ != nullptr) {
+    ++leaf_iter_;
+    ReadClusteredRow();
+    return *this;
+  }
   // 寻找下一个row
   page_id_t page_id = row_->GetRowId().GetPageId();
   auto page = reinterpret_cast<TablePage *>(table_heap_->buffer_pool_manager_->FetchPage(page_id));
@@ -72,6 +112,7 @@ TableIterator &TableIterator::operator++() {
     table_heap_->GetTuple(next_row, txn_);
     page->RUnlatch();
     table_heap_->buffer_pool_manager_->UnpinPage(page_id, false);
+    delete row_;
     row_ = next_row;
     return *this;
   } 
@@ -90,6 +131,7 @@ TableIterator &TableIterator::operator++() {
       table_heap_->GetTuple(first_row, txn_);
       page->RUnlatch();
       table_heap_->buffer_pool_manager_->UnpinPage(next_page_id, false);
+      delete row_;
       row_ = first_row;
       return *this;
     }
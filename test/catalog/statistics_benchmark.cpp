@@ -0,0 +1,38 @@
+#include <chrono>
+
+#include "statistics_test_util.h"  // NOLINT
+
+/**
+ * A predicate keeping 90% of the rows, through the grp index (the plan without statistics) and in
+ * heap order (the plan after ANALYZE), with a hot buffer pool and after reopening with a pool much
+ * smaller than the table. The index visits every heap page once for each grp value.
+ */
+TEST_F(StatisticsTest, SelectivityBenchmark) {
+  CreateTable(false, 20000);
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_grp", {"grp"}, nullptr, index_info, "bptree"));
+  const std::string broad = "select * from t where grp > 0;";
+  auto time = [this](const AbstractPlanNodeRef &plan) {
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(18000, Run(plan));
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  for (uint32_t pool_size : {DEFAULT_BUFFER_POOL_SIZE, 64}) {
+    if (pool_size != DEFAULT_BUFFER_POOL_SIZE) {
+      delete db_;
+      db_ = new DBStorageEngine(db_name_, false, pool_size);
+    }
+    TableInfo *table_info = nullptr;
+    db_->catalog_mgr_->GetTable("t", table_info);
+    table_info->SetStatistics(nullptr);
+    auto index_plan = Plan(broad);
+    ASSERT_EQ(PlanType::IndexScan, index_plan->GetType());
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+    auto seq_plan = Plan(broad);
+    ASSERT_EQ(PlanType::SeqScan, seq_plan->GetType());
+    double index_time = time(index_plan);
+    double seq_time = time(seq_plan);
+    std::cout << broad << " " << pool_size << " page buffer pool: index scan " << index_time << " ms, seq scan "
+              << seq_time << " ms" << std::endl;
+  }
+}
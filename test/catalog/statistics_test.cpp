@@ -0,0 +1,134 @@
+#include "statistics_test_util.h"  // NOLINT
+
+/**
+ * A table smaller than the sample is read whole, the statistics are exact apart from the histograms.
+ */
+TEST_F(StatisticsTest, ExactTest) {
+  CreateTable(true, 20000);
+  ASSERT_EQ(DB_TABLE_NOT_EXIST, db_->catalog_mgr_->AnalyzeTable("u", nullptr));
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  TableInfo *table_info = nullptr;
+  db_->catalog_mgr_->GetTable("t", table_info);
+  auto statistics = table_info->GetStatistics();
+  ASSERT_NE(nullptr, statistics);
+  ASSERT_EQ(20000, statistics->GetRowCount());
+  ASSERT_EQ(20000, statistics->GetSampleSize());
+  ASSERT_EQ(4, statistics->GetColumnCount());
+  EXPECT_DOUBLE_EQ(20000, statistics->GetColumn(0).GetDistinctCount());
+  EXPECT_DOUBLE_EQ(10, statistics->GetColumn(1).GetDistinctCount());
+  EXPECT_DOUBLE_EQ(750, statistics->GetColumn(2).GetDistinctCount());
+  EXPECT_DOUBLE_EQ(97, statistics->GetColumn(3).GetDistinctCount());
+  EXPECT_DOUBLE_EQ(0, statistics->GetColumn(0).GetNullFraction());
+  EXPECT_DOUBLE_EQ(0.25, statistics->GetColumn(2).GetNullFraction());
+  ASSERT_EQ(ColumnStatistics::MAX_BUCKETS, statistics->GetColumn(0).GetBucketCount());
+  const auto &id = statistics->GetColumn(0);
+  EXPECT_NEAR(0.25, id.EstimateComparison("<", Int(5000)), 0.01);
+  EXPECT_NEAR(0.75, id.EstimateComparison(">=", Int(5000)), 0.01);
+  EXPECT_DOUBLE_EQ(0, id.EstimateComparison("<", Int(-1)));
+  EXPECT_DOUBLE_EQ(1, id.EstimateComparison("<=", Int(20000)));
+  EXPECT_DOUBLE_EQ(0, id.EstimateComparison("=", Int(20000)));
+  EXPECT_NEAR(1.0 / 20000, id.EstimateComparison("=", Int(123)), 1e-9);
+  // grp的每个值占满多个桶
+  const auto &grp = statistics->GetColumn(1);
+  EXPECT_NEAR(0.1, grp.EstimateComparison("=", Int(3)), 0.02);
+  EXPECT_NEAR(0.9, grp.EstimateComparison(">", Int(0)), 0.03);
+  EXPECT_NEAR(0.9, grp.EstimateComparison("<>", Int(3)), 0.02);
+  const auto &val = statistics->GetColumn(2);
+  EXPECT_DOUBLE_EQ(0.25, val.EstimateComparison("is", Field(TypeId::kTypeInt)));
+  EXPECT_DOUBLE_EQ(0.75, val.EstimateComparison("not", Field(TypeId::kTypeInt)));
+  EXPECT_NEAR(0.75 / 750, val.EstimateComparison("=", Int(5)), 1e-6);
+  EXPECT_NEAR(0.375, val.EstimateComparison("<", Int(500)), 0.02);
+  const auto &name = statistics->GetColumn(3);
+  std::string low = "name-5";
+  EXPECT_NEAR(1.0 / 97, name.EstimateComparison("=", Field(TypeId::kTypeChar, const_cast<char *>(low.c_str()),
+                                                             low.size(), true)),
+              1e-6);
+}
+
+/**
+ * A table larger than the sample: counts stay exact, distinct values are estimated from the sample.
+ */
+TEST_F(StatisticsTest, SampleTest) {
+  const int n = 100000;
+  CreateTable(true, n);
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  TableInfo *table_info = nullptr;
+  db_->catalog_mgr_->GetTable("t", table_info);
+  auto statistics = table_info->GetStatistics();
+  ASSERT_EQ(n, statistics->GetRowCount());
+  ASSERT_EQ(TableStatistics::SAMPLE_SIZE, statistics->GetSampleSize());
+  EXPECT_NEAR(n, statistics->GetColumn(0).GetDistinctCount(), n * 0.05);
+  EXPECT_NEAR(10, statistics->GetColumn(1).GetDistinctCount(), 0.5);
+  EXPECT_NEAR(750, statistics->GetColumn(2).GetDistinctCount(), 75);
+  EXPECT_NEAR(97, statistics->GetColumn(3).GetDistinctCount(), 0.5);
+  EXPECT_NEAR(0.25, statistics->GetColumn(2).GetNullFraction(), 0.01);
+  std::unordered_set<uint32_t> id_column{0};
+  auto id_range = std::make_shared<LogicExpression>(
+      std::make_shared<ComparisonExpression>(std::make_shared<ColumnValueExpression>(0, 0, TypeId::kTypeInt),
+                                             std::make_shared<ConstantValueExpression>(Int(90000)), ">"),
+      std::make_shared<ComparisonExpression>(std::make_shared<ColumnValueExpression>(0, 0, TypeId::kTypeInt),
+                                             std::make_shared<ConstantValueExpression>(Int(95000)), "<="),
+      LogicType::And);
+  EXPECT_NEAR(0.05, Planner::EstimateSelectivity(id_range, statistics, id_column), 0.01);
+  // 其他列上的条件不能缩小id上的索引扫描
+  EXPECT_DOUBLE_EQ(1, Planner::EstimateSelectivity(id_range, statistics, {1}));
+  // 再次ANALYZE替换旧的统计信息
+  for (int i = n; i < 2 * n; i++) {
+    std::vector<Field> fields{Int(i), Int(0), Field(TypeId::kTypeInt), Field(TypeId::kTypeChar)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+  }
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  statistics = table_info->GetStatistics();
+  ASSERT_EQ(2 * n, statistics->GetRowCount());
+  EXPECT_NEAR(0.625, statistics->GetColumn(2).GetNullFraction(), 0.02);
+  EXPECT_NEAR(0.55, statistics->GetColumn(1).EstimateComparison("=", Int(0)), 0.03);
+}
+
+TEST_F(StatisticsTest, PersistTest) {
+  CreateTable(false, 5000);
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  TableInfo *table_info = nullptr;
+  db_->catalog_mgr_->GetTable("t", table_info);
+  std::vector<char> before(table_info->GetStatistics()->GetSerializedSize());
+  table_info->GetStatistics()->SerializeTo(before.data());
+  delete db_;
+  db_ = new DBStorageEngine(db_name_, false);
+  db_->catalog_mgr_->GetTable("t", table_info);
+  ASSERT_NE(nullptr, table_info->GetStatistics());
+  std::vector<char> after(table_info->GetStatistics()->GetSerializedSize());
+  table_info->GetStatistics()->SerializeTo(after.data());
+  ASSERT_EQ(before, after);
+  ASSERT_EQ(5000, table_info->GetStatistics()->GetRowCount());
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->DropTable("t"));
+}
+
+/**
+ * With statistics the planner reads a heap table in order when the index condition keeps many
+ * scattered rows.
+ */
+TEST_F(StatisticsTest, PlanTest) {
+  CreateTable(false, 20000);
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_grp", {"grp"}, nullptr, index_info, "bptree"));
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+  const std::string broad = "select * from t where grp > 0;";
+  const std::string narrow = "select * from t where grp = 3 and id < 1000;";
+  auto broad_index = Plan(broad);
+  ASSERT_EQ(PlanType::IndexScan, broad_index->GetType());
+  ASSERT_EQ(PlanType::IndexScan, Plan(narrow)->GetType());
+  ASSERT_EQ(kNodeAnalyze, ParseType("ANALYZE t;"));
+  ASSERT_EQ(kNodeUnknown, ParseType("analyse t;"));
+  // analyze不是保留字，还可以作为名字
+  ASSERT_EQ(kNodeAnalyze, ParseType("analyze analyze;"));
+  ASSERT_EQ(kNodeCreateTable, ParseType("create table analyze(analyze int);"));
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  auto broad_seq = Plan(broad);
+  ASSERT_EQ(PlanType::SeqScan, broad_seq->GetType());
+  ASSERT_EQ(PlanType::IndexScan, Plan(narrow)->GetType());
+  ASSERT_EQ(PlanType::BitmapHeapScan, Plan("select * from t where grp = 3;")->GetType());
+  ASSERT_EQ(PlanType::SeqScan, Plan("select * from t where id >= 5000;")->GetType());
+  ASSERT_EQ(PlanType::IndexScan, Plan("select * from t where id >= 18000;")->GetType());
+  ASSERT_EQ(18000, Run(broad_index));
+  ASSERT_EQ(18000, Run(broad_seq));
+}
@@ -0,0 +1,65 @@
+#ifndef MINISQL_STATISTICS_TEST_UTIL_H
+#define MINISQL_STATISTICS_TEST_UTIL_H
+
+#include <string>
+
+#include "../execution/sql_test_util.h"  // NOLINT
+#include "catalog/statistics.h"
+#include "executor/executors/index_scan_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+
+/**
+ * Table t(id int unique, grp int, val int, name char(16)) with grp = id % 10, val = id % 1000 and
+ * null for every fourth row, name = "name-" + id % 97. The clustered table fills in fast, it is used
+ * when the table has to be larger than the sample.
+ */
+class StatisticsTest : public SqlTest {
+ public:
+  void SetUp() override { db_ = new DBStorageEngine(db_name_, true); }
+
+  TableInfo *CreateTable(bool clustered, int rows) {
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, true),
+                                     new Column("grp", TypeId::kTypeInt, 1, true, false),
+                                     new Column("val", TypeId::kTypeInt, 2, true, false),
+                                     new Column("name", TypeId::kTypeChar, 16, 3, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    TableInfo *table_info = nullptr;
+    EXPECT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info, clustered));
+    for (int i = 0; i < rows; i++) {
+      std::string name = "name-" + std::to_string(i % 97);
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeInt, i % 10),
+                                i % 4 == 0 ? Field(TypeId::kTypeInt) : Field(TypeId::kTypeInt, i % 1000),
+                                Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+      Row row(fields);
+      EXPECT_TRUE(table_info->InsertTuple(row, nullptr));
+    }
+    return table_info;
+  }
+
+  /** @return Rows of a scan plan */
+  size_t Run(const AbstractPlanNodeRef &plan) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    std::unique_ptr<AbstractExecutor> executor;
+    if (plan->GetType() == PlanType::SeqScan) {
+      executor = std::make_unique<SeqScanExecutor>(context.get(), dynamic_cast<const SeqScanPlanNode *>(plan.get()));
+    } else {
+      executor =
+          std::make_unique<IndexScanExecutor>(context.get(), dynamic_cast<const IndexScanPlanNode *>(plan.get()));
+    }
+    executor->Init();
+    Row row;
+    RowId rid;
+    size_t count = 0;
+    while (executor->Next(&row, &rid)) {
+      count++;
+    }
+    return count;
+  }
+
+  static Field Int(int value) { return Field(TypeId::kTypeInt, value); }
+
+ protected:
+  const std::string db_name_ = "statistics_test.db";
+};
+
+#endif  // MINISQL_STATISTICS_TEST_UTIL_H
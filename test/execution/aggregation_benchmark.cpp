@@ -0,0 +1,39 @@
+#include <chrono>
+
+#include "aggregation_test_util.h"  // NOLINT
+
+/** Counting in the engine against fetching the rows to count them in the client */
+TEST_F(AggregationTest, AggregateBenchmark) {
+  auto context = db_->MakeExecuteContext(nullptr);
+  const int rounds = 5;
+  auto aggregate = Plan("select count(val), sum(val) from t;");
+  auto fetch = Plan("select val from t;");
+  double ms[2];
+  int64_t sums[2] = {0, 0};
+  for (int k = 0; k < 2; k++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+      auto executor = ExecuteEngine::CreateExecutor(context.get(), k == 0 ? aggregate : fetch);
+      executor->Init();
+      std::vector<Row> rows;
+      DataChunk chunk;
+      while (executor->NextBatch(&chunk)) {
+        for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+          rows.emplace_back();
+          chunk.GetRow(i, &rows.back());
+        }
+      }
+      sums[k] = 0;
+      if (k == 0) {
+        sums[k] = rows[0].GetField(1)->GetInteger();
+        continue;
+      }
+      for (const auto &row : rows) {
+        sums[k] += row.GetField(0)->IsNull() ? 0 : row.GetField(0)->GetInteger();
+      }
+    }
+    ms[k] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+  }
+  ASSERT_EQ(sums[1], sums[0]);
+  std::cout << row_count_ << " rows, aggregate: " << ms[0] << " ms, fetch and count: " << ms[1] << " ms" << std::endl;
+}
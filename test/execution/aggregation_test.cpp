@@ -0,0 +1,142 @@
+#include "aggregation_test_util.h"  // NOLINT
+
+/**
+ * COUNT, SUM, MIN, MAX and AVG of the whole table and of groups, with nulls, empty inputs, null
+ * group keys and groups of a join, equal to the aggregates computed row by row.
+ */
+TEST_F(AggregationTest, AggregateTest) {
+  Expected all;
+  for (int i = 0; i < row_count_; i++) {
+    all.Add(i);
+  }
+  ASSERT_EQ(std::vector<std::string>{ToString(std::vector<Field>{
+                Field(kTypeInt, all.count), Field(kTypeInt, all.val_count), all.ValSum(), all.ValMin(),
+                all.ValMax(), all.AmountAvg(), all.NameMin()})},
+            Run("select count(*), count(val), sum(val), min(val), max(val), avg(amount), min(name) from t;"));
+  ASSERT_EQ(std::vector<std::string>{"|100"}, Run("select COUNT(*) from t where id < 100;"));
+  // 没有输入行时不分组的聚集也有一行
+  ASSERT_EQ(std::vector<std::string>{"|0|0|" + Field(kTypeInt).toString() + "|" + Field(kTypeFloat).toString()},
+            Run("select count(*), count(val), sum(val), avg(amount) from t where id < 0;"));
+  ASSERT_TRUE(Run("select grp, count(*) from t where id < 0 group by grp;").empty());
+
+  std::map<int, Expected> groups;
+  for (int i = 0; i < row_count_; i++) {
+    groups[i % 50].Add(i);
+  }
+  std::vector<std::string> expected;
+  for (const auto &group : groups) {
+    const Expected &e = group.second;
+    expected.push_back(ToString(std::vector<Field>{Field(kTypeInt, e.count), e.ValSum(), Field(kTypeInt, group.first),
+                                                   e.NameMin(), Field(kTypeFloat, e.amount_max), e.AmountAvg()}));
+  }
+  std::sort(expected.begin(), expected.end());
+  // 列的顺序和select一致，group by的列可以出现在任意位置
+  ASSERT_EQ(expected, Run("select count(*), sum(val), grp, min(name), max(amount), avg(amount) from t group by grp;"));
+
+  // null是一组
+  std::map<int, int> val_counts;
+  for (int i = 0; i < row_count_; i++) {
+    val_counts[i % 11 == 0 ? -1 : i % 1000]++;
+  }
+  expected.clear();
+  for (const auto &group : val_counts) {
+    expected.push_back(ToString(std::vector<Field>{group.first < 0 ? Field(kTypeInt) : Field(kTypeInt, group.first),
+                                                   Field(kTypeInt, group.second)}));
+  }
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(expected, Run("select val, count(*) from t group by val;"));
+
+  // 多列分组，没有聚集函数时就是去重
+  expected.clear();
+  std::map<std::pair<int, int>, int> pairs;
+  for (int i = 0; i < row_count_; i++) {
+    pairs[{i % 50, i % 300}]++;
+  }
+  for (const auto &pair : pairs) {
+    std::string name = "n-" + std::to_string(pair.first.second);
+    expected.push_back(ToString(std::vector<Field>{
+        Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true), Field(kTypeInt, pair.first.first)}));
+  }
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(expected, Run("select name, grp from t group by grp, name;"));
+
+  // join后分组
+  std::map<std::string, Expected> labels;
+  for (int i = 0; i < row_count_; i++) {
+    if (i % 50 < 20) {
+      labels["g" + std::to_string(i % 50 % 5)].Add(i);
+    }
+  }
+  expected.clear();
+  for (const auto &label : labels) {
+    expected.push_back(ToString(std::vector<Field>{
+        Field(kTypeChar, const_cast<char *>(label.first.c_str()), label.first.size(), true),
+        Field(kTypeInt, label.second.count), label.second.ValMax()}));
+  }
+  ASSERT_EQ(expected, Run("select label, count(*), max(val) from t, g where t.grp = g.grp and g.grp < 20 group by label;"));
+}
+
+TEST_F(AggregationTest, PlanTest) {
+  auto plan = Plan("select grp, count(*), sum(val) from t group by grp;");
+  ASSERT_EQ("HashAggregate count(*), sum(val) group by grp", plan->ToString());
+  // 只扫描需要的列
+  ASSERT_EQ(2, plan->GetChildAt(0)->OutputSchema()->GetColumnCount());
+  ASSERT_EQ("sum(val)", plan->OutputSchema()->GetColumn(2)->GetName());
+  ASSERT_EQ(kTypeInt, plan->OutputSchema()->GetColumn(2)->GetType());
+  plan = Plan("select avg(val), max(name), count(*) from t where id < 10;");
+  ASSERT_EQ("Aggregate avg(val), max(name), count(*)", plan->ToString());
+  ASSERT_EQ("SeqScan on t with filter", plan->GetChildAt(0)->ToString());
+  ASSERT_EQ(2, plan->GetChildAt(0)->OutputSchema()->GetColumnCount());
+  ASSERT_EQ(kTypeFloat, plan->OutputSchema()->GetColumn(0)->GetType());
+  ASSERT_EQ(kTypeChar, plan->OutputSchema()->GetColumn(1)->GetType());
+  plan = Plan("select count(*) from t;");
+  ASSERT_EQ(0, plan->GetChildAt(0)->OutputSchema()->GetColumnCount());
+  ASSERT_LT(plan->GetEstimatedRows(), 0);
+
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  plan = Plan("select grp, count(*) from t group by grp;");
+  ASSERT_NEAR(50, plan->GetEstimatedRows(), 5);
+  ASSERT_GT(plan->GetEstimatedCost(), plan->GetChildAt(0)->GetEstimatedCost());
+  plan = Plan("select count(*) from t;");
+  ASSERT_EQ(1, plan->GetEstimatedRows());
+
+  ExpectPlanError("select id, count(*) from t;");
+  ExpectPlanError("select id, count(*) from t group by grp;");
+  ExpectPlanError("select * from t group by grp;");
+  ExpectPlanError("select sum(name) from t;");
+  ExpectPlanError("select sum(*) from t;");
+  ExpectPlanError("select count(other) from t;");
+  ExpectParseError("select median(val) from t;");
+}
+
+/** The function names are keywords, but still name tables and columns */
+TEST_F(AggregationTest, FunctionNameTest) {
+  std::vector<Column *> columns = {new Column("count", TypeId::kTypeInt, 0, true, false),
+                                   new Column("min", TypeId::kTypeInt, 1, true, false),
+                                   new Column("max", TypeId::kTypeInt, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("sum", schema.get(), nullptr, table_info));
+  for (int i = 0; i < 9; i++) {
+    std::vector<Field> fields{Field(kTypeInt, i % 3), Field(kTypeInt, i), Field(kTypeInt, i * 2)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+  }
+  ASSERT_EQ((std::vector<std::string>{"|0|3|6|0", "|1|3|7|2", "|2|3|8|4"}),
+            Run("select count, count(*), max(min), min(max) from sum group by count;"));
+  ASSERT_EQ(std::vector<std::string>{"|5"}, Run("select count(count) from sum where sum.max < 10;"));
+}
+
+/** Groups exceeding the work memory are partitioned to temporary pages and give the same rows */
+TEST_F(AggregationTest, SpillTest) {
+  const std::string sql = "select id, count(*), sum(val), min(name) from t group by id;";
+  bool spilled = true;
+  auto expected = Run(sql, ExecuteContext::DEFAULT_WORK_MEMORY, &spilled);
+  ASSERT_FALSE(spilled);
+  ASSERT_EQ(row_count_, expected.size());
+  ASSERT_EQ(expected, Run(sql, 64 << 10, &spilled));
+  ASSERT_TRUE(spilled);
+  // 组数不多时不会spill
+  Run("select grp, count(*) from t group by grp;", 64 << 10, &spilled);
+  ASSERT_FALSE(spilled);
+}
@@ -0,0 +1,149 @@
+#ifndef MINISQL_AGGREGATION_TEST_UTIL_H
+#define MINISQL_AGGREGATION_TEST_UTIL_H
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "executor/execute_engine.h"
+#include "executor/executors/aggregation_executor.h"
+#include "sql_test_util.h"  // NOLINT
+
+/**
+ * Heap tables t(id int, grp int, val int, amount float, name char(16)) with 20000 rows, grp = i % 50,
+ * val = i % 1000 (null every 11th row), amount = i % 100 / 4 and name = "n-" + i % 300, and
+ * g(grp int, label char(8)) with a row for each group, label = "g" + grp % 5.
+ */
+class AggregationTest : public SqlTest {
+ public:
+  void SetUp() override {
+    db_ = new DBStorageEngine("aggregation_test.db", true);
+    std::vector<Column *> columns = {
+        new Column("id", TypeId::kTypeInt, 0, true, false), new Column("grp", TypeId::kTypeInt, 1, true, false),
+        new Column("val", TypeId::kTypeInt, 2, true, false), new Column("amount", TypeId::kTypeFloat, 3, true, false),
+        new Column("name", TypeId::kTypeChar, 16, 4, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    TableInfo *table_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info));
+    for (int i = 0; i < row_count_; i++) {
+      std::string name = "n-" + std::to_string(i % 300);
+      std::vector<Field> fields{Field(kTypeInt, i), Field(kTypeInt, i % 50),
+                                i % 11 == 0 ? Field(kTypeInt) : Field(kTypeInt, i % 1000),
+                                Field(kTypeFloat, static_cast<float>(i % 100) / 4),
+                                Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+      Row row(fields);
+      ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+    }
+    std::vector<Column *> group_columns = {new Column("grp", TypeId::kTypeInt, 0, true, false),
+                                           new Column("label", TypeId::kTypeChar, 8, 1, true, false)};
+    auto group_schema = std::make_shared<Schema>(group_columns);
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("g", group_schema.get(), nullptr, table_info));
+    for (int i = 0; i < 50; i++) {
+      std::string label = "g" + std::to_string(i % 5);
+      std::vector<Field> fields{Field(kTypeInt, i),
+                                Field(kTypeChar, const_cast<char *>(label.c_str()), label.size(), true)};
+      Row row(fields);
+      ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+    }
+  }
+
+  /**
+   * @param work_memory Work memory of the executors
+   * @param[out] spilled Whether the aggregation spilled
+   * @return The rows of sql as text, sorted
+   */
+  std::vector<std::string> Run(const std::string &sql, size_t work_memory = ExecuteContext::DEFAULT_WORK_MEMORY,
+                               bool *spilled = nullptr) {
+    auto plan = Plan(sql);
+    EXPECT_EQ(PlanType::Aggregation, plan->GetType()) << sql;
+    auto context = db_->MakeExecuteContext(nullptr);
+    context->SetWorkMemory(work_memory);
+    auto executor = ExecuteEngine::CreateExecutor(context.get(), plan);
+    executor->Init();
+    std::vector<std::string> result;
+    DataChunk chunk;
+    Row row;
+    while (executor->NextBatch(&chunk)) {
+      EXPECT_GT(chunk.GetSelectedCount(), 0);
+      EXPECT_LE(chunk.GetSelectedCount(), DataChunk::CAPACITY);
+      for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+        chunk.GetRow(i, &row);
+        result.push_back(ToString(row.GetFields()));
+      }
+    }
+    if (spilled != nullptr) {
+      *spilled = dynamic_cast<AggregationExecutor *>(executor.get())->IsSpilled();
+    }
+    std::sort(result.begin(), result.end());
+    EXPECT_TRUE(db_->bpm_->CheckAllUnpinned());
+    return result;
+  }
+
+  static std::string ToString(const std::vector<Field *> &fields) {
+    std::string text;
+    for (const auto field : fields) {
+      text += "|" + field->toString();
+    }
+    return text;
+  }
+
+  static std::string ToString(const std::vector<Field> &fields) {
+    std::string text;
+    for (const auto &field : fields) {
+      text += "|" + field.toString();
+    }
+    return text;
+  }
+
+  /** Aggregates of the rows of a group, computed row by row */
+  struct Expected {
+    int count{0};
+    int val_count{0};
+    int64_t val_sum{0};
+    int val_min{0};
+    int val_max{0};
+    double amount_sum{0};
+    float amount_max{0};
+    std::string name_min;
+
+    void Add(int i) {
+      float amount = static_cast<float>(i % 100) / 4;
+      std::string name = "n-" + std::to_string(i % 300);
+      if (count == 0 || amount > amount_max) {
+        amount_max = amount;
+      }
+      if (count == 0 || name < name_min) {
+        name_min = name;
+      }
+      count++;
+      amount_sum += amount;
+      if (i % 11 != 0) {
+        int val = i % 1000;
+        val_min = val_count == 0 ? val : std::min(val_min, val);
+        val_max = val_count == 0 ? val : std::max(val_max, val);
+        val_count++;
+        val_sum += val;
+      }
+    }
+
+    Field ValSum() const { return val_count == 0 ? Field(kTypeInt) : Field(kTypeInt, static_cast<int32_t>(val_sum)); }
+
+    Field ValMin() const { return val_count == 0 ? Field(kTypeInt) : Field(kTypeInt, val_min); }
+
+    Field ValMax() const { return val_count == 0 ? Field(kTypeInt) : Field(kTypeInt, val_max); }
+
+    Field AmountAvg() const {
+      return count == 0 ? Field(kTypeFloat) : Field(kTypeFloat, static_cast<float>(amount_sum / count));
+    }
+
+    Field NameMin() const {
+      return count == 0 ? Field(kTypeChar)
+                        : Field(kTypeChar, const_cast<char *>(name_min.c_str()), name_min.size(), true);
+    }
+  };
+
+ protected:
+  const int row_count_ = 20000;
+};
+
+#endif  // MINISQL_AGGREGATION_TEST_UTIL_H
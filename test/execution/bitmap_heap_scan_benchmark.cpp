@@ -0,0 +1,38 @@
+#include <chrono>
+
+#include "bitmap_heap_scan_test_util.h"  // NOLINT
+#include "executor/executors/index_scan_executor.h"
+
+/**
+ * 3 <= grp < 6 keeps 30% of the rows, in index order they go over the heap three times: fetched in
+ * index order, in heap order one page at a time, and by a sequential scan. With a hot buffer pool,
+ * then with one of 64 pages.
+ */
+TEST_F(BitmapHeapScanTest, ScanBenchmark) {
+  auto predicate = std::make_shared<LogicExpression>(Compare(1, 3, ">="), Compare(1, 6, "<"), LogicType::And);
+  for (uint32_t pool_size : {DEFAULT_BUFFER_POOL_SIZE, 64}) {
+    if (pool_size != DEFAULT_BUFFER_POOL_SIZE) {
+      Open(false, pool_size);
+    }
+    auto context = db_->MakeExecuteContext(nullptr);
+    auto schema = table_info_->GetSchema();
+    IndexScanPlanNode index_plan(schema, "t", grp_index_, KeyRange(predicate, grp_index_->GetIndexKeySchema()),
+                                 predicate);
+    BitmapHeapScanPlanNode bitmap_plan(schema, "t", grp_index_, KeyRange(predicate, grp_index_->GetIndexKeySchema()),
+                                       predicate);
+    SeqScanPlanNode seq_plan(schema, "t", predicate);
+    IndexScanExecutor index_executor(context.get(), &index_plan);
+    BitmapHeapScanExecutor bitmap_executor(context.get(), &bitmap_plan);
+    SeqScanExecutor seq_executor(context.get(), &seq_plan);
+    auto time = [](AbstractExecutor &executor, bool ordered) {
+      auto start = std::chrono::steady_clock::now();
+      EXPECT_EQ(6000, Run(executor, ordered));
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+    double index_time = time(index_executor, false);
+    double bitmap_time = time(bitmap_executor, true);
+    double seq_time = time(seq_executor, true);
+    std::cout << "3 <= grp < 6, " << pool_size << " page buffer pool: index scan " << index_time << " ms, bitmap heap scan "
+              << bitmap_time << " ms, seq scan " << seq_time << " ms" << std::endl;
+  }
+}
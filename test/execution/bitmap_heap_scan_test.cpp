@@ -0,0 +1,50 @@
+#include "bitmap_heap_scan_test_util.h"  // NOLINT
+
+TEST_F(BitmapHeapScanTest, ScanTest) {
+  auto context = db_->MakeExecuteContext(nullptr);
+  auto schema = table_info_->GetSchema();
+  // grp = 3：每页都有，每页只读一次
+  auto predicate = Compare(1, 3, "=");
+  BitmapHeapScanPlanNode plan(schema, "t", grp_index_, KeyRange(predicate, grp_index_->GetIndexKeySchema()),
+                              predicate);
+  ASSERT_EQ("BitmapHeapScan on t using t_grp (range)", plan.ToString());
+  BitmapHeapScanExecutor executor(context.get(), &plan);
+  ASSERT_EQ(2000, Run(executor, true));
+  size_t pages = 0;
+  page_id_t last_page_id = INVALID_PAGE_ID;
+  for (auto iter = table_info_->Begin(nullptr); iter != table_info_->End(); ++iter) {
+    if (iter->GetRowId().GetPageId() != last_page_id) {
+      last_page_id = iter->GetRowId().GetPageId();
+      pages++;
+    }
+  }
+  ASSERT_EQ(pages, executor.GetPagesRead());
+
+  // row id集合：grp = 3 and id < 5000，带过滤
+  auto conjunction = std::make_shared<LogicExpression>(predicate, Compare(0, 5000, "<"), LogicType::And);
+  BitmapHeapScanPlanNode set_plan(schema, "t", {grp_index_, id_index_}, false, conjunction);
+  BitmapHeapScanExecutor set_executor(context.get(), &set_plan);
+  ASSERT_EQ(500, Run(set_executor, true));
+  auto disjunction = std::make_shared<LogicExpression>(Compare(1, 3, "="), Compare(0, 10, "<"), LogicType::Or);
+  BitmapHeapScanPlanNode union_plan(schema, "t", {grp_index_, id_index_}, false, disjunction);
+  BitmapHeapScanExecutor union_executor(context.get(), &union_plan);
+  ASSERT_EQ(2009, Run(union_executor, true));
+
+  // 结果很少时逐行读
+  auto point = Compare(0, 77, "=");
+  BitmapHeapScanPlanNode point_plan(schema, "t", id_index_, KeyRange(point, id_index_->GetIndexKeySchema()), point);
+  BitmapHeapScanExecutor point_executor(context.get(), &point_plan);
+  ASSERT_EQ(1, Run(point_executor, true));
+  ASSERT_EQ(0, point_executor.GetPagesRead());
+
+  // 删除的行不输出
+  for (int id = 3; id < n_; id += 100) {
+    std::vector<RowId> rids;
+    std::vector<Field> key_fields{Field(kTypeInt, id)};
+    Row key(key_fields);
+    ASSERT_EQ(DB_SUCCESS, id_index_->GetIndex()->ScanKey(key, rids, nullptr, "="));
+    ASSERT_TRUE(table_info_->MarkDelete(rids[0], nullptr));
+  }
+  BitmapHeapScanExecutor after_delete(context.get(), &plan);
+  ASSERT_EQ(1800, Run(after_delete, true));
+}
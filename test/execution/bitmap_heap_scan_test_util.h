@@ -0,0 +1,82 @@
+#ifndef MINISQL_BITMAP_HEAP_SCAN_TEST_UTIL_H
+#define MINISQL_BITMAP_HEAP_SCAN_TEST_UTIL_H
+
+#include <string>
+
+#include "common/instance.h"
+#include "executor/executors/bitmap_heap_scan_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "gtest/gtest.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+
+/**
+ * Heap table t(id int unique, grp int, name char(32)) with grp = id % 10, so that the rows of one grp
+ * value are spread over every page. b+ tree indexes on id and grp.
+ */
+class BitmapHeapScanTest : public ::testing::Test {
+ public:
+  void SetUp() override { Open(true, DEFAULT_BUFFER_POOL_SIZE); }
+
+  void TearDown() override { delete db_; }
+
+  void Open(bool init, uint32_t pool_size) {
+    delete db_;
+    db_ = new DBStorageEngine("bitmap_heap_scan_test.db", init, pool_size);
+    if (!init) {
+      db_->catalog_mgr_->GetTable("t", table_info_);
+      db_->catalog_mgr_->GetIndex("t", "t_grp", grp_index_);
+      db_->catalog_mgr_->GetIndex("t", "t_id", id_index_);
+      return;
+    }
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, true),
+                                     new Column("grp", TypeId::kTypeInt, 1, true, false),
+                                     new Column("name", TypeId::kTypeChar, 32, 2, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info_));
+    for (int i = 0; i < n_; i++) {
+      std::string name = "name-" + std::to_string(i);
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeInt, i % 10),
+                                Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+      Row row(fields);
+      ASSERT_TRUE(table_info_->InsertTuple(row, nullptr));
+    }
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, id_index_, "bptree"));
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_grp", {"grp"}, nullptr, grp_index_, "bptree"));
+  }
+
+  AbstractExpressionRef Compare(uint32_t col_idx, int value, const std::string &op) {
+    return std::make_shared<ComparisonExpression>(std::make_shared<ColumnValueExpression>(0, col_idx, kTypeInt),
+                                                  std::make_shared<ConstantValueExpression>(Field(kTypeInt, value)),
+                                                  op);
+  }
+
+  /** @return Rows of the executor, their ids must be ascending if ordered */
+  static size_t Run(AbstractExecutor &executor, bool ordered) {
+    executor.Init();
+    Row row;
+    RowId rid;
+    size_t count = 0;
+    int64_t last = -1;
+    while (executor.Next(&row, &rid)) {
+      EXPECT_EQ(rid.Get(), row.GetRowId().Get());
+      if (ordered) {
+        EXPECT_LT(last, rid.Get());
+        last = rid.Get();
+      }
+      count++;
+    }
+    return count;
+  }
+
+ protected:
+  const int n_ = 20000;
+  DBStorageEngine *db_{nullptr};
+  TableInfo *table_info_{nullptr};
+  IndexInfo *id_index_{nullptr};
+  IndexInfo *grp_index_{nullptr};
+};
+
+#endif  // MINISQL_BITMAP_HEAP_SCAN_TEST_UTIL_H
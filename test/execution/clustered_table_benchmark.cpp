@@ -0,0 +1,46 @@
+#include <chrono>
+
+#include "clustered_table_test_util.h"  // NOLINT
+
+/**
+ * Primary key range scans, a heap table with a b+ tree on the primary key (range scan of the
+ * index, then a heap lookup per row) against a clustered table. Rows are inserted in random
+ * order, so the rows of a key range are spread over the heap. The scans run once with every
+ * page in the buffer pool and once after reopening with a pool much smaller than the tables.
+ */
+TEST_F(ClusteredTableTest, RangeScanBenchmark) {
+  const int n = 50000;
+  const int scans = 500;
+  const int width = 200;
+  ASSERT_EQ(DB_SUCCESS, CreateTable(db_, "h", false));
+  std::vector<int> ids(n);
+  for (int i = 0; i < n; i++) {
+    ids[i] = i;
+  }
+  ShuffleArray(ids);
+  ASSERT_EQ(n, Insert(db_, "t", ids));
+  ASSERT_EQ(n, Insert(db_, "h", ids));
+  std::vector<int> starts(scans);
+  for (int i = 0; i < scans; i++) {
+    starts[i] = RandomUtils::RandomInt(0, n - width);
+  }
+  auto run = [&](const std::string &table_name) {
+    auto start = std::chrono::steady_clock::now();
+    for (int low : starts) {
+      auto predicate = And(Compare(ColumnExpr(0), Field(kTypeInt, low), ">="),
+                           Compare(ColumnExpr(0), Field(kTypeInt, low + width), "<"));
+      EXPECT_EQ(width, RangeScan(db_, table_name, predicate).size());
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  for (uint32_t pool_size : {DEFAULT_BUFFER_POOL_SIZE, 64}) {
+    if (pool_size != DEFAULT_BUFFER_POOL_SIZE) {
+      delete db_;
+      db_ = new DBStorageEngine(db_name_, false, pool_size);
+    }
+    double heap = run("h");
+    double clustered = run("t");
+    std::cout << scans << " primary key range scans of " << width << " rows over " << n << " rows, " << pool_size
+              << " page buffer pool: heap + index " << heap << " ms, clustered " << clustered << " ms" << std::endl;
+  }
+}
@@ -0,0 +1,123 @@
+#include "clustered_table_test_util.h"  // NOLINT
+#include "expression_test_util.h"  // NOLINT
+
+TEST_F(ClusteredTableTest, CreateTest) {
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->GetTable("t", table_info));
+  ASSERT_TRUE(table_info->IsClustered());
+  ASSERT_EQ(nullptr, table_info->GetTableHeap());
+  ASSERT_NE(nullptr, table_info->GetClusteredIndex());
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->GetIndex("t", "t_PRIMARY_KEY", index_info));
+  ASSERT_EQ("clustered", index_info->GetIndexType());
+  // 记录存放在clustered index中，不能单独删除，也不能再建一个
+  ASSERT_EQ(DB_FAILED, db_->catalog_mgr_->DropIndex("t", "t_PRIMARY_KEY"));
+  ASSERT_EQ(DB_FAILED, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "clustered"));
+  // 主键必须是单个int列
+  auto create = [this](std::vector<Column *> columns) {
+    auto schema = std::make_shared<Schema>(columns);
+    TableInfo *info = nullptr;
+    return db_->catalog_mgr_->CreateTable("bad", schema.get(), nullptr, info, true);
+  };
+  ASSERT_EQ(DB_FAILED, create({new Column("a", TypeId::kTypeInt, 0, false, false),
+                               new Column("b", TypeId::kTypeInt, 1, false, false)}));
+  ASSERT_EQ(DB_FAILED, create({new Column("a", TypeId::kTypeChar, 8, 0, false, false)}));
+  ASSERT_EQ(DB_FAILED, create({new Column("a", TypeId::kTypeInt, 0, true, false)}));
+  ASSERT_EQ(DB_FAILED, create({new Column("a", TypeId::kTypeInt, 0, false, false),
+                               new Column("b", TypeId::kTypeChar, PAGE_SIZE / 4, 1, true, false)}));
+  ASSERT_EQ(DB_TABLE_NOT_EXIST, db_->catalog_mgr_->GetTable("bad", table_info));
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->DropTable("t"));
+  ASSERT_TRUE(db_->bpm_->CheckAllUnpinned());
+}
+
+TEST_F(ClusteredTableTest, ScanTest) {
+  const int n = 5000;
+  std::vector<int> ids(n);
+  for (int i = 0; i < n; i++) {
+    ids[i] = i;
+  }
+  ShuffleArray(ids);
+  ASSERT_EQ(n, Insert(db_, "t", ids));
+  ASSERT_EQ(0, Insert(db_, "t", {1234}));
+  // 顺序扫描按主键顺序返回
+  auto rows = SeqScan();
+  ASSERT_EQ(n, rows.size());
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(i, IdOf(rows[i]));
+    ASSERT_EQ(NameOf(i), rows[i].GetField(1)->toString());
+    ASSERT_EQ(ClusteredIndex::RowIdOf(i), rows[i].GetRowId());
+  }
+  // 主键范围扫描直接读叶子
+  auto range_rows = RangeScan(db_, "t", And(Compare(ColumnExpr(0), Field(kTypeInt, 100), ">="),
+                                            Compare(ColumnExpr(0), Field(kTypeInt, 300), "<")));
+  ASSERT_EQ(200, range_rows.size());
+  for (int i = 0; i < 200; i++) {
+    ASSERT_EQ(100 + i, IdOf(range_rows[i]));
+  }
+  // 二级索引指向主键
+  ASSERT_EQ(52, CheckNameIndex(7));
+  TableInfo *table_info = nullptr;
+  db_->catalog_mgr_->GetTable("t", table_info);
+  Row row(ClusteredIndex::RowIdOf(n));
+  ASSERT_FALSE(table_info->GetTuple(&row, nullptr));
+  ASSERT_TRUE(db_->bpm_->CheckAllUnpinned());
+}
+
+TEST_F(ClusteredTableTest, UpdateDeleteTest) {
+  const int n = 3000;
+  std::vector<int> ids(n);
+  for (int i = 0; i < n; i++) {
+    ids[i] = i;
+  }
+  ShuffleArray(ids);
+  ASSERT_EQ(n, Insert(db_, "t", ids));
+  // 修改非主键列，记录留在原位
+  ASSERT_EQ(100, Update(Compare(ColumnExpr(0), Field(kTypeInt, 100), "<"), 2,
+                        std::make_shared<ConstantValueExpression>(Field(kTypeFloat, -1.f))));
+  auto rows = SeqScan(Compare(ColumnExpr(2), Field(kTypeFloat, 0.f), "<"));
+  ASSERT_EQ(100, rows.size());
+  // 修改主键，每条记录移动到新的位置，只被修改一次
+  ASSERT_EQ(n, Update(nullptr, 0, std::make_shared<ShiftExpression>(10000)));
+  rows = SeqScan();
+  ASSERT_EQ(n, rows.size());
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(10000 + i, IdOf(rows[i]));
+    ASSERT_EQ(NameOf(i), rows[i].GetField(1)->toString());
+  }
+  ASSERT_EQ(31, CheckNameIndex(7));
+  // 新主键已存在时不修改
+  ASSERT_EQ(0, Update(Compare(ColumnExpr(0), Field(kTypeInt, 10001), "="), 0,
+                      std::make_shared<ConstantValueExpression>(Field(kTypeInt, 10002))));
+  ASSERT_EQ(n, SeqScan().size());
+  // 删除一半记录，叶子合并
+  ASSERT_EQ(n / 2, Delete(Compare(ColumnExpr(0), Field(kTypeInt, 10000 + n / 2), "<")));
+  rows = SeqScan();
+  ASSERT_EQ(n - n / 2, rows.size());
+  ASSERT_EQ(10000 + n / 2, IdOf(rows[0]));
+  ASSERT_EQ(15, CheckNameIndex(7));
+  ASSERT_TRUE(db_->bpm_->CheckAllUnpinned());
+}
+
+TEST_F(ClusteredTableTest, PersistTest) {
+  const int n = 2000;
+  std::vector<int> ids(n);
+  for (int i = 0; i < n; i++) {
+    ids[i] = n - 1 - i;
+  }
+  ASSERT_EQ(n, Insert(db_, "t", ids));
+  delete db_;
+  db_ = new DBStorageEngine(db_name_, false);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->GetTable("t", table_info));
+  ASSERT_TRUE(table_info->IsClustered());
+  ASSERT_NE(nullptr, table_info->GetClusteredIndex());
+  auto rows = SeqScan();
+  ASSERT_EQ(n, rows.size());
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(i, IdOf(rows[i]));
+  }
+  ASSERT_EQ(21, CheckNameIndex(7));
+  ASSERT_EQ(0, Insert(db_, "t", {42}));
+  ASSERT_EQ(1, Insert(db_, "t", {n}));
+  ASSERT_TRUE(db_->bpm_->CheckAllUnpinned());
+}
@@ -0,0 +1,169 @@
+#ifndef MINISQL_CLUSTERED_TABLE_TEST_UTIL_H
+#define MINISQL_CLUSTERED_TABLE_TEST_UTIL_H
+
+#include <string>
+
+#include "common/instance.h"
+#include "executor/executors/delete_executor.h"
+#include "executor/executors/index_scan_executor.h"
+#include "executor/executors/insert_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "executor/executors/update_executor.h"
+#include "executor/executors/values_executor.h"
+#include "gtest/gtest.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+#include "planner/key_range.h"
+#include "utils/utils.h"
+
+/**
+ * Table t(id int primary key, name char(16), account float) CLUSTERED with a secondary index on
+ * name. Rows go through the executors like the statements would.
+ */
+class ClusteredTableTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    db_ = new DBStorageEngine(db_name_, true);
+    ASSERT_EQ(DB_SUCCESS, CreateTable(db_, "t", true));
+    IndexInfo *index_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_name", {"name"}, nullptr, index_info, "bptree"));
+  }
+
+  void TearDown() override {
+    for (auto schema : schemas_) {
+      delete schema;
+    }
+    delete db_;
+  }
+
+  static dberr_t CreateTable(DBStorageEngine *db, const std::string &table_name, bool clustered) {
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                     new Column("name", TypeId::kTypeChar, 16, 1, true, false),
+                                     new Column("account", TypeId::kTypeFloat, 2, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    TableInfo *table_info = nullptr;
+    return db->catalog_mgr_->CreateTable(table_name, schema.get(), nullptr, table_info, clustered);
+  }
+
+  static std::string NameOf(int id) { return "name-" + std::to_string(id % 97); }
+
+  /** @return Rows inserted before the first rejected one */
+  static int Insert(DBStorageEngine *db, const std::string &table_name, const std::vector<int> &ids) {
+    std::vector<std::vector<AbstractExpressionRef>> values;
+    for (int id : ids) {
+      std::string name = NameOf(id);
+      values.push_back({std::make_shared<ConstantValueExpression>(Field(kTypeInt, id)),
+                        std::make_shared<ConstantValueExpression>(
+                            Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)),
+                        std::make_shared<ConstantValueExpression>(Field(kTypeFloat, static_cast<float>(id) / 2))});
+    }
+    auto values_plan = std::make_shared<ValuesPlanNode>(nullptr, values);
+    auto insert_plan = std::make_shared<InsertPlanNode>(nullptr, values_plan, table_name);
+    auto exec_ctx = db->MakeExecuteContext(nullptr);
+    InsertExecutor executor(exec_ctx.get(), insert_plan.get(),
+                            std::make_unique<ValuesExecutor>(exec_ctx.get(), values_plan.get()));
+    return static_cast<int>(Run(executor).size());
+  }
+
+  static std::vector<Row> Run(AbstractExecutor &executor) {
+    std::vector<Row> result_set;
+    executor.Init();
+    Row row;
+    RowId rid;
+    while (executor.Next(&row, &rid)) {
+      result_set.push_back(row);
+    }
+    return result_set;
+  }
+
+  static int IdOf(const Row &row) {
+    int32_t id;
+    row.GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+    return id;
+  }
+
+  AbstractExpressionRef ColumnExpr(uint32_t col_idx) {
+    TableInfo *table_info = nullptr;
+    db_->catalog_mgr_->GetTable("t", table_info);
+    return std::make_shared<ColumnValueExpression>(0, col_idx, table_info->GetSchema()->GetColumn(col_idx)->GetType());
+  }
+
+  static AbstractExpressionRef Compare(AbstractExpressionRef column, const Field &value, const std::string &op) {
+    return std::make_shared<ComparisonExpression>(column, std::make_shared<ConstantValueExpression>(value), op);
+  }
+
+  static AbstractExpressionRef And(AbstractExpressionRef lhs, AbstractExpressionRef rhs) {
+    return std::make_shared<LogicExpression>(lhs, rhs, LogicType::And);
+  }
+
+  Schema *TableSchema(DBStorageEngine *db, const std::string &table_name) {
+    TableInfo *table_info = nullptr;
+    db->catalog_mgr_->GetTable(table_name, table_info);
+    schemas_.push_back(Schema::DeepCopySchema(table_info->GetSchema()));
+    return schemas_.back();
+  }
+
+  std::vector<Row> SeqScan(AbstractExpressionRef predicate = nullptr) {
+    auto plan = std::make_shared<SeqScanPlanNode>(TableSchema(db_, "t"), "t", predicate);
+    auto exec_ctx = db_->MakeExecuteContext(nullptr);
+    SeqScanExecutor executor(exec_ctx.get(), plan.get());
+    return Run(executor);
+  }
+
+  std::vector<Row> RangeScan(DBStorageEngine *db, const std::string &table_name, AbstractExpressionRef predicate) {
+    IndexInfo *index_info = nullptr;
+    db->catalog_mgr_->GetIndex(table_name, table_name + "_PRIMARY_KEY", index_info);
+    KeyRange range(predicate, index_info->GetIndexKeySchema());
+    auto plan = std::make_shared<IndexScanPlanNode>(TableSchema(db, table_name), table_name, index_info,
+                                                    std::move(range), predicate);
+    auto exec_ctx = db->MakeExecuteContext(nullptr);
+    IndexScanExecutor executor(exec_ctx.get(), plan.get());
+    return Run(executor);
+  }
+
+  int Update(AbstractExpressionRef predicate, uint32_t column, AbstractExpressionRef value) {
+    auto scan_plan = std::make_shared<SeqScanPlanNode>(TableSchema(db_, "t"), "t", predicate);
+    auto update_plan = std::make_shared<UpdatePlanNode>(TableSchema(db_, "t"), scan_plan, "t",
+                                                        std::unordered_map<uint32_t, AbstractExpressionRef>{{column, value}});
+    auto exec_ctx = db_->MakeExecuteContext(nullptr);
+    UpdateExecutor executor(exec_ctx.get(), update_plan.get(),
+                            std::make_unique<SeqScanExecutor>(exec_ctx.get(), scan_plan.get()));
+    return static_cast<int>(Run(executor).size());
+  }
+
+  int Delete(AbstractExpressionRef predicate) {
+    auto scan_plan = std::make_shared<SeqScanPlanNode>(TableSchema(db_, "t"), "t", predicate);
+    auto delete_plan = std::make_shared<DeletePlanNode>(TableSchema(db_, "t"), scan_plan, "t");
+    auto exec_ctx = db_->MakeExecuteContext(nullptr);
+    DeleteExecutor executor(exec_ctx.get(), delete_plan.get(),
+                            std::make_unique<SeqScanExecutor>(exec_ctx.get(), scan_plan.get()));
+    return static_cast<int>(Run(executor).size());
+  }
+
+  /** Row ids of name in the secondary index, each one must lead to a row with that name. */
+  size_t CheckNameIndex(int id) {
+    IndexInfo *index_info = nullptr;
+    db_->catalog_mgr_->GetIndex("t", "t_name", index_info);
+    TableInfo *table_info = nullptr;
+    db_->catalog_mgr_->GetTable("t", table_info);
+    std::string name = NameOf(id);
+    std::vector<Field> fields{Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+    std::vector<RowId> rids;
+    index_info->GetIndex()->ScanKey(Row(fields), rids, nullptr, "=");
+    for (auto rid : rids) {
+      Row row(rid);
+      EXPECT_TRUE(table_info->GetTuple(&row, nullptr));
+      EXPECT_EQ(name, row.GetField(1)->toString());
+    }
+    return rids.size();
+  }
+
+ protected:
+  const std::string db_name_ = "clustered_table_test.db";
+  DBStorageEngine *db_{nullptr};
+  std::vector<Schema *> schemas_;
+};
+
+#endif  // MINISQL_CLUSTERED_TABLE_TEST_UTIL_H
@@ -0,0 +1,24 @@
+#ifndef MINISQL_EXPRESSION_TEST_UTIL_H
+#define MINISQL_EXPRESSION_TEST_UTIL_H
+
+#include "planner/expressions/abstract_expression.h"
+
+/** id + delta, where id is the first column of an int row. Moves the rows of an update to new keys. */
+class ShiftExpression : public AbstractExpression {
+ public:
+  explicit ShiftExpression(int delta)
+      : AbstractExpression({}, kTypeInt, ExpressionType::ConstantExpression), delta_(delta) {}
+
+  Field Evaluate(const Row *row) const override {
+    int32_t id;
+    row->GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+    return Field(kTypeInt, id + delta_);
+  }
+
+  Field EvaluateJoin(const Row *left_row, const Row *) const override { return Evaluate(left_row); }
+
+ private:
+  int delta_;
+};
+
+#endif  // MINISQL_EXPRESSION_TEST_UTIL_H
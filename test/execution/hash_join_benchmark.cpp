@@ -0,0 +1,78 @@
+#include <chrono>
+
+#include "hash_join_test_util.h"  // NOLINT
+
+/**
+ * Source of (key int, payload int) rows in chunks built beforehand: row i has key (i * 7919) %
+ * key_range, so the join measures the hash table and not the scan.
+ */
+class GeneratedRowsExecutor : public AbstractExecutor {
+ public:
+  GeneratedRowsExecutor(ExecuteContext *exec_ctx, const Schema *schema, size_t rows, int32_t key_range)
+      : AbstractExecutor(exec_ctx), schema_(schema) {
+    for (size_t i = 0; i < rows; i++) {
+      if (i % DataChunk::CAPACITY == 0) {
+        chunks_.emplace_back();
+        chunks_.back().Reset(schema_);
+      }
+      std::vector<Field> fields{Field(kTypeInt, static_cast<int32_t>(i * 7919 % key_range)),
+                                Field(kTypeInt, static_cast<int32_t>(i))};
+      chunks_.back().AppendRow(Row(fields), RowId());
+    }
+  }
+
+  void Init() override { next_ = 0; }
+
+  bool Next(Row *, RowId *) override { return false; }
+
+  bool NextBatch(DataChunk *chunk) override {
+    if (next_ >= chunks_.size()) {
+      return false;
+    }
+    *chunk = chunks_[next_++];
+    return true;
+  }
+
+  const Schema *GetOutputSchema() const override { return schema_; }
+
+ private:
+  const Schema *schema_;
+  std::vector<DataChunk> chunks_;
+  size_t next_{0};
+};
+
+/**
+ * Equi-join of 100000 rows with unique keys and 1000000 rows whose keys hit half of them, in memory
+ * and partitioned to temporary pages.
+ */
+TEST_F(HashJoinTest, JoinBenchmark) {
+  const size_t build_rows = 100000;
+  const size_t probe_rows = 1000000;
+  Schema schema({new Column("key", TypeId::kTypeInt, 0, false, false),
+                 new Column("payload", TypeId::kTypeInt, 1, false, false)});
+  Schema output({new Column("payload", TypeId::kTypeInt, 0, false, false),
+                 new Column("payload", TypeId::kTypeInt, 1, false, false)});
+  HashJoinPlanNode plan(&output, nullptr, nullptr, {0}, {0}, nullptr, {{0, 1}, {1, 1}});
+  auto context = db_->MakeExecuteContext(nullptr);
+  for (size_t work_memory : {ExecuteContext::DEFAULT_WORK_MEMORY, static_cast<size_t>(1 << 20)}) {
+    context->SetWorkMemory(work_memory);
+    auto start = std::chrono::steady_clock::now();
+    HashJoinExecutor executor(context.get(), &plan,
+                              std::make_unique<GeneratedRowsExecutor>(context.get(), &schema, build_rows, build_rows),
+                              std::make_unique<GeneratedRowsExecutor>(context.get(), &schema, probe_rows, 2 * build_rows));
+    double generate_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    executor.Init();
+    DataChunk chunk;
+    size_t count = 0;
+    while (executor.NextBatch(&chunk)) {
+      count += chunk.GetSelectedCount();
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_EQ(probe_rows / 2, count);
+    ASSERT_EQ(work_memory != ExecuteContext::DEFAULT_WORK_MEMORY, executor.IsSpilled());
+    std::cout << build_rows << " x " << probe_rows << " rows" << (executor.IsSpilled() ? " spilled" : " in memory")
+              << ": " << ms << " ms (" << generate_ms << " ms to generate the input)" << std::endl;
+  }
+  ASSERT_TRUE(db_->bpm_->CheckAllUnpinned());
+}
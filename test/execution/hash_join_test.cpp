@@ -0,0 +1,128 @@
+#include "hash_join_test_util.h"  // NOLINT
+
+/**
+ * Joins of two and three tables, with FROM lists and JOIN ... ON, equal to a nested loop, in memory
+ * and with the work memory too small for either input.
+ */
+TEST_F(HashJoinTest, JoinTest) {
+  using Current = const std::vector<const std::vector<Field> *> &;
+  auto concat = [](Current rows) {
+    std::vector<const Field *> fields;
+    for (auto row : rows) {
+      for (const auto &field : *row) {
+        fields.push_back(&field);
+      }
+    }
+    return fields;
+  };
+  struct Query {
+    std::string sql;
+    std::vector<const Rows *> tables;
+    std::function<bool(Current)> match;
+    std::function<std::vector<const Field *>(Current)> project;
+    /** Whether both inputs of the top join exceed the small work memory */
+    bool spills;
+  };
+  std::vector<Query> queries{
+      {"select * from a, b where a.k = b.k;",
+       {&a_, &b_},
+       [](Current r) { return Equal((*r[0])[1], (*r[1])[1]); },
+       concat, true},
+      {"select b.v, a.id from a join b on a.k = b.k where b.v > 10 and a.f < 3;",
+       {&a_, &b_},
+       [](Current r) {
+         return Equal((*r[0])[1], (*r[1])[1]) && (*r[1])[3].GetInteger() > 10 && (*r[0])[3].GetFloat() < 3;
+       },
+       [](Current r) { return std::vector<const Field *>{&(*r[1])[3], &(*r[0])[0]}; }, true},
+      // 两个key，加上不是等值的条件
+      {"select a.id, b.id from b, a where a.k = b.k and b.s = a.s and a.id < b.id;",
+       {&b_, &a_},
+       [](Current r) {
+         return Equal((*r[1])[1], (*r[0])[1]) && Equal((*r[0])[2], (*r[1])[2]) &&
+                (*r[1])[0].GetInteger() < (*r[0])[0].GetInteger();
+       },
+       [](Current r) { return std::vector<const Field *>{&(*r[1])[0], &(*r[0])[0]}; }, true},
+      {"select a.id, b.id, name from a, b, c where a.k = b.k and b.v = c.k and c.k < 20;",
+       {&a_, &b_, &c_},
+       [](Current r) {
+         return Equal((*r[0])[1], (*r[1])[1]) && Equal((*r[1])[3], (*r[2])[0]) && (*r[2])[0].GetInteger() < 20;
+       },
+       [](Current r) { return std::vector<const Field *>{&(*r[0])[0], &(*r[1])[0], &(*r[2])[1]}; }, false},
+      {"select * from a join c on a.k = c.k join b on b.v = c.k and a.id < 300;",
+       {&a_, &c_, &b_},
+       [](Current r) {
+         return Equal((*r[0])[1], (*r[1])[0]) && Equal((*r[2])[3], (*r[1])[0]) && (*r[0])[0].GetInteger() < 300;
+       },
+       concat, false},
+      // 没有等值条件
+      {"select a.id, c.k from a, c where a.id < 10 and c.k < 3;",
+       {&a_, &c_},
+       [](Current r) { return (*r[0])[0].GetInteger() < 10 && (*r[1])[0].GetInteger() < 3; },
+       [](Current r) { return std::vector<const Field *>{&(*r[0])[0], &(*r[1])[0]}; }, false},
+      {"select a.id, name from a, c where a.id = c.k or a.k = c.k;",
+       {&a_, &c_},
+       [](Current r) { return Equal((*r[0])[0], (*r[1])[0]) || Equal((*r[0])[1], (*r[1])[0]); },
+       [](Current r) { return std::vector<const Field *>{&(*r[0])[0], &(*r[1])[1]}; }, false},
+      {"select v, name from b, c where b.k < c.k and b.id < 100;",
+       {&b_, &c_},
+       [](Current r) {
+         return !(*r[0])[1].IsNull() && (*r[0])[1].GetInteger() < (*r[1])[0].GetInteger() && (*r[0])[0].GetInteger() < 100;
+       },
+       [](Current r) { return std::vector<const Field *>{&(*r[0])[3], &(*r[1])[1]}; }, false},
+      {"select * from a, b where a.k = b.k and a.id = 5000;", {&a_, &b_}, [](Current) { return false; }, concat, false},
+  };
+  for (const auto &query : queries) {
+    auto plan = Plan(query.sql);
+    ASSERT_EQ(PlanType::HashJoin, plan->GetType()) << query.sql;
+    auto expected = NestedLoop(query.tables, query.match, query.project);
+    bool spilled = true;
+    ASSERT_EQ(expected, Run(plan, ExecuteContext::DEFAULT_WORK_MEMORY, &spilled)) << query.sql;
+    ASSERT_FALSE(spilled);
+    auto rows = Run(plan, 16 << 10, &spilled);
+    ASSERT_EQ(expected, rows) << query.sql;
+    ASSERT_EQ(query.spills, spilled) << query.sql;
+  }
+}
+
+/** Names of the columns, the build side and the errors of binding */
+TEST_F(HashJoinTest, PlanTest) {
+  auto plan = Plan("select a.id, v from a, b where a.k = b.k and b.s = a.s and a.f > 1;");
+  ASSERT_EQ("HashJoin on a.k = b.k and a.s = b.s", plan->ToString());
+  ASSERT_EQ("a.id", plan->OutputSchema()->GetColumn(0)->GetName());
+  ASSERT_EQ("v", plan->OutputSchema()->GetColumn(1)->GetName());
+  ASSERT_EQ("SeqScan on a with filter", plan->GetChildAt(0)->ToString());
+  ASSERT_EQ("SeqScan on b", plan->GetChildAt(1)->ToString());
+  plan = Plan("select * from a, b where a.id < b.id;");
+  ASSERT_EQ("HashJoin without keys with filter", plan->ToString());
+  ASSERT_EQ("b.v", plan->OutputSchema()->GetColumn(7)->GetName());
+  // 单表查询也可以写表名
+  plan = Plan("select a.id from a where a.k = 3;");
+  ASSERT_EQ(PlanType::SeqScan, plan->GetType());
+  auto expected = NestedLoop(
+      {&a_}, [](const std::vector<const std::vector<Field> *> &r) { return Equal((*r[0])[1], Field(kTypeInt, 3)); },
+      [](const std::vector<const std::vector<Field> *> &r) { return std::vector<const Field *>{&(*r[0])[0]}; });
+  ASSERT_EQ(expected, Run(plan, ExecuteContext::DEFAULT_WORK_MEMORY));
+
+  // 小的一边做build
+  for (const auto &sql : {"select * from a, b where a.k = b.k;", "select * from b, a where a.k = b.k;"}) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    plan = Plan(sql);
+    auto executor = ExecuteEngine::CreateExecutor(context.get(), plan);
+    executor->Init();
+    auto hash_join = dynamic_cast<HashJoinExecutor *>(executor.get());
+    ASSERT_EQ(std::string(sql).find("from a") != std::string::npos ? 0 : 1, hash_join->GetBuildSide()) << sql;
+  }
+
+  ExpectPlanError("select * from a, b where k = 3;");
+  ExpectPlanError("select id from a, b;");
+  ExpectPlanError("select * from a, d where a.k = d.k;");
+  ExpectPlanError("select * from a, a where a.k = a.k;");
+  ExpectPlanError("select * from a, b where c.k = b.k;");
+  ExpectPlanError("select * from a, b where a.k = a.id;");
+  ExpectPlanError("select * from a, b where a.k = b.s;");
+  ExpectPlanError("select * from a where a.k = id;");
+  ExpectPlanError("select b.id from a where k = 3;");
+
+  ASSERT_EQ(kNodeSelect, ParseType("select * from a, b where a.k = b.k;"));
+  ExpectParseError("select * from a left b on a.k = b.k;");
+}
@@ -0,0 +1,141 @@
+#ifndef MINISQL_HASH_JOIN_TEST_UTIL_H
+#define MINISQL_HASH_JOIN_TEST_UTIL_H
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "executor/execute_engine.h"
+#include "executor/executors/hash_join_executor.h"
+#include "sql_test_util.h"  // NOLINT
+
+/**
+ * Heap tables a(id int, k int, s char(8), f float) with 600 rows, b(id int, k int,
+ * s char(8), v int) with 2000 rows and c(k int, name char(16)) with 40 rows:
+ * a.k = i % 100, null every 13th row, a.s = "s" + i % 7, a.f = i % 5; b.k = j % 150, null every
+ * 17th row, b.s = "s" + j % 5, b.v = j % 40; c.k = i, c.name = "c-" + i.
+ */
+class HashJoinTest : public SqlTest {
+ public:
+  using Rows = std::vector<std::vector<Field>>;
+
+  void SetUp() override {
+    db_ = new DBStorageEngine("hash_join_test.db", true);
+    CreateTable("a", {new Column("id", TypeId::kTypeInt, 0, true, false), new Column("k", TypeId::kTypeInt, 1, true, false),
+                      new Column("s", TypeId::kTypeChar, 8, 2, true, false),
+                      new Column("f", TypeId::kTypeFloat, 3, true, false)});
+    for (int i = 0; i < 600; i++) {
+      std::string s = "s" + std::to_string(i % 7);
+      a_.push_back({Field(kTypeInt, i), i % 13 == 0 ? Field(kTypeInt) : Field(kTypeInt, i % 100),
+                    Field(kTypeChar, const_cast<char *>(s.c_str()), s.size(), true),
+                    Field(kTypeFloat, static_cast<float>(i % 5))});
+    }
+    CreateTable("b", {new Column("id", TypeId::kTypeInt, 0, true, false), new Column("k", TypeId::kTypeInt, 1, true, false),
+                      new Column("s", TypeId::kTypeChar, 8, 2, true, false),
+                      new Column("v", TypeId::kTypeInt, 3, true, false)});
+    for (int j = 0; j < 2000; j++) {
+      std::string s = "s" + std::to_string(j % 5);
+      b_.push_back({Field(kTypeInt, j), j % 17 == 0 ? Field(kTypeInt) : Field(kTypeInt, j % 150),
+                    Field(kTypeChar, const_cast<char *>(s.c_str()), s.size(), true), Field(kTypeInt, j % 40)});
+    }
+    CreateTable("c", {new Column("k", TypeId::kTypeInt, 0, true, false),
+                      new Column("name", TypeId::kTypeChar, 16, 1, true, false)});
+    for (int i = 0; i < 40; i++) {
+      std::string name = "c-" + std::to_string(i);
+      c_.push_back({Field(kTypeInt, i), Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)});
+    }
+    Insert("a", a_);
+    Insert("b", b_);
+    Insert("c", c_);
+  }
+
+  void CreateTable(const std::string &name, const std::vector<Column *> &columns) {
+    auto schema = std::make_shared<Schema>(columns);
+    TableInfo *table_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable(name, schema.get(), nullptr, table_info));
+  }
+
+  void Insert(const std::string &name, Rows &rows) {
+    TableInfo *table_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->GetTable(name, table_info));
+    for (auto &fields : rows) {
+      Row row(fields);
+      ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+    }
+  }
+
+  /**
+   * @param work_memory Work memory of the executors
+   * @param[out] spilled Whether the top join spilled
+   * @return The rows of plan as text, sorted
+   */
+  std::vector<std::string> Run(const AbstractPlanNodeRef &plan, size_t work_memory, bool *spilled = nullptr) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    context->SetWorkMemory(work_memory);
+    auto executor = ExecuteEngine::CreateExecutor(context.get(), plan);
+    executor->Init();
+    std::vector<std::string> result;
+    DataChunk chunk;
+    Row row;
+    while (executor->NextBatch(&chunk)) {
+      EXPECT_GT(chunk.GetSelectedCount(), 0);
+      EXPECT_LE(chunk.GetSelectedCount(), DataChunk::CAPACITY);
+      for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+        chunk.GetRow(i, &row);
+        result.push_back(ToString(row.GetFields()));
+      }
+    }
+    if (spilled != nullptr) {
+      *spilled = dynamic_cast<HashJoinExecutor *>(executor.get())->IsSpilled();
+    }
+    std::sort(result.begin(), result.end());
+    EXPECT_TRUE(db_->bpm_->CheckAllUnpinned());
+    return result;
+  }
+
+  template <typename T>
+  static std::string ToString(const std::vector<T> &fields) {
+    std::string text;
+    for (const auto &field : fields) {
+      text += "|" + Ref(field).toString();
+    }
+    return text;
+  }
+
+  static const Field &Ref(const Field &field) { return field; }
+  static const Field &Ref(const Field *field) { return *field; }
+
+  /** @return Whether both fields are not null and equal, as a join on them decides */
+  static bool Equal(const Field &lhs, const Field &rhs) { return lhs.CompareEquals(rhs) == CmpBool::kTrue; }
+
+  /** @return The projected rows of a nested loop over the rows of tables that match */
+  static std::vector<std::string> NestedLoop(
+      const std::vector<const Rows *> &tables,
+      const std::function<bool(const std::vector<const std::vector<Field> *> &)> &match,
+      const std::function<std::vector<const Field *>(const std::vector<const std::vector<Field> *> &)> &project) {
+    std::vector<std::string> result;
+    std::vector<const std::vector<Field> *> current(tables.size());
+    std::function<void(size_t)> loop = [&](size_t depth) {
+      if (depth == tables.size()) {
+        if (match(current)) {
+          result.push_back(ToString(project(current)));
+        }
+        return;
+      }
+      for (const auto &row : *tables[depth]) {
+        current[depth] = &row;
+        loop(depth + 1);
+      }
+    };
+    loop(0);
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+ protected:
+  Rows a_;
+  Rows b_;
+  Rows c_;
+};
+
+#endif  // MINISQL_HASH_JOIN_TEST_UTIL_H
@@ -0,0 +1,145 @@
+#include <functional>
+#include <string>
+
+#include "executor/executors/delete_executor.h"
+#include "executor/executors/index_scan_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "executor/executors/update_executor.h"
+#include "expression_test_util.h"  // NOLINT
+#include "sql_test_util.h"  // NOLINT
+
+/**
+ * Table t(id int unique, grp int, val int) with 2000 rows, grp = id % 10 and val = id % 1000, with b+
+ * tree indexes on id and val. DELETE and UPDATE plans are run by their executors directly.
+ */
+class IndexDmlTest : public SqlTest {
+ public:
+  void SetUp() override { db_ = new DBStorageEngine("index_dml_test.db", true); }
+
+  void CreateTable(bool clustered) {
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, true),
+                                     new Column("grp", TypeId::kTypeInt, 1, true, false),
+                                     new Column("val", TypeId::kTypeInt, 2, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    TableInfo *table_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info, clustered));
+    for (int i = 0; i < n_; i++) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeInt, i % 10),
+                                Field(TypeId::kTypeInt, i % 1000)};
+      Row row(fields);
+      ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+    }
+    IndexInfo *index_info = nullptr;
+    if (!clustered) {
+      ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+    }
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_val", {"val"}, nullptr, index_info, "bptree"));
+  }
+
+  std::unique_ptr<AbstractExecutor> MakeScan(ExecuteContext *context, const AbstractPlanNodeRef &plan) {
+    if (plan->GetType() == PlanType::SeqScan) {
+      return std::make_unique<SeqScanExecutor>(context, dynamic_cast<const SeqScanPlanNode *>(plan.get()));
+    }
+    return std::make_unique<IndexScanExecutor>(context, dynamic_cast<const IndexScanPlanNode *>(plan.get()));
+  }
+
+  /** @return Rows produced by a delete, an update or a scan plan */
+  size_t Run(const AbstractPlanNodeRef &plan) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    std::unique_ptr<AbstractExecutor> executor;
+    if (plan->GetType() == PlanType::Delete) {
+      auto delete_plan = dynamic_cast<const DeletePlanNode *>(plan.get());
+      executor = std::make_unique<DeleteExecutor>(context.get(), delete_plan,
+                                                  MakeScan(context.get(), delete_plan->GetChildPlan()));
+    } else if (plan->GetType() == PlanType::Update) {
+      auto update_plan = dynamic_cast<const UpdatePlanNode *>(plan.get());
+      executor = std::make_unique<UpdateExecutor>(context.get(), update_plan,
+                                                  MakeScan(context.get(), update_plan->GetChildPlan()));
+    } else {
+      executor = MakeScan(context.get(), plan);
+    }
+    executor->Init();
+    Row row;
+    RowId rid;
+    size_t count = 0;
+    while (executor->Next(&row, &rid)) {
+      count++;
+    }
+    return count;
+  }
+
+  /** @return Rows matching a predicate, by a sequential scan and through the plan the planner picks */
+  size_t Count(const std::string &where) {
+    size_t through_plan = Run(Plan("select * from t where " + where + ";"));
+    auto plan = Plan("select * from t where " + where + ";");
+    std::string table = "t";
+    auto predicate = plan->GetType() == PlanType::SeqScan
+                         ? dynamic_cast<const SeqScanPlanNode *>(plan.get())->GetPredicate()
+                         : dynamic_cast<const IndexScanPlanNode *>(plan.get())->GetPredicate();
+    size_t by_seq_scan = Run(std::make_shared<SeqScanPlanNode>(plan->OutputSchema(), table, predicate));
+    EXPECT_EQ(by_seq_scan, through_plan) << where;
+    return by_seq_scan;
+  }
+
+ protected:
+  const int n_ = 2000;
+};
+
+TEST_F(IndexDmlTest, PlanTest) {
+  CreateTable(false);
+  auto plan = Plan("delete from t where id = 5;");
+  ASSERT_EQ(PlanType::Delete, plan->GetType());
+  ASSERT_EQ("IndexScan on t using t_id (range)", plan->GetChildAt(0)->ToString());
+  plan = Plan("update t set grp = 1 where val = 7 and grp = 7;");
+  ASSERT_EQ(PlanType::Update, plan->GetType());
+  ASSERT_EQ(PlanType::IndexScan, plan->GetChildAt(0)->GetType());
+  ASSERT_EQ(PlanType::SeqScan, Plan("delete from t where grp = 3;")->GetChildAt(0)->GetType());
+  ASSERT_EQ(PlanType::SeqScan, Plan("delete from t;")->GetChildAt(0)->GetType());
+  // 覆盖索引的只读扫描拿不到整行，删除和更新不用
+  ASSERT_EQ(PlanType::IndexScan, Plan("delete from t where id < 10;")->GetChildAt(0)->GetType());
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  ASSERT_EQ(PlanType::IndexScan, Plan("delete from t where id = 5;")->GetChildAt(0)->GetType());
+  ASSERT_EQ(PlanType::SeqScan, Plan("delete from t where id > 5;")->GetChildAt(0)->GetType());
+}
+
+TEST_F(IndexDmlTest, DeleteTest) {
+  for (bool clustered : {false, true}) {
+    CreateTable(clustered);
+    ASSERT_EQ(1, Run(Plan("delete from t where id = 5;")));
+    ASSERT_EQ(0, Run(Plan("delete from t where id = 5;")));
+    ASSERT_EQ(995, Run(Plan("delete from t where id >= 1005;")));
+    ASSERT_EQ(2, Run(Plan("delete from t where val = 7 or val = 8;")));
+    ASSERT_EQ(1002, Count("id >= 0"));
+    ASSERT_EQ(0, Count("val = 5"));
+    ASSERT_EQ(1, Count("val = 6"));
+    ASSERT_EQ(0, Count("id = 1005"));
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->DropTable("t"));
+  }
+}
+
+/**
+ * The updates change the column of the index they are found with and move the rows further along
+ * it. Every row is updated exactly once and the indexes follow.
+ */
+TEST_F(IndexDmlTest, HalloweenTest) {
+  for (bool clustered : {false, true}) {
+    CreateTable(clustered);
+    auto plan = Plan("update t set val = 900 where val > 100;");
+    ASSERT_EQ(PlanType::IndexScan, plan->GetChildAt(0)->GetType());
+    ASSERT_EQ(1798, Run(plan));
+    ASSERT_EQ(1798, Count("val = 900"));
+    ASSERT_EQ(0, Count("val > 100 and val < 900"));
+    // id += 10000，每行在id索引上都移到还没扫描的位置之后
+    auto shift_plan = Plan("update t set id = 0 where id >= 1000;");
+    ASSERT_EQ(PlanType::IndexScan, shift_plan->GetChildAt(0)->GetType());
+    auto update = dynamic_cast<const UpdatePlanNode *>(shift_plan.get());
+    auto shift = std::make_shared<UpdatePlanNode>(update->OutputSchema(), update->GetChildPlan(), "t",
+                                                  std::unordered_map<uint32_t, AbstractExpressionRef>{
+                                                      {0, std::make_shared<ShiftExpression>(10000)}});
+    ASSERT_EQ(1000, Run(shift));
+    ASSERT_EQ(1000, Count("id >= 11000"));
+    ASSERT_EQ(0, Count("id >= 1000 and id < 11000"));
+    ASSERT_EQ(n_, Count("grp >= 0"));
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->DropTable("t"));
+  }
+}
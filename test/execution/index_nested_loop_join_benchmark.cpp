@@ -0,0 +1,27 @@
+#include <chrono>
+
+#include "index_nested_loop_join_test_util.h"  // NOLINT
+
+/** Index lookups of a few outer rows against a hash join reading the whole inner table */
+TEST_F(IndexNestedLoopJoinTest, JoinBenchmark) {
+  const std::string sql = "select c.name, o.id, amount from c, o where c.id = o.cust and c.id < 50;";
+  auto hash_plan = Plan(sql);
+  ASSERT_EQ(PlanType::HashJoin, hash_plan->GetType());
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("c", nullptr));
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("o", nullptr));
+  auto index_plan = Plan(sql);
+  ASSERT_EQ(PlanType::IndexNestedLoopJoin, index_plan->GetType());
+  std::vector<std::string> results[2];
+  double ms[2];
+  const int rounds = 5;
+  for (int k = 0; k < 2; k++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+      results[k] = Sorted(Run(k == 0 ? hash_plan : index_plan));
+    }
+    ms[k] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+  }
+  ASSERT_EQ(results[0], results[1]);
+  std::cout << results[1].size() << " rows, hash join: " << ms[0] << " ms, index nested-loop join: " << ms[1] << " ms"
+            << std::endl;
+}
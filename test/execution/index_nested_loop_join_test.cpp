@@ -0,0 +1,57 @@
+#include "index_nested_loop_join_test_util.h"  // NOLINT
+
+/**
+ * After ANALYZE a small outer input probes the index of the inner table and gives the rows of the
+ * hash join, in the order of the outer rows; a large outer input is still hashed.
+ */
+TEST_F(IndexNestedLoopJoinTest, JoinTest) {
+  std::vector<std::string> queries{
+      "select c.name, o.id, amount from c, o where c.id = o.cust and c.region = 3;",
+      "select c.id, o.id from c join o on o.cust = c.id and o.amount < 30 where c.region = 5;",
+      // 索引只覆盖一个key，另一个key和其余条件在join时检查
+      "select c.id, o.id, kind from c, o where c.id = o.cust and c.region = o.kind and c.id < 400 and o.id > c.id;",
+      "select o.id, c.name from o, c where o.cust = c.id and o.id < 20;",
+      "select * from c, o where c.id = o.cust and c.region = 11;",
+  };
+  std::vector<std::vector<std::string>> expected;
+  for (const auto &sql : queries) {
+    auto plan = Plan(sql);
+    ASSERT_EQ(PlanType::HashJoin, plan->GetType()) << sql;
+    ASSERT_LT(plan->GetEstimatedRows(), 0);
+    expected.push_back(Sorted(Run(plan)));
+  }
+  ASSERT_FALSE(expected[0].empty());
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("c", nullptr));
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("o", nullptr));
+  for (size_t i = 0; i < queries.size(); i++) {
+    auto plan = Plan(queries[i]);
+    ASSERT_EQ(PlanType::IndexNestedLoopJoin, plan->GetType()) << queries[i];
+    ASSERT_GE(plan->GetEstimatedRows(), 0);
+    std::unique_ptr<AbstractExecutor> executor;
+    auto rows = Run(plan, &executor);
+    ASSERT_EQ(expected[i], Sorted(rows)) << queries[i];
+    // 按outer行的顺序输出
+    if (i == 0) {
+      ASSERT_EQ("IndexNestedLoopJoin on c.id = o.cust using o_cust", plan->ToString());
+      ASSERT_TRUE(std::is_sorted(rows.begin(), rows.end(), [](const std::string &lhs, const std::string &rhs) {
+        return std::stoi(lhs.substr(lhs.find('-') + 1)) < std::stoi(rhs.substr(rhs.find('-') + 1));
+      }));
+      auto index_join = dynamic_cast<IndexNestedLoopJoinExecutor *>(executor.get());
+      ASSERT_EQ(customer_count_ / 10, index_join->GetLookupCount());
+      // 同一个chunk的行每页只读一次
+      ASSERT_LT(index_join->GetPagesRead(), rows.size() / 4);
+    }
+    if (i == 3) {
+      ASSERT_EQ("IndexNestedLoopJoin on o.cust = c.id using c_id", plan->ToString());
+    }
+  }
+
+  auto plan = Plan("select c.name, o.id from o, c where o.cust = c.id;");
+  ASSERT_EQ(PlanType::HashJoin, plan->GetType());
+  ASSERT_EQ(order_count_ - (order_count_ + 96) / 97, Run(plan).size());
+  plan = Plan("select c.name, o.id from c, o where c.id = o.cust;");
+  ASSERT_EQ(PlanType::HashJoin, plan->GetType());
+  // 没有等值条件时只能hash join
+  plan = Plan("select c.name, o.id from c, o where c.id < o.cust and c.id = 3;");
+  ASSERT_EQ(PlanType::HashJoin, plan->GetType());
+}
@@ -0,0 +1,89 @@
+#ifndef MINISQL_INDEX_NESTED_LOOP_JOIN_TEST_UTIL_H
+#define MINISQL_INDEX_NESTED_LOOP_JOIN_TEST_UTIL_H
+
+#include <algorithm>
+#include <string>
+
+#include "executor/execute_engine.h"
+#include "executor/executors/hash_join_executor.h"
+#include "executor/executors/index_nested_loop_join_executor.h"
+#include "sql_test_util.h"  // NOLINT
+
+/**
+ * Heap tables c(id int, region int, name char(16)) with 2000 customers, region = id % 10, and
+ * o(id int, cust int, kind int, amount float) with 20000 orders, cust = id % 2000 (null every 97th
+ * order), kind = id % 7 and amount = id % 100. B+ tree indexes on c.id and on o.cust.
+ */
+class IndexNestedLoopJoinTest : public SqlTest {
+ public:
+  void SetUp() override {
+    db_ = new DBStorageEngine("index_nested_loop_join_test.db", true);
+    std::vector<Column *> customer_columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                              new Column("region", TypeId::kTypeInt, 1, true, false),
+                                              new Column("name", TypeId::kTypeChar, 16, 2, true, false)};
+    auto customer_schema = std::make_shared<Schema>(customer_columns);
+    TableInfo *customers = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("c", customer_schema.get(), nullptr, customers));
+    for (int i = 0; i < customer_count_; i++) {
+      std::string name = "cust-" + std::to_string(i);
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeInt, i % 10),
+                                Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+      Row row(fields);
+      ASSERT_TRUE(customers->InsertTuple(row, nullptr));
+    }
+    std::vector<Column *> order_columns = {
+        new Column("id", TypeId::kTypeInt, 0, true, false), new Column("cust", TypeId::kTypeInt, 1, true, false),
+        new Column("kind", TypeId::kTypeInt, 2, true, false), new Column("amount", TypeId::kTypeFloat, 3, true, false)};
+    auto order_schema = std::make_shared<Schema>(order_columns);
+    TableInfo *orders = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("o", order_schema.get(), nullptr, orders));
+    for (int i = 0; i < order_count_; i++) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i),
+                                i % 97 == 0 ? Field(TypeId::kTypeInt) : Field(TypeId::kTypeInt, i % customer_count_),
+                                Field(TypeId::kTypeInt, i % 7), Field(TypeId::kTypeFloat, static_cast<float>(i % 100))};
+      Row row(fields);
+      ASSERT_TRUE(orders->InsertTuple(row, nullptr));
+    }
+    IndexInfo *index_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("c", "c_id", {"id"}, nullptr, index_info, "bptree"));
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("o", "o_cust", {"cust"}, nullptr, index_info, "bptree"));
+  }
+
+  /** @return The rows of plan as text in their order, and the top executor through executor */
+  std::vector<std::string> Run(const AbstractPlanNodeRef &plan, std::unique_ptr<AbstractExecutor> *executor = nullptr) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    auto root = ExecuteEngine::CreateExecutor(context.get(), plan);
+    root->Init();
+    std::vector<std::string> result;
+    DataChunk chunk;
+    Row row;
+    while (root->NextBatch(&chunk)) {
+      EXPECT_GT(chunk.GetSelectedCount(), 0);
+      EXPECT_LE(chunk.GetSelectedCount(), DataChunk::CAPACITY);
+      for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+        chunk.GetRow(i, &row);
+        std::string text;
+        for (auto field : row.GetFields()) {
+          text += "|" + field->toString();
+        }
+        result.push_back(text);
+      }
+    }
+    EXPECT_TRUE(db_->bpm_->CheckAllUnpinned());
+    if (executor != nullptr) {
+      *executor = std::move(root);
+    }
+    return result;
+  }
+
+  static std::vector<std::string> Sorted(std::vector<std::string> rows) {
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+ protected:
+  const int customer_count_ = 2000;
+  const int order_count_ = 20000;
+};
+
+#endif  // MINISQL_INDEX_NESTED_LOOP_JOIN_TEST_UTIL_H
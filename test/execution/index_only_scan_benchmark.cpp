@@ -0,0 +1,31 @@
+#include <chrono>
+
+#include "executor/executors/index_only_scan_executor.h"
+#include "executor/executors/index_scan_executor.h"
+#include "index_scan_test_util.h"  // NOLINT
+
+using IndexOnlyScanTest = IndexScanTest;
+
+// SELECT id FROM t WHERE id < 500, index scan vs index only scan
+TEST_F(IndexOnlyScanTest, IndexScanBenchmark) {
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+  auto predicate = Compare(ColumnExpr(0), Field(kTypeInt, 500), "<");
+  auto out_schema = OutputSchema({0});
+  IndexScanPlanNode index_plan(out_schema, "t", {index_info}, false, predicate);
+  IndexOnlyScanPlanNode index_only_plan(out_schema, "t", index_info, predicate);
+  const int rounds = 50;
+  auto run = [&](auto make_executor) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+      auto executor = make_executor();
+      EXPECT_EQ(500, Run(*executor).size());
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  double index_ms = run([&] { return std::make_unique<IndexScanExecutor>(exec_ctx_.get(), &index_plan); });
+  double index_only_ms =
+      run([&] { return std::make_unique<IndexOnlyScanExecutor>(exec_ctx_.get(), &index_only_plan); });
+  std::cout << rounds << " range scans: index scan " << index_ms << " ms, index only scan " << index_only_ms << " ms"
+            << std::endl;
+}
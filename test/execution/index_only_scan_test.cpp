@@ -0,0 +1,54 @@
+#include "executor/executors/index_only_scan_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "index_scan_test_util.h"  // NOLINT
+
+using IndexOnlyScanTest = IndexScanTest;
+
+// SELECT id FROM t WHERE id >= 100 AND id < 300
+TEST_F(IndexOnlyScanTest, RangeTest) {
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+  auto predicate = std::make_shared<LogicExpression>(Compare(ColumnExpr(0), Field(kTypeInt, 100), ">="),
+                                                     Compare(ColumnExpr(0), Field(kTypeInt, 300), "<"), LogicType::And);
+  IndexOnlyScanPlanNode plan(OutputSchema({0}), "t", index_info, predicate);
+  IndexOnlyScanExecutor executor(exec_ctx_.get(), &plan);
+  auto result_set = Run(executor);
+  ASSERT_EQ(200, result_set.size());
+  // 按索引顺序输出
+  for (int i = 0; i < 200; i++) {
+    ASSERT_EQ(CmpBool::kTrue, result_set[i].GetField(0)->CompareEquals(Field(kTypeInt, 100 + i)));
+  }
+  // id > 100 AND id <= 300
+  auto strict = std::make_shared<LogicExpression>(Compare(ColumnExpr(0), Field(kTypeInt, 100), ">"),
+                                                  Compare(ColumnExpr(0), Field(kTypeInt, 300), "<="), LogicType::And);
+  IndexOnlyScanPlanNode strict_plan(OutputSchema({0}), "t", index_info, strict);
+  IndexOnlyScanExecutor strict_executor(exec_ctx_.get(), &strict_plan);
+  result_set = Run(strict_executor);
+  ASSERT_EQ(200, result_set.size());
+  ASSERT_EQ(CmpBool::kTrue, result_set[0].GetField(0)->CompareEquals(Field(kTypeInt, 101)));
+  ASSERT_EQ(CmpBool::kTrue, result_set[199].GetField(0)->CompareEquals(Field(kTypeInt, 300)));
+  // 没有条件时扫描整个索引
+  IndexOnlyScanPlanNode full_plan(OutputSchema({0}), "t", index_info);
+  IndexOnlyScanExecutor full_executor(exec_ctx_.get(), &full_plan);
+  ASSERT_EQ(n_, Run(full_executor).size());
+  ASSERT_TRUE(db_->bpm_->CheckAllUnpinned());
+}
+
+// SELECT account, name FROM t WHERE name = 'name-5' AND account < 0, index on (name, account)
+TEST_F(IndexOnlyScanTest, CompositeKeyTest) {
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS,
+            db_->catalog_mgr_->CreateIndex("t", "t_name_account", {"name", "account"}, nullptr, index_info, "bptree"));
+  char name[] = "name-5";
+  auto predicate = std::make_shared<LogicExpression>(
+      Compare(ColumnExpr(1), Field(kTypeChar, name, strlen(name), true), "="),
+      Compare(ColumnExpr(2), Field(kTypeFloat, 0.f), "<"), LogicType::And);
+  auto out_schema = OutputSchema({2, 1});
+  SeqScanPlanNode seq_plan(out_schema, "t", predicate);
+  IndexOnlyScanPlanNode index_only_plan(out_schema, "t", index_info, predicate);
+  SeqScanExecutor seq_executor(exec_ctx_.get(), &seq_plan);
+  IndexOnlyScanExecutor index_only_executor(exec_ctx_.get(), &index_only_plan);
+  auto expected = Run(seq_executor);
+  ASSERT_FALSE(expected.empty());
+  ASSERT_EQ(Sorted(expected), Sorted(Run(index_only_executor)));
+}
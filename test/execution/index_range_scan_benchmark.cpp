@@ -0,0 +1,33 @@
+#include <chrono>
+
+#include "executor/executors/index_scan_executor.h"
+#include "index_scan_test_util.h"  // NOLINT
+#include "planner/key_range.h"
+
+using IndexRangeScanTest = IndexScanTest;
+
+// SELECT * FROM t WHERE id > 200 AND id < 220, one bounded scan vs two range scans and an intersection
+TEST_F(IndexRangeScanTest, RangeScanBenchmark) {
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+  auto predicate = std::make_shared<LogicExpression>(Compare(ColumnExpr(0), Field(kTypeInt, 200), ">"),
+                                                     Compare(ColumnExpr(0), Field(kTypeInt, 220), "<"), LogicType::And);
+  auto out_schema = OutputSchema({0, 1, 2});
+  IndexScanPlanNode intersect_plan(out_schema, "t", {index_info}, false, predicate);
+  IndexScanPlanNode range_plan(out_schema, "t", index_info, KeyRange(predicate, index_info->GetIndexKeySchema()),
+                               predicate);
+  ASSERT_FALSE(range_plan.need_filter_);
+  const int rounds = 200;
+  auto run = [&](const IndexScanPlanNode *plan) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+      IndexScanExecutor executor(exec_ctx_.get(), plan);
+      EXPECT_EQ(19, Run(executor).size());
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  double intersect_ms = run(&intersect_plan);
+  double range_ms = run(&range_plan);
+  std::cout << rounds << " scans: two range scans + intersection " << intersect_ms << " ms, one bounded scan "
+            << range_ms << " ms" << std::endl;
+}
@@ -0,0 +1,88 @@
+#include "executor/executors/index_scan_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "index_scan_test_util.h"  // NOLINT
+#include "planner/key_range.h"
+
+using IndexRangeScanTest = IndexScanTest;
+
+TEST_F(IndexRangeScanTest, KeyRangeTest) {
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS,
+            db_->catalog_mgr_->CreateIndex("t", "t_id_account", {"id", "account"}, nullptr, index_info, "bptree"));
+  auto key_schema = index_info->GetIndexKeySchema();
+  auto And = [](AbstractExpressionRef lhs, AbstractExpressionRef rhs) {
+    return std::make_shared<LogicExpression>(lhs, rhs, LogicType::And);
+  };
+  // id = 5 AND account > 1 AND account <= 2
+  KeyRange range(And(And(Compare(ColumnExpr(0), Field(kTypeInt, 5), "="),
+                         Compare(ColumnExpr(2), Field(kTypeFloat, 1.f), ">")),
+                     Compare(ColumnExpr(2), Field(kTypeFloat, 2.f), "<=")),
+                 key_schema);
+  ASSERT_EQ(1, range.GetEqualityCount());
+  ASSERT_TRUE(range.HasRange());
+  ASSERT_TRUE(range.IsExact());
+  std::vector<Field> before{Field(kTypeInt, 5), Field(kTypeFloat, 1.f)};
+  std::vector<Field> inside{Field(kTypeInt, 5), Field(kTypeFloat, 2.f)};
+  std::vector<Field> after{Field(kTypeInt, 5), Field(kTypeFloat, 2.5f)};
+  ASSERT_EQ(-1, range.Locate(Row(before)));
+  ASSERT_EQ(0, range.Locate(Row(inside)));
+  ASSERT_EQ(1, range.Locate(Row(after)));
+  Row start_key;
+  ASSERT_TRUE(range.GetStartKey(start_key));
+  ASSERT_EQ(CmpBool::kTrue, start_key.GetField(1)->CompareEquals(Field(kTypeFloat, 1.f)));
+  // 同一列上的条件合并：id >= 3 AND id > 3 AND id < 10，account上没有条件
+  KeyRange merged(And(And(Compare(ColumnExpr(0), Field(kTypeInt, 3), ">="),
+                          Compare(ColumnExpr(0), Field(kTypeInt, 3), ">")),
+                      Compare(ColumnExpr(0), Field(kTypeInt, 10), "<")),
+                  key_schema);
+  ASSERT_EQ(0, merged.GetEqualityCount());
+  ASSERT_TRUE(merged.HasRange());
+  std::vector<Field> three{Field(kTypeInt, 3), Field(kTypeFloat, 0.f)};
+  ASSERT_EQ(-1, merged.Locate(Row(three)));
+  // 矛盾的条件
+  KeyRange empty(And(Compare(ColumnExpr(0), Field(kTypeInt, 5), ">"), Compare(ColumnExpr(0), Field(kTypeInt, 5), "<")),
+                 key_schema);
+  ASSERT_TRUE(empty.IsEmpty());
+  // 第一列上没有条件时不能缩小范围，name不在key中需要再过滤
+  char m[] = "m";
+  KeyRange partial(And(Compare(ColumnExpr(2), Field(kTypeFloat, 0.f), "="),
+                       Compare(ColumnExpr(1), Field(kTypeChar, m, 1, true), "<")),
+                   key_schema);
+  ASSERT_EQ(0, partial.GetMatchedColumns());
+  ASSERT_FALSE(partial.IsExact());
+}
+
+// 单次范围扫描的结果和顺序扫描一致
+TEST_F(IndexRangeScanTest, CompositeRangeTest) {
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS,
+            db_->catalog_mgr_->CreateIndex("t", "t_name_id", {"name", "id"}, nullptr, index_info, "bptree"));
+  char name[] = "name-7";
+  auto And = [](AbstractExpressionRef lhs, AbstractExpressionRef rhs) {
+    return std::make_shared<LogicExpression>(lhs, rhs, LogicType::And);
+  };
+  auto name_eq = Compare(ColumnExpr(1), Field(kTypeChar, name, strlen(name), true), "=");
+  std::vector<AbstractExpressionRef> predicates{
+      name_eq,
+      And(name_eq, Compare(ColumnExpr(0), Field(kTypeInt, 300), ">")),
+      And(And(name_eq, Compare(ColumnExpr(0), Field(kTypeInt, 104), ">=")),
+          Compare(ColumnExpr(0), Field(kTypeInt, 589), "<")),
+      And(name_eq, Compare(ColumnExpr(2), Field(kTypeFloat, 0.f), "<")),
+      And(Compare(ColumnExpr(1), Field(kTypeChar, name, strlen(name), true), ">="),
+          Compare(ColumnExpr(1), Field(kTypeChar, name, strlen(name), true), "<=")),
+      And(name_eq, Compare(ColumnExpr(0), Field(kTypeInt, 300), "<")),
+  };
+  auto out_schema = OutputSchema({0, 1, 2});
+  for (auto &predicate : predicates) {
+    KeyRange range(predicate, index_info->GetIndexKeySchema());
+    ASSERT_GE(range.GetMatchedColumns(), 1);
+    SeqScanPlanNode seq_plan(out_schema, "t", predicate);
+    IndexScanPlanNode index_plan(out_schema, "t", index_info, std::move(range), predicate);
+    SeqScanExecutor seq_executor(exec_ctx_.get(), &seq_plan);
+    IndexScanExecutor index_executor(exec_ctx_.get(), &index_plan);
+    auto expected = Run(seq_executor);
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(Sorted(expected), Sorted(Run(index_executor)));
+  }
+  ASSERT_TRUE(db_->bpm_->CheckAllUnpinned());
+}
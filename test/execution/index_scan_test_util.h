@@ -0,0 +1,103 @@
+#ifndef MINISQL_INDEX_SCAN_TEST_UTIL_H
+#define MINISQL_INDEX_SCAN_TEST_UTIL_H
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/instance.h"
+#include "executor/executors/abstract_executor.h"
+#include "gtest/gtest.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+#include "utils/utils.h"
+
+/**
+ * Table t(id int, name char(16), account float) with 1000 rows. The executors are driven
+ * directly, ExecuteEngine would try to load every database file under ./databases.
+ */
+class IndexScanTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    db_ = new DBStorageEngine("index_scan_test.db", true);
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                     new Column("name", TypeId::kTypeChar, 16, 1, true, false),
+                                     new Column("account", TypeId::kTypeFloat, 2, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    db_->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info_);
+    char name[16];
+    for (int i = 0; i < n_; i++) {
+      int len = snprintf(name, sizeof(name), "name-%d", i % 97);
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, len, true),
+                                Field(TypeId::kTypeFloat, RandomUtils::RandomFloat(-999.f, 999.f))};
+      Row row(fields);
+      ASSERT_TRUE(table_info_->GetTableHeap()->InsertTuple(row, nullptr));
+    }
+    exec_ctx_ = db_->MakeExecuteContext(nullptr);
+  }
+
+  void TearDown() override {
+    for (auto schema : schemas_) {
+      delete schema;
+    }
+    delete db_;
+  }
+
+  AbstractExpressionRef ColumnExpr(uint32_t col_idx) {
+    return std::make_shared<ColumnValueExpression>(0, col_idx, table_info_->GetSchema()->GetColumn(col_idx)->GetType());
+  }
+
+  AbstractExpressionRef Compare(AbstractExpressionRef column, const Field &value, const std::string &op) {
+    return std::make_shared<ComparisonExpression>(column, std::make_shared<ConstantValueExpression>(value), op);
+  }
+
+  Schema *OutputSchema(const std::vector<uint32_t> &col_ids) {
+    std::vector<Column *> cols;
+    for (auto col_id : col_ids) {
+      auto column = table_info_->GetSchema()->GetColumn(col_id);
+      if (column->GetType() == TypeId::kTypeChar) {
+        cols.push_back(new Column(column->GetName(), column->GetType(), column->GetLength(), col_id, true, false));
+      } else {
+        cols.push_back(new Column(column->GetName(), column->GetType(), col_id, true, false));
+      }
+    }
+    schemas_.push_back(new Schema(cols));
+    return schemas_.back();
+  }
+
+  std::vector<Row> Run(AbstractExecutor &executor) {
+    std::vector<Row> result_set;
+    executor.Init();
+    Row row;
+    RowId rid;
+    while (executor.Next(&row, &rid)) {
+      result_set.push_back(row);
+    }
+    return result_set;
+  }
+
+  static std::vector<std::string> Sorted(const std::vector<Row> &result_set) {
+    std::vector<std::string> rows;
+    for (const auto &row : result_set) {
+      std::string s;
+      for (uint32_t i = 0; i < row.GetFieldCount(); i++) {
+        s += row.GetField(i)->toString() + "|";
+      }
+      rows.push_back(s);
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+ protected:
+  const int n_ = 1000;
+  DBStorageEngine *db_{nullptr};
+  TableInfo *table_info_{nullptr};
+  std::unique_ptr<ExecuteContext> exec_ctx_;
+  std::vector<Schema *> schemas_;
+};
+
+#endif  // MINISQL_INDEX_SCAN_TEST_UTIL_H
@@ -0,0 +1,36 @@
+#include <chrono>
+#include <thread>
+
+#include "parallel_seq_scan_test_util.h"  // NOLINT
+
+/**
+ * Scan with filter and projection of the 10000 rows repeated 10 times, on the calling thread and
+ * with 2, 4 and 8 workers. The speedup depends on the cores of the machine.
+ */
+TEST_F(ParallelSeqScanTest, ScanBenchmark) {
+  const std::string sql = "select id, price from t where price > 10 and name <> \"name-3\";";
+  const int repeat = 10;
+  std::cout << "scan of " << n_ << " rows, " << std::thread::hardware_concurrency() << " cores:";
+  double serial_time = 0;
+  size_t expected = 0;
+  for (size_t parallelism : {1, 2, 4, 8}) {
+    auto plan = Plan(sql, parallelism, false);
+    auto context = db_->MakeExecuteContext(nullptr);
+    size_t count = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++) {
+      auto executor = MakeExecutor(context.get(), plan);
+      executor->Init();
+      DataChunk chunk;
+      while (executor->NextBatch(&chunk)) {
+        count += chunk.GetSelectedCount();
+      }
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeat;
+    serial_time = parallelism == 1 ? ms : serial_time;
+    expected = parallelism == 1 ? count : expected;
+    ASSERT_EQ(expected, count);
+    std::cout << " " << parallelism << " workers " << ms << " ms (" << serial_time / ms << "x)";
+  }
+  std::cout << std::endl;
+}
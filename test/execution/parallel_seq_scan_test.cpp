@@ -0,0 +1,86 @@
+#include <chrono>
+
+#include "parallel_seq_scan_test_util.h"  // NOLINT
+
+/**
+ * The workers return the rows of the serial scan: the same set, and the same sequence when the
+ * order is preserved, for each degree of parallelism, with and without projection and filter.
+ */
+TEST_F(ParallelSeqScanTest, ScanTest) {
+  const std::vector<std::pair<std::string, size_t>> queries{
+      {"select * from t;", 10000},
+      {"select name, id from t where price < 10;", 857},
+      {"select * from t where grp = 3 and price > 50;", 429},
+      {"select id from t where price is null;", 1429},
+      {"select * from t where name = \"name-7\" or grp = 1;", 1093},
+      {"select * from t where grp = 11;", 0}};
+  for (const auto &query : queries) {
+    auto serial = Run(Plan(query.first, 1, false), true);
+    ASSERT_EQ(query.second, serial.size()) << query.first;
+    auto sorted = serial;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t parallelism : {2, 3, 8}) {
+      for (bool preserve_order : {false, true}) {
+        auto plan = Plan(query.first, parallelism, preserve_order);
+        ASSERT_EQ(PlanType::SeqScan, plan->GetType());
+        ASSERT_NE(std::string::npos, plan->ToString().find(std::to_string(parallelism) + " workers"));
+        for (bool batch : {true, false}) {
+          auto rows = Run(plan, batch);
+          if (preserve_order) {
+            ASSERT_EQ(serial, rows) << query.first << " " << parallelism;
+          } else {
+            std::sort(rows.begin(), rows.end());
+            ASSERT_EQ(sorted, rows) << query.first << " " << parallelism;
+          }
+        }
+      }
+    }
+  }
+  // 索引扫描和删除、更新的扫描不并行
+  ASSERT_EQ(PlanType::IndexScan, Plan("select * from t where id = 5;", 4, false)->GetType());
+  auto delete_plan = Plan("delete from t where grp = 3;", 4, false);
+  auto child = dynamic_cast<const SeqScanPlanNode *>(delete_plan->GetChildAt(0).get());
+  ASSERT_NE(nullptr, child);
+  ASSERT_EQ(1, child->GetParallelism());
+
+  Parse("set parallelism = 4;", [](pSyntaxNode root) {
+    ASSERT_NE(nullptr, root);
+    ASSERT_EQ(kNodeSet, root->type_);
+    ASSERT_EQ(std::string("parallelism"), root->child_->val_);
+    ASSERT_EQ(std::string("4"), root->child_->next_->val_);
+  });
+}
+
+/** Stopping a scan whose workers are still running, or waiting for their rows to be taken */
+TEST_F(ParallelSeqScanTest, EarlyStopTest) {
+  for (bool preserve_order : {false, true}) {
+    auto plan = Plan("select * from t;", 4, preserve_order);
+    for (int taken = 0; taken < 3; taken++) {
+      auto context = db_->MakeExecuteContext(nullptr);
+      auto executor = MakeExecutor(context.get(), plan);
+      executor->Init();
+      DataChunk chunk;
+      for (int i = 0; i < taken; i++) {
+        ASSERT_TRUE(executor->NextBatch(&chunk));
+      }
+      if (taken == 2) {
+        // 等工作线程都停在窗口上
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      }
+    }
+    // 重新Init从头扫描
+    auto context = db_->MakeExecuteContext(nullptr);
+    auto executor = MakeExecutor(context.get(), plan);
+    size_t count = 0;
+    for (int i = 0; i < 2; i++) {
+      executor->Init();
+      DataChunk chunk;
+      count = 0;
+      while (executor->NextBatch(&chunk)) {
+        count += chunk.GetSelectedCount();
+      }
+    }
+    ASSERT_EQ(n_, count);
+  }
+  ASSERT_TRUE(db_->bpm_->CheckAllUnpinned());
+}
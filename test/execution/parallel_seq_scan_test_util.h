@@ -0,0 +1,95 @@
+#ifndef MINISQL_PARALLEL_SEQ_SCAN_TEST_UTIL_H
+#define MINISQL_PARALLEL_SEQ_SCAN_TEST_UTIL_H
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "executor/executors/parallel_seq_scan_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "sql_test_util.h"  // NOLINT
+
+/**
+ * Heap table t(id int unique, grp int, price float, name char(16)) with 10000 rows, grp = id % 10,
+ * price = id % 100 + 0.5 and name = "name-" + id % 97, every 7th price is null. A b+ tree index on
+ * id. The buffer pool only holds 64 pages, so the workers also read pages from disk.
+ */
+class ParallelSeqScanTest : public SqlTest {
+ public:
+  void SetUp() override {
+    db_ = new DBStorageEngine("parallel_seq_scan_test.db", true, 64);
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, true),
+                                     new Column("grp", TypeId::kTypeInt, 1, true, false),
+                                     new Column("price", TypeId::kTypeFloat, 2, true, false),
+                                     new Column("name", TypeId::kTypeChar, 16, 3, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info_));
+    for (int i = 0; i < n_; i++) {
+      std::string name = "name-" + std::to_string(i % 97);
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeInt, i % 10),
+                                i % 7 == 0 ? Field(TypeId::kTypeFloat)
+                                           : Field(TypeId::kTypeFloat, static_cast<float>(i % 100 + 0.5)),
+                                Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+      Row row(fields);
+      ASSERT_TRUE(table_info_->InsertTuple(row, nullptr));
+    }
+    IndexInfo *index_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+  }
+
+  AbstractPlanNodeRef Plan(const std::string &sql, size_t parallelism, bool preserve_order) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    context->SetParallelism(parallelism);
+    context->SetScanOrderPreserved(preserve_order);
+    return SqlTest::Plan(context.get(), sql);
+  }
+
+  static std::unique_ptr<AbstractExecutor> MakeExecutor(ExecuteContext *context, const AbstractPlanNodeRef &plan) {
+    auto seq_scan_plan = dynamic_cast<const SeqScanPlanNode *>(plan.get());
+    EXPECT_NE(nullptr, seq_scan_plan);
+    if (seq_scan_plan->GetParallelism() > 1) {
+      return std::make_unique<ParallelSeqScanExecutor>(context, seq_scan_plan);
+    }
+    return std::make_unique<SeqScanExecutor>(context, seq_scan_plan);
+  }
+
+  /** @return The rows of plan, as text, pulled with NextBatch() or with Next() */
+  std::vector<std::string> Run(const AbstractPlanNodeRef &plan, bool batch) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    auto executor = MakeExecutor(context.get(), plan);
+    executor->Init();
+    std::vector<std::string> result;
+    Row row;
+    if (batch) {
+      DataChunk chunk;
+      while (executor->NextBatch(&chunk)) {
+        EXPECT_GT(chunk.GetSelectedCount(), 0);
+        for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+          chunk.GetRow(i, &row);
+          result.push_back(ToString(row));
+        }
+      }
+    } else {
+      RowId rid;
+      while (executor->Next(&row, &rid)) {
+        EXPECT_EQ(rid.Get(), row.GetRowId().Get());
+        result.push_back(ToString(row));
+      }
+    }
+    return result;
+  }
+
+  static std::string ToString(const Row &row) {
+    std::string text = std::to_string(row.GetRowId().Get());
+    for (auto field : const_cast<Row &>(row).GetFields()) {
+      text += "|" + field->toString();
+    }
+    return text;
+  }
+
+ protected:
+  const int n_ = 10000;
+  TableInfo *table_info_{nullptr};
+};
+
+#endif  // MINISQL_PARALLEL_SEQ_SCAN_TEST_UTIL_H
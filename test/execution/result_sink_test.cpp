@@ -0,0 +1,242 @@
+#include "executor/result_sink.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+
+#include "executor/execute_engine.h"
+#include "common/result_writer.h"
+#include "gtest/gtest.h"
+
+/**
+ * Chunks of rows (id int, name char(8), amount float) for the sinks: id = i, name = "n" + i % 37
+ * (null every 7th row) and amount = i / 3.
+ */
+class ResultSinkTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                     new Column("name", TypeId::kTypeChar, 8, 1, true, false),
+                                     new Column("amount", TypeId::kTypeFloat, 2, true, false)};
+    schema_ = std::make_unique<Schema>(columns);
+  }
+
+  Row MakeRow(int i) const {
+    std::string name = "n" + std::to_string(i % 37);
+    std::vector<Field> fields{Field(kTypeInt, i),
+                              i % 7 == 0 ? Field(kTypeChar)
+                                         : Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                              Field(kTypeFloat, static_cast<float>(i) / 3)};
+    return Row(fields);
+  }
+
+  /** Hand rows [0, count) to sink, DataChunk::CAPACITY at a time, the odd rows left unselected */
+  void Feed(ResultSink *sink, int count, const std::function<void(int)> &after_chunk = nullptr) const {
+    sink->Begin(schema_.get());
+    DataChunk chunk;
+    for (int i = 0; i < count;) {
+      chunk.Reset(schema_.get());
+      for (; i < count && !chunk.IsFull(); i++) {
+        chunk.AppendRow(MakeRow(i), RowId(i));
+      }
+      auto &selection = chunk.GetSelection();
+      selection.erase(std::remove_if(selection.begin(), selection.end(), [](uint32_t pos) { return pos % 2 == 1; }),
+                      selection.end());
+      sink->Consume(chunk);
+      if (after_chunk != nullptr) {
+        after_chunk(i);
+      }
+    }
+    sink->End();
+  }
+
+  /** @return The even rows of [0, count) as the table of the shell, the widths fitting every cell */
+  std::string ExpectedTable(int count) const {
+    std::vector<int> widths;
+    for (auto column : schema_->GetColumns()) {
+      widths.push_back(column->GetName().size());
+    }
+    for (int i = 0; i < count; i += 2) {
+      Row row = MakeRow(i);
+      for (uint32_t j = 0; j < widths.size(); j++) {
+        widths[j] = std::max(widths[j], static_cast<int>(row.GetField(j)->toString().size()));
+      }
+    }
+    std::stringstream ss;
+    ResultWriter writer(ss);
+    writer.Divider(widths);
+    writer.BeginRow();
+    for (uint32_t j = 0; j < widths.size(); j++) {
+      writer.WriteHeaderCell(schema_->GetColumn(j)->GetName(), widths[j]);
+    }
+    writer.EndRow();
+    writer.Divider(widths);
+    for (int i = 0; i < count; i += 2) {
+      Row row = MakeRow(i);
+      writer.BeginRow();
+      for (uint32_t j = 0; j < widths.size(); j++) {
+        writer.WriteCell(row.GetField(j)->toString(), widths[j]);
+      }
+      writer.EndRow();
+    }
+    writer.Divider(widths);
+    return ss.str();
+  }
+
+ protected:
+  std::unique_ptr<Schema> schema_;
+};
+
+/** A result within the sample is laid out exactly as the shell did with the whole result in memory */
+TEST_F(ResultSinkTest, TableTest) {
+  for (int count : {1, 100, 2 * static_cast<int>(TableSink::SAMPLE_ROWS)}) {
+    std::stringstream ss;
+    TableSink sink(ss);
+    Feed(&sink, count);
+    ASSERT_EQ((count + 1) / 2, sink.GetRowCount());
+    ASSERT_EQ(ExpectedTable(count), ss.str());
+  }
+  // 没有行时什么都不写
+  std::stringstream ss;
+  TableSink sink(ss);
+  Feed(&sink, 0);
+  ASSERT_EQ(0, sink.GetRowCount());
+  ASSERT_TRUE(ss.str().empty());
+  // 不写行的sink只计数
+  ResultSink counter;
+  Feed(&counter, 5000);
+  ASSERT_EQ(2500, counter.GetRowCount());
+}
+
+/** Past the sample the rows are written chunk by chunk, aligned to the widths fixed after the sample */
+TEST_F(ResultSinkTest, StreamingTest) {
+  std::stringstream ss;
+  TableSink sink(ss);
+  const int count = 20 * DataChunk::CAPACITY;
+  std::vector<size_t> lines;
+  Feed(&sink, count, [&ss, &lines](int) {
+    std::string text = ss.str();
+    lines.push_back(std::count(text.begin(), text.end(), '\n'));
+  });
+  // 样本满之前不写，之后每个chunk的行都已写出
+  size_t sample_chunks = 2 * TableSink::SAMPLE_ROWS / DataChunk::CAPACITY;
+  for (size_t i = 0; i < sample_chunks; i++) {
+    ASSERT_EQ(0, lines[i]);
+  }
+  for (size_t i = sample_chunks; i < lines.size(); i++) {
+    ASSERT_EQ(3 + (i + 1) * DataChunk::CAPACITY / 2, lines[i]);
+  }
+  ASSERT_EQ(count / 2, sink.GetRowCount());
+  // int和char(8)列按类型的最大长度对齐，float列按样本；样本之后更长的值整个写出，这一行变长
+  std::istringstream in(ss.str());
+  std::string line;
+  std::getline(in, line);
+  ASSERT_EQ("+-------------+----------+------------+", line);
+  std::getline(in, line);
+  ASSERT_EQ("| id          | name     | amount     |", line);
+  size_t rows = 0;
+  while (std::getline(in, line)) {
+    if (line[0] == '+') {
+      continue;
+    }
+    int id = std::stoi(line.substr(2, 11));
+    ASSERT_EQ(rows * 2, id);
+    ASSERT_EQ(id >= 3000 ? 40 : 39, line.size()) << line;
+    rows++;
+  }
+  ASSERT_EQ(count / 2, rows);
+}
+
+/** Tab separated values, escaped, with \N for null and floats that read back to the same value */
+TEST_F(ResultSinkTest, TsvTest) {
+  std::stringstream ss;
+  auto sink = ResultSink::Create(OutputFormat::kTsv, ss);
+  Feed(sink.get(), 3000);
+  std::istringstream in(ss.str());
+  std::string line;
+  std::getline(in, line);
+  ASSERT_EQ("id\tname\tamount", line);
+  for (int i = 0; i < 3000; i += 2) {
+    ASSERT_TRUE(std::getline(in, line));
+    std::stringstream fields(line);
+    std::string id, name, amount;
+    std::getline(fields, id, '\t');
+    std::getline(fields, name, '\t');
+    std::getline(fields, amount, '\t');
+    ASSERT_EQ(std::to_string(i), id);
+    ASSERT_EQ(i % 7 == 0 ? "\\N" : "n" + std::to_string(i % 37), name);
+    ASSERT_EQ(static_cast<float>(i) / 3, strtof(amount.c_str(), nullptr));
+  }
+  ASSERT_FALSE(std::getline(in, line));
+
+  std::vector<Column *> columns = {new Column("text", TypeId::kTypeChar, 16, 0, true, false)};
+  Schema schema(columns);
+  char text[] = "a\tb\\c\nd";
+  DataChunk chunk;
+  chunk.Reset(&schema);
+  std::vector<Field> fields{Field(kTypeChar, text, strlen(text), true)};
+  chunk.AppendRow(Row(fields), RowId());
+  std::stringstream escaped;
+  TsvSink tsv(escaped);
+  tsv.Begin(&schema);
+  tsv.Consume(chunk);
+  tsv.End();
+  ASSERT_EQ("text\na\\tb\\\\c\\nd\n", escaped.str());
+}
+
+/** The binary rows decode to the values of the rows */
+TEST_F(ResultSinkTest, BinaryTest) {
+  std::stringstream ss;
+  auto sink = ResultSink::Create(OutputFormat::kBinary, ss);
+  Feed(sink.get(), 3000);
+  std::string data = ss.str();
+  size_t offset = 0;
+  auto read = [&data, &offset](void *dest, size_t size) {
+    ASSERT_LE(offset + size, data.size());
+    memcpy(dest, data.data() + offset, size);
+    offset += size;
+  };
+  char magic[8];
+  read(magic, 8);
+  ASSERT_EQ(0, memcmp(magic, BinarySink::MAGIC, 8));
+  uint32_t column_count = 0;
+  read(&column_count, 4);
+  ASSERT_EQ(3, column_count);
+  for (uint32_t j = 0; j < column_count; j++) {
+    char type;
+    uint32_t length;
+    read(&type, 1);
+    read(&length, 4);
+    ASSERT_EQ(schema_->GetColumn(j)->GetType(), static_cast<TypeId>(type));
+    ASSERT_EQ(schema_->GetColumn(j)->GetName(), data.substr(offset, length));
+    offset += length;
+  }
+  for (int i = 0; i < 3000; i += 2) {
+    char flag, is_null;
+    int32_t id;
+    float amount;
+    read(&flag, 1);
+    ASSERT_EQ(1, flag);
+    read(&is_null, 1);
+    ASSERT_EQ(0, is_null);
+    read(&id, 4);
+    ASSERT_EQ(i, id);
+    read(&is_null, 1);
+    ASSERT_EQ(i % 7 == 0, is_null);
+    if (!is_null) {
+      uint32_t length;
+      read(&length, 4);
+      ASSERT_EQ("n" + std::to_string(i % 37), data.substr(offset, length));
+      offset += length;
+    }
+    read(&is_null, 1);
+    read(&amount, 4);
+    ASSERT_EQ(static_cast<float>(i) / 3, amount);
+  }
+  char end;
+  read(&end, 1);
+  ASSERT_EQ(0, end);
+  ASSERT_EQ(data.size(), offset);
+}
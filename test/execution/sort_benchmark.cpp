@@ -0,0 +1,21 @@
+#include <chrono>
+
+#include "sort_test_util.h"  // NOLINT
+
+/** A top-N heap against sorting every row and keeping the first ones */
+TEST_F(SortTest, TopNBenchmark) {
+  auto top_n = Plan("select id, val, name from t order by name, id limit 10;");
+  auto sort = std::make_shared<SortPlanNode>(top_n->GetChildAt(0),
+                                             std::static_pointer_cast<const SortPlanNode>(top_n)->GetOrderBys());
+  const int rounds = 5;
+  double ms[2];
+  for (int k = 0; k < 2; k++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+      auto rows = Run(k == 0 ? top_n : sort);
+      ASSERT_EQ(k == 0 ? 10 : row_count_, rows.size());
+    }
+    ms[k] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / rounds;
+  }
+  std::cout << row_count_ << " rows, top 10: " << ms[0] << " ms, full sort: " << ms[1] << " ms" << std::endl;
+}
@@ -0,0 +1,262 @@
+#include "sort_test_util.h"  // NOLINT
+
+/** Orders by several columns in both directions, nulls and char prefixes, equal to std::stable_sort */
+TEST_F(SortTest, SortTest) {
+  auto plan = Plan("select id, val, name from t order by val desc, name, id;");
+  ASSERT_EQ("Sort by val desc, name, id", plan->ToString());
+  ASSERT_EQ(Expected([](const Item &lhs, const Item &rhs) {
+              int cmp = CompareVal(lhs, rhs);
+              if (cmp != 0) {
+                return cmp > 0;
+              }
+              return lhs.name != rhs.name ? lhs.name < rhs.name : lhs.id < rhs.id;
+            }),
+            Run(plan));
+  // char的前缀相同时比较整个值
+  ASSERT_EQ(Expected([](const Item &lhs, const Item &rhs) {
+              if (lhs.name != rhs.name) {
+                return lhs.name > rhs.name;
+              }
+              int cmp = CompareVal(lhs, rhs);
+              return cmp != 0 ? cmp < 0 : lhs.id < rhs.id;
+            }),
+            Run("select id, val, name from t order by name DESC, val asc, id;"));
+  // float的-0.0和0.0相等，按id排
+  auto rows = Run("select amount, id from t order by amount, id;");
+  ASSERT_EQ(row_count_, rows.size());
+  std::vector<Item> expected(items_);
+  std::sort(expected.begin(), expected.end(), [](const Item &lhs, const Item &rhs) {
+    return lhs.amount != rhs.amount ? lhs.amount < rhs.amount : lhs.id < rhs.id;
+  });
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ("|" + Field(kTypeFloat, expected[i].amount).toString() + "|" + std::to_string(expected[i].id), rows[i]);
+  }
+  // 没有输入行
+  ASSERT_TRUE(Run("select id from t where grp > 100 order by id;").empty());
+}
+
+/** A limit keeps the first rows in a heap, the same rows as the full sort */
+TEST_F(SortTest, TopNTest) {
+  auto by_val_desc = [](const Item &lhs, const Item &rhs) {
+    int cmp = CompareVal(lhs, rhs);
+    return cmp != 0 ? cmp > 0 : lhs.id < rhs.id;
+  };
+  for (size_t limit : {1, 10, 1000, 5000}) {
+    auto plan = Plan("select id, val, name from t order by val desc, id limit " + std::to_string(limit) + ";");
+    ASSERT_EQ("TopN " + std::to_string(limit) + " by val desc, id", plan->ToString());
+    ASSERT_EQ(Expected(by_val_desc, limit), Run(plan));
+  }
+  auto context = db_->MakeExecuteContext(nullptr);
+  auto plan = Plan("select id, val, name from t order by val desc, id limit 10;");
+  auto executor = ExecuteEngine::CreateExecutor(context.get(), plan);
+  executor->Init();
+  ASSERT_TRUE(dynamic_cast<SortExecutor *>(executor.get())->IsTopN());
+  ASSERT_TRUE(Run("select id from t order by id limit 0;").empty());
+  // 没有order by时取扫描到的前几行
+  plan = Plan("select id from t limit 7;");
+  ASSERT_EQ("Limit 7", plan->ToString());
+  ASSERT_EQ(7, Run(plan).size());
+  ASSERT_EQ(row_count_, Run("select id from t limit 100000;").size());
+}
+
+/** Runs spilled past the work memory, merged in several passes when there are too many */
+TEST_F(SortTest, ExternalSortTest) {
+  auto plan = Plan("select id, val, name from t order by val, name desc, id;");
+  auto expected = Expected([](const Item &lhs, const Item &rhs) {
+    int cmp = CompareVal(lhs, rhs);
+    if (cmp != 0) {
+      return cmp < 0;
+    }
+    return lhs.name != rhs.name ? lhs.name > rhs.name : lhs.id < rhs.id;
+  });
+  size_t runs = 0;
+  ASSERT_EQ(expected, Run(plan, ExecuteContext::DEFAULT_WORK_MEMORY, &runs));
+  ASSERT_EQ(0, runs);
+  ASSERT_EQ(expected, Run(plan, 256 << 10, &runs));
+  ASSERT_GT(runs, 1);
+  // 每次只能合并两个run
+  size_t merged_runs = 0;
+  ASSERT_EQ(expected, Run(plan, 32 << 10, &merged_runs));
+  ASSERT_GT(merged_runs, runs);
+}
+
+/** The sort is left out when an index scan already yields the order */
+TEST_F(SortTest, IndexOrderTest) {
+  auto by_id = [](const Item &lhs, const Item &rhs) { return lhs.id < rhs.id; };
+  // 范围扫描按id的顺序
+  auto plan = Plan("select id, val, name from t where id >= 100 order by id;");
+  ASSERT_EQ(PlanType::IndexScan, plan->GetType());
+  auto expected = Expected(by_id);
+  expected.erase(expected.begin(), expected.begin() + 100);
+  ASSERT_EQ(expected, Run(plan));
+  // 没有统计信息时有limit就按索引顺序读
+  plan = Plan("select id, val, name from t order by id limit 5;");
+  ASSERT_EQ("Limit 5", plan->ToString());
+  ASSERT_EQ("IndexScan on t using t_id (range)", plan->GetChildAt(0)->ToString());
+  ASSERT_EQ(Expected(by_id, 5), Run(plan));
+  // 等值条件固定了grp，索引(grp, val)按val有序
+  plan = Plan("select val, grp from t where grp = 3 order by val;");
+  ASSERT_EQ(PlanType::IndexOnlyScan, plan->GetType());
+  auto rows = Run(plan);
+  plan = Plan("select val, grp from t where grp = 3 order by grp, val desc;");
+  ASSERT_EQ("Sort by grp, val desc", plan->ToString());
+  auto reversed = Run(plan);
+  ASSERT_EQ(500, rows.size());
+  std::reverse(reversed.begin(), reversed.end());
+  ASSERT_EQ(rows, reversed);
+  ASSERT_EQ("|NULL|3", rows[0]);
+  // clustered表按主键顺序存储
+  plan = Plan("select id from c order by id;");
+  ASSERT_EQ(PlanType::SeqScan, plan->GetType());
+  rows = Run(plan);
+  ASSERT_EQ(500, rows.size());
+  for (int i = 0; i < 500; i++) {
+    ASSERT_EQ("|" + std::to_string(i), rows[i]);
+  }
+  ASSERT_EQ(PlanType::Sort, Plan("select id from c order by id desc;")->GetType());
+  ASSERT_EQ(PlanType::Sort, Plan("select id, name from c order by name;")->GetType());
+
+  // 有统计信息时按代价选择：全表按id回表比排序贵，只取前几行时回表便宜
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  plan = Plan("select id, val, name from t order by id;");
+  ASSERT_EQ(PlanType::Sort, plan->GetType());
+  ASSERT_GT(plan->GetEstimatedCost(), plan->GetChildAt(0)->GetEstimatedCost());
+  plan = Plan("select id, val, name from t order by id limit 10;");
+  ASSERT_EQ(PlanType::Limit, plan->GetType());
+  ASSERT_EQ(PlanType::IndexScan, plan->GetChildAt(0)->GetType());
+  ASSERT_EQ(10, plan->GetEstimatedRows());
+  ASSERT_EQ(Expected(by_id, 10), Run(plan));
+}
+
+/** Order by on the output of an aggregation and of a join, and the errors of the clauses */
+TEST_F(SortTest, PlanTest) {
+  auto plan = Plan("select grp, count(*) from t group by grp order by grp desc limit 3;");
+  ASSERT_EQ("TopN 3 by grp desc", plan->ToString());
+  ASSERT_EQ((std::vector<std::string>{"|39|500", "|38|500", "|37|500"}), Run(plan));
+  plan = Plan("select c.id, t.grp from t, c where t.id = c.id and c.id < 5 order by t.grp desc, c.id;");
+  ASSERT_EQ(PlanType::Sort, plan->GetType());
+  ASSERT_EQ((std::vector<std::string>{"|4|4", "|3|3", "|2|2", "|1|1", "|0|0"}), Run(plan));
+
+  ExpectPlanError("select id from t order by val;");
+  ExpectPlanError("select id from t order by other;");
+  ExpectPlanError("select grp, count(*) from t group by grp order by id;");
+  ExpectPlanError("select id from t limit 1.5;");
+  ExpectParseError("select id from t order id;");
+  ExpectParseError("select id from t order by id sideways;");
+  ExpectParseError("select id from t limit 3 order by id;");
+  ExpectParseError("select id from t order by id, ;");
+  ExpectParseError("select id from t limit;");
+  // join不是子句
+  ExpectParseError("select id from t join c;");
+}
+
+/** Rows skipped by an offset before the limit, after a sort or straight from a scan */
+TEST_F(SortTest, OffsetTest) {
+  auto by_val_desc = [](const Item &lhs, const Item &rhs) {
+    int cmp = CompareVal(lhs, rhs);
+    return cmp != 0 ? cmp > 0 : lhs.id < rhs.id;
+  };
+  // top-N保留offset + limit行
+  auto plan = Plan("select id, val, name from t order by val desc, id limit 10 offset 5;");
+  ASSERT_EQ("Limit 10 offset 5", plan->ToString());
+  ASSERT_EQ("TopN 15 by val desc, id", plan->GetChildAt(0)->ToString());
+  auto expected = Expected(by_val_desc, 15);
+  expected.erase(expected.begin(), expected.begin() + 5);
+  ASSERT_EQ(expected, Run(plan));
+  // offset跨过几个chunk
+  expected = Expected(by_val_desc, 5000);
+  expected.erase(expected.begin(), expected.begin() + 3000);
+  ASSERT_EQ(expected, Run("select id, val, name from t order by val desc, id limit 2000 offset 3000;"));
+  // 索引给出顺序时不排序，limit直接跳过索引扫描的行
+  plan = Plan("select id, val, name from t order by id limit 10 offset 19995;");
+  ASSERT_EQ("IndexScan on t using t_id (range)", plan->GetChildAt(0)->ToString());
+  expected = Expected([](const Item &lhs, const Item &rhs) { return lhs.id < rhs.id; });
+  expected.erase(expected.begin(), expected.begin() + 19995);
+  ASSERT_EQ(expected, Run(plan));
+  ASSERT_TRUE(Run("select id from t limit 5 offset 30000;").empty());
+  ASSERT_EQ(5, Run("select id from t limit 5 offset 0;").size());
+  ASSERT_EQ((std::vector<std::string>{"|13", "|14", "|15"}), Run("select id from c where id > 10 limit 3 offset 2;"));
+
+  // 逐行的Next与NextBatch结果相同
+  plan = Plan("select id from t where id < 3000 order by id limit 1500 offset 700;");
+  auto rows = Run(plan);
+  auto context = db_->MakeExecuteContext(nullptr);
+  auto executor = ExecuteEngine::CreateExecutor(context.get(), plan);
+  executor->Init();
+  Row row;
+  RowId rid;
+  std::vector<std::string> by_row;
+  while (executor->Next(&row, &rid)) {
+    by_row.push_back("|" + row.GetField(0)->toString());
+  }
+  ASSERT_EQ(1500, by_row.size());
+  ASSERT_EQ("|700", by_row[0]);
+  ASSERT_EQ(rows, by_row);
+
+  ExpectPlanError("select id from t limit 5 offset 1.5;");
+  ExpectParseError("select id from t offset 5;");
+  ExpectParseError("select id from t limit 5 offset;");
+  ExpectParseError("select id from t limit 5 offset 1 offset 2;");
+  ExpectParseError("select id from t order by id offset 2 limit 5;");
+}
+
+/** limit and offset are keywords, but still name tables and columns */
+TEST_F(SortTest, KeywordNameTest) {
+  std::vector<Column *> columns = {new Column("offset", TypeId::kTypeInt, 0, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("limit", schema.get(), nullptr, table_info));
+  for (int i = 0; i < 10; i++) {
+    std::vector<Field> fields{Field(kTypeInt, i)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+  }
+  ASSERT_EQ((std::vector<std::string>{"|7", "|6"}),
+            Run("select offset from limit order by offset desc limit 2 offset 2;"));
+}
+
+/** A range scan of a select reads the index as the rows are asked for, one under a delete reads it all first */
+TEST_F(SortTest, LazyIndexScanTest) {
+  auto plan = Plan("select * from t where id > 5 limit 10;");
+  ASSERT_EQ("Limit 10", plan->ToString());
+  auto scan_plan = std::static_pointer_cast<const IndexScanPlanNode>(plan->GetChildAt(0));
+  ASSERT_NE(nullptr, scan_plan->range_);
+  ASSERT_FALSE(scan_plan->collect_all_);
+  auto rows = Run(plan);
+  ASSERT_EQ(10, rows.size());
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ("|" + std::to_string(6 + i), rows[i].substr(0, rows[i].find('|', 1)));
+  }
+  // 只读了开头的几个entry
+  auto context = db_->MakeExecuteContext(nullptr);
+  IndexScanExecutor executor(context.get(), scan_plan.get());
+  executor.Init();
+  ASSERT_EQ(0, executor.GetScannedEntries());
+  DataChunk chunk;
+  ASSERT_TRUE(executor.NextBatch(&chunk));
+  ASSERT_EQ(IndexScanExecutor::FIRST_READ_ENTRIES, chunk.GetSelectedCount());
+  ASSERT_LE(executor.GetScannedEntries(), IndexScanExecutor::FIRST_READ_ENTRIES + 6);
+  size_t total = chunk.GetSelectedCount();
+  while (executor.NextBatch(&chunk)) {
+    ASSERT_LE(chunk.GetSelectedCount(), DataChunk::CAPACITY);
+    total += chunk.GetSelectedCount();
+  }
+  ASSERT_EQ(row_count_ - 6, total);
+
+  // 删除时先取出全部row id
+  auto delete_plan = Plan(context.get(), "delete from t where id > 19000;");
+  auto delete_scan = delete_plan->GetChildAt(0);
+  ASSERT_EQ(PlanType::IndexScan, delete_scan->GetType());
+  ASSERT_TRUE(std::static_pointer_cast<const IndexScanPlanNode>(delete_scan)->collect_all_);
+  ASSERT_EQ(999, Run(delete_plan).size());
+  ASSERT_EQ(19001, Run("select id from t;").size());
+
+  // 有统计信息时，limit只计扫描到第limit行的代价
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  plan = Plan("select * from t where id > 5 limit 10;");
+  ASSERT_EQ(PlanType::Limit, plan->GetType());
+  ASSERT_EQ(10, plan->GetEstimatedRows());
+  ASSERT_LT(plan->GetEstimatedCost() * 100, plan->GetChildAt(0)->GetEstimatedCost());
+  plan = Plan("select id, val, name from t order by val limit 10;");
+  ASSERT_EQ(PlanType::Sort, plan->GetType());
+}
@@ -0,0 +1,149 @@
+#ifndef MINISQL_SORT_TEST_UTIL_H
+#define MINISQL_SORT_TEST_UTIL_H
+
+#include <algorithm>
+#include <string>
+
+#include "executor/execute_engine.h"
+#include "executor/executors/index_scan_executor.h"
+#include "executor/executors/sort_executor.h"
+#include "executor/plans/insert_plan.h"
+#include "executor/plans/values_plan.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "sql_test_util.h"  // NOLINT
+
+/**
+ * Heap table t(id int, grp int, val int, name char(16), amount float) with 20000 rows inserted out
+ * of id order, b+ tree indexes on id and on (grp, val), and the clustered table c(id int, name
+ * char(16), account float) with ids inserted out of order. val is null for every 11th id; names
+ * share their first 7 bytes in groups so that the sort has to look past its key prefixes.
+ */
+class SortTest : public SqlTest {
+ public:
+  /** Values of a row of t */
+  struct Item {
+    int id;
+    int grp;
+    bool val_null;
+    int val;
+    std::string name;
+    float amount;
+  };
+
+  void SetUp() override {
+    db_ = new DBStorageEngine("sort_test.db", true);
+    std::vector<Column *> columns = {
+        new Column("id", TypeId::kTypeInt, 0, true, false), new Column("grp", TypeId::kTypeInt, 1, true, false),
+        new Column("val", TypeId::kTypeInt, 2, true, false), new Column("name", TypeId::kTypeChar, 16, 3, true, false),
+        new Column("amount", TypeId::kTypeFloat, 4, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    TableInfo *table_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info));
+    for (int i = 0; i < row_count_; i++) {
+      int id = static_cast<int>(i * 7919L % row_count_);
+      Item item{id, id % 40, id % 11 == 0, id * 37 % 1000 - 500, "name-" + std::to_string(1000 + id % 700),
+                id % 13 == 6 ? -0.0f : static_cast<float>(id % 13 - 6) + 0.5f};
+      items_.push_back(item);
+      std::vector<Field> fields{Field(kTypeInt, item.id), Field(kTypeInt, item.grp),
+                                item.val_null ? Field(kTypeInt) : Field(kTypeInt, item.val),
+                                Field(kTypeChar, const_cast<char *>(item.name.c_str()), item.name.size(), true),
+                                Field(kTypeFloat, item.amount)};
+      Row row(fields);
+      ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+    }
+    IndexInfo *index_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+    ASSERT_EQ(DB_SUCCESS,
+              db_->catalog_mgr_->CreateIndex("t", "t_grp_val", {"grp", "val"}, nullptr, index_info, "bptree"));
+
+    std::vector<Column *> clustered_columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                               new Column("name", TypeId::kTypeChar, 16, 1, true, false),
+                                               new Column("account", TypeId::kTypeFloat, 2, true, false)};
+    auto clustered_schema = std::make_shared<Schema>(clustered_columns);
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("c", clustered_schema.get(), nullptr, table_info, true));
+    std::vector<std::vector<AbstractExpressionRef>> values;
+    for (int i = 0; i < 500; i++) {
+      int id = i * 37 % 500;
+      std::string name = "c" + std::to_string(id % 7);
+      values.push_back({std::make_shared<ConstantValueExpression>(Field(kTypeInt, id)),
+                        std::make_shared<ConstantValueExpression>(
+                            Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)),
+                        std::make_shared<ConstantValueExpression>(Field(kTypeFloat, static_cast<float>(id)))});
+    }
+    auto values_plan = std::make_shared<ValuesPlanNode>(nullptr, values);
+    auto insert_plan = std::make_shared<InsertPlanNode>(nullptr, values_plan, "c");
+    auto context = db_->MakeExecuteContext(nullptr);
+    auto insert = ExecuteEngine::CreateExecutor(context.get(), insert_plan);
+    insert->Init();
+    Row row;
+    RowId rid;
+    while (insert->Next(&row, &rid)) {
+    }
+  }
+
+  /**
+   * @param work_memory Work memory of the executors
+   * @param[out] runs Sorted runs the sort at the root of the plan spilled
+   * @return The rows of plan as text, in order
+   */
+  std::vector<std::string> Run(const AbstractPlanNodeRef &plan,
+                               size_t work_memory = ExecuteContext::DEFAULT_WORK_MEMORY, size_t *runs = nullptr) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    context->SetWorkMemory(work_memory);
+    auto executor = ExecuteEngine::CreateExecutor(context.get(), plan);
+    executor->Init();
+    std::vector<std::string> result;
+    DataChunk chunk;
+    Row row;
+    while (executor->NextBatch(&chunk)) {
+      EXPECT_GT(chunk.GetSelectedCount(), 0);
+      for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+        chunk.GetRow(i, &row);
+        std::string text;
+        for (const auto field : row.GetFields()) {
+          text += "|" + field->toString();
+        }
+        result.push_back(text);
+      }
+    }
+    if (runs != nullptr) {
+      *runs = dynamic_cast<SortExecutor *>(executor.get())->GetRunCount();
+    }
+    // limit提前结束时索引扫描还停在叶子上，executor析构后才放开
+    executor.reset();
+    EXPECT_TRUE(db_->bpm_->CheckAllUnpinned());
+    return result;
+  }
+
+  std::vector<std::string> Run(const std::string &sql) { return Run(Plan(sql)); }
+
+  /** @return The id, val and name of items, sorted by less, as the rows of "select id, val, name" */
+  template <typename Less>
+  std::vector<std::string> Expected(Less less, size_t limit = SIZE_MAX) const {
+    std::vector<Item> sorted(items_);
+    std::stable_sort(sorted.begin(), sorted.end(), less);
+    std::vector<std::string> rows;
+    for (size_t i = 0; i < sorted.size() && i < limit; i++) {
+      const Item &item = sorted[i];
+      std::string name = item.name;
+      rows.push_back("|" + Field(kTypeInt, item.id).toString() + "|" +
+                     (item.val_null ? Field(kTypeInt) : Field(kTypeInt, item.val)).toString() + "|" +
+                     Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true).toString());
+    }
+    return rows;
+  }
+
+  /** Null first, then by value */
+  static int CompareVal(const Item &lhs, const Item &rhs) {
+    if (lhs.val_null || rhs.val_null) {
+      return lhs.val_null == rhs.val_null ? 0 : (lhs.val_null ? -1 : 1);
+    }
+    return lhs.val < rhs.val ? -1 : (lhs.val > rhs.val ? 1 : 0);
+  }
+
+ protected:
+  const int row_count_ = 20000;
+  std::vector<Item> items_;
+};
+
+#endif  // MINISQL_SORT_TEST_UTIL_H
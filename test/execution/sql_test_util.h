@@ -0,0 +1,83 @@
+#ifndef MINISQL_SQL_TEST_UTIL_H
+#define MINISQL_SQL_TEST_UTIL_H
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "planner/planner.h"
+
+extern "C" {
+int yyparse(void);
+#include "parser/minisql_lex.h"
+#include "parser/parser.h"
+}
+
+/**
+ * Base of the tests that parse and plan sql statements against db_, which the test opens in SetUp
+ * and the base closes in TearDown.
+ */
+class SqlTest : public ::testing::Test {
+ public:
+  void TearDown() override {
+    delete db_;
+    db_ = nullptr;
+  }
+
+  /** Parse a statement and hand its syntax tree to work, null on a syntax error. */
+  static void Parse(const std::string &sql, const std::function<void(pSyntaxNode)> &work) {
+    YY_BUFFER_STATE bp = yy_scan_string(sql.c_str());
+    yy_switch_to_buffer(bp);
+    MinisqlParserInit();
+    yyparse();
+    work(MinisqlParserGetError() ? nullptr : MinisqlGetParserRootNode());
+    MinisqlParserFinish();
+    yy_delete_buffer(bp);
+    yylex_destroy();
+  }
+
+  /** @return Type of the root of the syntax tree, kNodeUnknown on a syntax error */
+  static SyntaxNodeType ParseType(const std::string &sql) {
+    SyntaxNodeType type = kNodeUnknown;
+    Parse(sql, [&type](pSyntaxNode ast) { type = ast == nullptr ? kNodeUnknown : ast->type_; });
+    return type;
+  }
+
+  /** Check that sql does not parse */
+  static void ExpectParseError(const std::string &sql) {
+    Parse(sql, [&sql](pSyntaxNode ast) { EXPECT_EQ(nullptr, ast) << sql; });
+  }
+
+  /** Plan a statement the way the execute engine does, with the settings of context. */
+  static AbstractPlanNodeRef Plan(ExecuteContext *context, const std::string &sql) {
+    Planner planner(context);
+    Parse(sql, [&planner, &sql](pSyntaxNode ast) {
+      ASSERT_NE(nullptr, ast) << sql;
+      planner.PlanQuery(ast);
+    });
+    return planner.plan_;
+  }
+
+  AbstractPlanNodeRef Plan(const std::string &sql) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    return Plan(context.get(), sql);
+  }
+
+  /** Check that sql parses but planning it fails */
+  void ExpectPlanError(const std::string &sql) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    Planner planner(context.get());
+    Parse(sql, [&planner, &sql](pSyntaxNode ast) {
+      ASSERT_NE(nullptr, ast) << sql;
+      EXPECT_THROW(planner.PlanQuery(ast), std::logic_error) << sql;
+    });
+  }
+
+ protected:
+  DBStorageEngine *db_{nullptr};
+};
+
+#endif  // MINISQL_SQL_TEST_UTIL_H
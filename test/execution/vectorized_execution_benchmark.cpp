@@ -0,0 +1,48 @@
+#include <chrono>
+
+#include "vectorized_execution_test_util.h"  // NOLINT
+
+/**
+ * Scan, filter and project: the row at a time iterator against the batches of column vectors, read
+ * by a consumer that only counts them and sums one column.
+ */
+TEST_F(VectorizedExecutionTest, ScanFilterProjectBenchmark) {
+  auto plan = Plan("select id, price from t where price > 10 and price < 60;");
+  ASSERT_EQ(PlanType::SeqScan, plan->GetType());
+  auto context = db_->MakeExecuteContext(nullptr);
+  const int repeat = 5;
+  size_t row_count = 0, batch_count = 0;
+  int64_t row_sum = 0, batch_sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; i++) {
+    auto executor = MakeExecutor(context.get(), plan);
+    executor->Init();
+    Row row;
+    RowId rid;
+    while (executor->Next(&row, &rid)) {
+      int32_t id;
+      row.GetField(0)->SerializeTo(reinterpret_cast<char *>(&id));
+      row_sum += id;
+      row_count++;
+    }
+  }
+  double row_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; i++) {
+    auto executor = MakeExecutor(context.get(), plan);
+    executor->Init();
+    DataChunk chunk;
+    while (executor->NextBatch(&chunk)) {
+      const int32_t *ids = chunk.GetColumn(0).GetInts();
+      for (size_t j = 0; j < chunk.GetSelectedCount(); j++) {
+        batch_sum += ids[chunk.GetSelected(j)];
+      }
+      batch_count += chunk.GetSelectedCount();
+    }
+  }
+  double batch_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  ASSERT_EQ(row_count, batch_count);
+  ASSERT_EQ(row_sum, batch_sum);
+  std::cout << "scan filter project of " << row_count / repeat << " rows: Next " << row_time / repeat
+            << " ms, NextBatch " << batch_time / repeat << " ms, " << row_time / batch_time << "x" << std::endl;
+}
@@ -0,0 +1,111 @@
+#include "vectorized_execution_test_util.h"  // NOLINT
+
+TEST_F(VectorizedExecutionTest, DataChunkTest) {
+  Schema *schema = table_info_->GetSchema();
+  DataChunk chunk;
+  chunk.Reset(schema);
+  char buf[PAGE_SIZE];
+  for (int i = 0; i < 100; i++) {
+    std::vector<Field> fields;
+    MakeFields(i, fields);
+    Row row(fields);
+    uint32_t size = row.SerializeTo(buf, schema);
+    if (i % 2 == 0) {
+      ASSERT_EQ(size, chunk.AppendSerialized(buf, RowId(1, i)));
+    } else {
+      chunk.AppendRow(row, RowId(1, i));
+    }
+  }
+  ASSERT_EQ(100, chunk.GetSize());
+  ASSERT_EQ(100, chunk.GetSelectedCount());
+  Row row;
+  for (int i = 0; i < 100; i++) {
+    std::vector<Field> fields;
+    MakeFields(i, fields);
+    chunk.GetRow(i, &row);
+    ASSERT_EQ(ToString(Row(fields), RowId(1, i)), ToString(row, row.GetRowId()));
+  }
+  // 和Field的比较结果一致，null不满足任何比较
+  const std::vector<std::string> comparisons{"=", "<>", "<", "<=", ">", ">="};
+  std::vector<Field> constants;
+  constants.emplace_back(kTypeInt, 5);
+  constants.emplace_back(kTypeFloat, 42.5f);
+  std::string name = "name-50";
+  constants.emplace_back(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true);
+  for (uint32_t column = 1; column < 4; column++) {
+    const Field &constant = constants[column - 1];
+    for (const auto &comparison : comparisons) {
+      std::vector<uint32_t> selection(chunk.GetSelection());
+      ASSERT_TRUE(chunk.GetColumn(column).SelectCompare(ComparisonExpression::Str2CompareOp(comparison), constant, selection));
+      std::vector<uint32_t> expected;
+      for (uint32_t i = 0; i < 100; i++) {
+        chunk.GetRowAt(i, &row);
+        auto predicate = std::make_shared<ComparisonExpression>(
+            std::make_shared<ColumnValueExpression>(0, column, constant.GetTypeId()),
+            std::make_shared<ConstantValueExpression>(constant), comparison);
+        if (predicate->Evaluate(&row).CompareEquals(Field(kTypeInt, 1)) == CmpBool::kTrue) {
+          expected.push_back(i);
+        }
+      }
+      ASSERT_EQ(expected, selection) << column << " " << comparison;
+    }
+  }
+  std::vector<uint32_t> nulls(chunk.GetSelection());
+  chunk.GetColumn(2).SelectNull(true, nulls);
+  ASSERT_EQ(15, nulls.size());
+  // 投影选中的行
+  chunk.GetSelection() = {3, 50, 99};
+  DataChunk projected;
+  std::vector<Column *> columns{new Column("name", TypeId::kTypeChar, 16, 0, true, false),
+                                new Column("id", TypeId::kTypeInt, 1, false, true)};
+  Schema out_schema(columns);
+  projected.Reset(&out_schema);
+  projected.AppendSelected(chunk, {3, 0});
+  ASSERT_EQ(3, projected.GetSelectedCount());
+  projected.GetRow(1, &row);
+  ASSERT_EQ(RowId(1, 50).Get(), row.GetRowId().Get());
+  ASSERT_EQ("name-50", row.GetField(0)->toString());
+  ASSERT_EQ("50", row.GetField(1)->toString());
+  projected.GetRow(2, &row);
+  ASSERT_EQ("NULL", row.GetField(0)->toString());
+}
+
+/**
+ * Every scan gives the same rows in the same order through NextBatch() as through Next(), with and
+ * without projection, nulls and chars.
+ */
+TEST_F(VectorizedExecutionTest, ScanTest) {
+  const std::vector<std::pair<std::string, size_t>> queries{
+      {"select * from t;", 20000},
+      {"select * from t where grp = 3;", 2000},
+      {"select name, id from t where price < 10;", 1714},
+      {"select * from t where name = \"name-7\";", 189},
+      {"select id from t where price is null;", 2858},
+      {"select id, name from t where name not null and grp <> 0;", 16363},
+      {"select * from t where name > \"name-90\" or grp = 1 and id < 1000;", 148},
+      {"select * from t where id >= 19000;", 1000},
+      {"select * from t where id < 100 or id > 19950;", 149},
+      {"select * from t where id = 12345;", 1},
+      {"select * from t where id = 5 and grp = 4;", 0}};
+  for (int analyzed = 0; analyzed < 2; analyzed++) {
+    for (const auto &query : queries) {
+      auto plan = Plan(query.first);
+      auto rows = RunRows(plan);
+      ASSERT_EQ(query.second, rows.size()) << query.first;
+      ASSERT_EQ(rows, RunBatches(plan)) << query.first << " " << plan->ToString();
+    }
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  }
+  ASSERT_EQ(PlanType::BitmapHeapScan, Plan("select * from t where grp = 3;")->GetType());
+}
+
+TEST_F(VectorizedExecutionTest, DmlTest) {
+  ASSERT_EQ(2000, RunBatches(Plan("delete from t where grp = 3;")).size());
+  ASSERT_EQ(0, RunBatches(Plan("select * from t where grp = 3;")).size());
+  ASSERT_EQ(1000, RunBatches(Plan("update t set grp = 3 where grp = 4 and id < 10000;")).size());
+  ASSERT_EQ(1000, RunBatches(Plan("select * from t where grp = 3;")).size());
+  ASSERT_EQ(1000, RunRows(Plan("select * from t where grp = 4;")).size());
+  auto deleted = RunBatches(Plan("delete from t where id < 10;"));
+  ASSERT_EQ(9, deleted.size());
+  ASSERT_EQ(RunBatches(Plan("select * from t;")).size(), 17991);
+}
@@ -0,0 +1,126 @@
+#ifndef MINISQL_VECTORIZED_EXECUTION_TEST_UTIL_H
+#define MINISQL_VECTORIZED_EXECUTION_TEST_UTIL_H
+
+#include <string>
+
+#include "executor/executors/bitmap_heap_scan_executor.h"
+#include "executor/executors/delete_executor.h"
+#include "executor/executors/index_scan_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "executor/executors/update_executor.h"
+#include "sql_test_util.h"  // NOLINT
+
+/**
+ * Heap table t(id int unique, grp int, price float, name char(16)) with 20000 rows, grp = id % 10,
+ * price = id % 100 + 0.5 and name = "name-" + id % 97. Every 7th price and every 11th name is null.
+ * b+ tree indexes on id and grp.
+ */
+class VectorizedExecutionTest : public SqlTest {
+ public:
+  void SetUp() override {
+    db_ = new DBStorageEngine("vectorized_execution_test.db", true);
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, true),
+                                     new Column("grp", TypeId::kTypeInt, 1, true, false),
+                                     new Column("price", TypeId::kTypeFloat, 2, true, false),
+                                     new Column("name", TypeId::kTypeChar, 16, 3, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info_));
+    for (int i = 0; i < n_; i++) {
+      std::vector<Field> fields;
+      MakeFields(i, fields);
+      Row row(fields);
+      ASSERT_TRUE(table_info_->InsertTuple(row, nullptr));
+    }
+    IndexInfo *index_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_grp", {"grp"}, nullptr, index_info, "bptree"));
+  }
+
+  static void MakeFields(int i, std::vector<Field> &fields) {
+    std::string name = "name-" + std::to_string(i % 97);
+    fields.emplace_back(TypeId::kTypeInt, i);
+    fields.emplace_back(TypeId::kTypeInt, i % 10);
+    if (i % 7 == 0) {
+      fields.emplace_back(TypeId::kTypeFloat);
+    } else {
+      fields.emplace_back(TypeId::kTypeFloat, static_cast<float>(i % 100 + 0.5));
+    }
+    if (i % 11 == 0) {
+      fields.emplace_back(TypeId::kTypeChar);
+    } else {
+      fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true);
+    }
+  }
+
+  static std::unique_ptr<AbstractExecutor> MakeExecutor(ExecuteContext *context, const AbstractPlanNodeRef &plan) {
+    switch (plan->GetType()) {
+      case PlanType::SeqScan:
+        return std::make_unique<SeqScanExecutor>(context, dynamic_cast<const SeqScanPlanNode *>(plan.get()));
+      case PlanType::IndexScan:
+        return std::make_unique<IndexScanExecutor>(context, dynamic_cast<const IndexScanPlanNode *>(plan.get()));
+      case PlanType::BitmapHeapScan:
+        return std::make_unique<BitmapHeapScanExecutor>(context,
+                                                        dynamic_cast<const BitmapHeapScanPlanNode *>(plan.get()));
+      case PlanType::Delete: {
+        auto delete_plan = dynamic_cast<const DeletePlanNode *>(plan.get());
+        return std::make_unique<DeleteExecutor>(context, delete_plan,
+                                                MakeExecutor(context, delete_plan->GetChildPlan()));
+      }
+      case PlanType::Update: {
+        auto update_plan = dynamic_cast<const UpdatePlanNode *>(plan.get());
+        return std::make_unique<UpdateExecutor>(context, update_plan,
+                                                MakeExecutor(context, update_plan->GetChildPlan()));
+      }
+      default:
+        ADD_FAILURE() << "unexpected plan";
+        return nullptr;
+    }
+  }
+
+  /** @return The rows of plan pulled with Next(), as text */
+  std::vector<std::string> RunRows(const AbstractPlanNodeRef &plan) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    auto executor = MakeExecutor(context.get(), plan);
+    executor->Init();
+    std::vector<std::string> result;
+    Row row;
+    RowId rid;
+    while (executor->Next(&row, &rid)) {
+      result.push_back(ToString(row, rid));
+    }
+    return result;
+  }
+
+  /** @return The rows of plan pulled with NextBatch(), as text */
+  std::vector<std::string> RunBatches(const AbstractPlanNodeRef &plan) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    auto executor = MakeExecutor(context.get(), plan);
+    executor->Init();
+    std::vector<std::string> result;
+    DataChunk chunk;
+    Row row;
+    while (executor->NextBatch(&chunk)) {
+      EXPECT_LE(chunk.GetSize(), DataChunk::CAPACITY);
+      EXPECT_GT(chunk.GetSelectedCount(), 0);
+      for (size_t i = 0; i < chunk.GetSelectedCount(); i++) {
+        chunk.GetRow(i, &row);
+        result.push_back(ToString(row, row.GetRowId()));
+      }
+    }
+    return result;
+  }
+
+  static std::string ToString(const Row &row, const RowId &rid) {
+    std::string text = std::to_string(rid.Get());
+    for (auto field : const_cast<Row &>(row).GetFields()) {
+      text += "|" + field->toString();
+    }
+    return text;
+  }
+
+ protected:
+  const int n_ = 20000;
+  TableInfo *table_info_{nullptr};
+};
+
+#endif  // MINISQL_VECTORIZED_EXECUTION_TEST_UTIL_H
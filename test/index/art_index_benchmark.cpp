@@ -0,0 +1,83 @@
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/art_index.h"
+#include "index/b_plus_tree_index.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "art_index_benchmark.db";
+
+static Row MakeIntKey(int value) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+  return Row(fields);
+}
+
+TEST(ArtIndexTests, BPlusTreeBenchmark) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{0};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  auto *bptree = new BPlusTreeIndex(0, key_schema, 16, engine.bpm_);
+  auto *art = new ArtIndex(1, key_schema);
+  const int n = 200000;
+  std::vector<int> seq(n);
+  for (int i = 0; i < n; i++) {
+    seq[i] = i;
+  }
+  ShuffleArray(seq);
+  auto time = [](const std::function<void()> &work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  auto insert = [&](Index *index) {
+    return time([&]() {
+      for (int i : seq) {
+        ASSERT_EQ(DB_SUCCESS, index->InsertEntry(MakeIntKey(i), RowId(i, 0), nullptr));
+      }
+    });
+  };
+  auto lookup = [&](Index *index) {
+    return time([&]() {
+      std::vector<RowId> result;
+      for (int i : seq) {
+        result.clear();
+        index->ScanKey(MakeIntKey(i), result, nullptr, "=");
+        ASSERT_EQ(RowId(i, 0), result[0]);
+      }
+    });
+  };
+  double bptree_insert = insert(bptree), art_insert = insert(art);
+  ShuffleArray(seq);
+  double bptree_lookup = lookup(bptree), art_lookup = lookup(art);
+  // 1000次范围查询，每次从随机位置开始读1000条
+  auto bptree_range = time([&]() {
+    for (int i = 0; i < 1000; i++) {
+      auto iter = bptree->GetLowerBoundIterator(MakeIntKey(seq[i] % (n - 1000)));
+      for (int j = 0; j < 1000; j++, ++iter) {
+        ASSERT_EQ(seq[i] % (n - 1000) + j, (*iter).second.GetPageId());
+      }
+    }
+  });
+  auto art_range = time([&]() {
+    for (int i = 0; i < 1000; i++) {
+      auto iter = art->GetLowerBoundIterator(MakeIntKey(seq[i] % (n - 1000)));
+      for (int j = 0; j < 1000; j++, ++iter) {
+        ASSERT_EQ(seq[i] % (n - 1000) + j, iter.Value().GetPageId());
+      }
+    }
+  });
+  std::cout << n << " inserts: b+ tree " << bptree_insert << " ms, art " << art_insert << " ms" << std::endl;
+  std::cout << n << " point lookups: b+ tree " << bptree_lookup << " ms, art " << art_lookup << " ms" << std::endl;
+  std::cout << "1000 range scans: b+ tree " << bptree_range << " ms, art " << art_range << " ms" << std::endl;
+  std::cout << "art memory: " << art->GetMemoryUsage() / 1024 << " KB" << std::endl;
+  bptree->Destroy();
+  art->Destroy();
+  delete bptree;
+  delete art;
+  delete key_schema;
+}
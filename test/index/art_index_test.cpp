@@ -0,0 +1,228 @@
+#include "index/art_index.h"
+
+#include <map>
+#include <random>
+#include <string>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+
+static const std::string db_name = "art_index_test.db";
+
+static Row MakeIntKey(int value) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+  return Row(fields);
+}
+
+/**
+ * Random inserts, removes and lower bounds checked against std::map. The keys share long
+ * prefixes and up to 256 children per byte, so every node type, path compression longer
+ * than MAX_PREFIX_LEN and the shrinking back are exercised.
+ */
+TEST(ArtIndexTests, RadixTreeTest) {
+  std::mt19937 rng(20240612);
+  std::vector<std::string> keys;
+  for (int i = 0; i < 20000; i++) {
+    std::string key(rng() % 3 == 0 ? "a-very-long-common-prefix/" : "b/");
+    int len = 1 + rng() % 4;
+    for (int j = 0; j < len; j++) {
+      key.push_back(static_cast<char>(j == 0 ? rng() % 256 : rng() % 4));
+    }
+    // 以不在其他位置出现的字节结尾，保证key之间没有前缀关系
+    key.push_back('\xFF');
+    key.push_back('\xFF');
+    keys.push_back(key);
+  }
+  AdaptiveRadixTree tree;
+  std::map<std::string, RowId> expected;
+  for (size_t i = 0; i < keys.size(); i++) {
+    bool inserted = expected.emplace(keys[i], RowId(i, 0)).second;
+    ASSERT_EQ(inserted, tree.Insert(keys[i], RowId(i, 0)));
+  }
+  ASSERT_EQ(expected.size(), tree.GetSize());
+  auto check = [&]() {
+    auto iter = tree.Begin();
+    for (auto &entry : expected) {
+      ASSERT_FALSE(iter.IsEnd());
+      ASSERT_EQ(entry.first, iter.Key());
+      ASSERT_EQ(entry.second, iter.Value());
+      ++iter;
+    }
+    ASSERT_TRUE(iter.IsEnd());
+    for (int i = 0; i < 2000; i++) {
+      std::string target = keys[rng() % keys.size()];
+      target.resize(rng() % (target.size() + 1));
+      if (rng() % 2 == 0) {
+        target.push_back(static_cast<char>(rng() % 256));
+      }
+      auto lower = tree.LowerBound(target);
+      auto map_lower = expected.lower_bound(target);
+      if (map_lower == expected.end()) {
+        ASSERT_TRUE(lower.IsEnd());
+      } else {
+        ASSERT_FALSE(lower.IsEnd());
+        ASSERT_EQ(map_lower->first, lower.Key());
+      }
+    }
+  };
+  check();
+  RowId value;
+  for (size_t i = 0; i < keys.size(); i += 3) {
+    ASSERT_EQ(expected.erase(keys[i]) == 1, tree.Remove(keys[i]));
+    ASSERT_FALSE(tree.GetValue(keys[i], value));
+  }
+  ASSERT_EQ(expected.size(), tree.GetSize());
+  for (auto &entry : expected) {
+    ASSERT_TRUE(tree.GetValue(entry.first, value));
+    ASSERT_EQ(entry.second, value);
+  }
+  check();
+  size_t memory = tree.GetMemoryUsage();
+  for (auto &key : keys) {
+    tree.Remove(key);
+  }
+  ASSERT_EQ(0, tree.GetSize());
+  ASSERT_TRUE(tree.Begin().IsEnd());
+  ASSERT_EQ(0, tree.GetMemoryUsage());
+  ASSERT_GT(memory, 0);
+}
+
+TEST(ArtIndexTests, EncodeKeyTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                   new Column("name", TypeId::kTypeChar, 16, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  Schema schema(columns);
+  char names[][4] = {"", "a", "ab", "b", {'a', '\0', 'c'}};
+  std::vector<Row> rows;
+  for (int id : {-100000, -1, 0, 7, 100000}) {
+    for (int n = 0; n < 5; n++) {
+      for (float account : {-3.5f, -0.0f, 0.0f, 1e-10f, 2.25f}) {
+        std::vector<Field> fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeChar, names[n], n == 4 ? 3 : strlen(names[n]), true),
+                                  Field(TypeId::kTypeFloat, account)};
+        rows.emplace_back(fields);
+      }
+    }
+  }
+  std::vector<Field> null_fields{Field(TypeId::kTypeInt), Field(TypeId::kTypeChar), Field(TypeId::kTypeFloat)};
+  rows.emplace_back(null_fields);
+  auto compare_rows = [](const Row &lhs, const Row &rhs) {
+    for (uint32_t i = 0; i < lhs.GetFieldCount(); i++) {
+      Field *l = lhs.GetField(i), *r = rhs.GetField(i);
+      if (l->IsNull() || r->IsNull()) {
+        if (l->IsNull() != r->IsNull()) {
+          return l->IsNull() ? -1 : 1;
+        }
+        continue;
+      }
+      if (l->CompareLessThan(*r) == CmpBool::kTrue) {
+        return -1;
+      }
+      if (l->CompareGreaterThan(*r) == CmpBool::kTrue) {
+        return 1;
+      }
+    }
+    return 0;
+  };
+  for (auto &lhs : rows) {
+    std::string lhs_key = ArtIndex::EncodeKey(lhs, &schema);
+    for (auto &rhs : rows) {
+      std::string rhs_key = ArtIndex::EncodeKey(rhs, &schema);
+      int expected = compare_rows(lhs, rhs);
+      int actual = lhs_key.compare(rhs_key);
+      ASSERT_EQ(expected, actual < 0 ? -1 : (actual > 0 ? 1 : 0));
+    }
+  }
+}
+
+TEST(ArtIndexTests, ScanKeyTest) {
+  std::vector<Column *> columns = {new Column("score", TypeId::kTypeInt, 0, true, false)};
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{0};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  ArtIndex index(0, key_schema, false);
+  const int n = 3000;
+  // score = i % 100 - 50，每个值30条记录，另有10条null
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(DB_SUCCESS, index.InsertEntry(MakeIntKey(i % 100 - 50), RowId(i, 0), nullptr));
+  }
+  for (int i = n; i < n + 10; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt)};
+    ASSERT_EQ(DB_SUCCESS, index.InsertEntry(Row(fields), RowId(i, 0), nullptr));
+  }
+  ASSERT_EQ(DB_FAILED, index.InsertEntry(MakeIntKey(-50), RowId(0, 0), nullptr));
+  auto expected_count = [&](int value, const std::string &op) {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+      int score = i % 100 - 50;
+      count += (op == "=" && score == value) || (op == "<" && score < value) || (op == "<=" && score <= value) ||
+               (op == ">" && score > value) || (op == ">=" && score >= value) || (op == "<>" && score != value);
+    }
+    return count;
+  };
+  for (int value : {-60, -50, -1, 0, 13, 49, 60}) {
+    for (std::string op : {"=", "<", "<=", ">", ">=", "<>"}) {
+      std::vector<RowId> result;
+      index.ScanKey(MakeIntKey(value), result, nullptr, op);
+      ASSERT_EQ(expected_count(value, op), result.size()) << value << " " << op;
+      for (auto rid : result) {
+        ASSERT_LT(rid.GetPageId(), n);
+      }
+    }
+  }
+  for (int i = 0; i < n; i += 2) {
+    ASSERT_EQ(DB_SUCCESS, index.RemoveEntry(MakeIntKey(i % 100 - 50), RowId(i, 0), nullptr));
+  }
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index.ScanKey(MakeIntKey(-50), result, nullptr, "="));
+  ASSERT_EQ(DB_SUCCESS, index.ScanKey(MakeIntKey(-49), result, nullptr, "="));
+  ASSERT_EQ(30, result.size());
+  ASSERT_EQ(DB_SUCCESS, index.Destroy());
+  ASSERT_TRUE(index.GetBeginIterator().IsEnd());
+  delete key_schema;
+}
+
+/**
+ * The index is not persisted, reloading the catalog rebuilds it from the table heap.
+ */
+TEST(ArtIndexTests, CatalogRebuildTest) {
+  auto db_01 = new DBStorageEngine(db_name, true);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 16, 1, true, true)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info));
+  char name[16];
+  for (int i = 0; i < 500; i++) {
+    int len = snprintf(name, sizeof(name), "name-%d", i);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, len, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("t", "t_name", {"name"}, nullptr, index_info, "art"));
+  ASSERT_EQ("art", index_info->GetIndexType());
+  ASSERT_TRUE(index_info->IsUnique());
+  std::vector<Field> duplicate{Field(TypeId::kTypeChar, const_cast<char *>("name-7"), 6, true)};
+  ASSERT_EQ(DB_FAILED, index_info->GetIndex()->InsertEntry(Row(duplicate), RowId(1, 1), nullptr));
+  delete db_01;
+  auto db_02 = new DBStorageEngine(db_name, false);
+  ASSERT_EQ(DB_SUCCESS, db_02->catalog_mgr_->GetIndex("t", "t_name", index_info));
+  auto index = dynamic_cast<ArtIndex *>(index_info->GetIndex());
+  ASSERT_NE(nullptr, index);
+  for (int i = 0; i < 500; i++) {
+    int len = snprintf(name, sizeof(name), "name-%d", i);
+    std::vector<Field> fields{Field(TypeId::kTypeChar, name, len, true)};
+    std::vector<RowId> result;
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(Row(fields), result, nullptr));
+    ASSERT_EQ(1, result.size());
+  }
+  // 除name-0外都>= name-1，< name-2的是name-0, name-1, name-10 ... name-199
+  std::vector<Field> low{Field(TypeId::kTypeChar, const_cast<char *>("name-1"), 6, true)};
+  std::vector<Field> high{Field(TypeId::kTypeChar, const_cast<char *>("name-2"), 6, true)};
+  std::vector<RowId> ge, lt;
+  index->ScanKey(Row(low), ge, nullptr, ">=");
+  index->ScanKey(Row(high), lt, nullptr, "<");
+  ASSERT_EQ(499, ge.size());
+  ASSERT_EQ(112, lt.size());
+  delete db_02;
+}
@@ -70,4 +70,81 @@ TEST(BPlusTreeTests, SampleTest) {
     ASSERT_EQ(kv_map[delete_seq[i]], ans[ans.size() - 1]);
   }
   ASSERT_TRUE(tree.Check());
-}
\ No newline at end of file
+}
+
+TEST(BPlusTreeTests, StringKeyTest) {
+  DBStorageEngine engine("bp_tree_string_key_test.db");
+  std::vector<Column *> columns = {
+      new Column("name", TypeId::kTypeChar, 64, 0, false, false),
+  };
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 128);
+  BPlusTree tree(0, engine.bpm_, KP);
+  // keys sharing long prefixes, as in most string indexes
+  const int n = 20000;
+  vector<GenericKey *> keys;
+  char name[64];
+  for (int i = 0; i < n; i++) {
+    int len = snprintf(name, sizeof(name), "customer-%06d-account-%s", i, (i % 2) ? "checking" : "savings");
+    GenericKey *key = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeChar, name, len, true)};
+    KP.SerializeFromKey(key, Row(fields), table_schema);
+    keys.push_back(key);
+  }
+  vector<int> insert_seq(n);
+  for (int j = 0; j < n; j++) {
+    insert_seq[j] = j;
+  }
+  ShuffleArray(insert_seq);
+  for (int j : insert_seq) {
+    ASSERT_TRUE(tree.Insert(keys[j], RowId(j)));
+  }
+  ASSERT_FALSE(tree.Insert(keys[0], RowId(0)));
+  ASSERT_TRUE(tree.Check());
+  std::cout << n << " char(64) keys: height " << tree.GetHeight() << ", pages " << tree.GetPageCount() << std::endl;
+  // range scan returns the keys in order
+  int i = 0;
+  for (auto iter = tree.Begin(); iter != tree.End(); ++iter, ++i) {
+    ASSERT_EQ(0, KP.CompareKeys((*iter).first, keys[i]));
+  }
+  ASSERT_EQ(n, i);
+  // decoding keys leaves the page as is, every decoded key stays valid
+  auto page = engine.bpm_->FetchPage(tree.Begin().GetPageId());
+  auto leaf = reinterpret_cast<BPlusTreeLeafPage *>(page->GetData());
+  std::string before(page->GetData(), PAGE_SIZE);
+  vector<GenericKey *> decoded;
+  for (int j = 0; j < leaf->GetSize(); j++) {
+    decoded.push_back(leaf->KeyAt(j, KP.InitKey()));
+  }
+  ASSERT_EQ(before, std::string(page->GetData(), PAGE_SIZE));
+  for (int j = 0; j < leaf->GetSize(); j++) {
+    ASSERT_EQ(0, KP.CompareKeys(decoded[j], keys[j]));
+    free(decoded[j]);
+  }
+  engine.bpm_->UnpinPage(page->GetPageId(), false);
+  vector<RowId> ans;
+  for (int j = 0; j < n; j++) {
+    ASSERT_TRUE(tree.GetValue(keys[j], ans));
+    ASSERT_EQ(RowId(j), ans.back());
+  }
+  ASSERT_TRUE(tree.Check());
+  // delete half keys, then the rest
+  vector<GenericKey *> delete_seq(keys);
+  ShuffleArray(delete_seq);
+  for (int j = 0; j < n / 2; j++) {
+    tree.Remove(delete_seq[j]);
+  }
+  for (int j = 0; j < n; j++) {
+    ASSERT_EQ(j >= n / 2, tree.GetValue(delete_seq[j], ans));
+  }
+  ASSERT_TRUE(tree.Check());
+  for (int j = n / 2; j < n; j++) {
+    tree.Remove(delete_seq[j]);
+  }
+  ASSERT_TRUE(tree.IsEmpty());
+  ASSERT_TRUE(tree.Check());
+  for (auto key : keys) {
+    free(key);
+  }
+  delete table_schema;
+}
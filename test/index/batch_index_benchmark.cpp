@@ -0,0 +1,89 @@
+#include <chrono>
+#include <functional>
+
+#include "batch_index_test_util.h"  // NOLINT
+#include "utils/utils.h"
+
+/**
+ * Batches of 1024 keys as the DML executors use them, with random keys (a few keys per leaf)
+ * and with increasing keys (a batch fills the rightmost leaves, like inserts with a growing id).
+ */
+TEST_F(BatchIndexTests, BatchBenchmark) {
+  const int n = 100000;
+  const size_t batch = 1024;
+  auto time = [](const std::function<void()> &work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  for (bool shuffle : {true, false}) {
+    auto single = NewIndex(0, true);
+    auto batched = NewIndex(0, true);
+    std::vector<int> seq(n);
+    for (int i = 0; i < n; i++) {
+      seq[i] = i;
+    }
+    if (shuffle) {
+      ShuffleArray(seq);
+    }
+    std::vector<Row> keys;
+    std::vector<RowId> rids;
+    std::vector<std::vector<Row>> key_batches;
+    std::vector<std::vector<RowId>> rid_batches;
+    for (int i = 0; i < n; i++) {
+      keys.push_back(MakeIntKey(seq[i]));
+      rids.emplace_back(seq[i], 0);
+      if (i % batch == 0) {
+        key_batches.emplace_back();
+        rid_batches.emplace_back();
+      }
+      key_batches.back().push_back(keys.back());
+      rid_batches.back().push_back(rids.back());
+    }
+    double single_insert = time([&]() {
+      for (int i = 0; i < n; i++) {
+        single->InsertEntry(keys[i], rids[i], nullptr);
+      }
+    });
+    double batched_insert = time([&]() {
+      for (size_t i = 0; i < key_batches.size(); i++) {
+        batched->InsertEntries(key_batches[i], rid_batches[i], nullptr);
+      }
+    });
+    double single_lookup = time([&]() {
+      for (int i = 0; i < n; i++) {
+        std::vector<RowId> result;
+        single->ScanKey(keys[i], result, nullptr, "=");
+        ASSERT_EQ(1, result.size());
+      }
+    });
+    double batched_lookup = time([&]() {
+      for (const auto &key_batch : key_batches) {
+        std::vector<std::vector<RowId>> results;
+        batched->LookupMany(key_batch, results, nullptr);
+        for (const auto &result : results) {
+          ASSERT_EQ(1, result.size());
+        }
+      }
+    });
+    double single_remove = time([&]() {
+      for (int i = 0; i < n; i++) {
+        single->RemoveEntry(keys[i], rids[i], nullptr);
+      }
+    });
+    double batched_remove = time([&]() {
+      for (size_t i = 0; i < key_batches.size(); i++) {
+        batched->RemoveEntries(key_batches[i], rid_batches[i], nullptr);
+      }
+    });
+    std::cout << n << (shuffle ? " random" : " increasing") << " keys, one by one vs batches of " << batch
+              << std::endl;
+    std::cout << "  insert: " << single_insert << " ms vs " << batched_insert << " ms" << std::endl;
+    std::cout << "  lookup: " << single_lookup << " ms vs " << batched_lookup << " ms" << std::endl;
+    std::cout << "  remove: " << single_remove << " ms vs " << batched_remove << " ms" << std::endl;
+    single->Destroy();
+    batched->Destroy();
+    delete single;
+    delete batched;
+  }
+}
@@ -0,0 +1,112 @@
+#include "batch_index_test_util.h"  // NOLINT
+#include "utils/utils.h"
+
+/**
+ * Batches in random order, the batch is sorted before it goes to the tree and the results
+ * come back in the order of the batch.
+ */
+TEST_F(BatchIndexTests, UniqueTest) {
+  auto index = NewIndex(0, true);
+  const int n = 20000;
+  std::vector<int> seq(n);
+  for (int i = 0; i < n; i++) {
+    seq[i] = 2 * i;
+  }
+  ShuffleArray(seq);
+  std::vector<Row> keys;
+  std::vector<RowId> rids;
+  for (int v : seq) {
+    keys.push_back(MakeIntKey(v));
+    rids.emplace_back(v, 0);
+  }
+  ASSERT_EQ(DB_SUCCESS, index->InsertEntries(keys, rids, nullptr));
+  // 与已有key重复，或者与同一批中的key重复
+  ASSERT_EQ(DB_FAILED, index->InsertEntries({MakeIntKey(1), MakeIntKey(4), MakeIntKey(3), MakeIntKey(3)},
+                                            {RowId(1, 0), RowId(4, 1), RowId(3, 0), RowId(3, 1)}, nullptr));
+  std::vector<Row> probes;
+  for (int i = -10; i < 2 * n + 10; i++) {
+    probes.push_back(MakeIntKey(i));
+  }
+  ShuffleArray(probes);
+  std::vector<std::vector<RowId>> results;
+  ASSERT_EQ(DB_SUCCESS, index->LookupMany(probes, results, nullptr));
+  ASSERT_EQ(probes.size(), results.size());
+  for (size_t i = 0; i < probes.size(); i++) {
+    std::vector<RowId> expected;
+    index->ScanKey(probes[i], expected, nullptr, "=");
+    ASSERT_EQ(expected, results[i]);
+    int v;
+    probes[i].GetField(0)->SerializeTo(reinterpret_cast<char *>(&v));
+    bool present = (v >= 0 && v < 2 * n && v % 2 == 0) || v == 1 || v == 3;
+    ASSERT_EQ(present ? 1 : 0, results[i].size());
+  }
+  // 删除一半，树会合并
+  std::vector<Row> removed(keys.begin(), keys.begin() + n / 2);
+  std::vector<RowId> removed_rids(rids.begin(), rids.begin() + n / 2);
+  ASSERT_EQ(DB_SUCCESS, index->RemoveEntries(removed, removed_rids, nullptr));
+  ASSERT_EQ(DB_SUCCESS, index->LookupMany(keys, results, nullptr));
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(i < n / 2 ? 0 : 1, results[i].size());
+  }
+  // 全部删除后树为空
+  ASSERT_EQ(DB_SUCCESS, index->RemoveEntries(keys, rids, nullptr));
+  ASSERT_EQ(DB_SUCCESS, index->RemoveEntries({MakeIntKey(1), MakeIntKey(3)}, {RowId(1, 0), RowId(3, 0)}, nullptr));
+  ASSERT_EQ(DB_SUCCESS, index->LookupMany(keys, results, nullptr));
+  for (const auto &result : results) {
+    ASSERT_TRUE(result.empty());
+  }
+  index->Destroy();
+  ASSERT_TRUE(engine_->bpm_->CheckAllUnpinned());
+  delete index;
+}
+
+/**
+ * Equal keys of a non-unique index span several leaves, a lookup follows the leaf chain.
+ */
+TEST_F(BatchIndexTests, NonUniqueTest) {
+  auto index = NewIndex(1, false);
+  const int n = 20000;
+  std::vector<Row> keys;
+  std::vector<RowId> rids;
+  for (int i = 0; i < n; i++) {
+    // key i % 20 对应1000条记录，key 7只有一条
+    int grp = i % 20 == 7 && i != 7 ? 8 : i % 20;
+    keys.push_back(MakeIntKey(grp));
+    rids.emplace_back(i, 0);
+  }
+  ASSERT_EQ(DB_SUCCESS, index->InsertEntries(keys, rids, nullptr));
+  index->SetPinnedLevels(1);
+  std::vector<Row> probes;
+  for (int i = 25; i >= -5; i--) {
+    probes.push_back(MakeIntKey(i));
+  }
+  std::vector<std::vector<RowId>> results;
+  ASSERT_EQ(DB_SUCCESS, index->LookupMany(probes, results, nullptr));
+  for (size_t i = 0; i < probes.size(); i++) {
+    std::vector<RowId> expected;
+    index->ScanKey(probes[i], expected, nullptr, "=");
+    ASSERT_EQ(expected, results[i]);
+  }
+  ASSERT_EQ(1000, results[25 - 0].size());
+  ASSERT_EQ(1, results[25 - 7].size());
+  ASSERT_EQ(1999, results[25 - 8].size());
+  ASSERT_TRUE(results[25 - 20].empty());
+  // 按row id删除，其他相同key的记录保留
+  std::vector<Row> removed;
+  std::vector<RowId> removed_rids;
+  for (int i = 0; i < n; i += 3) {
+    removed.push_back(keys[i]);
+    removed_rids.push_back(rids[i]);
+  }
+  ASSERT_EQ(DB_SUCCESS, index->RemoveEntries(removed, removed_rids, nullptr));
+  ASSERT_EQ(DB_SUCCESS, index->LookupMany(probes, results, nullptr));
+  size_t total = 0;
+  for (const auto &result : results) {
+    total += result.size();
+  }
+  ASSERT_EQ(n - removed.size(), total);
+  index->SetPinnedLevels(0);
+  index->Destroy();
+  ASSERT_TRUE(engine_->bpm_->CheckAllUnpinned());
+  delete index;
+}
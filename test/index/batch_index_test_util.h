@@ -0,0 +1,42 @@
+#ifndef MINISQL_BATCH_INDEX_TEST_UTIL_H
+#define MINISQL_BATCH_INDEX_TEST_UTIL_H
+
+#include <memory>
+#include <vector>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/b_plus_tree_index.h"
+
+/** Table schema (id int, grp int) and b+ tree indexes on one of its columns. */
+class BatchIndexTests : public ::testing::Test {
+ public:
+  void SetUp() override {
+    engine_ = new DBStorageEngine("batch_index_test.db");
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                     new Column("grp", TypeId::kTypeInt, 1, true, false)};
+    table_schema_ = new Schema(columns);
+  }
+
+  void TearDown() override {
+    delete table_schema_;
+    delete engine_;
+  }
+
+  static Row MakeIntKey(int value) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+    return Row(fields);
+  }
+
+  BPlusTreeIndex *NewIndex(uint32_t column, bool unique) {
+    key_schemas_.emplace_back(Schema::ShallowCopySchema(table_schema_, {column}));
+    return new BPlusTreeIndex(0, key_schemas_.back().get(), 32, engine_->bpm_, unique);
+  }
+
+ protected:
+  DBStorageEngine *engine_{nullptr};
+  Schema *table_schema_{nullptr};
+  std::vector<std::unique_ptr<Schema>> key_schemas_;
+};
+
+#endif  // MINISQL_BATCH_INDEX_TEST_UTIL_H
@@ -0,0 +1,29 @@
+#include <chrono>
+
+#include "bloom_filter_test_util.h"  // NOLINT
+#include "utils/utils.h"
+
+TEST_F(IndexBloomFilterTests, InsertBenchmark) {
+  const int n = 20000;
+  std::vector<int> ids(n);
+  for (int i = 0; i < n; i++) {
+    ids[i] = i;
+  }
+  ShuffleArray(ids);
+  auto run = [&](DBStorageEngine *db) {
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(n, Insert(db, ids));
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  };
+  double with_filter = run(db_);
+  auto db = new DBStorageEngine("bloom_filter_test_off.db", true);
+  CreateTable(db);
+  for (auto name : {"t_id_UNIQUE", "t_code_UNIQUE", "t_name_UNIQUE"}) {
+    ASSERT_EQ(DB_SUCCESS, db->catalog_mgr_->SetIndexBloomFilter("t", name, false));
+  }
+  double without_filter = run(db);
+  delete db;
+  std::cout << n << " inserts into 3 unique indexes: " << static_cast<int>(n / without_filter)
+            << " rows/s without bloom filters, " << static_cast<int>(n / with_filter) << " rows/s with bloom filters"
+            << std::endl;
+}
@@ -0,0 +1,87 @@
+#include "bloom_filter_test_util.h"  // NOLINT
+#include "utils/utils.h"
+
+static Row IntKey(int value) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+  return Row(fields);
+}
+
+TEST(BloomFilterTests, FalsePositiveTest) {
+  const int n = 100000;
+  BloomFilter filter(BloomFilter::BlocksFor(n));
+  for (int i = 0; i < n; i++) {
+    filter.Insert(BloomFilter::Hash(reinterpret_cast<const char *>(&i), sizeof(i)));
+  }
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(filter.MayContain(BloomFilter::Hash(reinterpret_cast<const char *>(&i), sizeof(i))));
+  }
+  int false_positives = 0;
+  for (int i = n; i < 2 * n; i++) {
+    false_positives += filter.MayContain(BloomFilter::Hash(reinterpret_cast<const char *>(&i), sizeof(i))) ? 1 : 0;
+  }
+  std::cout << "false positive rate: " << 100.0 * false_positives / n << "%" << std::endl;
+  ASSERT_LT(false_positives, n / 100);
+}
+
+TEST_F(IndexBloomFilterTests, DuplicateCheckTest) {
+  std::vector<IndexInfo *> indexes;
+  db_->catalog_mgr_->GetTableIndexes("t", indexes);
+  ASSERT_EQ(3, indexes.size());
+  for (auto index : indexes) {
+    ASSERT_TRUE(index->HasBloomFilter());
+  }
+  std::vector<int> ids(5000);
+  for (int i = 0; i < 5000; i++) {
+    ids[i] = i;
+  }
+  ShuffleArray(ids);
+  // filter从1个block开始，插入过程中会按表中的记录重建多次
+  ASSERT_EQ(5000, Insert(db_, ids));
+  ASSERT_EQ(0, Insert(db_, {1234}));
+  ASSERT_EQ(1, Insert(db_, {5000}));
+  for (auto index : indexes) {
+    ASSERT_GE(index->GetBloomFilterBytes() / BloomFilter::BLOCK_SIZE * BloomFilter::KEYS_PER_BLOCK, 5001);
+  }
+  // 每个key都在filter中
+  IndexInfo *id_index = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->GetIndex("t", "t_id_UNIQUE", id_index));
+  for (int i = 0; i <= 5000; i++) {
+    ASSERT_TRUE(id_index->MayContain(IntKey(i)));
+  }
+  // 删除后key留在filter中，直到filter重建
+  ASSERT_EQ(DB_SUCCESS, id_index->RemoveEntry(IntKey(42), RowId(0, 0), nullptr));
+  ASSERT_TRUE(id_index->MayContain(IntKey(42)));
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_KEY_NOT_FOUND, id_index->GetIndex()->ScanKey(IntKey(42), result, nullptr, "="));
+  int absent = 0;
+  for (int i = 10000; i < 20000; i++) {
+    absent += id_index->MayContain(IntKey(i)) ? 0 : 1;
+  }
+  ASSERT_GT(absent, 9900);
+}
+
+TEST_F(IndexBloomFilterTests, PersistTest) {
+  std::vector<int> ids(3000);
+  for (int i = 0; i < 3000; i++) {
+    ids[i] = i;
+  }
+  ASSERT_EQ(3000, Insert(db_, ids));
+  IndexInfo *index = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->GetIndex("t", "t_code_UNIQUE", index));
+  size_t bytes = index->GetBloomFilterBytes();
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->SetIndexBloomFilter("t", "t_name_UNIQUE", false));
+  delete db_;
+  // 正常关闭后直接读取页上的filter
+  db_ = new DBStorageEngine(db_name_, false);
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->GetIndex("t", "t_code_UNIQUE", index));
+  ASSERT_TRUE(index->HasBloomFilter());
+  ASSERT_EQ(bytes, index->GetBloomFilterBytes());
+  for (int i = 0; i < 3000; i++) {
+    ASSERT_TRUE(index->MayContain(IntKey(i * 7 + 3)));
+  }
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->GetIndex("t", "t_name_UNIQUE", index));
+  ASSERT_FALSE(index->HasBloomFilter());
+  ASSERT_EQ(0, Insert(db_, {10}));
+  ASSERT_EQ(1, Insert(db_, {3000}));
+  ASSERT_TRUE(db_->bpm_->CheckAllUnpinned());
+}
@@ -0,0 +1,73 @@
+#ifndef MINISQL_BLOOM_FILTER_TEST_UTIL_H
+#define MINISQL_BLOOM_FILTER_TEST_UTIL_H
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/instance.h"
+#include "executor/executors/insert_executor.h"
+#include "executor/executors/values_executor.h"
+#include "gtest/gtest.h"
+#include "index/bloom_filter.h"
+#include "planner/expressions/constant_value_expression.h"
+
+/**
+ * Table t(id int unique, code int unique, name char(16) unique), every column has its own
+ * unique index. Rows are inserted through InsertExecutor, which checks every index for a
+ * duplicate before the insert.
+ */
+class IndexBloomFilterTests : public ::testing::Test {
+ public:
+  void SetUp() override {
+    db_ = new DBStorageEngine(db_name_, true);
+    CreateTable(db_);
+  }
+
+  void TearDown() override { delete db_; }
+
+  static void CreateTable(DBStorageEngine *db) {
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, true, true),
+                                     new Column("code", TypeId::kTypeInt, 1, true, true),
+                                     new Column("name", TypeId::kTypeChar, 16, 2, true, true)};
+    auto schema = std::make_shared<Schema>(columns);
+    TableInfo *table_info = nullptr;
+    db->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info);
+  }
+
+  static std::vector<AbstractExpressionRef> MakeValues(int id) {
+    char name[16];
+    int len = snprintf(name, sizeof(name), "name-%d", id);
+    return {std::make_shared<ConstantValueExpression>(Field(kTypeInt, id)),
+            std::make_shared<ConstantValueExpression>(Field(kTypeInt, id * 7 + 3)),
+            std::make_shared<ConstantValueExpression>(Field(kTypeChar, name, len, true))};
+  }
+
+  /** @return Rows inserted before the first rejected one */
+  static int Insert(DBStorageEngine *db, const std::vector<int> &ids) {
+    std::vector<std::vector<AbstractExpressionRef>> values;
+    for (int id : ids) {
+      values.push_back(MakeValues(id));
+    }
+    auto values_plan = std::make_shared<ValuesPlanNode>(nullptr, values);
+    auto insert_plan = std::make_shared<InsertPlanNode>(nullptr, values_plan, "t");
+    auto exec_ctx = db->MakeExecuteContext(nullptr);
+    InsertExecutor executor(exec_ctx.get(), insert_plan.get(),
+                            std::make_unique<ValuesExecutor>(exec_ctx.get(), values_plan.get()));
+    executor.Init();
+    int count = 0;
+    Row row;
+    RowId rid;
+    while (executor.Next(&row, &rid)) {
+      count++;
+    }
+    return count;
+  }
+
+ protected:
+  const std::string db_name_ = "bloom_filter_test.db";
+  DBStorageEngine *db_{nullptr};
+};
+
+#endif  // MINISQL_BLOOM_FILTER_TEST_UTIL_H
@@ -0,0 +1,54 @@
+#include <chrono>
+#include <string>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/b_plus_tree_index.h"
+#include "index/hash_index.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "hash_index_benchmark.db";
+
+static Row MakeIntKey(int value) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+  return Row(fields);
+}
+
+TEST(HashIndexTests, PointLookupBenchmark) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{0};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  auto *bptree = new BPlusTreeIndex(0, key_schema, 16, engine.bpm_);
+  auto *hash = new HashIndex(1, key_schema, 16, engine.bpm_);
+  const int n = 100000;
+  vector<int> seq(n);
+  for (int i = 0; i < n; i++) {
+    seq[i] = i;
+  }
+  ShuffleArray(seq);
+  for (int i : seq) {
+    ASSERT_EQ(DB_SUCCESS, bptree->InsertEntry(MakeIntKey(i), RowId(i, 0), nullptr));
+    ASSERT_EQ(DB_SUCCESS, hash->InsertEntry(MakeIntKey(i), RowId(i, 0), nullptr));
+  }
+  ShuffleArray(seq);
+  auto run = [&seq](Index *index) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<RowId> result;
+    for (int i : seq) {
+      result.clear();
+      index->ScanKey(MakeIntKey(i), result, nullptr, "=");
+      EXPECT_EQ(RowId(i, 0), result[0]);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  double bptree_ms = run(bptree);
+  double hash_ms = run(hash);
+  std::cout << n << " point lookups: b+ tree " << bptree_ms << " ms, hash " << hash_ms << " ms" << std::endl;
+  bptree->Destroy();
+  hash->Destroy();
+  delete bptree;
+  delete hash;
+  delete key_schema;
+}
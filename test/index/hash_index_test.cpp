@@ -0,0 +1,151 @@
+#include <cstdio>
+#include <string>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/extendible_hash_table.h"
+#include "index/hash_index.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "hash_index_test.db";
+
+static Row MakeIntKey(int value) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+  return Row(fields);
+}
+
+TEST(HashIndexTests, ExtendibleHashTableTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 16);
+  ExtendibleHashTable table(0, engine.bpm_, KP);
+  const int n = 20000;
+  vector<GenericKey *> keys;
+  for (int i = 0; i < n; i++) {
+    GenericKey *key = KP.InitKey();
+    KP.SerializeFromKey(key, MakeIntKey(i), table_schema);
+    keys.push_back(key);
+  }
+  vector<int> seq(n);
+  for (int i = 0; i < n; i++) {
+    seq[i] = i;
+  }
+  ShuffleArray(seq);
+  for (int i : seq) {
+    ASSERT_TRUE(table.Insert(keys[i], RowId(i)));
+  }
+  ASSERT_FALSE(table.Insert(keys[0], RowId(1)));
+  ASSERT_TRUE(table.Check());
+  ASSERT_GT(table.GetGlobalDepth(), 0);
+  vector<RowId> ans;
+  for (int i = 0; i < n; i++) {
+    ans.clear();
+    ASSERT_TRUE(table.GetValue(keys[i], ans));
+    ASSERT_EQ(1, ans.size());
+    ASSERT_EQ(RowId(i), ans[0]);
+  }
+  // delete half keys
+  ShuffleArray(seq);
+  for (int i = 0; i < n / 2; i++) {
+    table.Remove(keys[seq[i]]);
+  }
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(i >= n / 2, table.GetValue(keys[seq[i]], ans));
+  }
+  ASSERT_TRUE(table.Check());
+  // buckets merge and the directory shrinks back to a single bucket
+  for (int i = n / 2; i < n; i++) {
+    table.Remove(keys[seq[i]]);
+  }
+  ASSERT_EQ(0, table.GetGlobalDepth());
+  ASSERT_EQ(2, table.GetPageCount());
+  ASSERT_TRUE(table.Check());
+  table.Destroy();
+  ASSERT_TRUE(table.IsEmpty());
+  for (auto key : keys) {
+    free(key);
+  }
+  delete table_schema;
+}
+
+TEST(HashIndexTests, DuplicateKeyOverflowTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{0};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  auto *index = new HashIndex(0, key_schema, 32, engine.bpm_, false);
+  // key 7有3000条记录，超过一个bucket的容量，需要overflow页
+  const int n = 3000;
+  for (int i = 0; i < n; i++) {
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(MakeIntKey(7), RowId(i, 0), nullptr));
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(MakeIntKey(i + 100), RowId(i, 1), nullptr));
+  }
+  ASSERT_EQ(DB_FAILED, index->InsertEntry(MakeIntKey(7), RowId(5, 0), nullptr));
+  std::vector<RowId> result;
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(MakeIntKey(7), result, nullptr, "="));
+  ASSERT_EQ(n, result.size());
+  ASSERT_EQ(DB_FAILED, index->ScanKey(MakeIntKey(7), result, nullptr, "<"));
+  for (int i = 0; i < n; i += 2) {
+    ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(MakeIntKey(7), RowId(i, 0), nullptr));
+  }
+  result.clear();
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(MakeIntKey(7), result, nullptr, "="));
+  ASSERT_EQ(n / 2, result.size());
+  for (auto &rid : result) {
+    ASSERT_EQ(1, rid.GetPageId() % 2);
+  }
+  for (int i = 1; i < n; i += 2) {
+    ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(MakeIntKey(7), RowId(i, 0), nullptr));
+  }
+  result.clear();
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index->ScanKey(MakeIntKey(7), result, nullptr, "="));
+  for (int i = 0; i < n; i++) {
+    result.clear();
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(MakeIntKey(i + 100), result, nullptr, "="));
+    ASSERT_EQ(RowId(i, 1), result[0]);
+  }
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+  index->Destroy();
+  delete index;
+  delete key_schema;
+}
+
+TEST(HashIndexTests, CatalogHashIndexTest) {
+  auto db_01 = new DBStorageEngine(db_name, true);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info));
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_FAILED, db_01->catalog_mgr_->CreateIndex("t", "t_name", {"name"}, nullptr, index_info, "rtree"));
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("t", "t_name", {"name"}, nullptr, index_info, "hash"));
+  ASSERT_EQ("hash", index_info->GetIndexType());
+  // btree是bptree的别名
+  IndexInfo *id_index = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, id_index, "btree"));
+  ASSERT_EQ("bptree", id_index->GetIndexType());
+  char name[16];
+  for (int i = 0; i < 100; i++) {
+    int len = snprintf(name, sizeof(name), "name-%d", i);
+    std::vector<Field> fields{Field(TypeId::kTypeChar, name, len, true)};
+    Row key(fields);
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(key, RowId(i, 0), nullptr));
+  }
+  delete db_01;
+  // index type survives reloading the catalog
+  auto db_02 = new DBStorageEngine(db_name, false);
+  ASSERT_EQ(DB_SUCCESS, db_02->catalog_mgr_->GetIndex("t", "t_name", index_info));
+  ASSERT_EQ("hash", index_info->GetIndexType());
+  for (int i = 0; i < 100; i++) {
+    int len = snprintf(name, sizeof(name), "name-%d", i);
+    std::vector<Field> fields{Field(TypeId::kTypeChar, name, len, true)};
+    Row key(fields);
+    std::vector<RowId> result;
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(key, result, nullptr));
+    ASSERT_EQ(RowId(i, 0), result[0]);
+  }
+  delete db_02;
+}
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <string>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/b_plus_tree.h"
+#include "index/int_key_search.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "int_key_search_benchmark.db";
+
+static const IntKeySearch::Kernel kernels[] = {IntKeySearch::Kernel::kScalar, IntKeySearch::Kernel::kSSE,
+                                               IntKeySearch::Kernel::kAVX2};
+
+/**
+ * Point lookups on a tree of n int keys with different fanouts. The generic layout decodes a
+ * row per probe, the int layout runs a lower bound over the int array with each kernel.
+ */
+TEST(IntKeySearchTests, LookupBenchmark) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema *table_schema = new Schema(columns);
+  const int n = 100000;
+  std::vector<int> seq(n);
+  for (int i = 0; i < n; i++) {
+    seq[i] = i;
+  }
+  ShuffleArray(seq);
+  KeyManager KP(table_schema, 16);
+  std::vector<GenericKey *> keys(n);
+  for (int i = 0; i < n; i++) {
+    keys[i] = KP.InitKey();
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    KP.SerializeFromKey(keys[i], Row(fields), table_schema);
+  }
+  auto best = IntKeySearch::DetectKernel();
+  index_id_t index_id = 0;
+  for (int fanout : {16, 64, UNDEFINED_SIZE}) {
+    for (bool int_search : {false, true}) {
+      KeyManager tree_kp(KP);
+      tree_kp.SetIntSearch(int_search);
+      BPlusTree tree(index_id++, engine.bpm_, tree_kp, fanout, fanout);
+      for (int i : seq) {
+        ASSERT_TRUE(tree.Insert(keys[i], RowId(i, 0)));
+      }
+      int height = tree.GetHeight();
+      for (auto kernel : kernels) {
+        if (!int_search && kernel != IntKeySearch::Kernel::kScalar) {
+          continue;
+        }
+        if (IntKeySearch::SetKernel(kernel) != kernel) {
+          continue;
+        }
+        std::vector<RowId> result;
+        auto start = std::chrono::steady_clock::now();
+        for (int i : seq) {
+          result.clear();
+          tree.GetValue(keys[i], result);
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+        ASSERT_EQ(RowId(seq[n - 1], 0), result[0]);
+        std::cout << "fanout " << (fanout == UNDEFINED_SIZE ? std::string("page") : std::to_string(fanout))
+                  << ", height " << height << ", " << (int_search ? "int array " : "generic ")
+                  << IntKeySearch::KernelName(kernel) << ": " << ns << " ns/lookup, " << ns / height << " ns/level"
+                  << std::endl;
+      }
+      tree.Destroy();
+    }
+  }
+  IntKeySearch::SetKernel(best);
+  for (auto key : keys) {
+    free(key);
+  }
+  delete table_schema;
+}
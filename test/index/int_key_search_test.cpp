@@ -0,0 +1,105 @@
+#include "index/int_key_search.h"
+
+#include <algorithm>
+#include <climits>
+#include <random>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/b_plus_tree.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "int_key_search_test.db";
+
+static const IntKeySearch::Kernel kernels[] = {IntKeySearch::Kernel::kScalar, IntKeySearch::Kernel::kSSE,
+                                               IntKeySearch::Kernel::kAVX2};
+
+TEST(IntKeySearchTests, LowerBoundTest) {
+  std::mt19937 rng(20240611);
+  auto best = IntKeySearch::DetectKernel();
+  for (auto kernel : kernels) {
+    ASSERT_EQ(std::min(kernel, best), IntKeySearch::SetKernel(kernel));
+    for (int n : {0, 1, 3, 7, 8, 9, 31, 64, 65, 200, 513}) {
+      std::vector<int32_t> keys(n);
+      for (auto &key : keys) {
+        key = static_cast<int32_t>(rng() % 1000) - 500;
+      }
+      keys.push_back(INT_MIN);
+      std::sort(keys.begin(), keys.end());
+      // 页内的int数组不一定4字节对齐
+      std::vector<char> buf(keys.size() * sizeof(int32_t) + 1);
+      memcpy(buf.data() + 1, keys.data(), keys.size() * sizeof(int32_t));
+      for (int32_t target : {INT_MIN, INT_MAX, -501, -500, -1, 0, 1, 250, 499, 500}) {
+        int expected = std::lower_bound(keys.begin(), keys.end(), target) - keys.begin();
+        ASSERT_EQ(expected, IntKeySearch::LowerBound(buf.data() + 1, keys.size(), target));
+      }
+    }
+  }
+  IntKeySearch::SetKernel(best);
+}
+
+/**
+ * Random inserts and removes on unique and non-unique trees with the int search array,
+ * checked against the generic layout.
+ */
+TEST(IntKeySearchTests, TreeTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, true, false)};
+  Schema *table_schema = new Schema(columns);
+  for (bool unique : {true, false}) {
+    KeyManager KP(table_schema, 24, unique);
+    ASSERT_TRUE(KP.IsIntKey());
+    BPlusTree tree(0, engine.bpm_, KP, 32, 32);
+    const int n = 5000;
+    std::vector<int> seq(n);
+    for (int i = 0; i < n; i++) {
+      seq[i] = i;
+    }
+    ShuffleArray(seq);
+    auto make_key = [&](int i) {
+      GenericKey *key = KP.InitKey();
+      // 非唯一索引每个值有4条记录
+      int value = unique ? i - n / 2 : (i / 4) - n / 8;
+      std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+      KP.SerializeFromKey(key, Row(fields), table_schema);
+      if (!unique) {
+        KP.SetRowIdSuffix(key, RowId(i, 0).Get());
+      }
+      return key;
+    };
+    for (int i : seq) {
+      GenericKey *key = make_key(i);
+      ASSERT_TRUE(tree.Insert(key, RowId(i, 0)));
+      free(key);
+    }
+    ASSERT_TRUE(tree.Check());
+    for (int i = 0; i < n; i += 2) {
+      GenericKey *key = make_key(seq[i]);
+      tree.Remove(key);
+      free(key);
+    }
+    std::vector<RowId> result;
+    for (int i = 0; i < n; i++) {
+      GenericKey *key = make_key(seq[i]);
+      result.clear();
+      ASSERT_EQ(i % 2 == 1, tree.GetValue(key, result));
+      if (i % 2 == 1) {
+        ASSERT_EQ(RowId(seq[i], 0), result[0]);
+      }
+      free(key);
+    }
+    // 迭代器顺序和插入的key顺序一致
+    int last = -1;
+    int count = 0;
+    for (auto iter = tree.Begin(); iter != tree.End(); ++iter) {
+      int rid = (*iter).second.GetPageId();
+      ASSERT_LT(last, rid);
+      last = rid;
+      count++;
+    }
+    ASSERT_EQ(n / 2, count);
+    ASSERT_TRUE(tree.Check());
+    tree.Destroy();
+  }
+  delete table_schema;
+}
@@ -0,0 +1,74 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "common/instance.h"
+#include "executor/executors/index_scan_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "executor/plans/index_scan_plan.h"
+#include "executor/plans/seq_scan_plan.h"
+#include "gtest/gtest.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+
+static const std::string db_name = "non_unique_index_benchmark.db";
+
+TEST(NonUniqueIndexTests, SelectiveFilterBenchmark) {
+  auto engine = new DBStorageEngine(db_name);
+  auto catalog = engine->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("grp", TypeId::kTypeInt, 1, true, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateTable("t", schema.get(), nullptr, table_info));
+  // grp有100个不同的值，每个值选中1%的记录
+  const int n = 20000;
+  const int groups = 100;
+  char name[32];
+  for (int i = 0; i < n; i++) {
+    int len = snprintf(name, sizeof(name), "row-%d", i);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeInt, i % groups),
+                              Field(TypeId::kTypeChar, name, len, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, nullptr));
+  }
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateIndex("t", "t_grp", {"grp"}, nullptr, index_info, "bptree"));
+  ASSERT_FALSE(index_info->IsUnique());
+  IndexInfo *id_grp_index = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog->CreateIndex("t", "t_id_grp", {"id", "grp"}, nullptr, id_grp_index, "bptree"));
+  ASSERT_TRUE(id_grp_index->IsUnique());
+
+  auto grp = std::make_shared<ColumnValueExpression>(0, 1, TypeId::kTypeInt);
+  auto const42 = std::make_shared<ConstantValueExpression>(Field(TypeId::kTypeInt, 42));
+  auto predicate = std::make_shared<ComparisonExpression>(grp, const42, "=");
+  auto context = engine->MakeExecuteContext(nullptr);
+  SeqScanPlanNode seq_plan(table_info->GetSchema(), "t", predicate);
+  IndexScanPlanNode index_plan(table_info->GetSchema(), "t", {index_info}, false, predicate);
+
+  auto run = [](AbstractExecutor &executor, size_t &rows) {
+    auto start = std::chrono::steady_clock::now();
+    executor.Init();
+    Row row;
+    RowId rid;
+    rows = 0;
+    while (executor.Next(&row, &rid)) {
+      rows++;
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  size_t seq_rows, index_rows;
+  SeqScanExecutor seq_scan(context.get(), &seq_plan);
+  IndexScanExecutor index_scan(context.get(), &index_plan);
+  double seq_ms = run(seq_scan, seq_rows);
+  double index_ms = run(index_scan, index_rows);
+  ASSERT_EQ(n / groups, seq_rows);
+  ASSERT_EQ(seq_rows, index_rows);
+  std::cout << "grp = 42 over " << n << " rows: seq scan " << seq_ms << " ms, index scan " << index_ms << " ms"
+            << std::endl;
+
+  delete engine;
+  remove(("./databases/" + db_name).c_str());
+}
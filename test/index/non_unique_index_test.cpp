@@ -0,0 +1,114 @@
+#include <string>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/b_plus_tree_index.h"
+
+static const std::string db_name = "non_unique_index_test.db";
+
+static Row MakeIntKey(int value) {
+  std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+  return Row(fields);
+}
+
+TEST(NonUniqueIndexTests, DuplicateKeyScanTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("grp", TypeId::kTypeInt, 1, true, false)};
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{1};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  auto *index = new BPlusTreeIndex(0, key_schema, 32, engine.bpm_, false);
+  // 10个不同的key，每个key对应200条记录
+  const int n = 2000;
+  for (int i = 0; i < n; i++) {
+    Row key = MakeIntKey(i % 10);
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(key, RowId(i / 100, i % 100), nullptr));
+  }
+  // same key and same row id is still a duplicate
+  Row dup = MakeIntKey(3);
+  ASSERT_EQ(DB_FAILED, index->InsertEntry(dup, RowId(0, 3), nullptr));
+
+  Row key = MakeIntKey(3);
+  std::vector<std::pair<std::string, size_t>> expects{{"=", 200},  {">", 1200}, {">=", 1400},
+                                                      {"<", 600},  {"<=", 800}, {"<>", 1800}};
+  for (auto &expect : expects) {
+    std::vector<RowId> result;
+    index->ScanKey(key, result, nullptr, expect.first);
+    ASSERT_EQ(expect.second, result.size()) << expect.first;
+  }
+  std::vector<RowId> result;
+  index->ScanKey(key, result, nullptr, "=");
+  for (auto &rid : result) {
+    ASSERT_EQ(3, (rid.GetPageId() * 100 + rid.GetSlotNum()) % 10);
+  }
+
+  // remove half of the entries of key 3
+  for (int i = 3; i < n; i += 20) {
+    ASSERT_EQ(DB_SUCCESS, index->RemoveEntry(key, RowId(i / 100, i % 100), nullptr));
+  }
+  result.clear();
+  index->ScanKey(key, result, nullptr, "=");
+  ASSERT_EQ(100, result.size());
+  result.clear();
+  index->ScanKey(key, result, nullptr, "<>");
+  ASSERT_EQ(1800, result.size());
+
+  // keys outside the stored range
+  Row small = MakeIntKey(-1);
+  Row large = MakeIntKey(10);
+  result.clear();
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index->ScanKey(small, result, nullptr, "<"));
+  ASSERT_EQ(DB_KEY_NOT_FOUND, index->ScanKey(large, result, nullptr, ">="));
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(large, result, nullptr, "<"));
+  ASSERT_EQ(1900, result.size());
+
+  index->Destroy();
+  delete index;
+  delete key_schema;
+}
+
+TEST(NonUniqueIndexTests, NullKeyBatchInsertTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("grp", TypeId::kTypeInt, 1, true, false)};
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{1};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  auto *index = new BPlusTreeIndex(0, key_schema, 32, engine.bpm_, false);
+  // 每7条记录有一条null key，一次批量插入，null排在所有key之前
+  const int n = 3000;
+  std::vector<Row> keys;
+  std::vector<RowId> row_ids;
+  for (int i = 0; i < n; i++) {
+    if (i % 7 == 0) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt)};
+      keys.emplace_back(fields);
+    } else {
+      keys.push_back(MakeIntKey(i % 100));
+    }
+    row_ids.emplace_back(i / 100, i % 100);
+  }
+  ASSERT_EQ(DB_SUCCESS, index->InsertEntries(keys, row_ids, nullptr));
+  std::vector<Row> lookups{MakeIntKey(0), MakeIntKey(1), MakeIntKey(99)};
+  std::vector<std::vector<RowId>> results;
+  ASSERT_EQ(DB_SUCCESS, index->LookupMany(lookups, results, nullptr));
+  for (size_t k = 0; k < lookups.size(); k++) {
+    std::vector<RowId> scan;
+    index->ScanKey(lookups[k], scan, nullptr, "=");
+    ASSERT_EQ(scan.size(), results[k].size());
+    ASSERT_FALSE(scan.empty());
+    for (auto &rid : scan) {
+      int i = rid.GetPageId() * 100 + rid.GetSlotNum();
+      ASSERT_NE(0, i % 7);
+      ASSERT_EQ(lookups[k].GetField(0)->GetInteger(), i % 100);
+    }
+  }
+  std::vector<RowId> result;
+  index->ScanKey(MakeIntKey(0), result, nullptr, ">=");
+  ASSERT_EQ(n - (n + 6) / 7, result.size());
+
+  index->Destroy();
+  delete index;
+  delete key_schema;
+}
@@ -0,0 +1,48 @@
+#include <chrono>
+#include <string>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/b_plus_tree_index.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "pinned_index_benchmark.db";
+
+TEST(PinnedIndexTests, PointLookupBenchmark) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  const TableSchema table_schema(columns);
+  std::vector<uint32_t> index_key_map{0};
+  auto *key_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  auto *index = new BPlusTreeIndex(0, key_schema, 16, engine.bpm_);
+  const int n = 200000;
+  std::vector<int> seq(n);
+  for (int i = 0; i < n; i++) {
+    seq[i] = i;
+  }
+  ShuffleArray(seq);
+  for (int i : seq) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(Row(fields), RowId(i, 0), nullptr));
+  }
+  ShuffleArray(seq);
+  auto run = [&]() {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<RowId> result;
+    for (int i : seq) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+      result.clear();
+      index->ScanKey(Row(fields), result, nullptr, "=");
+      EXPECT_EQ(RowId(i, 0), result[0]);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  double plain_ms = run();
+  index->SetPinnedLevels(3);
+  double pinned_ms = run();
+  std::cout << n << " point lookups: unpinned " << plain_ms << " ms, top levels pinned (" << index->GetPinnedBytes() / 1024
+            << " KB) " << pinned_ms << " ms" << std::endl;
+  index->Destroy();
+  delete index;
+  delete key_schema;
+}
@@ -0,0 +1,183 @@
+#include <string>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+#include "index/b_plus_tree.h"
+#include "index/b_plus_tree_index.h"
+#include "utils/utils.h"
+
+static const std::string db_name = "pinned_index_test.db";
+
+static GenericKey *MakeKey(const KeyManager &KP, Schema *schema, int value) {
+  GenericKey *key = KP.InitKey();
+  std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+  KP.SerializeFromKey(key, Row(fields), schema);
+  return key;
+}
+
+/**
+ * Lookups, inserts and removes through the pinned top levels, the pins are dropped on
+ * splits / merges and taken again by the next search.
+ */
+TEST(PinnedIndexTests, PinnedLevelsTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 16);
+  BPlusTree tree(0, engine.bpm_, KP, 16, 16);
+  const int n = 20000;
+  std::vector<int> seq(n);
+  for (int i = 0; i < n; i++) {
+    seq[i] = i;
+  }
+  ShuffleArray(seq);
+  for (int i = 0; i < n / 2; i++) {
+    GenericKey *key = MakeKey(KP, table_schema, seq[i]);
+    ASSERT_TRUE(tree.Insert(key, RowId(seq[i], 0)));
+    free(key);
+  }
+  ASSERT_GE(tree.GetHeight(), 4);
+  tree.SetPinnedLevels(2);
+  ASSERT_EQ(2, tree.GetPinnedLevels());
+  size_t pinned = tree.GetPinnedPageCount();
+  ASSERT_GT(pinned, 2);
+  std::vector<RowId> result;
+  for (int i = 0; i < n; i++) {
+    GenericKey *key = MakeKey(KP, table_schema, seq[i]);
+    result.clear();
+    ASSERT_EQ(i < n / 2, tree.GetValue(key, result));
+    free(key);
+  }
+  ASSERT_EQ(pinned, tree.GetPinnedPageCount());
+  // 交替修改和查找
+  for (int i = n / 2; i < n; i++) {
+    GenericKey *key = MakeKey(KP, table_schema, seq[i]);
+    ASSERT_TRUE(tree.Insert(key, RowId(seq[i], 0)));
+    free(key);
+    key = MakeKey(KP, table_schema, seq[i - n / 2]);
+    tree.Remove(key);
+    result.clear();
+    ASSERT_FALSE(tree.GetValue(key, result));
+    free(key);
+    key = MakeKey(KP, table_schema, seq[i]);
+    result.clear();
+    ASSERT_TRUE(tree.GetValue(key, result));
+    ASSERT_EQ(RowId(seq[i], 0), result[0]);
+    free(key);
+  }
+  ASSERT_GT(tree.GetPinnedPageCount(), 0);
+  int count = 0, last = -1;
+  for (auto iter = tree.Begin(); iter != tree.End(); ++iter) {
+    ASSERT_LT(last, (*iter).second.GetPageId());
+    last = (*iter).second.GetPageId();
+    count++;
+  }
+  ASSERT_EQ(n / 2, count);
+  // 只pin内部页，层数超过树高时叶子层不pin
+  tree.SetPinnedLevels(100);
+  ASSERT_LT(tree.GetPinnedPageCount(), tree.GetPageCount());
+  tree.SetPinnedLevels(0);
+  ASSERT_EQ(0, tree.GetPinnedPageCount());
+  ASSERT_TRUE(tree.Check());
+  tree.SetPinnedLevels(1);
+  ASSERT_EQ(1, tree.GetPinnedPageCount());
+  tree.Destroy();
+  ASSERT_TRUE(tree.IsEmpty());
+  ASSERT_EQ(0, tree.GetPinnedPageCount());
+  ASSERT_TRUE(tree.Check());
+  delete table_schema;
+}
+
+TEST(PinnedIndexTests, PoolBudgetTest) {
+  // 64页的buffer pool最多pin 8页
+  DBStorageEngine engine(db_name, true, 64);
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 16);
+  BPlusTree tree(0, engine.bpm_, KP, 4, 4);
+  for (int i = 0; i < 2000; i++) {
+    GenericKey *key = MakeKey(KP, table_schema, i);
+    ASSERT_TRUE(tree.Insert(key, RowId(i, 0)));
+    free(key);
+  }
+  tree.SetPinnedLevels(10);
+  ASSERT_GE(tree.GetPinnedPageCount(), 1);
+  ASSERT_LE(tree.GetPinnedPageCount(), 64 / BPlusTree::MAX_PINNED_FRACTION);
+  std::vector<RowId> result;
+  for (int i = 0; i < 2000; i++) {
+    GenericKey *key = MakeKey(KP, table_schema, i);
+    result.clear();
+    ASSERT_TRUE(tree.GetValue(key, result));
+    ASSERT_EQ(RowId(i, 0), result[0]);
+    free(key);
+  }
+  tree.Destroy();
+  ASSERT_TRUE(tree.Check());
+  delete table_schema;
+}
+
+TEST(PinnedIndexTests, CatalogTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("score", TypeId::kTypeInt, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, engine.catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info));
+  IndexInfo *bptree_info = nullptr, *hash_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, engine.catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, bptree_info, "bptree"));
+  ASSERT_EQ(DB_SUCCESS, engine.catalog_mgr_->CreateIndex("t", "t_score", {"score"}, nullptr, hash_info, "hash"));
+  for (int i = 0; i < 5000; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ASSERT_EQ(DB_SUCCESS, bptree_info->GetIndex()->InsertEntry(Row(fields), RowId(i, 0), nullptr));
+  }
+  ASSERT_EQ(DB_FAILED, engine.catalog_mgr_->SetIndexPinnedLevels("t", "t_score", 1));
+  ASSERT_EQ(DB_INDEX_NOT_FOUND, engine.catalog_mgr_->SetIndexPinnedLevels("t", "t_none", 1));
+  ASSERT_EQ(DB_SUCCESS, engine.catalog_mgr_->SetIndexPinnedLevels("t", "t_id", 1));
+  auto index = dynamic_cast<BPlusTreeIndex *>(bptree_info->GetIndex());
+  ASSERT_EQ(1, index->GetPinnedLevels());
+  ASSERT_EQ(PAGE_SIZE, index->GetPinnedBytes());
+  ASSERT_EQ(DB_SUCCESS, engine.catalog_mgr_->DropIndex("t", "t_id"));
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
+
+/**
+ * The pinned levels are kept in the index metadata and pinned again by the first search after
+ * the database is reopened.
+ */
+TEST(PinnedIndexTests, PersistTest) {
+  auto engine = new DBStorageEngine(db_name);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info));
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+  ASSERT_EQ(0, index_info->GetMetadata()->GetPinnedLevels());
+  for (int i = 0; i < 5000; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(Row(fields), RowId(i, 0), nullptr));
+  }
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->SetIndexPinnedLevels("t", "t_id", 1));
+  ASSERT_EQ(1, index_info->GetMetadata()->GetPinnedLevels());
+  delete engine;
+  engine = new DBStorageEngine(db_name, false);
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->GetIndex("t", "t_id", index_info));
+  ASSERT_EQ(1, index_info->GetMetadata()->GetPinnedLevels());
+  auto index = dynamic_cast<BPlusTreeIndex *>(index_info->GetIndex());
+  ASSERT_EQ(1, index->GetPinnedLevels());
+  std::vector<RowId> result;
+  std::vector<Field> fields{Field(TypeId::kTypeInt, 42)};
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(Row(fields), result, nullptr, "="));
+  ASSERT_EQ(RowId(42, 0), result[0]);
+  ASSERT_EQ(PAGE_SIZE, index->GetPinnedBytes());
+  // 负数按0处理，取消固定后也要写回元数据
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->SetIndexPinnedLevels("t", "t_id", -1));
+  ASSERT_EQ(0, index_info->GetMetadata()->GetPinnedLevels());
+  delete engine;
+  engine = new DBStorageEngine(db_name, false);
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->GetIndex("t", "t_id", index_info));
+  ASSERT_EQ(0, dynamic_cast<BPlusTreeIndex *>(index_info->GetIndex())->GetPinnedLevels());
+  ASSERT_EQ(DB_SUCCESS, engine->catalog_mgr_->DropTable("t"));
+  ASSERT_TRUE(engine->bpm_->CheckAllUnpinned());
+  delete engine;
+}
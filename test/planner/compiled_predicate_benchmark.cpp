@@ -0,0 +1,35 @@
+#include <chrono>
+
+#include "compiled_predicate_test_util.h"  // NOLINT
+
+/**
+ * A selective filter, a < 100 AND b > 10 OR c = 'name-3', over 10M rows (the rows above 100 times):
+ * the expression tree against the compiled predicate.
+ */
+TEST_F(CompiledPredicateTest, FilterBenchmark) {
+  std::string name = "name-3";
+  auto predicate =
+      Logic(Logic(Compare(0, Field(kTypeInt, 100), "<"), Compare(1, Field(kTypeFloat, 10.0f), ">"), LogicType::And),
+            Compare(2, Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true), "="), LogicType::Or);
+  auto compiled = CompiledPredicate::Compile(predicate);
+  const int repeat = 100;
+  size_t interpreted_count = 0, compiled_count = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; i++) {
+    for (const auto &row : rows_) {
+      interpreted_count += Interpret(predicate, row);
+    }
+  }
+  double interpreted_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; i++) {
+    for (const auto &row : rows_) {
+      compiled_count += compiled->EvaluatePredicate(row);
+    }
+  }
+  double compiled_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  ASSERT_EQ(interpreted_count, compiled_count);
+  std::cout << "filter of " << repeat * rows_.size() << " rows, " << compiled_count / repeat
+            << " per pass: Evaluate " << interpreted_time << " ms, compiled " << compiled_time << " ms, "
+            << interpreted_time / compiled_time << "x" << std::endl;
+}
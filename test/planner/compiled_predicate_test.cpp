@@ -0,0 +1,42 @@
+#include "compiled_predicate_test_util.h"  // NOLINT
+
+TEST_F(CompiledPredicateTest, EvaluateTest) {
+  ASSERT_EQ(nullptr, CompiledPredicate::Compile(nullptr));
+  std::string name = "name-50";
+  std::vector<Field> constants{Field(kTypeInt, 500), Field(kTypeFloat, 42.5f),
+                               Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+  std::vector<AbstractExpressionRef> comparisons;
+  for (uint32_t col_idx = 0; col_idx < 3; col_idx++) {
+    for (const std::string op : {"=", "<>", "<", "<=", ">", ">="}) {
+      comparisons.push_back(Compare(col_idx, constants[col_idx], op));
+      // 和null比较不成立
+      comparisons.push_back(Compare(col_idx, Field(constants[col_idx].GetTypeId()), op));
+    }
+    comparisons.push_back(Compare(col_idx, Field(constants[col_idx].GetTypeId()), "is"));
+    comparisons.push_back(Compare(col_idx, Field(constants[col_idx].GetTypeId()), "not"));
+  }
+  std::vector<AbstractExpressionRef> predicates(comparisons);
+  for (size_t i = 0; i < comparisons.size(); i += 3) {
+    const auto &other = comparisons[(i * 7 + 5) % comparisons.size()];
+    predicates.push_back(Logic(comparisons[i], other, LogicType::And));
+    predicates.push_back(Logic(comparisons[i], other, LogicType::Or));
+    predicates.push_back(Logic(Logic(comparisons[i], other, LogicType::Or), comparisons[i / 2], LogicType::And));
+  }
+  for (const auto &predicate : predicates) {
+    auto compiled = CompiledPredicate::Compile(predicate);
+    ASSERT_EQ(0, compiled->GetFallbackCount());
+    for (int i = 0; i < n_; i += 13) {
+      ASSERT_EQ(Interpret(predicate, rows_[i]), compiled->EvaluatePredicate(rows_[i])) << i;
+    }
+  }
+
+  // 两列比较不编译，按表达式求值
+  auto columns = std::make_shared<ComparisonExpression>(std::make_shared<ColumnValueExpression>(0, 0, kTypeInt),
+                                                        std::make_shared<ColumnValueExpression>(0, 0, kTypeInt), "=");
+  auto mixed = Logic(columns, Compare(1, constants[1], "<"), LogicType::And);
+  auto compiled = CompiledPredicate::Compile(mixed);
+  ASSERT_EQ(1, compiled->GetFallbackCount());
+  for (int i = 0; i < n_; i += 13) {
+    ASSERT_EQ(Interpret(mixed, rows_[i]), compiled->EvaluatePredicate(rows_[i])) << i;
+  }
+}
@@ -0,0 +1,50 @@
+#ifndef MINISQL_COMPILED_PREDICATE_TEST_UTIL_H
+#define MINISQL_COMPILED_PREDICATE_TEST_UTIL_H
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "planner/compiled_predicate.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+
+/**
+ * Rows (a int, b float, c char) with a = i, b = i % 100 + 0.5 and c = "name-" + i % 97, b is null
+ * every 7th row and c every 11th.
+ */
+class CompiledPredicateTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    for (int i = 0; i < n_; i++) {
+      std::string name = "name-" + std::to_string(i % 97);
+      std::vector<Field> fields{Field(kTypeInt, i), i % 7 == 0 ? Field(kTypeFloat) : Field(kTypeFloat, i % 100 + 0.5f),
+                                i % 11 == 0 ? Field(kTypeChar)
+                                            : Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+      rows_.emplace_back(fields);
+    }
+  }
+
+  static AbstractExpressionRef Compare(uint32_t col_idx, const Field &value, const std::string &op) {
+    TypeId type = col_idx == 0 ? kTypeInt : (col_idx == 1 ? kTypeFloat : kTypeChar);
+    return std::make_shared<ComparisonExpression>(std::make_shared<ColumnValueExpression>(0, col_idx, type),
+                                                  std::make_shared<ConstantValueExpression>(value), op);
+  }
+
+  static AbstractExpressionRef Logic(const AbstractExpressionRef &lhs, const AbstractExpressionRef &rhs,
+                                     LogicType type) {
+    return std::make_shared<LogicExpression>(lhs, rhs, type);
+  }
+
+  static bool Interpret(const AbstractExpressionRef &predicate, const Row &row) {
+    return predicate->Evaluate(&row).CompareEquals(Field(kTypeInt, 1)) == CmpBool::kTrue;
+  }
+
+ protected:
+  const int n_ = 100000;
+  std::vector<Row> rows_;
+};
+
+#endif  // MINISQL_COMPILED_PREDICATE_TEST_UTIL_H
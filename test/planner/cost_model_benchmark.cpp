@@ -0,0 +1,25 @@
+#include <chrono>
+
+#include "cost_model_test_util.h"  // NOLINT
+
+/**
+ * Three point conditions joined by OR, through the merged row ids of two indexes and by checking
+ * every row of the heap.
+ */
+TEST_F(CostModelTest, IndexUnionBenchmark) {
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  const std::string sql = "select * from t where id = 5 or val = 7 or id = 12345;";
+  auto union_plan = Plan(sql);
+  ASSERT_EQ(PlanType::BitmapHeapScan, union_plan->GetType());
+  std::string table = "t";
+  auto seq_plan = std::make_shared<SeqScanPlanNode>(union_plan->OutputSchema(), table, GetPredicate(union_plan));
+  auto time = [this](const AbstractPlanNodeRef &plan) {
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(22, Run(plan));
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+  double union_time = time(union_plan);
+  double seq_time = time(seq_plan);
+  std::cout << sql << " index union " << union_time << " ms (cost " << union_plan->GetEstimatedCost()
+            << "), seq scan " << seq_time << " ms" << std::endl;
+}
@@ -0,0 +1,109 @@
+#include "cost_model_test_util.h"  // NOLINT
+
+/**
+ * A narrow range on the id index (its rows are stored in id order) is read through the index. The
+ * 10% of rows with one grp value lie on every page and are read page by page in heap order, a
+ * condition keeping most of the rows scans the heap.
+ */
+TEST_F(CostModelTest, AccessPathTest) {
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  TableInfo *table_info = nullptr;
+  db_->catalog_mgr_->GetTable("t", table_info);
+  auto statistics = table_info->GetStatistics();
+  ASSERT_GT(statistics->GetColumn(0).GetCorrelation(), 0.99);
+  ASSERT_LT(std::abs(statistics->GetColumn(1).GetCorrelation()), 0.2);
+  CostModel cost_model(statistics);
+  ASSERT_EQ(statistics->GetPageCount(), cost_model.GetPageCount());
+  ASSERT_LT(cost_model.FetchRows(1000, 1), cost_model.FetchRows(1000, 0));
+  ASSERT_LT(cost_model.FetchSortedRows(1000), cost_model.FetchRows(1000, 0));
+
+  auto plan = PlanAndCheck("select * from t where id < 100;", 100);
+  ASSERT_EQ(PlanType::IndexScan, plan->GetType());
+  ASSERT_NEAR(100, plan->GetEstimatedRows(), 10);
+  ASSERT_GT(plan->GetEstimatedCost(), 0);
+  ASSERT_EQ(PlanType::BitmapHeapScan, PlanAndCheck("select * from t where grp = 3;", 2000)->GetType());
+  ASSERT_EQ(PlanType::SeqScan, PlanAndCheck("select * from t where grp > 0;", 18000)->GetType());
+  plan = PlanAndCheck("select * from t where grp = 3 and id >= 19000;", 100);
+  ASSERT_EQ("IndexScan on t using t_id (range) with filter", plan->ToString());
+  ASSERT_EQ(PlanType::IndexOnlyScan, PlanAndCheck("select id from t where id > 19990;", 9)->GetType());
+  // hash索引只支持等值
+  plan = PlanAndCheck("select * from t where val = 7 and grp = 7;", 20);
+  ASSERT_EQ("BitmapHeapScan on t using t_val (row ids) with filter", plan->ToString());
+  ASSERT_EQ(PlanType::SeqScan, PlanAndCheck("select * from t where val > 7;", 19840)->GetType());
+}
+
+/**
+ * OR is answered by merging the row ids of both sides when each side has an index, with or without
+ * statistics. Without an index on one side every row has to be checked.
+ */
+TEST_F(CostModelTest, IndexUnionTest) {
+  const std::string sql = "select * from t where id = 5 or val = 7 or id > 19995;";
+  for (int analyzed = 0; analyzed < 2; analyzed++) {
+    auto plan = PlanAndCheck(sql, 25);
+    // 有统计信息后排序的row id按页读
+    ASSERT_EQ(analyzed ? "BitmapHeapScan on t using t_id, t_val (row id set)"
+                       : "IndexScan on t using t_id, t_val (row id set)",
+              plan->ToString());
+    ASSERT_EQ(PlanType::SeqScan, PlanAndCheck("select * from t where id = 5 or name = \"name-3\";", 208)->GetType());
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->AnalyzeTable("t", nullptr));
+  }
+  ASSERT_NEAR(25, Plan(sql)->GetEstimatedRows(), 5);
+  // 两支都选很多行时不如顺序扫描
+  ASSERT_EQ(PlanType::SeqScan, PlanAndCheck("select * from t where id < 5000 or grp = 3;", 6500)->GetType());
+  // 条件从左往右结合，即 (val = 7 or val = 8) and id < 10000：OR的两支求并，再和id的row id求交
+  auto plan = PlanAndCheck("select * from t where val = 7 or val = 8 and id < 10000;", 20);
+  ASSERT_EQ(PlanType::BitmapHeapScan, plan->GetType());
+  ASSERT_EQ(0, PlanAndCheck("select * from t where val = 1000 or id = 20000;", 0)->GetEstimatedRows());
+}
+
+/**
+ * Null keys sort first in a b+ tree, the <, <= and <> probes of an index union start after them:
+ * the row ids of both sides are the rows, no filter checks them again.
+ */
+TEST_F(CostModelTest, IndexUnionNullTest) {
+  std::vector<Column *> columns = {new Column("a", TypeId::kTypeInt, 0, true, false),
+                                   new Column("b", TypeId::kTypeInt, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("n", schema.get(), nullptr, table_info));
+  for (auto values : std::vector<std::pair<int, int>>{{1, 10}, {-1, 20}, {7, 30}, {-1, 40}}) {
+    std::vector<Field> fields{values.first < 0 ? Field(TypeId::kTypeInt) : Field(TypeId::kTypeInt, values.first),
+                              Field(TypeId::kTypeInt, values.second)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+  }
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("n", "n_a", {"a"}, nullptr, index_info, "bptree"));
+  ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("n", "n_b", {"b"}, nullptr, index_info, "bptree"));
+  const std::vector<std::pair<std::string, size_t>> queries{{"select * from n where a < 5 or b = 30;", 2},
+                                                            {"select * from n where a <> 1 or b = 10;", 2},
+                                                            {"select * from n where a <= 7 or b = 20;", 3},
+                                                            {"select * from n where a <> 7 or b = 40;", 2}};
+  for (const auto &query : queries) {
+    auto plan = Plan(query.first);
+    ASSERT_EQ("IndexScan on n using n_a, n_b (row id set)", plan->ToString()) << query.first;
+    ASSERT_EQ(query.second, Run(plan)) << query.first;
+  }
+}
+
+TEST_F(CostModelTest, ExplainParseTest) {
+  auto type = [](const std::string &sql) {
+    SyntaxNodeType node_type = kNodeUnknown, child_type = kNodeUnknown;
+    Parse(sql, [&node_type, &child_type](pSyntaxNode ast) {
+      if (ast != nullptr) {
+        node_type = ast->type_;
+        child_type = ast->child_ == nullptr ? kNodeUnknown : ast->child_->type_;
+      }
+    });
+    return std::make_pair(node_type, child_type);
+  };
+  ASSERT_EQ(std::make_pair(kNodeExplain, kNodeSelect), type("explain select * from t where id = 1;"));
+  ASSERT_EQ(std::make_pair(kNodeExplain, kNodeDelete), type("EXPLAIN delete from t where id = 1;"));
+  ASSERT_EQ(std::make_pair(kNodeExplain, kNodeUpdate), type("explain update t set grp = 1 where id = 1;"));
+  ASSERT_EQ(kNodeUnknown, type("explain t;").first);
+  ASSERT_EQ(kNodeUnknown, type("explan select * from t;").first);
+  ASSERT_EQ(kNodeUnknown, type("analyze select * from t;").first);
+  // explain不是保留字，仍可作为表名和列名
+  ASSERT_EQ(std::make_pair(kNodeExplain, kNodeSelect), type("explain select explain from explain;"));
+  ASSERT_EQ(kNodeCreateTable, type("create table explain(explain int);").first);
+}
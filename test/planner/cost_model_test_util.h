@@ -0,0 +1,94 @@
+#ifndef MINISQL_COST_MODEL_TEST_UTIL_H
+#define MINISQL_COST_MODEL_TEST_UTIL_H
+
+#include <string>
+
+#include "../execution/sql_test_util.h"  // NOLINT
+#include "catalog/statistics.h"
+#include "executor/executors/bitmap_heap_scan_executor.h"
+#include "executor/executors/index_only_scan_executor.h"
+#include "executor/executors/index_scan_executor.h"
+#include "executor/executors/seq_scan_executor.h"
+#include "planner/cost_model.h"
+
+/**
+ * Heap table t(id int unique, grp int, val int, name char(16)) with 20000 rows inserted in id order,
+ * grp = id % 10, val = id % 1000 and name = "name-" + id % 97. id and grp have b+ tree indexes, val
+ * a hash index.
+ */
+class CostModelTest : public SqlTest {
+ public:
+  void SetUp() override {
+    db_ = new DBStorageEngine("cost_model_test.db", true);
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, true),
+                                     new Column("grp", TypeId::kTypeInt, 1, true, false),
+                                     new Column("val", TypeId::kTypeInt, 2, true, false),
+                                     new Column("name", TypeId::kTypeChar, 16, 3, true, false)};
+    auto schema = std::make_shared<Schema>(columns);
+    TableInfo *table_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateTable("t", schema.get(), nullptr, table_info));
+    for (int i = 0; i < n_; i++) {
+      std::string name = "name-" + std::to_string(i % 97);
+      std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeInt, i % 10),
+                                Field(TypeId::kTypeInt, i % 1000),
+                                Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+      Row row(fields);
+      ASSERT_TRUE(table_info->InsertTuple(row, nullptr));
+    }
+    IndexInfo *index_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_id", {"id"}, nullptr, index_info, "bptree"));
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_grp", {"grp"}, nullptr, index_info, "bptree"));
+    ASSERT_EQ(DB_SUCCESS, db_->catalog_mgr_->CreateIndex("t", "t_val", {"val"}, nullptr, index_info, "hash"));
+  }
+
+  /** @return Rows of a scan plan */
+  size_t Run(const AbstractPlanNodeRef &plan) {
+    auto context = db_->MakeExecuteContext(nullptr);
+    std::unique_ptr<AbstractExecutor> executor;
+    if (plan->GetType() == PlanType::SeqScan) {
+      executor = std::make_unique<SeqScanExecutor>(context.get(), dynamic_cast<const SeqScanPlanNode *>(plan.get()));
+    } else if (plan->GetType() == PlanType::IndexOnlyScan) {
+      executor = std::make_unique<IndexOnlyScanExecutor>(context.get(),
+                                                         dynamic_cast<const IndexOnlyScanPlanNode *>(plan.get()));
+    } else if (plan->GetType() == PlanType::BitmapHeapScan) {
+      executor = std::make_unique<BitmapHeapScanExecutor>(context.get(),
+                                                          dynamic_cast<const BitmapHeapScanPlanNode *>(plan.get()));
+    } else {
+      executor =
+          std::make_unique<IndexScanExecutor>(context.get(), dynamic_cast<const IndexScanPlanNode *>(plan.get()));
+    }
+    executor->Init();
+    Row row;
+    RowId rid;
+    size_t count = 0;
+    while (executor->Next(&row, &rid)) {
+      count++;
+    }
+    return count;
+  }
+
+  /** Plan sql, check that it runs to expected rows and that a sequential scan agrees. */
+  AbstractPlanNodeRef PlanAndCheck(const std::string &sql, size_t expected) {
+    auto plan = Plan(sql);
+    EXPECT_EQ(expected, Run(plan)) << sql;
+    std::string table = "t";
+    auto seq = std::make_shared<SeqScanPlanNode>(plan->OutputSchema(), table, GetPredicate(plan));
+    EXPECT_EQ(expected, Run(seq)) << sql;
+    return plan;
+  }
+
+  static AbstractExpressionRef GetPredicate(const AbstractPlanNodeRef &plan) {
+    if (plan->GetType() == PlanType::SeqScan) {
+      return dynamic_cast<const SeqScanPlanNode *>(plan.get())->GetPredicate();
+    }
+    if (plan->GetType() == PlanType::IndexOnlyScan) {
+      return dynamic_cast<const IndexOnlyScanPlanNode *>(plan.get())->GetPredicate();
+    }
+    return dynamic_cast<const IndexScanPlanNode *>(plan.get())->GetPredicate();
+  }
+
+ protected:
+  const int n_ = 20000;
+};
+
+#endif  // MINISQL_COST_MODEL_TEST_UTIL_H
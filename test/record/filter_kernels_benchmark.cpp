@@ -0,0 +1,70 @@
+#include <chrono>
+
+#include "filter_kernels_test_util.h"  // NOLINT
+
+/**
+ * Kernel microbenchmarks: each kernel over a batch of 1024 values, repeated to 16M values, for the
+ * scalar and the AVX2 kernels, and the selection vector filter of ColumnVector::SelectCompare().
+ */
+TEST_F(FilterKernelsTest, KernelBenchmark) {
+  const size_t batch = DataChunk::CAPACITY;
+  const int repeat = 16 * 1024;
+  std::vector<uint64_t> bits(FilterKernels::WordCount(batch));
+  auto time = [&](const std::function<void()> &kernel) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t checksum = 0;
+    for (int i = 0; i < repeat; i++) {
+      kernel();
+      checksum += bits[i % bits.size()];
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_NE(static_cast<uint64_t>(-1), checksum);
+    return ms;
+  };
+  std::vector<std::pair<std::string, std::function<void(const FilterKernels *)>>> cases{
+      {"int <",
+       [&](const FilterKernels *k) {
+         k->CompareInt(ints_.data(), nulls_.data(), batch, CompareOp::LessThan, 10, bits.data());
+       }},
+      {"int =",
+       [&](const FilterKernels *k) {
+         k->CompareInt(ints_.data(), nulls_.data(), batch, CompareOp::Equal, 10, bits.data());
+       }},
+      {"float <",
+       [&](const FilterKernels *k) {
+         k->CompareFloat(floats_.data(), nulls_.data(), batch, CompareOp::LessThan, 5.0f, bits.data());
+       }},
+      {"int between",
+       [&](const FilterKernels *k) {
+         k->BetweenInt(ints_.data(), nulls_.data(), batch, -10, true, 20, false, bits.data());
+       }},
+      {"float between",
+       [&](const FilterKernels *k) {
+         k->BetweenFloat(floats_.data(), nulls_.data(), batch, -5.0f, true, 10.0f, false, bits.data());
+       }},
+      {"not null", [&](const FilterKernels *k) { k->NotNull(nulls_.data(), batch, bits.data()); }},
+  };
+  DataChunk chunk;
+  chunk.Reset(nullptr);
+  for (size_t i = 0; i < batch; i++) {
+    std::vector<Field> fields{nulls_[i] ? Field(kTypeInt) : Field(kTypeInt, ints_[i])};
+    chunk.AppendRow(Row(fields), RowId(0, i));
+  }
+  std::vector<uint32_t> selection;
+  double selection_time = time([&]() {
+    selection = chunk.GetSelection();
+    chunk.GetColumn(0).SelectCompare(CompareOp::LessThan, Field(kTypeInt, 10), selection);
+  });
+  std::cout << "int < with a selection vector: " << selection_time << " ms for " << batch * repeat << " values"
+            << std::endl;
+  for (const auto &kernel_case : cases) {
+    std::cout << kernel_case.first << ":";
+    double scalar_time = 0;
+    for (auto kernels : kernels_) {
+      double ms = time([&]() { kernel_case.second(kernels); });
+      scalar_time = kernels == &FilterKernels::Scalar() ? ms : scalar_time;
+      std::cout << " " << kernels->GetName() << " " << ms << " ms (" << scalar_time / ms << "x)";
+    }
+    std::cout << std::endl;
+  }
+}
@@ -0,0 +1,115 @@
+#include "filter_kernels_test_util.h"  // NOLINT
+
+TEST_F(FilterKernelsTest, KernelTest) {
+  const std::vector<CompareOp> ops{CompareOp::Equal,       CompareOp::NotEqual,    CompareOp::LessThan,
+                                   CompareOp::LessThanEquals, CompareOp::GreaterThan, CompareOp::GreaterThanEquals};
+  for (auto kernels : kernels_) {
+    // 不足一个字、正好一个字和带尾部的长度
+    for (size_t size : {0, 1, 63, 64, 65, 1000, 1024, 4096}) {
+      std::vector<uint64_t> bits(FilterKernels::WordCount(size));
+      for (auto op : ops) {
+        for (int32_t constant : {-51, -7, 0, 13, 50}) {
+          kernels->CompareInt(ints_.data(), nulls_.data(), size, op, constant, bits.data());
+          ASSERT_EQ(Expected(size, [&](size_t i) { return Compare(op, ints_[i], constant); }), bits)
+              << kernels->GetName() << " " << size << " " << static_cast<int>(op) << " " << constant;
+          float value = constant / 2.0f;
+          kernels->CompareFloat(floats_.data(), nulls_.data(), size, op, value, bits.data());
+          ASSERT_EQ(Expected(size, [&](size_t i) { return Compare(op, floats_[i], value); }), bits)
+              << kernels->GetName() << " " << size << " " << static_cast<int>(op) << " " << value;
+        }
+      }
+      for (bool lower_inclusive : {true, false}) {
+        for (bool upper_inclusive : {true, false}) {
+          kernels->BetweenInt(ints_.data(), nulls_.data(), size, -7, lower_inclusive, 13, upper_inclusive, bits.data());
+          ASSERT_EQ(Expected(size,
+                             [&](size_t i) {
+                               return (lower_inclusive ? ints_[i] >= -7 : ints_[i] > -7) &&
+                                      (upper_inclusive ? ints_[i] <= 13 : ints_[i] < 13);
+                             }),
+                    bits)
+              << kernels->GetName() << " " << size;
+          kernels->BetweenFloat(floats_.data(), nulls_.data(), size, -3.5f, lower_inclusive, 6.5f, upper_inclusive,
+                                bits.data());
+          ASSERT_EQ(Expected(size,
+                             [&](size_t i) {
+                               return (lower_inclusive ? floats_[i] >= -3.5f : floats_[i] > -3.5f) &&
+                                      (upper_inclusive ? floats_[i] <= 6.5f : floats_[i] < 6.5f);
+                             }),
+                    bits)
+              << kernels->GetName() << " " << size;
+        }
+      }
+      kernels->NotNull(nulls_.data(), size, bits.data());
+      ASSERT_EQ(Expected(size, [](size_t) { return true; }), bits) << kernels->GetName() << " " << size;
+    }
+  }
+}
+
+/**
+ * The bitmap of a predicate selects the same rows of a chunk as FilterBatch(), with the predicates
+ * of the SIMD kernels (comparisons, between, and, or, is null) and without them (chars).
+ */
+TEST_F(FilterKernelsTest, PredicateTest) {
+  DataChunk chunk;
+  chunk.Reset(nullptr);
+  for (size_t i = 0; i < 1000; i++) {
+    std::string name = "name-" + std::to_string(ints_[i]);
+    std::vector<Field> fields{nulls_[i] ? Field(kTypeInt) : Field(kTypeInt, ints_[i]),
+                              nulls_[(i + 3) % n_] ? Field(kTypeFloat) : Field(kTypeFloat, floats_[i]),
+                              Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+    chunk.AppendRow(Row(fields), RowId(0, i));
+  }
+  auto compare = [](uint32_t col_idx, const Field &value, const std::string &op) -> AbstractExpressionRef {
+    auto column = std::make_shared<ColumnValueExpression>(0, col_idx, value.GetTypeId());
+    return std::make_shared<ComparisonExpression>(column, std::make_shared<ConstantValueExpression>(value), op);
+  };
+  auto logic = [](const AbstractExpressionRef &lhs, const AbstractExpressionRef &rhs,
+                  LogicType type) -> AbstractExpressionRef {
+    return std::make_shared<LogicExpression>(lhs, rhs, type);
+  };
+  std::string name = "name-7";
+  auto a_range =
+      logic(compare(0, Field(kTypeInt, 20), "<="), compare(0, Field(kTypeInt, -10), ">"), LogicType::And);
+  auto b_range = logic(compare(1, Field(kTypeFloat, -3.0f), ">="), compare(1, Field(kTypeFloat, 3.0f), "<"),
+                       LogicType::And);
+  auto c_equal = compare(2, Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true), "=");
+  std::vector<std::pair<AbstractExpressionRef, bool>> predicates{
+      {compare(0, Field(kTypeInt, 5), "<"), true},
+      {compare(1, Field(kTypeFloat, 5.5f), "="), true},
+      {compare(0, Field(kTypeInt), "<>"), true},
+      {compare(1, Field(kTypeFloat), "is"), true},
+      {compare(0, Field(kTypeInt), "not"), true},
+      {a_range, true},
+      {b_range, true},
+      {logic(a_range, compare(1, Field(kTypeFloat), "not"), LogicType::And), true},
+      {logic(a_range, b_range, LogicType::Or), true},
+      {logic(compare(0, Field(kTypeInt, 0), "="), compare(1, Field(kTypeFloat, 0.0f), ">"), LogicType::Or), true},
+      {c_equal, false},
+      {logic(a_range, c_equal, LogicType::Or), false},
+  };
+  std::vector<uint64_t> bits(FilterKernels::WordCount(chunk.GetSize()));
+  for (const auto &predicate : predicates) {
+    std::vector<uint32_t> expected(chunk.GetSelection());
+    predicate.first->FilterBatch(chunk, expected);
+    ASSERT_EQ(predicate.second, predicate.first->FilterBitmap(chunk, bits.data()));
+    if (predicate.second) {
+      DataChunk copy(chunk);
+      copy.SelectBitmap(bits.data());
+      ASSERT_EQ(expected, copy.GetSelection());
+      // 已经过滤过一部分时取交集
+      std::vector<uint32_t> odd;
+      for (uint32_t i = 1; i < chunk.GetSize(); i += 2) {
+        odd.push_back(i);
+      }
+      copy.GetSelection() = odd;
+      copy.SelectBitmap(bits.data());
+      std::vector<uint32_t> expected_odd;
+      for (uint32_t pos : expected) {
+        if (pos % 2 == 1) {
+          expected_odd.push_back(pos);
+        }
+      }
+      ASSERT_EQ(expected_odd, copy.GetSelection());
+    }
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef MINISQL_FILTER_KERNELS_TEST_UTIL_H
+#define MINISQL_FILTER_KERNELS_TEST_UTIL_H
+
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+#include "record/data_chunk.h"
+#include "record/filter_kernels.h"
+
+/**
+ * Columns of random ints in [-50, 50], floats (the ints halved) and a null every 8th value on average,
+ * checked against plain loops for the scalar kernels and, if the CPU has it, the AVX2 ones.
+ */
+class FilterKernelsTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    srand(2023);
+    for (size_t i = 0; i < n_; i++) {
+      ints_.push_back(rand() % 101 - 50);
+      floats_.push_back(ints_.back() / 2.0f);
+      nulls_.push_back(rand() % 8 == 0);
+    }
+    kernels_.push_back(&FilterKernels::Scalar());
+    if (FilterKernels::Avx2() != nullptr) {
+      kernels_.push_back(FilterKernels::Avx2());
+    }
+  }
+
+  /** @return bits of the rows matching, as the kernels write them */
+  std::vector<uint64_t> Expected(size_t size, const std::function<bool(size_t)> &match) const {
+    std::vector<uint64_t> bits(FilterKernels::WordCount(size), 0);
+    for (size_t i = 0; i < size; i++) {
+      if (!nulls_[i] && match(i)) {
+        bits[i / 64] |= static_cast<uint64_t>(1) << (i % 64);
+      }
+    }
+    return bits;
+  }
+
+  template <typename T>
+  static bool Compare(CompareOp op, T lhs, T rhs) {
+    switch (op) {
+      case CompareOp::Equal:
+        return lhs == rhs;
+      case CompareOp::NotEqual:
+        return lhs != rhs;
+      case CompareOp::LessThan:
+        return lhs < rhs;
+      case CompareOp::LessThanEquals:
+        return lhs <= rhs;
+      case CompareOp::GreaterThan:
+        return lhs > rhs;
+      default:
+        return lhs >= rhs;
+    }
+  }
+
+ protected:
+  const size_t n_ = 4096;
+  std::vector<int32_t> ints_;
+  std::vector<float> floats_;
+  std::vector<uint8_t> nulls_;
+  std::vector<const FilterKernels *> kernels_;
+};
+
+#endif  // MINISQL_FILTER_KERNELS_TEST_UTIL_H